@@ -48,7 +48,7 @@ public:
   {
 
     AggregateHashTableBenchmark::SetUp(state);
-    AggregateExpr        aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    AggregateExpr        aggregate_expr(AggregateExpr::Type::SUM, make_unique<ValueExpr>(Value(0)));
     vector<Expression *> aggregate_exprs;
     aggregate_exprs.push_back(&aggregate_expr);
     standard_hash_table_ = make_unique<StandardAggregateHashTable>(aggregate_exprs);
@@ -67,7 +67,6 @@ BENCHMARK_DEFINE_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)(benc
 
 BENCHMARK_REGISTER_F(DISABLED_StandardAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
 
-#ifdef USE_SIMD
 class DISABLED_LinearProbingAggregateHashTableBenchmark : public AggregateHashTableBenchmark
 {
 public:
@@ -75,7 +74,10 @@ public:
   {
 
     AggregateHashTableBenchmark::SetUp(state);
-    linear_probing_hash_table_ = make_unique<LinearProbingAggregateHashTable<int>>(AggregateExpr::Type::SUM);
+    AggregateExpr        aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    vector<Expression *> aggregate_exprs;
+    aggregate_exprs.push_back(&aggregate_expr);
+    linear_probing_hash_table_ = make_unique<LinearProbingAggregateHashTable>(aggregate_exprs);
   }
 
 protected:
@@ -90,6 +92,95 @@ BENCHMARK_DEFINE_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)
 }
 
 BENCHMARK_REGISTER_F(DISABLED_LinearProbingAggregateHashTableBenchmark, Aggregate)->Arg(16)->Arg(1024)->Arg(8192);
-#endif
+
+/**
+ * @brief 两个分组列（char(16) 和 int）、三个聚合列，state.range(0) 行，state.range(1) 个分组
+ */
+class MultiColumnAggregateHashTableBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    unique_ptr<Column> group1 = make_unique<Column>(AttrType::CHARS, 16);
+    unique_ptr<Column> group2 = make_unique<Column>(AttrType::INTS, 4);
+    unique_ptr<Column> aggr1  = make_unique<Column>(AttrType::INTS, 4);
+    unique_ptr<Column> aggr2  = make_unique<Column>(AttrType::FLOATS, 4);
+    for (int i = 0; i < state.range(0); i++) {
+      const int group = i % state.range(1);
+      char      name[16]{};
+      snprintf(name, sizeof(name), "group-%d", group / 4);
+      const int   key   = group % 4;
+      const float value = i * 0.5f;
+      group1->append_one(name);
+      group2->append_one((char *)&key);
+      aggr1->append_one((char *)&i);
+      aggr2->append_one((char *)&value);
+    }
+    group_chunk_.add_column(std::move(group1), 0);
+    group_chunk_.add_column(std::move(group2), 1);
+    aggr_chunk_.add_column(std::move(aggr1), 0);
+    aggr_chunk_.add_column(std::move(aggr2), 1);
+    aggr_chunk_.add_column(aggr_chunk_.column(0).clone(), 2);
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    hash_table_.reset();
+    group_chunk_.reset();
+    aggr_chunk_.reset();
+  }
+
+protected:
+  vector<Expression *> aggregate_exprs() { return {&sum_expr_, &avg_expr_, &max_expr_}; }
+
+protected:
+  // StandardAggregateHashTable 通过子表达式获取聚合列的类型
+  AggregateExpr                  sum_expr_{AggregateExpr::Type::SUM, make_unique<ValueExpr>(Value(0))};
+  AggregateExpr                  avg_expr_{AggregateExpr::Type::AVG, make_unique<ValueExpr>(Value(0.0f))};
+  AggregateExpr                  max_expr_{AggregateExpr::Type::MAX, make_unique<ValueExpr>(Value(0))};
+  Chunk                          group_chunk_;
+  Chunk                          aggr_chunk_;
+  unique_ptr<AggregateHashTable> hash_table_;
+};
+
+class DISABLED_StandardMultiColumnBenchmark : public MultiColumnAggregateHashTableBenchmark
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    MultiColumnAggregateHashTableBenchmark::SetUp(state);
+    hash_table_ = make_unique<StandardAggregateHashTable>(aggregate_exprs());
+  }
+};
+
+BENCHMARK_DEFINE_F(DISABLED_StandardMultiColumnBenchmark, Aggregate)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    hash_table_->add_chunk(group_chunk_, aggr_chunk_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(DISABLED_StandardMultiColumnBenchmark, Aggregate)->ArgsProduct({{8192}, {8, 1024}});
+
+class DISABLED_LinearProbingMultiColumnBenchmark : public MultiColumnAggregateHashTableBenchmark
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    MultiColumnAggregateHashTableBenchmark::SetUp(state);
+    hash_table_ = make_unique<LinearProbingAggregateHashTable>(aggregate_exprs());
+  }
+};
+
+BENCHMARK_DEFINE_F(DISABLED_LinearProbingMultiColumnBenchmark, Aggregate)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    hash_table_->add_chunk(group_chunk_, aggr_chunk_);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(DISABLED_LinearProbingMultiColumnBenchmark, Aggregate)->ArgsProduct({{8192}, {8, 1024}});
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 #include <benchmark/benchmark.h>
 
 #include "sql/expr/arithmetic_operator.hpp"
+#include "sql/expr/column_kernels.h"
 
 class DISABLED_ArithmeticBenchmark : public benchmark::Fixture
 {
@@ -63,18 +64,42 @@ BENCHMARK_DEFINE_F(DISABLED_ArithmeticBenchmark, Sub)(benchmark::State &state)
 
 BENCHMARK_REGISTER_F(DISABLED_ArithmeticBenchmark, Sub)->Arg(10)->Arg(1000)->Arg(10000);
 
-#ifdef USE_SIMD
 static void DISABLED_benchmark_sum_simd(benchmark::State &state)
 {
   int              size = state.range(0);
   std::vector<int> data(state.range(0), 1);
   for (auto _ : state) {
-    mm256_sum_epi32(data.data(), size);
+    int res = simd_sum_epi32(data.data(), size);
+    benchmark::DoNotOptimize(res);
   }
 }
 
 BENCHMARK(DISABLED_benchmark_sum_simd)->RangeMultiplier(2)->Range(1 << 10, 1 << 12);
-#endif
+
+/// 比较不同指令集的性能，第一个参数是 SimdLevel，超过当前机器支持的级别时使用支持的最高级别
+static void DISABLED_benchmark_compare_simd_level(benchmark::State &state)
+{
+  const SimdLevel origin = simd_level();
+  const SimdLevel level  = set_simd_level(static_cast<SimdLevel>(state.range(0)));
+  state.SetLabel(simd_level_name(level));
+
+  int                  size = state.range(1);
+  std::vector<int>     data(size, 1);
+  std::vector<uint8_t> select(size, 1);
+  int                  constant = 2;
+  for (auto _ : state) {
+    compare_result<int, false, true>(data.data(), &constant, size, select, CompOp::LESS_THAN);
+    benchmark::DoNotOptimize(select.data());
+  }
+  set_simd_level(origin);
+}
+
+BENCHMARK(DISABLED_benchmark_compare_simd_level)
+    ->ArgsProduct({{static_cast<int>(SimdLevel::SCALAR),
+                       static_cast<int>(SimdLevel::SSE42),
+                       static_cast<int>(SimdLevel::AVX2),
+                       static_cast<int>(SimdLevel::AVX512)},
+        {1 << 10, 1 << 12}});
 
 static int sum_scalar(const int *data, int size)
 {
@@ -97,4 +122,185 @@ static void DISABLED_benchmark_sum_scalar(benchmark::State &state)
 
 BENCHMARK(DISABLED_benchmark_sum_scalar)->RangeMultiplier(2)->Range(1 << 10, 1 << 12);
 
+class DISABLED_ColumnKernelBenchmark : public benchmark::Fixture
+{
+public:
+  void SetUp(const ::benchmark::State &state) override
+  {
+    const int size = state.range(0);
+    int_column_.init(AttrType::INTS, sizeof(int), size);
+    float_column_.init(AttrType::FLOATS, sizeof(float), size);
+    date_column_.init(AttrType::DATES, sizeof(int), size);
+    char_column_.init(AttrType::CHARS, CHAR_LEN, size);
+    for (int i = 0; i < size; i++) {
+      int   int_value   = i % 100;
+      float float_value = i * 0.5f;
+      int   date_value  = 20250101 + i % 28;
+      char  chars[CHAR_LEN];
+      snprintf(chars, sizeof(chars), "%07d", i % 10000000);
+      int_column_.append_one(reinterpret_cast<const char *>(&int_value));
+      float_column_.append_one(reinterpret_cast<const char *>(&float_value));
+      date_column_.append_one(reinterpret_cast<const char *>(&date_value));
+      char_column_.append_one(chars);
+    }
+    // 有 NULL 的列，每 8 行一个 NULL
+    nullable_column_.init(AttrType::INTS, sizeof(int), size);
+    nullable_column_.append_rows(int_column_, 0, size);
+    for (int i = 0; i < size; i += 8) {
+      nullable_column_.set_null(i);
+    }
+
+    int_constant_.init(Value(50), size);
+    float_constant_.init(Value(100.0f), size);
+    char_constant_.init(Value("0000500"), size);
+    select_.assign(size, 1);
+  }
+
+  void TearDown(const ::benchmark::State &state) override
+  {
+    int_column_.reset();
+    float_column_.reset();
+    date_column_.reset();
+    char_column_.reset();
+    nullable_column_.reset();
+    int_constant_.reset();
+    float_constant_.reset();
+    char_constant_.reset();
+  }
+
+protected:
+  static constexpr int CHAR_LEN = 8;
+
+  Column          int_column_;
+  Column          float_column_;
+  Column          date_column_;
+  Column          char_column_;
+  Column          nullable_column_;
+  Column          int_constant_;
+  Column          float_constant_;
+  Column          char_constant_;
+  vector<uint8_t> select_;
+};
+
+#define COLUMN_KERNEL_BENCHMARK(name) \
+  BENCHMARK_REGISTER_F(DISABLED_ColumnKernelBenchmark, name)->Arg(10)->Arg(1000)->Arg(10000)
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareIntConstant)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::LESS_THAN, int_column_, int_constant_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareIntConstant);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareIntColumn)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::EQUAL_TO, int_column_, int_column_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareIntColumn);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareNullableInt)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::LESS_THAN, nullable_column_, int_constant_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareNullableInt);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareFloatConstant)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::GREAT_EQUAL, float_column_, float_constant_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareFloatConstant);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareIntFloat)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::LESS_THAN, int_column_, float_column_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareIntFloat);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareDateColumn)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::NOT_EQUAL, date_column_, date_column_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareDateColumn);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareCharConstant)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::LESS_THAN, char_column_, char_constant_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareCharConstant);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CompareCharColumn)(benchmark::State &state)
+{
+  for (auto _ : state) {
+    compare_columns(CompOp::EQUAL_TO, char_column_, char_column_, select_);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CompareCharColumn);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, AddInt)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    calc_columns(ArithmeticExpr::Type::ADD, int_column_, int_constant_, AttrType::INTS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(AddInt);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, MulInt)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    calc_columns(ArithmeticExpr::Type::MUL, int_column_, int_column_, AttrType::INTS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(MulInt);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, SubFloat)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    calc_columns(ArithmeticExpr::Type::SUB, float_column_, float_constant_, AttrType::FLOATS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(SubFloat);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, DivIntToFloat)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    calc_columns(ArithmeticExpr::Type::DIV, int_column_, int_column_, AttrType::FLOATS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(DivIntToFloat);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, NegateFloat)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    calc_columns(ArithmeticExpr::Type::NEGATIVE, float_column_, float_column_, AttrType::FLOATS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(NegateFloat);
+
+BENCHMARK_DEFINE_F(DISABLED_ColumnKernelBenchmark, CastIntToFloat)(benchmark::State &state)
+{
+  Column result;
+  for (auto _ : state) {
+    cast_column(int_column_, AttrType::FLOATS, result);
+  }
+}
+COLUMN_KERNEL_BENCHMARK(CastIntToFloat);
+
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -0,0 +1,170 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/lang/stdexcept.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/log/log.h"
+#include "common/math/integer_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 测试重做日志回放的耗时
+ * @details 先在多个数据文件和索引文件上生成日志，保存没有刷脏页的数据文件。
+ * 每轮测试恢复数据文件后使用不同的线程数回放全部日志。
+ * 只有在 CONCURRENCY 模式下编译时才会使用多个线程回放。
+ */
+class LogReplayBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (prepared_) {
+      return;
+    }
+
+    LoggerFactory::init_default("log_replay_performance_test.log", LOG_LEVEL_WARN);
+
+    filesystem::remove_all(directory_);
+    filesystem::create_directories(directory_);
+    for (int i = 0; i < RECORD_FILE_NUM; i++) {
+      files_.push_back(directory_ / ("record_" + to_string(i) + ".bp"));
+    }
+    files_.push_back(directory_ / "index.bp");
+
+    DiskLogHandler    log_handler;
+    BufferPoolManager bpm;
+    bpm.init(make_unique<VacuousDoubleWriteBuffer>());
+
+    IntegratedLogReplayer replayer(bpm);
+    check(log_handler.init(directory_.c_str()), "init log handler");
+    check(log_handler.replay(replayer, 0), "replay");
+    check(log_handler.start(), "start log handler");
+
+    vector<DiskBufferPool *> buffer_pools;
+    for (const filesystem::path &file : files_) {
+      DiskBufferPool *buffer_pool = nullptr;
+      check(bpm.create_file(file.c_str()), "create file");
+      check(bpm.open_file(log_handler, file.c_str(), buffer_pool), "open file");
+      buffer_pools.push_back(buffer_pool);
+    }
+
+    vector<unique_ptr<RecordFileHandler>> record_handlers;
+    for (int i = 0; i < RECORD_FILE_NUM; i++) {
+      auto handler = make_unique<RecordFileHandler>(StorageFormat::ROW_FORMAT);
+      check(handler->init(*buffer_pools[i], log_handler, nullptr, nullptr), "init record file");
+      record_handlers.push_back(std::move(handler));
+    }
+
+    BplusTreeHandler tree_handler;
+    check(tree_handler.create(log_handler, *buffer_pools.back(), AttrType::INTS, sizeof(int32_t)), "create index");
+
+    const int        record_size = 100;
+    char             record[record_size] = "log replay benchmark";
+    IntegerGenerator file_random(0, RECORD_FILE_NUM - 1);
+    for (int i = 0; i < RECORD_NUM; i++) {
+      RID rid;
+      check(record_handlers[file_random.next()]->insert_record(record, record_size, &rid), "insert record");
+
+      int32_t key = i * 7919 % RECORD_NUM;
+      RID     index_rid(key, key);
+      check(tree_handler.insert_entry(reinterpret_cast<const char *>(&key), &index_rid), "insert entry");
+    }
+
+    check(log_handler.stop(), "stop log handler");
+    check(log_handler.await_termination(), "await log handler");
+    entry_num_ = log_handler.current_lsn();
+
+    // 在关闭文件刷脏页之前保存数据文件
+    for (const filesystem::path &file : files_) {
+      filesystem::copy_file(file, filesystem::path(file).concat(".origin"));
+    }
+
+    tree_handler.close();
+    record_handlers.clear();
+    prepared_ = true;
+  }
+
+  void restore_files()
+  {
+    for (const filesystem::path &file : files_) {
+      filesystem::copy_file(
+          filesystem::path(file).concat(".origin"), file, filesystem::copy_options::overwrite_existing);
+    }
+  }
+
+  static void check(RC rc, const char *what)
+  {
+    if (OB_FAIL(rc)) {
+      throw runtime_error(string("failed to ") + what + ". rc=" + strrc(rc));
+    }
+  }
+
+protected:
+  static constexpr int RECORD_FILE_NUM = 4;
+  static constexpr int RECORD_NUM      = 40000;
+
+  inline static bool               prepared_  = false;
+  inline static LSN                entry_num_ = 0;
+  inline static filesystem::path   directory_{"log_replay_performance_test"};
+  inline static vector<filesystem::path> files_;
+};
+
+BENCHMARK_DEFINE_F(LogReplayBenchmark, Replay)(State &state)
+{
+  for (auto _ : state) {
+    state.PauseTiming();
+    restore_files();
+    auto bpm = make_unique<BufferPoolManager>();
+    bpm->init(make_unique<VacuousDoubleWriteBuffer>());
+    DiskLogHandler log_handler;
+    for (const filesystem::path &file : files_) {
+      DiskBufferPool *buffer_pool = nullptr;
+      check(bpm->open_file(log_handler, file.c_str(), buffer_pool), "open file");
+    }
+    IntegratedLogReplayer replayer(*bpm);
+    replayer.set_worker_num(static_cast<int>(state.range(0)));
+    state.ResumeTiming();
+
+    check(log_handler.init(directory_.c_str()), "init log handler");
+    check(log_handler.replay(replayer, 0), "replay");
+
+    state.PauseTiming();
+    bpm.reset();
+    state.ResumeTiming();
+  }
+
+  state.counters["entries"] = Counter(entry_num_);
+  state.counters["entries_per_second"] =
+      Counter(static_cast<double>(entry_num_) * state.iterations(), Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(LogReplayBenchmark, Replay)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(kMillisecond)
+    ->UseRealTime()
+    ->Iterations(3);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "common/math/integer_generator.h"
+#include "storage/db/db.h"
+#include "storage/table/table.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 多个线程并发更新少量热点行
+ * @details 第一个参数是热点行的个数，第二个参数是等锁的超时时间，0 表示冲突时不等待直接回滚重试
+ */
+class ContendedUpdateBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      while (!setup_done_) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+      }
+      return;
+    }
+
+    LoggerFactory::init_default("contended_update.log", LOG_LEVEL_WARN);
+
+    filesystem::remove_all(directory_);
+    filesystem::create_directories(directory_);
+
+    db_ = make_unique<Db>();
+    RC rc = db_->init("bench_db", directory_.c_str(), "mvcc", "disk");
+    if (OB_FAIL(rc)) {
+      throw runtime_error("failed to init db");
+    }
+
+    vector<AttrInfoSqlNode> attr_infos(1);
+    attr_infos[0].name   = "val";
+    attr_infos[0].type   = AttrType::INTS;
+    attr_infos[0].length = 4;
+    rc = db_->create_table("t", attr_infos, {});
+    if (OB_FAIL(rc)) {
+      throw runtime_error("failed to create table");
+    }
+    table_ = db_->find_table("t");
+
+    Trx *trx = db_->trx_kit().create_trx(db_->log_handler());
+    trx->start_if_need();
+    for (int64_t i = 0; i < state.range(0); i++) {
+      Value  value(static_cast<int>(i));
+      Record record;
+      table_->make_record(1, &value, record);
+      trx->insert_record(table_, record);
+      rids_.push_back(record.rid());
+    }
+    trx->commit();
+    db_->trx_kit().destroy_trx(trx);
+
+    setup_done_ = true;
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    auto &lock_manager = static_cast<MvccTrxKit &>(db_->trx_kit()).lock_manager();
+    RowLockManager::Stats stats = lock_manager.stats();
+    LOG_WARN("row lock stats. locks=%ld, waits=%ld, deadlocks=%ld, timeouts=%ld",
+             stats.lock_count, stats.wait_count, stats.deadlock_count, stats.timeout_count);
+
+    db_.reset();
+    filesystem::remove_all(directory_);
+    rids_.clear();
+    setup_done_ = false;
+  }
+
+  void Update(State &state, int64_t &commit_count, int64_t &retry_count)
+  {
+    IntegerGenerator generator(0, static_cast<int>(rids_.size() - 1));
+    Trx             *trx = db_->trx_kit().create_trx(db_->log_handler());
+    trx->set_lock_wait_timeout(static_cast<int>(state.range(1)));
+
+    for (auto _ : state) {
+      // 冲突时回滚重试，直到这次更新成功
+      while (true) {
+        trx->start_if_need();
+        Record record;
+        record.set_rid(rids_[generator.next()]);
+        Value value(static_cast<int>(state.iterations()));
+        RC    rc = trx->update_record(table_, record, "val", &value);
+        if (OB_SUCC(rc)) {
+          trx->commit();
+          commit_count++;
+          break;
+        }
+
+        trx->rollback();
+        retry_count++;
+      }
+    }
+
+    db_->trx_kit().destroy_trx(trx);
+  }
+
+protected:
+  filesystem::path directory_{"contended_update"};
+  unique_ptr<Db>   db_;
+  Table           *table_ = nullptr;
+  vector<RID>      rids_;
+  volatile bool    setup_done_ = false;
+};
+
+BENCHMARK_DEFINE_F(ContendedUpdateBenchmark, Update)(State &state)
+{
+  int64_t commit_count = 0;
+  int64_t retry_count  = 0;
+  Update(state, commit_count, retry_count);
+
+  state.counters["commit"] = Counter(commit_count, Counter::kIsRate);
+  state.counters["retry"]  = Counter(retry_count, Counter::kIsRate);
+}
+
+BENCHMARK_REGISTER_F(ContendedUpdateBenchmark, Update)
+    ->Threads(8)
+    ->Args({4, 0})
+    ->Args({4, Trx::DEFAULT_LOCK_WAIT_TIMEOUT_MS})
+    ->Args({64, 0})
+    ->Args({64, Trx::DEFAULT_LOCK_WAIT_TIMEOUT_MS});
+
+BENCHMARK_MAIN();
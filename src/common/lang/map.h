@@ -14,4 +14,5 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/utility.h"
 
-using std::map;
\ No newline at end of file
+using std::map;
+using std::multimap;
\ No newline at end of file
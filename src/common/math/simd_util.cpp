@@ -9,20 +9,23 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include <stdint.h>
+#include "common/lang/atomic.h"
 #include "common/math/simd_util.h"
 
 #if defined(USE_SIMD)
+#include <cpuid.h>
+#endif
 
-int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i)
+namespace {
+
+atomic<SimdLevel> &current_simd_level()
 {
-  __m128i idx = _mm_cvtsi32_si128(i);
-  __m256i val = _mm256_permutevar8x32_epi32(vec, _mm256_castsi128_si256(idx));
-  return _mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+  static atomic<SimdLevel> level(detect_simd_level());
+  return level;
 }
 
-int mm256_sum_epi32(const int *values, int size)
+int sum_epi32_scalar(const int *values, int size)
 {
-  // your code here
   int sum = 0;
   for (int i = 0; i < size; i++) {
     sum += values[i];
@@ -30,9 +33,8 @@ int mm256_sum_epi32(const int *values, int size)
   return sum;
 }
 
-float mm256_sum_ps(const float *values, int size)
+float sum_ps_scalar(const float *values, int size)
 {
-  // your code here
   float sum = 0;
   for (int i = 0; i < size; i++) {
     sum += values[i];
@@ -40,18 +42,381 @@ float mm256_sum_ps(const float *values, int size)
   return sum;
 }
 
-template <typename V>
-void selective_load(V *memory, int offset, V *vec, __m256i &inv)
+void hash_epi32_scalar(const int *keys, int size, uint32_t *hashes)
+{
+  for (int i = 0; i < size; i++) {
+    hashes[i] = simd_hash_epi32(keys[i]);
+  }
+}
+
+int selective_load_scalar(const uint32_t *memory, int offset, uint32_t *vec, uint32_t mask, int width)
 {
-  int *inv_ptr = reinterpret_cast<int *>(&inv);
-  for (int i = 0; i < SIMD_WIDTH; i++) {
-    if (inv_ptr[i] == -1) {
-      vec[i] = memory[offset++];
+  int count = 0;
+  for (int i = 0; i < width; i++) {
+    if (mask & (1U << i)) {
+      vec[i] = memory[offset + count++];
     }
   }
+  return count;
+}
+
+void match_epi32_scalar(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask)
+{
+  match_mask = 0;
+  zero_mask  = 0;
+  for (int i = 0; i < SIMD_MATCH_WIDTH; i++) {
+    match_mask |= static_cast<uint32_t>(values[i] == key) << i;
+    zero_mask |= static_cast<uint32_t>(values[i] == 0) << i;
+  }
+}
+
+#if defined(USE_SIMD)
+
+uint64_t read_xcr0()
+{
+  uint32_t eax = 0;
+  uint32_t edx = 0;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+/// 一个 128 位寄存器中 4 个 int 的和
+SIMD_TARGET_SSE42 int reduce_epi32(__m128i value)
+{
+  value = _mm_hadd_epi32(value, value);
+  value = _mm_hadd_epi32(value, value);
+  return _mm_cvtsi128_si32(value);
+}
+
+SIMD_TARGET_SSE42 float reduce_ps(__m128 value)
+{
+  value = _mm_hadd_ps(value, value);
+  value = _mm_hadd_ps(value, value);
+  return _mm_cvtss_f32(value);
+}
+
+SIMD_TARGET_SSE42 int sum_epi32_sse42(const int *values, int size)
+{
+  __m128i acc = _mm_setzero_si128();
+  int     i   = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i)));
+  }
+  int sum = reduce_epi32(acc);
+  for (; i < size; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+SIMD_TARGET_AVX2 int sum_epi32_avx2(const int *values, int size)
+{
+  __m256i acc = _mm256_setzero_si256();
+  int     i   = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i)));
+  }
+  int sum = reduce_epi32(_mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+  for (; i < size; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+SIMD_TARGET_AVX512 int sum_epi32_avx512(const int *values, int size)
+{
+  __m512i acc = _mm512_setzero_si512();
+  int     i   = 0;
+  for (; i + 16 <= size; i += 16) {
+    acc = _mm512_add_epi32(acc, _mm512_loadu_si512(values + i));
+  }
+  // 剩余的值用带掩码的 load 读取，不需要标量循环
+  const __mmask16 tail = static_cast<__mmask16>((1U << (size - i)) - 1);
+  acc                  = _mm512_add_epi32(acc, _mm512_maskz_loadu_epi32(tail, values + i));
+  return _mm512_reduce_add_epi32(acc);
+}
+
+SIMD_TARGET_SSE42 float sum_ps_sse42(const float *values, int size)
+{
+  __m128 acc = _mm_setzero_ps();
+  int    i   = 0;
+  for (; i + 4 <= size; i += 4) {
+    acc = _mm_add_ps(acc, _mm_loadu_ps(values + i));
+  }
+  float sum = reduce_ps(acc);
+  for (; i < size; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+SIMD_TARGET_AVX2 float sum_ps_avx2(const float *values, int size)
+{
+  __m256 acc = _mm256_setzero_ps();
+  int    i   = 0;
+  for (; i + 8 <= size; i += 8) {
+    acc = _mm256_add_ps(acc, _mm256_loadu_ps(values + i));
+  }
+  float sum = reduce_ps(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+  for (; i < size; i++) {
+    sum += values[i];
+  }
+  return sum;
+}
+
+SIMD_TARGET_AVX512 float sum_ps_avx512(const float *values, int size)
+{
+  __m512 acc = _mm512_setzero_ps();
+  int    i   = 0;
+  for (; i + 16 <= size; i += 16) {
+    acc = _mm512_add_ps(acc, _mm512_loadu_ps(values + i));
+  }
+  const __mmask16 tail = static_cast<__mmask16>((1U << (size - i)) - 1);
+  acc                  = _mm512_add_ps(acc, _mm512_maskz_loadu_ps(tail, values + i));
+  return _mm512_reduce_add_ps(acc);
+}
+
+SIMD_TARGET_SSE42 __m128i fmix32_sse42(__m128i hash)
+{
+  hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+  hash = _mm_mullo_epi32(hash, _mm_set1_epi32(0x85ebca6b));
+  hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 13));
+  hash = _mm_mullo_epi32(hash, _mm_set1_epi32(0xc2b2ae35));
+  return _mm_xor_si128(hash, _mm_srli_epi32(hash, 16));
+}
+
+SIMD_TARGET_AVX2 __m256i fmix32_avx2(__m256i hash)
+{
+  hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+  hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(0x85ebca6b));
+  hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 13));
+  hash = _mm256_mullo_epi32(hash, _mm256_set1_epi32(0xc2b2ae35));
+  return _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+}
+
+SIMD_TARGET_AVX512 __m512i fmix32_avx512(__m512i hash)
+{
+  hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+  hash = _mm512_mullo_epi32(hash, _mm512_set1_epi32(0x85ebca6b));
+  hash = _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 13));
+  hash = _mm512_mullo_epi32(hash, _mm512_set1_epi32(0xc2b2ae35));
+  return _mm512_xor_si512(hash, _mm512_srli_epi32(hash, 16));
+}
+
+SIMD_TARGET_SSE42 void hash_epi32_sse42(const int *keys, int size, uint32_t *hashes)
+{
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    __m128i hash = fmix32_sse42(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(hashes + i), hash);
+  }
+  hash_epi32_scalar(keys + i, size - i, hashes + i);
+}
+
+SIMD_TARGET_AVX2 void hash_epi32_avx2(const int *keys, int size, uint32_t *hashes)
+{
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    __m256i hash = fmix32_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(hashes + i), hash);
+  }
+  hash_epi32_scalar(keys + i, size - i, hashes + i);
 }
-template void selective_load<uint32_t>(uint32_t *memory, int offset, uint32_t *vec, __m256i &inv);
-template void selective_load<int>(int *memory, int offset, int *vec, __m256i &inv);
-template void selective_load<float>(float *memory, int offset, float *vec, __m256i &inv);
 
-#endif
\ No newline at end of file
+SIMD_TARGET_AVX512 void hash_epi32_avx512(const int *keys, int size, uint32_t *hashes)
+{
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    _mm512_storeu_si512(hashes + i, fmix32_avx512(_mm512_loadu_si512(keys + i)));
+  }
+  const __mmask16 tail = static_cast<__mmask16>((1U << (size - i)) - 1);
+  _mm512_mask_storeu_epi32(hashes + i, tail, fmix32_avx512(_mm512_maskz_loadu_epi32(tail, keys + i)));
+}
+
+SIMD_TARGET_AVX512 int selective_load_avx512(const uint32_t *memory, int offset, uint32_t *vec, uint32_t mask, int width)
+{
+  const __mmask16 lanes = static_cast<__mmask16>((1U << width) - 1);
+  const __mmask16 load  = static_cast<__mmask16>(mask) & lanes;
+
+  __m512i value = _mm512_maskz_loadu_epi32(lanes, vec);
+  value         = _mm512_mask_expandloadu_epi32(value, load, memory + offset);
+  _mm512_mask_storeu_epi32(vec, lanes, value);
+  return __builtin_popcount(load);
+}
+
+SIMD_TARGET_SSE42 void match_epi32_sse42(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask)
+{
+  const __m128i keys  = _mm_set1_epi32(static_cast<int>(key));
+  const __m128i zeros = _mm_setzero_si128();
+  match_mask          = 0;
+  zero_mask           = 0;
+  for (int i = 0; i < SIMD_MATCH_WIDTH; i += 4) {
+    const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+    match_mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(value, keys)))) << i;
+    zero_mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(value, zeros)))) << i;
+  }
+}
+
+SIMD_TARGET_AVX2 void match_epi32_avx2(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask)
+{
+  const __m256i keys  = _mm256_set1_epi32(static_cast<int>(key));
+  const __m256i zeros = _mm256_setzero_si256();
+  const __m256i low   = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+  const __m256i high  = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + 8));
+
+  match_mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(low, keys)))) |
+               static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(high, keys)))) << 8;
+  zero_mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(low, zeros)))) |
+              static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(high, zeros)))) << 8;
+}
+
+SIMD_TARGET_AVX512 void match_epi32_avx512(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask)
+{
+  const __m512i value = _mm512_loadu_si512(values);
+  match_mask          = _mm512_cmpeq_epi32_mask(value, _mm512_set1_epi32(static_cast<int>(key)));
+  zero_mask           = _mm512_cmpeq_epi32_mask(value, _mm512_setzero_si512());
+}
+
+#endif  // USE_SIMD
+
+}  // namespace
+
+SimdLevel detect_simd_level()
+{
+#if defined(USE_SIMD)
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & bit_SSE4_2) == 0) {
+    return SimdLevel::SCALAR;
+  }
+
+  // AVX 指令需要操作系统在切换上下文时保存 YMM/ZMM 寄存器，通过 XCR0 确认
+  if ((ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) {
+    return SimdLevel::SSE42;
+  }
+  const uint64_t xcr0 = read_xcr0();
+  if ((xcr0 & 0x6) != 0x6) {
+    return SimdLevel::SSE42;
+  }
+
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0 || (ebx & bit_AVX2) == 0) {
+    return SimdLevel::SSE42;
+  }
+  if ((ebx & bit_AVX512F) != 0 && (xcr0 & 0xE6) == 0xE6) {
+    return SimdLevel::AVX512;
+  }
+  return SimdLevel::AVX2;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+
+SimdLevel simd_level() { return current_simd_level().load(std::memory_order_relaxed); }
+
+SimdLevel set_simd_level(SimdLevel level)
+{
+  const SimdLevel supported = detect_simd_level();
+  if (static_cast<int>(level) > static_cast<int>(supported)) {
+    level = supported;
+  }
+  current_simd_level().store(level, std::memory_order_relaxed);
+  return level;
+}
+
+const char *simd_level_name(SimdLevel level)
+{
+  switch (level) {
+    case SimdLevel::SCALAR: return "scalar";
+    case SimdLevel::SSE42: return "sse4.2";
+    case SimdLevel::AVX2: return "avx2";
+    case SimdLevel::AVX512: return "avx512";
+  }
+  return "unknown";
+}
+
+int simd_width(SimdLevel level)
+{
+  switch (level) {
+    case SimdLevel::SSE42: return 4;
+    case SimdLevel::AVX2: return 8;
+    case SimdLevel::AVX512: return 16;
+    default: return 1;
+  }
+}
+
+int simd_sum_epi32(const int *values, int size)
+{
+#if defined(USE_SIMD)
+  switch (simd_level()) {
+    case SimdLevel::AVX512: return sum_epi32_avx512(values, size);
+    case SimdLevel::AVX2: return sum_epi32_avx2(values, size);
+    case SimdLevel::SSE42: return sum_epi32_sse42(values, size);
+    default: break;
+  }
+#endif
+  return sum_epi32_scalar(values, size);
+}
+
+float simd_sum_ps(const float *values, int size)
+{
+#if defined(USE_SIMD)
+  switch (simd_level()) {
+    case SimdLevel::AVX512: return sum_ps_avx512(values, size);
+    case SimdLevel::AVX2: return sum_ps_avx2(values, size);
+    case SimdLevel::SSE42: return sum_ps_sse42(values, size);
+    default: break;
+  }
+#endif
+  return sum_ps_scalar(values, size);
+}
+
+void simd_hash_epi32(const int *keys, int size, uint32_t *hashes)
+{
+#if defined(USE_SIMD)
+  switch (simd_level()) {
+    case SimdLevel::AVX512: hash_epi32_avx512(keys, size, hashes); return;
+    case SimdLevel::AVX2: hash_epi32_avx2(keys, size, hashes); return;
+    case SimdLevel::SSE42: hash_epi32_sse42(keys, size, hashes); return;
+    default: break;
+  }
+#endif
+  hash_epi32_scalar(keys, size, hashes);
+}
+
+void simd_match_epi32(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask)
+{
+#if defined(USE_SIMD)
+  switch (simd_level()) {
+    case SimdLevel::AVX512: match_epi32_avx512(values, key, match_mask, zero_mask); return;
+    case SimdLevel::AVX2: match_epi32_avx2(values, key, match_mask, zero_mask); return;
+    case SimdLevel::SSE42: match_epi32_sse42(values, key, match_mask, zero_mask); return;
+    default: break;
+  }
+#endif
+  match_epi32_scalar(values, key, match_mask, zero_mask);
+}
+
+template <typename V>
+int selective_load(const V *memory, int offset, V *vec, uint32_t mask, int width)
+{
+  static_assert(sizeof(V) == sizeof(uint32_t), "selective load only supports 32 bit values");
+  const uint32_t *memory_ptr = reinterpret_cast<const uint32_t *>(memory);
+  uint32_t       *vec_ptr    = reinterpret_cast<uint32_t *>(vec);
+#if defined(USE_SIMD)
+  if (simd_level() == SimdLevel::AVX512) {
+    return selective_load_avx512(memory_ptr, offset, vec_ptr, mask, width);
+  }
+#endif
+  return selective_load_scalar(memory_ptr, offset, vec_ptr, mask, width);
+}
+template int selective_load<uint32_t>(const uint32_t *memory, int offset, uint32_t *vec, uint32_t mask, int width);
+template int selective_load<int>(const int *memory, int offset, int *vec, uint32_t mask, int width);
+template int selective_load<float>(const float *memory, int offset, float *vec, uint32_t mask, int width);
+
+#if defined(USE_SIMD)
+SIMD_TARGET_AVX2 int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i)
+{
+  __m128i idx = _mm_cvtsi32_si128(i);
+  __m256i val = _mm256_permutevar8x32_epi32(vec, _mm256_castsi128_si256(idx));
+  return _mm_cvtsi128_si32(_mm256_castsi256_si128(val));
+}
+#endif
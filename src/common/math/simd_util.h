@@ -10,19 +10,121 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
+
+#include "common/lang/array.h"
+
+/**
+ * @file simd_util.h
+ * @brief SIMD 指令的运行时分发
+ * @details USE_SIMD 表示编译 x86-64 上的 SIMD 实现，不要求编译时指定 -mavx2。
+ * 每个 SIMD 函数都通过 SIMD_TARGET_* 指定自己使用的指令集，启动时通过 cpuid 检测 CPU 支持的指令集，
+ * 调用时按照 simd_level() 选择实现。同一个二进制文件在只支持 SSE4.2 的机器上也可以运行。
+ */
+
 #if defined(USE_SIMD)
+// GCC 12 的 AVX-512 头文件中 _mm512_undefined_* 使用自初始化，开启优化时会误报未初始化的警告
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
 #include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
 
-static constexpr int SIMD_WIDTH = 8;  // AVX2 (256bit)
+#define SIMD_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
 
-/// @brief 从 vec 中提取下标为 i 的 int 类型的值。
-int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i);
+/**
+ * @brief SIMD 指令集的级别，后面的级别包含前面的级别
+ */
+enum class SimdLevel
+{
+  SCALAR = 0,
+  SSE42,
+  AVX2,
+  AVX512,
+};
+
+/// @brief 通过 cpuid 检测 CPU 和操作系统支持的指令集。没有编译 SIMD 实现时返回 SCALAR
+SimdLevel detect_simd_level();
+
+/// @brief 当前使用的指令集，第一次调用时检测
+SimdLevel simd_level();
+
+/**
+ * @brief 修改当前使用的指令集，用于测试和性能对比
+ * @return 实际使用的指令集，不会超过 detect_simd_level()
+ */
+SimdLevel set_simd_level(SimdLevel level);
+
+const char *simd_level_name(SimdLevel level);
+
+/// @brief 每次处理的 32 位的值的个数
+int simd_width(SimdLevel level);
+
+/**
+ * @brief 把比较结果的 8 位掩码展开成 8 个字节，第 i 位是 1 时第 i 个字节是 1
+ */
+inline constexpr array<uint64_t, 256> SIMD_MASK_TO_BYTES = [] {
+  array<uint64_t, 256> table{};
+  for (int mask = 0; mask < 256; mask++) {
+    for (int bit = 0; bit < 8; bit++) {
+      if (mask & (1 << bit)) {
+        table[mask] |= 1ULL << (bit * 8);
+      }
+    }
+  }
+  return table;
+}();
 
 /// @brief 数组求和
-int   mm256_sum_epi32(const int *values, int size);
-float mm256_sum_ps(const float *values, int size);
+int   simd_sum_epi32(const int *values, int size);
+float simd_sum_ps(const float *values, int size);
+
+/**
+ * @brief 批量计算 32 位整数的哈希值，使用 murmur3 的 fmix32
+ * @details 与 simd_hash_epi32(int) 的结果相同，不同的指令集结果也相同
+ */
+void simd_hash_epi32(const int *keys, int size, uint32_t *hashes);
+
+inline uint32_t simd_hash_epi32(int key)
+{
+  uint32_t hash = static_cast<uint32_t>(key);
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+/// simd_match_epi32 一次比较的值的个数
+inline constexpr int SIMD_MATCH_WIDTH = 16;
 
-/// @brief selective load 的标量实现
+/**
+ * @brief 比较 values 开始的 SIMD_MATCH_WIDTH 个值，用于线性探测哈希表一次检查一段连续的槽
+ * @param[out] match_mask 第 i 位为 1 表示 values[i] == key
+ * @param[out] zero_mask 第 i 位为 1 表示 values[i] == 0
+ * @note 调用者需要保证 values 后面有 SIMD_MATCH_WIDTH 个值可以读取
+ */
+void simd_match_epi32(const uint32_t *values, uint32_t key, uint32_t &match_mask, uint32_t &zero_mask);
+
+/**
+ * @brief selective load，参考 `Rethinking SIMD Vectorization for In-Memory Databases`
+ * @details 对于 mask 中为 1 的位 i，依次从 memory[offset] 开始读取值写入 vec[i]，其它位置的值保持不变。
+ * AVX-512 上使用 expand load 实现
+ * @param width vec 的长度，不超过 16
+ * @return 读取的值的个数
+ */
 template <typename V>
-void selective_load(V *memory, int offset, V *vec, __m256i &inv);
-#endif
\ No newline at end of file
+int selective_load(const V *memory, int offset, V *vec, uint32_t mask, int width);
+
+#if defined(USE_SIMD)
+/// @brief 从 vec 中提取下标为 i 的 int 类型的值。
+SIMD_TARGET_AVX2 int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i);
+#endif
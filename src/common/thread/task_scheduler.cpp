@@ -0,0 +1,190 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "common/thread/task_scheduler.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+
+using namespace std;
+
+namespace common {
+
+/// 当前线程所属的调度器和线程编号，不是调度器的线程时为空
+static thread_local TaskScheduler *current_scheduler = nullptr;
+static thread_local int            current_worker    = -1;
+
+TaskGroup::TaskGroup(int parallelism, function<RC(int)> task)
+    : parallelism_(parallelism), task_(std::move(task)), results_(std::max(parallelism, 0), RC::SUCCESS)
+{}
+
+bool TaskGroup::run_one()
+{
+  const int index = next_index_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= parallelism_) {
+    return false;
+  }
+
+  RC rc = task_(index);
+
+  lock_guard<mutex> guard(lock_);
+  results_[index] = rc;
+  finished_++;
+  if (finished_ == parallelism_) {
+    finished_cond_.notify_all();
+  }
+  return true;
+}
+
+bool TaskGroup::done() const
+{
+  lock_guard<mutex> guard(lock_);
+  return finished_ >= parallelism_;
+}
+
+RC TaskGroup::wait_done()
+{
+  unique_lock<mutex> guard(lock_);
+  finished_cond_.wait(guard, [this] { return finished_ >= parallelism_; });
+  for (RC rc : results_) {
+    if (rc != RC::SUCCESS) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+TaskScheduler::TaskScheduler(int thread_num)
+{
+  if (thread_num <= 0) {
+    thread_num = std::max(static_cast<int>(thread::hardware_concurrency()), 1);
+  }
+
+  for (int i = 0; i < thread_num; i++) {
+    workers_.emplace_back(make_unique<Worker>());
+  }
+  for (int i = 0; i < thread_num; i++) {
+    workers_[i]->thread_handle = thread(&TaskScheduler::thread_func, this, i);
+  }
+  LOG_INFO("task scheduler started. thread num=%d", thread_num);
+}
+
+TaskScheduler::~TaskScheduler()
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    stop_ = true;
+    task_cond_.notify_all();
+  }
+  for (unique_ptr<Worker> &worker : workers_) {
+    worker->thread_handle.join();
+  }
+}
+
+TaskScheduler &TaskScheduler::instance()
+{
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+shared_ptr<TaskGroup> TaskScheduler::submit(int parallelism, function<RC(int)> task)
+{
+  auto group = make_shared<TaskGroup>(parallelism, std::move(task));
+  if (parallelism <= 0) {
+    return group;
+  }
+
+  const int worker_num = thread_num();
+  for (int i = 0; i < parallelism; i++) {
+    // 调度器的线程提交的任务放到自己的队列中，空闲的线程会来窃取
+    const int index = current_scheduler == this ? current_worker
+                                                : next_worker_.fetch_add(1, std::memory_order_relaxed) % worker_num;
+    Worker &worker = *workers_[index];
+    lock_guard<mutex> guard(worker.lock);
+    worker.tasks.push_back(group);
+  }
+
+  lock_guard<mutex> guard(lock_);
+  pending_ += parallelism;
+  if (parallelism == 1) {
+    task_cond_.notify_one();
+  } else {
+    task_cond_.notify_all();
+  }
+  return group;
+}
+
+RC TaskScheduler::wait(TaskGroup &group)
+{
+  while (group.run_one()) {
+  }
+  return group.wait_done();
+}
+
+RC TaskScheduler::run(int parallelism, const function<RC(int)> &task)
+{
+  shared_ptr<TaskGroup> group = submit(parallelism, task);
+  return wait(*group);
+}
+
+shared_ptr<TaskGroup> TaskScheduler::pop_task(int index)
+{
+  shared_ptr<TaskGroup> group;
+  {
+    Worker           &worker = *workers_[index];
+    lock_guard<mutex> guard(worker.lock);
+    if (!worker.tasks.empty()) {
+      group = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    }
+  }
+
+  const int worker_num = thread_num();
+  for (int i = 1; group == nullptr && i < worker_num; i++) {
+    Worker           &victim = *workers_[(index + i) % worker_num];
+    lock_guard<mutex> guard(victim.lock);
+    if (!victim.tasks.empty()) {
+      group = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+
+  if (group != nullptr) {
+    lock_guard<mutex> guard(lock_);
+    pending_--;
+  }
+  return group;
+}
+
+void TaskScheduler::thread_func(int index)
+{
+  thread_set_name("TaskScheduler");
+  current_scheduler = this;
+  current_worker    = index;
+
+  while (true) {
+    shared_ptr<TaskGroup> group = pop_task(index);
+    if (group != nullptr) {
+      group->run_one();
+      continue;
+    }
+
+    unique_lock<mutex> guard(lock_);
+    task_cond_.wait(guard, [this] { return stop_ || pending_ > 0; });
+    if (stop_) {
+      break;
+    }
+  }
+
+  current_scheduler = nullptr;
+  current_worker    = -1;
+}
+
+}  // namespace common
@@ -0,0 +1,131 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/deque.h"
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+
+namespace common {
+
+class TaskScheduler;
+
+/**
+ * @brief 一组可以并行执行的任务
+ * @ingroup ThreadPool
+ * @details 任务的参数是编号 [0, parallelism)，每个编号执行一次。调度器的线程和等待的线程都通过
+ * run_one 领取编号执行，所以等待的线程不会因为调度器的线程都在忙而一直等待。
+ */
+class TaskGroup
+{
+  friend class TaskScheduler;
+
+public:
+  TaskGroup(int parallelism, function<RC(int)> task);
+
+  /**
+   * @brief 领取一个还没有执行的编号并执行
+   * @return 没有可以领取的编号时返回 false
+   */
+  bool run_one();
+
+  /// 所有任务是否都已经结束
+  bool done() const;
+
+  int parallelism() const { return parallelism_; }
+
+private:
+  /// 等待所有任务结束，返回编号最小的失败任务的错误码
+  RC wait_done();
+
+private:
+  const int         parallelism_;
+  function<RC(int)> task_;
+  atomic<int>       next_index_{0};  ///< 下一个要领取的编号
+
+  mutable mutex      lock_;
+  condition_variable finished_cond_;
+  int                finished_ = 0;  ///< 已经结束的任务个数
+  vector<RC>         results_;
+};
+
+/**
+ * @brief 查询内并行执行使用的任务调度器
+ * @ingroup ThreadPool
+ * @details 所有会话共享一组常驻线程，每个线程有自己的任务队列（双端队列）。线程从自己队列的尾部取任务，
+ * 自己的队列为空时从其它线程队列的头部窃取任务（work stealing）。在调度器的线程中提交的任务放到当前线程的队列中，
+ * 其它线程提交的任务轮流放到各个线程的队列中。
+ *
+ * 队列中的元素是 TaskGroup，一个元素表示执行这个任务组中的一个任务，执行时才领取具体的编号。
+ * 等待任务组的线程也会领取编号执行，调度器的线程都被占用或者在调度器的线程中等待其它任务组时也不会死锁。
+ */
+class TaskScheduler
+{
+public:
+  /**
+   * @param thread_num 线程个数，不大于 0 时使用 CPU 的个数
+   */
+  explicit TaskScheduler(int thread_num = 0);
+  ~TaskScheduler();
+
+  /**
+   * @brief 进程内共享的调度器，第一次使用时创建，线程个数与 CPU 的个数相同
+   */
+  static TaskScheduler &instance();
+
+  int thread_num() const { return static_cast<int>(workers_.size()); }
+
+  /**
+   * @brief 提交 parallelism 个任务，不等待任务执行
+   * @details 调用者需要在任务用到的数据失效之前调用 wait
+   */
+  shared_ptr<TaskGroup> submit(int parallelism, function<RC(int)> task);
+
+  /**
+   * @brief 等待任务组结束，当前线程也参与执行没有领取的任务
+   * @return 所有任务都成功时返回 SUCCESS，否则返回编号最小的失败任务的错误码
+   */
+  RC wait(TaskGroup &group);
+
+  /**
+   * @brief 执行 parallelism 个任务并等待结束，当前线程执行其中一部分
+   */
+  RC run(int parallelism, const function<RC(int)> &task);
+
+private:
+  struct Worker
+  {
+    mutex                        lock;
+    deque<shared_ptr<TaskGroup>> tasks;
+    thread                       thread_handle;
+  };
+
+  void thread_func(int index);
+
+  /// 从自己的队列尾部或者其它线程的队列头部取一个任务
+  shared_ptr<TaskGroup> pop_task(int index);
+
+private:
+  vector<unique_ptr<Worker>> workers_;
+  atomic<int>                next_worker_{0};  ///< 其它线程提交任务时下一个使用的队列
+
+  mutex              lock_;
+  condition_variable task_cond_;
+  int                pending_ = 0;  ///< 队列中的任务个数，线程没有任务时在 task_cond_ 上等待
+  bool               stop_    = false;
+};
+
+}  // namespace common
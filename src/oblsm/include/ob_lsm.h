@@ -110,6 +110,19 @@ public:
    */
   virtual RC batch_put(const vector<pair<string, string>> &kvs) = 0;
 
+  /**
+   * @brief Atomically inserts a batch of key-value entries if none of the keys has been written after a snapshot.
+   *
+   * This is the commit path of optimistic transactions: the validation and the write happen under
+   * the same write lock, so either all entries become visible with consecutive sequence numbers or
+   * none of them is written. An empty value marks the key as deleted.
+   *
+   * @param kvs A vector of key-value pairs to insert.
+   * @param snapshot_seq The last sequence number visible to the transaction.
+   * @return RC::LOCKED_CONCURRENCY_CONFLICT if any key has a version newer than `snapshot_seq`.
+   */
+  virtual RC batch_put_if_unmodified(const vector<pair<string, string>> &kvs, uint64_t snapshot_seq) = 0;
+
   /**
    * @brief Dumps all SSTables for debugging purposes.
    *
@@ -19,6 +19,7 @@ See the Mulan PSL v2 for more details. */
 #include "oblsm/memtable/ob_skiplist.h"
 #include "oblsm/util/ob_arena.h"
 #include "oblsm/util/ob_coding.h"
+#include "common/lang/iterator.h"
 #include "common/lang/map.h"
 
 namespace oceanbase {
@@ -73,6 +74,10 @@ public:
    * The iterator allows traversal of keys and values within the database. Options can define
    * how data is accessed, such as timestamp.
    *
+   * The iterator sees the uncommitted writes of this transaction on top of the snapshot. It only
+   * supports forward iteration: like the iterator returned by `ObLsm::new_iterator`, `seek_to_last`
+   * leaves it invalid.
+   *
    * @param options The `ObLsmReadOptions` that define the read behavior of the iterator.
    * @return A pointer to the newly created `ObLsmIterator` object.
    */
@@ -81,6 +86,11 @@ public:
   /**
    * @brief Commits the transaction, persisting all transaction changes to the database.
    *
+   * The write set is written as one batch. Conflicts are validated optimistically: if another
+   * transaction committed any of the written keys after this transaction began, nothing is
+   * written (first committer wins).
+   *
+   * @return RC::LOCKED_CONCURRENCY_CONFLICT if the validation fails, the transaction is rolled back.
    */
   RC commit();
 
@@ -101,6 +111,8 @@ private:
   /**
    * @brief The transaction's unique timestamp.
    *
+   * It is the last sequence number visible to the transaction, reads go to this snapshot and
+   * the commit fails if any key in the write set has been written after it.
    */
   uint64_t ts_ = 0;
 
@@ -109,15 +121,37 @@ private:
    *
    * This map holds key-value pairs that have been inserted or removed within the
    * transaction scope but not yet committed to the database. It's used to track changes
-   * and ensure atomicity during commit operations.
+   * and ensure atomicity during commit operations. A removed key has an empty value.
    */
   map<string, string> inner_store_;
 };
 
 /**
  * @class TrxInnerMapIterator
- * @brief An iterator for traversing the transaction's in-memory store
+ * @brief An iterator for traversing the transaction's in-memory store (the write set of a transaction).
+ *
+ * Deleted keys are kept in the write set with an empty value, it is up to the caller to skip them.
+ * The iterator stays valid while new keys are put into the transaction, since `map` iterators are
+ * not invalidated by insertion.
  */
 class TrxInnerMapIterator : public ObLsmIterator
-{};
+{
+public:
+  explicit TrxInnerMapIterator(const map<string, string> &store) : store_(store), iter_(store.end()) {}
+  ~TrxInnerMapIterator() override = default;
+
+  bool valid() const override { return iter_ != store_.end(); }
+  void next() override { ++iter_; }
+
+  string_view key() const override { return iter_->first; }
+  string_view value() const override { return iter_->second; }
+
+  void seek(const string_view &k) override { iter_ = store_.lower_bound(string(k)); }
+  void seek_to_first() override { iter_ = store_.begin(); }
+  void seek_to_last() override { iter_ = store_.empty() ? store_.end() : prev(store_.end()); }
+
+private:
+  const map<string, string>          &store_;
+  map<string, string>::const_iterator iter_;
+};
 }  // namespace oceanbase
\ No newline at end of file
@@ -11,6 +11,7 @@ See the Mulan PSL v2 for more details. */
 #include "oblsm/ob_lsm_impl.h"
 
 #include "common/log/log.h"
+#include "common/lang/limits.h"
 #include "common/sys/rc.h"
 #include "oblsm/include/ob_lsm.h"
 #include "oblsm/ob_manifest.h"
@@ -105,27 +106,74 @@ RC ObLsmImpl::put(const string_view &key, const string_view &value)
   // TODO: if put rate is too high, slow down writes is needed.
   // currently, the writes is stopped when the memtable is full.
   LOG_TRACE("begin to put key=%s, value=%s", key.data(), value.data());
-  RC rc = RC::SUCCESS;
   // TODO: currenttly the memtable use skiplist as the underlying data structure,
   // and the skiplist concurently write is not thread safe, so we use mutex here,
   // if the skiplist support `insert_concurrently()` interface, can we remove the mutex?
   unique_lock<mutex> lock(mu_);
-  uint64_t           seq = seq_.fetch_add(1);
-  // Write WAL
-  rc = wal_->put(seq, key, value);
+  return write_batch_locked(lock, {{key, value}});
+}
+
+RC ObLsmImpl::batch_put(const vector<pair<string, string>> &kvs)
+{
+  vector<pair<string_view, string_view>> views(kvs.begin(), kvs.end());
+  unique_lock<mutex>                     lock(mu_);
+  return write_batch_locked(lock, views);
+}
+
+RC ObLsmImpl::batch_put_if_unmodified(const vector<pair<string, string>> &kvs, uint64_t snapshot_seq)
+{
+  vector<pair<string_view, string_view>> views(kvs.begin(), kvs.end());
+  unique_lock<mutex>                     lock(mu_);
+  RC                                     rc = check_conflict_locked(kvs, snapshot_seq);
   if (rc != RC::SUCCESS) {
     return rc;
   }
+  return write_batch_locked(lock, views);
+}
+
+// an empty value is a tombstone, see ObUserIterator
+RC ObLsmImpl::remove(const string_view &key) { return put(key, string_view()); }
+
+RC ObLsmImpl::write_batch_locked(unique_lock<mutex> &lock, const vector<pair<string_view, string_view>> &kvs)
+{
+  RC rc = RC::SUCCESS;
+  if (kvs.empty()) {
+    return rc;
+  }
+
+  // a failed WAL write may leave a partial record in the log. Records appended after it would
+  // not be recovered, and the sequence numbers of the failed batch must not be handed out again,
+  // so no more writes are accepted.
+  if (wal_rc_ != RC::SUCCESS) {
+    LOG_WARN("refuse to write after a wal failure, rc=%s", strrc(wal_rc_));
+    return wal_rc_;
+  }
+
+  const uint64_t first_seq = seq_.load() + 1;
+  const uint64_t last_seq  = first_seq + kvs.size() - 1;
+  // Write WAL. The whole batch is one record, so recovery replays all of it or none of it.
+  rc = wal_->put_batch(first_seq, kvs);
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("Failed to write wal logs, rc=%s", strrc(rc));
+    wal_rc_ = rc;
+    return rc;
+  }
 
   if (options_.force_sync_new_log) {
     rc = wal_->sync();
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to sync wal logs, rc=%s", strrc(rc));
+      wal_rc_ = rc;
       return rc;
     }
   }
   // write memtable
-  mem_table_->put(seq, key, value);
+  for (size_t i = 0; i < kvs.size(); i++) {
+    mem_table_->put(first_seq + i, kvs[i].first, kvs[i].second);
+  }
+  // readers take their snapshot from `seq_`, so the batch becomes visible at once
+  seq_.store(last_seq);
+
   size_t mem_size = mem_table_->appro_memory_usage();
   if (mem_size > options_.memtable_size) {
     // Thinking point: here vector is used to store imems,
@@ -137,7 +185,7 @@ RC ObLsmImpl::put(const string_view &key, const string_view &value)
     }
     // check again after get lock(maybe freeze memtable by another thread)
     if (mem_table_->appro_memory_usage() > options_.memtable_size) {
-      manifest_.latest_seq = seq;
+      manifest_.latest_seq = last_seq;
       try_freeze_memtable();
     } else {
       // if there are multi put threads waiting here, need to notify one thread to
@@ -148,9 +196,36 @@ RC ObLsmImpl::put(const string_view &key, const string_view &value)
   return rc;
 }
 
-RC ObLsmImpl::batch_put(const vector<pair<string, string>> &kvs) { return RC::UNIMPLEMENTED; }
-
-RC ObLsmImpl::remove(const string_view &key) { return RC::UNIMPLEMENTED; }
+RC ObLsmImpl::check_conflict_locked(const vector<pair<string, string>> &kvs, uint64_t snapshot_seq)
+{
+  vector<unique_ptr<ObLsmIterator>> iters;
+  iters.emplace_back(mem_table_->new_iterator());
+  if (!imem_tables_.empty()) {
+    iters.emplace_back(imem_tables_.back()->new_iterator());
+  }
+  for (auto &level : *sstables_) {
+    for (auto &sst : level) {
+      iters.emplace_back(sst->new_iterator());
+    }
+  }
+  unique_ptr<ObLsmIterator> iter(new_merging_iterator(&internal_key_comparator_, std::move(iters)));
+
+  // the newest version of a user key is the first entry of it, since internal keys are sorted by seq desc
+  string lookup_key;
+  for (const auto &[key, value] : kvs) {
+    lookup_key.clear();
+    put_numeric<uint64_t>(&lookup_key, key.size() + SEQ_SIZE);
+    lookup_key.append(key);
+    put_numeric<uint64_t>(&lookup_key, numeric_limits<uint64_t>::max());
+    iter->seek(lookup_key);
+    if (iter->valid() && extract_user_key(iter->key()) == key && extract_sequence(iter->key()) > snapshot_seq) {
+      LOG_TRACE("write conflict. key=%s, seq=%lu, snapshot seq=%lu",
+                key.c_str(), extract_sequence(iter->key()), snapshot_seq);
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
+    }
+  }
+  return RC::SUCCESS;
+}
 
 RC ObLsmImpl::try_freeze_memtable()
 {
@@ -314,9 +389,8 @@ string ObLsmImpl::get_wal_path(uint64_t memtable_id)
 
 RC ObLsmImpl::get(const string_view &key, string *value)
 {
-  RC                 rc = RC::SUCCESS;
-  unique_lock<mutex> lock(mu_);
-  auto               iter = unique_ptr<ObLsmIterator>(new_iterator(ObLsmReadOptions{}));
+  RC   rc   = RC::SUCCESS;
+  auto iter = unique_ptr<ObLsmIterator>(new_iterator(ObLsmReadOptions{}));
   iter->seek(key);
   if (iter->valid() && iter->key() == key) {
     if (iter->value().empty()) {
@@ -343,6 +417,8 @@ ObLsmIterator *ObLsmImpl::new_iterator(ObLsmReadOptions options)
   for (auto &level : *sstables_) {
     sstables.insert(sstables.end(), level.begin(), level.end());
   }
+  // take the snapshot together with the tables, a batch is published only after it is in the memtable
+  const uint64_t seq = options.seq == -1 ? seq_.load() : options.seq;
   lock.unlock();
   vector<unique_ptr<ObLsmIterator>> iters;
   iters.emplace_back(mem->new_iterator());
@@ -353,8 +429,7 @@ ObLsmIterator *ObLsmImpl::new_iterator(ObLsmReadOptions options)
     iters.emplace_back(sst->new_iterator());
   }
 
-  return new_user_iterator(
-      new_merging_iterator(&internal_key_comparator_, std::move(iters)), options.seq == -1 ? seq_.load() : options.seq);
+  return new_user_iterator(new_merging_iterator(&internal_key_comparator_, std::move(iters)), seq);
 }
 
 ObLsmTransaction *ObLsmImpl::begin_transaction() { return new ObLsmTransaction(this, seq_.load()); }
@@ -62,6 +62,7 @@ public:
 
   RC recover();
   RC batch_put(const std::vector<pair<string, string>> &kvs) override;
+  RC batch_put_if_unmodified(const vector<pair<string, string>> &kvs, uint64_t snapshot_seq) override;
 
   // used for debug
   void dump_sstables() override;
@@ -74,6 +75,22 @@ private:
   RC write_manifest_snapshot();
 
 private:
+  /**
+   * @brief Writes entries with consecutive sequence numbers. The caller must hold `mu_`.
+   *
+   * The entries are written to the WAL as one record and `seq_` is published after all
+   * entries are in the MemTable, so both recovery and readers see the whole batch or nothing
+   * of it. After a WAL write fails, all later writes fail with the same error.
+   */
+  RC write_batch_locked(unique_lock<mutex> &lock, const vector<pair<string_view, string_view>> &kvs);
+
+  /**
+   * @brief Checks whether any key has a version newer than `snapshot_seq`. The caller must hold `mu_`.
+   *
+   * @return RC::LOCKED_CONCURRENCY_CONFLICT if a newer version exists.
+   */
+  RC check_conflict_locked(const vector<pair<string, string>> &kvs, uint64_t snapshot_seq);
+
   /**
    * @brief Attempts to freeze the current active MemTable.
    *
@@ -168,7 +185,8 @@ private:
   SSTablesPtr                       sstables_;
   common::ThreadPoolExecutor        executor_;
   ObManifest                        manifest_;
-  atomic<uint64_t>                  seq_{0};
+  atomic<uint64_t>                  seq_{0};  ///< the last sequence number that has been written
+  RC                                wal_rc_ = RC::SUCCESS;  ///< the error of the first failed WAL write, protected by `mu_`
   atomic<uint64_t>                  sstable_id_{0};
   atomic<uint64_t>                  memtable_id_{0};
   condition_variable                cv_;
@@ -16,9 +16,10 @@ namespace oceanbase {
 
 /**
  * @brief merge TrxInnerMapIterator and ObUserIterator
- * @details Merges two iterators of different types into one.
- * If the two iterators have the same key, only
- * produce the key once and prefer the entry from left.
+ * @details Merges the write set of a transaction (left) with the snapshot of the database (right).
+ * If the two iterators have the same key, only produce the key once and prefer the entry from left.
+ * Keys removed by the transaction are skipped; the snapshot iterator already skips the deleted keys
+ * of the database. Only forward iteration is supported, `seek_to_last` leaves the iterator invalid.
  */
 class TrxIterator : public ObLsmIterator
 {
@@ -26,36 +27,118 @@ public:
   TrxIterator(ObLsmIterator *left, ObLsmIterator *right) : left_(left), right_(right) {}
   ~TrxIterator() override = default;
 
-  bool valid() const override { return false; }
-  void seek_to_first() override {}
-  void seek_to_last() override {}
-  void seek(const string_view &key) override {}
-  void next() override {}
+  bool valid() const override { return current_ != nullptr; }
+  void seek_to_first() override
+  {
+    left_->seek_to_first();
+    right_->seek_to_first();
+    find_next_entry();
+  }
+  void seek_to_last() override { current_ = nullptr; }
+  void seek(const string_view &key) override
+  {
+    left_->seek(key);
+    right_->seek(key);
+    find_next_entry();
+  }
+  void next() override
+  {
+    current_->next();
+    find_next_entry();
+  }
 
-  string_view key() const override { return ""; }
-  string_view value() const override { return ""; }
+  string_view key() const override { return current_->key(); }
+  string_view value() const override { return current_->value(); }
+
+private:
+  void find_next_entry()
+  {
+    while (left_->valid()) {
+      int r = right_->valid() ? comparator_.compare(left_->key(), right_->key()) : -1;
+      if (r > 0) {
+        current_ = right_.get();
+        return;
+      }
+
+      if (r == 0) {
+        right_->next();
+      }
+      if (!left_->value().empty()) {
+        current_ = left_.get();
+        return;
+      }
+      left_->next();
+    }
+
+    current_ = right_->valid() ? right_.get() : nullptr;
+  }
 
 private:
   unique_ptr<ObLsmIterator> left_;
   unique_ptr<ObLsmIterator> right_;
+  ObLsmIterator            *current_ = nullptr;
+  ObDefaultComparator       comparator_;
 };
 
-ObLsmTransaction::ObLsmTransaction(ObLsm *db, uint64_t ts) : db_(db), ts_(ts)
+ObLsmTransaction::ObLsmTransaction(ObLsm *db, uint64_t ts) : db_(db), ts_(ts) {}
+
+RC ObLsmTransaction::get(const string_view &key, string *value)
 {
-  (void)db_;
-  (void)ts_;
+  auto iter = inner_store_.find(string(key));
+  if (iter != inner_store_.end()) {
+    if (iter->second.empty()) {
+      return RC::NOT_EXIST;
+    }
+    value->assign(iter->second);
+    return RC::SUCCESS;
+  }
+
+  ObLsmReadOptions options;
+  options.seq = static_cast<int64_t>(ts_);
+  unique_ptr<ObLsmIterator> db_iter(db_->new_iterator(options));
+  db_iter->seek(key);
+  if (db_iter->valid() && db_iter->key() == key) {
+    value->assign(db_iter->value());
+    return RC::SUCCESS;
+  }
+  return RC::NOT_EXIST;
 }
 
-RC ObLsmTransaction::get(const string_view &key, string *value) { return RC::UNIMPLEMENTED; }
+RC ObLsmTransaction::put(const string_view &key, const string_view &value)
+{
+  inner_store_[string(key)] = string(value);
+  return RC::SUCCESS;
+}
 
-RC ObLsmTransaction::put(const string_view &key, const string_view &value) { return RC::UNIMPLEMENTED; }
+RC ObLsmTransaction::remove(const string_view &key)
+{
+  inner_store_[string(key)].clear();
+  return RC::SUCCESS;
+}
 
-RC ObLsmTransaction::remove(const string_view &key) { return RC::UNIMPLEMENTED; }
+ObLsmIterator *ObLsmTransaction::new_iterator(ObLsmReadOptions options)
+{
+  if (options.seq == -1) {
+    options.seq = static_cast<int64_t>(ts_);
+  }
+  return new TrxIterator(new TrxInnerMapIterator(inner_store_), db_->new_iterator(options));
+}
 
-ObLsmIterator *ObLsmTransaction::new_iterator(ObLsmReadOptions options) { return nullptr; }
+RC ObLsmTransaction::commit()
+{
+  if (inner_store_.empty()) {
+    return RC::SUCCESS;
+  }
 
-RC ObLsmTransaction::commit() { return RC::UNIMPLEMENTED; }
+  vector<pair<string, string>> kvs(inner_store_.begin(), inner_store_.end());
+  inner_store_.clear();
+  return db_->batch_put_if_unmodified(kvs, ts_);
+}
 
-RC ObLsmTransaction::rollback() { return RC::UNIMPLEMENTED; }
+RC ObLsmTransaction::rollback()
+{
+  inner_store_.clear();
+  return RC::SUCCESS;
+}
 
 }  // namespace oceanbase
@@ -18,7 +18,7 @@ RC WAL::recover(const std::string &wal_file, std::vector<WalRecord> &wal_records
   return RC::UNIMPLEMENTED;
 }
 
-RC WAL::put(uint64_t seq, string_view key, string_view val)
+RC WAL::put_batch(uint64_t first_seq, const vector<pair<string_view, string_view>> &kvs)
 {
   return RC::UNIMPLEMENTED;
 }
@@ -14,6 +14,8 @@
 #pragma once
 
 #include "common/lang/mutex.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
 #include "common/sys/rc.h"
 #include "oblsm/util/ob_file_writer.h"
 
@@ -52,16 +54,25 @@ struct WalRecord
  *
  * ### Data Serialization Format:
  * The data is serialized as follows:
- * - Each entry in the WAL consists of a key-value pair.
- * - The data format is:
- *   - **Sequence Number (uint64_t)**: A 8-byte value representing the sequence of logs.
+ * - Each record in the WAL is a batch of key-value pairs with consecutive sequence numbers.
+ * - The record format is:
+ *   - **Payload Length (uint64_t)**: A 8-byte value representing the length of the payload.
+ *   - **Checksum (uint32_t)**: The crc32 of the payload.
+ *   - **Payload**: The first sequence number (uint64_t) and the entry count (uint64_t),
+ *     followed by the entries.
+ * - Each entry in the payload consists of a key-value pair:
  *   - **Key Length (size_t)**: A value representing the length of the key.
  *   - **Key (string)**: The actual key, as a string.
  *   - **Value Length (size_t)**: A value representing the length of the value.
  *   - **Value (string)**: The actual value, as a string.
  *
- * The data is written to the file in the order: key length, key, value length, value.
+ * The entries are written to the file in the order: key length, key, value length, value.
+ * The sequence number of the i-th entry is the first sequence number plus i.
  * After writing the data, the system performs a `flush()` operation to ensure the data is persisted.
+ *
+ * A batch is recovered either whole or not at all. If the last record is truncated or
+ * its checksum does not match (e.g. a crash in the middle of a write), recovery stops
+ * before it and none of its entries are replayed.
  */
 class WAL
 {
@@ -92,6 +103,7 @@ public:
    *
    * This function reads the given WAL file, extracts key-value pairs, and stores them in the provided vector.
    * It also returns the total number of records read from the WAL.
+   * Only entries of complete batch records are returned, see the serialization format above.
    *
    * @param wal_file The name of the WAL file to recover from.
    * @param wal_records A reference to a vector where the WalRecord objects will be stored.
@@ -102,14 +114,27 @@ public:
   /**
    * @brief Writes a key-value pair to the WAL.
    *
-   * This function serializes the key-value pair and appends it to the WAL file.
+   * This function writes a batch record with a single entry.
    *
    * @param seq The sequence number of the record.
    * @param key The key to write.
    * @param val The value associated with the key.
    * @return `RC::SUCCESS` if the write operation is successful, or an error code if it fails.
    */
-  RC put(uint64_t seq, std::string_view key, std::string_view val);
+  RC put(uint64_t seq, std::string_view key, std::string_view val) { return put_batch(seq, {{key, val}}); }
+
+  /**
+   * @brief Writes key-value pairs with consecutive sequence numbers as one record.
+   *
+   * This function serializes all the key-value pairs into one batch record and appends it to
+   * the WAL file, so that recovery replays either all of them or none of them.
+   *
+   * @param first_seq The sequence number of the first key-value pair.
+   * @param kvs The key-value pairs to write.
+   * @return `RC::SUCCESS` if the write operation is successful, or an error code if it fails.
+   * If it fails, part of the record may have been written.
+   */
+  RC put_batch(uint64_t first_seq, const std::vector<std::pair<std::string_view, std::string_view>> &kvs);
 
   /**
    * @brief Synchronizes the WAL to disk.
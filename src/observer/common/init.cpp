@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/string.h"
 #include "common/lang/iostream.h"
 #include "common/log/log.h"
+#include "common/math/simd_util.h"
 #include "common/os/path.h"
 #include "common/os/pidfile.h"
 #include "common/os/process.h"
@@ -199,6 +200,7 @@ int init(ProcessParam *process_param)
   string conf_data;
   get_properties()->to_string(conf_data);
   LOG_INFO("Output configuration \n%s", conf_data.c_str());
+  LOG_INFO("SIMD level: %s", simd_level_name(simd_level()));
 
   rc = init_global_objects(process_param, *get_properties());
   if (rc != 0) {
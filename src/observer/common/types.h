@@ -30,6 +30,10 @@ using LSN = int64_t;
 
 #define LSN_FORMAT PRId64
 
+/// 事务ID。事务ID和提交ID从同一个计数器中分配，记录上用负数表示还没有提交的事务，
+/// 所以是有符号的64位整数，不会回绕
+using TrxID = int64_t;
+
 /**
  * @brief 读写模式
  * @details 原来的代码中有大量的true/false来表示是否只读，这种代码不易于阅读
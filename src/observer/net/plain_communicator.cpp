@@ -363,7 +363,8 @@ RC PlainCommunicator::write_chunk_result(SqlResult *sql_result)
       header_printed = true;
     }
     int col_num = chunk.column_num();
-    for (int row_idx = 0; row_idx < chunk.rows(); row_idx++) {
+    // 按照选择向量输出，这时才读取有效的行
+    for (int row_idx = 0; row_idx < chunk.selected_rows(); row_idx++) {
       for (int col_idx = 0; col_idx < col_num; col_idx++) {
         if (col_idx != 0) {
           const char *delim = " | ";
@@ -376,7 +377,7 @@ RC PlainCommunicator::write_chunk_result(SqlResult *sql_result)
           }
         }
 
-        Value value = chunk.get_value(col_idx, row_idx);
+        Value value = chunk.get_value(col_idx, chunk.row_index(row_idx));
 
         string cell_str = value.to_string();
 
@@ -73,6 +73,9 @@ Trx *Session::current_trx()
   if (trx_ == nullptr) {
     trx_ = db_->trx_kit().create_trx(db_->log_handler());
   }
+  if (lock_wait_timeout_ms_ >= 0) {
+    trx_->set_lock_wait_timeout(lock_wait_timeout_ms_);
+  }
   return trx_;
 }
 
@@ -86,8 +86,23 @@ public:
   bool hash_join_on() const { return hash_join_; }
 
   void set_use_cascade(bool use_cascade) { use_cascade_ = use_cascade; }
+
+  /**
+   * @brief 设置等待行锁的最长时间(毫秒)，对当前会话之后的语句生效
+   */
+  void set_lock_wait_timeout(int timeout_ms) { lock_wait_timeout_ms_ = timeout_ms; }
+  int  lock_wait_timeout() const { return lock_wait_timeout_ms_; }
   bool use_cascade() const { return use_cascade_; }
 
+  /// 并行度的最大值
+  static constexpr int MAX_PARALLEL_DEGREE = 64;
+
+  /**
+   * @brief 设置查询的并行度，即向量化执行时扫描和聚合使用的线程个数
+   */
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+  int  parallel_degree() const { return parallel_degree_; }
+
   void          set_execution_mode(const ExecutionMode mode) { execution_mode_ = mode; }
   ExecutionMode get_execution_mode() const { return execution_mode_; }
 
@@ -118,6 +133,10 @@ private:
   bool hash_join_   = false;  ///< 是否使用hash join
   bool use_cascade_ = false;  ///< 是否使用 cascade 优化器
 
+  int lock_wait_timeout_ms_ = -1;  ///< 等待行锁的最长时间，小于0时使用事务的默认值
+
+  int parallel_degree_ = 1;  ///< 查询的并行度，1 表示只使用会话线程
+
   // 是否使用了 `chunk_iterator` 模式。 只有在设置了 `chunk_iterator`
   // 并且可以生成相关物理执行计划时才会使用 `chunk_iterator` 模式。
   bool used_chunk_mode_ = false;
@@ -18,7 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/db/db.h"
 #include "storage/table/table.h"
 #include "catalog/catalog.h"
-#include "storage/record/record_scanner.h"
+#include "sql/optimizer/statistics/table_statistics.h"
 
 using namespace std;
 
@@ -39,34 +39,24 @@ RC AnalyzeTableExecutor::execute(SQLStageEvent *sql_event)
   Db    *db    = session->get_current_db();
   Table *table = db->find_table(table_name);
   if (table != nullptr) {
-    // TODO: optimize the analyze table compute. we can only get table statistics from metadata
-    // Don't really scan the whole table!!
-    int table_id = table->table_id();
-    table->get_record_scanner(scanner_, session->current_trx(), ReadWriteMode::READ_ONLY);
-    Record dummy;
-    int row_nums = 0;
-    while (OB_SUCC(rc = scanner_->next(dummy))) {
-      row_nums++;
+    auto statistics = make_shared<TableStatistics>();
+    rc = TableStatistics::collect(table, session->current_trx(), TableStatistics::DEFAULT_SAMPLE_PAGES, *statistics);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to collect statistics. table=%s, rc=%s", table_name, strrc(rc));
+      return rc;
     }
-    if (rc == RC::RECORD_EOF) {
-      rc = RC::SUCCESS;
-    } else {
+
+    const int row_num = static_cast<int>(statistics->row_num() + 0.5);
+    if (OB_FAIL(rc = table->update_statistics(std::move(statistics)))) {
+      LOG_WARN("failed to save statistics. table=%s, rc=%s", table_name, strrc(rc));
       return rc;
     }
-  
-    TableStats stats(row_nums);
-    Catalog::get_instance().update_table_stats(table_id, stats);
+
+    TableStats stats(row_num);
+    Catalog::get_instance().update_table_stats(table->table_id(), stats);
   } else {
     sql_result->set_return_code(RC::SCHEMA_TABLE_NOT_EXIST);
     sql_result->set_state_string("Table not exists");
   }
   return rc;
 }
-
-AnalyzeTableExecutor::~AnalyzeTableExecutor() 
-{
-  if (scanner_ != nullptr) {
-    delete scanner_;
-    scanner_ = nullptr;
-  }
-}
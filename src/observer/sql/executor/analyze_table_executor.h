@@ -13,20 +13,17 @@ See the Mulan PSL v2 for more details. */
 #include "common/sys/rc.h"
 
 class SQLStageEvent;
-class RecordScanner;
 
 /**
  * @brief 分析表的执行器(analyze table)
  * @ingroup Executor
+ * @details 采样表中的数据收集统计信息，保存到表的元数据中，参考 TableStatistics
  */
 class AnalyzeTableExecutor
 {
 public:
-  AnalyzeTableExecutor() = default;
-  virtual ~AnalyzeTableExecutor();
+  AnalyzeTableExecutor()          = default;
+  virtual ~AnalyzeTableExecutor() = default;
 
   RC execute(SQLStageEvent *sql_event);
-
-private:
-  RecordScanner *scanner_ = nullptr;
 };
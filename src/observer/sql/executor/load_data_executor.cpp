@@ -13,12 +13,15 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/executor/load_data_executor.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/string.h"
 #include "event/session_event.h"
 #include "event/sql_event.h"
 #include "sql/executor/sql_result.h"
 #include "sql/stmt/load_data_stmt.h"
 #include "storage/common/chunk.h"
+#include "storage/table/table.h"
+#include "common/lang/thread.h"
 
 using namespace common;
 
@@ -34,17 +37,78 @@ RC LoadDataExecutor::execute(SQLStageEvent *sql_event)
 }
 
 /**
- * 从文件中导入数据时使用。尝试向表中插入解析后的一行数据。
+ * @brief 文件数据的格式
+ */
+struct LoadDataFormat
+{
+  char terminated;  ///< 字段之间的分隔符
+  char enclosed;    ///< 字段的修饰符，修饰符之间的分隔符和换行符都是字段内容
+};
+
+/**
+ * @brief 找到从 pos 开始的一行数据的结束位置
+ * @details 修饰符内的换行符属于字段内容，不会结束一行
+ * @return 行尾的换行符位置，如果直到 end 都没有结束，返回 end
+ */
+static const char *find_line_end(const char *pos, const char *end, char enclosed)
+{
+  bool in_enclosed = false;
+  for (; pos < end; pos++) {
+    if (*pos == enclosed) {
+      in_enclosed = !in_enclosed;
+    } else if (*pos == '\n' && !in_enclosed) {
+      return pos;
+    }
+  }
+  return end;
+}
+
+/**
+ * @brief 按照分隔符和修饰符拆分一行数据
+ * @details 修饰符内连续两个修饰符表示一个修饰符字符
+ */
+static void split_line(const char *begin, const char *end, const LoadDataFormat &format, vector<string> &fields)
+{
+  fields.clear();
+  if (begin < end && *(end - 1) == '\r') {
+    end--;
+  }
+
+  string field;
+  bool   in_enclosed = false;
+  for (const char *pos = begin; pos < end; pos++) {
+    const char c = *pos;
+    if (in_enclosed) {
+      if (c != format.enclosed) {
+        field.push_back(c);
+      } else if (pos + 1 < end && *(pos + 1) == format.enclosed) {
+        field.push_back(c);
+        pos++;
+      } else {
+        in_enclosed = false;
+      }
+    } else if (c == format.enclosed) {
+      in_enclosed = true;
+    } else if (c == format.terminated) {
+      fields.push_back(std::move(field));
+      field.clear();
+    } else {
+      field.push_back(c);
+    }
+  }
+  fields.push_back(std::move(field));
+}
+
+/**
+ * 从文件中导入数据时使用。将解析后的一行数据转换成表的一条记录。
  * @param table  要导入的表
  * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
- * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
- * @param errmsg 如果出现错误，通过这个参数返回错误信息
+ * @param record_values Table::make_record使用的参数，为了防止频繁的申请内存
+ * @param record 返回转换后的记录
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(
-    Table *table, vector<string> &file_values, vector<Value> &record_values, stringstream &errmsg)
+static RC make_record_from_file(Table *table, vector<string> &file_values, vector<Value> &record_values, Record &record)
 {
-
   const int field_num     = record_values.size();
   const int sys_field_num = table->table_meta().sys_field_num();
 
@@ -54,7 +118,6 @@ RC insert_record_from_file(
 
   RC rc = RC::SUCCESS;
 
-  stringstream deserialize_stream;
   for (int i = 0; i < field_num && RC::SUCCESS == rc; i++) {
     const FieldMeta *field = table->table_meta().field(i + sys_field_num);
 
@@ -69,23 +132,211 @@ RC insert_record_from_file(
     }
   }
 
-  if (RC::SUCCESS == rc) {
-    Record record;
-    rc = table->make_record(field_num, record_values.data(), record);
-    if (rc != RC::SUCCESS) {
-      errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
-      errmsg << "insert failed.";
+  return table->make_record(field_num, record_values.data(), record);
+}
+
+/**
+ * @brief 导入时，一个线程负责解析的一段文件数据
+ * @details 每段数据都由完整的行组成。行存表的解析结果是逐行插入的，PAX 表的解析结果按行的顺序保存在多个 Chunk 中
+ */
+struct LoadDataPartition
+{
+  const char *begin = nullptr;
+  const char *end   = nullptr;
+
+  vector<unique_ptr<Chunk>> chunks;
+  int                       line_num        = 0;  ///< 已经解析的行数，包括空行
+  int                       insertion_count = 0;  ///< 行存表逐行插入成功的行数
+  RC                        rc              = RC::SUCCESS;
+};
+
+static unique_ptr<Chunk> make_load_chunk(const TableMeta &table_meta)
+{
+  auto chunk = make_unique<Chunk>();
+  for (int i = 0; i < table_meta.field_num(); i++) {
+    const FieldMeta *field = table_meta.field(i);
+    chunk->add_column(make_unique<Column>(*field, Chunk::MAX_ROWS), i);
+  }
+  return chunk;
+}
+
+/**
+ * @brief 解析一段文件数据
+ * @details PAX 表转换成按列存放的 Chunk，行存表直接逐行插入。
+ * 遇到错误时停止解析，出错之前的数据仍然保留或已经插入。
+ */
+static void parse_partition(Table *table, const LoadDataFormat &format, LoadDataPartition &partition)
+{
+  const TableMeta &table_meta    = table->table_meta();
+  const int        sys_field_num = table_meta.sys_field_num();
+  const bool       use_chunk     = table_meta.storage_format() == StorageFormat::PAX_FORMAT;
+
+  vector<Value>  record_values(table_meta.field_num() - sys_field_num);
+  vector<string> file_values;
+  Record         record;
+
+  unique_ptr<Chunk> chunk = use_chunk ? make_load_chunk(table_meta) : nullptr;
+  const char       *pos   = partition.begin;
+  while (pos < partition.end) {
+    const char *line_end = find_line_end(pos, partition.end, format.enclosed);
+    const char *line     = pos;
+    pos                  = line_end + 1;
+    partition.line_num++;
+
+    if (common::is_blank(string(line, line_end).c_str())) {
+      continue;
+    }
+
+    split_line(line, line_end, format, file_values);
+    partition.rc = make_record_from_file(table, file_values, record_values, record);
+    if (OB_FAIL(partition.rc)) {
+      break;
+    }
+
+    if (!use_chunk) {
+      partition.rc = table->insert_record(record);
+      if (OB_FAIL(partition.rc)) {
+        break;
+      }
+      partition.insertion_count++;
+      continue;
+    }
+
+    if (chunk->rows() == Chunk::MAX_ROWS) {
+      partition.chunks.push_back(std::move(chunk));
+      chunk = make_load_chunk(table_meta);
+    }
+    for (int i = 0; i < table_meta.field_num(); i++) {
+      chunk->column(i).append_one(record.data() + table_meta.field(i)->offset());
     }
   }
-  return rc;
+
+  if (chunk != nullptr && chunk->rows() > 0) {
+    partition.chunks.push_back(std::move(chunk));
+  }
 }
 
+/**
+ * @brief 将一块文件数据按行切分成多段
+ * @param eof 是否已经读到文件末尾，如果不是，最后一行不完整的数据留给下一块
+ * @return 切分出去的数据长度，剩余的数据不足一行
+ */
+static size_t split_block(const char *data, size_t size, bool eof, char enclosed, int partition_num,
+    vector<LoadDataPartition> &partitions)
+{
+  const char *end       = data + size;
+  const char *begin     = data;
+  const char *pos       = data;
+  const char *block_end = data;
+  size_t      target    = size / partition_num;
+
+  partitions.clear();
+  while (pos < end) {
+    const char *line_end = find_line_end(pos, end, enclosed);
+    if (line_end == end && !eof) {
+      break;
+    }
+
+    pos       = std::min(line_end + 1, end);
+    block_end = pos;
+    if (static_cast<size_t>(pos - data) >= target && static_cast<int>(partitions.size()) < partition_num - 1) {
+      partitions.emplace_back();
+      partitions.back().begin = begin;
+      partitions.back().end   = pos;
+      begin                   = pos;
+      target += size / partition_num;
+    }
+  }
+
+  if (begin < block_end) {
+    partitions.emplace_back();
+    partitions.back().begin = begin;
+    partitions.back().end   = block_end;
+  }
+  return block_end - data;
+}
+
+/**
+ * @brief 按块读取文件，多线程解析，再写入表中
+ * @details PAX 表解析成 Chunk 后通过 Table::insert_chunk 整页写入，只记录页面级别的日志。
+ * 行存表逐行插入，由于插入顺序要与文件一致，只使用一个线程。
+ * 调用者需要先调用 Table::begin_bulk_insert，空的索引在 Table::end_bulk_insert 时自底向上构建。
+ */
+static RC load_data_in_blocks(
+    Table *table, fstream &fs, const LoadDataFormat &format, int &insertion_count, stringstream &result_string)
+{
+  const TableMeta &table_meta    = table->table_meta();
+  int              partition_num = 1;
+  if (table_meta.storage_format() == StorageFormat::PAX_FORMAT) {
+    partition_num = std::clamp(static_cast<int>(thread::hardware_concurrency()), 1, LoadDataExecutor::MAX_THREADS);
+    // TextManager 不支持并发写入，包含长文本字段时只能单线程解析
+    for (int i = 0; i < table_meta.field_num(); i++) {
+      if (table_meta.field(i)->type() == AttrType::TEXTS) {
+        partition_num = 1;
+        break;
+      }
+    }
+  }
+
+  RC                        rc       = RC::SUCCESS;
+  int                       line_num = 0;
+  vector<char>              buffer;
+  size_t                    remain = 0;  ///< 上一块中没有读完整的行，保留在 buffer 的最前面
+  vector<LoadDataPartition> partitions;
+  while (RC::SUCCESS == rc) {
+    buffer.resize(remain + LoadDataExecutor::BLOCK_SIZE);
+    fs.read(buffer.data() + remain, LoadDataExecutor::BLOCK_SIZE);
+    const size_t read_size = remain + fs.gcount();
+    const bool   eof       = fs.eof() || fs.fail();
+    if (read_size == 0) {
+      break;
+    }
+
+    const size_t block_size = split_block(buffer.data(), read_size, eof, format.enclosed, partition_num, partitions);
+
+    vector<thread> threads;
+    for (size_t i = 1; i < partitions.size(); i++) {
+      threads.emplace_back(parse_partition, table, std::cref(format), std::ref(partitions[i]));
+    }
+    if (!partitions.empty()) {
+      parse_partition(table, format, partitions[0]);
+    }
+    for (thread &t : threads) {
+      t.join();
+    }
+
+    for (LoadDataPartition &partition : partitions) {
+      insertion_count += partition.insertion_count;
+      for (unique_ptr<Chunk> &chunk : partition.chunks) {
+        rc = table->insert_chunk(*chunk);
+        if (OB_FAIL(rc)) {
+          result_string << "Line:" << line_num + partition.line_num << " insert chunk failed. error:" << strrc(rc)
+                        << endl;
+          break;
+        }
+        insertion_count += chunk->rows();
+      }
+      line_num += partition.line_num;
+      if (OB_SUCC(rc) && OB_FAIL(partition.rc)) {
+        rc = partition.rc;
+        result_string << "Line:" << line_num << " insert record failed:insert failed.. error:" << strrc(rc) << endl;
+      }
+      if (OB_FAIL(rc)) {
+        break;
+      }
+    }
+
+    if (eof) {
+      break;
+    }
+    remain = read_size - block_size;
+    memmove(buffer.data(), buffer.data() + block_size, remain);
+  }
+  return rc;
+}
 
-// TODO: pax format and row format
 void LoadDataExecutor::load_data(Table *table, const char *file_name, char terminated, char enclosed, SqlResult *sql_result)
 {
-  // your code here
   stringstream result_string;
 
   fstream fs;
@@ -99,43 +350,29 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, char termi
 
   struct timespec begin_time;
   clock_gettime(CLOCK_MONOTONIC, &begin_time);
-  const int sys_field_num = table->table_meta().sys_field_num();
-  const int field_num     = table->table_meta().field_num() - sys_field_num;
-
-  vector<Value>       record_values(field_num);
-  string              line;
-  vector<string> file_values;
-  const string        delim("|");
-  int                      line_num        = 0;
-  int                      insertion_count = 0;
-  RC                       rc              = RC::SUCCESS;
-  while (!fs.eof() && RC::SUCCESS == rc) {
-    getline(fs, line);
-    line_num++;
-    if (common::is_blank(line.c_str())) {
-      continue;
-    }
 
-    file_values.clear();
-    common::split_string(line, delim, file_values);
-    stringstream errmsg;
+  int insertion_count = 0;
+  RC  rc              = RC::SUCCESS;
+  if (table->table_meta().storage_format() == StorageFormat::ROW_FORMAT ||
+      table->table_meta().storage_format() == StorageFormat::PAX_FORMAT) {
+    LoadDataFormat format{terminated, enclosed};
+    rc = table->begin_bulk_insert();
+    if (OB_SUCC(rc)) {
+      rc = load_data_in_blocks(table, fs, format, insertion_count, result_string);
 
-    if (table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
-      rc = insert_record_from_file(table, file_values, record_values, errmsg);
-      if (rc != RC::SUCCESS) {
-        result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
-                      << endl;
-      } else {
-        insertion_count++;
+      // 空的索引在导入结束之后一次构建，构建失败时导入的数据全部删除
+      RC index_rc = table->end_bulk_insert();
+      if (OB_FAIL(index_rc)) {
+        result_string << "Failed to build indexes, all loaded rows are removed. error:" << strrc(index_rc) << endl;
+        insertion_count = 0;
+        rc              = OB_SUCC(rc) ? index_rc : rc;
       }
-    } else if (table->table_meta().storage_format() == StorageFormat::PAX_FORMAT) {
-      // your code here
-      // Todo: 参照insert_record_from_file实现
-      rc = RC::UNIMPLEMENTED;
     } else {
-      rc = RC::UNSUPPORTED;
-      result_string << "Unsupported storage format: " << strrc(rc) << endl;
+      result_string << "Failed to begin bulk insert. error:" << strrc(rc) << endl;
     }
+  } else {
+    rc = RC::UNSUPPORTED;
+    result_string << "Unsupported storage format: " << strrc(rc) << endl;
   }
   fs.close();
 
@@ -144,6 +381,7 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, char termi
   if (RC::SUCCESS == rc) {
     result_string << strrc(rc);
   }
-  LOG_INFO("load data done. row num: %s, result: %s", insertion_count, strrc(rc));
+  const long cost_ms = (end_time.tv_sec - begin_time.tv_sec) * 1000 + (end_time.tv_nsec - begin_time.tv_nsec) / 1000000;
+  LOG_INFO("load data done. row num: %d, cost: %ld ms, result: %s", insertion_count, cost_ms, strrc(rc));
   sql_result->set_return_code(RC::SUCCESS);
 }
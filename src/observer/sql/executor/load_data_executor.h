@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stddef.h>
+
 #include "common/sys/rc.h"
 
 class SQLStageEvent;
@@ -32,6 +34,9 @@ public:
 
   RC execute(SQLStageEvent *sql_event);
 
+  static constexpr size_t BLOCK_SIZE  = 16 * 1024 * 1024;  ///< 批量导入时每次从文件中读取的数据量
+  static constexpr int    MAX_THREADS = 8;                 ///< 批量导入时解析数据的最大线程数
+
 private:
   void load_data(Table *table, const char *file_name, char terminated, char enclosed, SqlResult *sql_result);
 };
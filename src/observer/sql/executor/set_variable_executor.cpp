@@ -50,6 +50,22 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
           session->set_use_cascade(bool_value);
           LOG_TRACE("set use_cascade to %d", bool_value);
         }
+      } else if (strcasecmp(var_name, "lock_wait_timeout") == 0) {
+        // 单位是毫秒，0 表示遇到行锁冲突时不等待
+        if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 0) {
+          session->set_lock_wait_timeout(var_value.get_int());
+          LOG_TRACE("set lock_wait_timeout to %d", var_value.get_int());
+        } else {
+          rc = RC::VARIABLE_NOT_VALID;
+        }
+      } else if (strcasecmp(var_name, "parallel_degree") == 0) {
+        if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 1 &&
+            var_value.get_int() <= Session::MAX_PARALLEL_DEGREE) {
+          session->set_parallel_degree(var_value.get_int());
+          LOG_TRACE("set parallel_degree to %d", var_value.get_int());
+        } else {
+          rc = RC::VARIABLE_NOT_VALID;
+        }
       } else {
       rc = RC::VARIABLE_NOT_EXISTS;
     }
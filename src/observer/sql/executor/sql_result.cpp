@@ -30,7 +30,8 @@ RC SqlResult::open()
 
   Trx *trx = session_->current_trx();
   trx->start_if_need();
-  return operator_->open(trx);
+  open_rc_ = operator_->open(trx);
+  return open_rc_;
 }
 
 RC SqlResult::close()
@@ -46,7 +47,8 @@ RC SqlResult::close()
   operator_.reset();
 
   if (session_ && !session_->is_trx_multi_operation_mode()) {
-    if (rc == RC::SUCCESS) {
+    // 执行失败(比如等锁超时)时，语句可能只做了一部分，不能提交
+    if (rc == RC::SUCCESS && open_rc_ == RC::SUCCESS) {
       rc = session_->current_trx()->commit();
     } else {
       RC rc2 = session_->current_trx()->rollback();
@@ -55,6 +57,13 @@ RC SqlResult::close()
       }
     }
     session_->destroy_trx();
+  } else if (session_ && open_rc_ == RC::LOCKED_DEADLOCK) {
+    // 死锁时回滚整个事务，释放它持有的行锁，让其它事务可以继续
+    LOG_INFO("rollback trx because of deadlock. trx id=%ld", session_->current_trx()->id());
+    RC rc2 = session_->current_trx()->rollback();
+    if (rc2 != RC::SUCCESS) {
+      LOG_PANIC("rollback failed. rc=%s", strrc(rc2));
+    }
   }
   return rc;
 }
@@ -55,5 +55,6 @@ private:
   unique_ptr<PhysicalOperator> operator_;           ///< 执行计划
   TupleSchema                  tuple_schema_;       ///< 返回的表头信息。可能有也可能没有
   RC                           return_code_ = RC::SUCCESS;
+  RC                           open_rc_     = RC::SUCCESS;  ///< 打开执行计划的结果，失败时不能提交事务
   string                       state_string_;
 };
@@ -15,11 +15,12 @@ See the Mulan PSL v2 for more details. */
 
 RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
 {
-    if (groups_chunk.rows() != aggrs_chunk.rows()) {
+  if (aggrs_chunk.column_num() > 0 && groups_chunk.rows() != aggrs_chunk.rows()) {
     LOG_WARN("groups_chunk and aggrs_chunk have different rows: %d, %d", groups_chunk.rows(), aggrs_chunk.rows());
     return RC::INVALID_ARGUMENT;
   }
-  for (int i = 0; i < groups_chunk.rows(); i++) {
+  for (int row = 0; row < groups_chunk.selected_rows(); row++) {
+    const int     i = groups_chunk.row_index(row);
     vector<Value> group_by_values;
     vector<void*> aggr_values;
 
@@ -41,7 +42,11 @@ RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk
     }
     auto &aggr = aggr_values_.find(group_by_values)->second;
     for (size_t aggr_idx = 0; aggr_idx < aggr.size(); aggr_idx++) {
-      RC rc = aggregate_state_update_by_value(aggr[aggr_idx], aggr_types_[aggr_idx], aggr_child_types_[aggr_idx], aggrs_chunk.get_value(aggr_idx, i));
+      const Value value = aggrs_chunk.get_value(aggr_idx, i);
+      if (value.is_null()) {
+        continue;
+      }
+      RC rc = aggregate_state_update_by_value(aggr[aggr_idx], aggr_types_[aggr_idx], aggr_child_types_[aggr_idx], value);
       if (rc != RC::SUCCESS) {
         LOG_WARN("update aggregate state failed");
         return rc;
@@ -115,175 +120,488 @@ bool StandardAggregateHashTable::VectorEqual::operator()(const vector<Value> &lh
 }
 
 // ----------------------------------LinearProbingAggregateHashTable------------------
-#ifdef USE_SIMD
-template <typename V>
-RC LinearProbingAggregateHashTable<V>::add_chunk(Chunk &group_chunk, Chunk &aggr_chunk)
+
+const int LinearProbingAggregateHashTable::DEFAULT_CAPACITY = 16384;
+
+static_assert(sizeof(string_t) == 16 && alignof(string_t) == 8, "string keys are stored as 16 bytes string_t");
+
+/// NULL 参与哈希计算时使用的值
+static constexpr int NULL_HASH_INPUT = static_cast<int>(0x9e3779b9U);
+
+/// 探测时提前读取后面的行对应的槽
+static constexpr int PREFETCH_DISTANCE = 8;
+
+static int align_up(int value, int alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+static bool is_constant(const Column &column) { return column.column_type() == Column::Type::CONSTANT_COLUMN; }
+
+/// -0.0 和 0.0 属于同一个分组
+static float normalize_float(float value) { return value == 0.0f ? 0.0f : value; }
+
+/// FNV-1a
+static uint32_t hash_bytes(const char *data, size_t len)
 {
-  if (group_chunk.column_num() != 1 || aggr_chunk.column_num() != 1) {
-    LOG_WARN("group_chunk and aggr_chunk size must be 1.");
-    return RC::INVALID_ARGUMENT;
+  uint32_t hash = 2166136261U;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= static_cast<uint8_t>(data[i]);
+    hash *= 16777619U;
   }
-  if (group_chunk.rows() != aggr_chunk.rows()) {
-    LOG_WARN("group_chunk and aggr _chunk rows must be equal.");
-    return RC::INVALID_ARGUMENT;
+  return hash;
+}
+
+/**
+ * @brief 把分组列的值转换成 32 位整数，再统一使用 simd_hash_epi32 计算哈希值
+ */
+static int hash_input(const Column &column, int row)
+{
+  if (column.is_null(row)) {
+    return NULL_HASH_INPUT;
+  }
+  const char *data = column.data() + static_cast<size_t>(row) * column.attr_len();
+  switch (column.attr_type()) {
+    case AttrType::FLOATS: {
+      const float value = normalize_float(*reinterpret_cast<const float *>(data));
+      int         bits  = 0;
+      memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+    case AttrType::BOOLEANS: return *data != 0;
+    case AttrType::CHARS: return static_cast<int>(hash_bytes(data, strnlen(data, column.attr_len())));
+    default: return *reinterpret_cast<const int *>(data);
   }
-  add_batch((int *)group_chunk.column(0).data(), (V *)aggr_chunk.column(0).data(), group_chunk.rows());
-  return RC::SUCCESS;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::Scanner::open_scan()
+LinearProbingAggregateHashTable::LinearProbingAggregateHashTable(const vector<Expression *> &aggregations, int capacity)
 {
-  capacity_   = static_cast<LinearProbingAggregateHashTable *>(hash_table_)->capacity();
-  size_       = static_cast<LinearProbingAggregateHashTable *>(hash_table_)->size();
-  scan_pos_   = 0;
-  scan_count_ = 0;
+  for (Expression *expr : aggregations) {
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expect aggregate expression");
+    aggr_types_.push_back(static_cast<AggregateExpr *>(expr)->aggregate_type());
+  }
+
+  // 槽的个数是 2 的幂，并且大于一次比较的槽的个数
+  capacity_ = 2 * SIMD_MATCH_WIDTH;
+  while (capacity_ < capacity) {
+    capacity_ *= 2;
+  }
+  mask_ = capacity_ - 1;
+  tags_.assign(capacity_ + SIMD_MATCH_WIDTH, 0);
+  slot_groups_.assign(capacity_, -1);
 }
 
-template <typename V>
-RC LinearProbingAggregateHashTable<V>::Scanner::next(Chunk &output_chunk)
+bool LinearProbingAggregateHashTable::can_group_by(AttrType type)
 {
-  if (scan_pos_ >= capacity_ || scan_count_ >= size_) {
-    return RC::RECORD_EOF;
+  switch (type) {
+    case AttrType::INTS:
+    case AttrType::DATES:
+    case AttrType::FLOATS:
+    case AttrType::BOOLEANS:
+    case AttrType::CHARS: return true;
+    default: return false;
   }
-  auto linear_probing_hash_table = static_cast<LinearProbingAggregateHashTable *>(hash_table_);
-  while (scan_pos_ < capacity_ && scan_count_ < size_ && output_chunk.rows() <= output_chunk.capacity()) {
-    int key;
-    V   value;
-    RC  rc = linear_probing_hash_table->iter_get(scan_pos_, key, value);
-    if (rc == RC::SUCCESS) {
-      output_chunk.column(0).append_one((char *)&key);
-      output_chunk.column(1).append_one((char *)&value);
-      scan_count_++;
+}
+
+RC LinearProbingAggregateHashTable::init_layout(const Chunk &groups_chunk, const Chunk &aggrs_chunk)
+{
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggregate columns mismatch. expect=%d, actual=%d", static_cast<int>(aggr_types_.size()), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  for (int i = 0; i < groups_chunk.column_num(); i++) {
+    const AttrType type = groups_chunk.column(i).attr_type();
+    if (!can_group_by(type)) {
+      LOG_WARN("unsupported group by column type: %s", attr_type_to_string(type));
+      return RC::UNIMPLEMENTED;
     }
-    scan_pos_++;
+    key_columns_.push_back({type, 0});
   }
+
+  // 字符串放在 key 的开头，保证 string_t 按照 8 字节对齐
+  int offset = 0;
+  for (KeyColumn &key_column : key_columns_) {
+    if (key_column.type == AttrType::CHARS) {
+      key_column.offset = offset;
+      offset += sizeof(string_t);
+    }
+  }
+  string_bytes_ = offset;
+  for (KeyColumn &key_column : key_columns_) {
+    if (key_column.type != AttrType::CHARS) {
+      key_column.offset = offset;
+      offset += sizeof(int32_t);
+    }
+  }
+  null_offset_ = offset;
+  key_width_   = align_up(null_offset_ + (static_cast<int>(key_columns_.size()) + 7) / 8, 8);
+
+  // 行的格式：key，每个聚合是否有非 NULL 的值，聚合状态
+  valid_offset_  = key_width_;
+  int row_offset = align_up(valid_offset_ + static_cast<int>(aggr_types_.size()), 8);
+  for (size_t i = 0; i < aggr_types_.size(); i++) {
+    const AttrType child_type = aggrs_chunk.column(i).attr_type();
+    const int      state_size = aggregate_state_size(aggr_types_[i], child_type);
+    if (state_size <= 0) {
+      LOG_WARN("unsupported aggregate. aggregate type=%d, value type=%s",
+               static_cast<int>(aggr_types_[i]), attr_type_to_string(child_type));
+      return RC::UNIMPLEMENTED;
+    }
+    aggr_child_types_.push_back(child_type);
+    state_offsets_.push_back(row_offset);
+    row_offset += align_up(state_size, 8);
+  }
+  row_width_     = std::max(row_offset, 8);
+  layout_inited_ = true;
   return RC::SUCCESS;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::Scanner::close_scan()
+void LinearProbingAggregateHashTable::hash_keys(const Chunk &groups_chunk, const int *rows, int size)
 {
-  capacity_   = -1;
-  size_       = -1;
-  scan_pos_   = -1;
-  scan_count_ = 0;
+  hashes_.assign(size, 0);
+  column_hashes_.resize(size);
+  hash_inputs_.resize(size);
+  for (size_t col = 0; col < key_columns_.size(); col++) {
+    const Column  &column   = groups_chunk.column(col);
+    const bool     constant = is_constant(column);
+    const AttrType type     = key_columns_[col].type;
+    uint32_t      *hashes   = col == 0 ? hashes_.data() : column_hashes_.data();
+    if (rows == nullptr && !constant && !column.has_null() && (type == AttrType::INTS || type == AttrType::DATES)) {
+      // 列值是连续的整数，直接计算哈希值
+      simd_hash_epi32(reinterpret_cast<const int *>(column.data()), size, hashes);
+    } else {
+      for (int i = 0; i < size; i++) {
+        hash_inputs_[i] = hash_input(column, constant ? 0 : (rows == nullptr ? i : rows[i]));
+      }
+      simd_hash_epi32(hash_inputs_.data(), size, hashes);
+    }
+
+    if (col > 0) {
+      for (int i = 0; i < size; i++) {
+        hashes_[i] = hashes_[i] * 0x9e3779b1U ^ column_hashes_[i];
+      }
+    }
+  }
+}
+
+void LinearProbingAggregateHashTable::pack_key(const Chunk &groups_chunk, int row, char *key) const
+{
+  memset(key, 0, key_width_);
+  for (size_t col = 0; col < key_columns_.size(); col++) {
+    const Column &column = groups_chunk.column(col);
+    const int     index  = is_constant(column) ? 0 : row;
+    if (column.is_null(index)) {
+      key[null_offset_ + col / 8] |= static_cast<char>(1 << (col % 8));
+      continue;
+    }
+
+    const KeyColumn &key_column = key_columns_[col];
+    const char      *data       = column.data() + static_cast<size_t>(index) * column.attr_len();
+    char            *target     = key + key_column.offset;
+    switch (key_column.type) {
+      case AttrType::CHARS: {
+        // 较长的字符串先引用 chunk 中的数据，插入新的分组时再拷贝
+        new (target) string_t(data, strnlen(data, column.attr_len()));
+      } break;
+      case AttrType::FLOATS: {
+        const float value = normalize_float(*reinterpret_cast<const float *>(data));
+        memcpy(target, &value, sizeof(value));
+      } break;
+      case AttrType::BOOLEANS: {
+        *target = *data != 0;
+      } break;
+      default: {
+        memcpy(target, data, sizeof(int32_t));
+      } break;
+    }
+  }
+}
+
+bool LinearProbingAggregateHashTable::key_equal(const char *left, const char *right) const
+{
+  if (memcmp(left + string_bytes_, right + string_bytes_, key_width_ - string_bytes_) != 0) {
+    return false;
+  }
+  for (int offset = 0; offset < string_bytes_; offset += sizeof(string_t)) {
+    if (*reinterpret_cast<const string_t *>(left + offset) != *reinterpret_cast<const string_t *>(right + offset)) {
+      return false;
+    }
+  }
+  return true;
 }
 
-template <typename V>
-RC LinearProbingAggregateHashTable<V>::get(int key, V &value)
+int LinearProbingAggregateHashTable::find_or_insert(const char *key, uint32_t hash)
 {
-  RC  rc          = RC::SUCCESS;
-  int index       = (key % capacity_ + capacity_) % capacity_;
-  int iterate_cnt = 0;
+  const uint32_t tag = hash | TAG_BIT;
+  uint32_t       pos = hash & mask_;
   while (true) {
-    if (keys_[index] == EMPTY_KEY) {
-      rc = RC::NOT_EXIST;
-      break;
-    } else if (keys_[index] == key) {
-      value = values_[index];
-      break;
-    } else {
-      index += 1;
-      index %= capacity_;
-      iterate_cnt++;
-      if (iterate_cnt > capacity_) {
-        rc = RC::NOT_EXIST;
-        break;
+    uint32_t match_mask = 0;
+    uint32_t empty_mask = 0;
+    simd_match_epi32(tags_.data() + pos, tag, match_mask, empty_mask);
+
+    // 没有删除操作，只需要检查第一个空槽之前的槽
+    if (empty_mask != 0) {
+      match_mask &= (empty_mask & (0U - empty_mask)) - 1;
+    }
+    while (match_mask != 0) {
+      const int group = slot_groups_[(pos + __builtin_ctz(match_mask)) & mask_];
+      if (key_equal(group_row(group), key)) {
+        return group;
       }
+      match_mask &= match_mask - 1;
+    }
+
+    if (empty_mask != 0) {
+      return insert_group((pos + __builtin_ctz(empty_mask)) & mask_, key, hash);
     }
+    pos = (pos + SIMD_MATCH_WIDTH) & mask_;
   }
-  return rc;
 }
 
-template <typename V>
-RC LinearProbingAggregateHashTable<V>::iter_get(int pos, int &key, V &value)
+int LinearProbingAggregateHashTable::insert_group(int slot, const char *key, uint32_t hash)
 {
-  RC rc = RC::SUCCESS;
-  if (keys_[pos] == LinearProbingAggregateHashTable<V>::EMPTY_KEY) {
-    rc = RC::NOT_EXIST;
+  const int group = size();
+  group_hashes_.push_back(hash);
+  rows_.resize(rows_.size() + row_width_);
+
+  char *row = group_row(group);
+  memcpy(row, key, key_width_);
+  for (int offset = 0; offset < string_bytes_; offset += sizeof(string_t)) {
+    auto *str = reinterpret_cast<string_t *>(row + offset);
+    if (!str->is_inlined()) {
+      char *data = arena_.Allocate(str->size());
+      memcpy(data, str->data(), str->size());
+      str->value.pointer.ptr = data;
+    }
+  }
+  for (size_t i = 0; i < aggr_types_.size(); i++) {
+    init_aggregate_state(row + state_offsets_[i], aggr_types_[i], aggr_child_types_[i]);
+  }
+
+  // 负载因子超过 0.5 时扩容，扩容时会重新插入所有的分组
+  if (size() * 2 > capacity_) {
+    resize();
   } else {
-    key   = keys_[pos];
-    value = values_[pos];
+    set_slot(slot, hash, group);
   }
-  return rc;
+  return group;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::aggregate(V *value, V value_to_aggregate)
+void LinearProbingAggregateHashTable::set_slot(int slot, uint32_t hash, int group)
 {
-  if (aggregate_type_ == AggregateExpr::Type::SUM) {
-    *value += value_to_aggregate;
-  } else {
-    ASSERT(false, "unsupported aggregate type");
+  const uint32_t tag = hash | TAG_BIT;
+  tags_[slot]        = tag;
+  if (slot < SIMD_MATCH_WIDTH) {
+    tags_[capacity_ + slot] = tag;
   }
+  slot_groups_[slot] = group;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::resize()
+void LinearProbingAggregateHashTable::resize()
 {
   capacity_ *= 2;
-  vector<int> new_keys(capacity_);
-  vector<V>   new_values(capacity_);
-
-  for (size_t i = 0; i < keys_.size(); i++) {
-    auto &key   = keys_[i];
-    auto &value = values_[i];
-    if (key != EMPTY_KEY) {
-      int index = (key % capacity_ + capacity_) % capacity_;
-      while (new_keys[index] != EMPTY_KEY) {
-        index = (index + 1) % capacity_;
+  mask_ = capacity_ - 1;
+  tags_.assign(capacity_ + SIMD_MATCH_WIDTH, 0);
+  slot_groups_.assign(capacity_, -1);
+  for (int group = 0; group < size(); group++) {
+    uint32_t slot = group_hashes_[group] & mask_;
+    while (tags_[slot] != 0) {
+      slot = (slot + 1) & mask_;
+    }
+    set_slot(slot, group_hashes_[group], group);
+  }
+}
+
+RC LinearProbingAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
+{
+  if (aggrs_chunk.column_num() > 0 && groups_chunk.rows() != aggrs_chunk.rows()) {
+    LOG_WARN("groups_chunk and aggrs_chunk have different rows: %d, %d", groups_chunk.rows(), aggrs_chunk.rows());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = RC::SUCCESS;
+  if (!layout_inited_ && OB_FAIL(rc = init_layout(groups_chunk, aggrs_chunk))) {
+    return rc;
+  }
+  if (groups_chunk.column_num() != static_cast<int>(key_columns_.size()) ||
+      aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("chunk columns mismatch. group by columns=%d, aggregate columns=%d",
+             groups_chunk.column_num(), aggrs_chunk.column_num());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int  size = groups_chunk.selected_rows();
+  const int *rows = groups_chunk.has_selection() ? groups_chunk.selection().data() : nullptr;
+  if (size == 0) {
+    return RC::SUCCESS;
+  }
+
+  // 1. 按列批量计算哈希值
+  hash_keys(groups_chunk, rows, size);
+
+  // 2. 编码 key，依次探测得到每一行所在的分组
+  probe_keys_.resize(static_cast<size_t>(size) * key_width_);
+  for (int i = 0; i < size; i++) {
+    pack_key(groups_chunk, rows == nullptr ? i : rows[i], probe_keys_.data() + static_cast<size_t>(i) * key_width_);
+  }
+  group_ids_.resize(size);
+  for (int i = 0; i < size; i++) {
+    if (i + PREFETCH_DISTANCE < size) {
+      __builtin_prefetch(&tags_[hashes_[i + PREFETCH_DISTANCE] & mask_]);
+    }
+    group_ids_[i] = find_or_insert(probe_keys_.data() + static_cast<size_t>(i) * key_width_, hashes_[i]);
+  }
+
+  // 3. 按列更新聚合状态。插入分组时 rows_ 可能重新分配内存，所以探测结束后再计算分组的地址
+  states_.resize(size);
+  for (int i = 0; i < size; i++) {
+    states_[i] = group_row(group_ids_[i]);
+  }
+  for (size_t aggr_idx = 0; aggr_idx < aggr_types_.size(); aggr_idx++) {
+    const Column &column = aggrs_chunk.column(aggr_idx);
+    rc = aggregate_state_update_by_rows(
+        states_.data(), state_offsets_[aggr_idx], aggr_types_[aggr_idx], aggr_child_types_[aggr_idx], column, rows, size);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("update aggregate state failed. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // 记录分组中是否有非 NULL 的值，只有 NULL 时聚合的结果是 NULL
+    const int valid = valid_offset_ + static_cast<int>(aggr_idx);
+    if (!column.has_null()) {
+      for (int i = 0; i < size; i++) {
+        states_[i][valid] = 1;
+      }
+    } else {
+      const bool constant = is_constant(column);
+      for (int i = 0; i < size; i++) {
+        states_[i][valid] |= !column.is_null(constant ? 0 : (rows == nullptr ? i : rows[i]));
       }
-      new_keys[index]   = key;
-      new_values[index] = value;
     }
   }
+  return RC::SUCCESS;
+}
 
-  keys_   = std::move(new_keys);
-  values_ = std::move(new_values);
+RC LinearProbingAggregateHashTable::merge(const LinearProbingAggregateHashTable &other, int partition, int partition_bits)
+{
+  if (!other.layout_inited_) {
+    return RC::SUCCESS;
+  }
+  if (other.aggr_types_ != aggr_types_) {
+    LOG_WARN("cannot merge hash tables with different aggregations");
+    return RC::INVALID_ARGUMENT;
+  }
+  if (!layout_inited_) {
+    key_columns_      = other.key_columns_;
+    string_bytes_     = other.string_bytes_;
+    null_offset_      = other.null_offset_;
+    key_width_        = other.key_width_;
+    valid_offset_     = other.valid_offset_;
+    state_offsets_    = other.state_offsets_;
+    row_width_        = other.row_width_;
+    aggr_child_types_ = other.aggr_child_types_;
+    layout_inited_    = true;
+  } else if (other.row_width_ != row_width_ || other.aggr_child_types_ != aggr_child_types_) {
+    LOG_WARN("cannot merge hash tables with different layouts");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 两个哈希表的行格式相同，other 中的行开头就是 key
+  RC rc = RC::SUCCESS;
+  for (int other_group = 0; other_group < other.size(); other_group++) {
+    const uint32_t hash = other.group_hashes_[other_group];
+    if (partition_of(hash, partition_bits) != partition) {
+      continue;
+    }
+
+    const char *other_row = other.group_row(other_group);
+    char       *row       = group_row(find_or_insert(other_row, hash));
+    for (size_t aggr_idx = 0; aggr_idx < aggr_types_.size(); aggr_idx++) {
+      const int offset = state_offsets_[aggr_idx];
+      rc = aggregate_state_merge(row + offset, other_row + offset, aggr_types_[aggr_idx], aggr_child_types_[aggr_idx]);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to merge aggregate state. rc=%s", strrc(rc));
+        return rc;
+      }
+      row[valid_offset_ + aggr_idx] |= other_row[valid_offset_ + aggr_idx];
+    }
+  }
+  return rc;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::resize_if_need()
+RC LinearProbingAggregateHashTable::append_key(const char *row, int key_idx, Column &column, vector<char> &buffer) const
 {
-  if (size_ >= capacity_ / 2) {
-    resize();
+  if (key_idx < 0 || key_idx >= static_cast<int>(key_columns_.size())) {
+    LOG_WARN("invalid group by column index: %d", key_idx);
+    return RC::INVALID_ARGUMENT;
   }
+
+  buffer.assign(std::max(column.attr_len(), 1), 0);
+  const KeyColumn &key_column = key_columns_[key_idx];
+  const bool       is_null    = (row[null_offset_ + key_idx / 8] & (1 << (key_idx % 8))) != 0;
+  if (!is_null) {
+    const char *data = row + key_column.offset;
+    if (key_column.type == AttrType::CHARS) {
+      const auto *str = reinterpret_cast<const string_t *>(data);
+      memcpy(buffer.data(), str->data(), std::min(str->size(), column.attr_len()));
+    } else {
+      memcpy(buffer.data(), data, std::min<int>(column.attr_len(), sizeof(int32_t)));
+    }
+  }
+
+  RC rc = column.append_one(buffer.data());
+  if (OB_SUCC(rc) && is_null) {
+    column.set_null(column.count() - 1);
+  }
+  return rc;
 }
 
-template <typename V>
-void LinearProbingAggregateHashTable<V>::add_batch(int *input_keys, V *input_values, int len)
+RC LinearProbingAggregateHashTable::append_aggregate(const char *row, int aggr_idx, Column &column) const
 {
-  // your code here
-  exit(-1);
-
-  // inv (invalid) 表示是否有效，inv[i] = -1 表示有效，inv[i] = 0 表示无效。
-  // key[SIMD_WIDTH],value[SIMD_WIDTH] 表示当前循环中处理的键值对。
-  // off (offset) 表示线性探测冲突时的偏移量，key[i] 每次遇到冲突键，则off[i]++，如果key[i] 已经完成聚合，则off[i] = 0，
-  // i = 0 表示selective load 的起始位置。
-  // inv 全部初始化为 -1
-  // off 全部初始化为 0
-
-  // for (; i + SIMD_WIDTH <= len;) {
-    // 1: 根据 `inv` 变量的值，从 `input_keys` 中 `selective load` `SIMD_WIDTH` 个不同的输入键值对。
-    // 2. 计算 i += |inv|, `|inv|` 表示 `inv` 中有效的个数 
-    // 3. 计算 hash 值，
-    // 4. 根据聚合类型（目前只支持 sum），在哈希表中更新聚合结果。如果本次循环，没有找到key[i] 在哈希表中的位置，则不更新聚合结果。
-    // 5. gather 操作，根据 hash 值将 keys_ 的 gather 结果写入 table_key 中。
-    // 6. 更新 inv 和 off。如果本次循环key[i] 聚合完成，则inv[i]=-1，表示该位置在下次循环中读取新的键值对。
-    // 如果本次循环 key[i] 未在哈希表中聚合完成（table_key[i] != key[i]），则inv[i] = 0，表示该位置在下次循环中不需要读取新的键值对。
-    // 如果本次循环中，key[i]聚合完成，则off[i] 更新为 0，表示线性探测偏移量为 0，key[i] 未完成聚合，则off[i]++,表示线性探测偏移量加 1。
-  // }
-  //7. 通过标量线性探测，处理剩余键值对
-
-  // resize_if_need();
+  if (aggr_idx < 0 || aggr_idx >= static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("invalid aggregate column index: %d", aggr_idx);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const AggregateExpr::Type aggr_type = aggr_types_[aggr_idx];
+  if (aggr_type != AggregateExpr::Type::COUNT && row[valid_offset_ + aggr_idx] == 0) {
+    const int64_t zero = 0;
+    RC            rc   = column.append_one(reinterpret_cast<const char *>(&zero));
+    if (OB_SUCC(rc)) {
+      column.set_null(column.count() - 1);
+    }
+    return rc;
+  }
+  return finialize_aggregate_state(
+      const_cast<char *>(row) + state_offsets_[aggr_idx], aggr_type, aggr_child_types_[aggr_idx], column);
 }
 
-template <typename V>
-const int LinearProbingAggregateHashTable<V>::EMPTY_KEY = 0xffffffff;
-template <typename V>
-const int LinearProbingAggregateHashTable<V>::DEFAULT_CAPACITY = 16384;
+void LinearProbingAggregateHashTable::Scanner::open_scan() { scan_pos_ = 0; }
+
+RC LinearProbingAggregateHashTable::Scanner::next(Chunk &output_chunk)
+{
+  auto *hash_table = static_cast<LinearProbingAggregateHashTable *>(hash_table_);
+  if (scan_pos_ < 0 || scan_pos_ >= hash_table->size()) {
+    return RC::RECORD_EOF;
+  }
+
+  const int key_num = static_cast<int>(hash_table->key_columns_.size());
+  RC        rc      = RC::SUCCESS;
+  while (scan_pos_ < hash_table->size() && output_chunk.rows() < output_chunk.capacity()) {
+    const char *row = hash_table->group_row(scan_pos_);
+    for (int i = 0; OB_SUCC(rc) && i < output_chunk.column_num(); i++) {
+      const int col_idx = output_chunk.column_ids(i);
+      if (col_idx < key_num) {
+        rc = hash_table->append_key(row, col_idx, output_chunk.column(i), buffer_);
+      } else {
+        rc = hash_table->append_aggregate(row, col_idx - key_num, output_chunk.column(i));
+      }
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to output group. rc=%s", strrc(rc));
+      return rc;
+    }
+    scan_pos_++;
+  }
+  return RC::SUCCESS;
+}
 
-template class LinearProbingAggregateHashTable<int>;
-template class LinearProbingAggregateHashTable<float>;
-#endif
+void LinearProbingAggregateHashTable::Scanner::close_scan() { scan_pos_ = -1; }
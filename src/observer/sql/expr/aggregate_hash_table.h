@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/math/simd_util.h"
 #include "common/sys/rc.h"
 #include "sql/expr/expression.h"
+#include "storage/common/arena_allocator.h"
 
 /**
  * @brief 用于hash group by 的哈希表实现，不支持并发访问。
@@ -108,11 +109,15 @@ public:
 };
 
 /**
- * @brief 线性探测哈希表实现
- * @note 当前只支持group by 列为 char/char(4) 类型，且聚合列为单列。
+ * @brief 线性探测（开放寻址）哈希表实现，支持多个分组列和多个聚合列
+ * @details
+ * - 分组列的值编码成固定宽度的 key（packed key）。数值类型占 4 个字节，字符串按照 string_t 保存，
+ *   超过 string_t::INLINE_LENGTH 的字符串在插入新的分组时拷贝到 arena 中，最后是每个分组列的 NULL 标记；
+ * - add_chunk 先按批计算所有行的哈希值，然后依次探测得到每行所在的分组，最后按列更新聚合状态；
+ * - 槽中只保存哈希值（tag）和分组编号，探测时使用 simd_match_epi32 一次比较 SIMD_MATCH_WIDTH 个槽；
+ * - 每个分组的 key 和聚合状态连续保存在一行中（row-major），扩容时只需要重新插入槽，不需要移动分组。
+ * 分组列的类型和聚合列的类型在第一次调用 add_chunk 时确定。
  */
-#ifdef USE_SIMD
-template <typename V>
 class LinearProbingAggregateHashTable : public AggregateHashTable
 {
 public:
@@ -124,55 +129,107 @@ public:
 
     void open_scan() override;
 
+    /**
+     * 按照分组插入的顺序输出，输出列的 id 小于分组列的个数时表示分组列，否则是聚合列。
+     */
     RC next(Chunk &chunk) override;
 
     void close_scan() override;
 
   private:
-    int capacity_   = -1;
-    int size_       = -1;
-    int scan_pos_   = -1;
-    int scan_count_ = 0;
+    int          scan_pos_ = -1;
+    vector<char> buffer_;
   };
 
-  LinearProbingAggregateHashTable(AggregateExpr::Type aggregate_type, int capacity = DEFAULT_CAPACITY)
-      : keys_(capacity, EMPTY_KEY), values_(capacity, 0), capacity_(capacity), aggregate_type_(aggregate_type)
-  {}
-  virtual ~LinearProbingAggregateHashTable() {}
+  LinearProbingAggregateHashTable(const vector<Expression *> &aggregations, int capacity = DEFAULT_CAPACITY);
+  virtual ~LinearProbingAggregateHashTable() = default;
 
-  RC get(int key, V &value);
+  /**
+   * @brief 是否支持按照这个类型的列分组
+   */
+  static bool can_group_by(AttrType type);
 
-  RC iter_get(int pos, int &key, V &value);
+  RC add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk) override;
 
-  RC add_chunk(Chunk &group_chunk, Chunk &aggr_chunk) override;
+  /**
+   * @brief 把 other 中属于分区 partition 的分组合并到当前哈希表，用于合并多个线程的部分聚合结果
+   * @details 分组按照哈希值的高 partition_bits 位划分到 2^partition_bits 个分区，不同分区中不会有相同的分组，
+   * 所以每个分区可以在不同的线程中合并到不同的哈希表。other 需要使用相同的聚合表达式，并且不能同时被修改
+   */
+  RC merge(const LinearProbingAggregateHashTable &other, int partition = 0, int partition_bits = 0);
 
-  int capacity() { return capacity_; }
-  int size() { return size_; }
+  /// 哈希值所在的分区
+  static int partition_of(uint32_t hash, int partition_bits)
+  {
+    return partition_bits == 0 ? 0 : static_cast<int>(hash >> (32 - partition_bits));
+  }
+
+  /// 槽的个数
+  int capacity() const { return capacity_; }
+  /// 分组的个数
+  int size() const { return static_cast<int>(group_hashes_.size()); }
 
 private:
+  struct KeyColumn
+  {
+    AttrType type;
+    int      offset;  /// 在 key 中的偏移
+  };
+
+  RC init_layout(const Chunk &groups_chunk, const Chunk &aggrs_chunk);
+
   /**
-   * @brief 将键值对以批量的形式写入哈希表中，这里参考了论文
-   * `Rethinking SIMD Vectorization for In-Memory Databases` 中的 `Algorithm 5`。
-   * @param input_keys 输入的键数组
-   * @param input_values 输入的值数组，与键数组一一对应。
-   * @param len 键值对数组的长度
+   * @brief 按列计算一批行的哈希值，结果保存在 hashes_ 中
    */
-  void add_batch(int *input_keys, V *input_values, int len);
+  void hash_keys(const Chunk &groups_chunk, const int *rows, int size);
 
-  void aggregate(V *value, V value_to_aggregate);
+  void pack_key(const Chunk &groups_chunk, int row, char *key) const;
+  bool key_equal(const char *left, const char *right) const;
 
+  /**
+   * @brief 查找 key 所在的分组，不存在时插入一个新的分组
+   * @return 分组编号
+   */
+  int  find_or_insert(const char *key, uint32_t hash);
+  int  insert_group(int slot, const char *key, uint32_t hash);
+  void set_slot(int slot, uint32_t hash, int group);
   void resize();
 
-  void resize_if_need();
+  char       *group_row(int group) { return rows_.data() + static_cast<size_t>(group) * row_width_; }
+  const char *group_row(int group) const { return rows_.data() + static_cast<size_t>(group) * row_width_; }
+
+  RC append_key(const char *row, int key_idx, Column &column, vector<char> &buffer) const;
+  RC append_aggregate(const char *row, int aggr_idx, Column &column) const;
 
 private:
-  static const int EMPTY_KEY;
   static const int DEFAULT_CAPACITY;
 
-  vector<int>         keys_;
-  vector<V>           values_;
-  int                 size_     = 0;
-  int                 capacity_ = 0;
-  AggregateExpr::Type aggregate_type_;
+  /// 槽中保存的 tag 的最高位总是 1，0 表示空槽
+  static constexpr uint32_t TAG_BIT = 0x80000000U;
+
+  bool              layout_inited_ = false;
+  vector<KeyColumn> key_columns_;
+  int               string_bytes_  = 0;  /// key 开头保存字符串的字节数
+  int               null_offset_   = 0;  /// NULL 标记在 key 中的偏移
+  int               key_width_     = 0;
+  int               valid_offset_  = 0;  /// 每个聚合是否有非 NULL 的值，在行中的偏移
+  vector<int>       state_offsets_;      /// 聚合状态在行中的偏移
+  int               row_width_ = 0;
+
+  int              capacity_ = 0;
+  uint32_t         mask_     = 0;
+  vector<uint32_t> tags_;         /// 长度是 capacity_ + SIMD_MATCH_WIDTH，末尾重复开头的槽，探测时不需要处理回绕
+  vector<int>      slot_groups_;  /// 槽对应的分组编号
+
+  vector<uint32_t> group_hashes_;  /// 每个分组的哈希值，扩容时使用
+  vector<char>     rows_;          /// 每个分组一行
+  Arena            arena_;         /// 保存较长的字符串
+
+  // 处理一个 chunk 时使用的临时空间
+  vector<uint32_t> hashes_;
+  vector<uint32_t> column_hashes_;
+  vector<int>      hash_inputs_;
+  vector<char>     probe_keys_;
+  vector<int>      group_ids_;
+  vector<char *>   states_;
 };
-#endif  // USE_SIMD
@@ -11,23 +11,20 @@ See the Mulan PSL v2 for more details. */
 #include "sql/expr/aggregate_state.h"
 #include <stdint.h>
 
-#ifdef USE_SIMD
 #include "common/math/simd_util.h"
-#endif
+
 template <typename T>
 void SumState<T>::update(const T *values, int size)
 {
-#ifdef USE_SIMD
   if constexpr (is_same<T, float>::value) {
-    value += mm256_sum_ps(values, size);
+    value += simd_sum_ps(values, size);
   } else if constexpr (is_same<T, int>::value) {
-    value += mm256_sum_epi32(values, size);
-  }
-#else
-  for (int i = 0; i < size; ++i) {
- 	  value += values[i];
+    value += simd_sum_epi32(values, size);
+  } else {
+    for (int i = 0; i < size; ++i) {
+      value += values[i];
+    }
   }
-#endif
 }
 
 template <typename T>
@@ -81,57 +78,66 @@ void MinState<T>::update(const T *values, int size)
   }
 }
 
-void* create_aggregate_state(AggregateExpr::Type aggr_type, AttrType attr_type)
+template <template <class> class STATE>
+static int state_size(AttrType attr_type)
 {
-  void* state_ptr = nullptr;
-  if (aggr_type == AggregateExpr::Type::SUM) {
-    if (attr_type == AttrType::INTS) {
-      state_ptr = malloc(sizeof(SumState<int>));
-      new (state_ptr) SumState<int>();
-    } else if (attr_type == AttrType::FLOATS) {
-      state_ptr = malloc(sizeof(SumState<float>));
-      new (state_ptr) SumState<float>();
-    } else {
-      LOG_WARN("unsupported aggregate value type");
-    }
-  } else if (aggr_type == AggregateExpr::Type::COUNT) {
-    state_ptr = malloc(sizeof(CountState<int>));
-    new (state_ptr) CountState<int>();
-  } else if (aggr_type == AggregateExpr::Type::AVG) {
-    if (attr_type == AttrType::INTS) {
-      state_ptr = malloc(sizeof(AvgState<int>));
-      new (state_ptr) AvgState<int>();
-    } else if (attr_type == AttrType::FLOATS) {
-      state_ptr = malloc(sizeof(AvgState<float>));
-      new (state_ptr) AvgState<float>();
-    } else {
-      LOG_WARN("unsupported aggregate value type");
-    }
+  if (attr_type == AttrType::INTS) {
+    return sizeof(STATE<int>);
+  } else if (attr_type == AttrType::FLOATS) {
+    return sizeof(STATE<float>);
+  }
+  return 0;
+}
+
+template <template <class> class STATE>
+static RC init_state(void *state, AttrType attr_type)
+{
+  if (attr_type == AttrType::INTS) {
+    new (state) STATE<int>();
+  } else if (attr_type == AttrType::FLOATS) {
+    new (state) STATE<float>();
   } else {
-    if (aggr_type == AggregateExpr::Type::MAX) {
-      if (attr_type == AttrType::INTS) {
-        state_ptr = malloc(sizeof(MaxState<int>));
-        new (state_ptr) MaxState<int>();
-      } else if (attr_type == AttrType::FLOATS) {
-        state_ptr = malloc(sizeof(MaxState<float>));
-        new (state_ptr) MaxState<float>();
-      } else {
-        LOG_WARN("unsupported aggregate value type");
-      }
-    } else if (aggr_type == AggregateExpr::Type::MIN) {
-      if (attr_type == AttrType::INTS) {
-        state_ptr = malloc(sizeof(MinState<int>));
-        new (state_ptr) MinState<int>();
-      } else if (attr_type == AttrType::FLOATS) {
-        state_ptr = malloc(sizeof(MinState<float>));
-        new (state_ptr) MinState<float>();
-      } else {
-        LOG_WARN("unsupported aggregate value type");
-      }
-    } else {
-      LOG_WARN("unsupported aggregator type");
-    }
+    LOG_WARN("unsupported aggregate value type");
+    return RC::UNIMPLEMENTED;
+  }
+  return RC::SUCCESS;
+}
+
+int aggregate_state_size(AggregateExpr::Type aggr_type, AttrType attr_type)
+{
+  switch (aggr_type) {
+    case AggregateExpr::Type::COUNT: return sizeof(CountState<int>);
+    case AggregateExpr::Type::SUM: return state_size<SumState>(attr_type);
+    case AggregateExpr::Type::AVG: return state_size<AvgState>(attr_type);
+    case AggregateExpr::Type::MAX: return state_size<MaxState>(attr_type);
+    case AggregateExpr::Type::MIN: return state_size<MinState>(attr_type);
+  }
+  return 0;
+}
+
+RC init_aggregate_state(void *state, AggregateExpr::Type aggr_type, AttrType attr_type)
+{
+  switch (aggr_type) {
+    case AggregateExpr::Type::COUNT: new (state) CountState<int>(); return RC::SUCCESS;
+    case AggregateExpr::Type::SUM: return init_state<SumState>(state, attr_type);
+    case AggregateExpr::Type::AVG: return init_state<AvgState>(state, attr_type);
+    case AggregateExpr::Type::MAX: return init_state<MaxState>(state, attr_type);
+    case AggregateExpr::Type::MIN: return init_state<MinState>(state, attr_type);
+  }
+  LOG_WARN("unsupported aggregator type");
+  return RC::UNIMPLEMENTED;
+}
+
+void* create_aggregate_state(AggregateExpr::Type aggr_type, AttrType attr_type)
+{
+  const int size = aggregate_state_size(aggr_type, attr_type);
+  if (size <= 0) {
+    LOG_WARN("unsupported aggregate. aggregate type=%d, value type=%s",
+             static_cast<int>(aggr_type), attr_type_to_string(attr_type));
+    return nullptr;
   }
+  void *state_ptr = malloc(size);
+  init_aggregate_state(state_ptr, aggr_type, attr_type);
   return state_ptr;
 }
 
@@ -297,6 +303,105 @@ RC aggregate_state_update_by_column(void *state, AggregateExpr::Type aggr_type,
   return rc;
 }
 
+template <class STATE, typename T>
+static void update_aggregate_state_by_rows(char *const *states, int offset, const Column &column, const int *rows, int size)
+{
+  const T   *data     = reinterpret_cast<const T *>(column.data());
+  const bool constant = column.column_type() == Column::Type::CONSTANT_COLUMN;
+  const bool has_null = column.has_null();
+  for (int i = 0; i < size; i++) {
+    const int row = constant ? 0 : (rows == nullptr ? i : rows[i]);
+    if (has_null && column.is_null(row)) {
+      continue;
+    }
+    reinterpret_cast<STATE *>(states[i] + offset)->update(data[row]);
+  }
+}
+
+/// COUNT 只需要判断是否为 NULL，不读取列值，列可以是任意类型
+static void count_aggregate_state_by_rows(char *const *states, int offset, const Column &column, const int *rows, int size)
+{
+  const bool constant = column.column_type() == Column::Type::CONSTANT_COLUMN;
+  const bool has_null = column.has_null();
+  for (int i = 0; i < size; i++) {
+    const int row = constant ? 0 : (rows == nullptr ? i : rows[i]);
+    if (has_null && column.is_null(row)) {
+      continue;
+    }
+    reinterpret_cast<CountState<int> *>(states[i] + offset)->value++;
+  }
+}
+
+RC aggregate_state_update_by_rows(char *const *states, int offset, AggregateExpr::Type aggr_type, AttrType attr_type,
+    const Column &col, const int *rows, int size)
+{
+  RC rc = RC::SUCCESS;
+  if (aggr_type == AggregateExpr::Type::COUNT) {
+    count_aggregate_state_by_rows(states, offset, col, rows, size);
+  } else if (attr_type != AttrType::INTS && attr_type != AttrType::FLOATS) {
+    LOG_WARN("unsupported aggregate value type");
+    rc = RC::UNIMPLEMENTED;
+  } else if (aggr_type == AggregateExpr::Type::SUM) {
+    if (attr_type == AttrType::INTS) {
+      update_aggregate_state_by_rows<SumState<int>, int>(states, offset, col, rows, size);
+    } else {
+      update_aggregate_state_by_rows<SumState<float>, float>(states, offset, col, rows, size);
+    }
+  } else if (aggr_type == AggregateExpr::Type::AVG) {
+    if (attr_type == AttrType::INTS) {
+      update_aggregate_state_by_rows<AvgState<int>, int>(states, offset, col, rows, size);
+    } else {
+      update_aggregate_state_by_rows<AvgState<float>, float>(states, offset, col, rows, size);
+    }
+  } else if (aggr_type == AggregateExpr::Type::MAX) {
+    if (attr_type == AttrType::INTS) {
+      update_aggregate_state_by_rows<MaxState<int>, int>(states, offset, col, rows, size);
+    } else {
+      update_aggregate_state_by_rows<MaxState<float>, float>(states, offset, col, rows, size);
+    }
+  } else if (aggr_type == AggregateExpr::Type::MIN) {
+    if (attr_type == AttrType::INTS) {
+      update_aggregate_state_by_rows<MinState<int>, int>(states, offset, col, rows, size);
+    } else {
+      update_aggregate_state_by_rows<MinState<float>, float>(states, offset, col, rows, size);
+    }
+  } else {
+    LOG_WARN("unsupported aggregator type");
+    rc = RC::UNIMPLEMENTED;
+  }
+  return rc;
+}
+
+template <template <class> class STATE>
+static RC merge_state(void *state, const void *other, AttrType attr_type)
+{
+  if (attr_type == AttrType::INTS) {
+    static_cast<STATE<int> *>(state)->merge(*static_cast<const STATE<int> *>(other));
+  } else if (attr_type == AttrType::FLOATS) {
+    static_cast<STATE<float> *>(state)->merge(*static_cast<const STATE<float> *>(other));
+  } else {
+    LOG_WARN("unsupported aggregate value type");
+    return RC::UNIMPLEMENTED;
+  }
+  return RC::SUCCESS;
+}
+
+RC aggregate_state_merge(void *state, const void *other, AggregateExpr::Type aggr_type, AttrType attr_type)
+{
+  switch (aggr_type) {
+    case AggregateExpr::Type::COUNT: {
+      static_cast<CountState<int> *>(state)->merge(*static_cast<const CountState<int> *>(other));
+      return RC::SUCCESS;
+    }
+    case AggregateExpr::Type::SUM: return merge_state<SumState>(state, other, attr_type);
+    case AggregateExpr::Type::AVG: return merge_state<AvgState>(state, other, attr_type);
+    case AggregateExpr::Type::MAX: return merge_state<MaxState>(state, other, attr_type);
+    case AggregateExpr::Type::MIN: return merge_state<MinState>(state, other, attr_type);
+  }
+  LOG_WARN("unsupported aggregator type");
+  return RC::UNIMPLEMENTED;
+}
+
 template class SumState<int>;
 template class SumState<float>;
 
@@ -8,8 +8,11 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#pragma once
+
 #include "sql/expr/expression.h"
 #include "common/type/attr_type.h"
+
 template <class T>
 class SumState
 {
@@ -18,6 +21,7 @@ public:
   T    value;
   void update(const T *values, int size);
   void update(const T &value) { this->value += value; }
+  void merge(const SumState &other) { value += other.value; }
   template <class U>
   U finalize()
   {
@@ -33,6 +37,7 @@ public:
   int  value;
   void update(const T *values, int size);
   void update(const T &value) { this->value++; }
+  void merge(const CountState &other) { value += other.value; }
   template <class U>
   U finalize()
   {
@@ -53,6 +58,11 @@ public:
     this->value += value;
     this->count++;
   }
+  void merge(const AvgState &other)
+  {
+    value += other.value;
+    count += other.count;
+  }
   template <class U>
   U finalize()
   {
@@ -77,6 +87,12 @@ public:
       value = v;
     }
   }
+  void merge(const MaxState &other)
+  {
+    if (other.inited) {
+      update(other.value);
+    }
+  }
   template <class U>
   U finalize()
   {
@@ -101,6 +117,12 @@ public:
       value = v;
     }
   }
+  void merge(const MinState &other)
+  {
+    if (other.inited) {
+      update(other.value);
+    }
+  }
   template <class U>
   U finalize()
   {
@@ -108,9 +130,32 @@ public:
   }
 };
 
+/**
+ * @brief 聚合状态占用的字节数，不支持的聚合返回 0
+ */
+int aggregate_state_size(AggregateExpr::Type aggr_type, AttrType attr_type);
+
+/**
+ * @brief 在 state 指向的内存上构造聚合状态，内存大小需要不小于 aggregate_state_size
+ */
+RC init_aggregate_state(void *state, AggregateExpr::Type aggr_type, AttrType attr_type);
+
 void *create_aggregate_state(AggregateExpr::Type aggr_type, AttrType attr_type);
 
 RC aggregate_state_update_by_value(void *state, AggregateExpr::Type aggr_type, AttrType attr_type, const Value &val);
 RC aggregate_state_update_by_column(void *state, AggregateExpr::Type aggr_type, AttrType attr_type, Column &col);
 
+/**
+ * @brief 按行更新聚合状态，用于分组聚合
+ * @details 第 i 行的值是 col 中下标为 rows[i] 的值（rows 为 nullptr 时是第 i 个值），它所在分组的聚合状态位于
+ * states[i] + offset。col 中为 NULL 的值不参与聚合
+ */
+RC aggregate_state_update_by_rows(char *const *states, int offset, AggregateExpr::Type aggr_type, AttrType attr_type,
+    const Column &col, const int *rows, int size);
+
+/**
+ * @brief 把聚合状态 other 合并到 state 中，用于合并多个线程的部分聚合结果
+ */
+RC aggregate_state_merge(void *state, const void *other, AggregateExpr::Type aggr_type, AttrType attr_type);
+
 RC finialize_aggregate_state(void *state, AggregateExpr::Type aggr_type, AttrType attr_type, Column &col);
\ No newline at end of file
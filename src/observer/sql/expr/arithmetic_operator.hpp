@@ -10,12 +10,17 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
-#if defined(USE_SIMD)
+#include "common/defs.h"
+#include "common/lang/limits.h"
 #include "common/math/simd_util.h"
-#endif
-
 #include "storage/common/column.h"
 
+/**
+ * @file arithmetic_operator.hpp
+ * @details 每个运算都有标量实现，以及 AVX2 和 AVX-512 的实现（USE_SIMD）。
+ * SIMD 的实现通过 SIMD_TARGET_* 编译成对应的指令集，运行时按照 simd_level() 选择，剩余不足一个寄存器的数据使用标量实现
+ */
+
 struct Equal
 {
   template <class T>
@@ -24,12 +29,22 @@ struct Equal
     return left == right;
   }
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_EQ_OS);
+    return _mm256_cmp_ps(left, right, _CMP_EQ_OQ);
+  }
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
+  {
+    return _mm256_cmpeq_epi32(left, right);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_EQ_OQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
+  {
+    return _mm512_cmpeq_epi32_mask(left, right);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right) { return _mm256_cmpeq_epi32(left, right); }
 #endif
 };
 struct NotEqual
@@ -40,15 +55,23 @@ struct NotEqual
     return left != right;
   }
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  // 与标量的 != 相同，NaN 与任何值都不相等
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_NEQ_OS);
+    return _mm256_cmp_ps(left, right, _CMP_NEQ_UQ);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right)
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
   {
     return _mm256_xor_si256(_mm256_set1_epi32(-1), _mm256_cmpeq_epi32(left, right));
   }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_NEQ_UQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
+  {
+    return _mm512_cmpneq_epi32_mask(left, right);
+  }
 #endif
 };
 
@@ -60,12 +83,22 @@ struct GreatThan
     return left > right;
   }
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_GT_OS);
+    return _mm256_cmp_ps(left, right, _CMP_GT_OQ);
+  }
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
+  {
+    return _mm256_cmpgt_epi32(left, right);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_GT_OQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
+  {
+    return _mm512_cmpgt_epi32_mask(left, right);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right) { return _mm256_cmpgt_epi32(left, right); }
 #endif
 };
 
@@ -76,16 +109,22 @@ struct GreatEqual
   {
     return left >= right;
   }
-
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_GE_OS);
+    return _mm256_cmp_ps(left, right, _CMP_GE_OQ);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right)
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
+  {
+    return _mm256_or_si256(_mm256_cmpgt_epi32(left, right), _mm256_cmpeq_epi32(left, right));
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_GE_OQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
   {
-    return _mm256_cmpgt_epi32(left, right) | _mm256_cmpeq_epi32(left, right);
+    return _mm512_cmpge_epi32_mask(left, right);
   }
 #endif
 };
@@ -98,12 +137,22 @@ struct LessThan
     return left < right;
   }
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_LT_OS);
+    return _mm256_cmp_ps(left, right, _CMP_LT_OQ);
+  }
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
+  {
+    return _mm256_cmpgt_epi32(right, left);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_LT_OQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
+  {
+    return _mm512_cmplt_epi32_mask(left, right);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right) { return _mm256_cmpgt_epi32(right, left); }
 #endif
 };
 
@@ -115,15 +164,22 @@ struct LessEqual
     return left <= right;
   }
 #if defined(USE_SIMD)
-  static inline __m256 operation(const __m256 &left, const __m256 &right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(const __m256 &left, const __m256 &right)
   {
-    return _mm256_cmp_ps(left, right, _CMP_LE_OS);
+    return _mm256_cmp_ps(left, right, _CMP_LE_OQ);
   }
-
-  static inline __m256i operation(const __m256i &left, const __m256i &right)
+  SIMD_TARGET_AVX2 static inline __m256i operation(const __m256i &left, const __m256i &right)
   {
     return _mm256_or_si256(_mm256_cmpgt_epi32(right, left), _mm256_cmpeq_epi32(left, right));
   }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512 &left, const __m512 &right)
+  {
+    return _mm512_cmp_ps_mask(left, right, _CMP_LE_OQ);
+  }
+  SIMD_TARGET_AVX512 static inline __mmask16 operation(const __m512i &left, const __m512i &right)
+  {
+    return _mm512_cmple_epi32_mask(left, right);
+  }
 #endif
 };
 
@@ -134,11 +190,14 @@ struct AddOperator
   {
     return left + right;
   }
-
 #if defined(USE_SIMD)
-  static inline __m256 operation(__m256 left, __m256 right) { return _mm256_add_ps(left, right); }
-
-  static inline __m256i operation(__m256i left, __m256i right) { return _mm256_add_epi32(left, right); }
+  SIMD_TARGET_AVX2 static inline __m256 operation(__m256 left, __m256 right) { return _mm256_add_ps(left, right); }
+  SIMD_TARGET_AVX2 static inline __m256i operation(__m256i left, __m256i right) { return _mm256_add_epi32(left, right); }
+  SIMD_TARGET_AVX512 static inline __m512 operation(__m512 left, __m512 right) { return _mm512_add_ps(left, right); }
+  SIMD_TARGET_AVX512 static inline __m512i operation(__m512i left, __m512i right)
+  {
+    return _mm512_add_epi32(left, right);
+  }
 #endif
 };
 
@@ -149,11 +208,14 @@ struct SubtractOperator
   {
     return left - right;
   }
-  // your code here
 #if defined(USE_SIMD)
-  static inline __m256 operation(__m256 left, __m256 right) { exit(-1); }
-
-  static inline __m256i operation(__m256i left, __m256i right) { exit(-1); }
+  SIMD_TARGET_AVX2 static inline __m256 operation(__m256 left, __m256 right) { return _mm256_sub_ps(left, right); }
+  SIMD_TARGET_AVX2 static inline __m256i operation(__m256i left, __m256i right) { return _mm256_sub_epi32(left, right); }
+  SIMD_TARGET_AVX512 static inline __m512 operation(__m512 left, __m512 right) { return _mm512_sub_ps(left, right); }
+  SIMD_TARGET_AVX512 static inline __m512i operation(__m512i left, __m512i right)
+  {
+    return _mm512_sub_epi32(left, right);
+  }
 #endif
 };
 
@@ -164,33 +226,49 @@ struct MultiplyOperator
   {
     return left * right;
   }
-// your code here
 #if defined(USE_SIMD)
-  static inline __m256 operation(__m256 left, __m256 right) { exit(-1); }
-
-  static inline __m256i operation(__m256i left, __m256i right) { exit(-1); }
+  SIMD_TARGET_AVX2 static inline __m256 operation(__m256 left, __m256 right) { return _mm256_mul_ps(left, right); }
+  SIMD_TARGET_AVX2 static inline __m256i operation(__m256i left, __m256i right)
+  {
+    return _mm256_mullo_epi32(left, right);
+  }
+  SIMD_TARGET_AVX512 static inline __m512 operation(__m512 left, __m512 right) { return _mm512_mul_ps(left, right); }
+  SIMD_TARGET_AVX512 static inline __m512i operation(__m512i left, __m512i right)
+  {
+    return _mm512_mullo_epi32(left, right);
+  }
 #endif
 };
 
 struct DivideOperator
 {
+  /**
+   * @details 与 FloatType::divide 相同，除数为 0 时结果是浮点数的最大值。
+   * 用条件表达式而不是分支，编译器可以生成向量化的代码。
+   * 整数除法没有 SIMD 指令，只有标量实现
+   */
   template <class T>
   static inline T operation(T left, T right)
   {
-    // TODO: `right = 0` is invalid
-    return left / right;
+    if constexpr (is_floating_point<T>::value) {
+      const bool zero = right > -EPSILON && right < EPSILON;
+      return zero ? numeric_limits<T>::max() : left / (zero ? T(1) : right);
+    } else {
+      return right == 0 ? T(0) : left / right;
+    }
   }
 
 #if defined(USE_SIMD)
-  static inline __m256  operation(__m256 left, __m256 right) { return _mm256_div_ps(left, right); }
-  static inline __m256i operation(__m256i left, __m256i right)
+  SIMD_TARGET_AVX2 static inline __m256 operation(__m256 left, __m256 right)
   {
-
-    __m256 left_float   = _mm256_cvtepi32_ps(left);
-    __m256 right_float  = _mm256_cvtepi32_ps(right);
-    __m256 result_float = _mm256_div_ps(left_float, right_float);
-    return _mm256_cvttps_epi32(result_float);
-    ;
+    const __m256 abs_right = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), right);
+    const __m256 zero      = _mm256_cmp_ps(abs_right, _mm256_set1_ps(EPSILON), _CMP_LT_OS);
+    return _mm256_blendv_ps(_mm256_div_ps(left, right), _mm256_set1_ps(numeric_limits<float>::max()), zero);
+  }
+  SIMD_TARGET_AVX512 static inline __m512 operation(__m512 left, __m512 right)
+  {
+    const __mmask16 zero = _mm512_cmp_ps_mask(_mm512_abs_ps(right), _mm512_set1_ps(EPSILON), _CMP_LT_OS);
+    return _mm512_mask_blend_ps(zero, _mm512_div_ps(left, right), _mm512_set1_ps(numeric_limits<float>::max()));
   }
 #endif
 };
@@ -204,117 +282,156 @@ struct NegateOperator
   }
 };
 
+/// @brief 运算 OP 是否有 T 类型的 SIMD 实现
+template <typename T, class OP>
+inline constexpr bool HAS_SIMD_OPERATION =
+    is_same<T, float>::value || (is_same<T, int>::value && !is_same<OP, DivideOperator>::value);
+
+#if defined(USE_SIMD)
+template <bool CONSTANT>
+SIMD_TARGET_AVX2 inline __m256 simd_load_avx2(const float *data, int i)
+{
+  return CONSTANT ? _mm256_set1_ps(data[0]) : _mm256_loadu_ps(data + i);
+}
+
+template <bool CONSTANT>
+SIMD_TARGET_AVX2 inline __m256i simd_load_avx2(const int *data, int i)
+{
+  return CONSTANT ? _mm256_set1_epi32(data[0]) : _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+}
+
+template <bool CONSTANT>
+SIMD_TARGET_AVX512 inline __m512 simd_load_avx512(const float *data, int i)
+{
+  return CONSTANT ? _mm512_set1_ps(data[0]) : _mm512_loadu_ps(data + i);
+}
+
+template <bool CONSTANT>
+SIMD_TARGET_AVX512 inline __m512i simd_load_avx512(const int *data, int i)
+{
+  return CONSTANT ? _mm512_set1_epi32(data[0]) : _mm512_loadu_si512(data + i);
+}
+
+/// @brief 比较结果的掩码与 result 中对应的 8 个字节做与运算
+inline void simd_and_mask8(uint8_t *result, uint32_t mask)
+{
+  uint64_t bytes;
+  memcpy(&bytes, result, sizeof(bytes));
+  bytes &= SIMD_MASK_TO_BYTES[mask & 0xFF];
+  memcpy(result, &bytes, sizeof(bytes));
+}
+
+/**
+ * @brief 使用 AVX2 比较，每次处理 8 个值
+ * @return 处理的行数，剩余的行由调用者处理
+ */
+template <typename T, bool LEFT_CONSTANT, bool RIGHT_CONSTANT, class OP>
+SIMD_TARGET_AVX2 int compare_operation_avx2(const T *left, const T *right, int n, uint8_t *result)
+{
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    auto left_value  = simd_load_avx2<LEFT_CONSTANT>(left, i);
+    auto right_value = simd_load_avx2<RIGHT_CONSTANT>(right, i);
+    int  mask        = 0;
+    if constexpr (is_same<T, float>::value) {
+      mask = _mm256_movemask_ps(OP::operation(left_value, right_value));
+    } else {
+      mask = _mm256_movemask_ps(_mm256_castsi256_ps(OP::operation(left_value, right_value)));
+    }
+    simd_and_mask8(result + i, mask);
+  }
+  return i;
+}
+
+/// @brief 使用 AVX-512 比较，每次处理 16 个值，比较结果直接是掩码
+template <typename T, bool LEFT_CONSTANT, bool RIGHT_CONSTANT, class OP>
+SIMD_TARGET_AVX512 int compare_operation_avx512(const T *left, const T *right, int n, uint8_t *result)
+{
+  int i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __mmask16 mask =
+        OP::operation(simd_load_avx512<LEFT_CONSTANT>(left, i), simd_load_avx512<RIGHT_CONSTANT>(right, i));
+    simd_and_mask8(result + i, mask);
+    simd_and_mask8(result + i + 8, mask >> 8);
+  }
+  return i;
+}
+
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT, typename T, class OP>
+SIMD_TARGET_AVX2 int binary_operator_avx2(const T *left_data, const T *right_data, T *result_data, int size)
+{
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    auto result_value =
+        OP::operation(simd_load_avx2<LEFT_CONSTANT>(left_data, i), simd_load_avx2<RIGHT_CONSTANT>(right_data, i));
+    if constexpr (is_same<T, float>::value) {
+      _mm256_storeu_ps(result_data + i, result_value);
+    } else {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(result_data + i), result_value);
+    }
+  }
+  return i;
+}
+
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT, typename T, class OP>
+SIMD_TARGET_AVX512 int binary_operator_avx512(const T *left_data, const T *right_data, T *result_data, int size)
+{
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    auto result_value =
+        OP::operation(simd_load_avx512<LEFT_CONSTANT>(left_data, i), simd_load_avx512<RIGHT_CONSTANT>(right_data, i));
+    if constexpr (is_same<T, float>::value) {
+      _mm512_storeu_ps(result_data + i, result_value);
+    } else {
+      _mm512_storeu_si512(result_data + i, result_value);
+    }
+  }
+  return i;
+}
+#endif  // USE_SIMD
+
 template <typename T, bool LEFT_CONSTANT, bool RIGHT_CONSTANT, class OP>
 void compare_operation(T *left, T *right, int n, vector<uint8_t> &result)
 {
+  int i = 0;
 #if defined(USE_SIMD)
-  int           i          = 0;
-  if constexpr (is_same<T, float>::value) {
-    for (; i <= n - SIMD_WIDTH; i += SIMD_WIDTH) {
-      __m256 left_value, right_value;
-
-      if constexpr (LEFT_CONSTANT) {
-        left_value = _mm256_set1_ps(left[0]);
-      } else {
-        left_value = _mm256_loadu_ps(&left[i]);
-      }
-
-      if constexpr (RIGHT_CONSTANT) {
-        right_value = _mm256_set1_ps(right[0]);
-      } else {
-        right_value = _mm256_loadu_ps(&right[i]);
-      }
-
-      __m256  result_values = OP::operation(left_value, right_value);
-      __m256i mask          = _mm256_castps_si256(result_values);
-
-      for (int j = 0; j < SIMD_WIDTH; j++) {
-        result[i + j] &= mm256_extract_epi32_var_indx(mask, j) ? 1 : 0;
-      }
-    }
-  } else if constexpr (is_same<T, int>::value) {
-    for (; i <= n - SIMD_WIDTH; i += SIMD_WIDTH) {
-      __m256i left_value, right_value;
-
-      if (LEFT_CONSTANT) {
-        left_value = _mm256_set1_epi32(left[0]);
-      } else {
-        left_value = _mm256_loadu_si256((__m256i *)&left[i]);
-      }
-
-      if (RIGHT_CONSTANT) {
-        right_value = _mm256_set1_epi32(right[0]);
-      } else {
-        right_value = _mm256_loadu_si256((__m256i *)&right[i]);
-      }
-
-      __m256i result_values = OP::operation(left_value, right_value);
-
-      for (int j = 0; j < SIMD_WIDTH; j++) {
-        result[i + j] &= mm256_extract_epi32_var_indx(result_values, j) ? 1 : 0;
-      }
+  if constexpr (HAS_SIMD_OPERATION<T, OP>) {
+    switch (simd_level()) {
+      case SimdLevel::AVX512: {
+        i = compare_operation_avx512<T, LEFT_CONSTANT, RIGHT_CONSTANT, OP>(left, right, n, result.data());
+      } break;
+      case SimdLevel::AVX2: {
+        i = compare_operation_avx2<T, LEFT_CONSTANT, RIGHT_CONSTANT, OP>(left, right, n, result.data());
+      } break;
+      default: break;
     }
   }
+#endif
 
   for (; i < n; i++) {
     auto &left_value  = left[LEFT_CONSTANT ? 0 : i];
     auto &right_value = right[RIGHT_CONSTANT ? 0 : i];
     result[i] &= OP::operation(left_value, right_value) ? 1 : 0;
   }
-#else
-  for (int i = 0; i < n; i++) {
-    auto &left_value  = left[LEFT_CONSTANT ? 0 : i];
-    auto &right_value = right[RIGHT_CONSTANT ? 0 : i];
-    result[i] &= OP::operation(left_value, right_value) ? 1 : 0;
-  }
-#endif
 }
 
 template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT, typename T, class OP>
 void binary_operator(T *left_data, T *right_data, T *result_data, int size)
 {
-#if defined(USE_SIMD)
   int i = 0;
-
-  if constexpr (is_same<T, float>::value) {
-    for (; i <= size - SIMD_WIDTH; i += SIMD_WIDTH) {
-      __m256 left_value, right_value;
-
-      if (LEFT_CONSTANT) {
-        left_value = _mm256_set1_ps(left_data[0]);
-      } else {
-        left_value = _mm256_loadu_ps(&left_data[i]);
-      }
-
-      if (RIGHT_CONSTANT) {
-        right_value = _mm256_set1_ps(right_data[0]);
-      } else {
-        right_value = _mm256_loadu_ps(&right_data[i]);
-      }
-
-      __m256 result_value = OP::operation(left_value, right_value);
-      _mm256_storeu_ps(&result_data[i], result_value);
-    }
-  } else if constexpr (is_same<T, int>::value) {
-    for (; i <= size - SIMD_WIDTH; i += SIMD_WIDTH) {
-      __m256i left_value, right_value;
-
-      if (LEFT_CONSTANT) {
-        left_value = _mm256_set1_epi32(left_data[0]);
-      } else {
-        left_value = _mm256_loadu_si256((const __m256i *)&left_data[i]);
-      }
-
-      if (RIGHT_CONSTANT) {
-        right_value = _mm256_set1_epi32(right_data[0]);
-      } else {
-        right_value = _mm256_loadu_si256((const __m256i *)&right_data[i]);
-      }
-
-      __m256i result_value = OP::operation(left_value, right_value);
-      _mm256_storeu_si256((__m256i *)&result_data[i], result_value);
+#if defined(USE_SIMD)
+  if constexpr (HAS_SIMD_OPERATION<T, OP>) {
+    switch (simd_level()) {
+      case SimdLevel::AVX512: {
+        i = binary_operator_avx512<LEFT_CONSTANT, RIGHT_CONSTANT, T, OP>(left_data, right_data, result_data, size);
+      } break;
+      case SimdLevel::AVX2: {
+        i = binary_operator_avx2<LEFT_CONSTANT, RIGHT_CONSTANT, T, OP>(left_data, right_data, result_data, size);
+      } break;
+      default: break;
     }
   }
+#endif
 
   // 处理剩余未对齐的数据
   for (; i < size; i++) {
@@ -322,13 +439,6 @@ void binary_operator(T *left_data, T *right_data, T *result_data, int size)
     auto &right_value = right_data[RIGHT_CONSTANT ? 0 : i];
     result_data[i]    = OP::template operation<T>(left_value, right_value);
   }
-#else
-  for (int i = 0; i < size; i++) {
-    auto &left_value  = left_data[LEFT_CONSTANT ? 0 : i];
-    auto &right_value = right_data[RIGHT_CONSTANT ? 0 : i];
-    result_data[i]    = OP::template operation<T>(left_value, right_value);
-  }
-#endif
 }
 
 template <bool CONSTANT, typename T, class OP>
@@ -340,7 +450,6 @@ void unary_operator(T *input, T *result_data, int size)
   }
 }
 
-// TODO: optimized with simd
 template <typename T, bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
 void compare_result(T *left, T *right, int n, vector<uint8_t> &result, CompOp op)
 {
@@ -372,3 +481,83 @@ void compare_result(T *left, T *right, int n, vector<uint8_t> &result, CompOp op
     default: break;
   }
 }
+
+/**
+ * @brief 定长字符串的比较，结果与 CharType::compare 相同
+ * @details 列中的字符串以 '\0' 结尾或者占满整个长度，常量的长度只计算一次
+ */
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT, class OP>
+void compare_string_operation(const char *left, int left_len, const char *right, int right_len, int n, vector<uint8_t> &result)
+{
+  const int left_const_len  = LEFT_CONSTANT ? strnlen(left, left_len) : 0;
+  const int right_const_len = RIGHT_CONSTANT ? strnlen(right, right_len) : 0;
+  for (int i = 0; i < n; i++) {
+    const char *left_value  = left + (LEFT_CONSTANT ? 0 : static_cast<size_t>(i) * left_len);
+    const char *right_value = right + (RIGHT_CONSTANT ? 0 : static_cast<size_t>(i) * right_len);
+    const int   left_size   = LEFT_CONSTANT ? left_const_len : strnlen(left_value, left_len);
+    const int   right_size  = RIGHT_CONSTANT ? right_const_len : strnlen(right_value, right_len);
+
+    int cmp = memcmp(left_value, right_value, left_size < right_size ? left_size : right_size);
+    if (cmp == 0) {
+      cmp = left_size - right_size;
+    }
+    result[i] &= OP::operation(cmp, 0) ? 1 : 0;
+  }
+}
+
+template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
+void compare_string_result(
+    const char *left, int left_len, const char *right, int right_len, int n, vector<uint8_t> &result, CompOp op)
+{
+  switch (op) {
+    case CompOp::EQUAL_TO: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, Equal>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    case CompOp::NOT_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, NotEqual>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    case CompOp::GREAT_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, GreatEqual>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    case CompOp::GREAT_THAN: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, GreatThan>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    case CompOp::LESS_EQUAL: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, LessEqual>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    case CompOp::LESS_THAN: {
+      compare_string_operation<LEFT_CONSTANT, RIGHT_CONSTANT, LessThan>(left, left_len, right, right_len, n, result);
+      break;
+    }
+    default: break;
+  }
+}
+
+/**
+ * @brief 数值类型的转换
+ */
+template <typename FROM, typename TO>
+void cast_operator(const FROM *input, TO *result_data, int size)
+{
+  for (int i = 0; i < size; i++) {
+    result_data[i] = static_cast<TO>(input[i]);
+  }
+}
+
+/**
+ * @brief 按照有效性位图把 NULL 所在的行从结果中去掉
+ * @param validity 有效性位图，CONSTANT 为 true 时只使用第 0 位
+ */
+template <bool CONSTANT>
+void select_valid(const uint8_t *validity, int n, vector<uint8_t> &result)
+{
+  for (int i = 0; i < n; i++) {
+    const int index = CONSTANT ? 0 : i;
+    result[i] &= (validity[index >> 3] >> (index & 7)) & 1;
+  }
+}
@@ -0,0 +1,287 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/expr/column_kernels.h"
+#include "common/log/log.h"
+#include "common/type/date_type.h"
+#include "sql/expr/arithmetic_operator.hpp"
+
+static bool is_constant(const Column &column) { return column.column_type() == Column::Type::CONSTANT_COLUMN; }
+
+static bool is_numeric(AttrType type) { return type == AttrType::INTS || type == AttrType::FLOATS; }
+
+/**
+ * @brief 计算结果的行数，两边都是常量列时只计算一行
+ */
+static int physical_rows(const Column &left, const Column &right)
+{
+  const bool left_const  = is_constant(left);
+  const bool right_const = is_constant(right);
+  if (left_const && right_const) {
+    return 1;
+  }
+  return left_const ? right.count() : left.count();
+}
+
+template <typename T>
+static void compare_typed(CompOp op, const Column &left, const Column &right, int n, vector<uint8_t> &select)
+{
+  T *left_data  = reinterpret_cast<T *>(left.data());
+  T *right_data = reinterpret_cast<T *>(right.data());
+  if (is_constant(left) && is_constant(right)) {
+    compare_result<T, true, true>(left_data, right_data, n, select, op);
+  } else if (is_constant(left)) {
+    compare_result<T, true, false>(left_data, right_data, n, select, op);
+  } else if (is_constant(right)) {
+    compare_result<T, false, true>(left_data, right_data, n, select, op);
+  } else {
+    compare_result<T, false, false>(left_data, right_data, n, select, op);
+  }
+}
+
+static void compare_string(CompOp op, const Column &left, const Column &right, int n, vector<uint8_t> &select)
+{
+  const char *left_data  = left.data();
+  const char *right_data = right.data();
+  const int   left_len   = left.attr_len();
+  const int   right_len  = right.attr_len();
+  if (is_constant(left) && is_constant(right)) {
+    compare_string_result<true, true>(left_data, left_len, right_data, right_len, n, select, op);
+  } else if (is_constant(left)) {
+    compare_string_result<true, false>(left_data, left_len, right_data, right_len, n, select, op);
+  } else if (is_constant(right)) {
+    compare_string_result<false, true>(left_data, left_len, right_data, right_len, n, select, op);
+  } else {
+    compare_string_result<false, false>(left_data, left_len, right_data, right_len, n, select, op);
+  }
+}
+
+static void select_not_null(const Column &column, int n, vector<uint8_t> &select)
+{
+  const uint8_t *validity = column.validity();
+  if (validity == nullptr) {
+    return;
+  }
+  if (is_constant(column)) {
+    select_valid<true>(validity, n, select);
+  } else {
+    select_valid<false>(validity, n, select);
+  }
+}
+
+bool can_compare_columns(AttrType left_type, AttrType right_type)
+{
+  if (left_type != right_type) {
+    return is_numeric(left_type) && is_numeric(right_type);
+  }
+  switch (left_type) {
+    case AttrType::INTS:
+    case AttrType::FLOATS:
+    case AttrType::DATES:
+    case AttrType::BOOLEANS:
+    case AttrType::CHARS: return true;
+    default: return false;
+  }
+}
+
+RC compare_columns(CompOp op, const Column &left, const Column &right, vector<uint8_t> &select)
+{
+  if (!can_compare_columns(left.attr_type(), right.attr_type())) {
+    LOG_WARN("cannot compare columns. left type=%s, right type=%s",
+             attr_type_to_string(left.attr_type()), attr_type_to_string(right.attr_type()));
+    return RC::INTERNAL;
+  }
+
+  if (left.attr_type() != right.attr_type()) {
+    Column left_float;
+    Column right_float;
+    RC     rc = cast_column(left, AttrType::FLOATS, left_float);
+    if (OB_SUCC(rc)) {
+      rc = cast_column(right, AttrType::FLOATS, right_float);
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    return compare_columns(op, left_float, right_float, select);
+  }
+
+  // 两边都是常量列时，比较结果仍然要填满常量列的所有行
+  const int n = is_constant(left) && is_constant(right) ? left.count() : physical_rows(left, right);
+  ASSERT(n <= static_cast<int>(select.size()), "select is shorter than the columns");
+
+  switch (left.attr_type()) {
+    case AttrType::INTS:
+    case AttrType::DATES: compare_typed<int>(op, left, right, n, select); break;
+    case AttrType::FLOATS: compare_typed<float>(op, left, right, n, select); break;
+    case AttrType::BOOLEANS: compare_typed<bool>(op, left, right, n, select); break;
+    case AttrType::CHARS: compare_string(op, left, right, n, select); break;
+    default: return RC::INTERNAL;
+  }
+
+  select_not_null(left, n, select);
+  select_not_null(right, n, select);
+  return RC::SUCCESS;
+}
+
+template <typename T, class OP>
+static void calc_binary(const Column &left, const Column &right, Column &result, int n)
+{
+  T *left_data   = reinterpret_cast<T *>(left.data());
+  T *right_data  = reinterpret_cast<T *>(right.data());
+  T *result_data = reinterpret_cast<T *>(result.data());
+  if (is_constant(left) && is_constant(right)) {
+    binary_operator<true, true, T, OP>(left_data, right_data, result_data, n);
+  } else if (is_constant(left)) {
+    binary_operator<true, false, T, OP>(left_data, right_data, result_data, n);
+  } else if (is_constant(right)) {
+    binary_operator<false, true, T, OP>(left_data, right_data, result_data, n);
+  } else {
+    binary_operator<false, false, T, OP>(left_data, right_data, result_data, n);
+  }
+}
+
+template <typename T>
+static RC calc_typed(ArithmeticExpr::Type type, const Column &left, const Column &right, Column &result, int n)
+{
+  switch (type) {
+    case ArithmeticExpr::Type::ADD: calc_binary<T, AddOperator>(left, right, result, n); break;
+    case ArithmeticExpr::Type::SUB: calc_binary<T, SubtractOperator>(left, right, result, n); break;
+    case ArithmeticExpr::Type::MUL: calc_binary<T, MultiplyOperator>(left, right, result, n); break;
+    case ArithmeticExpr::Type::DIV: calc_binary<T, DivideOperator>(left, right, result, n); break;
+    case ArithmeticExpr::Type::NEGATIVE: {
+      unary_operator<false, T, NegateOperator>(
+          reinterpret_cast<T *>(left.data()), reinterpret_cast<T *>(result.data()), n);
+    } break;
+    default: return RC::UNIMPLEMENTED;
+  }
+  return RC::SUCCESS;
+}
+
+bool can_calc_columns(ArithmeticExpr::Type type, AttrType left_type, AttrType right_type, AttrType result_type)
+{
+  if (!is_numeric(result_type) || !is_numeric(left_type)) {
+    return false;
+  }
+  if (type == ArithmeticExpr::Type::NEGATIVE) {
+    return left_type == result_type;
+  }
+  if (!is_numeric(right_type)) {
+    return false;
+  }
+  if (result_type == AttrType::INTS) {
+    return left_type == AttrType::INTS && right_type == AttrType::INTS && type != ArithmeticExpr::Type::DIV;
+  }
+  return true;
+}
+
+RC calc_columns(
+    ArithmeticExpr::Type type, const Column &left, const Column &right, AttrType result_type, Column &result)
+{
+  const bool unary = type == ArithmeticExpr::Type::NEGATIVE;
+  if (!can_calc_columns(type, left.attr_type(), unary ? left.attr_type() : right.attr_type(), result_type)) {
+    LOG_WARN("unsupported arithmetic. type=%d, left type=%s, result type=%s",
+             static_cast<int>(type), attr_type_to_string(left.attr_type()), attr_type_to_string(result_type));
+    return RC::UNIMPLEMENTED;
+  }
+
+  // 操作数的类型与结果不同时先转换类型
+  RC            rc         = RC::SUCCESS;
+  const Column *left_ptr   = &left;
+  const Column *right_ptr  = &right;
+  Column        left_cast;
+  Column        right_cast;
+  if (left.attr_type() != result_type) {
+    rc       = cast_column(left, result_type, left_cast);
+    left_ptr = &left_cast;
+  }
+  if (OB_SUCC(rc) && !unary && right.attr_type() != result_type) {
+    rc        = cast_column(right, result_type, right_cast);
+    right_ptr = &right_cast;
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const bool constant = is_constant(*left_ptr) && (unary || is_constant(*right_ptr));
+  int        n        = 0;
+  int        count    = 0;
+  if (unary) {
+    n     = constant ? 1 : left_ptr->count();
+    count = left_ptr->count();
+  } else {
+    n     = physical_rows(*left_ptr, *right_ptr);
+    count = constant ? max(left_ptr->count(), right_ptr->count()) : n;
+  }
+
+  result.init(result_type, sizeof(int32_t), max(n, 1));
+  if (result_type == AttrType::INTS) {
+    rc = calc_typed<int>(type, *left_ptr, *right_ptr, result, n);
+  } else {
+    rc = calc_typed<float>(type, *left_ptr, *right_ptr, result, n);
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  result.set_column_type(constant ? Column::Type::CONSTANT_COLUMN : Column::Type::NORMAL_COLUMN);
+  result.set_count(count);
+  // 任何一边是 NULL 时结果也是 NULL
+  result.merge_nulls(*left_ptr);
+  if (!unary) {
+    result.merge_nulls(*right_ptr);
+  }
+  return rc;
+}
+
+bool can_cast_column(AttrType from_type, AttrType to_type)
+{
+  return from_type == to_type || (from_type == AttrType::INTS && to_type == AttrType::FLOATS) ||
+         (from_type == AttrType::CHARS && to_type == AttrType::DATES);
+}
+
+RC cast_column(const Column &input, AttrType to_type, Column &result)
+{
+  const AttrType from_type = input.attr_type();
+  if (from_type == to_type) {
+    result.reference(input);
+    return RC::SUCCESS;
+  }
+  if (!can_cast_column(from_type, to_type)) {
+    return RC::UNIMPLEMENTED;
+  }
+
+  const int n = is_constant(input) ? 1 : input.count();
+  if (from_type == AttrType::INTS && to_type == AttrType::FLOATS) {
+    result.init(AttrType::FLOATS, sizeof(float), max(n, 1));
+    cast_operator<int, float>(reinterpret_cast<const int *>(input.data()), reinterpret_cast<float *>(result.data()), n);
+  } else {
+    // 日期需要逐个解析，与 CharType::cast_to 相同
+    result.init(AttrType::DATES, sizeof(int), max(n, 1));
+    int *dates = reinterpret_cast<int *>(result.data());
+    for (int i = 0; i < n; i++) {
+      if (input.is_null(i)) {
+        dates[i] = INT32_MAX;
+        continue;
+      }
+      const char  *data = input.data() + static_cast<size_t>(i) * input.attr_len();
+      const string value(data, strnlen(data, input.attr_len()));
+      if (!DateType::is_valid(value)) {
+        LOG_WARN("invalid date. value=%s", value.c_str());
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
+      dates[i] = DateType::to_int(value);
+    }
+  }
+
+  result.set_column_type(input.column_type());
+  result.set_count(input.count());
+  result.merge_nulls(input);
+  return RC::SUCCESS;
+}
@@ -0,0 +1,62 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/sys/rc.h"
+#include "common/lang/vector.h"
+#include "sql/expr/expression.h"
+#include "storage/common/column.h"
+
+/**
+ * @defgroup ColumnKernels 列计算
+ * @brief 向量化表达式计算使用的比较、算术和类型转换
+ * @details 每个 chunk 只按照列的类型和是否是常量列分发一次，选择 arithmetic_operator.hpp 中
+ * 编译期特化的实现，循环中没有类型判断，编译器可以自动向量化。
+ * 常量列只保存一个值，与普通列计算时不需要展开。
+ * 计算结果会处理 NULL：比较时 NULL 所在的行结果为 false，算术运算和类型转换的结果传递 NULL。
+ */
+
+/**
+ * @brief 是否有两个类型的列比较的实现
+ * @details 相同的 INTS、FLOATS、DATES、BOOLEANS、CHARS 类型之间可以比较，INTS 和 FLOATS 比较时先转换成 FLOATS
+ */
+bool can_compare_columns(AttrType left_type, AttrType right_type);
+
+/**
+ * @brief 比较两个列，结果与 `select` 做与运算
+ * @param select 长度与非常量列的行数相同，两边都是常量列时与常量列的行数相同
+ */
+RC compare_columns(CompOp op, const Column &left, const Column &right, vector<uint8_t> &select);
+
+/**
+ * @brief 是否有算术运算的实现
+ * @details 操作数是 INTS 或者 FLOATS，类型与结果不同的操作数先转换成结果的类型
+ */
+bool can_calc_columns(ArithmeticExpr::Type type, AttrType left_type, AttrType right_type, AttrType result_type);
+
+/**
+ * @brief 计算算术表达式
+ * @param right 取负数时不使用
+ * @param result 两边都是常量列时结果也是常量列
+ */
+RC calc_columns(
+    ArithmeticExpr::Type type, const Column &left, const Column &right, AttrType result_type, Column &result);
+
+/**
+ * @brief 是否有列的类型转换的实现，目前支持 INTS 转 FLOATS 和 CHARS 转 DATES
+ */
+bool can_cast_column(AttrType from_type, AttrType to_type);
+
+/**
+ * @brief 转换列的类型，类型相同时直接引用
+ * @return RC::UNIMPLEMENTED 没有对应的实现，调用者可以逐行转换
+ */
+RC cast_column(const Column &input, AttrType to_type, Column &result);
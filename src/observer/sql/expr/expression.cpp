@@ -14,7 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/expr/expression.h"
 #include "sql/expr/tuple.h"
-#include "sql/expr/arithmetic_operator.hpp"
+#include "sql/expr/column_kernels.h"
 #include "sql/expr/sub_query_expr.h"
 
 using namespace std;
@@ -36,15 +36,23 @@ bool FieldExpr::equal(const Expression &other) const
   return table_name() == other_field_expr.table_name() && field_name() == other_field_expr.field_name();
 }
 
-// TODO: 在进行表达式计算时，`chunk` 包含了所有列，因此可以通过 `field_id` 获取到对应列。
-// 后续可以优化成在 `FieldExpr` 中存储 `chunk` 中某列的位置信息。
+/**
+ * @details 生成物理计划时会设置字段在 chunk 中的位置。没有设置时 chunk 包含表的所有列，按照字段在表中的位置获取，
+ * 没有表时按照 field_id 获取
+ */
 RC FieldExpr::get_column(Chunk &chunk, Column &column)
 {
-  if (pos_ != -1) {
-    column.reference(chunk.column(pos_));
-  } else {
-    column.reference(chunk.column(field().meta()->field_id()));
+  int pos = pos_;
+  if (pos == -1) {
+    pos = field().table() != nullptr ? field().table()->table_meta().field_index(field().meta())
+                                     : field().meta()->field_id();
   }
+  if (pos < 0 || pos >= chunk.column_num()) {
+    LOG_WARN("failed to find field in chunk. field=%s, pos=%d, column num=%d", field_name(), pos, chunk.column_num());
+    return RC::INTERNAL;
+  }
+
+  column.reference(chunk.column(pos));
   return RC::SUCCESS;
 }
 
@@ -73,6 +81,15 @@ RC ValueExpr::get_column(Chunk &chunk, Column &column)
   return RC::SUCCESS;
 }
 
+RC ValueExpr::eval(Chunk &chunk, vector<uint8_t> &select)
+{
+  // 谓词下推后留下的恒真条件
+  if (!value_.get_boolean()) {
+    std::fill(select.begin(), select.end(), 0);
+  }
+  return RC::SUCCESS;
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 CastExpr::CastExpr(unique_ptr<Expression> child, AttrType cast_type) : child_(std::move(child)), cast_type_(cast_type)
 {}
@@ -108,7 +125,14 @@ RC CastExpr::get_column(Chunk &chunk, Column &column)
   if (rc != RC::SUCCESS) {
     return rc;
   }
-  column.init(cast_type_, child_column.attr_len());
+  rc = cast_column(child_column, cast_type_, column);
+  if (rc != RC::UNIMPLEMENTED) {
+    return rc;
+  }
+
+  // 没有向量化实现的类型转换逐行计算
+  rc = RC::SUCCESS;
+  column.init(cast_type_, child_column.attr_len(), max(child_column.count(), 1));
   for (int i = 0; i < child_column.count(); ++i) {
     Value value = child_column.get_value(i);
     Value cast_value;
@@ -239,16 +263,33 @@ RC ComparisonExpr::get_value(const Tuple &tuple, Value &value) const
         LOG_WARN("failed to get value of left expression. rc=%s", strrc(rc));
         return rc;
       }
-      SubQueryExpr *sub = static_cast<SubQueryExpr*>(right_.get());
-      bool found = sub->check_in(left_value);
-      if (comp_ == CompOp_NOT_IN) {
-        found = !found;
+      SubQueryExpr *sub     = static_cast<SubQueryExpr*>(right_.get());
+      bool          found   = false;
+      bool          is_null = false;
+      rc = sub->check_in(tuple, left_value, found, is_null);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to check in sub query. rc=%s", strrc(rc));
+        return rc;
       }
-      value.set_boolean(found);
+      // 结果是 NULL 时，IN 和 NOT IN 都不成立
+      value.set_boolean(!is_null && (comp_ == CompOp_IN ? found : !found));
       return RC::SUCCESS;
     }
   }
 
+  if (comp_ == CompOp_EXISTS || comp_ == CompOp_NOT_EXISTS) {
+    if (right_->type() != ExprType::SUB_QUERY) {
+      LOG_WARN("exists requires a sub query");
+      return RC::INVALID_ARGUMENT;
+    }
+    bool exists = false;
+    RC   rc     = static_cast<SubQueryExpr *>(right_.get())->exists(tuple, exists);
+    if (rc == RC::SUCCESS) {
+      value.set_boolean(comp_ == CompOp_EXISTS ? exists : !exists);
+    }
+    return rc;
+  }
+
   Value left_value;
   Value right_value;
 
@@ -288,57 +329,7 @@ RC ComparisonExpr::eval(Chunk &chunk, vector<uint8_t> &select)
     LOG_WARN("failed to get value of right expression. rc=%s", strrc(rc));
     return rc;
   }
-  if (left_column.attr_type() != right_column.attr_type()) {
-    LOG_WARN("cannot compare columns with different types");
-    return RC::INTERNAL;
-  }
-  if (left_column.attr_type() == AttrType::INTS) {
-    rc = compare_column<int>(left_column, right_column, select);
-  } else if (left_column.attr_type() == AttrType::FLOATS) {
-    rc = compare_column<float>(left_column, right_column, select);
-  } else if (left_column.attr_type() == AttrType::CHARS) {
-    int rows = 0;
-    if (left_column.column_type() == Column::Type::CONSTANT_COLUMN) {
-      rows = right_column.count();
-    } else {
-      rows = left_column.count();
-    }
-    for (int i = 0; i < rows; ++i) {
-      Value left_val = left_column.get_value(i);
-      Value right_val = right_column.get_value(i);
-      bool        result   = false;
-      rc                   = compare_value(left_val, right_val, result);
-      if (rc != RC::SUCCESS) {
-        LOG_WARN("failed to compare tuple cells. rc=%s", strrc(rc));
-        return rc;
-      }
-      select[i] &= result ? 1 : 0;
-    }
-
-  } else {
-    LOG_WARN("unsupported data type %d", left_column.attr_type());
-    return RC::INTERNAL;
-  }
-  return rc;
-}
-
-template <typename T>
-RC ComparisonExpr::compare_column(const Column &left, const Column &right, vector<uint8_t> &result) const
-{
-  RC rc = RC::SUCCESS;
-
-  bool left_const  = left.column_type() == Column::Type::CONSTANT_COLUMN;
-  bool right_const = right.column_type() == Column::Type::CONSTANT_COLUMN;
-  if (left_const && right_const) {
-    compare_result<T, true, true>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
-  } else if (left_const && !right_const) {
-    compare_result<T, true, false>((T *)left.data(), (T *)right.data(), right.count(), result, comp_);
-  } else if (!left_const && right_const) {
-    compare_result<T, false, true>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
-  } else {
-    compare_result<T, false, false>((T *)left.data(), (T *)right.data(), left.count(), result, comp_);
-  }
-  return rc;
+  return compare_columns(comp_, left_column, right_column, select);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -384,6 +375,43 @@ RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value) const
   return rc;
 }
 
+RC ConjunctionExpr::eval(Chunk &chunk, vector<uint8_t> &select)
+{
+  RC rc = RC::SUCCESS;
+  if (conjunction_type_ == Type::AND) {
+    for (unique_ptr<Expression> &child : children_) {
+      rc = child->eval(chunk, select);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+    return rc;
+  }
+
+  if (children_.empty()) {
+    return rc;
+  }
+
+  vector<uint8_t> any_selected(select.size(), 0);
+  vector<uint8_t> child_select;
+  for (unique_ptr<Expression> &child : children_) {
+    child_select.assign(select.size(), 1);
+    rc = child->eval(chunk, child_select);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+      return rc;
+    }
+    for (size_t i = 0; i < select.size(); i++) {
+      any_selected[i] |= child_select[i];
+    }
+  }
+  for (size_t i = 0; i < select.size(); i++) {
+    select[i] &= any_selected[i];
+  }
+  return rc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArithmeticExpr::ArithmeticExpr(ArithmeticExpr::Type type, Expression *left, Expression *right)
@@ -456,74 +484,6 @@ RC ArithmeticExpr::calc_value(const Value &left_value, const Value &right_value,
   return rc;
 }
 
-template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
-RC ArithmeticExpr::execute_calc(
-    const Column &left, const Column &right, Column &result, Type type, AttrType attr_type) const
-{
-  RC rc = RC::SUCCESS;
-  switch (type) {
-    case Type::ADD: {
-      if (attr_type == AttrType::INTS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, int, AddOperator>(
-            (int *)left.data(), (int *)right.data(), (int *)result.data(), result.capacity());
-      } else if (attr_type == AttrType::FLOATS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, float, AddOperator>(
-            (float *)left.data(), (float *)right.data(), (float *)result.data(), result.capacity());
-      } else {
-        rc = RC::UNIMPLEMENTED;
-      }
-    } break;
-    case Type::SUB:
-      if (attr_type == AttrType::INTS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, int, SubtractOperator>(
-            (int *)left.data(), (int *)right.data(), (int *)result.data(), result.capacity());
-      } else if (attr_type == AttrType::FLOATS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, float, SubtractOperator>(
-            (float *)left.data(), (float *)right.data(), (float *)result.data(), result.capacity());
-      } else {
-        rc = RC::UNIMPLEMENTED;
-      }
-      break;
-    case Type::MUL:
-      if (attr_type == AttrType::INTS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, int, MultiplyOperator>(
-            (int *)left.data(), (int *)right.data(), (int *)result.data(), result.capacity());
-      } else if (attr_type == AttrType::FLOATS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, float, MultiplyOperator>(
-            (float *)left.data(), (float *)right.data(), (float *)result.data(), result.capacity());
-      } else {
-        rc = RC::UNIMPLEMENTED;
-      }
-      break;
-    case Type::DIV:
-      if (attr_type == AttrType::INTS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, int, DivideOperator>(
-            (int *)left.data(), (int *)right.data(), (int *)result.data(), result.capacity());
-      } else if (attr_type == AttrType::FLOATS) {
-        binary_operator<LEFT_CONSTANT, RIGHT_CONSTANT, float, DivideOperator>(
-            (float *)left.data(), (float *)right.data(), (float *)result.data(), result.capacity());
-      } else {
-        rc = RC::UNIMPLEMENTED;
-      }
-      break;
-    case Type::NEGATIVE:
-      if (attr_type == AttrType::INTS) {
-        unary_operator<LEFT_CONSTANT, int, NegateOperator>((int *)left.data(), (int *)result.data(), result.capacity());
-      } else if (attr_type == AttrType::FLOATS) {
-        unary_operator<LEFT_CONSTANT, float, NegateOperator>(
-            (float *)left.data(), (float *)result.data(), result.capacity());
-      } else {
-        rc = RC::UNIMPLEMENTED;
-      }
-      break;
-    default: rc = RC::UNIMPLEMENTED; break;
-  }
-  if (rc == RC::SUCCESS) {
-    result.set_count(result.capacity());
-  }
-  return rc;
-}
-
 RC ArithmeticExpr::get_value(const Tuple &tuple, Value &value) const
 {
   RC rc = RC::SUCCESS;
@@ -559,36 +519,19 @@ RC ArithmeticExpr::get_column(Chunk &chunk, Column &column)
     LOG_WARN("failed to get column of left expression. rc=%s", strrc(rc));
     return rc;
   }
-  rc = right_->get_column(chunk, right_column);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to get column of right expression. rc=%s", strrc(rc));
-    return rc;
+  if (right_) {
+    rc = right_->get_column(chunk, right_column);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get column of right expression. rc=%s", strrc(rc));
+      return rc;
+    }
   }
   return calc_column(left_column, right_column, column);
 }
 
 RC ArithmeticExpr::calc_column(const Column &left_column, const Column &right_column, Column &column) const
 {
-  RC rc = RC::SUCCESS;
-
-  const AttrType target_type = value_type();
-  column.init(target_type, left_column.attr_len(), max(left_column.count(), right_column.count()));
-  bool left_const  = left_column.column_type() == Column::Type::CONSTANT_COLUMN;
-  bool right_const = right_column.column_type() == Column::Type::CONSTANT_COLUMN;
-  if (left_const && right_const) {
-    column.set_column_type(Column::Type::CONSTANT_COLUMN);
-    rc = execute_calc<true, true>(left_column, right_column, column, arithmetic_type_, target_type);
-  } else if (left_const && !right_const) {
-    column.set_column_type(Column::Type::NORMAL_COLUMN);
-    rc = execute_calc<true, false>(left_column, right_column, column, arithmetic_type_, target_type);
-  } else if (!left_const && right_const) {
-    column.set_column_type(Column::Type::NORMAL_COLUMN);
-    rc = execute_calc<false, true>(left_column, right_column, column, arithmetic_type_, target_type);
-  } else {
-    column.set_column_type(Column::Type::NORMAL_COLUMN);
-    rc = execute_calc<false, false>(left_column, right_column, column, arithmetic_type_, target_type);
-  }
-  return rc;
+  return calc_columns(arithmetic_type_, left_column, right_column, value_type(), column);
 }
 
 RC ArithmeticExpr::try_get_value(Value &value) const
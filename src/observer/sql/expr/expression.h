@@ -48,6 +48,7 @@ enum class ExprType
   ARITHMETIC,   ///< 算术运算
   AGGREGATION,  ///< 聚合运算
   SUB_QUERY,    ///< 子查询
+  CORRELATED_FIELD,  ///< 相关子查询中引用的外层查询的字段
 };
 
 class Trx;
@@ -233,6 +234,55 @@ private:
   Field field_;
 };
 
+/**
+ * @brief 相关子查询中引用的外层查询的字段
+ * @ingroup Expression
+ * @details 子查询每次执行之前，SubQueryExpr 把外层查询当前行的字段值设置进来，子查询的算子计算时直接使用这个值。
+ * 复制出来的表达式与原来的表达式共享同一个值。
+ */
+class CorrelatedFieldExpr : public Expression
+{
+public:
+  explicit CorrelatedFieldExpr(const Field &field) : CorrelatedFieldExpr(field, make_shared<Value>()) {}
+
+  virtual ~CorrelatedFieldExpr() = default;
+
+  bool equal(const Expression &other) const override
+  {
+    return other.type() == ExprType::CORRELATED_FIELD &&
+           static_cast<const CorrelatedFieldExpr &>(other).value_ == value_;
+  }
+
+  unique_ptr<Expression> copy() const override
+  {
+    return unique_ptr<Expression>(new CorrelatedFieldExpr(field_, value_));
+  }
+
+  ExprType type() const override { return ExprType::CORRELATED_FIELD; }
+  AttrType value_type() const override { return field_.attr_type(); }
+  int      value_length() const override { return field_.meta()->len(); }
+
+  const Field &field() const { return field_; }
+
+  void set_value(const Value &value) { *value_ = value; }
+
+  RC get_value(const Tuple &tuple, Value &value) const override
+  {
+    value = *value_;
+    return RC::SUCCESS;
+  }
+
+private:
+  CorrelatedFieldExpr(const Field &field, shared_ptr<Value> value) : field_(field), value_(std::move(value))
+  {
+    set_name(field_.field_name());
+  }
+
+private:
+  Field             field_;
+  shared_ptr<Value> value_;
+};
+
 /**
  * @brief 常量值表达式
  * @ingroup Expression
@@ -252,6 +302,7 @@ public:
 
   RC get_value(const Tuple &tuple, Value &value) const override;
   RC get_column(Chunk &chunk, Column &column) override;
+  RC eval(Chunk &chunk, vector<uint8_t> &select) override;
   RC try_get_value(Value &value) const override
   {
     value = value_;
@@ -342,9 +393,6 @@ public:
    */
   RC compare_value(const Value &left, const Value &right, bool &value) const;
 
-  template <typename T>
-  RC compare_column(const Column &left, const Column &right, vector<uint8_t> &result) const;
-
 private:
   CompOp                 comp_;
   unique_ptr<Expression> left_;
@@ -384,6 +432,11 @@ public:
   RC       get_value(const Tuple &tuple, Value &value) const override;
   RC       init(Trx *trx) override;
 
+  /**
+   * @brief AND 依次用每个子表达式过滤 `select`，OR 先把各个子表达式的结果合并起来再过滤
+   */
+  RC eval(Chunk &chunk, vector<uint8_t> &select) override;
+
   Type conjunction_type() const { return conjunction_type_; }
 
   vector<unique_ptr<Expression>> &children() { return children_; }
@@ -445,9 +498,6 @@ private:
 
   RC calc_column(const Column &left_column, const Column &right_column, Column &column) const;
 
-  template <bool LEFT_CONSTANT, bool RIGHT_CONSTANT>
-  RC execute_calc(const Column &left, const Column &right, Column &result, Type type, AttrType attr_type) const;
-
 private:
   Type                   arithmetic_type_;
   unique_ptr<Expression> left_;
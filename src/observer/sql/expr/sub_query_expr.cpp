@@ -1,151 +1,362 @@
-#include "sql/expr/sub_query_expr.h"
-#include "sql/optimizer/physical_plan_generator.h"
-#include "sql/operator/physical_operator.h"
-#include "common/log/log.h"
-#include "sql/expr/tuple.h"
-
-SubQueryExpr::SubQueryExpr(std::unique_ptr<LogicalOperator> logical_plan)
-    : logical_plan_(std::move(logical_plan))
-{}
-
-AttrType SubQueryExpr::value_type() const
-{
-  if (logical_plan_ && !logical_plan_->expressions().empty()) {
-    return logical_plan_->expressions()[0]->value_type();
-  }
-  return AttrType::UNDEFINED;
-}
-
-std::unique_ptr<Expression> SubQueryExpr::copy() const
-{
-  LOG_ERROR("SubQueryExpr::copy not implemented");
-  return nullptr;
-}
-
-RC SubQueryExpr::get_value(const Tuple &tuple, Value &value) const
-{
-  if (!executed_) {
-    LOG_WARN("SubQueryExpr not executed");
-    return RC::INTERNAL;
-  }
-  if (result_set_.empty()) {
-    AttrType type = value_type();
-    if (type == AttrType::UNDEFINED) {
-      LOG_WARN("SubQueryExpr result empty and type undefined. Defaulting to INTS.");
-      type = AttrType::INTS;
-    }
-    value.set_type(type);
-    value.set_null_value();
-  } else if (result_set_.size() == 1) {
-    value = result_set_[0];
-  } else {
-    LOG_WARN("SubQueryExpr returned multiple rows in scalar context");
-    return RC::INVALID_ARGUMENT; 
-  }
-  return RC::SUCCESS;
-}
-
-RC SubQueryExpr::init(Trx *trx)
-{
-  if (executed_) {
-    return RC::SUCCESS;
-  }
-
-  PhysicalPlanGenerator physical_plan_generator;
-  std::unique_ptr<PhysicalOperator> physical_plan;
-  // TODO: get session from trx or pass session to init
-  // For now, we pass nullptr as session, assuming subquery doesn't need session info for now
-  // or we need to find a way to get session.
-  // Trx doesn't seem to have session info directly.
-  // However, PhysicalPlanGenerator::create needs session.
-  // Let's try to pass nullptr and see if it works, or if we need to change the interface.
-  // Looking at PhysicalPlanGenerator::create, it uses session for some operators.
-  
-  // Since we don't have session here easily, and changing Expression::init signature affects many classes,
-  // let's check if we can get session from somewhere else or if nullptr is safe for simple subqueries.
-  // If PhysicalPlanGenerator uses session, passing nullptr might crash.
-  
-  // Actually, we can try to get the session from thread local storage if available, 
-  // but the best way is to pass it down.
-  
-  // Let's modify Expression::init to take Session * as well, or just Trx * and assume we can get Session.
-  // But Trx doesn't have Session.
-  
-  // Let's look at where init is called. It is called in PredicatePhysicalOperator::open(Trx *trx).
-  // PredicatePhysicalOperator::open only has Trx.
-  
-  // Wait, PhysicalOperator::open takes Trx *.
-  // If we change PhysicalOperator::open to take Session *, that would be a big change.
-  
-  // Let's check if we can use `Session::default_session()` or similar if it exists, 
-  // or if there is a global way to get current session.
-  // There is `Session::default_session()` in `session.h`.
-  
-  RC rc = physical_plan_generator.create(*logical_plan_, physical_plan, nullptr);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to create physical plan for subquery");
-    return rc;
-  }
-
-  rc = physical_plan->open(trx);
-  if (rc != RC::SUCCESS) {
-    LOG_WARN("failed to open physical plan for subquery");
-    return rc;
-  }
-
-  result_set_.clear();
-  while (true) {
-    rc = physical_plan->next();
-    if (rc == RC::RECORD_EOF) {
-      rc = RC::SUCCESS;
-      break;
-    }
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to execute subquery");
-      physical_plan->close();
-      return rc;
-    }
-
-    Tuple *tuple = physical_plan->current_tuple();
-    if (tuple == nullptr) {
-      continue;
-    }
-
-    TupleSchema schema;
-    physical_plan->tuple_schema(schema);
-    if (schema.cell_num() != 1) {
-       LOG_WARN("SubQuery must return exactly one column");
-       physical_plan->close();
-       return RC::INVALID_ARGUMENT;
-    }
-    
-    Value val;
-    rc = tuple->cell_at(0, val);
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to get value from tuple");
-      physical_plan->close();
-      return rc;
-    }
-    LOG_INFO("SubQuery got value: %s", val.to_string().c_str());
-    result_set_.push_back(val);
-  }
-  
-  physical_plan->close();
-  executed_ = true;
-  LOG_INFO("SubQuery executed, result set size: %d", result_set_.size());
-  return rc;
-}
-
-bool SubQueryExpr::check_in(const Value &val) const
-{
-  if (!executed_) {
-    return false;
-  }
-  for (const auto &v : result_set_) {
-    if (v.compare(val) == 0) {
-      return true;
-    }
-  }
-  LOG_INFO("Check IN failed for value: %s", val.to_string().c_str());
-  return false;
-}
+#include "sql/expr/sub_query_expr.h"
+#include "sql/optimizer/physical_plan_generator.h"
+#include "sql/operator/physical_operator.h"
+#include "common/log/log.h"
+#include "sql/expr/expression_iterator.h"
+#include "sql/expr/tuple.h"
+
+SubQueryExpr::SubQueryExpr(std::unique_ptr<LogicalOperator> logical_plan)
+    : logical_plan_(std::move(logical_plan))
+{}
+
+AttrType SubQueryExpr::value_type() const
+{
+  if (physical_plan_ != nullptr) {
+    return value_type_;
+  }
+  // 按照分组查找时，子查询原来的输出在分组的值后面
+  if (logical_plan_ && logical_plan_->expressions().size() > lookup_keys_.size()) {
+    return logical_plan_->expressions()[lookup_keys_.size()]->value_type();
+  }
+  return AttrType::UNDEFINED;
+}
+
+std::unique_ptr<Expression> SubQueryExpr::copy() const
+{
+  LOG_ERROR("SubQueryExpr::copy not implemented");
+  return nullptr;
+}
+
+void SubQueryExpr::set_lookup_keys(std::vector<std::unique_ptr<Expression>> &&outer_keys)
+{
+  lookup_keys_ = std::move(outer_keys);
+}
+
+RC SubQueryExpr::get_value(const Tuple &tuple, Value &value) const
+{
+  const Result *result = nullptr;
+  RC            rc     = evaluate(tuple, result);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (!result->single_column) {
+    LOG_WARN("SubQuery must return exactly one column");
+    return RC::INVALID_ARGUMENT;
+  }
+  if (result->values.empty()) {
+    AttrType type = value_type();
+    if (type == AttrType::UNDEFINED) {
+      LOG_WARN("SubQueryExpr result empty and type undefined. Defaulting to INTS.");
+      type = AttrType::INTS;
+    }
+    value.set_type(type);
+    value.set_null_value();
+  } else if (result->values.size() == 1) {
+    value = result->values[0];
+  } else {
+    LOG_WARN("SubQueryExpr returned multiple rows in scalar context");
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
+
+void SubQueryExpr::collect_params(LogicalOperator &oper)
+{
+  function<RC(std::unique_ptr<Expression> &)> collector = [&](std::unique_ptr<Expression> &expr) -> RC {
+    if (expr->type() == ExprType::CORRELATED_FIELD) {
+      const Field &field = static_cast<CorrelatedFieldExpr &>(*expr).field();
+      cacheable_         = cacheable_ && ValueHashSet::support(field.attr_type());
+      params_.emplace_back(expr->copy());
+      param_fields_.emplace_back(make_unique<FieldExpr>(field));
+      return RC::SUCCESS;
+    }
+    // 嵌套的子查询只能引用直接外层查询的字段，不需要再往下找
+    return ExpressionIterator::iterate_child_expr(*expr, collector);
+  };
+
+  for (std::unique_ptr<Expression> &expr : oper.expressions()) {
+    collector(expr);
+  }
+  for (std::unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_params(*child);
+  }
+}
+
+RC SubQueryExpr::init(Trx *trx)
+{
+  trx_ = trx;
+  // 外层的算子重新打开时不需要重新创建，缓存的结果在整个语句执行期间都有效
+  if (physical_plan_ != nullptr) {
+    return RC::SUCCESS;
+  }
+  if (logical_plan_ == nullptr) {
+    LOG_WARN("sub query has no logical plan");
+    return RC::INTERNAL;
+  }
+
+  collect_params(*logical_plan_);
+  value_type_ = value_type();
+
+  // 子查询中没有使用会话的信息，会话传空
+  PhysicalPlanGenerator physical_plan_generator;
+  RC rc = physical_plan_generator.create(*logical_plan_, physical_plan_, nullptr);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to create physical plan for subquery");
+    physical_plan_.reset();
+    return rc;
+  }
+
+  if (!lookup_keys_.empty()) {
+    rc = execute_lookup();
+  } else if (params_.empty()) {
+    // 不相关的子查询直接执行
+    key_.clear();
+    rc = execute(cache_[key_]);
+  }
+  if (OB_FAIL(rc)) {
+    physical_plan_.reset();
+    cache_.clear();
+  }
+  return rc;
+}
+
+RC SubQueryExpr::execute(Result &result) const
+{
+  execute_count_++;
+  result.values.clear();
+  result.row_num       = 0;
+  result.single_column = true;
+
+  RC rc = physical_plan_->open(trx_);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open physical plan for subquery");
+    return rc;
+  }
+
+  while (true) {
+    rc = physical_plan_->next();
+    if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+      break;
+    }
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to execute subquery");
+      physical_plan_->close();
+      return rc;
+    }
+
+    Tuple *tuple = physical_plan_->current_tuple();
+    if (tuple == nullptr) {
+      continue;
+    }
+
+    result.row_num++;
+    if (tuple->cell_num() != 1) {
+      // 多列的结果只能用于 EXISTS，只需要行数
+      result.single_column = false;
+      continue;
+    }
+
+    Value val;
+    rc = tuple->cell_at(0, val);
+    if (rc != RC::SUCCESS) {
+      LOG_WARN("failed to get value from tuple");
+      physical_plan_->close();
+      return rc;
+    }
+    result.values.push_back(val);
+  }
+
+  physical_plan_->close();
+
+  build_value_set(result, value_type_);
+  LOG_TRACE("SubQuery executed, result set size: %d", result.values.size());
+  return rc;
+}
+
+RC SubQueryExpr::execute_lookup()
+{
+  execute_count_++;
+  RC rc = physical_plan_->open(trx_);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open physical plan for subquery");
+    return rc;
+  }
+
+  const int key_num = static_cast<int>(lookup_keys_.size());
+  Value     val;
+  while (OB_SUCC(rc = physical_plan_->next())) {
+    Tuple *tuple = physical_plan_->current_tuple();
+    if (tuple == nullptr) {
+      continue;
+    }
+    if (tuple->cell_num() != key_num + 1) {
+      LOG_WARN("invalid sub query output for lookup. cell num=%d, key num=%d", tuple->cell_num(), key_num);
+      rc = RC::INTERNAL;
+      break;
+    }
+
+    key_.clear();
+    for (int i = 0; i < key_num; i++) {
+      tuple->cell_at(i, val);
+      ValueHashSet::encode(val, key_);
+    }
+    tuple->cell_at(key_num, val);
+
+    // 每个分组只有一行
+    Result &result = cache_[key_];
+    result.values.assign(1, val);
+    result.row_num = 1;
+  }
+  physical_plan_->close();
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to execute subquery. rc=%s", strrc(rc));
+    return rc;
+  }
+  LOG_TRACE("SubQuery executed for lookup, group num: %d", cache_.size());
+  return RC::SUCCESS;
+}
+
+RC SubQueryExpr::evaluate(const Tuple &tuple, const Result *&result) const
+{
+  if (physical_plan_ == nullptr) {
+    LOG_WARN("SubQueryExpr not executed");
+    return RC::INTERNAL;
+  }
+
+  RC    rc = RC::SUCCESS;
+  Value val;
+  key_.clear();
+  if (!lookup_keys_.empty()) {
+    for (const std::unique_ptr<Expression> &key : lookup_keys_) {
+      if (OB_FAIL(rc = key->get_value(tuple, val))) {
+        LOG_WARN("failed to get value of lookup key. rc=%s", strrc(rc));
+        return rc;
+      }
+      // 原来的相关条件是等值比较，NULL 不会有结果
+      if (val.is_null()) {
+        result = &empty_;
+        return rc;
+      }
+      ValueHashSet::encode(val, key_);
+    }
+    auto iter = cache_.find(key_);
+    result    = iter != cache_.end() ? &iter->second : &empty_;
+    return rc;
+  }
+
+  for (size_t i = 0; i < params_.size(); i++) {
+    if (OB_FAIL(rc = param_fields_[i]->get_value(tuple, val))) {
+      LOG_WARN("failed to get value of correlated field. field=%s, rc=%s", param_fields_[i]->name(), strrc(rc));
+      return rc;
+    }
+    static_cast<CorrelatedFieldExpr &>(*params_[i]).set_value(val);
+    if (cacheable_) {
+      ValueHashSet::encode(val, key_);
+    }
+  }
+
+  if (cacheable_) {
+    auto iter = cache_.find(key_);
+    if (iter != cache_.end()) {
+      cache_hit_count_ += params_.empty() ? 0 : 1;
+      result = &iter->second;
+      return rc;
+    }
+  }
+
+  // 缓存的值太多时不再缓存新的结果
+  if (!cacheable_ || cached_values_ >= MAX_CACHED_VALUES) {
+    rc     = execute(uncached_);
+    result = &uncached_;
+    return rc;
+  }
+
+  auto   iter          = cache_.emplace(key_, Result()).first;
+  Result &cached_result = iter->second;
+  if (OB_FAIL(rc = execute(cached_result))) {
+    cache_.erase(iter);
+    return rc;
+  }
+  cached_values_ += static_cast<int64_t>(cached_result.values.size()) + 1;
+  result = &cached_result;
+  return rc;
+}
+
+void SubQueryExpr::build_value_set(Result &result, AttrType type)
+{
+  result.value_set.reset(AttrType::UNDEFINED);
+  if (result.values.size() < MIN_HASH_VALUES) {
+    return;
+  }
+
+  for (const Value &val : result.values) {
+    if (!val.is_null()) {
+      type = val.attr_type();
+      break;
+    }
+  }
+  if (!ValueHashSet::support(type)) {
+    return;
+  }
+
+  result.value_set.reset(type);
+  for (const Value &val : result.values) {
+    if (OB_FAIL(result.value_set.insert(val))) {
+      LOG_INFO("sub query returns values of different types, compare values one by one");
+      result.value_set.reset(AttrType::UNDEFINED);
+      return;
+    }
+  }
+}
+
+RC SubQueryExpr::check_in(const Tuple &tuple, const Value &val, bool &result, bool &is_null) const
+{
+  result  = false;
+  is_null = false;
+
+  const Result *sub_result = nullptr;
+  RC            rc         = evaluate(tuple, sub_result);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  if (!sub_result->single_column) {
+    LOG_WARN("SubQuery must return exactly one column");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const ValueHashSet &value_set = sub_result->value_set;
+  if (value_set.type() != AttrType::UNDEFINED && (val.is_null() || val.attr_type() == value_set.type())) {
+    return value_set.in(val, result, is_null);
+  }
+
+  // 结果比较少或者类型不同时逐个比较
+  if (sub_result->values.empty()) {
+    return RC::SUCCESS;
+  }
+  if (val.is_null()) {
+    is_null = true;
+    return RC::SUCCESS;
+  }
+  for (const auto &v : sub_result->values) {
+    if (v.is_null()) {
+      is_null = true;
+    } else if (v.compare(val) == 0) {
+      result  = true;
+      is_null = false;
+      return RC::SUCCESS;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC SubQueryExpr::exists(const Tuple &tuple, bool &result) const
+{
+  const Result *sub_result = nullptr;
+  RC            rc         = evaluate(tuple, sub_result);
+  if (OB_SUCC(rc)) {
+    result = sub_result->row_num > 0;
+  }
+  return rc;
+}
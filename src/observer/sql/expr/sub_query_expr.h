@@ -1,31 +1,108 @@
-#pragma once
-
-#include "sql/expr/expression.h"
-#include "sql/operator/logical_operator.h"
-#include "common/lang/vector.h"
-
-class SubQueryExpr : public Expression
-{
-public:
-  SubQueryExpr(std::unique_ptr<LogicalOperator> logical_plan);
-  ~SubQueryExpr() override = default;
-
-  ExprType type() const override { return ExprType::SUB_QUERY; }
-
-  AttrType value_type() const override;
-
-  std::unique_ptr<Expression> copy() const override;
-
-  RC get_value(const Tuple &tuple, Value &value) const override;
-
-  RC init(Trx *trx) override;
-
-  bool check_in(const Value &val) const;
-
-  const std::vector<Value> &result_set() const { return result_set_; }
-
-private:
-  std::unique_ptr<LogicalOperator> logical_plan_;
-  std::vector<Value> result_set_;
-  bool executed_ = false;
-};
+#pragma once
+
+#include "sql/expr/expression.h"
+#include "sql/expr/value_hash_set.h"
+#include "sql/operator/logical_operator.h"
+#include "sql/operator/physical_operator.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+
+/**
+ * @brief 子查询表达式
+ * @ingroup Expression
+ * @details 不相关的子查询在 init 时执行一次。相关子查询（条件中有 CorrelatedFieldExpr）在外层查询的每一行上，
+ * 用这一行的字段值作为参数执行，相同参数的结果缓存下来，直到语句执行结束，重复的参数不再执行子查询。
+ * 参考 SubqueryToJoinRewriter，能够去相关的子查询会改写成连接或者按照相关字段分组之后查找。
+ */
+class SubQueryExpr : public Expression
+{
+public:
+  SubQueryExpr(std::unique_ptr<LogicalOperator> logical_plan);
+  ~SubQueryExpr() override = default;
+
+  ExprType type() const override { return ExprType::SUB_QUERY; }
+
+  AttrType value_type() const override;
+
+  std::unique_ptr<Expression> copy() const override;
+
+  RC get_value(const Tuple &tuple, Value &value) const override;
+
+  RC init(Trx *trx) override;
+
+  /**
+   * @brief 计算 val IN (子查询的结果)，NULL 的处理参考 ValueHashSet::in
+   * @details 结果比较多时放到哈希集合中查找，val 的类型与子查询结果的类型不同时逐个比较
+   * @param tuple 外层查询当前的行，用于计算相关子查询的参数
+   */
+  RC check_in(const Tuple &tuple, const Value &val, bool &result, bool &is_null) const;
+
+  /// 子查询是否有结果，用于 EXISTS
+  RC exists(const Tuple &tuple, bool &result) const;
+
+  /// 子查询的逻辑计划，改写成 semi/anti join 时会被取走
+  std::unique_ptr<LogicalOperator> &logical_plan() { return logical_plan_; }
+
+  /**
+   * @brief 设置按照分组查找子查询结果的外层查询的表达式
+   * @details 去相关之后，子查询的逻辑计划按照原来的相关字段分组，输出的前几列是分组的值，最后一列是原来的输出。
+   * 子查询只在 init 时执行一次，外层查询的每一行计算 outer_keys，找到对应的分组。
+   * 没有对应的分组时与子查询没有结果相同
+   */
+  void set_lookup_keys(std::vector<std::unique_ptr<Expression>> &&outer_keys);
+
+  const std::vector<std::unique_ptr<Expression>> &lookup_keys() const { return lookup_keys_; }
+
+  /// 子查询实际执行的次数
+  int64_t execute_count() const { return execute_count_; }
+  /// 相关子查询使用缓存结果的次数
+  int64_t cache_hit_count() const { return cache_hit_count_; }
+
+private:
+  /// 子查询一次执行的结果
+  struct Result
+  {
+    std::vector<Value> values;
+    ValueHashSet       value_set;  ///< 结果比较多时才创建，否则类型是 UNDEFINED
+    int64_t            row_num       = 0;
+    bool               single_column = true;  ///< 只有一列时才能用作标量或者 IN，EXISTS 不限制列数
+  };
+
+  /// 收集子查询条件中引用的外层查询的字段
+  void collect_params(LogicalOperator &oper);
+
+  /// 使用当前的参数执行一次子查询
+  RC execute(Result &result) const;
+
+  /// 执行按照分组改写过的子查询，每个分组的结果放到缓存中
+  RC execute_lookup();
+
+  /// 找到外层查询当前行对应的结果，需要时执行子查询
+  RC evaluate(const Tuple &tuple, const Result *&result) const;
+
+  static void build_value_set(Result &result, AttrType type);
+
+private:
+  /// 结果超过这个数量时才放到哈希集合中，否则逐个比较
+  static constexpr size_t MIN_HASH_VALUES = 8;
+  /// 缓存的结果最多包含的值的个数，超过之后新的结果不再缓存
+  static constexpr int64_t MAX_CACHED_VALUES = 1 << 20;
+
+  std::unique_ptr<LogicalOperator>  logical_plan_;
+  std::unique_ptr<PhysicalOperator> physical_plan_;
+  Trx                              *trx_        = nullptr;
+  AttrType                          value_type_ = AttrType::UNDEFINED;  ///< 创建物理计划之后逻辑计划的输出被取走
+
+  std::vector<std::unique_ptr<Expression>> params_;        ///< 子查询中的 CorrelatedFieldExpr，与子查询共享参数的值
+  std::vector<std::unique_ptr<Expression>> param_fields_;  ///< 参数在外层查询中对应的字段
+  bool                                     cacheable_ = true;  ///< 参数的类型都可以编码时才缓存
+  std::vector<std::unique_ptr<Expression>> lookup_keys_;
+
+  mutable std::unordered_map<std::string, Result> cache_;  ///< 参数编码之后作为 key
+  mutable Result                                  uncached_;
+  mutable Result                                  empty_;
+  mutable std::string                             key_;
+  mutable int64_t                                 cached_values_   = 0;
+  mutable int64_t                                 execute_count_   = 0;
+  mutable int64_t                                 cache_hit_count_ = 0;
+};
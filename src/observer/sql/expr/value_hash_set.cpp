@@ -0,0 +1,108 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/expr/value_hash_set.h"
+#include "common/log/log.h"
+
+bool ValueHashSet::support(AttrType type)
+{
+  switch (type) {
+    case AttrType::CHARS:
+    case AttrType::TEXTS:
+    case AttrType::INTS:
+    case AttrType::DATES:
+    case AttrType::FLOATS:
+    case AttrType::BOOLEANS: return true;
+    default: return false;
+  }
+}
+
+void ValueHashSet::reset(AttrType type)
+{
+  type_ = type;
+  keys_.clear();
+  size_     = 0;
+  has_null_ = false;
+}
+
+RC ValueHashSet::insert(const Value &value)
+{
+  size_++;
+  if (value.is_null()) {
+    has_null_ = true;
+    return RC::SUCCESS;
+  }
+  if (value.attr_type() != type_) {
+    LOG_WARN("value type mismatch. set type=%s, value type=%s",
+             attr_type_to_string(type_), attr_type_to_string(value.attr_type()));
+    return RC::INVALID_ARGUMENT;
+  }
+
+  string key;
+  encode(value, key);
+  keys_.insert(std::move(key));
+  return RC::SUCCESS;
+}
+
+RC ValueHashSet::in(const Value &value, bool &result, bool &is_null) const
+{
+  result  = false;
+  is_null = false;
+  if (empty()) {
+    return RC::SUCCESS;
+  }
+  if (value.is_null()) {
+    is_null = true;
+    return RC::SUCCESS;
+  }
+  if (value.attr_type() != type_) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  string key;
+  encode(value, key);
+  result  = keys_.count(key) > 0;
+  is_null = !result && has_null_;
+  return RC::SUCCESS;
+}
+
+void ValueHashSet::encode(const Value &value, string &key)
+{
+  // 每个值前面有一个字节区分 NULL，字符串后面有结束符，拼接之后也不会有歧义
+  if (value.is_null()) {
+    key.push_back('\0');
+    return;
+  }
+  key.push_back('\1');
+
+  const char *data = value.data();
+  switch (value.attr_type()) {
+    case AttrType::CHARS:
+    case AttrType::TEXTS: {
+      // 与比较字符串时一样，只取到第一个 '\0'
+      key.append(data, strnlen(data, value.length()));
+      key.push_back('\0');
+    } break;
+    case AttrType::FLOATS: {
+      float float_value = value.get_float();
+      if (float_value == 0) {
+        float_value = 0;  // -0.0 与 0.0 相等
+      }
+      key.append(reinterpret_cast<const char *>(&float_value), sizeof(float_value));
+    } break;
+    case AttrType::BOOLEANS: {
+      key.push_back(value.get_boolean() ? '\1' : '\0');
+    } break;
+    default: {
+      int32_t int_value = value.get_int();
+      key.append(reinterpret_cast<const char *>(&int_value), sizeof(int_value));
+    } break;
+  }
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/string.h"
+#include "common/lang/unordered_set.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+
+/**
+ * @brief 同一种类型的值的哈希集合
+ * @ingroup Expression
+ * @details 用于 IN 子查询和行模式的 semi/anti join。值按照集合的类型编码成字符串作为 key，
+ * 编码方式与 HashJoinVecPhysicalOperator 的连接键相同。NULL 不放到集合中，只记录集合中有 NULL，
+ * 按照 SQL 的三值逻辑计算 IN 的结果。
+ */
+class ValueHashSet
+{
+public:
+  explicit ValueHashSet(AttrType type = AttrType::UNDEFINED) : type_(type) {}
+
+  /// 是否支持这种类型的值
+  static bool support(AttrType type);
+
+  void reset(AttrType type);
+
+  AttrType type() const { return type_; }
+
+  /// 插入的值的个数，包括 NULL
+  int64_t size() const { return size_; }
+  bool    empty() const { return size_ == 0; }
+  bool    has_null() const { return has_null_; }
+
+  /**
+   * @brief 插入一个值
+   * @return 值的类型与集合的类型不同时返回 INVALID_ARGUMENT
+   */
+  RC insert(const Value &value);
+
+  /**
+   * @brief 计算 value IN (集合中的值)
+   * @details 集合为空时结果是 false。value 是 NULL，或者 value 不在集合中但是集合中有 NULL 时结果是 NULL，
+   * NOT IN 的结果是 NULL 的时候同样是 NULL。
+   * @param[out] result 结果不是 NULL 时，value 是否在集合中
+   * @param[out] is_null 结果是否是 NULL
+   * @return 值的类型与集合的类型不同时返回 INVALID_ARGUMENT
+   */
+  RC in(const Value &value, bool &result, bool &is_null) const;
+
+  /**
+   * @brief 把值编码后追加到 key 的后面
+   * @details 多个值依次编码得到的 key 可以作为组合的哈希 key，比如多个连接键或者分组的值。
+   * NULL 也有编码，同一个位置上的值需要是同一种 support 的类型
+   */
+  static void encode(const Value &value, string &key);
+
+private:
+  AttrType              type_ = AttrType::UNDEFINED;
+  unordered_set<string> keys_;
+  int64_t               size_     = 0;
+  bool                  has_null_ = false;
+};
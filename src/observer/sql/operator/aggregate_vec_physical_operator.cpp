@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/expr/aggregate_state.h"
 #include "sql/expr/expression_tuple.h"
 #include "sql/expr/composite_tuple.h"
+#include "sql/operator/parallel_pipeline.h"
 
 using namespace common;
 
@@ -32,14 +33,30 @@ AggregateVecPhysicalOperator::AggregateVecPhysicalOperator(vector<Expression *>
   for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
     auto &expr = aggregate_expressions_[i];
     ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
+    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    output_chunk_.add_column(make_unique<Column>(aggregate_expr->value_type(), aggregate_expr->value_length()), i);
+  }
+  init_aggregate_values(aggr_values_);
+}
+
+void AggregateVecPhysicalOperator::init_aggregate_values(AggregateValues &values) const
+{
+  for (Expression *expr : aggregate_expressions_) {
     auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
     void *state_ptr = create_aggregate_state(aggregate_expr->aggregate_type(), aggregate_expr->child()->value_type());
     ASSERT(state_ptr != nullptr, "failed to create aggregate state");
-    aggr_values_.insert(state_ptr);
-    output_chunk_.add_column(make_unique<Column>(aggregate_expr->value_type(), aggregate_expr->value_length()), i);
+    values.insert(state_ptr);
   }
 }
 
+string AggregateVecPhysicalOperator::param() const
+{
+  if (parallel_degree_ > 1 && !children_.empty() && children_[0]->parallel_safe()) {
+    return "parallel_degree=" + to_string(parallel_degree_);
+  }
+  return "";
+}
+
 RC AggregateVecPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
@@ -51,17 +68,16 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
+  ParallelPipeline pipeline;
+  rc = pipeline.init(child, parallel_degree_);
+  if (rc != RC::UNSUPPORTED) {
+    return OB_SUCC(rc) ? open_parallel(pipeline, trx) : rc;
+  }
+
   while (OB_SUCC(rc = child.next(chunk_))) {
-    for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
-      Column column;
-      value_expressions_[aggr_idx]->get_column(chunk_, column);
-      ASSERT(aggregate_expressions_[aggr_idx]->type() == ExprType::AGGREGATION, "expect aggregate expression");
-      auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
-      rc = aggregate_state_update_by_column(aggr_values_.at(aggr_idx), aggregate_expr->aggregate_type(), aggregate_expr->child()->value_type(), column);
-      if (OB_FAIL(rc)) {
-        LOG_INFO("failed to update aggregate state. rc=%s", strrc(rc));
-        return rc;
-      }
+    rc = aggregate_chunk(chunk_, aggr_values_);
+    if (OB_FAIL(rc)) {
+      return rc;
     }
   }
 
@@ -72,6 +88,67 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
   return rc;
 }
 
+RC AggregateVecPhysicalOperator::aggregate_chunk(Chunk &chunk, AggregateValues &values) const
+{
+  RC rc = RC::SUCCESS;
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    Column column;
+    rc = value_expressions_[aggr_idx]->get_column(chunk, column);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get column of aggregate value. rc=%s", strrc(rc));
+      return rc;
+    }
+    Column *column_ptr = &column;
+    Column  selected;
+    if (chunk.has_selection()) {
+      // 只拷贝聚合用到的列中有效的行
+      selected.init(column.attr_type(), column.attr_len(), std::max(chunk.selected_rows(), 1));
+      selected.append_selected(column, chunk.selection());
+      column_ptr = &selected;
+    }
+    ASSERT(aggregate_expressions_[aggr_idx]->type() == ExprType::AGGREGATION, "expect aggregate expression");
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    rc = aggregate_state_update_by_column(
+        values.at(aggr_idx), aggregate_expr->aggregate_type(), aggregate_expr->child()->value_type(), *column_ptr);
+    if (OB_FAIL(rc)) {
+      LOG_INFO("failed to update aggregate state. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC AggregateVecPhysicalOperator::open_parallel(ParallelPipeline &pipeline, Trx *trx)
+{
+  vector<AggregateValues> local_values(pipeline.parallel_degree());
+  for (AggregateValues &values : local_values) {
+    init_aggregate_values(values);
+  }
+
+  RC rc = pipeline.run(trx, [this, &local_values](int worker_id, Chunk &chunk) {
+    return aggregate_chunk(chunk, local_values[worker_id]);
+  });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to aggregate in parallel. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 没有分组，每个线程只有一组聚合状态，直接合并
+  for (AggregateValues &values : local_values) {
+    for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+      auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+      rc = aggregate_state_merge(aggr_values_.at(aggr_idx), values.at(aggr_idx), aggregate_expr->aggregate_type(),
+          aggregate_expr->child()->value_type());
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to merge aggregate state. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+  }
+  LOG_INFO("aggregate in parallel. parallel degree=%d", parallel_degree_);
+  return rc;
+}
+
 template <class STATE, typename T>
 void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column)
 {
@@ -12,8 +12,11 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/physical_operator.h"
 
+class ParallelPipeline;
+
 /**
  * @brief 聚合物理算子 (Vectorized)
+ * @details 并行度大于 1 并且下层的流水线可以并行执行时，每个工作算子聚合到自己的聚合状态中，最后合并
  * @ingroup PhysicalOperator
  */
 class AggregateVecPhysicalOperator : public PhysicalOperator
@@ -25,14 +28,30 @@ public:
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::AGGREGATE_VEC; }
 
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+
+  string param() const override;
+
   RC open(Trx *trx) override;
   RC next(Chunk &chunk) override;
   RC close() override;
 
 private:
+  class AggregateValues;
+
   template <class STATE, typename T>
   void update_aggregate_state(void *state, const Column &column);
 
+  void init_aggregate_values(AggregateValues &values) const;
+
+  /**
+   * @brief 使用 chunk 更新聚合状态
+   * @details 不修改算子的成员，并行聚合时多个线程同时调用
+   */
+  RC aggregate_chunk(Chunk &chunk, AggregateValues &values) const;
+
+  RC open_parallel(ParallelPipeline &pipeline, Trx *trx);
+
 private:
   class AggregateValues
   {
@@ -64,5 +83,6 @@ private:
   Chunk                chunk_;
   Chunk                output_chunk_;
   AggregateValues      aggr_values_;
-  bool                 outputed_ = false;
+  bool                 outputed_        = false;
+  int                  parallel_degree_ = 1;
 };
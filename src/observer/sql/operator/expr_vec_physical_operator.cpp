@@ -49,11 +49,32 @@ RC ExprVecPhysicalOperator::next(Chunk &chunk)
       expressions_[i]->get_column(chunk_, *column);
       evaled_chunk_.add_column(std::move(column), i);
     }
+    // 表达式在所有的行上计算，只保留下层的选择向量，输出时再按照选择向量取值
+    if (chunk_.has_selection()) {
+      evaled_chunk_.set_selection(vector<int>(chunk_.selection()));
+    }
     chunk.reference(evaled_chunk_);
   }
   return rc;
 }
 
+RC ExprVecPhysicalOperator::create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers)
+{
+  vector<unique_ptr<PhysicalOperator>> child_workers;
+  RC                                   rc = children_[0]->create_workers(parallel_degree, child_workers);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 表达式的向量化计算不修改表达式，工作算子直接使用相同的表达式
+  for (unique_ptr<PhysicalOperator> &child_worker : child_workers) {
+    auto worker = make_unique<ExprVecPhysicalOperator>(vector<Expression *>(expressions_));
+    worker->add_child(std::move(child_worker));
+    workers.emplace_back(std::move(worker));
+  }
+  return rc;
+}
+
 RC ExprVecPhysicalOperator::close()
 {
   children_[0]->close();
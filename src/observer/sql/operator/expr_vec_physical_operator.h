@@ -29,6 +29,9 @@ public:
   RC next(Chunk &chunk) override;
   RC close() override;
 
+  bool parallel_safe() const override { return children_[0]->parallel_safe(); }
+  RC   create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers) override;
+
 private:
   vector<Expression *> expressions_;  /// 表达式
   Chunk                chunk_;
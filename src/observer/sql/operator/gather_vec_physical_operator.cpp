@@ -0,0 +1,137 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/gather_vec_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+string GatherVecPhysicalOperator::param() const { return "parallel_degree=" + to_string(parallel_degree_); }
+
+RC GatherVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "gather operator should have 1 child");
+
+  RC rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  trx_              = trx;
+  started_          = false;
+  finished_workers_ = 0;
+  stopping_         = false;
+  queue_.clear();
+  current_.reset();
+
+  pipeline_ = make_unique<ParallelPipeline>();
+  rc        = pipeline_->init(*children_[0], parallel_degree_);
+  if (rc == RC::UNSUPPORTED) {
+    LOG_INFO("child of gather operator cannot run in parallel, fall back to serial execution");
+    pipeline_.reset();
+    rc = RC::SUCCESS;
+  }
+  return rc;
+}
+
+RC GatherVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (pipeline_ == nullptr) {
+    return children_[0]->next(chunk);
+  }
+
+  if (!started_) {
+    started_         = true;
+    consumer_thread_ = this_thread::get_id();
+    pipeline_->start(
+        trx_,
+        [this](int /*worker_id*/, Chunk &worker_chunk) { return push(worker_chunk); },
+        [this](int /*worker_id*/) {
+          lock_guard<mutex> guard(lock_);
+          finished_workers_++;
+          not_empty_.notify_all();
+        });
+  }
+
+  // 队列为空时领取还没有开始的工作算子执行，否则调度器的线程都在忙(比如都在执行其它查询的 Gather)时会一直等待
+  unique_lock<mutex> guard(lock_);
+  while (queue_.empty() && finished_workers_ < pipeline_->parallel_degree()) {
+    guard.unlock();
+    const bool ran = pipeline_->run_one();
+    guard.lock();
+    if (!ran) {
+      not_empty_.wait(guard, [this] { return !queue_.empty() || finished_workers_ == pipeline_->parallel_degree(); });
+    }
+  }
+  if (queue_.empty()) {
+    guard.unlock();
+    RC rc = pipeline_->wait();
+    return OB_FAIL(rc) ? rc : RC::RECORD_EOF;
+  }
+
+  current_ = std::move(queue_.front());
+  queue_.pop_front();
+  not_full_.notify_one();
+  guard.unlock();
+
+  return chunk.reference(*current_);
+}
+
+RC GatherVecPhysicalOperator::push(Chunk &chunk)
+{
+  if (chunk.selected_rows() == 0) {
+    return RC::SUCCESS;
+  }
+
+  // 工作算子输出的 chunk 引用的是它自己的数据，读取下一个 chunk 时就会被覆盖
+  auto copy = make_unique<Chunk>();
+  RC   rc   = chunk.materialize(*copy);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 在调用 next 的线程中执行时不能等待，等待的就是自己
+  const size_t       max_chunks = static_cast<size_t>(MAX_CHUNKS_PER_WORKER) * pipeline_->parallel_degree();
+  unique_lock<mutex> guard(lock_);
+  if (this_thread::get_id() != consumer_thread_) {
+    not_full_.wait(guard, [this, max_chunks] { return queue_.size() < max_chunks || stopping_; });
+  }
+  if (!stopping_) {
+    queue_.emplace_back(std::move(copy));
+    not_empty_.notify_one();
+  }
+  return rc;
+}
+
+RC GatherVecPhysicalOperator::stop()
+{
+  pipeline_->cancel();
+  {
+    lock_guard<mutex> guard(lock_);
+    stopping_ = true;
+    not_full_.notify_all();
+  }
+  RC rc = pipeline_->wait();
+  queue_.clear();
+  current_.reset();
+  return rc;
+}
+
+RC GatherVecPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  if (pipeline_ != nullptr) {
+    rc = stop();
+    pipeline_.reset();
+  }
+  children_[0]->close();
+  return rc;
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/deque.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "sql/operator/parallel_pipeline.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 汇集并行执行结果的物理算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 下层的流水线由多个工作算子并行执行，工作算子输出的 chunk 拷贝后放到队列中，当前算子在调用者的线程中
+ * 依次输出。输出的顺序与串行执行不同。队列满时工作算子等待，避免读取太多的数据。
+ * 队列为空时当前线程也领取还没有开始的工作算子执行，调度器的线程都在忙时也不会一直等待。
+ * 当前线程执行的工作算子在队列满时不等待，它的输出都放在队列中，执行完之后再依次输出。
+ * 第一次调用 next 时才开始并行执行，在这之前不占用调度器的线程。
+ * 下层的算子不能并行执行时直接输出下层算子的结果。
+ */
+class GatherVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit GatherVecPhysicalOperator(int parallel_degree) : parallel_degree_(parallel_degree) {}
+
+  virtual ~GatherVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::GATHER_VEC; }
+
+  string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  RC tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  /// 工作算子输出一个 chunk，在工作算子的线程中调用
+  RC push(Chunk &chunk);
+
+  /// 停止并行执行并等待所有工作算子结束
+  RC stop();
+
+private:
+  /// 队列中最多保存的每个工作算子的 chunk 个数
+  static constexpr int MAX_CHUNKS_PER_WORKER = 2;
+
+  int                          parallel_degree_ = 1;
+  Trx                         *trx_             = nullptr;
+  unique_ptr<ParallelPipeline> pipeline_;  ///< 为空表示串行执行
+  bool                         started_ = false;
+  thread::id                   consumer_thread_;  ///< 调用 next 的线程
+
+  mutex                    lock_;
+  condition_variable       not_empty_;
+  condition_variable       not_full_;
+  deque<unique_ptr<Chunk>> queue_;
+  int                      finished_workers_ = 0;
+  bool                     stopping_         = false;
+  unique_ptr<Chunk>        current_;  ///< 正在输出的 chunk
+};
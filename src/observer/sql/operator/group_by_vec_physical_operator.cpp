@@ -8,4 +8,211 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
-#include "sql/operator/group_by_vec_physical_operator.h"
\ No newline at end of file
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "common/lang/atomic.h"
+#include "common/log/log.h"
+#include "common/thread/task_scheduler.h"
+#include "sql/operator/parallel_pipeline.h"
+
+/// 并行聚合时分区的个数不少于线程个数的这么多倍，合并快的线程可以多处理几个分区
+static constexpr int PARTITIONS_PER_THREAD = 4;
+
+GroupByVecPhysicalOperator::GroupByVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions)
+    : group_by_exprs_(std::move(group_by_exprs)), aggregate_expressions_(std::move(expressions))
+{
+  for (size_t i = 0; i < group_by_exprs_.size(); i++) {
+    Expression *expr = group_by_exprs_[i].get();
+    linear_probing_  = linear_probing_ && LinearProbingAggregateHashTable::can_group_by(expr->value_type());
+    output_chunk_.add_column(make_unique<Column>(expr->value_type(), expr->value_length()), i);
+  }
+
+  for (size_t i = 0; i < aggregate_expressions_.size(); i++) {
+    Expression *expr = aggregate_expressions_[i];
+    ASSERT(expr->type() == ExprType::AGGREGATION, "expected an aggregation expression");
+    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    ASSERT(aggregate_expr->child() != nullptr, "aggregation expression must have a child expression");
+    value_expressions_.push_back(aggregate_expr->child().get());
+    output_chunk_.add_column(
+        make_unique<Column>(aggregate_expr->value_type(), aggregate_expr->value_length()), group_by_exprs_.size() + i);
+  }
+}
+
+string GroupByVecPhysicalOperator::param() const
+{
+  if (parallel_degree_ > 1 && linear_probing_ && !children_.empty() && children_[0]->parallel_safe()) {
+    return "parallel_degree=" + to_string(parallel_degree_);
+  }
+  return "";
+}
+
+unique_ptr<AggregateHashTable> GroupByVecPhysicalOperator::create_hash_table() const
+{
+  if (linear_probing_) {
+    return make_unique<LinearProbingAggregateHashTable>(aggregate_expressions_);
+  }
+  return make_unique<StandardAggregateHashTable>(aggregate_expressions_);
+}
+
+RC GroupByVecPhysicalOperator::open(Trx *trx)
+{
+  ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
+
+  hash_tables_.clear();
+  scanners_.clear();
+  scan_index_ = 0;
+
+  PhysicalOperator &child = *children_[0];
+  RC                rc    = child.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  ParallelPipeline pipeline;
+  rc = linear_probing_ ? pipeline.init(child, parallel_degree_) : RC::UNSUPPORTED;
+  if (OB_SUCC(rc)) {
+    rc = open_parallel(pipeline, trx);
+  } else if (rc == RC::UNSUPPORTED) {
+    unique_ptr<AggregateHashTable> hash_table = create_hash_table();
+    while (OB_SUCC(rc = child.next(chunk_))) {
+      rc = add_chunk(chunk_, *hash_table);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+    if (rc == RC::RECORD_EOF) {
+      rc = RC::SUCCESS;
+    }
+    hash_tables_.emplace_back(std::move(hash_table));
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (unique_ptr<AggregateHashTable> &hash_table : hash_tables_) {
+    unique_ptr<AggregateHashTable::Scanner> scanner;
+    if (linear_probing_) {
+      scanner = make_unique<LinearProbingAggregateHashTable::Scanner>(hash_table.get());
+    } else {
+      scanner = make_unique<StandardAggregateHashTable::Scanner>(hash_table.get());
+    }
+    scanner->open_scan();
+    scanners_.emplace_back(std::move(scanner));
+  }
+  return rc;
+}
+
+RC GroupByVecPhysicalOperator::add_chunk(Chunk &chunk, AggregateHashTable &hash_table) const
+{
+  RC    rc = RC::SUCCESS;
+  Chunk groups_chunk;
+  Chunk aggrs_chunk;
+  for (size_t i = 0; OB_SUCC(rc) && i < group_by_exprs_.size(); i++) {
+    auto column = make_unique<Column>();
+    rc          = group_by_exprs_[i]->get_column(chunk, *column);
+    groups_chunk.add_column(std::move(column), i);
+  }
+  for (size_t i = 0; OB_SUCC(rc) && i < value_expressions_.size(); i++) {
+    auto column = make_unique<Column>();
+    rc          = value_expressions_[i]->get_column(chunk, *column);
+    aggrs_chunk.add_column(std::move(column), i);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to evaluate group by expressions. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 分组和聚合的列与输入的 chunk 行数相同，只处理选择向量中的行
+  if (chunk.has_selection()) {
+    vector<int> selection = chunk.selection();
+    groups_chunk.set_selection(std::move(selection));
+  }
+
+  rc = hash_table.add_chunk(groups_chunk, aggrs_chunk);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to add chunk to aggregate hash table. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC GroupByVecPhysicalOperator::open_parallel(ParallelPipeline &pipeline, Trx *trx)
+{
+  vector<unique_ptr<LinearProbingAggregateHashTable>> local_tables;
+  for (int i = 0; i < pipeline.parallel_degree(); i++) {
+    local_tables.emplace_back(make_unique<LinearProbingAggregateHashTable>(aggregate_expressions_));
+  }
+
+  RC rc = pipeline.run(trx, [this, &local_tables](int worker_id, Chunk &chunk) {
+    return add_chunk(chunk, *local_tables[worker_id]);
+  });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to aggregate in parallel. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  int partition_bits = 0;
+  while ((1 << partition_bits) < parallel_degree_ * PARTITIONS_PER_THREAD) {
+    partition_bits++;
+  }
+  const int partition_num = 1 << partition_bits;
+
+  // 分组比较均匀地分布在各个分区中，按照最大的局部哈希表估计分区的大小，避免分区很多时预先分配太多内存
+  int max_local_size = 0;
+  for (unique_ptr<LinearProbingAggregateHashTable> &local_table : local_tables) {
+    max_local_size = std::max(max_local_size, local_table->size());
+  }
+  const int partition_capacity = 2 * (max_local_size / partition_num + 1);
+
+  vector<unique_ptr<AggregateHashTable>> partitions(partition_num);
+  atomic<int>                            next_partition(0);
+  rc = common::TaskScheduler::instance().run(parallel_degree_, [&](int /*worker_id*/) {
+    int partition = 0;
+    while ((partition = next_partition.fetch_add(1, std::memory_order_relaxed)) < partition_num) {
+      auto hash_table = make_unique<LinearProbingAggregateHashTable>(aggregate_expressions_, partition_capacity);
+      for (unique_ptr<LinearProbingAggregateHashTable> &local_table : local_tables) {
+        RC rc = hash_table->merge(*local_table, partition, partition_bits);
+        if (OB_FAIL(rc)) {
+          return rc;
+        }
+      }
+      partitions[partition] = std::move(hash_table);
+    }
+    return RC::SUCCESS;
+  });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to merge partitions of aggregate hash tables. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  hash_tables_ = std::move(partitions);
+  LOG_INFO("aggregate in parallel. parallel degree=%d, partitions=%d", parallel_degree_, partition_num);
+  return rc;
+}
+
+RC GroupByVecPhysicalOperator::next(Chunk &chunk)
+{
+  while (scan_index_ < scanners_.size()) {
+    output_chunk_.reset_data();
+    RC rc = scanners_[scan_index_]->next(output_chunk_);
+    if (rc == RC::RECORD_EOF || (OB_SUCC(rc) && output_chunk_.rows() == 0)) {
+      scan_index_++;
+      continue;
+    }
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    return chunk.reference(output_chunk_);
+  }
+  return RC::RECORD_EOF;
+}
+
+RC GroupByVecPhysicalOperator::close()
+{
+  for (unique_ptr<AggregateHashTable::Scanner> &scanner : scanners_) {
+    scanner->close_scan();
+  }
+  children_[0]->close();
+  LOG_INFO("close group by(vec) operator");
+  return RC::SUCCESS;
+}
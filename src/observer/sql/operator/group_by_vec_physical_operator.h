@@ -13,22 +13,60 @@ See the Mulan PSL v2 for more details. */
 #include "sql/expr/aggregate_hash_table.h"
 #include "sql/operator/physical_operator.h"
 
+class ParallelPipeline;
+
 /**
  * @brief Group By 物理算子(vectorized)
+ * @details 分组列的类型都支持时使用 LinearProbingAggregateHashTable，否则使用 StandardAggregateHashTable。
+ * 输出的 chunk 中先是分组列，然后是聚合列，与生成逻辑计划时设置的表达式位置一致。
+ * 并行度大于 1、下层的流水线可以并行执行并且使用 LinearProbingAggregateHashTable 时，使用多个线程并行聚合。
  * @ingroup PhysicalOperator
  */
 class GroupByVecPhysicalOperator : public PhysicalOperator
 {
 public:
-  GroupByVecPhysicalOperator(vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions){};
+  GroupByVecPhysicalOperator(vector<unique_ptr<Expression>> &&group_by_exprs, vector<Expression *> &&expressions);
 
   virtual ~GroupByVecPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::GROUP_BY_VEC; }
 
-  RC open(Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC next(Chunk &chunk) override { return RC::UNIMPLEMENTED; }
-  RC close() override { return RC::UNIMPLEMENTED; }
+  void set_parallel_degree(int parallel_degree) { parallel_degree_ = parallel_degree; }
+
+  string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  unique_ptr<AggregateHashTable> create_hash_table() const;
+
+  /**
+   * @brief 计算 chunk 的分组列和聚合列，写入哈希表
+   * @details 不修改算子的成员，并行聚合时多个线程同时调用
+   */
+  RC add_chunk(Chunk &chunk, AggregateHashTable &hash_table) const;
+
+  /**
+   * @brief 并行聚合
+   * @details 1. 每个工作算子执行下层流水线的一部分数据，预聚合到自己的哈希表中；
+   * 2. 按照分组哈希值的高位把分组划分到多个分区，每个线程领取分区，把所有线程的哈希表中属于这个分区的分组合并到一起。
+   * 不同分区的分组不会相同，合并时不需要加锁，每个分区的哈希表依次输出
+   */
+  RC open_parallel(ParallelPipeline &pipeline, Trx *trx);
 
 private:
+  vector<unique_ptr<Expression>> group_by_exprs_;
+  vector<Expression *>           aggregate_expressions_;  /// 聚合表达式
+  vector<Expression *>           value_expressions_;      /// 聚合表达式的子表达式
+  bool                           linear_probing_  = true;
+  int                            parallel_degree_ = 1;
+
+  /// 聚合的结果，并行聚合时每个分区一个哈希表
+  vector<unique_ptr<AggregateHashTable>>          hash_tables_;
+  vector<unique_ptr<AggregateHashTable::Scanner>> scanners_;
+  size_t                                          scan_index_ = 0;  /// 正在输出的哈希表
+  Chunk                                           chunk_;
+  Chunk                                           output_chunk_;
 };
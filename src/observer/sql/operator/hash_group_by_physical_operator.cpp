@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/hash_group_by_physical_operator.h"
 #include "sql/expr/expression_tuple.h"
 #include "sql/expr/composite_tuple.h"
+#include "sql/expr/value_hash_set.h"
 
 using namespace std;
 using namespace common;
@@ -37,6 +38,14 @@ RC HashGroupByPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
+  // 重新打开时（比如子查询再次执行）从头开始分组
+  groups_.clear();
+  group_index_.clear();
+  use_index_ = true;
+  for (const unique_ptr<Expression> &expr : group_by_exprs_) {
+    use_index_ = use_index_ && ValueHashSet::support(expr->value_type());
+  }
+
   ExpressionTuple<Expression *> group_value_expression_tuple(value_expressions_);
 
   ValueListTuple group_by_evaluated_tuple;
@@ -141,18 +150,33 @@ RC HashGroupByPhysicalOperator::find_group(const Tuple &child_tuple, GroupType *
     return rc;
   }
 
-  // 找到对应的group
-  for (GroupType &group : groups_) {
-    int compare_result = 0;
-    rc                 = group_by_evaluated_tuple.compare(get<0>(group), compare_result);
-    if (OB_FAIL(rc)) {
-      LOG_WARN("failed to compare group by values. rc=%s", strrc(rc));
+  if (use_index_) {
+    group_key_.clear();
+    Value value;
+    for (int i = 0; i < group_by_evaluated_tuple.cell_num(); i++) {
+      group_by_evaluated_tuple.cell_at(i, value);
+      ValueHashSet::encode(value, group_key_);
+    }
+    auto iter = group_index_.find(group_key_);
+    if (iter != group_index_.end()) {
+      found_group = &groups_[iter->second];
       return rc;
     }
-
-    if (compare_result == 0) {
-      found_group = &group;
-      break;
+    group_index_.emplace(group_key_, groups_.size());
+  } else {
+    // 找到对应的group
+    for (GroupType &group : groups_) {
+      int compare_result = 0;
+      rc                 = group_by_evaluated_tuple.compare(get<0>(group), compare_result);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to compare group by values. rc=%s", strrc(rc));
+        return rc;
+      }
+
+      if (compare_result == 0) {
+        found_group = &group;
+        break;
+      }
     }
   }
 
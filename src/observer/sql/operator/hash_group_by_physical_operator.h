@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/unordered_map.h"
 #include "sql/operator/group_by_physical_operator.h"
 #include "sql/expr/composite_tuple.h"
 
@@ -21,8 +22,8 @@ See the Mulan PSL v2 for more details. */
  * @brief Group By Hash 方式物理算子
  * @ingroup PhysicalOperator
  * @details 通过 hash 的方式进行 group by 操作。当聚合函数存在 group by
- * 表达式时，默认采用这个物理算子（当前也只有这个物理算子）。 NOTE:
- * 当前并没有使用hash方式实现，而是每次使用线性查找的方式。
+ * 表达式时，默认采用这个物理算子（当前也只有这个物理算子）。
+ * 分组的值按照 ValueHashSet::encode 编码后在哈希表中查找，有不支持编码的类型时使用线性查找。
  */
 class HashGroupByPhysicalOperator : public GroupByPhysicalOperator
 {
@@ -54,9 +55,12 @@ private:
 
   /// 一组一条数据
   /// pair的first是group by 的值列表，second是计算出来的表达式值列表
-  /// TODO 改成hash/unordered_map
   vector<GroupType> groups_;
 
+  bool                          use_index_ = false;
+  unordered_map<string, size_t> group_index_;  ///< 编码后的分组的值在 groups_ 中的下标
+  string                        group_key_;
+
   vector<GroupType>::iterator current_group_;
   bool                        first_emited_ = false;  /// 第一条数据是否已经输出
 };
@@ -0,0 +1,274 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "common/log/log.h"
+
+HashJoinVecPhysicalOperator::HashJoinVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys, JoinType join_type)
+    : join_type_(join_type), left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys))
+{
+  ASSERT((join_type_ != JoinType::INNER || !left_keys_.empty()) && left_keys_.size() == right_keys_.size(),
+      "invalid hash join keys");
+}
+
+string HashJoinVecPhysicalOperator::param() const
+{
+  string param;
+  if (join_type_ != JoinType::INNER) {
+    param = join_type_to_string(join_type_);
+    if (!left_keys_.empty()) {
+      param += " ";
+    }
+  }
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    if (i > 0) {
+      param += " AND ";
+    }
+    param += left_keys_[i]->name();
+    param += "=";
+    param += right_keys_[i]->name();
+  }
+  return param;
+}
+
+RC HashJoinVecPhysicalOperator::open(Trx *trx)
+{
+  hash_table_.clear();
+  key_set_.clear();
+  build_rows_     = 0;
+  build_has_null_ = false;
+  left_row_       = 0;
+  matches_   = nullptr;
+  match_idx_ = 0;
+  left_key_columns_.clear();
+  return JoinVecPhysicalOperator::open(trx);
+}
+
+RC HashJoinVecPhysicalOperator::close()
+{
+  hash_table_.clear();
+  key_set_.clear();
+  left_key_columns_.clear();
+  return JoinVecPhysicalOperator::close();
+}
+
+RC HashJoinVecPhysicalOperator::on_right_chunk(int chunk_idx)
+{
+  Chunk                     &chunk = *right_chunks_[chunk_idx];
+  vector<unique_ptr<Column>> key_columns;
+  RC                         rc = eval_keys(right_keys_, chunk, key_columns);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  build_rows_ += chunk.rows();
+  for (int row = 0; row < chunk.rows(); row++) {
+    if (has_null_key(key_columns, row)) {
+      build_has_null_ = true;
+      continue;
+    }
+    make_key(key_columns, row, key_);
+    if (join_type_ == JoinType::INNER) {
+      hash_table_[key_].push_back(RowRef{chunk_idx, row});
+    } else {
+      key_set_.insert(key_);
+    }
+  }
+  return rc;
+}
+
+RC HashJoinVecPhysicalOperator::create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers)
+{
+  vector<unique_ptr<PhysicalOperator>> left_workers;
+  RC                                   rc = children_[0]->create_workers(parallel_degree, left_workers);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (unique_ptr<PhysicalOperator> &left_worker : left_workers) {
+    unique_ptr<HashJoinVecPhysicalOperator> worker(new HashJoinVecPhysicalOperator());
+    worker->parent_    = this;
+    worker->join_type_ = join_type_;
+    worker->add_child(std::move(left_worker));
+    workers.emplace_back(std::move(worker));
+  }
+  return rc;
+}
+
+RC HashJoinVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (join_type_ != JoinType::INNER) {
+    return semi_next(chunk);
+  }
+
+  const HashJoinVecPhysicalOperator &build = build_side();
+  if (build.right_chunks_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = RC::SUCCESS;
+  output_chunk_.reset_data();
+  while (output_space() > 0) {
+    if (matches_ != nullptr) {
+      while (match_idx_ < matches_->size() && output_space() > 0) {
+        const RowRef &ref = (*matches_)[match_idx_++];
+        rc                = append_joined_rows(left_row_, *build.right_chunks_[ref.chunk_idx], ref.row, 1);
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to append joined rows. rc=%s", strrc(rc));
+          return rc;
+        }
+      }
+      if (match_idx_ < matches_->size()) {
+        break;
+      }
+      matches_ = nullptr;
+      left_row_++;
+    }
+
+    if (left_row_ >= left_chunk_.selected_rows()) {
+      rc = left_next();
+      if (OB_FAIL(rc)) {
+        break;
+      }
+      left_row_ = 0;
+      rc        = eval_keys(build.left_keys_, left_chunk_, left_key_columns_);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      continue;
+    }
+
+    const int left_idx = left_chunk_.row_index(left_row_);
+    if (has_null_key(left_key_columns_, left_idx)) {
+      left_row_++;
+      continue;
+    }
+    make_key(left_key_columns_, left_idx, key_);
+    auto iter = build.hash_table_.find(key_);
+    if (iter == build.hash_table_.end()) {
+      left_row_++;
+    } else {
+      matches_   = &iter->second;
+      match_idx_ = 0;
+    }
+  }
+
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read left child. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (output_chunk_.rows() == 0) {
+    return RC::RECORD_EOF;
+  }
+  return chunk.reference(output_chunk_);
+}
+
+RC HashJoinVecPhysicalOperator::semi_next(Chunk &chunk)
+{
+  const HashJoinVecPhysicalOperator &build = build_side();
+  const bool                         semi  = join_type_ == JoinType::SEMI;
+  // 这几种情况下没有输出，不需要读取左边的数据
+  if (build.left_keys_.empty() ? semi == (build.build_rows_ == 0)
+                               : (semi ? build.key_set_.empty()
+                                       : join_type_ == JoinType::NULL_AWARE_ANTI && build.build_has_null_)) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = RC::SUCCESS;
+  while (OB_SUCC(rc = children_[0]->next(chunk))) {
+    if (chunk.selected_rows() == 0) {
+      continue;
+    }
+    // 没有连接键，或者右边为空的 anti join，左边所有的行都输出
+    if (build.left_keys_.empty() || build.build_rows_ == 0) {
+      return rc;
+    }
+
+    rc = eval_keys(build.left_keys_, chunk, left_key_columns_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    chunk.init_select(select_);
+    for (int i = 0; i < chunk.selected_rows(); i++) {
+      const int row = chunk.row_index(i);
+      if (has_null_key(left_key_columns_, row)) {
+        // 左边的连接键是 NULL 时不会匹配，NOT IN 的结果是 NULL
+        select_[row] = join_type_ == JoinType::ANTI ? 1 : 0;
+        continue;
+      }
+      make_key(left_key_columns_, row, key_);
+      const bool found = build.key_set_.count(key_) > 0;
+      select_[row]     = found == semi ? 1 : 0;
+    }
+    chunk.set_selection(select_);
+    if (chunk.selected_rows() > 0) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC HashJoinVecPhysicalOperator::eval_keys(
+    const vector<unique_ptr<Expression>> &keys, Chunk &chunk, vector<unique_ptr<Column>> &columns)
+{
+  columns.clear();
+  for (const unique_ptr<Expression> &key : keys) {
+    auto column = make_unique<Column>();
+    RC   rc     = key->get_column(chunk, *column);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    columns.emplace_back(std::move(column));
+  }
+  return RC::SUCCESS;
+}
+
+bool HashJoinVecPhysicalOperator::has_null_key(const vector<unique_ptr<Column>> &columns, int row)
+{
+  for (const unique_ptr<Column> &column : columns) {
+    if (column->is_null(row)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void HashJoinVecPhysicalOperator::make_key(const vector<unique_ptr<Column>> &columns, int row, string &key)
+{
+  key.clear();
+  for (const unique_ptr<Column> &column : columns) {
+    const int   len  = column->attr_len();
+    const char *data = column->data();
+    if (column->column_type() == Column::Type::NORMAL_COLUMN) {
+      data += static_cast<size_t>(row) * len;
+    }
+
+    switch (column->attr_type()) {
+      case AttrType::CHARS: {
+        // 定长字符串后面可能有没有清零的字节，只取到第一个 '\0'
+        key.append(data, strnlen(data, len));
+        key.push_back('\0');
+      } break;
+      case AttrType::FLOATS: {
+        float value;
+        memcpy(&value, data, sizeof(value));
+        if (value == 0) {
+          value = 0;  // -0.0 与 0.0 相等
+        }
+        key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+      } break;
+      default: {
+        key.append(data, len);
+      } break;
+    }
+  }
+}
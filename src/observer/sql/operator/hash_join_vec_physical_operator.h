@@ -0,0 +1,95 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#pragma once
+
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/join_vec_physical_operator.h"
+
+/**
+ * @brief Hash Join 算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 用右孩子建立哈希表，左孩子逐个 chunk 探测。
+ * 只处理等值连接条件，左右两边的连接键分别在左右孩子返回的 chunk 上计算，其它条件由上层的过滤算子计算。
+ * 连接键是 NULL 的行不会匹配。
+ * semi/anti join（参考 JoinType）只需要右边连接键的集合，探测时只修改左边 chunk 的选择向量，不拷贝数据。
+ * 左孩子可以并行执行时，多个工作算子使用同一个哈希表并行探测。
+ */
+class HashJoinVecPhysicalOperator : public JoinVecPhysicalOperator
+{
+public:
+  HashJoinVecPhysicalOperator(vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys,
+      JoinType join_type = JoinType::INNER);
+  virtual ~HashJoinVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN_VEC; }
+
+  string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  bool parallel_safe() const override { return children_[0]->parallel_safe(); }
+  RC   create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers) override;
+
+protected:
+  RC on_right_chunk(int chunk_idx) override;
+
+private:
+  /// 并行探测的工作算子
+  HashJoinVecPhysicalOperator() = default;
+
+  /// semi/anti join 的探测，在左边的 chunk 上设置选择向量
+  RC semi_next(Chunk &chunk);
+
+  struct RowRef
+  {
+    int chunk_idx;
+    int row;
+  };
+
+  /**
+   * @brief 计算 chunk 上的连接键
+   */
+  static RC eval_keys(const vector<unique_ptr<Expression>> &keys, Chunk &chunk, vector<unique_ptr<Column>> &columns);
+
+  /**
+   * @brief 把一行的连接键编码成字符串，作为哈希表的 key
+   */
+  static void make_key(const vector<unique_ptr<Column>> &columns, int row, string &key);
+
+  static bool has_null_key(const vector<unique_ptr<Column>> &columns, int row);
+
+  /// 工作算子使用创建它的算子的连接键和哈希表
+  const HashJoinVecPhysicalOperator &build_side() const
+  {
+    return parent_ != nullptr ? static_cast<const HashJoinVecPhysicalOperator &>(*parent_) : *this;
+  }
+
+private:
+  JoinType                       join_type_ = JoinType::INNER;
+  vector<unique_ptr<Expression>> left_keys_;
+  vector<unique_ptr<Expression>> right_keys_;
+
+  unordered_map<string, vector<RowRef>> hash_table_;
+  unordered_set<string>                 key_set_;                ///< semi/anti join 右边的连接键
+  int64_t                               build_rows_     = 0;     ///< 右边的行数
+  bool                                  build_has_null_ = false;  ///< 右边是否有 NULL 的连接键
+  vector<uint8_t>                       select_;
+
+  vector<unique_ptr<Column>> left_key_columns_;  ///< 当前左边 chunk 的连接键
+  string                     key_;
+  int                        left_row_  = 0;        ///< 当前左边 chunk 中正在探测第几个有效的行
+  const vector<RowRef>      *matches_   = nullptr;  ///< 当前行在右边匹配的行
+  size_t                     match_idx_ = 0;        ///< 下一个要输出的匹配行
+};
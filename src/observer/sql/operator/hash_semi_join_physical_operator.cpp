@@ -0,0 +1,161 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/hash_semi_join_physical_operator.h"
+#include "common/log/log.h"
+#include "sql/expr/value_hash_set.h"
+
+HashSemiJoinPhysicalOperator::HashSemiJoinPhysicalOperator(
+    JoinType join_type, vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys)
+    : join_type_(join_type), left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys))
+{
+  ASSERT(join_type_ != JoinType::INNER && left_keys_.size() == right_keys_.size(), "invalid hash semi join");
+}
+
+string HashSemiJoinPhysicalOperator::param() const
+{
+  string param = join_type_to_string(join_type_);
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    param += i == 0 ? " " : " AND ";
+    param += left_keys_[i]->name();
+    param += "=";
+    param += right_keys_[i]->name();
+  }
+  return param;
+}
+
+RC HashSemiJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash semi join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  RC rc = build(trx);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  const bool semi = join_type_ == JoinType::SEMI;
+  if (left_keys_.empty()) {
+    left_all_ = semi != (build_rows_ == 0);
+    no_rows_  = !left_all_;
+  } else {
+    left_all_ = !semi && build_rows_ == 0;
+    no_rows_  = semi ? key_set_.empty() : join_type_ == JoinType::NULL_AWARE_ANTI && build_has_null_;
+  }
+
+  rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open left child. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC HashSemiJoinPhysicalOperator::build(Trx *trx)
+{
+  key_set_.clear();
+  build_rows_     = 0;
+  build_has_null_ = false;
+
+  PhysicalOperator &right = *children_[1];
+  RC                rc    = right.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open right child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  while (OB_SUCC(rc = right.next())) {
+    build_rows_++;
+    // 没有连接键时只需要知道右边是否为空
+    if (right_keys_.empty()) {
+      rc = RC::RECORD_EOF;
+      break;
+    }
+
+    bool has_null = false;
+    rc            = make_key(right_keys_, *right.current_tuple(), key_, has_null);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get value of right key. rc=%s", strrc(rc));
+      break;
+    }
+    if (has_null) {
+      build_has_null_ = true;
+    } else {
+      key_set_.insert(key_);
+    }
+  }
+  right.close();
+
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read right child. rc=%s", strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC HashSemiJoinPhysicalOperator::make_key(
+    const vector<unique_ptr<Expression>> &keys, const Tuple &tuple, string &key, bool &has_null)
+{
+  key.clear();
+  has_null = false;
+  Value value;
+  for (const unique_ptr<Expression> &expr : keys) {
+    RC rc = expr->get_value(tuple, value);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (value.is_null()) {
+      has_null = true;
+      return RC::SUCCESS;
+    }
+    ValueHashSet::encode(value, key);
+  }
+  return RC::SUCCESS;
+}
+
+RC HashSemiJoinPhysicalOperator::next()
+{
+  if (no_rows_) {
+    return RC::RECORD_EOF;
+  }
+
+  PhysicalOperator &left = *children_[0];
+  RC                rc   = RC::SUCCESS;
+  while (OB_SUCC(rc = left.next())) {
+    if (left_all_) {
+      return rc;
+    }
+
+    bool has_null = false;
+    rc            = make_key(left_keys_, *left.current_tuple(), key_, has_null);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get value of left key. rc=%s", strrc(rc));
+      return rc;
+    }
+    // 左边的连接键是 NULL 时不会匹配，NOT IN 的结果是 NULL
+    if (has_null) {
+      if (join_type_ == JoinType::ANTI) {
+        return rc;
+      }
+      continue;
+    }
+    if ((key_set_.count(key_) > 0) == (join_type_ == JoinType::SEMI)) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC HashSemiJoinPhysicalOperator::close()
+{
+  key_set_.clear();
+  return children_[0]->close();
+}
@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/unordered_set.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief Hash semi/anti join 算子
+ * @ingroup PhysicalOperator
+ * @details open 时把右孩子的连接键放到哈希集合中，然后逐行读取左孩子，只输出左边的行（参考 JoinType）。
+ * 由 IN/EXISTS 子查询改写而来，连接条件都是等值比较，左右两边的连接键编码后放到哈希集合中，
+ * 参考 ValueHashSet::encode。没有连接键时只看右边是否为空。
+ */
+class HashSemiJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  HashSemiJoinPhysicalOperator(
+      JoinType join_type, vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys);
+  virtual ~HashSemiJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_SEMI_JOIN; }
+
+  string param() const override;
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override { return children_[0]->current_tuple(); }
+
+  RC tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  RC build(Trx *trx);
+
+  /**
+   * @brief 计算一行的连接键并编码
+   * @param[out] has_null 是否有连接键是 NULL，这时 key 没有意义
+   */
+  static RC make_key(const vector<unique_ptr<Expression>> &keys, const Tuple &tuple, string &key, bool &has_null);
+
+private:
+  JoinType                       join_type_;
+  vector<unique_ptr<Expression>> left_keys_;
+  vector<unique_ptr<Expression>> right_keys_;
+  unordered_set<string>          key_set_;
+  int64_t                        build_rows_     = 0;      ///< 右边的行数
+  bool                           build_has_null_ = false;  ///< 右边是否有 NULL 的连接键
+  bool                           left_all_       = false;  ///< 左边所有的行都输出
+  bool                           no_rows_        = false;  ///< 没有输出
+  string                         key_;
+};
@@ -13,24 +13,20 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/index_scan_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "storage/index/index.h"
 #include "storage/trx/trx.h"
 
-IndexScanPhysicalOperator::IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, const Value *left_value,
-    bool left_inclusive, const Value *right_value, bool right_inclusive)
+IndexScanPhysicalOperator::IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode,
+    const vector<Value> &left_values, bool left_inclusive, const vector<Value> &right_values, bool right_inclusive)
     : table_(table),
       index_(index),
       mode_(mode),
+      left_values_(left_values),
+      right_values_(right_values),
       left_inclusive_(left_inclusive),
       right_inclusive_(right_inclusive)
-{
-  if (left_value) {
-    left_value_ = *left_value;
-  }
-  if (right_value) {
-    right_value_ = *right_value;
-  }
-}
+{}
 
 RC IndexScanPhysicalOperator::open(Trx *trx)
 {
@@ -38,18 +34,22 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
-      left_value_.length(),
-      left_inclusive_,
-      right_value_.data(),
-      right_value_.length(),
-      right_inclusive_);
+  IndexScanner *index_scanner = index_->create_scanner(left_values_, left_inclusive_, right_values_, right_inclusive_);
   if (nullptr == index_scanner) {
     LOG_WARN("failed to create index scanner");
     return RC::INTERNAL;
   }
   index_scanner_ = index_scanner;
 
+  key_length_ = index_->key_length();
+  entry_rids_.resize(BATCH_SIZE);
+  entry_keys_.resize(static_cast<size_t>(BATCH_SIZE) * key_length_);
+  entry_order_.resize(BATCH_SIZE);
+  rids_.resize(BATCH_SIZE);
+  records_.resize(BATCH_SIZE);
+  record_index_ = 0;
+  record_count_ = 0;
+
   tuple_.set_schema(table_, table_->table_meta().field_metas());
 
   trx_ = trx;
@@ -66,18 +66,36 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
 RC IndexScanPhysicalOperator::next()
 {
   // TODO: 需要适配 lsm-tree 引擎
-  RID rid;
-  RC  rc = RC::SUCCESS;
+  RC rc = RC::SUCCESS;
 
   bool filter_result = false;
-  while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
-    rc = table_->get_record(rid, current_record_);
-    if (OB_FAIL(rc)) {
-      LOG_TRACE("failed to get record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
-      return rc;
+  while (true) {
+    if (record_index_ >= record_count_) {
+      rc = fetch_batch();
+      if (OB_FAIL(rc)) {
+        break;
+      }
+    }
+
+    const int record_index = record_index_++;
+    current_record_        = std::move(records_[record_index]);
+    LOG_TRACE("got a record. rid=%s", current_record_.rid().to_string().c_str());
+
+    // 只读访问时，事务可能会把记录替换成当前事务可见的旧版本，所以要先判断可见性再过滤
+    if (mode_ == ReadWriteMode::READ_ONLY) {
+      rc = trx_->visit_record(table_, current_record_, mode_);
+      if (rc == RC::RECORD_INVISIBLE) {
+        LOG_TRACE("record invisible");
+        continue;
+      } else if (OB_FAIL(rc)) {
+        return rc;
+      }
     }
 
-    LOG_TRACE("got a record. rid=%s", rid.to_string().c_str());
+    if (!match_entry_key(current_record_, record_index)) {
+      LOG_TRACE("index entry belongs to another version of the record");
+      continue;
+    }
 
     tuple_.set_record(&current_record_);
     rc = filter(tuple_, filter_result);
@@ -91,6 +109,10 @@ RC IndexScanPhysicalOperator::next()
       continue;
     }
 
+    if (mode_ == ReadWriteMode::READ_ONLY) {
+      return rc;
+    }
+
     rc = trx_->visit_record(table_, current_record_, mode_);
     if (rc == RC::RECORD_INVISIBLE) {
       LOG_TRACE("record invisible");
@@ -103,13 +125,71 @@ RC IndexScanPhysicalOperator::next()
   return rc;
 }
 
+RC IndexScanPhysicalOperator::fetch_batch()
+{
+  RC  rc    = RC::SUCCESS;
+  int count = 0;
+  while (count < BATCH_SIZE) {
+    int fetched = 0;
+    if (key_length_ > 0) {
+      rc = index_scanner_->next_entries_with_keys(entry_rids_.data() + count,
+          entry_keys_.data() + static_cast<size_t>(count) * key_length_, BATCH_SIZE - count, fetched);
+    } else {
+      rc = index_scanner_->next_entries(entry_rids_.data() + count, BATCH_SIZE - count, fetched);
+    }
+    if (rc == RC::RECORD_EOF) {
+      break;
+    } else if (OB_FAIL(rc)) {
+      LOG_WARN("failed to fetch rids from index. rc=%s", strrc(rc));
+      return rc;
+    }
+    count += fetched;
+  }
+
+  if (count == 0) {
+    return RC::RECORD_EOF;
+  }
+
+  // 按照页面顺序读取，同一个页面的记录只需要访问一次页面
+  for (int i = 0; i < count; i++) {
+    entry_order_[i] = i;
+  }
+  sort(entry_order_.begin(), entry_order_.begin() + count, [this](int left, int right) {
+    return RID::compare(&entry_rids_[left], &entry_rids_[right]) < 0;
+  });
+  for (int i = 0; i < count; i++) {
+    rids_[i] = entry_rids_[entry_order_[i]];
+  }
+
+  rc = table_->get_records(rids_.data(), count, records_.data());
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get records. count=%d, rc=%s", count, strrc(rc));
+    return rc;
+  }
+
+  record_index_ = 0;
+  record_count_ = count;
+  return RC::SUCCESS;
+}
+
 RC IndexScanPhysicalOperator::close()
 {
   index_scanner_->destroy();
   index_scanner_ = nullptr;
+  record_index_  = 0;
+  record_count_  = 0;
   return RC::SUCCESS;
 }
 
+bool IndexScanPhysicalOperator::match_entry_key(const Record &record, int record_index) const
+{
+  if (key_length_ == 0) {
+    return true;
+  }
+  const char *key = entry_keys_.data() + static_cast<size_t>(entry_order_[record_index]) * key_length_;
+  return index_->match_key(record.data(), key);
+}
+
 Tuple *IndexScanPhysicalOperator::current_tuple()
 {
   tuple_.set_record(&current_record_);
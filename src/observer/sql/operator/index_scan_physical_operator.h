@@ -21,12 +21,18 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief 索引扫描物理算子
  * @ingroup PhysicalOperator
+ * @details 每次从索引中批量取出一批 RID，按照页面顺序排序之后再批量读取记录，这样同一个页面在一批数据中只访问一次。
+ * 因此输出的记录不保证是索引的顺序
  */
 class IndexScanPhysicalOperator : public PhysicalOperator
 {
 public:
-  IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, const Value *left_value,
-      bool left_inclusive, const Value *right_value, bool right_inclusive);
+  /**
+   * @param left_values 左边界，对应索引的前几个字段，为空表示没有左边界
+   * @param right_values 右边界，对应索引的前几个字段，为空表示没有右边界
+   */
+  IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, const vector<Value> &left_values,
+      bool left_inclusive, const vector<Value> &right_values, bool right_inclusive);
 
   virtual ~IndexScanPhysicalOperator() = default;
 
@@ -46,6 +52,22 @@ private:
   // 与TableScanPhysicalOperator代码相同，可以优化
   RC filter(RowTuple &tuple, bool &result);
 
+  /**
+   * @brief 从索引中取出下一批 RID，并按照页面顺序读取记录
+   * @return RC RECORD_EOF 表示索引中没有更多的数据
+   */
+  RC fetch_batch();
+
+  /**
+   * @brief 记录是否与读出它的索引项的键值相同
+   * @details 原地更新的记录在索引中每个不同的键值各有一个索引项，只保留与可见版本的键值相同的那一个，
+   * 这样同一条记录只输出一次
+   */
+  bool match_entry_key(const Record &record, int record_index) const;
+
+private:
+  static constexpr int BATCH_SIZE = 1024;  ///< 每批从索引中读取的最大 RID 数
+
 private:
   Trx          *trx_           = nullptr;
   Table        *table_         = nullptr;
@@ -56,10 +78,19 @@ private:
   Record   current_record_;
   RowTuple tuple_;
 
-  Value left_value_;
-  Value right_value_;
-  bool  left_inclusive_  = false;
-  bool  right_inclusive_ = false;
+  vector<RID>    entry_rids_;        ///< 索引项中的 RID，按照索引的顺序
+  vector<char>   entry_keys_;        ///< 索引项中的键值，与 entry_rids_ 对应
+  vector<int>    entry_order_;       ///< 按照页面顺序排列的索引项编号，与 records_ 对应
+  vector<RID>    rids_;              ///< 按照页面顺序排列的 RID
+  vector<Record> records_;
+  int            record_index_ = 0;  ///< 下一个要处理的记录在 records_ 中的位置
+  int            record_count_ = 0;  ///< records_ 中当前批次的有效记录数
+  int            key_length_   = 0;  ///< 索引项键值的长度，为 0 时索引不能返回键值，不检查键值
+
+  vector<Value> left_values_;
+  vector<Value> right_values_;
+  bool          left_inclusive_  = false;
+  bool          right_inclusive_ = false;
 
   vector<unique_ptr<Expression>> predicates_;
 };
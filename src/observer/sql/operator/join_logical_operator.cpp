@@ -0,0 +1,36 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/join_logical_operator.h"
+#include "sql/optimizer/cascade/property.h"
+#include "sql/optimizer/statistics/selectivity.h"
+
+unique_ptr<LogicalProperty> JoinLogicalOperator::find_log_prop(const vector<LogicalProperty *> &log_props)
+{
+  if (log_props.size() != 2) {
+    return nullptr;
+  }
+
+  LogicalProperty *left_log_prop  = log_props[0];
+  LogicalProperty *right_log_prop = log_props[1];
+  if (join_type_ != JoinType::INNER) {
+    return make_unique<LogicalProperty>(left_log_prop->get_card());
+  }
+
+  const double left_card  = left_log_prop->get_card();
+  const double right_card = right_log_prop->get_card();
+  double       card       = left_card * right_card;
+  for (unique_ptr<Expression> &predicate : join_predicates_) {
+    if (predicate != nullptr) {
+      card *= Selectivity::estimate_join(*predicate, left_card, right_card);
+    }
+  }
+  return make_unique<LogicalProperty>(LogicalProperty::to_card(card));
+}
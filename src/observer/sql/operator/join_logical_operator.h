@@ -25,9 +25,11 @@ class JoinLogicalOperator : public LogicalOperator
 {
 public:
   JoinLogicalOperator()          = default;
+  explicit JoinLogicalOperator(JoinType join_type) : join_type_(join_type) {}
   virtual ~JoinLogicalOperator() = default;
 
   LogicalOperatorType type() const override { return LogicalOperatorType::JOIN; }
+  JoinType            join_type() const { return join_type_; }
   void                add_predicate_op(LogicalOperator *predicate_op) { predicate_op_ = predicate_op; }
   auto                predicates() -> Expression *
   {
@@ -45,31 +47,14 @@ public:
 
   auto add_join_predicate(unique_ptr<Expression> &&predicate) { join_predicates_.push_back(std::move(predicate)); }
 
-  unique_ptr<LogicalProperty> find_log_prop(const vector<LogicalProperty *> &log_props) override
-  {
-    if (log_props.size() != 2) {
-      return nullptr;
-    }
-
-    LogicalProperty *left_log_prop  = log_props[0];
-    LogicalProperty *right_log_prop = log_props[1];
-    int              card           = left_log_prop->get_card() * right_log_prop->get_card();
-    for (auto &predicate : join_predicates_) {
-      if (predicate->type() != ExprType::COMPARISON) {
-        continue;
-      }
-      auto  pred_expr = dynamic_cast<ComparisonExpr *>(predicate.get());
-      auto &left      = pred_expr->left();
-      auto &right     = pred_expr->right();
-      if (pred_expr->comp() == CompOp::EQUAL_TO && left->type() == ExprType::FIELD &&
-          right->type() == ExprType::FIELD) {
-        card /= std::max(std::max(left_log_prop->get_card(), right_log_prop->get_card()), 1);
-      }
-    }
-    return make_unique<LogicalProperty>(card);
-  }
+  /**
+   * @brief 估计连接的输出行数
+   * @details 内连接按照连接条件的选择率估计，参考 Selectivity::estimate_join。其它连接按照左表的行数估计
+   */
+  unique_ptr<LogicalProperty> find_log_prop(const vector<LogicalProperty *> &log_props) override;
 
 private:
+  JoinType                            join_type_    = JoinType::INNER;
   LogicalOperator                    *predicate_op_ = nullptr;
   std::vector<unique_ptr<Expression>> join_predicates_;
 };
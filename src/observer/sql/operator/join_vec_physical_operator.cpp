@@ -0,0 +1,151 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "sql/operator/join_vec_physical_operator.h"
+#include "common/log/log.h"
+
+RC JoinVecPhysicalOperator::open(Trx *trx)
+{
+  left_eof_ = false;
+  left_chunk_.reset();
+  output_chunk_.reset();
+  if (parent_ != nullptr) {
+    return children_[0]->open(trx);
+  }
+
+  if (children_.size() != 2) {
+    LOG_WARN("join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  RC rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open left child. rc=%s", strrc(rc));
+    return rc;
+  }
+  rc = children_[1]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open right child. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  Chunk right_chunk;
+  while (OB_SUCC(rc = children_[1]->next(right_chunk))) {
+    if (right_chunk.selected_rows() == 0) {
+      continue;
+    }
+    // 右表需要多次访问，只保存有效的行
+    auto chunk = make_unique<Chunk>();
+    rc         = right_chunk.materialize(*chunk);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    right_chunks_.emplace_back(std::move(chunk));
+    rc = on_right_chunk(static_cast<int>(right_chunks_.size()) - 1);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read right child. rc=%s", strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+RC JoinVecPhysicalOperator::close()
+{
+  right_chunks_.clear();
+  for (unique_ptr<PhysicalOperator> &child : children_) {
+    child->close();
+  }
+  return RC::SUCCESS;
+}
+
+RC JoinVecPhysicalOperator::left_next()
+{
+  if (left_eof_) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = children_[0]->next(left_chunk_);
+  if (rc == RC::RECORD_EOF) {
+    left_eof_ = true;
+  } else if (OB_SUCC(rc) && output_chunk_.column_num() == 0 && !right_chunks().empty()) {
+    output_chunk_.add_columns_like(left_chunk_);
+    output_chunk_.add_columns_like(*right_chunks().front());
+  }
+  return rc;
+}
+
+RC JoinVecPhysicalOperator::append_joined_rows(int left_row, const Chunk &right_chunk, int right_start, int count)
+{
+  RC        rc        = RC::SUCCESS;
+  const int left_cols = left_chunk_.column_num();
+  const int left_idx  = left_chunk_.row_index(left_row);
+  for (int i = 0; i < left_cols && OB_SUCC(rc); i++) {
+    Column &column = output_chunk_.column(i);
+    for (int j = 0; j < count && OB_SUCC(rc); j++) {
+      rc = column.append_rows(left_chunk_.column(i), left_idx, 1);
+    }
+  }
+  for (int i = 0; i < right_chunk.column_num() && OB_SUCC(rc); i++) {
+    rc = output_chunk_.column(left_cols + i).append_rows(right_chunk.column(i), right_start, count);
+  }
+  return rc;
+}
+
+RC NestedLoopJoinVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (right_chunks_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = RC::SUCCESS;
+  output_chunk_.reset_data();
+  while (output_space() > 0) {
+    if (left_row_ >= left_chunk_.selected_rows()) {
+      rc = left_next();
+      if (OB_FAIL(rc)) {
+        break;
+      }
+      left_row_  = 0;
+      right_idx_ = 0;
+      right_row_ = 0;
+      continue;
+    }
+
+    const Chunk &right_chunk = *right_chunks_[right_idx_];
+    const int    count       = std::min(right_chunk.rows() - right_row_, output_space());
+    rc = append_joined_rows(left_row_, right_chunk, right_row_, count);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to append joined rows. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    right_row_ += count;
+    if (right_row_ == right_chunk.rows()) {
+      right_row_ = 0;
+      right_idx_++;
+      if (right_idx_ == static_cast<int>(right_chunks_.size())) {
+        right_idx_ = 0;
+        left_row_++;
+      }
+    }
+  }
+
+  if (rc != RC::SUCCESS && rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to read left child. rc=%s", strrc(rc));
+    return rc;
+  }
+  if (output_chunk_.rows() == 0) {
+    return RC::RECORD_EOF;
+  }
+  return chunk.reference(output_chunk_);
+}
@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 向量化 join 算子的基类
+ * @ingroup PhysicalOperator
+ * @details 右孩子的所有 chunk 在 open 时只把有效的行读取到内存中，左孩子按照 chunk 逐个读取，按照选择向量访问。
+ * 输出的 chunk 中先是左孩子的所有列，后面接着右孩子的所有列。
+ * 并行执行时，工作算子只有左孩子的工作算子一个孩子，右孩子的数据使用创建它的算子在 open 时读取的数据。
+ */
+class JoinVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  virtual ~JoinVecPhysicalOperator() = default;
+
+  RC open(Trx *trx) override;
+  RC close() override;
+
+protected:
+  /**
+   * @brief 读取右孩子的一个 chunk 之后调用，子类可以在这里建立索引
+   * @param chunk_idx chunk 在 right_chunks_ 中的下标
+   */
+  virtual RC on_right_chunk(int chunk_idx) { return RC::SUCCESS; }
+
+  /**
+   * @brief 读取左孩子的下一个 chunk，读完之后一直返回 RECORD_EOF
+   */
+  RC left_next();
+
+  /**
+   * @brief 把左边 chunk 的一行和右边 chunk 中连续的 count 行连接起来，追加到输出的 chunk 中
+   * @param left_row 左边 chunk 中第几个有效的行（考虑选择向量）
+   */
+  RC append_joined_rows(int left_row, const Chunk &right_chunk, int right_start, int count);
+
+  int output_space() const { return Chunk::MAX_ROWS - output_chunk_.rows(); }
+
+  const vector<unique_ptr<Chunk>> &right_chunks() const
+  {
+    return parent_ != nullptr ? parent_->right_chunks_ : right_chunks_;
+  }
+
+protected:
+  Chunk                     left_chunk_;
+  vector<unique_ptr<Chunk>> right_chunks_;
+  Chunk                     output_chunk_;
+  bool                      left_eof_ = false;
+
+  const JoinVecPhysicalOperator *parent_ = nullptr;  ///< 创建工作算子的算子
+};
+
+/**
+ * @brief 嵌套循环 join 算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 没有等值连接条件时使用，输出左右两边的笛卡尔积，连接条件由上层的过滤算子计算
+ */
+class NestedLoopJoinVecPhysicalOperator : public JoinVecPhysicalOperator
+{
+public:
+  NestedLoopJoinVecPhysicalOperator()          = default;
+  virtual ~NestedLoopJoinVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::NESTED_LOOP_JOIN_VEC; }
+
+  RC next(Chunk &chunk) override;
+
+private:
+  int left_row_  = 0;  ///< 当前左边 chunk 中第几个有效的行
+  int right_idx_ = 0;  ///< 当前右边的 chunk
+  int right_row_ = 0;  ///< 当前右边 chunk 中下一次开始连接的行
+};
@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "sql/operator/limit_physical_operator.h"
+#include "common/log/log.h"
+
+string LimitPhysicalOperator::param() const { return std::to_string(limit_); }
+
+RC LimitPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("limit operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  count_ = 0;
+  return children_[0]->open(trx);
+}
+
+RC LimitPhysicalOperator::next()
+{
+  if (count_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = children_[0]->next();
+  if (OB_SUCC(rc)) {
+    count_++;
+  }
+  return rc;
+}
+
+RC LimitPhysicalOperator::close() { return children_[0]->close(); }
+
+string LimitVecPhysicalOperator::param() const { return std::to_string(limit_); }
+
+RC LimitVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("limit operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  count_ = 0;
+  return children_[0]->open(trx);
+}
+
+RC LimitVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (count_ >= limit_) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = children_[0]->next(child_chunk_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = chunk.reference(child_chunk_);
+  chunk.truncate(limit_ - count_);
+  count_ += chunk.selected_rows();
+  return rc;
+}
+
+RC LimitVecPhysicalOperator::close() { return children_[0]->close(); }
@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief LIMIT 物理算子
+ * @ingroup PhysicalOperator
+ */
+class LimitPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit LimitPhysicalOperator(int limit) : limit_(limit) {}
+
+  virtual ~LimitPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT; }
+  OpType               get_op_type() const override { return OpType::LIMIT; }
+
+  string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next() override;
+  RC close() override;
+
+  Tuple *current_tuple() override { return children_[0]->current_tuple(); }
+
+  RC tuple_schema(TupleSchema &schema) const override { return children_[0]->tuple_schema(schema); }
+
+private:
+  int limit_ = 0;
+  int count_ = 0;  ///< 已经输出的行数
+};
+
+/**
+ * @brief LIMIT 物理算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 超过 limit 的 chunk 只截断行数或者选择向量，不拷贝数据
+ */
+class LimitVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  explicit LimitVecPhysicalOperator(int limit) : limit_(limit) {}
+
+  virtual ~LimitVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT_VEC; }
+
+  string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  int   limit_ = 0;
+  int   count_ = 0;  ///< 已经输出的行数
+  Chunk child_chunk_;
+};
@@ -42,6 +42,7 @@ enum class LogicalOperatorType
   GROUP_BY,    ///< 分组
   UPDATE,      ///< 更新
   ORDER_BY,    ///< 排序
+  LIMIT,       ///< 只输出前若干行
 };
 
 /**
@@ -62,6 +62,33 @@ enum class OpType
   SCALARGROUPBY
 };
 
+/**
+ * @brief 连接的类型，逻辑算子和物理算子共用
+ * @details 除了 INNER 都只输出左边的行和列。SEMI 输出在右边有匹配的行，对应 IN 和 EXISTS 子查询；
+ * ANTI 输出在右边没有匹配的行，对应 NOT EXISTS 子查询，连接键是 NULL 的行不会匹配。
+ * NULL_AWARE_ANTI 对应 NOT IN 子查询，按照 NOT IN 的语义处理 NULL：
+ * 右边有 NULL 的连接键时没有输出，左边的连接键是 NULL 时只有右边为空才输出。
+ * 没有连接键时，SEMI 在右边不为空时输出左边所有的行，两种 ANTI 在右边为空时输出左边所有的行。
+ */
+enum class JoinType
+{
+  INNER,
+  SEMI,
+  ANTI,
+  NULL_AWARE_ANTI,
+};
+
+inline const char *join_type_to_string(JoinType type)
+{
+  switch (type) {
+    case JoinType::INNER: return "INNER";
+    case JoinType::SEMI: return "SEMI";
+    case JoinType::ANTI: return "ANTI";
+    case JoinType::NULL_AWARE_ANTI: return "NULL AWARE ANTI";
+  }
+  return "UNKNOWN";
+}
+
 // TODO: OperatorNode is the abstrace class of logical/physical operator
 // in cascade there is EXPR to include OperatorNode and OperatorNode children
 // so here remove genral_children.
@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "sql/operator/order_by_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+RC OrderByVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("order by operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  RC rc = children_[0]->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open child operator: %s", strrc(rc));
+    return rc;
+  }
+
+  chunks_.clear();
+  rows_.clear();
+  next_row_ = 0;
+  output_chunk_.reset();
+
+  Chunk child_chunk;
+  while (OB_SUCC(rc = children_[0]->next(child_chunk))) {
+    if (child_chunk.selected_rows() == 0) {
+      continue;
+    }
+    const int chunk_idx = static_cast<int>(chunks_.size());
+    auto      chunk     = make_unique<Chunk>();
+    rc                  = child_chunk.materialize(*chunk);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    for (int row = 0; row < chunk->rows(); row++) {
+      rows_.push_back(RowRef{chunk_idx, row});
+    }
+    chunks_.emplace_back(std::move(chunk));
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to fetch child chunk. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 排序列的值只取一次，避免比较时反复构造 Value
+  const size_t  key_num = keys_.size();
+  vector<Value> key_values(rows_.size() * key_num);
+  for (size_t i = 0; i < rows_.size(); i++) {
+    const Chunk &chunk = *chunks_[rows_[i].chunk_idx];
+    for (size_t k = 0; k < key_num; k++) {
+      key_values[i * key_num + k] = chunk.get_value(keys_[k].pos, rows_[i].row);
+    }
+  }
+
+  vector<int> order(rows_.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = static_cast<int>(i);
+  }
+  stable_sort(order.begin(), order.end(), [&](int left, int right) {
+    for (size_t k = 0; k < key_num; k++) {
+      int res = key_values[left * key_num + k].compare(key_values[right * key_num + k]);
+      if (res != 0) {
+        return keys_[k].asc ? res < 0 : res > 0;
+      }
+    }
+    return false;
+  });
+
+  vector<RowRef> sorted_rows;
+  sorted_rows.reserve(rows_.size());
+  for (int i : order) {
+    sorted_rows.push_back(rows_[i]);
+  }
+  rows_.swap(sorted_rows);
+  return RC::SUCCESS;
+}
+
+RC OrderByVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (next_row_ >= rows_.size()) {
+    return RC::RECORD_EOF;
+  }
+
+  if (output_chunk_.column_num() == 0) {
+    output_chunk_.add_columns_like(*chunks_.front());
+  }
+  output_chunk_.reset_data();
+
+  RC rc = RC::SUCCESS;
+  for (int i = 0; i < Chunk::MAX_ROWS && next_row_ < rows_.size(); i++, next_row_++) {
+    const RowRef &ref   = rows_[next_row_];
+    Chunk        &input = *chunks_[ref.chunk_idx];
+    for (int col = 0; col < input.column_num(); col++) {
+      rc = output_chunk_.column(col).append_rows(input.column(col), ref.row, 1);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to copy sorted row. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+  }
+  return chunk.reference(output_chunk_);
+}
+
+RC OrderByVecPhysicalOperator::close()
+{
+  chunks_.clear();
+  rows_.clear();
+  children_[0]->close();
+  return RC::SUCCESS;
+}
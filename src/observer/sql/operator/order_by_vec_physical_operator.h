@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 排序物理算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details open 时读取下层算子所有 chunk 中有效的行，只对行号排序，输出时再按照排好的顺序把行拷贝到输出的 chunk 中。
+ */
+class OrderByVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @brief 排序列
+   */
+  struct OrderKey
+  {
+    int  pos = -1;    ///< 排序列在下层算子返回的 chunk 中的位置
+    bool asc = true;  ///< 是否升序
+  };
+
+public:
+  OrderByVecPhysicalOperator(vector<OrderKey> &&keys) : keys_(std::move(keys)) {}
+
+  virtual ~OrderByVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::ORDER_BY_VEC; }
+  OpType               get_op_type() const override { return OpType::ORDERBY; }
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  struct RowRef
+  {
+    int chunk_idx;
+    int row;
+  };
+
+private:
+  vector<OrderKey>          keys_;
+  vector<unique_ptr<Chunk>> chunks_;      ///< 下层算子返回的所有数据
+  vector<RowRef>            rows_;        ///< 排好序的行
+  size_t                    next_row_ = 0;
+  Chunk                     output_chunk_;
+};
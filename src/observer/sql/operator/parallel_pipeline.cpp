@@ -0,0 +1,100 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/parallel_pipeline.h"
+#include "common/log/log.h"
+
+using namespace std;
+using namespace common;
+
+ParallelPipeline::~ParallelPipeline()
+{
+  if (group_ != nullptr) {
+    cancel();
+    wait();
+  }
+}
+
+RC ParallelPipeline::init(PhysicalOperator &root, int parallel_degree)
+{
+  ASSERT(group_ == nullptr, "parallel pipeline is running");
+  workers_.clear();
+  cancelled_.store(false, std::memory_order_relaxed);
+
+  if (parallel_degree <= 1 || !root.parallel_safe()) {
+    return RC::UNSUPPORTED;
+  }
+
+  RC rc = root.create_workers(parallel_degree, workers_);
+  if (OB_FAIL(rc)) {
+    LOG_INFO("failed to create parallel workers. rc=%s", strrc(rc));
+    workers_.clear();
+  }
+  return rc;
+}
+
+void ParallelPipeline::start(Trx *trx, Sink sink, function<void(int)> on_finish)
+{
+  ASSERT(group_ == nullptr, "parallel pipeline is running");
+  group_ = TaskScheduler::instance().submit(
+      parallel_degree(), [this, trx, sink = std::move(sink), on_finish = std::move(on_finish)](int worker_id) {
+        RC rc = run_worker(worker_id, trx, sink);
+        if (on_finish) {
+          on_finish(worker_id);
+        }
+        return rc;
+      });
+}
+
+RC ParallelPipeline::wait()
+{
+  if (group_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  RC rc  = TaskScheduler::instance().wait(*group_);
+  group_ = nullptr;
+  return rc;
+}
+
+RC ParallelPipeline::run(Trx *trx, Sink sink)
+{
+  start(trx, std::move(sink));
+  return wait();
+}
+
+RC ParallelPipeline::run_worker(int worker_id, Trx *trx, const Sink &sink)
+{
+  PhysicalOperator &worker = *workers_[worker_id];
+
+  RC rc = worker.open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open parallel worker. rc=%s", strrc(rc));
+    cancel();
+    return rc;
+  }
+
+  Chunk chunk;
+  while (!cancelled_.load(std::memory_order_relaxed) && OB_SUCC(rc = worker.next(chunk))) {
+    rc = sink(worker_id, chunk);
+    if (OB_FAIL(rc)) {
+      break;
+    }
+  }
+  worker.close();
+
+  if (rc == RC::RECORD_EOF) {
+    return RC::SUCCESS;
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("parallel worker failed. rc=%s", strrc(rc));
+    cancel();
+  }
+  return rc;
+}
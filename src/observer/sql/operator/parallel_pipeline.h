@@ -0,0 +1,74 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/functional.h"
+#include "common/thread/task_scheduler.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 并行执行的流水线
+ * @ingroup PhysicalOperator
+ * @details 流水线的根算子在当前线程中 open 之后，通过 PhysicalOperator::create_workers 创建工作算子，
+ * 每个工作算子是 TaskScheduler 中的一个任务，读取的每个 chunk 交给 sink 处理。sink 是流水线的终点，
+ * 比如聚合算子的预聚合，或者 Gather 算子的队列。
+ * 表扫描的工作算子按照页面范围（morsel）领取数据，执行快的工作算子会处理更多的数据。
+ */
+class ParallelPipeline
+{
+public:
+  /// 参数是工作算子的编号和它输出的 chunk。同一个编号的调用在同一个线程中依次执行
+  using Sink = function<RC(int, Chunk &)>;
+
+  ParallelPipeline() = default;
+  ~ParallelPipeline();
+
+  /**
+   * @brief 为已经 open 的 root 创建 parallel_degree 个工作算子
+   * @return root 下面的算子不能并行执行时返回 UNSUPPORTED
+   */
+  RC init(PhysicalOperator &root, int parallel_degree);
+
+  int parallel_degree() const { return static_cast<int>(workers_.size()); }
+
+  /**
+   * @brief 开始执行，不等待结束
+   * @param on_finish 工作算子结束时在它的线程中调用，参数是工作算子的编号
+   */
+  void start(Trx *trx, Sink sink, function<void(int)> on_finish = nullptr);
+
+  /**
+   * @brief 在当前线程中执行一个还没有开始的工作算子，执行完才返回
+   * @return 没有在执行或者所有工作算子都已经开始时返回 false
+   */
+  bool run_one() { return group_ != nullptr && group_->run_one(); }
+
+  /// 通知工作算子不再读取新的 chunk，需要再调用 wait 等待结束
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+
+  /**
+   * @brief 等待所有工作算子结束，当前线程也会执行还没有开始的工作算子
+   * @return 某个工作算子或者 sink 失败时返回编号最小的失败的错误码。没有在执行时返回 SUCCESS
+   */
+  RC wait();
+
+  /// 执行并等待结束
+  RC run(Trx *trx, Sink sink);
+
+private:
+  RC run_worker(int worker_id, Trx *trx, const Sink &sink);
+
+private:
+  vector<unique_ptr<PhysicalOperator>> workers_;
+  shared_ptr<common::TaskGroup>        group_;
+  atomic_bool                          cancelled_{false};  ///< 取消或者某个工作算子失败后，其它工作算子尽快结束
+};
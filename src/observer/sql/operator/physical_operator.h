@@ -38,7 +38,10 @@ enum class PhysicalOperatorType
   TABLE_SCAN_VEC,
   INDEX_SCAN,
   NESTED_LOOP_JOIN,
+  NESTED_LOOP_JOIN_VEC,
   HASH_JOIN,
+  HASH_JOIN_VEC,
+  HASH_SEMI_JOIN,
   EXPLAIN,
   PREDICATE,
   PREDICATE_VEC,
@@ -55,6 +58,10 @@ enum class PhysicalOperatorType
   EXPR_VEC,
   UPDATE,
   ORDER_BY,
+  ORDER_BY_VEC,
+  LIMIT,
+  LIMIT_VEC,
+  GATHER_VEC,
 };
 
 /**
@@ -88,6 +95,23 @@ public:
 
   virtual RC tuple_schema(TupleSchema &schema) const { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 当前算子和它下层的算子是否可以作为一条流水线并行执行
+   * @details 并行的流水线从向量化的表扫描开始，经过过滤、表达式计算、哈希连接的探测等逐个处理 chunk 的算子，
+   * 在需要读取全部数据的算子（聚合、排序、哈希表的构建）处断开。参考 `Morsel-Driven Parallelism`
+   */
+  virtual bool parallel_safe() const { return false; }
+
+  /**
+   * @brief 创建 parallel_degree 个工作算子，每个工作算子执行流水线的一部分数据
+   * @details 调用之前当前算子已经 open，比如哈希连接已经建好哈希表。工作算子共享当前算子的只读状态
+   * （表达式、哈希表等），在各自的线程中 open/next/close。所有工作算子关闭之后才能关闭当前算子
+   */
+  virtual RC create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers)
+  {
+    return RC::UNSUPPORTED;
+  }
+
   void add_child(unique_ptr<PhysicalOperator> oper) { children_.emplace_back(std::move(oper)); }
 
   vector<unique_ptr<PhysicalOperator>> &children() { return children_; }
@@ -13,8 +13,23 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/predicate_logical_operator.h"
+#include "sql/optimizer/cascade/property.h"
+#include "sql/optimizer/statistics/selectivity.h"
 
 PredicateLogicalOperator::PredicateLogicalOperator(unique_ptr<Expression> expression)
 {
   expressions_.emplace_back(std::move(expression));
 }
+
+unique_ptr<LogicalProperty> PredicateLogicalOperator::find_log_prop(const vector<LogicalProperty *> &log_props)
+{
+  if (log_props.size() != 1 || log_props[0] == nullptr) {
+    return nullptr;
+  }
+  // 转换成物理算子之后表达式会被取走
+  double card = log_props[0]->get_card();
+  if (!expressions_.empty() && expressions_.front() != nullptr) {
+    card *= Selectivity::estimate(*expressions_.front());
+  }
+  return make_unique<LogicalProperty>(LogicalProperty::to_card(card));
+}
@@ -30,4 +30,7 @@ public:
   LogicalOperatorType type() const override { return LogicalOperatorType::PREDICATE; }
 
   OpType get_op_type() const override { return OpType::LOGICALFILTER; }
+
+  /// 按照过滤条件的选择率估计输出的行数
+  unique_ptr<LogicalProperty> find_log_prop(const vector<LogicalProperty *> &log_props) override;
 };
@@ -33,6 +33,16 @@ public:
   PhysicalOperatorType type() const override { return PhysicalOperatorType::PREDICATE; }
   OpType               get_op_type() const override { return OpType::FILTER; }
 
+  /// 每一行输入都要计算一次过滤条件
+  double calculate_cost(LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override
+  {
+    double card = 0;
+    for (LogicalProperty *child_log_prop : child_log_props) {
+      card += child_log_prop != nullptr ? child_log_prop->get_card() : 0;
+    }
+    return cm->cpu_op() * card;
+  }
+
   RC open(Trx *trx) override;
   RC next() override;
   RC close() override;
@@ -0,0 +1,82 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "sql/operator/predicate_vec_physical_operator.h"
+#include "common/log/log.h"
+
+PredicateVecPhysicalOperator::PredicateVecPhysicalOperator(unique_ptr<Expression> expr) : expression_(std::move(expr))
+{
+  ASSERT(expression_->value_type() == AttrType::BOOLEANS, "predicate's expression should be BOOLEAN type");
+}
+
+RC PredicateVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("predicate operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  // 工作算子的过滤条件在 parent 打开时已经初始化
+  if (parent_ == nullptr) {
+    RC rc = expression_->init(trx);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
+  return children_[0]->open(trx);
+}
+
+RC PredicateVecPhysicalOperator::next(Chunk &chunk)
+{
+  RC                rc    = RC::SUCCESS;
+  PhysicalOperator &child = *children_[0];
+
+  while (OB_SUCC(rc = child.next(chunk))) {
+    if (chunk.selected_rows() == 0) {
+      continue;
+    }
+
+    // 表达式在所有的行上计算，结果与原来的选择向量合并
+    chunk.init_select(select_);
+    rc = expression().eval(chunk, select_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval predicate. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    chunk.set_selection(select_);
+    if (chunk.selected_rows() > 0) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC PredicateVecPhysicalOperator::create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers)
+{
+  vector<unique_ptr<PhysicalOperator>> child_workers;
+  RC                                   rc = children_[0]->create_workers(parallel_degree, child_workers);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  for (unique_ptr<PhysicalOperator> &child_worker : child_workers) {
+    unique_ptr<PhysicalOperator> worker(new PredicateVecPhysicalOperator(this));
+    worker->add_child(std::move(child_worker));
+    workers.emplace_back(std::move(worker));
+  }
+  return rc;
+}
+
+RC PredicateVecPhysicalOperator::close()
+{
+  children_[0]->close();
+  return RC::SUCCESS;
+}
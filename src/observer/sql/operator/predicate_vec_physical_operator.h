@@ -0,0 +1,47 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#pragma once
+
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 过滤/谓词物理算子(Vectorized)
+ * @ingroup PhysicalOperator
+ * @details 用 `Expression::eval` 计算下层 chunk 的过滤结果，只修改 chunk 的选择向量，不拷贝列数据。
+ * 全部没有选中时继续读取下一个 chunk。
+ */
+class PredicateVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  PredicateVecPhysicalOperator(unique_ptr<Expression> expr);
+
+  virtual ~PredicateVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::PREDICATE_VEC; }
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+  bool parallel_safe() const override { return children_[0]->parallel_safe(); }
+  RC   create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers) override;
+
+private:
+  /// 并行执行的工作算子，使用 parent 的过滤条件
+  explicit PredicateVecPhysicalOperator(PredicateVecPhysicalOperator *parent) : parent_(parent) {}
+
+  Expression &expression() { return parent_ != nullptr ? *parent_->expression_ : *expression_; }
+
+private:
+  unique_ptr<Expression>        expression_;
+  vector<uint8_t>               select_;
+  PredicateVecPhysicalOperator *parent_ = nullptr;
+};
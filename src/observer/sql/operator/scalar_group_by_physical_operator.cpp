@@ -82,11 +82,19 @@ RC ScalarGroupByPhysicalOperator::open(Trx *trx)
     return rc;
   }
 
-  // 得到最终聚合后的值
-  if (group_value_) {
-    rc = evaluate(*group_value_);
+  // 没有输入时也输出一行，COUNT 是 0，其它的聚合是 NULL
+  if (group_value_ == nullptr) {
+    AggregatorList aggregator_list;
+    create_aggregator_list(aggregator_list);
+
+    CompositeTuple composite_tuple;
+    composite_tuple.add_tuple(make_unique<ValueListTuple>());
+    group_value_ = make_unique<GroupValueType>(std::move(aggregator_list), std::move(composite_tuple));
   }
 
+  // 得到最终聚合后的值
+  rc = evaluate(*group_value_);
+
   emitted_ = false;
   return rc;
 }
@@ -14,7 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_get_logical_operator.h"
 #include "sql/optimizer/cascade/property.h"
-#include "catalog/catalog.h"
+#include "sql/optimizer/statistics/selectivity.h"
 
 TableGetLogicalOperator::TableGetLogicalOperator(Table *table, ReadWriteMode mode)
     : LogicalOperator(), table_(table), mode_(mode)
@@ -27,7 +27,9 @@ void TableGetLogicalOperator::set_predicates(vector<unique_ptr<Expression>> &&ex
 
 unique_ptr<LogicalProperty> TableGetLogicalOperator::find_log_prop(const vector<LogicalProperty*> &log_props)
 {
-  int card = Catalog::get_instance().get_table_stats(table_->table_id()).row_nums;
-  // TODO: think about predicates.
-  return make_unique<LogicalProperty>(card);
-}
\ No newline at end of file
+  double card = Selectivity::table_rows(table_);
+  for (unique_ptr<Expression> &predicate : predicates_) {
+    card *= Selectivity::estimate(*predicate);
+  }
+  return make_unique<LogicalProperty>(LogicalProperty::to_card(card));
+}
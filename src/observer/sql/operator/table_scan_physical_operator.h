@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/sys/rc.h"
 #include "sql/operator/physical_operator.h"
+#include "sql/optimizer/statistics/selectivity.h"
 #include "storage/record/record_manager.h"
 #include "storage/record/record_scanner.h"
 #include "common/types.h"
@@ -54,9 +55,10 @@ public:
     return true;
   }
 
+  /// 无论过滤条件的选择率是多少，都要读取全表的数据
   double calculate_cost(LogicalProperty *prop, const vector<LogicalProperty *> &child_log_props, CostModel *cm) override
   {
-    return (cm->io() + cm->cpu_op()) * prop->get_card();
+    return (cm->io() + cm->cpu_op()) * max(Selectivity::table_rows(table_), static_cast<double>(prop->get_card()));
   }
 
   RC open(Trx *trx) override;
@@ -16,17 +16,20 @@ using namespace std;
 
 RC TableScanVecPhysicalOperator::open(Trx *trx)
 {
-  RC rc = table_->get_chunk_scanner(chunk_scanner_, trx, mode_);
+  RC rc = table_->get_chunk_scanner(chunk_scanner_, trx, mode_, morsels_.get());
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
   // TODO: don't need to fetch all columns from record manager
+  all_columns_.reset();
+  nullable_columns_.clear();
   for (int i = 0; i < table_->table_meta().field_num(); ++i) {
-    all_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
+    const FieldMeta *field = table_->table_meta().field(i);
+    all_columns_.add_column(make_unique<Column>(*field), i);
+    if (field->nullable()) {
+      nullable_columns_.push_back(i);
+    }
   }
   return rc;
 }
@@ -36,29 +39,21 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
   RC rc = RC::SUCCESS;
 
   all_columns_.reset_data();
-  filterd_columns_.reset_data();
   if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
-    select_.assign(all_columns_.rows(), 1);
-    if (predicates_.empty()) {
-      chunk.reference(all_columns_);
-    } else {
+    for (int col : nullable_columns_) {
+      all_columns_.column(col).detect_nulls();
+    }
+
+    if (!predicates().empty()) {
+      select_.assign(all_columns_.rows(), 1);
       rc = filter(all_columns_);
       if (rc != RC::SUCCESS) {
         LOG_TRACE("filtered failed=%s", strrc(rc));
         return rc;
       }
-      // TODO: if all setted, it doesn't need to set one by one
-      for (int i = 0; i < all_columns_.rows(); i++) {
-        if (select_[i] == 0) {
-          continue;
-        }
-        for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_value(
-              all_columns_.column(filterd_columns_.column_ids(j)).get_value(i));
-        }
-      }
-      chunk.reference(filterd_columns_);
+      all_columns_.set_selection(select_);
     }
+    chunk.reference(all_columns_);
   }
   return rc;
 }
@@ -72,10 +67,26 @@ void TableScanVecPhysicalOperator::set_predicates(vector<unique_ptr<Expression>>
   predicates_ = std::move(exprs);
 }
 
+RC TableScanVecPhysicalOperator::create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers)
+{
+  if (!parallel_safe()) {
+    return RC::UNSUPPORTED;
+  }
+
+  auto morsels = make_shared<PageMorselSource>();
+  for (int i = 0; i < parallel_degree; i++) {
+    auto worker      = make_unique<TableScanVecPhysicalOperator>(table_, mode_);
+    worker->morsels_ = morsels;
+    worker->parent_  = this;
+    workers.emplace_back(std::move(worker));
+  }
+  return RC::SUCCESS;
+}
+
 RC TableScanVecPhysicalOperator::filter(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
-  for (unique_ptr<Expression> &expr : predicates_) {
+  for (const unique_ptr<Expression> &expr : predicates()) {
     rc = expr->eval(chunk, select_);
     if (rc != RC::SUCCESS) {
       return rc;
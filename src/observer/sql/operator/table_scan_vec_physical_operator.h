@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/memory.h"
 #include "common/sys/rc.h"
 #include "sql/operator/physical_operator.h"
 #include "storage/record/record_manager.h"
@@ -20,6 +21,7 @@ class Table;
 /**
  * @brief 表扫描物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details 过滤条件只生成选择向量，不拷贝列数据
  */
 class TableScanVecPhysicalOperator : public PhysicalOperator
 {
@@ -38,15 +40,32 @@ public:
 
   void set_predicates(vector<unique_ptr<Expression>> &&exprs);
 
+  /// 只读的扫描可以并行执行，工作算子从同一个 PageMorselSource 中领取页面范围
+  bool parallel_safe() const override { return mode_ == ReadWriteMode::READ_ONLY; }
+
+  /**
+   * @brief 创建并行扫描的工作算子
+   * @details 工作算子共享当前算子的过滤条件，向量化的表达式计算不修改表达式，可以在多个线程中同时执行
+   */
+  RC create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers) override;
+
 private:
   RC filter(Chunk &chunk);
 
+  const vector<unique_ptr<Expression>> &predicates() const
+  {
+    return parent_ != nullptr ? parent_->predicates_ : predicates_;
+  }
+
 private:
   Table                         *table_ = nullptr;
   ReadWriteMode                  mode_  = ReadWriteMode::READ_WRITE;
   ChunkFileScanner               chunk_scanner_;
   Chunk                          all_columns_;
-  Chunk                          filterd_columns_;
+  vector<int>                    nullable_columns_;  ///< 可以为 NULL 的列，需要生成有效性位图
   vector<uint8_t>                select_;
   vector<unique_ptr<Expression>> predicates_;
+
+  shared_ptr<PageMorselSource>        morsels_;           ///< 并行扫描的工作算子从这里领取页面范围
+  const TableScanVecPhysicalOperator *parent_ = nullptr;  ///< 创建工作算子的算子，过滤条件使用它的
 };
@@ -10,6 +10,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/limits.h"
+
 class Property
 {};
 
@@ -25,6 +27,18 @@ public:
 
   int get_card() const { return card_; }
 
+  /// 把估计的行数转换成整数，有数据时至少为 1，避免后续的估计都变成 0
+  static int to_card(double card)
+  {
+    if (!(card > 0)) {
+      return 0;
+    }
+    if (card >= static_cast<double>(numeric_limits<int>::max())) {
+      return numeric_limits<int>::max();
+    }
+    return card < 1 ? 1 : static_cast<int>(card + 0.5);
+  }
+
 private:
   int card_ = 0;  /// cardinality
 };
\ No newline at end of file
@@ -21,6 +21,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_logical_operator.h"
 #include "sql/operator/insert_logical_operator.h"
 #include "sql/operator/join_logical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
 #include "sql/operator/logical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/project_logical_operator.h"
@@ -157,6 +158,17 @@ RC LogicalPlanGenerator::create_plan(SelectStmt *select_stmt, unique_ptr<Logical
     last_oper = &group_by_oper;
   }
 
+  unique_ptr<LogicalOperator> limit_oper(
+      select_stmt->limit() >= 0 ? new LimitLogicalOperator(select_stmt->limit()) : nullptr);
+
+  if (limit_oper) {
+    if (*last_oper) {
+      limit_oper->add_child(std::move(*last_oper));
+    }
+
+    last_oper = &limit_oper;
+  }
+
   unique_ptr<LogicalOperator> project_oper = make_unique<ProjectLogicalOperator>(std::move(select_stmt->query_expressions()));
   if (*last_oper) {
     project_oper->add_child(std::move(*last_oper));
@@ -208,10 +220,12 @@ RC LogicalPlanGenerator::create_plan(FilterStmt *filter_stmt, unique_ptr<Logical
        rc = create_plan(filter_obj_left.sub_query, sub_plan);
        if (rc != RC::SUCCESS) return rc;
        left = make_unique<SubQueryExpr>(std::move(sub_plan));
+    } else if (!filter_obj_left.is_attr) {
+       left = make_unique<ValueExpr>(filter_obj_left.value);
+    } else if (filter_obj_left.is_outer) {
+       left = make_unique<CorrelatedFieldExpr>(filter_obj_left.field);
     } else {
-       left.reset(filter_obj_left.is_attr
-                                    ? static_cast<Expression *>(new FieldExpr(filter_obj_left.field))
-                                    : static_cast<Expression *>(new ValueExpr(filter_obj_left.value)));
+       left = make_unique<FieldExpr>(filter_obj_left.field);
     }
 
     unique_ptr<Expression> right;
@@ -220,17 +234,22 @@ RC LogicalPlanGenerator::create_plan(FilterStmt *filter_stmt, unique_ptr<Logical
        rc = create_plan(filter_obj_right.sub_query, sub_plan);
        if (rc != RC::SUCCESS) return rc;
        right = make_unique<SubQueryExpr>(std::move(sub_plan));
+    } else if (!filter_obj_right.is_attr) {
+       right = make_unique<ValueExpr>(filter_obj_right.value);
+    } else if (filter_obj_right.is_outer) {
+       right = make_unique<CorrelatedFieldExpr>(filter_obj_right.field);
     } else {
-       right.reset(filter_obj_right.is_attr
-                                     ? static_cast<Expression *>(new FieldExpr(filter_obj_right.field))
-                                     : static_cast<Expression *>(new ValueExpr(filter_obj_right.value)));
+       right = make_unique<FieldExpr>(filter_obj_right.field);
     }
     bool null_exist = left->is_null() || right->is_null();
     // 对于 IS / IS NOT NULL 或任一端为 NULL，不做类型强转，直接用 NULL 判定
     if (!null_exist && left->value_type() != right->value_type()) {
       auto left_to_right_cost = implicit_cast_cost(left->value_type(), right->value_type());
       auto right_to_left_cost = implicit_cast_cost(right->value_type(), left->value_type());
-      if (left_to_right_cost <= right_to_left_cost && left_to_right_cost != INT32_MAX) {
+      // IN 子查询按照集合查找，只转换另一边的类型
+      const bool is_in          = filter_unit->comp() == CompOp_IN || filter_unit->comp() == CompOp_NOT_IN;
+      const bool right_castable = !(is_in && right->type() == ExprType::SUB_QUERY);
+      if (left_to_right_cost != INT32_MAX && (left_to_right_cost <= right_to_left_cost || !right_castable)) {
         ExprType left_type = left->type();
         auto cast_expr = make_unique<CastExpr>(std::move(left), right->value_type());
         if (left_type == ExprType::VALUE) {
@@ -244,7 +263,7 @@ RC LogicalPlanGenerator::create_plan(FilterStmt *filter_stmt, unique_ptr<Logical
         } else {
           left = std::move(cast_expr);
         }
-      } else if (right_to_left_cost < left_to_right_cost && right_to_left_cost != INT32_MAX) {
+      } else if (right_castable && right_to_left_cost < left_to_right_cost && right_to_left_cost != INT32_MAX) {
         ExprType right_type = right->type();
         auto cast_expr = make_unique<CastExpr>(std::move(right), left->value_type());
         if (right_type == ExprType::VALUE) {
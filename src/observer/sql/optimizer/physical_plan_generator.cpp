@@ -12,8 +12,12 @@ See the Mulan PSL v2 for more details. */
 // Created by Wangyunlai on 2022/12/14.
 //
 
+#include "common/lang/unordered_set.h"
 #include "common/log/log.h"
+#include "sql/expr/aggregate_state.h"
+#include "sql/expr/column_kernels.h"
 #include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
 #include "session/session.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
 #include "sql/operator/calc_logical_operator.h"
@@ -23,15 +27,22 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_logical_operator.h"
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/expr_vec_physical_operator.h"
+#include "sql/operator/gather_vec_physical_operator.h"
 #include "sql/operator/group_by_vec_physical_operator.h"
 #include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "sql/operator/hash_semi_join_physical_operator.h"
 #include "sql/operator/index_scan_physical_operator.h"
 #include "sql/operator/insert_logical_operator.h"
 #include "sql/operator/insert_physical_operator.h"
 #include "sql/operator/join_logical_operator.h"
+#include "sql/operator/join_vec_physical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
+#include "sql/operator/limit_physical_operator.h"
 #include "sql/operator/nested_loop_join_physical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/predicate_physical_operator.h"
+#include "sql/operator/predicate_vec_physical_operator.h"
 #include "sql/operator/project_logical_operator.h"
 #include "sql/operator/project_physical_operator.h"
 #include "sql/operator/project_vec_physical_operator.h"
@@ -47,6 +58,9 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/update_physical_operator.h"
 #include "sql/operator/order_by_logical_operator.h"
 #include "sql/operator/order_by_physical_operator.h"
+#include "sql/operator/order_by_vec_physical_operator.h"
+#include "storage/index/index.h"
+#include "storage/table/table.h"
 
 using namespace std;
 
@@ -99,6 +113,10 @@ RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<P
       return create_plan(static_cast<OrderByLogicalOperator &>(logical_operator), oper,session);
     } break;
 
+    case LogicalOperatorType::LIMIT: {
+      return create_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper, session);
+    } break;
+
     default: {
       ASSERT(false, "unknown logical operator type");
       return RC::INVALID_ARGUMENT;
@@ -124,6 +142,18 @@ RC PhysicalPlanGenerator::create_vec(LogicalOperator &logical_operator, unique_p
     case LogicalOperatorType::EXPLAIN: {
       return create_vec_plan(static_cast<ExplainLogicalOperator &>(logical_operator), oper, session);
     } break;
+    case LogicalOperatorType::PREDICATE: {
+      return create_vec_plan(static_cast<PredicateLogicalOperator &>(logical_operator), oper, session);
+    } break;
+    case LogicalOperatorType::JOIN: {
+      return create_vec_plan(static_cast<JoinLogicalOperator &>(logical_operator), oper, session);
+    } break;
+    case LogicalOperatorType::ORDER_BY: {
+      return create_vec_plan(static_cast<OrderByLogicalOperator &>(logical_operator), oper, session);
+    } break;
+    case LogicalOperatorType::LIMIT: {
+      return create_vec_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper, session);
+    } break;
     default: {
       LOG_WARN("unknown logical operator type: %d", logical_operator.type());
       return RC::INVALID_ARGUMENT;
@@ -132,67 +162,202 @@ RC PhysicalPlanGenerator::create_vec(LogicalOperator &logical_operator, unique_p
   return rc;
 }
 
-RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper, Session* session)
+/**
+ * @brief 可以用于索引扫描的条件，形如 field op value
+ */
+struct IndexCondition
 {
-  vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
-  // 看看是否有可以用于索引查找的表达式
-  Table *table = table_get_oper.table();
+  const FieldMeta *field = nullptr;
+  CompOp           comp  = NO_OP;
+  Value            value;  ///< 已经转换成字段的类型
+};
+
+/**
+ * @brief 索引扫描的范围
+ * @details 前面若干个字段是等值条件，最后一个字段可以是范围条件
+ */
+struct IndexScanRange
+{
+  Index        *index = nullptr;
+  vector<Value> left_values;
+  vector<Value> right_values;
+  bool          left_inclusive  = true;
+  bool          right_inclusive = true;
+  int           score           = 0;  ///< 等值字段数*2 + 是否有范围条件，越大越好
+};
+
+static CompOp reverse_comp(CompOp comp)
+{
+  switch (comp) {
+    case LESS_THAN: return GREAT_THAN;
+    case LESS_EQUAL: return GREAT_EQUAL;
+    case GREAT_THAN: return LESS_THAN;
+    case GREAT_EQUAL: return LESS_EQUAL;
+    default: return comp;
+  }
+}
 
-  Index     *index      = nullptr;
-  ValueExpr *value_expr = nullptr;
-  for (auto &expr : predicates) {
-    if (expr->type() == ExprType::COMPARISON) {
-      auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
-      // 简单处理，就找等值查询
-      if (comparison_expr->comp() != EQUAL_TO && comparison_expr->comp() != NOT_EQUAL) {
-        continue;
-      }
+/**
+ * @brief 从谓词中找出 field op value 形式的条件
+ * @details 值需要可以无损地转换成字段的类型，否则按照字段类型构造的索引键值会改变比较的结果
+ */
+static void collect_index_conditions(
+    const Table *table, const vector<unique_ptr<Expression>> &predicates, vector<IndexCondition> &conditions)
+{
+  for (const unique_ptr<Expression> &expr : predicates) {
+    if (expr->type() != ExprType::COMPARISON) {
+      continue;
+    }
+
+    auto   comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+    CompOp comp            = comparison_expr->comp();
+    if (comp != EQUAL_TO && comp != LESS_THAN && comp != LESS_EQUAL && comp != GREAT_THAN && comp != GREAT_EQUAL) {
+      continue;
+    }
+
+    unique_ptr<Expression> &left_expr  = comparison_expr->left();
+    unique_ptr<Expression> &right_expr = comparison_expr->right();
+
+    FieldExpr *field_expr = nullptr;
+    ValueExpr *value_expr = nullptr;
+    if (left_expr->type() == ExprType::FIELD && right_expr->type() == ExprType::VALUE) {
+      field_expr = static_cast<FieldExpr *>(left_expr.get());
+      value_expr = static_cast<ValueExpr *>(right_expr.get());
+    } else if (left_expr->type() == ExprType::VALUE && right_expr->type() == ExprType::FIELD) {
+      field_expr = static_cast<FieldExpr *>(right_expr.get());
+      value_expr = static_cast<ValueExpr *>(left_expr.get());
+      comp       = reverse_comp(comp);
+    } else {
+      continue;
+    }
 
-      unique_ptr<Expression> &left_expr  = comparison_expr->left();
-      unique_ptr<Expression> &right_expr = comparison_expr->right();
-      // 左右比较的一边最少是一个值
-      if (left_expr->type() != ExprType::VALUE && right_expr->type() != ExprType::VALUE) {
+    const Field &field = field_expr->field();
+    const Value &value = value_expr->get_value();
+    if (field.table() != table || value.is_null()) {
+      continue;
+    }
+
+    IndexCondition condition;
+    condition.field = field.meta();
+    condition.comp  = comp;
+    if (value.attr_type() == condition.field->type()) {
+      condition.value = value;
+    } else if (OB_FAIL(Value::cast_to(value, condition.field->type(), condition.value)) ||
+               condition.value.compare(value) != 0) {
+      continue;
+    }
+
+    // 超过字段长度的字符串无法放到索引键值中
+    if (condition.value.attr_type() == AttrType::CHARS &&
+        static_cast<int>(condition.value.to_string().size()) > condition.field->len()) {
+      continue;
+    }
+    conditions.push_back(std::move(condition));
+  }
+}
+
+/**
+ * @brief 计算一个索引可以使用的扫描范围
+ * @details 按照索引字段的顺序，尽量多地使用等值条件，然后在下一个字段上使用范围条件
+ * @return 索引不能使用时返回false
+ */
+static bool make_index_scan_range(const vector<IndexCondition> &conditions, IndexScanRange &range)
+{
+  for (const FieldMeta &field_meta : range.index->field_metas()) {
+    const IndexCondition *equal = nullptr;
+    const IndexCondition *lower = nullptr;
+    const IndexCondition *upper = nullptr;
+    for (const IndexCondition &condition : conditions) {
+      if (0 != strcmp(condition.field->name(), field_meta.name())) {
         continue;
       }
 
-      FieldExpr *field_expr = nullptr;
-      if (left_expr->type() == ExprType::FIELD) {
-        ASSERT(right_expr->type() == ExprType::VALUE, "right expr should be a value expr while left is field expr");
-        field_expr = static_cast<FieldExpr *>(left_expr.get());
-        value_expr = static_cast<ValueExpr *>(right_expr.get());
-      } else if (right_expr->type() == ExprType::FIELD) {
-        ASSERT(left_expr->type() == ExprType::VALUE, "left expr should be a value expr while right is a field expr");
-        field_expr = static_cast<FieldExpr *>(right_expr.get());
-        value_expr = static_cast<ValueExpr *>(left_expr.get());
+      if (condition.comp == EQUAL_TO) {
+        equal = &condition;
+        break;
       }
 
-      if (field_expr == nullptr) {
-        continue;
+      if (condition.comp == GREAT_THAN || condition.comp == GREAT_EQUAL) {
+        // 多个下界时取最大的，相同时不包含边界的更严格
+        const int result = lower == nullptr ? 1 : condition.value.compare(lower->value);
+        if (result > 0 || (result == 0 && condition.comp == GREAT_THAN)) {
+          lower = &condition;
+        }
+      } else {
+        const int result = upper == nullptr ? -1 : condition.value.compare(upper->value);
+        if (result < 0 || (result == 0 && condition.comp == LESS_THAN)) {
+          upper = &condition;
+        }
       }
+    }
 
-      const Field &field = field_expr->field();
-      index              = table->find_index_by_field(field.field_name());
-      if (nullptr != index) {
-        break;
+    if (equal != nullptr) {
+      range.left_values.push_back(equal->value);
+      range.right_values.push_back(equal->value);
+      range.score += 2;
+      continue;
+    }
+
+    if (lower != nullptr && upper != nullptr) {
+      // 范围为空时放弃这个字段上的范围条件，由谓词过滤
+      const int result = lower->value.compare(upper->value);
+      if (result > 0 || (result == 0 && (lower->comp == GREAT_THAN || upper->comp == LESS_THAN))) {
+        lower = upper = nullptr;
       }
     }
+
+    if (lower != nullptr) {
+      range.left_values.push_back(lower->value);
+      range.left_inclusive = lower->comp == GREAT_EQUAL;
+    }
+    if (upper != nullptr) {
+      range.right_values.push_back(upper->value);
+      range.right_inclusive = upper->comp == LESS_EQUAL;
+    }
+    if (lower != nullptr || upper != nullptr) {
+      range.score += 1;
+    }
+    break;
   }
 
-  if (index != nullptr) {
-    ASSERT(value_expr != nullptr, "got an index but value expr is null ?");
+  return range.score > 0;
+}
 
-    const Value               &value           = value_expr->get_value();
+RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper, Session* session)
+{
+  vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
+  // 看看是否有可以用于索引查找的表达式
+  Table *table = table_get_oper.table();
+
+  vector<IndexCondition> conditions;
+  collect_index_conditions(table, predicates, conditions);
+
+  // 选择可以使用最多条件的索引
+  IndexScanRange best_range;
+  if (!conditions.empty()) {
+    const TableMeta &table_meta = table->table_meta();
+    for (int i = 0; i < table_meta.index_num(); i++) {
+      IndexScanRange range;
+      range.index = table->find_index(table_meta.index(i)->name());
+      if (range.index != nullptr && make_index_scan_range(conditions, range) && range.score > best_range.score) {
+        best_range = std::move(range);
+      }
+    }
+  }
+
+  if (best_range.index != nullptr) {
     IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(table,
-        index,
+        best_range.index,
         table_get_oper.read_write_mode(),
-        &value,
-        true /*left_inclusive*/,
-        &value,
-        true /*right_inclusive*/);
+        best_range.left_values,
+        best_range.left_inclusive,
+        best_range.right_values,
+        best_range.right_inclusive);
 
+    // 索引只用来缩小扫描范围，所有的谓词仍然需要过滤一遍
     index_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(index_scan_oper);
-    LOG_TRACE("use index scan");
+    LOG_TRACE("use index scan. index=%s", best_range.index->index_meta().name());
   } else {
     auto table_scan_oper = new TableScanPhysicalOperator(table, table_get_oper.read_write_mode());
     table_scan_oper->set_predicates(std::move(predicates));
@@ -319,7 +484,30 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
     LOG_WARN("join operator should have 2 children, but have %d", child_opers.size());
     return RC::INTERNAL;
   }
-  if (session->hash_join_on() && can_use_hash_join(join_oper)) {
+  if (join_oper.join_type() != JoinType::INNER) {
+    // semi/anti join 由子查询改写而来，连接条件都是等值比较，左边是外层查询的表达式
+    vector<unique_ptr<Expression>> left_keys;
+    vector<unique_ptr<Expression>> right_keys;
+    for (unique_ptr<Expression> &predicate : join_oper.get_join_predicates()) {
+      auto &cmp_expr = static_cast<ComparisonExpr &>(*predicate);
+      left_keys.emplace_back(std::move(cmp_expr.left()));
+      right_keys.emplace_back(std::move(cmp_expr.right()));
+    }
+    join_oper.clear_join_predicates();
+
+    unique_ptr<PhysicalOperator> join_physical_oper(
+        new HashSemiJoinPhysicalOperator(join_oper.join_type(), std::move(left_keys), std::move(right_keys)));
+    for (auto &child_oper : child_opers) {
+      unique_ptr<PhysicalOperator> child_physical_oper;
+      rc = create(*child_oper, child_physical_oper, session);
+      if (rc != RC::SUCCESS) {
+        LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+        return rc;
+      }
+      join_physical_oper->add_child(std::move(child_physical_oper));
+    }
+    oper = std::move(join_physical_oper);
+  } else if (session->hash_join_on() && can_use_hash_join(join_oper)) {
     // your code here
   } else {
     unique_ptr<PhysicalOperator> join_physical_oper(new NestedLoopJoinPhysicalOperator());
@@ -383,6 +571,347 @@ RC PhysicalPlanGenerator::create_plan(GroupByLogicalOperator &logical_oper, uniq
   return rc;
 }
 
+/**
+ * @brief 表达式是否可以按照 chunk 计算
+ * @details 比较和算术运算的两边需要是相同的类型，目前不支持子查询、IN 和 IS NULL
+ */
+static bool can_eval_vec(Expression *expr)
+{
+  if (expr == nullptr) {
+    return true;
+  }
+
+  switch (expr->type()) {
+    case ExprType::FIELD:
+    case ExprType::VALUE: {
+      return true;
+    }
+    case ExprType::CAST: {
+      return can_eval_vec(static_cast<CastExpr *>(expr)->child().get());
+    }
+    case ExprType::AGGREGATION: {
+      return can_eval_vec(static_cast<AggregateExpr *>(expr)->child().get());
+    }
+    case ExprType::CONJUNCTION: {
+      for (unique_ptr<Expression> &child : static_cast<ConjunctionExpr *>(expr)->children()) {
+        if (!can_eval_vec(child.get())) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case ExprType::ARITHMETIC: {
+      auto          *arithmetic_expr = static_cast<ArithmeticExpr *>(expr);
+      Expression    *right           = arithmetic_expr->right().get();
+      const AttrType right_type      = right == nullptr ? AttrType::UNDEFINED : right->value_type();
+      if ((right == nullptr) != (arithmetic_expr->arithmetic_type() == ArithmeticExpr::Type::NEGATIVE) ||
+          !can_calc_columns(arithmetic_expr->arithmetic_type(),
+              arithmetic_expr->left()->value_type(),
+              right_type,
+              arithmetic_expr->value_type())) {
+        return false;
+      }
+      return can_eval_vec(arithmetic_expr->left().get()) && can_eval_vec(right);
+    }
+    case ExprType::COMPARISON: {
+      auto *cmp_expr = static_cast<ComparisonExpr *>(expr);
+      switch (cmp_expr->comp()) {
+        case EQUAL_TO:
+        case LESS_EQUAL:
+        case NOT_EQUAL:
+        case LESS_THAN:
+        case GREAT_EQUAL:
+        case GREAT_THAN: break;
+        default: return false;
+      }
+      if (!can_compare_columns(cmp_expr->left()->value_type(), cmp_expr->right()->value_type())) {
+        return false;
+      }
+      return can_eval_vec(cmp_expr->left().get()) && can_eval_vec(cmp_expr->right().get());
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief 是否有对应的聚合状态（参考 aggregate_state.h），目前只支持数值类型的 sum/avg/max/min 和任意类型的 count
+ */
+static bool can_aggregate_vec(AggregateExpr *expr)
+{
+  return aggregate_state_size(expr->aggregate_type(), expr->child()->value_type()) > 0;
+}
+
+bool PhysicalPlanGenerator::can_create_vec(LogicalOperator &logical_operator)
+{
+  switch (logical_operator.type()) {
+    case LogicalOperatorType::TABLE_GET: {
+      for (unique_ptr<Expression> &predicate : static_cast<TableGetLogicalOperator &>(logical_operator).predicates()) {
+        if (!can_eval_vec(predicate.get())) {
+          return false;
+        }
+      }
+    } break;
+
+    case LogicalOperatorType::PREDICATE:
+    case LogicalOperatorType::PROJECTION: {
+      for (unique_ptr<Expression> &expr : logical_operator.expressions()) {
+        if (!can_eval_vec(expr.get())) {
+          return false;
+        }
+      }
+    } break;
+
+    case LogicalOperatorType::GROUP_BY: {
+      auto &group_by_oper = static_cast<GroupByLogicalOperator &>(logical_operator);
+      for (unique_ptr<Expression> &expr : group_by_oper.group_by_expressions()) {
+        if (!can_eval_vec(expr.get())) {
+          return false;
+        }
+      }
+      for (Expression *expr : group_by_oper.aggregate_expressions()) {
+        if (!can_eval_vec(expr) || !can_aggregate_vec(static_cast<AggregateExpr *>(expr))) {
+          return false;
+        }
+      }
+    } break;
+
+    case LogicalOperatorType::JOIN: {
+      for (unique_ptr<Expression> &predicate : static_cast<JoinLogicalOperator &>(logical_operator).get_join_predicates()) {
+        if (!can_eval_vec(predicate.get())) {
+          return false;
+        }
+      }
+    } break;
+
+    case LogicalOperatorType::ORDER_BY:
+    case LogicalOperatorType::LIMIT:
+    case LogicalOperatorType::EXPLAIN: {
+    } break;
+
+    default: {
+      return false;
+    }
+  }
+
+  for (unique_ptr<LogicalOperator> &child : logical_operator.children()) {
+    if (!can_create_vec(*child)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 收集逻辑算子返回的 chunk 中依次是哪些表的列
+ * @details 表扫描返回表的所有字段，连接算子返回左孩子的所有列后面接着右孩子的所有列，semi/anti join 只返回左孩子的列。
+ * 分组聚合改变了 chunk 的结构，不再收集。
+ */
+static void collect_chunk_tables(LogicalOperator &oper, vector<const Table *> &tables)
+{
+  switch (oper.type()) {
+    case LogicalOperatorType::TABLE_GET: {
+      tables.push_back(static_cast<TableGetLogicalOperator &>(oper).table());
+    } break;
+    case LogicalOperatorType::JOIN: {
+      if (static_cast<JoinLogicalOperator &>(oper).join_type() != JoinType::INNER) {
+        collect_chunk_tables(*oper.children().front(), tables);
+        break;
+      }
+      for (unique_ptr<LogicalOperator> &child : oper.children()) {
+        collect_chunk_tables(*child, tables);
+      }
+    } break;
+    case LogicalOperatorType::PREDICATE:
+    case LogicalOperatorType::ORDER_BY:
+    case LogicalOperatorType::LIMIT: {
+      for (unique_ptr<LogicalOperator> &child : oper.children()) {
+        collect_chunk_tables(*child, tables);
+      }
+    } break;
+    default: break;
+  }
+}
+
+/**
+ * @brief 字段在 chunk 中的位置，找不到时返回 -1
+ */
+static int chunk_column_pos(const vector<const Table *> &tables, const Table *table, const FieldMeta *field)
+{
+  int offset = 0;
+  for (const Table *chunk_table : tables) {
+    if (chunk_table == table) {
+      int index = table->table_meta().field_index(field);
+      return index < 0 ? -1 : offset + index;
+    }
+    offset += chunk_table->table_meta().field_num();
+  }
+  return -1;
+}
+
+/**
+ * @brief 设置表达式中字段在 chunk 中的位置
+ * @details 已经设置过位置的字段（比如分组之后引用分组列的字段）保持不变
+ */
+static RC bind_chunk_columns(const vector<const Table *> &tables, Expression &expr)
+{
+  if (expr.type() == ExprType::FIELD) {
+    auto &field_expr = static_cast<FieldExpr &>(expr);
+    if (field_expr.pos() != -1) {
+      return RC::SUCCESS;
+    }
+    int pos = chunk_column_pos(tables, field_expr.field().table(), field_expr.field().meta());
+    if (pos < 0) {
+      LOG_WARN("failed to find field in chunk. field=%s.%s", field_expr.table_name(), field_expr.field_name());
+      return RC::INTERNAL;
+    }
+    field_expr.set_pos(pos);
+    return RC::SUCCESS;
+  }
+
+  return ExpressionIterator::iterate_child_expr(expr, [&tables](unique_ptr<Expression> &child) {
+    return child ? bind_chunk_columns(tables, *child) : RC::SUCCESS;
+  });
+}
+
+static RC bind_chunk_columns(const vector<const Table *> &tables, vector<unique_ptr<Expression>> &exprs)
+{
+  for (unique_ptr<Expression> &expr : exprs) {
+    RC rc = bind_chunk_columns(tables, *expr);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+static void collect_expr_tables(Expression &expr, unordered_set<const Table *> &tables)
+{
+  if (expr.type() == ExprType::FIELD) {
+    tables.insert(static_cast<FieldExpr &>(expr).field().table());
+    return;
+  }
+
+  ExpressionIterator::iterate_child_expr(expr, [&tables](unique_ptr<Expression> &child) {
+    if (child) {
+      collect_expr_tables(*child, tables);
+    }
+    return RC::SUCCESS;
+  });
+}
+
+static bool contains_table(const vector<const Table *> &chunk_tables, const Table *table)
+{
+  return find(chunk_tables.begin(), chunk_tables.end(), table) != chunk_tables.end();
+}
+
+static bool contains_tables(const vector<const Table *> &chunk_tables, const unordered_set<const Table *> &tables)
+{
+  for (const Table *table : tables) {
+    if (!contains_table(chunk_tables, table)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 是否是 hash join 可以使用的连接条件，即左右两边各一个字段的等值比较
+ */
+static bool is_hash_join_condition(
+    Expression &expr, const vector<const Table *> &left_tables, const vector<const Table *> &right_tables)
+{
+  if (expr.type() != ExprType::COMPARISON) {
+    return false;
+  }
+  auto &cmp_expr = static_cast<ComparisonExpr &>(expr);
+  if (cmp_expr.comp() != EQUAL_TO || cmp_expr.left()->type() != ExprType::FIELD ||
+      cmp_expr.right()->type() != ExprType::FIELD) {
+    return false;
+  }
+
+  AttrType type = cmp_expr.left()->value_type();
+  if (type != cmp_expr.right()->value_type() ||
+      (type != AttrType::INTS && type != AttrType::FLOATS && type != AttrType::CHARS && type != AttrType::DATES)) {
+    return false;
+  }
+
+  const Table *left_table  = static_cast<FieldExpr &>(*cmp_expr.left()).field().table();
+  const Table *right_table = static_cast<FieldExpr &>(*cmp_expr.right()).field().table();
+  return (contains_table(left_tables, left_table) && contains_table(right_tables, right_table)) ||
+         (contains_table(left_tables, right_table) && contains_table(right_tables, left_table));
+}
+
+/**
+ * @brief 把过滤条件下推到连接算子下面
+ * @details 只涉及一个表的条件交给这个表的扫描算子过滤，左右两边各一个字段的等值条件作为 hash join 的连接条件，
+ * 避免连接算子先生成笛卡尔积再过滤。
+ * @return 条件是否已经下推
+ */
+static bool push_down_condition(
+    LogicalOperator &oper, unique_ptr<Expression> &cond, const unordered_set<const Table *> &cond_tables)
+{
+  switch (oper.type()) {
+    case LogicalOperatorType::TABLE_GET: {
+      auto &table_get_oper = static_cast<TableGetLogicalOperator &>(oper);
+      if (cond_tables.size() == 1 && *cond_tables.begin() == table_get_oper.table()) {
+        table_get_oper.predicates().emplace_back(std::move(cond));
+        return true;
+      }
+      return false;
+    }
+
+    case LogicalOperatorType::JOIN: {
+      auto                 &join_oper = static_cast<JoinLogicalOperator &>(oper);
+      LogicalOperator      &left      = *join_oper.children()[0];
+      LogicalOperator      &right     = *join_oper.children()[1];
+      vector<const Table *> left_tables;
+      vector<const Table *> right_tables;
+      collect_chunk_tables(left, left_tables);
+      collect_chunk_tables(right, right_tables);
+      if (contains_tables(left_tables, cond_tables)) {
+        return push_down_condition(left, cond, cond_tables);
+      }
+      // semi/anti join 上面的条件只涉及左边的表
+      if (join_oper.join_type() != JoinType::INNER) {
+        return false;
+      }
+      if (contains_tables(right_tables, cond_tables)) {
+        return push_down_condition(right, cond, cond_tables);
+      }
+      if (is_hash_join_condition(*cond, left_tables, right_tables)) {
+        join_oper.add_join_predicate(std::move(cond));
+        return true;
+      }
+      return false;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+static int session_parallel_degree(Session *session) { return session != nullptr ? session->parallel_degree() : 1; }
+
+/**
+ * @brief 下层的流水线可以并行执行时，在上面加一个 Gather 算子
+ * @details 在需要在会话线程中读取流水线结果的算子（投影、排序、LIMIT）下面调用。
+ * 加了 Gather 之后 oper 就不能再并行执行，所以一个流水线上只有一个 Gather
+ */
+static void add_gather(unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  const int parallel_degree = session_parallel_degree(session);
+  if (parallel_degree <= 1 || !oper->parallel_safe()) {
+    return;
+  }
+
+  auto gather = make_unique<GatherVecPhysicalOperator>(parallel_degree);
+  gather->add_child(std::move(oper));
+  oper = std::move(gather);
+}
+
 RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_oper, unique_ptr<PhysicalOperator> &oper, Session* session)
 {
   vector<unique_ptr<Expression>> &predicates = table_get_oper.predicates();
@@ -398,17 +927,34 @@ RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_ope
 RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper, Session* session)
 {
   RC rc = RC::SUCCESS;
+  ASSERT(logical_oper.children().size() == 1, "group by operator should have 1 child");
+
+  vector<const Table *> tables;
+  collect_chunk_tables(*logical_oper.children().front(), tables);
+  rc = bind_chunk_columns(tables, logical_oper.group_by_expressions());
+  for (size_t i = 0; OB_SUCC(rc) && i < logical_oper.aggregate_expressions().size(); i++) {
+    rc = bind_chunk_columns(tables, *logical_oper.aggregate_expressions()[i]);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to bind group by expressions to chunk columns. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 下层的流水线可以并行执行时，聚合算子按照会话设置的并行度并行执行流水线和聚合
+  const int parallel_degree = session_parallel_degree(session);
+
   unique_ptr<PhysicalOperator> physical_oper = nullptr;
   if (logical_oper.group_by_expressions().empty()) {
-    physical_oper = make_unique<AggregateVecPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    auto aggregate_oper = make_unique<AggregateVecPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    aggregate_oper->set_parallel_degree(parallel_degree);
+    physical_oper = std::move(aggregate_oper);
   } else {
-    physical_oper = make_unique<GroupByVecPhysicalOperator>(
+    auto group_by_oper = make_unique<GroupByVecPhysicalOperator>(
       std::move(logical_oper.group_by_expressions()), std::move(logical_oper.aggregate_expressions()));
-
+    group_by_oper->set_parallel_degree(parallel_degree);
+    physical_oper = std::move(group_by_oper);
   }
 
-  ASSERT(logical_oper.children().size() == 1, "group by operator should have 1 child");
-
   LogicalOperator             &child_oper = *logical_oper.children().front();
   unique_ptr<PhysicalOperator> child_physical_oper;
   rc = create_vec(child_oper, child_physical_oper, session);
@@ -434,7 +980,19 @@ RC PhysicalPlanGenerator::create_vec_plan(ProjectLogicalOperator &project_oper,
   RC rc = RC::SUCCESS;
   if (!child_opers.empty()) {
     LogicalOperator *child_oper = child_opers.front().get();
-    rc                          = create_vec(*child_oper, child_phy_oper, session);
+
+    // 下层是分组聚合时，表达式的位置在生成逻辑计划时已经确定
+    vector<const Table *> tables;
+    collect_chunk_tables(*child_oper, tables);
+    if (!tables.empty()) {
+      rc = bind_chunk_columns(tables, project_oper.expressions());
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to bind project expressions to chunk columns. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+
+    rc = create_vec(*child_oper, child_phy_oper, session);
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to create project logical operator's child physical operator. rc=%s", strrc(rc));
       return rc;
@@ -448,8 +1006,9 @@ RC PhysicalPlanGenerator::create_vec_plan(ProjectLogicalOperator &project_oper,
     for (auto &expr : project_operator->expressions()) {
       expressions.push_back(expr.get());
     }
-    auto expr_operator = make_unique<ExprVecPhysicalOperator>(std::move(expressions));
+    unique_ptr<PhysicalOperator> expr_operator = make_unique<ExprVecPhysicalOperator>(std::move(expressions));
     expr_operator->add_child(std::move(child_phy_oper));
+    add_gather(expr_operator, session);
     project_operator->add_child(std::move(expr_operator));
   }
 
@@ -526,4 +1085,189 @@ RC PhysicalPlanGenerator::create_plan(OrderByLogicalOperator &order_by_oper, std
     oper->add_child(std::move(child_physical_oper));
   }
   return rc;
-}
\ No newline at end of file
+}
+RC PhysicalPlanGenerator::create_plan(LimitLogicalOperator &limit_oper, unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  ASSERT(limit_oper.children().size() == 1, "limit operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;
+  RC                           rc = create(*limit_oper.children().front(), child_physical_oper, session);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of limit operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  oper = make_unique<LimitPhysicalOperator>(limit_oper.limit());
+  oper->add_child(std::move(child_physical_oper));
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(PredicateLogicalOperator &pred_oper, unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  vector<unique_ptr<LogicalOperator>> &children_opers = pred_oper.children();
+  ASSERT(children_opers.size() == 1, "predicate logical operator's sub oper number should be 1");
+
+  vector<unique_ptr<Expression>> &expressions = pred_oper.expressions();
+  ASSERT(expressions.size() == 1, "predicate logical operator's children should be 1");
+
+  LogicalOperator &child_oper = *children_opers.front();
+
+  // 连接算子上面的条件尽量下推，剩下的条件在连接之后过滤
+  vector<unique_ptr<Expression>> conditions;
+  unique_ptr<Expression>         expression = std::move(expressions.front());
+  expressions.clear();
+  if (expression->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr &>(*expression).conjunction_type() == ConjunctionExpr::Type::AND) {
+    conditions.swap(static_cast<ConjunctionExpr &>(*expression).children());
+  } else {
+    conditions.emplace_back(std::move(expression));
+  }
+
+  vector<unique_ptr<Expression>> remain_conditions;
+  for (unique_ptr<Expression> &condition : conditions) {
+    unordered_set<const Table *> cond_tables;
+    collect_expr_tables(*condition, cond_tables);
+    if (child_oper.type() == LogicalOperatorType::JOIN && !cond_tables.empty() &&
+        push_down_condition(child_oper, condition, cond_tables)) {
+      continue;
+    }
+    remain_conditions.emplace_back(std::move(condition));
+  }
+
+  vector<const Table *> tables;
+  collect_chunk_tables(child_oper, tables);
+  RC rc = bind_chunk_columns(tables, remain_conditions);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to bind predicate to chunk columns. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  unique_ptr<PhysicalOperator> child_phy_oper;
+  rc = create_vec(child_oper, child_phy_oper, session);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child operator of predicate operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (remain_conditions.empty()) {
+    oper = std::move(child_phy_oper);
+    return rc;
+  }
+
+  oper = make_unique<PredicateVecPhysicalOperator>(
+      make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, remain_conditions));
+  oper->add_child(std::move(child_phy_oper));
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(JoinLogicalOperator &join_oper, unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = join_oper.children();
+  if (child_opers.size() != 2) {
+    LOG_WARN("join operator should have 2 children, but have %d", child_opers.size());
+    return RC::INTERNAL;
+  }
+
+  vector<const Table *> left_tables;
+  vector<const Table *> right_tables;
+  collect_chunk_tables(*child_opers[0], left_tables);
+  collect_chunk_tables(*child_opers[1], right_tables);
+
+  // 等值连接条件拆成左右两边的连接键
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  for (unique_ptr<Expression> &predicate : join_oper.get_join_predicates()) {
+    auto                        &cmp_expr = static_cast<ComparisonExpr &>(*predicate);
+    unordered_set<const Table *> tables;
+    collect_expr_tables(*cmp_expr.left(), tables);
+    // semi/anti join 的条件左边是外层查询的表达式，子查询中也可能有同一个表
+    if (join_oper.join_type() != JoinType::INNER || contains_tables(left_tables, tables)) {
+      left_keys.emplace_back(std::move(cmp_expr.left()));
+      right_keys.emplace_back(std::move(cmp_expr.right()));
+    } else {
+      left_keys.emplace_back(std::move(cmp_expr.right()));
+      right_keys.emplace_back(std::move(cmp_expr.left()));
+    }
+  }
+  join_oper.clear_join_predicates();
+
+  RC rc = bind_chunk_columns(left_tables, left_keys);
+  if (OB_SUCC(rc)) {
+    rc = bind_chunk_columns(right_tables, right_keys);
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to bind join keys to chunk columns. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  unique_ptr<PhysicalOperator> join_physical_oper;
+  if (left_keys.empty() && join_oper.join_type() == JoinType::INNER) {
+    join_physical_oper = make_unique<NestedLoopJoinVecPhysicalOperator>();
+  } else {
+    join_physical_oper = make_unique<HashJoinVecPhysicalOperator>(
+        std::move(left_keys), std::move(right_keys), join_oper.join_type());
+  }
+
+  for (unique_ptr<LogicalOperator> &child_oper : child_opers) {
+    unique_ptr<PhysicalOperator> child_physical_oper;
+    rc = create_vec(*child_oper, child_physical_oper, session);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+      return rc;
+    }
+    join_physical_oper->add_child(std::move(child_physical_oper));
+  }
+
+  oper = std::move(join_physical_oper);
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(OrderByLogicalOperator &order_by_oper, unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  ASSERT(order_by_oper.children().size() == 1, "order by operator should have 1 child");
+  LogicalOperator &child_oper = *order_by_oper.children().front();
+
+  vector<const Table *> tables;
+  collect_chunk_tables(child_oper, tables);
+
+  vector<OrderByVecPhysicalOperator::OrderKey> keys;
+  for (OrderUnit *order : order_by_oper.orders()) {
+    OrderByVecPhysicalOperator::OrderKey key;
+    key.pos = chunk_column_pos(tables, order->field().table(), order->field().meta());
+    key.asc = order->type() == ASC;
+    if (key.pos < 0) {
+      LOG_WARN("failed to find order by field in chunk. field=%s", order->field().field_name());
+      return RC::INTERNAL;
+    }
+    keys.push_back(key);
+  }
+
+  unique_ptr<PhysicalOperator> child_physical_oper;
+  RC                           rc = create_vec(child_oper, child_physical_oper, session);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of order by operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  add_gather(child_physical_oper, session);
+  oper = make_unique<OrderByVecPhysicalOperator>(std::move(keys));
+  oper->add_child(std::move(child_physical_oper));
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(LimitLogicalOperator &limit_oper, unique_ptr<PhysicalOperator> &oper, Session *session)
+{
+  ASSERT(limit_oper.children().size() == 1, "limit operator should have 1 child");
+
+  unique_ptr<PhysicalOperator> child_physical_oper;
+  RC                           rc = create_vec(*limit_oper.children().front(), child_physical_oper, session);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create child physical operator of limit operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  add_gather(child_physical_oper, session);
+  oper = make_unique<LimitVecPhysicalOperator>(limit_oper.limit());
+  oper->add_child(std::move(child_physical_oper));
+  return rc;
+}
@@ -18,11 +18,13 @@ See the Mulan PSL v2 for more details. */
 #include "sql/optimizer/expression_rewriter.h"
 #include "sql/optimizer/predicate_pushdown_rewriter.h"
 #include "sql/optimizer/predicate_rewrite.h"
+#include "sql/optimizer/subquery_to_join_rewriter.h"
 
 Rewriter::Rewriter()
 {
   rewrite_rules_.emplace_back(new ExpressionRewriter);
   rewrite_rules_.emplace_back(new PredicateRewriteRule);
+  rewrite_rules_.emplace_back(new SubqueryToJoinRewriter);
   rewrite_rules_.emplace_back(new PredicatePushdownRewriter);
 }
 
@@ -0,0 +1,320 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/column_statistics.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/cmath.h"
+#include "common/log/log.h"
+
+#include "json/json.h"
+
+const static Json::StaticString FIELD_NAME("name");
+const static Json::StaticString FIELD_TYPE("type");
+const static Json::StaticString FIELD_NULL_FRACTION("null_fraction");
+const static Json::StaticString FIELD_NDV("ndv");
+const static Json::StaticString FIELD_MIN("min");
+const static Json::StaticString FIELD_MAX("max");
+const static Json::StaticString FIELD_HISTOGRAM("histogram");
+
+static void value_to_json(const Value &value, Json::Value &json_value)
+{
+  switch (value.attr_type()) {
+    case AttrType::INTS:
+    case AttrType::DATES: json_value = value.get_int(); break;
+    case AttrType::FLOATS: json_value = value.get_float(); break;
+    case AttrType::BOOLEANS: json_value = value.get_boolean(); break;
+    default: json_value = value.get_string(); break;
+  }
+}
+
+static RC value_from_json(const Json::Value &json_value, AttrType type, Value &value)
+{
+  switch (type) {
+    case AttrType::INTS:
+    case AttrType::DATES: {
+      if (!json_value.isInt()) {
+        return RC::INVALID_ARGUMENT;
+      }
+      if (type == AttrType::INTS) {
+        value.set_int(json_value.asInt());
+      } else {
+        value.set_date(json_value.asInt());
+      }
+    } break;
+    case AttrType::FLOATS: {
+      if (!json_value.isNumeric()) {
+        return RC::INVALID_ARGUMENT;
+      }
+      value.set_float(json_value.asFloat());
+    } break;
+    case AttrType::BOOLEANS: {
+      if (!json_value.isBool()) {
+        return RC::INVALID_ARGUMENT;
+      }
+      value.set_boolean(json_value.asBool());
+    } break;
+    case AttrType::CHARS: {
+      if (!json_value.isString()) {
+        return RC::INVALID_ARGUMENT;
+      }
+      value.set_string(json_value.asCString());
+    } break;
+    default: {
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+/// 数值类型在桶内插值时使用的值
+static bool to_double(const Value &value, double &result)
+{
+  switch (value.attr_type()) {
+    case AttrType::INTS:
+    case AttrType::DATES: result = value.get_int(); return true;
+    case AttrType::FLOATS: result = value.get_float(); return true;
+    default: return false;
+  }
+}
+
+bool ColumnStatistics::support_range(AttrType type)
+{
+  switch (type) {
+    case AttrType::CHARS:
+    case AttrType::INTS:
+    case AttrType::DATES:
+    case AttrType::FLOATS:
+    case AttrType::BOOLEANS: return true;
+    default: return false;
+  }
+}
+
+double ColumnStatistics::fraction_below(const Value &value) const
+{
+  if (!has_histogram()) {
+    return 1.0 / 3;
+  }
+
+  const int bucket_num = static_cast<int>(histogram_.size()) - 1;
+  // 第一个不小于 value 的边界
+  auto iter = lower_bound(
+      histogram_.begin(), histogram_.end(), value, [](const Value &bound, const Value &v) { return bound.compare(v) < 0; });
+  if (iter == histogram_.begin()) {
+    return 0;
+  }
+  if (iter == histogram_.end()) {
+    return 1;
+  }
+
+  const int    bucket = static_cast<int>(iter - histogram_.begin()) - 1;
+  double       low = 0, high = 0, v = 0;
+  double       inside = 0.5;
+  if (to_double(*(iter - 1), low) && to_double(*iter, high) && to_double(value, v) && high > low) {
+    inside = (v - low) / (high - low);
+  }
+  return (bucket + inside) / bucket_num;
+}
+
+double ColumnStatistics::fraction_equal(const Value &value) const
+{
+  if (ndv_ <= 0) {
+    return 0;
+  }
+  if (!support_range(type_) || min_.attr_type() == AttrType::UNDEFINED) {
+    return 1.0 / ndv_;
+  }
+  if (value.compare(min_) < 0 || value.compare(max_) > 0) {
+    return 0;
+  }
+
+  double fraction = 1.0 / ndv_;
+  if (has_histogram()) {
+    // 多个边界都等于 value 时，value 至少占据了这些边界之间的桶
+    auto range = equal_range(histogram_.begin(), histogram_.end(), value, [](const Value &left, const Value &right) {
+      return left.compare(right) < 0;
+    });
+    const int bounds = static_cast<int>(range.second - range.first);
+    if (bounds >= 2) {
+      fraction = max(fraction, static_cast<double>(bounds - 1) / (histogram_.size() - 1));
+    }
+  }
+  return min(fraction, 1.0);
+}
+
+double ColumnStatistics::equal_selectivity(const Value &value) const
+{
+  if (value.is_null()) {
+    return 0;
+  }
+  return (1 - null_fraction_) * fraction_equal(value);
+}
+
+double ColumnStatistics::less_selectivity(const Value &value, bool inclusive) const
+{
+  if (value.is_null()) {
+    return 0;
+  }
+  double fraction = fraction_below(value);
+  if (inclusive) {
+    fraction += fraction_equal(value);
+  }
+  return (1 - null_fraction_) * min(max(fraction, 0.0), 1.0);
+}
+
+double ColumnStatistics::greater_selectivity(const Value &value, bool inclusive) const
+{
+  if (value.is_null()) {
+    return 0;
+  }
+  return max((1 - null_fraction_) - less_selectivity(value, !inclusive), 0.0);
+}
+
+void ColumnStatistics::to_json(Json::Value &json_value) const
+{
+  json_value[FIELD_NAME]          = name_;
+  json_value[FIELD_TYPE]          = attr_type_to_string(type_);
+  json_value[FIELD_NULL_FRACTION] = null_fraction_;
+  json_value[FIELD_NDV]           = ndv_;
+  if (min_.attr_type() != AttrType::UNDEFINED) {
+    value_to_json(min_, json_value[FIELD_MIN]);
+    value_to_json(max_, json_value[FIELD_MAX]);
+  }
+
+  Json::Value histogram_value(Json::arrayValue);
+  for (const Value &bound : histogram_) {
+    Json::Value bound_value;
+    value_to_json(bound, bound_value);
+    histogram_value.append(std::move(bound_value));
+  }
+  json_value[FIELD_HISTOGRAM] = std::move(histogram_value);
+}
+
+RC ColumnStatistics::from_json(const Json::Value &json_value, ColumnStatistics &column)
+{
+  if (!json_value.isObject()) {
+    LOG_ERROR("Failed to deserialize column statistics. json is not an object. json value=%s",
+              json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  const Json::Value &name_value          = json_value[FIELD_NAME];
+  const Json::Value &type_value          = json_value[FIELD_TYPE];
+  const Json::Value &null_fraction_value = json_value[FIELD_NULL_FRACTION];
+  const Json::Value &ndv_value           = json_value[FIELD_NDV];
+  const Json::Value &histogram_value     = json_value[FIELD_HISTOGRAM];
+  if (!name_value.isString() || !type_value.isString() || !null_fraction_value.isNumeric() || !ndv_value.isNumeric() ||
+      !histogram_value.isArray()) {
+    LOG_ERROR("Invalid column statistics. json value=%s", json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  column.name_          = name_value.asString();
+  column.type_          = attr_type_from_string(type_value.asCString());
+  column.null_fraction_ = null_fraction_value.asDouble();
+  column.ndv_           = ndv_value.asDouble();
+  column.min_.reset();
+  column.max_.reset();
+  column.histogram_.clear();
+
+  const Json::Value &min_value = json_value[FIELD_MIN];
+  const Json::Value &max_value = json_value[FIELD_MAX];
+  if (!min_value.isNull() && (OB_FAIL(value_from_json(min_value, column.type_, column.min_)) ||
+                                 OB_FAIL(value_from_json(max_value, column.type_, column.max_)))) {
+    LOG_ERROR("Invalid min/max value of column statistics. json value=%s", json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  column.histogram_.resize(histogram_value.size());
+  for (Json::ArrayIndex i = 0; i < histogram_value.size(); i++) {
+    if (OB_FAIL(value_from_json(histogram_value[i], column.type_, column.histogram_[i]))) {
+      LOG_ERROR("Invalid histogram of column statistics. json value=%s", json_value.toStyledString().c_str());
+      return RC::INTERNAL;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void ColumnStatisticsBuilder::add(const Value &value)
+{
+  row_num_++;
+  if (value.is_null()) {
+    null_num_++;
+    return;
+  }
+
+  hll_.add(value);
+  if (ColumnStatistics::support_range(type_)) {
+    values_.push_back(value);
+  }
+}
+
+double ColumnStatisticsBuilder::scale_ndv(double sample_ndv, double sample_rows, double row_num)
+{
+  if (sample_ndv <= 0 || sample_rows <= 0 || sample_rows >= row_num) {
+    return sample_ndv;
+  }
+
+  // 采样中的不同值个数的期望 D * (1 - (1 - q)^(N / D)) 随 D 单调递增，二分查找
+  const double q        = sample_rows / row_num;
+  auto         expected = [q, row_num](double d) { return d * (1 - pow(1 - q, row_num / d)); };
+  if (expected(row_num) <= sample_ndv) {
+    return row_num;
+  }
+  double low = sample_ndv, high = row_num;
+  for (int i = 0; i < 64 && high - low > 0.5; i++) {
+    const double mid = (low + high) / 2;
+    if (expected(mid) < sample_ndv) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  return high;
+}
+
+void ColumnStatisticsBuilder::build(double row_num, ColumnStatistics &column, int bucket_num)
+{
+  column.name_          = name_;
+  column.type_          = type_;
+  column.null_fraction_ = row_num_ == 0 ? 0 : static_cast<double>(null_num_) / row_num_;
+  column.min_.reset();
+  column.max_.reset();
+  column.histogram_.clear();
+
+  const int64_t non_null_num = row_num_ - null_num_;
+  if (non_null_num == 0) {
+    column.ndv_ = 0;
+    return;
+  }
+
+  // HyperLogLog 的估计值不会超过实际的值个数
+  const double sample_ndv = min(max(hll_.estimate(), 1.0), static_cast<double>(non_null_num));
+  const double scale      = row_num_ == 0 ? 1 : row_num / row_num_;
+  column.ndv_             = max(scale_ndv(sample_ndv, non_null_num, non_null_num * scale), 1.0);
+
+  if (values_.empty()) {
+    return;
+  }
+
+  sort(values_.begin(), values_.end(), [](const Value &left, const Value &right) { return left.compare(right) < 0; });
+  column.min_ = values_.front();
+  column.max_ = values_.back();
+
+  const int64_t value_num = static_cast<int64_t>(values_.size());
+  bucket_num              = static_cast<int>(min<int64_t>(bucket_num, value_num - 1));
+  if (bucket_num <= 0) {
+    return;
+  }
+  column.histogram_.reserve(bucket_num + 1);
+  for (int i = 0; i <= bucket_num; i++) {
+    column.histogram_.push_back(values_[(value_num - 1) * i / bucket_num]);
+  }
+  values_.clear();
+}
@@ -0,0 +1,118 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "common/value.h"
+#include "sql/optimizer/statistics/hyper_log_log.h"
+
+namespace Json {
+class Value;
+}  // namespace Json
+
+/**
+ * @brief 一个字段的统计信息
+ * @ingroup Statistics
+ * @details 包括 NULL 的比例、不同值的个数（NDV）、最小值、最大值和等深直方图。
+ * 直方图保存 bucket_num + 1 个边界值，相邻的两个边界之间的非 NULL 值个数大致相同，第一个边界是最小值，最后一个是最大值。
+ * 可以比较大小的类型才有最小值、最大值和直方图。
+ */
+class ColumnStatistics
+{
+public:
+  ColumnStatistics() = default;
+
+  const string &name() const { return name_; }
+  AttrType      type() const { return type_; }
+  double        null_fraction() const { return null_fraction_; }
+  double        ndv() const { return ndv_; }
+  const Value  &min_value() const { return min_; }
+  const Value  &max_value() const { return max_; }
+
+  const vector<Value> &histogram() const { return histogram_; }
+  bool                 has_histogram() const { return histogram_.size() >= 2; }
+
+  /// 是否可以比较大小，只有这些类型收集最小值、最大值和直方图
+  static bool support_range(AttrType type);
+
+  /**
+   * @brief 估计 `字段 = value` 的选择率
+   * @details 在 [min, max] 之外时为 0，否则为 (1 - NULL 比例) / NDV。
+   * 一个值在直方图中占据多个完整的桶时，按照占据的桶估计，这样可以反映出现频率很高的值
+   */
+  double equal_selectivity(const Value &value) const;
+
+  /**
+   * @brief 估计 `字段 < value` 或者 `字段 <= value` 的选择率
+   * @details 按照直方图找到 value 所在的桶，数值类型在桶内按照线性分布插值，其它类型取桶的一半
+   */
+  double less_selectivity(const Value &value, bool inclusive) const;
+
+  /// 估计 `字段 > value` 或者 `字段 >= value` 的选择率
+  double greater_selectivity(const Value &value, bool inclusive) const;
+
+  void      to_json(Json::Value &json_value) const;
+  static RC from_json(const Json::Value &json_value, ColumnStatistics &column);
+
+private:
+  friend class ColumnStatisticsBuilder;
+
+  /// 非 NULL 的值中小于 value 的比例
+  double fraction_below(const Value &value) const;
+  /// 非 NULL 的值中等于 value 的比例
+  double fraction_equal(const Value &value) const;
+
+private:
+  string        name_;
+  AttrType      type_          = AttrType::UNDEFINED;
+  double        null_fraction_ = 0;
+  double        ndv_           = 0;
+  Value         min_;
+  Value         max_;
+  vector<Value> histogram_;
+};
+
+/**
+ * @brief 从采样的数据中计算一个字段的统计信息
+ * @ingroup Statistics
+ */
+class ColumnStatisticsBuilder
+{
+public:
+  static constexpr int DEFAULT_BUCKET_NUM = 32;
+
+  ColumnStatisticsBuilder(const string &name, AttrType type) : name_(name), type_(type) {}
+
+  /// 添加一个采样的值
+  void add(const Value &value);
+
+  /**
+   * @brief 计算统计信息
+   * @details 采样的数据只是全表的一部分时，按照每个值出现的次数相同估计全表的 NDV：
+   * 采样比例为 q，全表有 D 个不同值，每个值在采样中至少出现一次的概率为 1 - (1 - q)^(N / D)，
+   * 求出使采样中的不同值个数的期望等于 HyperLogLog 估计值的 D
+   * @param row_num 估计的全表行数
+   */
+  void build(double row_num, ColumnStatistics &column, int bucket_num = DEFAULT_BUCKET_NUM);
+
+  /// 按照采样中的不同值个数估计全表的不同值个数
+  static double scale_ndv(double sample_ndv, double sample_rows, double row_num);
+
+private:
+  string        name_;
+  AttrType      type_;
+  int64_t       row_num_  = 0;
+  int64_t       null_num_ = 0;
+  HyperLogLog   hll_;
+  vector<Value> values_;  ///< 采样的非 NULL 值，用于计算直方图
+};
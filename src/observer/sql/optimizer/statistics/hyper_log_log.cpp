@@ -0,0 +1,71 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/hyper_log_log.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/cmath.h"
+#include "common/lang/functional.h"
+#include "sql/expr/value_hash_set.h"
+
+void HyperLogLog::add(const Value &value)
+{
+  if (value.is_null()) {
+    return;
+  }
+  key_.clear();
+  ValueHashSet::encode(value, key_);
+  add_hash(hash(key_));
+}
+
+void HyperLogLog::add_hash(uint64_t hash)
+{
+  const int index = static_cast<int>(hash >> (64 - PRECISION));
+  // 剩余的位后面补一个 1，全是 0 时 rank 也不会超过 64 - PRECISION + 1
+  const uint64_t rest = (hash << PRECISION) | (1ULL << (PRECISION - 1));
+  const uint8_t  rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+  registers_[index]   = max(registers_[index], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog &other)
+{
+  for (int i = 0; i < REGISTERS; i++) {
+    registers_[i] = max(registers_[i], other.registers_[i]);
+  }
+}
+
+double HyperLogLog::estimate() const
+{
+  const double m     = REGISTERS;
+  double       sum   = 0;
+  int          zeros = 0;
+  for (uint8_t rank : registers_) {
+    sum += ldexp(1.0, -rank);
+    zeros += rank == 0 ? 1 : 0;
+  }
+
+  const double alpha    = 0.7213 / (1 + 1.079 / m);
+  const double estimate = alpha * m * m / sum;
+  if (estimate <= 2.5 * m && zeros > 0) {
+    return m * log(m / zeros);
+  }
+  return estimate;
+}
+
+uint64_t HyperLogLog::hash(const string &key)
+{
+  // std::hash 的低位分布比较好，再用 murmur3 的 fmix64 打散到高位
+  uint64_t h = std::hash<string>()(key);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
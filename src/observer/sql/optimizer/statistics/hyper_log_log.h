@@ -0,0 +1,49 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/value.h"
+
+/**
+ * @brief 估计不同值个数（NDV）的 HyperLogLog
+ * @ingroup Statistics
+ * @details 值的 64 位哈希值的前 PRECISION 位选择一个寄存器，寄存器记录剩余位中第一个 1 出现的最大位置。
+ * 内存大小固定为 2^PRECISION 字节，与值的个数无关，标准误差约为 1.04 / sqrt(2^PRECISION)。
+ * 基数比较小时使用 linear counting 修正。参考 `HyperLogLog in Practice`
+ */
+class HyperLogLog
+{
+public:
+  static constexpr int PRECISION = 12;
+  static constexpr int REGISTERS = 1 << PRECISION;
+
+  HyperLogLog() : registers_(REGISTERS, 0) {}
+
+  /// 添加一个值，NULL 不计入
+  void add(const Value &value);
+
+  void add_hash(uint64_t hash);
+
+  /// 合并另一个 HyperLogLog，结果相当于两边的值都添加到当前的 HyperLogLog 中
+  void merge(const HyperLogLog &other);
+
+  /// 估计添加过的不同值的个数
+  double estimate() const;
+
+  /// 值编码之后的哈希值，参考 ValueHashSet::encode
+  static uint64_t hash(const string &key);
+
+private:
+  vector<uint8_t> registers_;
+  string          key_;  ///< 编码值的缓存
+};
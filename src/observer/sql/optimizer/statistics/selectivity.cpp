@@ -0,0 +1,171 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/selectivity.h"
+#include "catalog/catalog.h"
+#include "common/lang/algorithm.h"
+#include "sql/expr/expression.h"
+#include "sql/optimizer/statistics/table_statistics.h"
+#include "storage/table/table.h"
+
+/// 交换比较的两边之后的比较运算符
+static CompOp swap_comp(CompOp comp)
+{
+  switch (comp) {
+    case CompOp::LESS_THAN: return CompOp::GREAT_THAN;
+    case CompOp::LESS_EQUAL: return CompOp::GREAT_EQUAL;
+    case CompOp::GREAT_THAN: return CompOp::LESS_THAN;
+    case CompOp::GREAT_EQUAL: return CompOp::LESS_EQUAL;
+    default: return comp;
+  }
+}
+
+static double clamp_selectivity(double selectivity) { return min(max(selectivity, 0.0), 1.0); }
+
+shared_ptr<const ColumnStatistics> Selectivity::column(const Field &field)
+{
+  if (field.table() == nullptr || field.meta() == nullptr) {
+    return nullptr;
+  }
+  shared_ptr<const TableStatistics> statistics = field.table()->table_meta().statistics();
+  if (statistics == nullptr) {
+    return nullptr;
+  }
+  const ColumnStatistics *column = statistics->column(field.field_name());
+  return column == nullptr ? nullptr : shared_ptr<const ColumnStatistics>(statistics, column);
+}
+
+double Selectivity::table_rows(const Table *table)
+{
+  shared_ptr<const TableStatistics> statistics = table->table_meta().statistics();
+  if (statistics != nullptr) {
+    return statistics->row_num();
+  }
+  return Catalog::get_instance().get_table_stats(table->table_id()).row_nums;
+}
+
+double Selectivity::estimate(Expression &expr)
+{
+  switch (expr.type()) {
+    case ExprType::CONJUNCTION: {
+      auto  &conjunction = static_cast<ConjunctionExpr &>(expr);
+      double selectivity = conjunction.conjunction_type() == ConjunctionExpr::Type::AND ? 1.0 : 0.0;
+      for (unique_ptr<Expression> &child : conjunction.children()) {
+        const double child_selectivity = estimate(*child);
+        if (conjunction.conjunction_type() == ConjunctionExpr::Type::AND) {
+          selectivity *= child_selectivity;
+        } else {
+          selectivity = selectivity + child_selectivity - selectivity * child_selectivity;
+        }
+      }
+      return clamp_selectivity(selectivity);
+    }
+    case ExprType::COMPARISON: {
+      return estimate_comparison(static_cast<ComparisonExpr &>(expr));
+    }
+    case ExprType::VALUE: {
+      const Value &value = static_cast<ValueExpr &>(expr).get_value();
+      return value.attr_type() == AttrType::BOOLEANS && !value.is_null() && !value.get_boolean() ? 0.0 : 1.0;
+    }
+    default: {
+      return DEFAULT_OTHER;
+    }
+  }
+}
+
+double Selectivity::estimate_comparison(ComparisonExpr &expr)
+{
+  CompOp      comp  = expr.comp();
+  Expression *left  = expr.left().get();
+  Expression *right = expr.right().get();
+  if (left->type() == ExprType::VALUE && right->type() == ExprType::FIELD) {
+    std::swap(left, right);
+    comp = swap_comp(comp);
+  }
+
+  const bool is_range = comp == CompOp::LESS_THAN || comp == CompOp::LESS_EQUAL || comp == CompOp::GREAT_THAN ||
+                        comp == CompOp::GREAT_EQUAL;
+  if (left->type() != ExprType::FIELD || right->type() != ExprType::VALUE) {
+    if (comp == CompOp::EQUAL_TO) {
+      return DEFAULT_EQUAL;
+    }
+    return is_range ? DEFAULT_RANGE : DEFAULT_OTHER;
+  }
+
+  shared_ptr<const ColumnStatistics> column = Selectivity::column(static_cast<FieldExpr *>(left)->field());
+  const Value                       &value  = static_cast<ValueExpr *>(right)->get_value();
+  if (column == nullptr) {
+    switch (comp) {
+      case CompOp::EQUAL_TO: return DEFAULT_EQUAL;
+      case CompOp::NOT_EQUAL: return 1 - DEFAULT_EQUAL;
+      default: return is_range ? DEFAULT_RANGE : DEFAULT_OTHER;
+    }
+  }
+
+  switch (comp) {
+    case CompOp::EQUAL_TO: return column->equal_selectivity(value);
+    case CompOp::NOT_EQUAL: {
+      if (value.is_null()) {
+        return 0;
+      }
+      return clamp_selectivity(1 - column->null_fraction() - column->equal_selectivity(value));
+    }
+    case CompOp::LESS_THAN: return column->less_selectivity(value, false);
+    case CompOp::LESS_EQUAL: return column->less_selectivity(value, true);
+    case CompOp::GREAT_THAN: return column->greater_selectivity(value, false);
+    case CompOp::GREAT_EQUAL: return column->greater_selectivity(value, true);
+    case CompOp::CompOp_IS: {
+      return value.is_null() ? column->null_fraction() : DEFAULT_OTHER;
+    }
+    case CompOp::CompOp_IS_NOT: {
+      return value.is_null() ? 1 - column->null_fraction() : DEFAULT_OTHER;
+    }
+    default: return DEFAULT_OTHER;
+  }
+}
+
+double Selectivity::estimate_join(Expression &expr, double left_card, double right_card)
+{
+  if (expr.type() == ExprType::CONJUNCTION) {
+    auto &conjunction = static_cast<ConjunctionExpr &>(expr);
+    if (conjunction.conjunction_type() == ConjunctionExpr::Type::AND) {
+      double selectivity = 1.0;
+      for (unique_ptr<Expression> &child : conjunction.children()) {
+        selectivity *= estimate_join(*child, left_card, right_card);
+      }
+      return selectivity;
+    }
+  }
+
+  if (expr.type() != ExprType::COMPARISON) {
+    return estimate(expr);
+  }
+  auto &comparison = static_cast<ComparisonExpr &>(expr);
+  if (comparison.left()->type() != ExprType::FIELD || comparison.right()->type() != ExprType::FIELD) {
+    return estimate(expr);
+  }
+  if (comparison.comp() != CompOp::EQUAL_TO) {
+    return DEFAULT_RANGE;
+  }
+
+  // 两边的值都均匀分布，值比较少的一边的每个值都能在另一边找到
+  shared_ptr<const ColumnStatistics> left_column  = column(static_cast<FieldExpr &>(*comparison.left()).field());
+  shared_ptr<const ColumnStatistics> right_column = column(static_cast<FieldExpr &>(*comparison.right()).field());
+  const double                       left_ndv     = left_column != nullptr ? left_column->ndv() : left_card;
+  const double                       right_ndv    = right_column != nullptr ? right_column->ndv() : right_card;
+  double                             selectivity  = 1.0 / max(max(left_ndv, right_ndv), 1.0);
+  if (left_column != nullptr) {
+    selectivity *= 1 - left_column->null_fraction();
+  }
+  if (right_column != nullptr) {
+    selectivity *= 1 - right_column->null_fraction();
+  }
+  return selectivity;
+}
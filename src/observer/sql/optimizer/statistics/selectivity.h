@@ -0,0 +1,56 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+
+class ColumnStatistics;
+class ComparisonExpr;
+class Expression;
+class Field;
+class Table;
+
+/**
+ * @brief 按照统计信息估计条件的选择率
+ * @ingroup Statistics
+ * @details 没有统计信息时使用固定的默认值。多个条件之间按照相互独立估计
+ */
+class Selectivity
+{
+public:
+  /// 没有统计信息时等值条件的选择率
+  static constexpr double DEFAULT_EQUAL = 0.005;
+  /// 没有统计信息时范围条件的选择率
+  static constexpr double DEFAULT_RANGE = 1.0 / 3;
+  /// 无法估计的条件的选择率
+  static constexpr double DEFAULT_OTHER = 0.5;
+
+  /**
+   * @brief 估计过滤条件的选择率
+   * @details 支持 AND、OR，以及字段与常量的比较和 IS [NOT] NULL
+   */
+  static double estimate(Expression &expr);
+
+  /**
+   * @brief 估计连接条件的选择率
+   * @details 字段之间的等值条件按照 1 / max(NDV) 估计，没有统计信息时使用两边的行数代替 NDV
+   */
+  static double estimate_join(Expression &expr, double left_card, double right_card);
+
+  /// 估计的表的行数，没有执行过 ANALYZE TABLE 时使用 Catalog 中的行数
+  static double table_rows(const Table *table);
+
+  /// 字段的统计信息，没有时返回 nullptr。返回值持有所属的表统计信息，使用期间不会被 ANALYZE TABLE 释放
+  static shared_ptr<const ColumnStatistics> column(const Field &field);
+
+private:
+  static double estimate_comparison(ComparisonExpr &expr);
+};
@@ -0,0 +1,127 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/statistics/table_statistics.h"
+#include "common/lang/memory.h"
+#include "common/log/log.h"
+#include "sql/expr/tuple.h"
+#include "storage/record/record_scanner.h"
+#include "storage/table/table.h"
+
+#include "json/json.h"
+
+const static Json::StaticString FIELD_ROW_NUM("row_num");
+const static Json::StaticString FIELD_SAMPLED_ROWS("sampled_rows");
+const static Json::StaticString FIELD_COLUMNS("columns");
+
+const ColumnStatistics *TableStatistics::column(const char *name) const
+{
+  for (const ColumnStatistics &column : columns_) {
+    if (column.name() == name) {
+      return &column;
+    }
+  }
+  return nullptr;
+}
+
+void TableStatistics::to_json(Json::Value &json_value) const
+{
+  json_value[FIELD_ROW_NUM]      = row_num_;
+  json_value[FIELD_SAMPLED_ROWS] = static_cast<Json::Int64>(sampled_rows_);
+
+  Json::Value columns_value(Json::arrayValue);
+  for (const ColumnStatistics &column : columns_) {
+    Json::Value column_value;
+    column.to_json(column_value);
+    columns_value.append(std::move(column_value));
+  }
+  json_value[FIELD_COLUMNS] = std::move(columns_value);
+}
+
+RC TableStatistics::from_json(const Json::Value &json_value, TableStatistics &statistics)
+{
+  const Json::Value &row_num_value      = json_value[FIELD_ROW_NUM];
+  const Json::Value &sampled_rows_value = json_value[FIELD_SAMPLED_ROWS];
+  const Json::Value &columns_value      = json_value[FIELD_COLUMNS];
+  if (!row_num_value.isNumeric() || !sampled_rows_value.isIntegral() || !columns_value.isArray()) {
+    LOG_ERROR("Invalid table statistics. json value=%s", json_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  statistics.row_num_      = row_num_value.asDouble();
+  statistics.sampled_rows_ = sampled_rows_value.asInt64();
+  statistics.columns_.clear();
+  statistics.columns_.resize(columns_value.size());
+
+  RC rc = RC::SUCCESS;
+  for (Json::ArrayIndex i = 0; i < columns_value.size(); i++) {
+    if (OB_FAIL(rc = ColumnStatistics::from_json(columns_value[i], statistics.columns_[i]))) {
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC TableStatistics::collect(Table *table, Trx *trx, int sample_pages, TableStatistics &statistics)
+{
+  RecordScanner *scanner         = nullptr;
+  double         sample_fraction = 1.0;
+  RC             rc              = table->get_sample_scanner(scanner, trx, sample_pages, sample_fraction);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create sample scanner. table=%s, rc=%s", table->name(), strrc(rc));
+    delete scanner;
+    return rc;
+  }
+  unique_ptr<RecordScanner> scanner_guard(scanner);
+
+  // 系统字段不需要统计信息
+  const TableMeta                &table_meta = table->table_meta();
+  const vector<FieldMeta>        *fields     = table_meta.field_metas();
+  const int                       sys_num    = table_meta.sys_field_num();
+  vector<ColumnStatisticsBuilder> builders;
+  for (int i = sys_num; i < static_cast<int>(fields->size()); i++) {
+    builders.emplace_back((*fields)[i].name(), (*fields)[i].type());
+  }
+
+  RowTuple tuple;
+  tuple.set_schema(table, fields);
+  Record  record;
+  Value   value;
+  int64_t sampled_rows = 0;
+  while (OB_SUCC(rc = scanner->next(record))) {
+    tuple.set_record(&record);
+    for (size_t i = 0; i < builders.size(); i++) {
+      if (OB_FAIL(rc = tuple.cell_at(sys_num + static_cast<int>(i), value))) {
+        LOG_WARN("failed to get value of record. table=%s, rc=%s", table->name(), strrc(rc));
+        scanner->close_scan();
+        return rc;
+      }
+      builders[i].add(value);
+    }
+    sampled_rows++;
+  }
+  scanner->close_scan();
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan table. table=%s, rc=%s", table->name(), strrc(rc));
+    return rc;
+  }
+
+  statistics.sampled_rows_ = sampled_rows;
+  statistics.row_num_      = sample_fraction > 0 ? sampled_rows / sample_fraction : sampled_rows;
+  statistics.columns_.clear();
+  statistics.columns_.resize(builders.size());
+  for (size_t i = 0; i < builders.size(); i++) {
+    builders[i].build(statistics.row_num_, statistics.columns_[i]);
+  }
+
+  LOG_INFO("collected statistics of table %s. sampled rows=%ld, sample fraction=%.4f, estimated rows=%.0f",
+           table->name(), sampled_rows, sample_fraction, statistics.row_num_);
+  return RC::SUCCESS;
+}
@@ -10,5 +10,53 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/vector.h"
+#include "common/sys/rc.h"
+#include "sql/optimizer/statistics/column_statistics.h"
+
+class Table;
+class Trx;
+
+/**
+ * @defgroup Statistics
+ * @brief 优化器使用的统计信息
+ * @details ANALYZE TABLE 采样表中的一部分页面，计算每个字段的统计信息，保存在表的元数据中。
+ * 优化器按照统计信息估计条件的选择率和算子输出的行数，参考 Selectivity。
+ */
+
+/**
+ * @brief 一个表的统计信息
+ * @ingroup Statistics
+ */
 class TableStatistics
-{};
\ No newline at end of file
+{
+public:
+  /// 默认最多采样的页面个数
+  static constexpr int DEFAULT_SAMPLE_PAGES = 256;
+
+  TableStatistics() = default;
+
+  /// 估计的全表行数
+  double row_num() const { return row_num_; }
+  /// 实际采样的行数
+  int64_t sampled_rows() const { return sampled_rows_; }
+
+  const vector<ColumnStatistics> &columns() const { return columns_; }
+  /// 按照名字查找字段的统计信息，没有时返回 nullptr
+  const ColumnStatistics *column(const char *name) const;
+
+  void      to_json(Json::Value &json_value) const;
+  static RC from_json(const Json::Value &json_value, TableStatistics &statistics);
+
+  /**
+   * @brief 采样表中的数据，计算统计信息
+   * @details 页面比较少时读取全部数据，否则均匀地读取 sample_pages 个页面，按照读取的比例估计全表的行数
+   * @param sample_pages 最多采样的页面个数
+   */
+  static RC collect(Table *table, Trx *trx, int sample_pages, TableStatistics &statistics);
+
+private:
+  double                   row_num_      = 0;
+  int64_t                  sampled_rows_ = 0;
+  vector<ColumnStatistics> columns_;
+};
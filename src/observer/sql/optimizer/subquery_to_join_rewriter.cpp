@@ -0,0 +1,394 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/optimizer/subquery_to_join_rewriter.h"
+#include "common/log/log.h"
+#include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
+#include "sql/expr/sub_query_expr.h"
+#include "sql/operator/group_by_logical_operator.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/logical_operator.h"
+
+/**
+ * @brief 算子输出的是否是表中的行，子查询的输出表达式可以直接在这些行上计算
+ */
+static bool outputs_table_rows(LogicalOperator &oper)
+{
+  switch (oper.type()) {
+    case LogicalOperatorType::TABLE_GET: {
+      return true;
+    }
+    case LogicalOperatorType::PREDICATE:
+    case LogicalOperatorType::JOIN:
+    case LogicalOperatorType::ORDER_BY: {
+      for (unique_ptr<LogicalOperator> &child : oper.children()) {
+        if (!outputs_table_rows(*child)) {
+          return false;
+        }
+      }
+      return !oper.children().empty();
+    }
+    default: {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief 算子中是否有 LIMIT
+ */
+static bool has_limit(LogicalOperator &oper)
+{
+  if (oper.type() == LogicalOperatorType::LIMIT) {
+    return true;
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    if (has_limit(*child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 可以作为连接键的类型，与 hash join 的连接键相同
+ */
+static bool is_join_key_type(AttrType type)
+{
+  return type == AttrType::INTS || type == AttrType::FLOATS || type == AttrType::CHARS || type == AttrType::DATES;
+}
+
+/**
+ * @brief 表达式中是否引用了外层查询的字段
+ */
+static bool has_correlated_field(Expression &expr)
+{
+  if (expr.type() == ExprType::CORRELATED_FIELD) {
+    return true;
+  }
+  bool found = false;
+  ExpressionIterator::iterate_child_expr(expr, [&found](unique_ptr<Expression> &child) {
+    found = found || has_correlated_field(*child);
+    return RC::SUCCESS;
+  });
+  return found;
+}
+
+static bool has_correlated_field(LogicalOperator &oper)
+{
+  for (unique_ptr<Expression> &expr : oper.expressions()) {
+    if (has_correlated_field(*expr)) {
+      return true;
+    }
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    if (has_correlated_field(*child)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 是否是 `子查询的表达式 = 外层查询的字段` 形式的相关条件，可以作为连接条件或者分组的值
+ * @param[out] outer 外层查询的字段在比较中的位置
+ */
+static bool is_correlation(Expression &expr, int &outer)
+{
+  if (expr.type() != ExprType::COMPARISON || static_cast<ComparisonExpr &>(expr).comp() != EQUAL_TO) {
+    return false;
+  }
+  auto &cmp_expr = static_cast<ComparisonExpr &>(expr);
+  outer          = cmp_expr.left()->type() == ExprType::CORRELATED_FIELD ? 0 : 1;
+  Expression &outer_expr = outer == 0 ? *cmp_expr.left() : *cmp_expr.right();
+  Expression &inner_expr = outer == 0 ? *cmp_expr.right() : *cmp_expr.left();
+  return outer_expr.type() == ExprType::CORRELATED_FIELD && !has_correlated_field(inner_expr) &&
+         inner_expr.value_type() == outer_expr.value_type() && is_join_key_type(inner_expr.value_type());
+}
+
+/**
+ * @brief 从子查询中取出相关条件
+ * @details 相关的字段只能出现在 oper 这个过滤算子的条件中，并且引用外层字段的条件都是 is_correlation 的形式。
+ * 取出的条件拆成外层查询的字段和子查询的表达式，过滤算子没有剩下的条件时直接去掉。
+ * 不相关的子查询不做修改，也返回 true
+ * @return 是否可以去相关，不能去相关时不修改子查询
+ */
+static bool extract_correlations(
+    unique_ptr<LogicalOperator> &oper, vector<unique_ptr<Expression>> &outer_keys, vector<unique_ptr<Expression>> &inner_keys)
+{
+  if (!has_correlated_field(*oper)) {
+    return true;
+  }
+  if (oper->type() != LogicalOperatorType::PREDICATE || oper->children().size() != 1 ||
+      oper->expressions().size() != 1 || has_correlated_field(*oper->children().front())) {
+    return false;
+  }
+
+  unique_ptr<Expression>          &predicate = oper->expressions().front();
+  vector<unique_ptr<Expression>> *conditions = nullptr;
+  vector<unique_ptr<Expression>>  single_condition;
+  if (predicate->type() == ExprType::CONJUNCTION &&
+      static_cast<ConjunctionExpr &>(*predicate).conjunction_type() == ConjunctionExpr::Type::AND) {
+    conditions = &static_cast<ConjunctionExpr &>(*predicate).children();
+  } else {
+    conditions = &single_condition;
+  }
+
+  // 先检查所有的条件，确定可以去相关之后再修改
+  int outer = 0;
+  for (unique_ptr<Expression> &cond : conditions == &single_condition ? oper->expressions() : *conditions) {
+    if (has_correlated_field(*cond) && !is_correlation(*cond, outer)) {
+      return false;
+    }
+  }
+
+  if (conditions == &single_condition) {
+    single_condition.emplace_back(std::move(predicate));
+  }
+  for (auto iter = conditions->begin(); iter != conditions->end();) {
+    if (!has_correlated_field(**iter)) {
+      ++iter;
+      continue;
+    }
+    is_correlation(**iter, outer);
+    auto &cmp_expr = static_cast<ComparisonExpr &>(**iter);
+    auto &corr     = static_cast<CorrelatedFieldExpr &>(outer == 0 ? *cmp_expr.left() : *cmp_expr.right());
+    outer_keys.emplace_back(make_unique<FieldExpr>(corr.field()));
+    inner_keys.emplace_back(std::move(outer == 0 ? cmp_expr.right() : cmp_expr.left()));
+    iter = conditions->erase(iter);
+  }
+
+  if (conditions->empty()) {
+    oper = std::move(oper->children().front());
+  } else if (conditions == &single_condition) {
+    predicate = std::move(single_condition.front());
+  }
+  return true;
+}
+
+RC SubqueryToJoinRewriter::rewrite(unique_ptr<LogicalOperator> &oper, bool &change_made)
+{
+  if (oper->type() != LogicalOperatorType::PREDICATE || oper->children().size() != 1 ||
+      oper->expressions().size() != 1) {
+    return RC::SUCCESS;
+  }
+
+  unique_ptr<Expression>             &predicate = oper->expressions().front();
+  vector<unique_ptr<LogicalOperator>> joins;
+  bool                                predicate_empty = false;
+  if (predicate->type() == ExprType::COMPARISON) {
+    unique_ptr<LogicalOperator> join;
+    if (create_join(predicate, join)) {
+      joins.emplace_back(std::move(join));
+      predicate_empty = true;
+    }
+  } else if (predicate->type() == ExprType::CONJUNCTION &&
+             static_cast<ConjunctionExpr &>(*predicate).conjunction_type() == ConjunctionExpr::Type::AND) {
+    vector<unique_ptr<Expression>> &conditions = static_cast<ConjunctionExpr &>(*predicate).children();
+    for (auto iter = conditions.begin(); iter != conditions.end();) {
+      unique_ptr<LogicalOperator> join;
+      if (create_join(*iter, join)) {
+        joins.emplace_back(std::move(join));
+        iter = conditions.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    predicate_empty = conditions.empty();
+  }
+
+  // 剩下的条件中的标量子查询
+  if (!predicate_empty && decorrelate_scalar(*predicate)) {
+    change_made = true;
+  }
+
+  if (joins.empty()) {
+    return RC::SUCCESS;
+  }
+
+  // 其它条件留在连接算子下面，还可以继续下推到表扫描中。过滤算子没有条件时直接去掉
+  unique_ptr<LogicalOperator> left = predicate_empty ? std::move(oper->children().front()) : std::move(oper);
+  for (unique_ptr<LogicalOperator> &join : joins) {
+    join->children().insert(join->children().begin(), std::move(left));
+    left = std::move(join);
+  }
+  oper        = std::move(left);
+  change_made = true;
+  return RC::SUCCESS;
+}
+
+bool SubqueryToJoinRewriter::create_join(unique_ptr<Expression> &cond, unique_ptr<LogicalOperator> &join)
+{
+  if (cond->type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto &cmp_expr = static_cast<ComparisonExpr &>(*cond);
+  if (cmp_expr.right()->type() != ExprType::SUB_QUERY) {
+    return false;
+  }
+
+  JoinType join_type = JoinType::INNER;
+  bool     has_key   = false;
+  switch (cmp_expr.comp()) {
+    case CompOp_IN: {
+      join_type = JoinType::SEMI;
+      has_key   = true;
+    } break;
+    case CompOp_NOT_IN: {
+      join_type = JoinType::NULL_AWARE_ANTI;
+      has_key   = true;
+    } break;
+    case CompOp_EXISTS: {
+      join_type = JoinType::SEMI;
+    } break;
+    case CompOp_NOT_EXISTS: {
+      join_type = JoinType::ANTI;
+    } break;
+    default: {
+      return false;
+    }
+  }
+
+  unique_ptr<LogicalOperator> &sub_plan = static_cast<SubQueryExpr &>(*cmp_expr.right()).logical_plan();
+  if (sub_plan == nullptr || sub_plan->type() != LogicalOperatorType::PROJECTION ||
+      sub_plan->children().size() != 1) {
+    return false;
+  }
+
+  // 带 LIMIT 的子查询只取部分行，改写成连接后 LIMIT 不再作用在子查询的结果上，不改写
+  unique_ptr<LogicalOperator> &sub_child = sub_plan->children().front();
+  if (has_limit(*sub_child)) {
+    return false;
+  }
+
+  // 相关的 NOT IN 在每个分组内都要按照 NULL 的语义处理，不改写
+  const bool correlated = has_correlated_field(*sub_plan);
+  if (correlated && join_type == JoinType::NULL_AWARE_ANTI) {
+    return false;
+  }
+
+  vector<unique_ptr<Expression>> &outputs = sub_plan->expressions();
+  unique_ptr<Expression>         &left    = cmp_expr.left();
+  if (has_key) {
+    // 子查询的输出表达式放到连接条件中，在子查询的投影算子下面的行上计算
+    if (outputs.size() != 1 || !outputs_table_rows(*sub_child) || has_correlated_field(*outputs.front()) ||
+        (left->type() != ExprType::FIELD && left->type() != ExprType::VALUE && left->type() != ExprType::CAST) ||
+        left->value_type() != outputs.front()->value_type() || !is_join_key_type(left->value_type())) {
+      return false;
+    }
+  } else if (correlated) {
+    for (unique_ptr<Expression> &output : outputs) {
+      if (has_correlated_field(*output)) {
+        return false;
+      }
+    }
+  }
+
+  // 相关条件变成连接条件，左边是外层查询的字段
+  vector<unique_ptr<Expression>> outer_keys;
+  vector<unique_ptr<Expression>> inner_keys;
+  if (!extract_correlations(sub_child, outer_keys, inner_keys)) {
+    return false;
+  }
+
+  auto join_oper = make_unique<JoinLogicalOperator>(join_type);
+  if (has_key) {
+    join_oper->add_join_predicate(make_unique<ComparisonExpr>(EQUAL_TO, std::move(left), std::move(outputs.front())));
+  }
+  for (size_t i = 0; i < outer_keys.size(); i++) {
+    join_oper->add_join_predicate(
+        make_unique<ComparisonExpr>(EQUAL_TO, std::move(outer_keys[i]), std::move(inner_keys[i])));
+  }
+  join_oper->add_child(std::move(sub_child));
+  join = std::move(join_oper);
+
+  LOG_TRACE("rewrite %s sub query to %s join", correlated ? "correlated" : "uncorrelated", join_type_to_string(join_type));
+  cond.reset();
+  return true;
+}
+
+bool SubqueryToJoinRewriter::decorrelate_scalar(Expression &expr)
+{
+  bool changed = false;
+  if (expr.type() == ExprType::COMPARISON) {
+    auto &cmp_expr = static_cast<ComparisonExpr &>(expr);
+    switch (cmp_expr.comp()) {
+      case EQUAL_TO:
+      case LESS_EQUAL:
+      case NOT_EQUAL:
+      case LESS_THAN:
+      case GREAT_EQUAL:
+      case GREAT_THAN: {
+        for (unique_ptr<Expression> *side : {&cmp_expr.left(), &cmp_expr.right()}) {
+          if ((*side)->type() == ExprType::SUB_QUERY && decorrelate_scalar(static_cast<SubQueryExpr &>(**side))) {
+            changed = true;
+          }
+        }
+      } break;
+      default: break;
+    }
+    return changed;
+  }
+
+  ExpressionIterator::iterate_child_expr(expr, [this, &changed](unique_ptr<Expression> &child) {
+    changed = decorrelate_scalar(*child) || changed;
+    return RC::SUCCESS;
+  });
+  return changed;
+}
+
+bool SubqueryToJoinRewriter::decorrelate_scalar(SubQueryExpr &sub_query)
+{
+  // 子查询是 `SELECT 聚合 FROM ... WHERE 相关条件 AND 其它条件`，没有 GROUP BY
+  unique_ptr<LogicalOperator> &sub_plan = sub_query.logical_plan();
+  if (sub_plan == nullptr || !sub_query.lookup_keys().empty() || !has_correlated_field(*sub_plan) ||
+      sub_plan->type() != LogicalOperatorType::PROJECTION || sub_plan->children().size() != 1 ||
+      sub_plan->expressions().size() != 1 || has_correlated_field(*sub_plan->expressions().front())) {
+    return false;
+  }
+
+  // 查找不到分组时结果是 NULL，只有没有输入时结果也是 NULL 的聚合才能改写。比如 COUNT 在没有输入时是 0
+  const Expression &output = *sub_plan->expressions().front();
+  if (output.type() != ExprType::AGGREGATION ||
+      static_cast<const AggregateExpr &>(output).aggregate_type() == AggregateExpr::Type::COUNT) {
+    return false;
+  }
+
+  LogicalOperator &group_by = *sub_plan->children().front();
+  if (group_by.type() != LogicalOperatorType::GROUP_BY || group_by.children().size() != 1) {
+    return false;
+  }
+  auto &group_by_oper = static_cast<GroupByLogicalOperator &>(group_by);
+  if (!group_by_oper.group_by_expressions().empty()) {
+    return false;
+  }
+
+  vector<unique_ptr<Expression>> outer_keys;
+  vector<unique_ptr<Expression>> inner_keys;
+  if (!extract_correlations(group_by_oper.children().front(), outer_keys, inner_keys) || outer_keys.empty()) {
+    return false;
+  }
+
+  // 按照相关条件中子查询的表达式分组，输出分组的值和原来的输出
+  vector<unique_ptr<Expression>> &outputs = sub_plan->expressions();
+  for (size_t i = 0; i < inner_keys.size(); i++) {
+    outputs.insert(outputs.begin() + i, inner_keys[i]->copy());
+  }
+  for (Expression *aggregate : group_by_oper.aggregate_expressions()) {
+    aggregate->set_pos(aggregate->pos() + static_cast<int>(inner_keys.size()));
+  }
+  group_by_oper.group_by_expressions() = std::move(inner_keys);
+  sub_query.set_lookup_keys(std::move(outer_keys));
+
+  LOG_TRACE("decorrelate scalar sub query into group by and lookup");
+  return true;
+}
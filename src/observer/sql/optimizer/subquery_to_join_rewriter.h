@@ -0,0 +1,51 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/optimizer/rewrite_rule.h"
+
+class SubQueryExpr;
+
+/**
+ * @brief 把 IN/EXISTS 子查询改写成 semi/anti join，把相关的标量子查询去相关
+ * @ingroup Rewriter
+ * @details 过滤条件中与其它条件 AND 连接的 `expr [NOT] IN (子查询)` 和 `[NOT] EXISTS (子查询)`，
+ * 改写成过滤算子与子查询之间的 semi/anti join（参考 JoinType），连接条件是 `expr = 子查询的输出`。
+ * 这样子查询的结果不需要先全部物化再逐行查找，可以使用连接算子的哈希表和向量化执行。
+ * 相关子查询中 `子查询的表达式 = 外层查询的字段` 形式的条件也取出来作为连接条件（相关的 NOT IN 除外）。
+ * 比较运算中的相关子查询是不带 GROUP BY 的聚合时，改成按照相关条件中子查询的表达式分组，只执行一次，
+ * 外层查询的每一行按照字段值查找对应的分组（参考 SubQueryExpr::set_lookup_keys）。
+ * 其它的子查询保留原来的条件，由 SubQueryExpr 计算，相关子查询按照参数缓存结果。
+ */
+class SubqueryToJoinRewriter : public RewriteRule
+{
+public:
+  SubqueryToJoinRewriter()          = default;
+  virtual ~SubqueryToJoinRewriter() = default;
+
+  RC rewrite(unique_ptr<LogicalOperator> &oper, bool &change_made) override;
+
+private:
+  /**
+   * @brief 把一个条件改写成 semi/anti join
+   * @param join 创建的连接算子，只有右孩子
+   * @return 是否改写，改写之后 cond 被取走
+   */
+  bool create_join(unique_ptr<Expression> &cond, unique_ptr<LogicalOperator> &join);
+
+  /**
+   * @brief 把表达式中比较运算的相关标量子查询去相关
+   * @details 只改写输出是 COUNT 以外的单个聚合的子查询，外层的行没有对应的分组时结果是 NULL
+   * @return 是否有子查询被改写
+   */
+  bool decorrelate_scalar(Expression &expr);
+  bool decorrelate_scalar(SubQueryExpr &sub_query);
+};
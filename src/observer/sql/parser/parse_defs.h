@@ -55,6 +55,8 @@ enum CompOp
   CompOp_IS_NOT,        ///< is not null
   CompOp_IN,            ///< IN
   CompOp_NOT_IN,        ///< NOT IN
+  CompOp_EXISTS,        ///< EXISTS，只有右边的子查询
+  CompOp_NOT_EXISTS,    ///< NOT EXISTS，只有右边的子查询
   NO_OP
   
 };
@@ -129,6 +131,7 @@ struct SelectSqlNode
   vector<ConditionSqlNode>       conditions;   ///< 查询条件，使用AND串联起来多个条件
   vector<unique_ptr<Expression>> group_by;     ///< group by clause
   vector<OrderSqlNode>           order_by;     ///< order by clause
+  int                            limit = -1;   ///< limit clause，-1 表示没有 limit
 };
 
 /**
@@ -225,14 +228,14 @@ struct AnalyzeTableSqlNode
  * @brief 描述一个create index语句
  * @ingroup SQLParser
  * @details 创建索引时，需要指定索引名，表名，字段名。
- * 正常的SQL语句中，一个索引可能包含了多个字段，这里仅支持一个字段。
+ * 一个索引可以包含多个字段，字段的顺序就是索引键值中的顺序。
  */
 struct CreateIndexSqlNode
 {
-  string index_name;      ///< Index name
-  string relation_name;   ///< Relation name
-  string attribute_name;  ///< Attribute name
-  bool   isUnique;        ///< Is unique index
+  string         index_name;       ///< Index name
+  string         relation_name;    ///< Relation name
+  vector<string> attribute_names;  ///< Attribute names
+  bool           isUnique;         ///< Is unique index
 };
 
 /**
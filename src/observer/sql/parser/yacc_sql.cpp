@@ -0,0 +1,3515 @@
+/* A Bison parser, made by GNU Bison 3.8.2.  */
+
+/* Bison implementation for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* C LALR(1) parser skeleton written by Richard Stallman, by
+   simplifying the original so-called "semantic" parser.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+/* All symbols defined below should begin with yy or YY, to avoid
+   infringing on user name space.  This should be done even for local
+   variables, as they might otherwise be expanded by user macros.
+   There are some unavoidable exceptions within include files to
+   define necessary library symbols; they are noted "INFRINGES ON
+   USER NAME SPACE" below.  */
+
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
+
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
+
+/* Skeleton name.  */
+#define YYSKELETON_NAME "yacc.c"
+
+/* Pure parsers.  */
+#define YYPURE 2
+
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
+
+
+
+/* First part of user prologue.  */
+#line 2 "yacc_sql.y"
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "common/log/log.h"
+#include "common/lang/string.h"
+#include "sql/parser/parse_defs.h"
+#include "sql/parser/yacc_sql.hpp"
+#include "sql/parser/lex_sql.h"
+#include "sql/expr/expression.h"
+
+using namespace std;
+
+string token_name(const char *sql_string, YYLTYPE *llocp)
+{
+  return string(sql_string + llocp->first_column, llocp->last_column - llocp->first_column + 1);
+}
+
+int yyerror(YYLTYPE *llocp, const char *sql_string, ParsedSqlResult *sql_result, yyscan_t scanner, const char *msg)
+{
+  unique_ptr<ParsedSqlNode> error_sql_node = make_unique<ParsedSqlNode>(SCF_ERROR);
+  error_sql_node->error.error_msg = msg;
+  error_sql_node->error.line = llocp->first_line;
+  error_sql_node->error.column = llocp->first_column;
+  sql_result->add_sql_node(std::move(error_sql_node));
+  return 0;
+}
+
+ArithmeticExpr *create_arithmetic_expression(ArithmeticExpr::Type type,
+                                             Expression *left,
+                                             Expression *right,
+                                             const char *sql_string,
+                                             YYLTYPE *llocp)
+{
+  ArithmeticExpr *expr = new ArithmeticExpr(type, left, right);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
+                                           Expression *child,
+                                           const char *sql_string,
+                                           YYLTYPE *llocp)
+{
+  UnboundAggregateExpr *expr = new UnboundAggregateExpr(aggregate_name, child);
+  expr->set_name(token_name(sql_string, llocp));
+  return expr;
+}
+
+
+#line 125 "yacc_sql.cpp"
+
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
+
+#include "yacc_sql.hpp"
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_SEMICOLON = 3,                  /* SEMICOLON  */
+  YYSYMBOL_BY = 4,                         /* BY  */
+  YYSYMBOL_CREATE = 5,                     /* CREATE  */
+  YYSYMBOL_DROP = 6,                       /* DROP  */
+  YYSYMBOL_GROUP = 7,                      /* GROUP  */
+  YYSYMBOL_TABLE = 8,                      /* TABLE  */
+  YYSYMBOL_TABLES = 9,                     /* TABLES  */
+  YYSYMBOL_INDEX = 10,                     /* INDEX  */
+  YYSYMBOL_CALC = 11,                      /* CALC  */
+  YYSYMBOL_SELECT = 12,                    /* SELECT  */
+  YYSYMBOL_ASC_T = 13,                     /* ASC_T  */
+  YYSYMBOL_DESC_T = 14,                    /* DESC_T  */
+  YYSYMBOL_ORDER = 15,                     /* ORDER  */
+  YYSYMBOL_LIMIT = 16,                     /* LIMIT  */
+  YYSYMBOL_SHOW = 17,                      /* SHOW  */
+  YYSYMBOL_SYNC = 18,                      /* SYNC  */
+  YYSYMBOL_INSERT = 19,                    /* INSERT  */
+  YYSYMBOL_DELETE = 20,                    /* DELETE  */
+  YYSYMBOL_UPDATE = 21,                    /* UPDATE  */
+  YYSYMBOL_UNIQUE = 22,                    /* UNIQUE  */
+  YYSYMBOL_LBRACE = 23,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 24,                    /* RBRACE  */
+  YYSYMBOL_COMMA = 25,                     /* COMMA  */
+  YYSYMBOL_TRX_BEGIN = 26,                 /* TRX_BEGIN  */
+  YYSYMBOL_TRX_COMMIT = 27,                /* TRX_COMMIT  */
+  YYSYMBOL_TRX_ROLLBACK = 28,              /* TRX_ROLLBACK  */
+  YYSYMBOL_INT_T = 29,                     /* INT_T  */
+  YYSYMBOL_DATE_T = 30,                    /* DATE_T  */
+  YYSYMBOL_STRING_T = 31,                  /* STRING_T  */
+  YYSYMBOL_TEXT_T = 32,                    /* TEXT_T  */
+  YYSYMBOL_FLOAT_T = 33,                   /* FLOAT_T  */
+  YYSYMBOL_VECTOR_T = 34,                  /* VECTOR_T  */
+  YYSYMBOL_IS = 35,                        /* IS  */
+  YYSYMBOL_NUL = 36,                       /* NUL  */
+  YYSYMBOL_NULLABLE = 37,                  /* NULLABLE  */
+  YYSYMBOL_NOT = 38,                       /* NOT  */
+  YYSYMBOL_HELP = 39,                      /* HELP  */
+  YYSYMBOL_EXIT = 40,                      /* EXIT  */
+  YYSYMBOL_DOT = 41,                       /* DOT  */
+  YYSYMBOL_INTO = 42,                      /* INTO  */
+  YYSYMBOL_IN = 43,                        /* IN  */
+  YYSYMBOL_EXISTS = 44,                    /* EXISTS  */
+  YYSYMBOL_VALUES = 45,                    /* VALUES  */
+  YYSYMBOL_FROM = 46,                      /* FROM  */
+  YYSYMBOL_WHERE = 47,                     /* WHERE  */
+  YYSYMBOL_AND = 48,                       /* AND  */
+  YYSYMBOL_SET = 49,                       /* SET  */
+  YYSYMBOL_ON = 50,                        /* ON  */
+  YYSYMBOL_LOAD = 51,                      /* LOAD  */
+  YYSYMBOL_DATA = 52,                      /* DATA  */
+  YYSYMBOL_INFILE = 53,                    /* INFILE  */
+  YYSYMBOL_EXPLAIN = 54,                   /* EXPLAIN  */
+  YYSYMBOL_STORAGE = 55,                   /* STORAGE  */
+  YYSYMBOL_FORMAT = 56,                    /* FORMAT  */
+  YYSYMBOL_PRIMARY = 57,                   /* PRIMARY  */
+  YYSYMBOL_KEY = 58,                       /* KEY  */
+  YYSYMBOL_ANALYZE = 59,                   /* ANALYZE  */
+  YYSYMBOL_FIELDS = 60,                    /* FIELDS  */
+  YYSYMBOL_TERMINATED = 61,                /* TERMINATED  */
+  YYSYMBOL_ENCLOSED = 62,                  /* ENCLOSED  */
+  YYSYMBOL_EQ = 63,                        /* EQ  */
+  YYSYMBOL_LT = 64,                        /* LT  */
+  YYSYMBOL_GT = 65,                        /* GT  */
+  YYSYMBOL_LE = 66,                        /* LE  */
+  YYSYMBOL_GE = 67,                        /* GE  */
+  YYSYMBOL_NE = 68,                        /* NE  */
+  YYSYMBOL_NUMBER = 69,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 70,                     /* FLOAT  */
+  YYSYMBOL_ID = 71,                        /* ID  */
+  YYSYMBOL_SSS = 72,                       /* SSS  */
+  YYSYMBOL_INNER_JOIN = 73,                /* INNER_JOIN  */
+  YYSYMBOL_74_ = 74,                       /* '+'  */
+  YYSYMBOL_75_ = 75,                       /* '-'  */
+  YYSYMBOL_76_ = 76,                       /* '*'  */
+  YYSYMBOL_77_ = 77,                       /* '/'  */
+  YYSYMBOL_UMINUS = 78,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 79,                  /* $accept  */
+  YYSYMBOL_commands = 80,                  /* commands  */
+  YYSYMBOL_command_wrapper = 81,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 82,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 83,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 84,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 85,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 86,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 87,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 88,           /* drop_table_stmt  */
+  YYSYMBOL_analyze_table_stmt = 89,        /* analyze_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 90,          /* show_tables_stmt  */
+  YYSYMBOL_desc_table_stmt = 91,           /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 92,         /* create_index_stmt  */
+  YYSYMBOL_drop_index_stmt = 93,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 94,         /* create_table_stmt  */
+  YYSYMBOL_attr_def_list = 95,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 96,                  /* attr_def  */
+  YYSYMBOL_number = 97,                    /* number  */
+  YYSYMBOL_type = 98,                      /* type  */
+  YYSYMBOL_primary_key = 99,               /* primary_key  */
+  YYSYMBOL_attr_list = 100,                /* attr_list  */
+  YYSYMBOL_insert_stmt = 101,              /* insert_stmt  */
+  YYSYMBOL_insert_tuple_list = 102,        /* insert_tuple_list  */
+  YYSYMBOL_insert_tuple = 103,             /* insert_tuple  */
+  YYSYMBOL_value_list = 104,               /* value_list  */
+  YYSYMBOL_value = 105,                    /* value  */
+  YYSYMBOL_storage_format = 106,           /* storage_format  */
+  YYSYMBOL_delete_stmt = 107,              /* delete_stmt  */
+  YYSYMBOL_update_stmt = 108,              /* update_stmt  */
+  YYSYMBOL_select_stmt = 109,              /* select_stmt  */
+  YYSYMBOL_calc_stmt = 110,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 111,          /* expression_list  */
+  YYSYMBOL_expression = 112,               /* expression  */
+  YYSYMBOL_aggregate_expression = 113,     /* aggregate_expression  */
+  YYSYMBOL_rel_attr = 114,                 /* rel_attr  */
+  YYSYMBOL_relation = 115,                 /* relation  */
+  YYSYMBOL_rel_list = 116,                 /* rel_list  */
+  YYSYMBOL_join_list = 117,                /* join_list  */
+  YYSYMBOL_where = 118,                    /* where  */
+  YYSYMBOL_condition_list = 119,           /* condition_list  */
+  YYSYMBOL_condition = 120,                /* condition  */
+  YYSYMBOL_comp_op = 121,                  /* comp_op  */
+  YYSYMBOL_order_by = 122,                 /* order_by  */
+  YYSYMBOL_order_list = 123,               /* order_list  */
+  YYSYMBOL_order_node = 124,               /* order_node  */
+  YYSYMBOL_order_type = 125,               /* order_type  */
+  YYSYMBOL_group_by = 126,                 /* group_by  */
+  YYSYMBOL_limit = 127,                    /* limit  */
+  YYSYMBOL_load_data_stmt = 128,           /* load_data_stmt  */
+  YYSYMBOL_fields_terminated_by = 129,     /* fields_terminated_by  */
+  YYSYMBOL_enclosed_by = 130,              /* enclosed_by  */
+  YYSYMBOL_explain_stmt = 131,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 132,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 133             /* opt_semicolon  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+
+#ifdef short
+# undef short
+#endif
+
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
+
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
+#else
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
+#else
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
+#endif
+
+#ifndef YYSIZE_T
+# ifdef __SIZE_TYPE__
+#  define YYSIZE_T __SIZE_TYPE__
+# elif defined size_t
+#  define YYSIZE_T size_t
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYSIZE_T size_t
+# else
+#  define YYSIZE_T unsigned
+# endif
+#endif
+
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_int16 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
+
+#ifndef YY_
+# if defined YYENABLE_NLS && YYENABLE_NLS
+#  if ENABLE_NLS
+#   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
+#  endif
+# endif
+# ifndef YY_
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
+# endif
+#endif
+
+/* Suppress unused-variable warnings by "using" E.  */
+#if ! defined lint || defined __GNUC__
+# define YY_USE(E) ((void) (E))
+#else
+# define YY_USE(E) /* empty */
+#endif
+
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
+#else
+# define YY_INITIAL_VALUE(Value) Value
+#endif
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
+
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
+
+# ifdef YYSTACK_USE_ALLOCA
+#  if YYSTACK_USE_ALLOCA
+#   ifdef __GNUC__
+#    define YYSTACK_ALLOC __builtin_alloca
+#   elif defined __BUILTIN_VA_ARG_INCR
+#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
+#   elif defined _AIX
+#    define YYSTACK_ALLOC __alloca
+#   elif defined _MSC_VER
+#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
+#    define alloca _alloca
+#   else
+#    define YYSTACK_ALLOC alloca
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
+#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
+#     endif
+#    endif
+#   endif
+#  endif
+# endif
+
+# ifdef YYSTACK_ALLOC
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+    /* The OS might guarantee only one guard page at the bottom of the stack,
+       and a page size can be as small as 4096 bytes.  So we cannot safely
+       invoke alloca (N) if N exceeds 4096.  Use a slightly smaller number
+       to allow for a few compiler-allocated temporary stack slots.  */
+#   define YYSTACK_ALLOC_MAXIMUM 4032 /* reasonable circa 2006 */
+#  endif
+# else
+#  define YYSTACK_ALLOC YYMALLOC
+#  define YYSTACK_FREE YYFREE
+#  ifndef YYSTACK_ALLOC_MAXIMUM
+#   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
+#  endif
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
+       && ! ((defined YYMALLOC || defined malloc) \
+             && (defined YYFREE || defined free)))
+#   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
+#   endif
+#  endif
+#  ifndef YYMALLOC
+#   define YYMALLOC malloc
+#   if ! defined malloc && ! defined EXIT_SUCCESS
+void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+#  ifndef YYFREE
+#   define YYFREE free
+#   if ! defined free && ! defined EXIT_SUCCESS
+void free (void *); /* INFRINGES ON USER NAME SPACE */
+#   endif
+#  endif
+# endif
+#endif /* 1 */
+
+#if (! defined yyoverflow \
+     && (! defined __cplusplus \
+         || (defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL \
+             && defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+
+/* A type that is properly aligned for any stack member.  */
+union yyalloc
+{
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+  YYLTYPE yyls_alloc;
+};
+
+/* The size of the maximum gap between one aligned stack and the next.  */
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
+
+/* The size of an array large to enough to hold all stacks, each with
+   N elements.  */
+# define YYSTACK_BYTES(N) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
+      + 2 * YYSTACK_GAP_MAXIMUM)
+
+# define YYCOPY_NEEDED 1
+
+/* Relocate STACK from its old location to the new one.  The
+   local variables YYSIZE and YYSTACKSIZE give the old and new number of
+   elements in the stack, and YYPTR gives the new location of the
+   stack.  Advance YYPTR to a properly aligned location for the next
+   stack.  */
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
+
+#endif
+
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
+/* YYFINAL -- State number of the termination state.  */
+#define YYFINAL  71
+/* YYLAST -- Last index in YYTABLE.  */
+#define YYLAST   289
+
+/* YYNTOKENS -- Number of terminals.  */
+#define YYNTOKENS  79
+/* YYNNTS -- Number of nonterminals.  */
+#define YYNNTS  55
+/* YYNRULES -- Number of rules.  */
+#define YYNRULES  143
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  277
+
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   329
+
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
+{
+       0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,    76,    74,     2,    75,     2,    77,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
+       2,     2,     2,     2,     2,     2,     1,     2,     3,     4,
+       5,     6,     7,     8,     9,    10,    11,    12,    13,    14,
+      15,    16,    17,    18,    19,    20,    21,    22,    23,    24,
+      25,    26,    27,    28,    29,    30,    31,    32,    33,    34,
+      35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
+      45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
+      55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    78
+};
+
+#if YYDEBUG
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
+{
+       0,   242,   242,   250,   251,   252,   253,   254,   255,   256,
+     257,   258,   259,   260,   261,   262,   263,   264,   265,   266,
+     267,   268,   269,   270,   274,   280,   285,   291,   297,   303,
+     309,   315,   322,   328,   335,   345,   358,   366,   387,   393,
+     402,   410,   418,   426,   434,   442,   452,   455,   456,   457,
+     458,   459,   460,   464,   467,   474,   478,   490,   512,   513,
+     529,   536,   542,   550,   554,   558,   563,   569,   572,   579,
+     590,   603,   650,   659,   664,   675,   678,   681,   684,   687,
+     691,   694,   697,   702,   708,   714,   717,   720,   726,   730,
+     738,   743,   747,   760,   763,   784,   787,   793,   796,   801,
+     808,   820,   832,   844,   855,   866,   877,   888,   900,   920,
+     940,   959,   978,   998,  1018,  1038,  1061,  1062,  1063,  1064,
+    1065,  1066,  1071,  1074,  1082,  1085,  1091,  1099,  1109,  1112,
+    1116,  1126,  1129,  1138,  1141,  1147,  1170,  1173,  1180,  1183,
+    1189,  1197,  1206,  1207
+};
+#endif
+
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
+/* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
+   First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
+static const char *const yytname[] =
+{
+  "\"end of file\"", "error", "\"invalid token\"", "SEMICOLON", "BY",
+  "CREATE", "DROP", "GROUP", "TABLE", "TABLES", "INDEX", "CALC", "SELECT",
+  "ASC_T", "DESC_T", "ORDER", "LIMIT", "SHOW", "SYNC", "INSERT", "DELETE",
+  "UPDATE", "UNIQUE", "LBRACE", "RBRACE", "COMMA", "TRX_BEGIN",
+  "TRX_COMMIT", "TRX_ROLLBACK", "INT_T", "DATE_T", "STRING_T", "TEXT_T",
+  "FLOAT_T", "VECTOR_T", "IS", "NUL", "NULLABLE", "NOT", "HELP", "EXIT",
+  "DOT", "INTO", "IN", "EXISTS", "VALUES", "FROM", "WHERE", "AND", "SET",
+  "ON", "LOAD", "DATA", "INFILE", "EXPLAIN", "STORAGE", "FORMAT",
+  "PRIMARY", "KEY", "ANALYZE", "FIELDS", "TERMINATED", "ENCLOSED", "EQ",
+  "LT", "GT", "LE", "GE", "NE", "NUMBER", "FLOAT", "ID", "SSS",
+  "INNER_JOIN", "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept",
+  "commands", "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt",
+  "begin_stmt", "commit_stmt", "rollback_stmt", "drop_table_stmt",
+  "analyze_table_stmt", "show_tables_stmt", "desc_table_stmt",
+  "create_index_stmt", "drop_index_stmt", "create_table_stmt",
+  "attr_def_list", "attr_def", "number", "type", "primary_key",
+  "attr_list", "insert_stmt", "insert_tuple_list", "insert_tuple",
+  "value_list", "value", "storage_format", "delete_stmt", "update_stmt",
+  "select_stmt", "calc_stmt", "expression_list", "expression",
+  "aggregate_expression", "rel_attr", "relation", "rel_list", "join_list",
+  "where", "condition_list", "condition", "comp_op", "order_by",
+  "order_list", "order_node", "order_type", "group_by", "limit",
+  "load_data_stmt", "fields_terminated_by", "enclosed_by", "explain_stmt",
+  "set_variable_stmt", "opt_semicolon", YY_NULLPTR
+};
+
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
+{
+  return yytname[yysymbol];
+}
+#endif
+
+#define YYPACT_NINF (-170)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-1)
+
+#define yytable_value_is_error(Yyn) \
+  0
+
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
+{
+      98,    11,     5,    -6,    -6,   -53,    14,  -170,   -10,    44,
+     -37,  -170,  -170,  -170,  -170,  -170,   -22,     0,    98,    92,
+     102,   108,  -170,  -170,  -170,  -170,  -170,  -170,  -170,  -170,
+    -170,  -170,  -170,  -170,  -170,  -170,  -170,  -170,  -170,  -170,
+    -170,  -170,  -170,    49,    50,   112,    52,    63,    -6,  -170,
+    -170,  -170,   -14,  -170,    -6,  -170,  -170,  -170,    56,  -170,
+    -170,    94,  -170,  -170,    68,    72,    95,    83,    97,  -170,
+      77,  -170,  -170,  -170,   128,   104,    85,  -170,   115,    17,
+     -16,    87,  -170,    -6,    -6,    -6,    -6,    -6,    88,   121,
+     122,   100,     3,    96,  -170,   139,   140,   123,   142,  -170,
+    -170,   188,    12,  -170,  -170,     6,     6,  -170,  -170,  -170,
+     189,   143,   192,    91,  -170,   154,  -170,   176,   153,   194,
+    -170,   197,   150,  -170,  -170,  -170,    88,   151,   122,     3,
+     198,   212,   181,   203,   186,   135,   129,  -170,   180,     3,
+     221,  -170,  -170,  -170,  -170,  -170,  -170,   -12,   -43,   206,
+     160,   209,  -170,   183,   219,    71,  -170,   192,  -170,   211,
+     213,   212,    -7,  -170,  -170,  -170,  -170,  -170,  -170,   105,
+      10,   195,   214,   119,    91,   122,   168,   171,  -170,   207,
+     184,  -170,   190,   222,   220,   160,    91,   242,   241,  -170,
+       3,   198,   141,   212,   225,  -170,   215,   212,  -170,  -170,
+    -170,   216,   227,   212,   212,  -170,  -170,  -170,  -170,   193,
+    -170,   230,  -170,   232,   200,  -170,   160,  -170,   233,   143,
+     187,   255,   244,  -170,  -170,   109,   237,  -170,  -170,   238,
+    -170,   212,   239,   240,   204,   205,    61,   160,   208,  -170,
+    -170,  -170,    93,  -170,   243,    -6,   201,  -170,  -170,  -170,
+    -170,  -170,   245,  -170,  -170,   262,   268,  -170,  -170,   246,
+     249,   210,  -170,  -170,  -170,   187,  -170,  -170,  -170,   202,
+     217,  -170,  -170,  -170,  -170,  -170,  -170
+};
+
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_uint8 yydefact[] =
+{
+       0,     0,     0,     0,     0,     0,     0,    26,     0,     0,
+       0,    27,    28,    29,    25,    24,     0,     0,     0,     0,
+       0,   142,    23,    22,    15,    16,    17,    18,     9,    10,
+      11,    12,    13,    14,     8,     5,     7,     6,     4,     3,
+      19,    20,    21,     0,     0,     0,     0,     0,     0,    66,
+      63,    64,    88,    65,     0,    81,    82,    72,    73,    84,
+      83,     0,    33,    32,     0,     0,     0,     0,     0,   140,
+       0,     1,   143,     2,     0,     0,     0,    30,     0,     0,
+       0,     0,    80,     0,     0,     0,     0,     0,     0,     0,
+      95,     0,     0,     0,    31,     0,     0,     0,     0,    79,
+      85,     0,     0,    89,    74,    75,    76,    77,    78,    90,
+      91,    93,     0,    97,    69,     0,   141,     0,     0,    53,
+      38,     0,     0,    36,    87,    86,     0,     0,    95,     0,
+      58,     0,     0,     0,    88,     0,     0,    96,    98,     0,
+       0,    47,    48,    49,    50,    51,    52,    41,     0,     0,
+       0,     0,    92,     0,   122,     0,    61,     0,    57,     0,
+       0,     0,     0,   116,   117,   118,   119,   120,   121,     0,
+       0,     0,     0,     0,    97,    95,     0,     0,    45,     0,
+       0,    39,    67,    55,     0,     0,    97,     0,   131,    60,
+       0,    58,     0,     0,     0,   105,     0,     0,   101,   107,
+     103,     0,     0,     0,     0,   100,   102,    99,    70,   136,
+      46,     0,    44,     0,     0,    37,     0,    34,     0,    93,
+     124,     0,   133,    62,    59,     0,     0,   110,   106,     0,
+     104,     0,     0,     0,     0,   138,    40,     0,     0,    56,
+      35,    94,   128,   123,   125,     0,     0,    71,   115,   114,
+     111,   113,     0,   108,   112,     0,     0,   135,    43,     0,
+       0,     0,   129,   130,   127,   124,   132,   134,   109,     0,
+       0,    42,    54,    68,   126,   137,   139
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -170,  -170,   257,  -170,  -170,  -170,  -170,  -170,  -170,  -170,
+    -170,  -170,  -170,  -170,  -170,  -170,  -170,   130,  -170,  -170,
+    -170,  -169,  -170,    86,   126,  -170,   -89,  -170,  -170,  -170,
+    -126,  -170,    -4,   -42,  -170,  -112,  -170,   158,    57,  -124,
+    -164,  -170,  -134,  -170,    15,  -170,  -170,  -170,  -170,  -170,
+    -170,  -170,  -170,  -170,  -170
+};
+
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_int16 yydefgoto[] =
+{
+       0,    20,    21,    22,    23,    24,    25,    26,    27,    28,
+      29,    30,    31,    32,    33,    34,   119,   120,   211,   147,
+     149,   184,    35,   158,   130,   155,    56,   215,    36,    37,
+      38,    39,    57,    58,    59,    60,   110,   111,   128,   114,
+     137,   138,   169,   188,   243,   244,   264,   222,   247,    40,
+     235,   257,    41,    42,    73
+};
+
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
+{
+      61,   136,   173,   116,   154,   159,    79,    48,   100,    80,
+     207,   177,    82,    46,   180,    47,   218,    48,    62,    43,
+      49,    44,   219,    63,   135,   178,   179,    81,   118,   195,
+      49,   196,    64,    45,    66,   194,   125,    83,   102,    49,
+     156,    99,   105,   106,   107,   108,   200,   239,   201,    67,
+     175,   208,    68,    50,    51,    52,    53,   199,   225,    54,
+      55,   206,   136,    50,    51,    52,    53,   226,   260,    54,
+      55,   229,    50,    51,   136,    53,   101,   232,   233,   104,
+     198,    83,    86,    87,   205,   135,    84,    85,    86,    87,
+      65,    84,    85,    86,    87,   189,   190,   135,   258,   259,
+      70,   223,    71,     1,     2,   252,   262,   263,   242,     3,
+       4,    72,     5,   249,   131,     6,     7,     8,     9,    10,
+      74,    75,    76,    77,    11,    12,    13,    49,   197,   132,
+      84,    85,    86,    87,    78,   133,   248,    14,    15,    89,
+      88,    49,   204,    90,    91,    49,    92,    16,    94,    17,
+      93,    95,    18,   242,    96,    49,    97,    19,   103,   109,
+      50,    51,   134,    53,   170,    98,   112,   171,   117,   113,
+     162,   115,   172,   122,    50,    51,   134,    53,    50,    51,
+     134,    53,   141,   142,   143,   144,   145,   146,    50,    51,
+     134,    53,   163,   164,   165,   166,   167,   168,   163,   164,
+     165,   166,   167,   168,   163,   164,   165,   166,   167,   168,
+     118,   121,   124,   123,   126,   129,   127,   139,   140,   148,
+     150,   151,   153,   157,     4,   160,   161,    81,   174,   176,
+     182,   183,   185,   186,   187,   192,   193,   203,   202,   209,
+     210,   266,   213,   212,   217,   214,   220,   216,   221,   227,
+     231,   228,   230,   234,   236,   237,   238,   240,   134,   245,
+     246,   250,   251,   253,   254,   255,   269,   256,   265,   268,
+     267,   261,   270,   272,   275,    69,   241,   224,   181,     0,
+     274,   273,   271,   191,   152,     0,     0,     0,     0,   276
+};
+
+static const yytype_int16 yycheck[] =
+{
+       4,   113,   136,    92,   128,   131,    48,    23,    24,    23,
+     174,    23,    54,     8,    57,    10,   185,    23,    71,     8,
+      36,    10,   186,     9,   113,    37,    38,    41,    71,    36,
+      36,    38,    42,    22,    71,   161,    24,    25,    80,    36,
+     129,    24,    84,    85,    86,    87,    36,   216,    38,    71,
+     139,   175,    52,    69,    70,    71,    72,   169,   192,    75,
+      76,   173,   174,    69,    70,    71,    72,   193,   237,    75,
+      76,   197,    69,    70,   186,    72,    80,   203,   204,    83,
+     169,    25,    76,    77,   173,   174,    74,    75,    76,    77,
+      46,    74,    75,    76,    77,    24,    25,   186,    37,    38,
+       8,   190,     0,     5,     6,   231,    13,    14,   220,    11,
+      12,     3,    14,   225,    23,    17,    18,    19,    20,    21,
+      71,    71,    10,    71,    26,    27,    28,    36,    23,    38,
+      74,    75,    76,    77,    71,    44,   225,    39,    40,    71,
+      46,    36,    23,    71,    49,    36,    63,    49,    71,    51,
+      53,    23,    54,   265,    50,    36,    71,    59,    71,    71,
+      69,    70,    71,    72,    35,    50,    45,    38,    72,    47,
+      35,    71,    43,    50,    69,    70,    71,    72,    69,    70,
+      71,    72,    29,    30,    31,    32,    33,    34,    69,    70,
+      71,    72,    63,    64,    65,    66,    67,    68,    63,    64,
+      65,    66,    67,    68,    63,    64,    65,    66,    67,    68,
+      71,    71,    24,    71,    25,    23,    73,    63,    42,    25,
+      23,    71,    71,    25,    12,    44,    23,    41,    48,     8,
+      24,    71,    23,    50,    15,    24,    23,    23,    43,    71,
+      69,   245,    58,    36,    24,    55,     4,    25,     7,    24,
+      23,    36,    36,    60,    24,    23,    56,    24,    71,     4,
+      16,    24,    24,    24,    24,    61,     4,    62,    25,    24,
+      69,    63,     4,    24,    72,    18,   219,   191,   148,    -1,
+     265,    71,    36,   157,   126,    -1,    -1,    -1,    -1,    72
+};
+
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_uint8 yystos[] =
+{
+       0,     5,     6,    11,    12,    14,    17,    18,    19,    20,
+      21,    26,    27,    28,    39,    40,    49,    51,    54,    59,
+      80,    81,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    93,    94,   101,   107,   108,   109,   110,
+     128,   131,   132,     8,    10,    22,     8,    10,    23,    36,
+      69,    70,    71,    72,    75,    76,   105,   111,   112,   113,
+     114,   111,    71,     9,    42,    46,    71,    71,    52,    81,
+       8,     0,     3,   133,    71,    71,    10,    71,    71,   112,
+      23,    41,   112,    25,    74,    75,    76,    77,    46,    71,
+      71,    49,    63,    53,    71,    23,    50,    71,    50,    24,
+      24,   111,   112,    71,   111,   112,   112,   112,   112,    71,
+     115,   116,    45,    47,   118,    71,   105,    72,    71,    95,
+      96,    71,    50,    71,    24,    24,    25,    73,   117,    23,
+     103,    23,    38,    44,    71,   105,   114,   119,   120,    63,
+      42,    29,    30,    31,    32,    33,    34,    98,    25,    99,
+      23,    71,   116,    71,   118,   104,   105,    25,   102,   109,
+      44,    23,    35,    63,    64,    65,    66,    67,    68,   121,
+      35,    38,    43,   121,    48,   105,     8,    23,    37,    38,
+      57,    96,    24,    71,   100,    23,    50,    15,   122,    24,
+      25,   103,    24,    23,   109,    36,    38,    23,   105,   114,
+      36,    38,    43,    23,    23,   105,   114,   119,   118,    71,
+      69,    97,    36,    58,    55,   106,    25,    24,   100,   119,
+       4,     7,   126,   105,   102,   121,   109,    24,    36,   109,
+      36,    23,   109,   109,    60,   129,    24,    23,    56,   100,
+      24,   117,   114,   123,   124,     4,    16,   127,   105,   114,
+      24,    24,   109,    24,    24,    61,    62,   130,    37,    38,
+     100,    63,    13,    14,   125,    25,   111,    69,    24,     4,
+       4,    36,    24,    71,   123,    72,    72
+};
+
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_uint8 yyr1[] =
+{
+       0,    79,    80,    81,    81,    81,    81,    81,    81,    81,
+      81,    81,    81,    81,    81,    81,    81,    81,    81,    81,
+      81,    81,    81,    81,    82,    83,    84,    85,    86,    87,
+      88,    89,    90,    91,    92,    92,    93,    94,    95,    95,
+      96,    96,    96,    96,    96,    96,    97,    98,    98,    98,
+      98,    98,    98,    99,    99,   100,   100,   101,   102,   102,
+     103,   104,   104,   105,   105,   105,   105,   106,   106,   107,
+     108,   109,   110,   111,   111,   112,   112,   112,   112,   112,
+     112,   112,   112,   112,   112,   113,   113,   113,   114,   114,
+     115,   116,   116,   117,   117,   118,   118,   119,   119,   119,
+     120,   120,   120,   120,   120,   120,   120,   120,   120,   120,
+     120,   120,   120,   120,   120,   120,   121,   121,   121,   121,
+     121,   121,   122,   122,   123,   123,   123,   124,   125,   125,
+     125,   126,   126,   127,   127,   128,   129,   129,   130,   130,
+     131,   132,   133,   133
+};
+
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
+{
+       0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       3,     3,     2,     2,     8,     9,     5,     8,     1,     3,
+       5,     2,     7,     6,     4,     3,     1,     1,     1,     1,
+       1,     1,     1,     0,     6,     1,     3,     6,     0,     3,
+       3,     1,     3,     1,     1,     1,     1,     0,     4,     4,
+       7,     9,     2,     1,     3,     3,     3,     3,     3,     3,
+       2,     1,     1,     1,     1,     3,     4,     4,     1,     3,
+       1,     1,     3,     0,     5,     0,     2,     0,     1,     3,
+       3,     3,     3,     3,     4,     3,     4,     3,     5,     6,
+       4,     5,     5,     5,     5,     5,     1,     1,     1,     1,
+       1,     1,     0,     3,     0,     1,     3,     2,     0,     1,
+       1,     0,     3,     0,     2,     9,     0,     4,     0,     3,
+       2,     4,     0,     1
+};
+
+
+enum { YYENOMEM = -2 };
+
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
+
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
+
+
+#define YYRECOVERING()  (!!yyerrstatus)
+
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, sql_string, sql_result, scanner, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
+
+/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
+   If N is 0, then set CURRENT to the empty location which ends
+   the previous symbol: RHS[0] (always defined).  */
+
+#ifndef YYLLOC_DEFAULT
+# define YYLLOC_DEFAULT(Current, Rhs, N)                                \
+    do                                                                  \
+      if (N)                                                            \
+        {                                                               \
+          (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;        \
+          (Current).first_column = YYRHSLOC (Rhs, 1).first_column;      \
+          (Current).last_line    = YYRHSLOC (Rhs, N).last_line;         \
+          (Current).last_column  = YYRHSLOC (Rhs, N).last_column;       \
+        }                                                               \
+      else                                                              \
+        {                                                               \
+          (Current).first_line   = (Current).last_line   =              \
+            YYRHSLOC (Rhs, 0).last_line;                                \
+          (Current).first_column = (Current).last_column =              \
+            YYRHSLOC (Rhs, 0).last_column;                              \
+        }                                                               \
+    while (0)
+#endif
+
+#define YYRHSLOC(Rhs, K) ((Rhs)[K])
+
+
+/* Enable debugging if requested.  */
+#if YYDEBUG
+
+# ifndef YYFPRINTF
+#  include <stdio.h> /* INFRINGES ON USER NAME SPACE */
+#  define YYFPRINTF fprintf
+# endif
+
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+/* YYLOCATION_PRINT -- Print the location on the stream.
+   This macro was not mandated originally: define only if we know
+   we won't break user code: when these are the locations we know.  */
+
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+
+/* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
+
+YY_ATTRIBUTE_UNUSED
+static int
+yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
+{
+  int res = 0;
+  int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
+  if (0 <= yylocp->first_line)
+    {
+      res += YYFPRINTF (yyo, "%d", yylocp->first_line);
+      if (0 <= yylocp->first_column)
+        res += YYFPRINTF (yyo, ".%d", yylocp->first_column);
+    }
+  if (0 <= yylocp->last_line)
+    {
+      if (yylocp->first_line < yylocp->last_line)
+        {
+          res += YYFPRINTF (yyo, "-%d", yylocp->last_line);
+          if (0 <= end_col)
+            res += YYFPRINTF (yyo, ".%d", end_col);
+        }
+      else if (0 <= end_col && yylocp->first_column < end_col)
+        res += YYFPRINTF (yyo, "-%d", end_col);
+    }
+  return res;
+}
+
+#   define YYLOCATION_PRINT  yy_location_print_
+
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
+
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
+
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, Location, sql_string, sql_result, scanner); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
+static void
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yyvaluep)
+    return;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
+
+static void
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
+
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, sql_string, sql_result, scanner);
+  YYFPRINTF (yyo, ")");
+}
+
+/*------------------------------------------------------------------.
+| yy_stack_print -- Print the state stack from its BOTTOM up to its |
+| TOP (included).                                                   |
+`------------------------------------------------------------------*/
+
+static void
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
+{
+  YYFPRINTF (stderr, "Stack now");
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
+  YYFPRINTF (stderr, "\n");
+}
+
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
+
+
+/*------------------------------------------------.
+| Report that the YYRULE is going to be reduced.  |
+`------------------------------------------------*/
+
+static void
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  int yylno = yyrline[yyrule];
+  int yynrhs = yyr2[yyrule];
+  int yyi;
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
+  /* The symbols being reduced.  */
+  for (yyi = 0; yyi < yynrhs; yyi++)
+    {
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), sql_string, sql_result, scanner);
+      YYFPRINTF (stderr, "\n");
+    }
+}
+
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, sql_string, sql_result, scanner); \
+} while (0)
+
+/* Nonzero means print parse trace.  It is left uninitialized so that
+   multiple parsers can coexist.  */
+int yydebug;
+#else /* !YYDEBUG */
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
+# define YY_STACK_PRINT(Bottom, Top)
+# define YY_REDUCE_PRINT(Rule)
+#endif /* !YYDEBUG */
+
+
+/* YYINITDEPTH -- initial size of the parser's stacks.  */
+#ifndef YYINITDEPTH
+# define YYINITDEPTH 200
+#endif
+
+/* YYMAXDEPTH -- maximum size the stacks can grow to (effective only
+   if the built-in stack extension method is used).
+
+   Do not make this value too large; the results are undefined if
+   YYSTACK_ALLOC_MAXIMUM < YYSTACK_BYTES (YYMAXDEPTH)
+   evaluated with infinite-precision integer arithmetic.  */
+
+#ifndef YYMAXDEPTH
+# define YYMAXDEPTH 10000
+#endif
+
+
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
+/* Return the length of YYSTR.  */
+static YYPTRDIFF_T
+yystrlen (const char *yystr)
+{
+  YYPTRDIFF_T yylen;
+  for (yylen = 0; yystr[yylen]; yylen++)
+    continue;
+  return yylen;
+}
+# endif
+#endif
+
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
+/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
+   YYDEST.  */
+static char *
+yystpcpy (char *yydest, const char *yysrc)
+{
+  char *yyd = yydest;
+  const char *yys = yysrc;
+
+  while ((*yyd++ = *yys++) != '\0')
+    continue;
+
+  return yyd - 1;
+}
+# endif
+#endif
+
+#ifndef yytnamerr
+/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
+   quotes and backslashes, so that it's suitable for yyerror.  The
+   heuristic is that double-quoting is unnecessary unless the string
+   contains an apostrophe, a comma, or backslash (other than
+   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
+   null, do not copy; instead, return the length of what the result
+   would have been.  */
+static YYPTRDIFF_T
+yytnamerr (char *yyres, const char *yystr)
+{
+  if (*yystr == '"')
+    {
+      YYPTRDIFF_T yyn = 0;
+      char const *yyp = yystr;
+      for (;;)
+        switch (*++yyp)
+          {
+          case '\'':
+          case ',':
+            goto do_not_strip_quotes;
+
+          case '\\':
+            if (*++yyp != '\\')
+              goto do_not_strip_quotes;
+            else
+              goto append;
+
+          append:
+          default:
+            if (yyres)
+              yyres[yyn] = *yyp;
+            yyn++;
+            break;
+
+          case '"':
+            if (yyres)
+              yyres[yyn] = '\0';
+            return yyn;
+          }
+    do_not_strip_quotes: ;
+    }
+
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
+    return yystrlen (yystr);
+}
+#endif
+
+
+static int
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  /* There are many possibilities here to consider:
+     - If this state is a consistent state with a default action, then
+       the only way this function was invoked is if the default action
+       is an error action.  In that case, don't check for expected
+       tokens because there are none.
+     - The only way there can be no lookahead present (in yychar) is if
+       this state is a consistent state with a default action.  Thus,
+       detecting the absence of a lookahead is sufficient to determine
+       that there is no unexpected or expected token to report.  In that
+       case, just report a simple "syntax error".
+     - Don't assume there isn't a lookahead just because this state is a
+       consistent state with a default action.  There might have been a
+       previous inconsistent state, consistent state with a non-default
+       action, or user semantic action that manipulated yychar.
+     - Of course, the expected token list depends on states to have
+       correct lookahead information, and it depends on the parser not
+       to perform extra reductions after fetching a lookahead from the
+       scanner and before detecting a syntax error.  Thus, state merging
+       (from LALR or IELR) and default reductions corrupt the expected
+       token list.  However, the list is correct for canonical LR with
+       one exception: it will still contain any token that will not be
+       accepted due to an error action in a later state.
+  */
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
+    {
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
+    }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
+
+  switch (yycount)
+    {
+#define YYCASE_(N, S)                       \
+      case N:                               \
+        yyformat = S;                       \
+        break
+    default: /* Avoid compiler warnings. */
+      YYCASE_(0, YY_("syntax error"));
+      YYCASE_(1, YY_("syntax error, unexpected %s"));
+      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
+      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
+      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
+      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
+#undef YYCASE_
+    }
+
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
+  {
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
+  }
+
+  if (*yymsg_alloc < yysize)
+    {
+      *yymsg_alloc = 2 * yysize;
+      if (! (yysize <= *yymsg_alloc
+             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
+        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
+      return -1;
+    }
+
+  /* Avoid sprintf, as that infringes on the user's name space.
+     Don't have undefined behavior even if the translation
+     produced a string with the wrong number of "%s"s.  */
+  {
+    char *yyp = *yymsg;
+    int yyi = 0;
+    while ((*yyp = *yyformat) != '\0')
+      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
+        {
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
+          yyformat += 2;
+        }
+      else
+        {
+          ++yyp;
+          ++yyformat;
+        }
+  }
+  return 0;
+}
+
+
+/*-----------------------------------------------.
+| Release the memory associated to this symbol.  |
+`-----------------------------------------------*/
+
+static void
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (sql_string);
+  YY_USE (sql_result);
+  YY_USE (scanner);
+  if (!yymsg)
+    yymsg = "Deleting";
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  switch (yykind)
+    {
+    case YYSYMBOL_attr_def_list: /* attr_def_list  */
+#line 164 "yacc_sql.y"
+            { delete ((*yyvaluep).attr_infos); }
+#line 1554 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_primary_key: /* primary_key  */
+#line 171 "yacc_sql.y"
+            { delete ((*yyvaluep).key_list); }
+#line 1560 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_attr_list: /* attr_list  */
+#line 171 "yacc_sql.y"
+            { delete ((*yyvaluep).key_list); }
+#line 1566 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_value_list: /* value_list  */
+#line 167 "yacc_sql.y"
+            { delete ((*yyvaluep).value_list); }
+#line 1572 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_value: /* value  */
+#line 162 "yacc_sql.y"
+            { delete ((*yyvaluep).value); }
+#line 1578 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_expression_list: /* expression_list  */
+#line 166 "yacc_sql.y"
+            { delete ((*yyvaluep).expression_list); }
+#line 1584 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_expression: /* expression  */
+#line 165 "yacc_sql.y"
+            { delete ((*yyvaluep).expression); }
+#line 1590 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_aggregate_expression: /* aggregate_expression  */
+#line 165 "yacc_sql.y"
+            { delete ((*yyvaluep).expression); }
+#line 1596 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_rel_attr: /* rel_attr  */
+#line 163 "yacc_sql.y"
+            { delete ((*yyvaluep).rel_attr); }
+#line 1602 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_rel_list: /* rel_list  */
+#line 170 "yacc_sql.y"
+            { delete ((*yyvaluep).relation_list); }
+#line 1608 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_where: /* where  */
+#line 168 "yacc_sql.y"
+            { delete ((*yyvaluep).condition_list); }
+#line 1614 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_condition_list: /* condition_list  */
+#line 168 "yacc_sql.y"
+            { delete ((*yyvaluep).condition_list); }
+#line 1620 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_condition: /* condition  */
+#line 161 "yacc_sql.y"
+            { delete ((*yyvaluep).condition); }
+#line 1626 "yacc_sql.cpp"
+        break;
+
+    case YYSYMBOL_group_by: /* group_by  */
+#line 166 "yacc_sql.y"
+            { delete ((*yyvaluep).expression_list); }
+#line 1632 "yacc_sql.cpp"
+        break;
+
+      default:
+        break;
+    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+}
+
+
+
+
+
+
+/*----------.
+| yyparse.  |
+`----------*/
+
+int
+yyparse (const char * sql_string, ParsedSqlResult * sql_result, void * scanner)
+{
+/* Lookahead token kind.  */
+int yychar;
+
+
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
+
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
+
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
+
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
+  /* The variables used to return semantic value and location from the
+     action routines.  */
+  YYSTYPE yyval;
+  YYLTYPE yyloc;
+
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+  /* Buffer for error messages, and its allocated size.  */
+  char yymsgbuf[128];
+  char *yymsg = yymsgbuf;
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
+
+  /* The number of symbols on the RHS of the reduced rule.
+     Keep to zero when no symbol should be popped.  */
+  int yylen = 0;
+
+  YYDPRINTF ((stderr, "Starting parse\n"));
+
+  yychar = YYEMPTY; /* Cause a token to be read.  */
+
+  yylsp[0] = yylloc;
+  goto yysetstate;
+
+
+/*------------------------------------------------------------.
+| yynewstate -- push a new state, which is found in yystate.  |
+`------------------------------------------------------------*/
+yynewstate:
+  /* In all cases, when you get here, the value and location stacks
+     have just been pushed.  So pushing a state here evens the stacks.  */
+  yyssp++;
+
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
+
+  if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
+    {
+      /* Get the current used size of the three stacks, in elements.  */
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
+
+# if defined yyoverflow
+      {
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+        YYLTYPE *yyls1 = yyls;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
+        yyls = yyls1;
+      }
+# else /* defined YYSTACK_RELOCATE */
+      /* Extend the stack our own way.  */
+      if (YYMAXDEPTH <= yystacksize)
+        YYNOMEM;
+      yystacksize *= 2;
+      if (YYMAXDEPTH < yystacksize)
+        yystacksize = YYMAXDEPTH;
+
+      {
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
+        YYSTACK_RELOCATE (yyls_alloc, yyls);
+#  undef YYSTACK_RELOCATE
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
+      }
+# endif
+
+      yyssp = yyss + yysize - 1;
+      yyvsp = yyvs + yysize - 1;
+      yylsp = yyls + yysize - 1;
+
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
+
+      if (yyss + yystacksize - 1 <= yyssp)
+        YYABORT;
+    }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
+
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
+
+  goto yybackup;
+
+
+/*-----------.
+| yybackup.  |
+`-----------*/
+yybackup:
+  /* Do appropriate processing given the current state.  Read a
+     lookahead token if we need one and don't already have one.  */
+
+  /* First try to decide what to do without reference to lookahead token.  */
+  yyn = yypact[yystate];
+  if (yypact_value_is_default (yyn))
+    goto yydefault;
+
+  /* Not known => get a lookahead token if don't already have one.  */
+
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == YYEMPTY)
+    {
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, &yylloc, scanner);
+    }
+
+  if (yychar <= YYEOF)
+    {
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
+      YYDPRINTF ((stderr, "Now at end of input.\n"));
+    }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
+  else
+    {
+      yytoken = YYTRANSLATE (yychar);
+      YY_SYMBOL_PRINT ("Next token is", yytoken, &yylval, &yylloc);
+    }
+
+  /* If the proper action on seeing token YYTOKEN is to reduce or to
+     detect an error, take that action.  */
+  yyn += yytoken;
+  if (yyn < 0 || YYLAST < yyn || yycheck[yyn] != yytoken)
+    goto yydefault;
+  yyn = yytable[yyn];
+  if (yyn <= 0)
+    {
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
+      yyn = -yyn;
+      goto yyreduce;
+    }
+
+  /* Count tokens shifted since error; after three, turn off error
+     status.  */
+  if (yyerrstatus)
+    yyerrstatus--;
+
+  /* Shift the lookahead token.  */
+  YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
+  yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+  *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
+  goto yynewstate;
+
+
+/*-----------------------------------------------------------.
+| yydefault -- do the default action for the current state.  |
+`-----------------------------------------------------------*/
+yydefault:
+  yyn = yydefact[yystate];
+  if (yyn == 0)
+    goto yyerrlab;
+  goto yyreduce;
+
+
+/*-----------------------------.
+| yyreduce -- do a reduction.  |
+`-----------------------------*/
+yyreduce:
+  /* yyn is the number of a rule to reduce with.  */
+  yylen = yyr2[yyn];
+
+  /* If YYLEN is nonzero, implement the default value of the action:
+     '$$ = $1'.
+
+     Otherwise, the following line sets YYVAL to garbage.
+     This behavior is undocumented and Bison
+     users should not rely upon it.  Assigning to YYVAL
+     unconditionally makes the parser a bit smaller, and it avoids a
+     GCC warning that YYVAL may be used uninitialized.  */
+  yyval = yyvsp[1-yylen];
+
+  /* Default location. */
+  YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
+  YY_REDUCE_PRINT (yyn);
+  switch (yyn)
+    {
+  case 2: /* commands: command_wrapper opt_semicolon  */
+#line 243 "yacc_sql.y"
+  {
+    unique_ptr<ParsedSqlNode> sql_node = unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
+    sql_result->add_sql_node(std::move(sql_node));
+  }
+#line 1941 "yacc_sql.cpp"
+    break;
+
+  case 24: /* exit_stmt: EXIT  */
+#line 274 "yacc_sql.y"
+         {
+      (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
+    }
+#line 1950 "yacc_sql.cpp"
+    break;
+
+  case 25: /* help_stmt: HELP  */
+#line 280 "yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
+    }
+#line 1958 "yacc_sql.cpp"
+    break;
+
+  case 26: /* sync_stmt: SYNC  */
+#line 285 "yacc_sql.y"
+         {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
+    }
+#line 1966 "yacc_sql.cpp"
+    break;
+
+  case 27: /* begin_stmt: TRX_BEGIN  */
+#line 291 "yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
+    }
+#line 1974 "yacc_sql.cpp"
+    break;
+
+  case 28: /* commit_stmt: TRX_COMMIT  */
+#line 297 "yacc_sql.y"
+               {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
+    }
+#line 1982 "yacc_sql.cpp"
+    break;
+
+  case 29: /* rollback_stmt: TRX_ROLLBACK  */
+#line 303 "yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
+    }
+#line 1990 "yacc_sql.cpp"
+    break;
+
+  case 30: /* drop_table_stmt: DROP TABLE ID  */
+#line 309 "yacc_sql.y"
+                  {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
+      (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 1999 "yacc_sql.cpp"
+    break;
+
+  case 31: /* analyze_table_stmt: ANALYZE TABLE ID  */
+#line 315 "yacc_sql.y"
+                     {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_ANALYZE_TABLE);
+      (yyval.sql_node)->analyze_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 2008 "yacc_sql.cpp"
+    break;
+
+  case 32: /* show_tables_stmt: SHOW TABLES  */
+#line 322 "yacc_sql.y"
+                {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
+    }
+#line 2016 "yacc_sql.cpp"
+    break;
+
+  case 33: /* desc_table_stmt: DESC_T ID  */
+#line 328 "yacc_sql.y"
+                {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
+      (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].cstring);
+    }
+#line 2025 "yacc_sql.cpp"
+    break;
+
+  case 34: /* create_index_stmt: CREATE INDEX ID ON ID LBRACE attr_list RBRACE  */
+#line 336 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+      CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+      create_index.index_name = (yyvsp[-5].cstring);
+      create_index.relation_name = (yyvsp[-3].cstring);
+      create_index.attribute_names.swap(*(yyvsp[-1].key_list));
+      delete (yyvsp[-1].key_list);
+      create_index.isUnique = false;
+    }
+#line 2039 "yacc_sql.cpp"
+    break;
+
+  case 35: /* create_index_stmt: CREATE UNIQUE INDEX ID ON ID LBRACE attr_list RBRACE  */
+#line 346 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
+      CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
+      create_index.index_name = (yyvsp[-5].cstring);
+      create_index.relation_name = (yyvsp[-3].cstring);
+      create_index.attribute_names.swap(*(yyvsp[-1].key_list));
+      delete (yyvsp[-1].key_list);
+      create_index.isUnique = true;
+    }
+#line 2053 "yacc_sql.cpp"
+    break;
+
+  case 36: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 359 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
+      (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].cstring);
+      (yyval.sql_node)->drop_index.relation_name = (yyvsp[0].cstring);
+    }
+#line 2063 "yacc_sql.cpp"
+    break;
+
+  case 37: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def_list primary_key RBRACE storage_format  */
+#line 367 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
+      CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
+      create_table.relation_name = (yyvsp[-5].cstring);
+      //free($3);
+
+      create_table.attr_infos.swap(*(yyvsp[-3].attr_infos));
+      delete (yyvsp[-3].attr_infos);
+
+      if ((yyvsp[-2].key_list) != nullptr) {
+        create_table.primary_keys.swap(*(yyvsp[-2].key_list));
+        delete (yyvsp[-2].key_list);
+      }
+      if ((yyvsp[0].cstring) != nullptr) {
+        create_table.storage_format = (yyvsp[0].cstring);
+      }
+    }
+#line 2085 "yacc_sql.cpp"
+    break;
+
+  case 38: /* attr_def_list: attr_def  */
+#line 388 "yacc_sql.y"
+    {
+      (yyval.attr_infos) = new vector<AttrInfoSqlNode>;
+      (yyval.attr_infos)->emplace_back(*(yyvsp[0].attr_info));
+      delete (yyvsp[0].attr_info);
+    }
+#line 2095 "yacc_sql.cpp"
+    break;
+
+  case 39: /* attr_def_list: attr_def_list COMMA attr_def  */
+#line 394 "yacc_sql.y"
+    {
+      (yyval.attr_infos) = (yyvsp[-2].attr_infos);
+      (yyval.attr_infos)->emplace_back(*(yyvsp[0].attr_info));
+      delete (yyvsp[0].attr_info);
+    }
+#line 2105 "yacc_sql.cpp"
+    break;
+
+  case 40: /* attr_def: ID type LBRACE number RBRACE  */
+#line 403 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[-3].number);
+      (yyval.attr_info)->name = (yyvsp[-4].cstring);
+      (yyval.attr_info)->length = (yyvsp[-1].number);
+      (yyval.attr_info)->nullable=false;
+    }
+#line 2117 "yacc_sql.cpp"
+    break;
+
+  case 41: /* attr_def: ID type  */
+#line 411 "yacc_sql.y"
+    {
+      (yyval.attr_info) = new AttrInfoSqlNode;
+      (yyval.attr_info)->type = (AttrType)(yyvsp[0].number);
+      (yyval.attr_info)->name = (yyvsp[-1].cstring);
+      (yyval.attr_info)->length = 4;
+      (yyval.attr_info)->nullable=false;
+    }
+#line 2129 "yacc_sql.cpp"
+    break;
+
+  case 42: /* attr_def: ID type LBRACE number RBRACE NOT NUL  */
+#line 419 "yacc_sql.y"
+    {
+      (yyval.attr_info)=new AttrInfoSqlNode;
+      (yyval.attr_info)->type=(AttrType)(yyvsp[-5].number);
+      (yyval.attr_info)->name = (yyvsp[-6].cstring);
+      (yyval.attr_info)->length = (yyvsp[-3].number);
+      (yyval.attr_info)->nullable=false;
+    }
+#line 2141 "yacc_sql.cpp"
+    break;
+
+  case 43: /* attr_def: ID type LBRACE number RBRACE NULLABLE  */
+#line 427 "yacc_sql.y"
+    {
+      (yyval.attr_info)=new AttrInfoSqlNode;
+      (yyval.attr_info)->type=(AttrType)(yyvsp[-4].number);
+      (yyval.attr_info)->name = (yyvsp[-5].cstring);
+      (yyval.attr_info)->length = (yyvsp[-2].number);
+      (yyval.attr_info)->nullable=true;
+    }
+#line 2153 "yacc_sql.cpp"
+    break;
+
+  case 44: /* attr_def: ID type NOT NUL  */
+#line 435 "yacc_sql.y"
+    {
+      (yyval.attr_info)=new AttrInfoSqlNode;
+      (yyval.attr_info)->type=(AttrType)(yyvsp[-2].number);
+      (yyval.attr_info)->name = (yyvsp[-3].cstring);
+      (yyval.attr_info)->length = 4;
+      (yyval.attr_info)->nullable=false;
+    }
+#line 2165 "yacc_sql.cpp"
+    break;
+
+  case 45: /* attr_def: ID type NULLABLE  */
+#line 443 "yacc_sql.y"
+    {
+      (yyval.attr_info)=new AttrInfoSqlNode;
+      (yyval.attr_info)->type=(AttrType)(yyvsp[-1].number);
+      (yyval.attr_info)->name = (yyvsp[-2].cstring);
+      (yyval.attr_info)->length = 4;
+      (yyval.attr_info)->nullable=true;
+    }
+#line 2177 "yacc_sql.cpp"
+    break;
+
+  case 46: /* number: NUMBER  */
+#line 452 "yacc_sql.y"
+           {(yyval.number) = (yyvsp[0].number);}
+#line 2183 "yacc_sql.cpp"
+    break;
+
+  case 47: /* type: INT_T  */
+#line 455 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::INTS); }
+#line 2189 "yacc_sql.cpp"
+    break;
+
+  case 48: /* type: DATE_T  */
+#line 456 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::DATES); }
+#line 2195 "yacc_sql.cpp"
+    break;
+
+  case 49: /* type: STRING_T  */
+#line 457 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::CHARS); }
+#line 2201 "yacc_sql.cpp"
+    break;
+
+  case 50: /* type: TEXT_T  */
+#line 458 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::TEXTS); }
+#line 2207 "yacc_sql.cpp"
+    break;
+
+  case 51: /* type: FLOAT_T  */
+#line 459 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
+#line 2213 "yacc_sql.cpp"
+    break;
+
+  case 52: /* type: VECTOR_T  */
+#line 460 "yacc_sql.y"
+               { (yyval.number) = static_cast<int>(AttrType::VECTORS); }
+#line 2219 "yacc_sql.cpp"
+    break;
+
+  case 53: /* primary_key: %empty  */
+#line 464 "yacc_sql.y"
+    {
+      (yyval.key_list) = nullptr;
+    }
+#line 2227 "yacc_sql.cpp"
+    break;
+
+  case 54: /* primary_key: COMMA PRIMARY KEY LBRACE attr_list RBRACE  */
+#line 468 "yacc_sql.y"
+    {
+      (yyval.key_list) = (yyvsp[-1].key_list);
+    }
+#line 2235 "yacc_sql.cpp"
+    break;
+
+  case 55: /* attr_list: ID  */
+#line 474 "yacc_sql.y"
+       {
+      (yyval.key_list) = new vector<string>();
+      (yyval.key_list)->push_back((yyvsp[0].cstring));
+    }
+#line 2244 "yacc_sql.cpp"
+    break;
+
+  case 56: /* attr_list: ID COMMA attr_list  */
+#line 478 "yacc_sql.y"
+                         {
+      if ((yyvsp[0].key_list) != nullptr) {
+        (yyval.key_list) = (yyvsp[0].key_list);
+      } else {
+        (yyval.key_list) = new vector<string>;
+      }
+
+      (yyval.key_list)->insert((yyval.key_list)->begin(), (yyvsp[-2].cstring));
+    }
+#line 2258 "yacc_sql.cpp"
+    break;
+
+  case 57: /* insert_stmt: INSERT INTO ID VALUES insert_tuple insert_tuple_list  */
+#line 491 "yacc_sql.y"
+    {
+        (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
+
+        // 使用 std::string 自动管理 relation_name
+        (yyval.sql_node)->insertion.relation_name = std::string((yyvsp[-3].cstring));
+
+        // 移动 insert_tuple_list 的内容到 ParsedSqlNode
+        if ((yyvsp[0].insert_tuple_list) != nullptr) {
+            (yyval.sql_node)->insertion.tuples = std::move(*(yyvsp[0].insert_tuple_list));
+        }
+
+        // 当前 insert_tuple 也移动进去
+        if ((yyvsp[-1].insert_tuple) != nullptr) {
+            (yyval.sql_node)->insertion.tuples.emplace_back(std::move(*(yyvsp[-1].insert_tuple)));
+        }
+    }
+#line 2279 "yacc_sql.cpp"
+    break;
+
+  case 58: /* insert_tuple_list: %empty  */
+#line 512 "yacc_sql.y"
+    { (yyval.insert_tuple_list) = nullptr; }
+#line 2285 "yacc_sql.cpp"
+    break;
+
+  case 59: /* insert_tuple_list: COMMA insert_tuple insert_tuple_list  */
+#line 514 "yacc_sql.y"
+    {
+        if ((yyvsp[0].insert_tuple_list) != nullptr) {
+            (yyval.insert_tuple_list) = (yyvsp[0].insert_tuple_list); // 已有 vector
+        } else {
+            (yyval.insert_tuple_list) = new std::vector<InsertTuple>;
+        }
+
+        if ((yyvsp[-1].insert_tuple) != nullptr) {
+            (yyval.insert_tuple_list)->emplace_back(std::move(*(yyvsp[-1].insert_tuple)));
+          
+        }
+    }
+#line 2302 "yacc_sql.cpp"
+    break;
+
+  case 60: /* insert_tuple: LBRACE value_list RBRACE  */
+#line 530 "yacc_sql.y"
+    {
+        (yyval.insert_tuple) = (yyvsp[-1].value_list); // value_list 本身就是 InsertTuple*
+    }
+#line 2310 "yacc_sql.cpp"
+    break;
+
+  case 61: /* value_list: value  */
+#line 537 "yacc_sql.y"
+    {
+      (yyval.value_list) = new vector<Value>;
+      (yyval.value_list)->emplace_back(*(yyvsp[0].value));
+      delete (yyvsp[0].value);
+    }
+#line 2320 "yacc_sql.cpp"
+    break;
+
+  case 62: /* value_list: value_list COMMA value  */
+#line 542 "yacc_sql.y"
+                             { 
+      (yyval.value_list) = (yyvsp[-2].value_list);
+      (yyval.value_list)->emplace_back(*(yyvsp[0].value));
+      delete (yyvsp[0].value);
+    }
+#line 2330 "yacc_sql.cpp"
+    break;
+
+  case 63: /* value: NUMBER  */
+#line 550 "yacc_sql.y"
+           {
+      (yyval.value) = new Value((int)(yyvsp[0].number));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2339 "yacc_sql.cpp"
+    break;
+
+  case 64: /* value: FLOAT  */
+#line 554 "yacc_sql.y"
+           {
+      (yyval.value) = new Value((float)(yyvsp[0].floats));
+      (yyloc) = (yylsp[0]);
+    }
+#line 2348 "yacc_sql.cpp"
+    break;
+
+  case 65: /* value: SSS  */
+#line 558 "yacc_sql.y"
+         {
+      char *tmp = common::substr((yyvsp[0].cstring),1,strlen((yyvsp[0].cstring))-2);
+      (yyval.value) = new Value(tmp);
+      free(tmp);
+    }
+#line 2358 "yacc_sql.cpp"
+    break;
+
+  case 66: /* value: NUL  */
+#line 563 "yacc_sql.y"
+        {
+      (yyval.value)=new Value("",0,true);
+    }
+#line 2366 "yacc_sql.cpp"
+    break;
+
+  case 67: /* storage_format: %empty  */
+#line 569 "yacc_sql.y"
+    {
+      (yyval.cstring) = nullptr;
+    }
+#line 2374 "yacc_sql.cpp"
+    break;
+
+  case 68: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 573 "yacc_sql.y"
+    {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 2382 "yacc_sql.cpp"
+    break;
+
+  case 69: /* delete_stmt: DELETE FROM ID where  */
+#line 580 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
+      (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].cstring);
+      if ((yyvsp[0].condition_list) != nullptr) {
+        (yyval.sql_node)->deletion.conditions.swap(*(yyvsp[0].condition_list));
+        delete (yyvsp[0].condition_list);
+      }
+    }
+#line 2395 "yacc_sql.cpp"
+    break;
+
+  case 70: /* update_stmt: UPDATE ID SET ID EQ value where  */
+#line 591 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
+      (yyval.sql_node)->update.relation_name = (yyvsp[-5].cstring);
+      (yyval.sql_node)->update.attribute_name = (yyvsp[-3].cstring);
+      (yyval.sql_node)->update.value = *(yyvsp[-1].value);
+      if ((yyvsp[0].condition_list) != nullptr) {
+        (yyval.sql_node)->update.conditions.swap(*(yyvsp[0].condition_list));
+        delete (yyvsp[0].condition_list);
+      }
+    }
+#line 2410 "yacc_sql.cpp"
+    break;
+
+  case 71: /* select_stmt: SELECT expression_list FROM rel_list join_list where order_by group_by limit  */
+#line 604 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
+      if ((yyvsp[-7].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-7].expression_list));
+        delete (yyvsp[-7].expression_list);
+      }
+
+      if ((yyvsp[-5].relation_list) != nullptr) {
+        (yyval.sql_node)->selection.relations.swap(*(yyvsp[-5].relation_list));
+        delete (yyvsp[-5].relation_list);
+      }
+
+      // join
+      if ((yyvsp[-4].join_list) != nullptr) {
+        /* 由于是递归顺序解析的join，需要 reverse */
+        std::reverse((yyvsp[-4].join_list)->begin(), (yyvsp[-4].join_list)->end());
+        for (auto &join : *(yyvsp[-4].join_list)) {
+          (yyval.sql_node)->selection.relations.push_back(join.relation);
+          for (auto &condition : join.conditions) {
+            (yyval.sql_node)->selection.conditions.emplace_back(std::move(condition));
+          }
+        }
+        delete (yyvsp[-4].join_list);
+      }
+
+      if ((yyvsp[-3].condition_list) != nullptr) {
+        for (auto &condition : *(yyvsp[-3].condition_list)) {
+          (yyval.sql_node)->selection.conditions.emplace_back(std::move(condition));
+        }
+        delete (yyvsp[-3].condition_list);
+      }
+
+      if ((yyvsp[-2].order_list) != nullptr) {
+        (yyval.sql_node)->selection.order_by.swap(*(yyvsp[-2].order_list));
+        delete (yyvsp[-2].order_list);
+      }
+
+      if ((yyvsp[-1].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[-1].expression_list));
+        delete (yyvsp[-1].expression_list);
+      }
+
+      (yyval.sql_node)->selection.limit = (yyvsp[0].number);
+    }
+#line 2459 "yacc_sql.cpp"
+    break;
+
+  case 72: /* calc_stmt: CALC expression_list  */
+#line 651 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
+      (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
+      delete (yyvsp[0].expression_list);
+    }
+#line 2469 "yacc_sql.cpp"
+    break;
+
+  case 73: /* expression_list: expression  */
+#line 660 "yacc_sql.y"
+    {
+      (yyval.expression_list) = new vector<unique_ptr<Expression>>;
+      (yyval.expression_list)->emplace_back((yyvsp[0].expression));
+    }
+#line 2478 "yacc_sql.cpp"
+    break;
+
+  case 74: /* expression_list: expression COMMA expression_list  */
+#line 665 "yacc_sql.y"
+    {
+      if ((yyvsp[0].expression_list) != nullptr) {
+        (yyval.expression_list) = (yyvsp[0].expression_list);
+      } else {
+        (yyval.expression_list) = new vector<unique_ptr<Expression>>;
+      }
+      (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-2].expression));
+    }
+#line 2491 "yacc_sql.cpp"
+    break;
+
+  case 75: /* expression: expression '+' expression  */
+#line 675 "yacc_sql.y"
+                              {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2499 "yacc_sql.cpp"
+    break;
+
+  case 76: /* expression: expression '-' expression  */
+#line 678 "yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2507 "yacc_sql.cpp"
+    break;
+
+  case 77: /* expression: expression '*' expression  */
+#line 681 "yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2515 "yacc_sql.cpp"
+    break;
+
+  case 78: /* expression: expression '/' expression  */
+#line 684 "yacc_sql.y"
+                                {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
+    }
+#line 2523 "yacc_sql.cpp"
+    break;
+
+  case 79: /* expression: LBRACE expression RBRACE  */
+#line 687 "yacc_sql.y"
+                               {
+      (yyval.expression) = (yyvsp[-1].expression);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+    }
+#line 2532 "yacc_sql.cpp"
+    break;
+
+  case 80: /* expression: '-' expression  */
+#line 691 "yacc_sql.y"
+                                  {
+      (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::NEGATIVE, (yyvsp[0].expression), nullptr, sql_string, &(yyloc));
+    }
+#line 2540 "yacc_sql.cpp"
+    break;
+
+  case 81: /* expression: '*'  */
+#line 694 "yacc_sql.y"
+          {
+      (yyval.expression) = new StarExpr();
+    }
+#line 2548 "yacc_sql.cpp"
+    break;
+
+  case 82: /* expression: value  */
+#line 697 "yacc_sql.y"
+            {
+      (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].value);
+    }
+#line 2558 "yacc_sql.cpp"
+    break;
+
+  case 83: /* expression: rel_attr  */
+#line 702 "yacc_sql.y"
+               {
+      RelAttrSqlNode *node = (yyvsp[0].rel_attr);
+      (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
+      (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2569 "yacc_sql.cpp"
+    break;
+
+  case 84: /* expression: aggregate_expression  */
+#line 708 "yacc_sql.y"
+                           {
+      (yyval.expression) = (yyvsp[0].expression);
+    }
+#line 2577 "yacc_sql.cpp"
+    break;
+
+  case 85: /* aggregate_expression: ID LBRACE RBRACE  */
+#line 714 "yacc_sql.y"
+                     {
+      (yyval.expression) = create_aggregate_expression((yyvsp[-2].cstring), nullptr, sql_string, &(yyloc));
+    }
+#line 2585 "yacc_sql.cpp"
+    break;
+
+  case 86: /* aggregate_expression: ID LBRACE expression RBRACE  */
+#line 717 "yacc_sql.y"
+                                  {
+      (yyval.expression) = create_aggregate_expression((yyvsp[-3].cstring), (yyvsp[-1].expression), sql_string, &(yyloc));
+    }
+#line 2593 "yacc_sql.cpp"
+    break;
+
+  case 87: /* aggregate_expression: ID LBRACE expression_list RBRACE  */
+#line 720 "yacc_sql.y"
+                                       {
+      (yyval.expression) = create_aggregate_expression((yyvsp[-3].cstring), nullptr, sql_string, &(yyloc));
+    }
+#line 2601 "yacc_sql.cpp"
+    break;
+
+  case 88: /* rel_attr: ID  */
+#line 726 "yacc_sql.y"
+       {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].cstring);
+    }
+#line 2610 "yacc_sql.cpp"
+    break;
+
+  case 89: /* rel_attr: ID DOT ID  */
+#line 730 "yacc_sql.y"
+                {
+      (yyval.rel_attr) = new RelAttrSqlNode;
+      (yyval.rel_attr)->relation_name  = (yyvsp[-2].cstring);
+      (yyval.rel_attr)->attribute_name = (yyvsp[0].cstring);
+    }
+#line 2620 "yacc_sql.cpp"
+    break;
+
+  case 90: /* relation: ID  */
+#line 738 "yacc_sql.y"
+       {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 2628 "yacc_sql.cpp"
+    break;
+
+  case 91: /* rel_list: relation  */
+#line 743 "yacc_sql.y"
+             {
+      (yyval.relation_list) = new vector<string>();
+      (yyval.relation_list)->push_back((yyvsp[0].cstring));
+    }
+#line 2637 "yacc_sql.cpp"
+    break;
+
+  case 92: /* rel_list: relation COMMA rel_list  */
+#line 747 "yacc_sql.y"
+                              {
+      if ((yyvsp[0].relation_list) != nullptr) {
+        (yyval.relation_list) = (yyvsp[0].relation_list);
+      } else {
+        (yyval.relation_list) = new vector<string>;
+      }
+
+      (yyval.relation_list)->insert((yyval.relation_list)->begin(), (yyvsp[-2].cstring));
+    }
+#line 2651 "yacc_sql.cpp"
+    break;
+
+  case 93: /* join_list: %empty  */
+#line 760 "yacc_sql.y"
+    {
+      (yyval.join_list) = nullptr;
+    }
+#line 2659 "yacc_sql.cpp"
+    break;
+
+  case 94: /* join_list: INNER_JOIN ID ON condition_list join_list  */
+#line 763 "yacc_sql.y"
+                                                {
+      if ((yyvsp[0].join_list) != nullptr) {
+        (yyval.join_list) = (yyvsp[0].join_list);
+      } else {
+        (yyval.join_list) = new std::vector<JoinSqlNode>;
+      }
+      JoinSqlNode join;
+      join.relation = (yyvsp[-3].cstring);
+      if((yyvsp[-1].condition_list) != nullptr) {
+        std::reverse((yyvsp[-1].condition_list)->begin(), (yyvsp[-1].condition_list)->end());
+        for (auto &condition : *(yyvsp[-1].condition_list)) {
+          join.conditions.emplace_back(std::move(condition));
+        }
+        delete (yyvsp[-1].condition_list);
+      }
+      (yyval.join_list)->emplace_back(std::move(join));
+    }
+#line 2681 "yacc_sql.cpp"
+    break;
+
+  case 95: /* where: %empty  */
+#line 784 "yacc_sql.y"
+    {
+      (yyval.condition_list) = nullptr;
+    }
+#line 2689 "yacc_sql.cpp"
+    break;
+
+  case 96: /* where: WHERE condition_list  */
+#line 787 "yacc_sql.y"
+                           {
+      (yyval.condition_list) = (yyvsp[0].condition_list);  
+    }
+#line 2697 "yacc_sql.cpp"
+    break;
+
+  case 97: /* condition_list: %empty  */
+#line 793 "yacc_sql.y"
+    {
+      (yyval.condition_list) = nullptr;
+    }
+#line 2705 "yacc_sql.cpp"
+    break;
+
+  case 98: /* condition_list: condition  */
+#line 796 "yacc_sql.y"
+                {
+      (yyval.condition_list) = new vector<ConditionSqlNode>;
+      (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
+      delete (yyvsp[0].condition);
+    }
+#line 2715 "yacc_sql.cpp"
+    break;
+
+  case 99: /* condition_list: condition AND condition_list  */
+#line 801 "yacc_sql.y"
+                                   {
+      (yyval.condition_list) = (yyvsp[0].condition_list);
+      (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
+      delete (yyvsp[-2].condition);
+    }
+#line 2725 "yacc_sql.cpp"
+    break;
+
+  case 100: /* condition: rel_attr comp_op value  */
+#line 809 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-2].rel_attr);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = *(yyvsp[0].value);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].rel_attr);
+      delete (yyvsp[0].value);
+    }
+#line 2741 "yacc_sql.cpp"
+    break;
+
+  case 101: /* condition: value comp_op value  */
+#line 821 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-2].value);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = *(yyvsp[0].value);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].value);
+      delete (yyvsp[0].value);
+    }
+#line 2757 "yacc_sql.cpp"
+    break;
+
+  case 102: /* condition: rel_attr comp_op rel_attr  */
+#line 833 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-2].rel_attr);
+      (yyval.condition)->right_is_attr = 1;
+      (yyval.condition)->right_attr = *(yyvsp[0].rel_attr);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].rel_attr);
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2773 "yacc_sql.cpp"
+    break;
+
+  case 103: /* condition: rel_attr IS NUL  */
+#line 845 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-2].rel_attr);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_IS;
+
+      delete (yyvsp[-2].rel_attr);
+    }
+#line 2788 "yacc_sql.cpp"
+    break;
+
+  case 104: /* condition: rel_attr IS NOT NUL  */
+#line 856 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-3].rel_attr);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_IS_NOT;
+
+      delete (yyvsp[-3].rel_attr);
+    }
+#line 2803 "yacc_sql.cpp"
+    break;
+
+  case 105: /* condition: value IS NUL  */
+#line 867 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-2].value);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_IS;
+
+      delete (yyvsp[-2].value);
+    }
+#line 2818 "yacc_sql.cpp"
+    break;
+
+  case 106: /* condition: value IS NOT NUL  */
+#line 878 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-3].value);
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_IS_NOT;
+
+      delete (yyvsp[-3].value);
+    }
+#line 2833 "yacc_sql.cpp"
+    break;
+
+  case 107: /* condition: value comp_op rel_attr  */
+#line 889 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-2].value);
+      (yyval.condition)->right_is_attr = 1;
+      (yyval.condition)->right_attr = *(yyvsp[0].rel_attr);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+
+      delete (yyvsp[-2].value);
+      delete (yyvsp[0].rel_attr);
+    }
+#line 2849 "yacc_sql.cpp"
+    break;
+
+  case 108: /* condition: rel_attr IN LBRACE select_stmt RBRACE  */
+#line 901 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-4].rel_attr);
+      (yyval.condition)->comp = CompOp_IN;
+      
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-4].rel_attr);
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2873 "yacc_sql.cpp"
+    break;
+
+  case 109: /* condition: rel_attr NOT IN LBRACE select_stmt RBRACE  */
+#line 921 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-5].rel_attr);
+      (yyval.condition)->comp = CompOp_NOT_IN;
+      
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-5].rel_attr);
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2897 "yacc_sql.cpp"
+    break;
+
+  case 110: /* condition: EXISTS LBRACE select_stmt RBRACE  */
+#line 941 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_EXISTS;
+
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2920 "yacc_sql.cpp"
+    break;
+
+  case 111: /* condition: NOT EXISTS LBRACE select_stmt RBRACE  */
+#line 960 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = Value("", 0, true);
+      (yyval.condition)->comp = CompOp_NOT_EXISTS;
+
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2943 "yacc_sql.cpp"
+    break;
+
+  case 112: /* condition: rel_attr comp_op LBRACE select_stmt RBRACE  */
+#line 979 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 1;
+      (yyval.condition)->left_attr = *(yyvsp[-4].rel_attr);
+      (yyval.condition)->comp = (yyvsp[-3].comp);
+      
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-4].rel_attr);
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2967 "yacc_sql.cpp"
+    break;
+
+  case 113: /* condition: value comp_op LBRACE select_stmt RBRACE  */
+#line 999 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->left_is_attr = 0;
+      (yyval.condition)->left_value = *(yyvsp[-4].value);
+      (yyval.condition)->comp = (yyvsp[-3].comp);
+      
+      ParsedSqlNode *node = (yyvsp[-1].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->right_sub_query = select_node;
+
+      delete (yyvsp[-4].value);
+      delete (yyvsp[-1].sql_node);
+    }
+#line 2991 "yacc_sql.cpp"
+    break;
+
+  case 114: /* condition: LBRACE select_stmt RBRACE comp_op rel_attr  */
+#line 1019 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->right_is_attr = 1;
+      (yyval.condition)->right_attr = *(yyvsp[0].rel_attr);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+      
+      ParsedSqlNode *node = (yyvsp[-3].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->left_sub_query = select_node;
+
+      delete (yyvsp[-3].sql_node);
+      delete (yyvsp[0].rel_attr);
+    }
+#line 3015 "yacc_sql.cpp"
+    break;
+
+  case 115: /* condition: LBRACE select_stmt RBRACE comp_op value  */
+#line 1039 "yacc_sql.y"
+    {
+      (yyval.condition) = new ConditionSqlNode;
+      (yyval.condition)->right_is_attr = 0;
+      (yyval.condition)->right_value = *(yyvsp[0].value);
+      (yyval.condition)->comp = (yyvsp[-1].comp);
+      
+      ParsedSqlNode *node = (yyvsp[-3].sql_node);
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      (yyval.condition)->left_sub_query = select_node;
+
+      delete (yyvsp[-3].sql_node);
+      delete (yyvsp[0].value);
+    }
+#line 3039 "yacc_sql.cpp"
+    break;
+
+  case 116: /* comp_op: EQ  */
+#line 1061 "yacc_sql.y"
+         { (yyval.comp) = EQUAL_TO; }
+#line 3045 "yacc_sql.cpp"
+    break;
+
+  case 117: /* comp_op: LT  */
+#line 1062 "yacc_sql.y"
+         { (yyval.comp) = LESS_THAN; }
+#line 3051 "yacc_sql.cpp"
+    break;
+
+  case 118: /* comp_op: GT  */
+#line 1063 "yacc_sql.y"
+         { (yyval.comp) = GREAT_THAN; }
+#line 3057 "yacc_sql.cpp"
+    break;
+
+  case 119: /* comp_op: LE  */
+#line 1064 "yacc_sql.y"
+         { (yyval.comp) = LESS_EQUAL; }
+#line 3063 "yacc_sql.cpp"
+    break;
+
+  case 120: /* comp_op: GE  */
+#line 1065 "yacc_sql.y"
+         { (yyval.comp) = GREAT_EQUAL; }
+#line 3069 "yacc_sql.cpp"
+    break;
+
+  case 121: /* comp_op: NE  */
+#line 1066 "yacc_sql.y"
+         { (yyval.comp) = NOT_EQUAL; }
+#line 3075 "yacc_sql.cpp"
+    break;
+
+  case 122: /* order_by: %empty  */
+#line 1071 "yacc_sql.y"
+    {
+      (yyval.order_list) = nullptr;
+    }
+#line 3083 "yacc_sql.cpp"
+    break;
+
+  case 123: /* order_by: ORDER BY order_list  */
+#line 1075 "yacc_sql.y"
+    {
+      (yyval.order_list) = (yyvsp[0].order_list);
+      std::reverse((yyval.order_list)->begin(), (yyval.order_list)->end());
+    }
+#line 3092 "yacc_sql.cpp"
+    break;
+
+  case 124: /* order_list: %empty  */
+#line 1082 "yacc_sql.y"
+    {
+      (yyval.order_list) = nullptr;
+    }
+#line 3100 "yacc_sql.cpp"
+    break;
+
+  case 125: /* order_list: order_node  */
+#line 1086 "yacc_sql.y"
+    {
+      (yyval.order_list) = new std::vector<OrderSqlNode>;
+      (yyval.order_list)->emplace_back(*(yyvsp[0].order_node));
+      delete (yyvsp[0].order_node);
+    }
+#line 3110 "yacc_sql.cpp"
+    break;
+
+  case 126: /* order_list: order_node COMMA order_list  */
+#line 1092 "yacc_sql.y"
+    {
+      (yyval.order_list) = (yyvsp[0].order_list);
+      (yyval.order_list)->emplace_back(*(yyvsp[-2].order_node));
+      delete (yyvsp[-2].order_node);
+    }
+#line 3120 "yacc_sql.cpp"
+    break;
+
+  case 127: /* order_node: rel_attr order_type  */
+#line 1100 "yacc_sql.y"
+    {
+      (yyval.order_node) = new OrderSqlNode;
+      (yyval.order_node)->type=(yyvsp[0].order_type);
+      (yyval.order_node)->attribute=*(yyvsp[-1].rel_attr);
+      delete (yyvsp[-1].rel_attr);
+    }
+#line 3131 "yacc_sql.cpp"
+    break;
+
+  case 128: /* order_type: %empty  */
+#line 1109 "yacc_sql.y"
+    {
+      (yyval.order_type) = ASC;
+    }
+#line 3139 "yacc_sql.cpp"
+    break;
+
+  case 129: /* order_type: ASC_T  */
+#line 1113 "yacc_sql.y"
+    {
+      (yyval.order_type) = ASC;
+    }
+#line 3147 "yacc_sql.cpp"
+    break;
+
+  case 130: /* order_type: DESC_T  */
+#line 1117 "yacc_sql.y"
+    {
+      (yyval.order_type) = DESC;
+    }
+#line 3155 "yacc_sql.cpp"
+    break;
+
+  case 131: /* group_by: %empty  */
+#line 1126 "yacc_sql.y"
+    {
+      (yyval.expression_list) = nullptr;
+    }
+#line 3163 "yacc_sql.cpp"
+    break;
+
+  case 132: /* group_by: GROUP BY expression_list  */
+#line 1130 "yacc_sql.y"
+    {
+      // group by 的表达式范围与select查询值的表达式范围是不同的，比如group by不支持 *
+      // 但是这里没有处理。
+      (yyval.expression_list) = (yyvsp[0].expression_list);
+    }
+#line 3173 "yacc_sql.cpp"
+    break;
+
+  case 133: /* limit: %empty  */
+#line 1138 "yacc_sql.y"
+    {
+      (yyval.number) = -1;
+    }
+#line 3181 "yacc_sql.cpp"
+    break;
+
+  case 134: /* limit: LIMIT NUMBER  */
+#line 1142 "yacc_sql.y"
+    {
+      (yyval.number) = (yyvsp[0].number);
+    }
+#line 3189 "yacc_sql.cpp"
+    break;
+
+  case 135: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID fields_terminated_by enclosed_by  */
+#line 1148 "yacc_sql.y"
+    {
+      char *tmp_file_name = common::substr((yyvsp[-5].cstring), 1, strlen((yyvsp[-5].cstring)) - 2);
+      
+      (yyval.sql_node) = new ParsedSqlNode(SCF_LOAD_DATA);
+      (yyval.sql_node)->load_data.relation_name = (yyvsp[-2].cstring);
+      (yyval.sql_node)->load_data.file_name = tmp_file_name;
+      if ((yyvsp[-1].cstring) != nullptr) {
+        char *tmp = common::substr((yyvsp[-1].cstring),1,strlen((yyvsp[-1].cstring))-2);
+        (yyval.sql_node)->load_data.terminated = (yyvsp[-1].cstring);
+        free(tmp);
+      }
+      if ((yyvsp[0].cstring) != nullptr) {
+        char *tmp = common::substr((yyvsp[0].cstring),1,strlen((yyvsp[0].cstring))-2);
+        (yyval.sql_node)->load_data.enclosed = (yyvsp[0].cstring);
+        free(tmp);
+      }
+      free(tmp_file_name);
+    }
+#line 3212 "yacc_sql.cpp"
+    break;
+
+  case 136: /* fields_terminated_by: %empty  */
+#line 1170 "yacc_sql.y"
+    {
+      (yyval.cstring) = nullptr;
+    }
+#line 3220 "yacc_sql.cpp"
+    break;
+
+  case 137: /* fields_terminated_by: FIELDS TERMINATED BY SSS  */
+#line 1174 "yacc_sql.y"
+    {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 3228 "yacc_sql.cpp"
+    break;
+
+  case 138: /* enclosed_by: %empty  */
+#line 1180 "yacc_sql.y"
+    {
+      (yyval.cstring) = nullptr;
+    }
+#line 3236 "yacc_sql.cpp"
+    break;
+
+  case 139: /* enclosed_by: ENCLOSED BY SSS  */
+#line 1184 "yacc_sql.y"
+    {
+      (yyval.cstring) = (yyvsp[0].cstring);
+    }
+#line 3244 "yacc_sql.cpp"
+    break;
+
+  case 140: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1190 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
+      (yyval.sql_node)->explain.sql_node = unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
+    }
+#line 3253 "yacc_sql.cpp"
+    break;
+
+  case 141: /* set_variable_stmt: SET ID EQ value  */
+#line 1198 "yacc_sql.y"
+    {
+      (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
+      (yyval.sql_node)->set_variable.name  = (yyvsp[-2].cstring);
+      (yyval.sql_node)->set_variable.value = *(yyvsp[0].value);
+      delete (yyvsp[0].value);
+    }
+#line 3264 "yacc_sql.cpp"
+    break;
+
+
+#line 3268 "yacc_sql.cpp"
+
+      default: break;
+    }
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
+
+  YYPOPSTACK (yylen);
+  yylen = 0;
+
+  *++yyvsp = yyval;
+  *++yylsp = yyloc;
+
+  /* Now 'shift' the result of the reduction.  Determine what state
+     that goes to, based on the state we popped back to and the rule
+     number reduced by.  */
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
+
+  goto yynewstate;
+
+
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
+yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
+  /* If not already recovering from an error, report this error.  */
+  if (!yyerrstatus)
+    {
+      ++yynerrs;
+      {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
+        char const *yymsgp = YY_("syntax error");
+        int yysyntax_error_status;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+        if (yysyntax_error_status == 0)
+          yymsgp = yymsg;
+        else if (yysyntax_error_status == -1)
+          {
+            if (yymsg != yymsgbuf)
+              YYSTACK_FREE (yymsg);
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
+              {
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
+              }
+            else
+              {
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
+              }
+          }
+        yyerror (&yylloc, sql_string, sql_result, scanner, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
+      }
+    }
+
+  yyerror_range[1] = yylloc;
+  if (yyerrstatus == 3)
+    {
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
+
+      if (yychar <= YYEOF)
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
+      else
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+          yychar = YYEMPTY;
+        }
+    }
+
+  /* Else will try to reuse lookahead token after shifting the error
+     token.  */
+  goto yyerrlab1;
+
+
+/*---------------------------------------------------.
+| yyerrorlab -- error raised explicitly by YYERROR.  |
+`---------------------------------------------------*/
+yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
+
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYERROR.  */
+  YYPOPSTACK (yylen);
+  yylen = 0;
+  YY_STACK_PRINT (yyss, yyssp);
+  yystate = *yyssp;
+  goto yyerrlab1;
+
+
+/*-------------------------------------------------------------.
+| yyerrlab1 -- common code for both syntax error and YYERROR.  |
+`-------------------------------------------------------------*/
+yyerrlab1:
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
+
+  /* Pop stack until we find a state that shifts the error token.  */
+  for (;;)
+    {
+      yyn = yypact[yystate];
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
+
+      /* Pop the current state because it cannot handle the error token.  */
+      if (yyssp == yyss)
+        YYABORT;
+
+      yyerror_range[1] = *yylsp;
+      yydestruct ("Error: popping",
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+      yystate = *yyssp;
+      YY_STACK_PRINT (yyss, yyssp);
+    }
+
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
+
+  yyerror_range[2] = yylloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
+
+  /* Shift the error token.  */
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
+
+  yystate = yyn;
+  goto yynewstate;
+
+
+/*-------------------------------------.
+| yyacceptlab -- YYACCEPT comes here.  |
+`-------------------------------------*/
+yyacceptlab:
+  yyresult = 0;
+  goto yyreturnlab;
+
+
+/*-----------------------------------.
+| yyabortlab -- YYABORT comes here.  |
+`-----------------------------------*/
+yyabortlab:
+  yyresult = 1;
+  goto yyreturnlab;
+
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
+yyexhaustedlab:
+  yyerror (&yylloc, sql_string, sql_result, scanner, YY_("memory exhausted"));
+  yyresult = 2;
+  goto yyreturnlab;
+
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, &yylloc, sql_string, sql_result, scanner);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
+     this YYABORT or YYACCEPT.  */
+  YYPOPSTACK (yylen);
+  YY_STACK_PRINT (yyss, yyssp);
+  while (yyssp != yyss)
+    {
+      yydestruct ("Cleanup: popping",
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, sql_string, sql_result, scanner);
+      YYPOPSTACK (1);
+    }
+#ifndef yyoverflow
+  if (yyss != yyssa)
+    YYSTACK_FREE (yyss);
+#endif
+  if (yymsg != yymsgbuf)
+    YYSTACK_FREE (yymsg);
+  return yyresult;
+}
+
+#line 1209 "yacc_sql.y"
+
+//_____________________________________________________________________
+extern void scan_string(const char *str, yyscan_t scanner);
+
+int sql_parse(const char *s, ParsedSqlResult *sql_result) {
+  yyscan_t scanner;
+  std::vector<char *> allocated_strings;
+  yylex_init_extra(static_cast<void*>(&allocated_strings),&scanner);
+  scan_string(s, scanner);
+  int result = yyparse(s, sql_result, scanner);
+
+  for (char *ptr : allocated_strings) {
+    free(ptr);
+  }
+  allocated_strings.clear();
+
+  yylex_destroy(scanner);
+  return result;
+}
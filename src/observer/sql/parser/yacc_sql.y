@@ -77,6 +77,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
         ASC_T
         DESC_T
         ORDER
+        LIMIT
         SHOW
         SYNC
         INSERT
@@ -104,6 +105,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
         DOT //QUOTE
         INTO
         IN
+        EXISTS
         VALUES
         FROM
         WHERE
@@ -180,6 +182,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 %type <condition>           condition
 %type <value>               value
 %type <number>              number
+%type <number>              limit
 %type <cstring>             relation
 %type <comp>                comp_op
 %type <rel_attr>            rel_attr
@@ -329,22 +332,24 @@ desc_table_stmt:
     ;
 
 create_index_stmt:    /*create index 语句的语法解析树*/
-    CREATE INDEX ID ON ID LBRACE ID RBRACE
+    CREATE INDEX ID ON ID LBRACE attr_list RBRACE
     {
       $$ = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = $$->create_index;
       create_index.index_name = $3;
       create_index.relation_name = $5;
-      create_index.attribute_name = $7;
+      create_index.attribute_names.swap(*$7);
+      delete $7;
       create_index.isUnique = false;
     }
-    | CREATE UNIQUE INDEX ID ON ID LBRACE ID RBRACE
+    | CREATE UNIQUE INDEX ID ON ID LBRACE attr_list RBRACE
     {
       $$ = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = $$->create_index;
       create_index.index_name = $4;
       create_index.relation_name = $6;
-      create_index.attribute_name = $8;
+      create_index.attribute_names.swap(*$8);
+      delete $8;
       create_index.isUnique = true;
     }
     ;
@@ -595,7 +600,7 @@ update_stmt:      /*  update 语句的语法解析树*/
     }
     ;
 select_stmt:        /*  select 语句的语法解析树*/
-    SELECT expression_list FROM rel_list join_list where order_by group_by
+    SELECT expression_list FROM rel_list join_list where order_by group_by limit
     {
       $$ = new ParsedSqlNode(SCF_SELECT);
       if ($2 != nullptr) {
@@ -637,6 +642,8 @@ select_stmt:        /*  select 语句的语法解析树*/
         $$->selection.group_by.swap(*$8);
         delete $8;
       }
+
+      $$->selection.limit = $9;
     }
     ;
 calc_stmt:
@@ -904,6 +911,7 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->right_sub_query = select_node;
 
       delete $1;
@@ -923,11 +931,50 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->right_sub_query = select_node;
 
       delete $1;
       delete $5;
     }
+    | EXISTS LBRACE select_stmt RBRACE
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_value = Value("", 0, true);
+      $$->comp = CompOp_EXISTS;
+
+      ParsedSqlNode *node = $3;
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      $$->right_sub_query = select_node;
+
+      delete $3;
+    }
+    | NOT EXISTS LBRACE select_stmt RBRACE
+    {
+      $$ = new ConditionSqlNode;
+      $$->left_is_attr = 0;
+      $$->left_value = Value("", 0, true);
+      $$->comp = CompOp_NOT_EXISTS;
+
+      ParsedSqlNode *node = $4;
+      auto select_node = std::make_shared<SelectSqlNode>();
+      select_node->expressions = std::move(node->selection.expressions);
+      select_node->relations = std::move(node->selection.relations);
+      select_node->conditions = std::move(node->selection.conditions);
+      select_node->group_by = std::move(node->selection.group_by);
+      select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
+      $$->right_sub_query = select_node;
+
+      delete $4;
+    }
     | rel_attr comp_op LBRACE select_stmt RBRACE
     {
       $$ = new ConditionSqlNode;
@@ -942,6 +989,7 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->right_sub_query = select_node;
 
       delete $1;
@@ -961,6 +1009,7 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->right_sub_query = select_node;
 
       delete $1;
@@ -980,6 +1029,7 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->left_sub_query = select_node;
 
       delete $2;
@@ -999,6 +1049,7 @@ condition:
       select_node->conditions = std::move(node->selection.conditions);
       select_node->group_by = std::move(node->selection.group_by);
       select_node->order_by = std::move(node->selection.order_by);
+      select_node->limit = node->selection.limit;
       $$->left_sub_query = select_node;
 
       delete $2;
@@ -1082,6 +1133,16 @@ group_by:
       $$ = $3;
     }
     ;
+limit:
+    /* empty */
+    {
+      $$ = -1;
+    }
+    | LIMIT NUMBER
+    {
+      $$ = $2;
+    }
+    ;
 load_data_stmt:
     LOAD DATA INFILE SSS INTO TABLE ID fields_terminated_by enclosed_by
     {
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/vector.h"
 #include "sql/stmt/stmt.h"
 
 struct CreateIndexSqlNode;
@@ -27,25 +28,25 @@ class FieldMeta;
 class CreateIndexStmt : public Stmt
 {
 public:
-  CreateIndexStmt(Table *table, const FieldMeta *field_meta, const string &index_name, bool isUnique)
-      : table_(table), field_meta_(field_meta), index_name_(index_name), isUnique_(isUnique)
+  CreateIndexStmt(Table *table, const vector<const FieldMeta *> &field_metas, const string &index_name, bool isUnique)
+      : table_(table), field_metas_(field_metas), index_name_(index_name), isUnique_(isUnique)
   {}
 
   virtual ~CreateIndexStmt() = default;
 
   StmtType type() const override { return StmtType::CREATE_INDEX; }
 
-  Table           *table() const { return table_; }
-  const FieldMeta *field_meta() const { return field_meta_; }
-  const string    &index_name() const { return index_name_; }
-  bool             isUnique() const { return isUnique_; }
+  Table                           *table() const { return table_; }
+  const vector<const FieldMeta *> &field_metas() const { return field_metas_; }
+  const string                    &index_name() const { return index_name_; }
+  bool                             isUnique() const { return isUnique_; }
 
 public:
   static RC create(Db *db, const CreateIndexSqlNode &create_index, Stmt *&stmt);
 
 private:
-  Table           *table_      = nullptr;
-  const FieldMeta *field_meta_ = nullptr;
-  string           index_name_;
-  bool             isUnique_;
+  Table                    *table_ = nullptr;
+  vector<const FieldMeta *> field_metas_;  ///< 索引包含的字段，按照索引中的顺序排列
+  string                    index_name_;
+  bool                      isUnique_;
 };
@@ -29,7 +29,7 @@ FilterStmt::~FilterStmt()
 }
 
 RC FilterStmt::create(Db *db, Table *default_table, unordered_map<string, Table *> *tables,
-    const ConditionSqlNode *conditions, int condition_num, FilterStmt *&stmt)
+    const ConditionSqlNode *conditions, int condition_num, FilterStmt *&stmt, unordered_map<string, Table *> *outer_tables)
 {
   RC rc = RC::SUCCESS;
   stmt  = nullptr;
@@ -38,7 +38,7 @@ RC FilterStmt::create(Db *db, Table *default_table, unordered_map<string, Table
   for (int i = 0; i < condition_num; i++) {
     FilterUnit *filter_unit = nullptr;
 
-    rc = create_filter_unit(db, default_table, tables, conditions[i], filter_unit);
+    rc = create_filter_unit(db, default_table, tables, conditions[i], filter_unit, outer_tables);
     if (rc != RC::SUCCESS) {
       delete tmp_stmt;
       LOG_WARN("failed to create filter unit. condition index=%d", i);
@@ -79,8 +79,35 @@ RC get_table_and_field(Db *db, Table *default_table, unordered_map<string, Table
   return RC::SUCCESS;
 }
 
+/**
+ * @brief 解析条件中的字段，在当前查询的表中找不到时，再到外层查询的表中查找，这时是一个相关子查询
+ * @details 只查找直接外层的查询
+ */
+static RC resolve_attr(Db *db, Table *default_table, unordered_map<string, Table *> *tables,
+    unordered_map<string, Table *> *outer_tables, const RelAttrSqlNode &attr, FilterObj &filter_obj)
+{
+  Table           *table = nullptr;
+  const FieldMeta *field = nullptr;
+  RC               rc    = get_table_and_field(db, default_table, tables, attr, table, field);
+  if (OB_SUCC(rc)) {
+    filter_obj.init_attr(Field(table, field));
+    return rc;
+  }
+  if (nullptr == outer_tables) {
+    return rc;
+  }
+
+  Table *outer_default_table = outer_tables->size() == 1 ? outer_tables->begin()->second : nullptr;
+  table                      = nullptr;
+  if (OB_FAIL(get_table_and_field(db, outer_default_table, outer_tables, attr, table, field))) {
+    return rc;
+  }
+  filter_obj.init_attr(Field(table, field), true /*is_outer*/);
+  return RC::SUCCESS;
+}
+
 RC FilterStmt::create_filter_unit(Db *db, Table *default_table, unordered_map<string, Table *> *tables,
-    const ConditionSqlNode &condition, FilterUnit *&filter_unit)
+    const ConditionSqlNode &condition, FilterUnit *&filter_unit, unordered_map<string, Table *> *outer_tables)
 {
   RC rc = RC::SUCCESS;
 
@@ -94,7 +121,7 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, unordered_map<st
 
   if (condition.left_sub_query) {
     Stmt *stmt = nullptr;
-    rc = SelectStmt::create(db, *condition.left_sub_query, stmt);
+    rc = SelectStmt::create(db, *condition.left_sub_query, stmt, tables);
     if (rc != RC::SUCCESS) {
       delete filter_unit;
       LOG_WARN("failed to create sub query stmt");
@@ -104,15 +131,13 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, unordered_map<st
     filter_obj.init_sub_query(static_cast<SelectStmt*>(stmt));
     filter_unit->set_left(filter_obj);
   } else if (condition.left_is_attr) {
-    Table           *table = nullptr;
-    const FieldMeta *field = nullptr;
-    rc                     = get_table_and_field(db, default_table, tables, condition.left_attr, table, field);
+    FilterObj filter_obj;
+    rc = resolve_attr(db, default_table, tables, outer_tables, condition.left_attr, filter_obj);
     if (rc != RC::SUCCESS) {
+      delete filter_unit;
       LOG_WARN("cannot find attr");
       return rc;
     }
-    FilterObj filter_obj;
-    filter_obj.init_attr(Field(table, field));
     filter_unit->set_left(filter_obj);
   } else {
     FilterObj filter_obj;
@@ -122,7 +147,7 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, unordered_map<st
 
   if (condition.right_sub_query) {
     Stmt *stmt = nullptr;
-    rc = SelectStmt::create(db, *condition.right_sub_query, stmt);
+    rc = SelectStmt::create(db, *condition.right_sub_query, stmt, tables);
     if (rc != RC::SUCCESS) {
       delete filter_unit;
       LOG_WARN("failed to create sub query stmt");
@@ -132,15 +157,13 @@ RC FilterStmt::create_filter_unit(Db *db, Table *default_table, unordered_map<st
     filter_obj.init_sub_query(static_cast<SelectStmt*>(stmt));
     filter_unit->set_right(filter_obj);
   } else if (condition.right_is_attr) {
-    Table           *table = nullptr;
-    const FieldMeta *field = nullptr;
-    rc                     = get_table_and_field(db, default_table, tables, condition.right_attr, table, field);
+    FilterObj filter_obj;
+    rc = resolve_attr(db, default_table, tables, outer_tables, condition.right_attr, filter_obj);
     if (rc != RC::SUCCESS) {
+      delete filter_unit;
       LOG_WARN("cannot find attr");
       return rc;
     }
-    FilterObj filter_obj;
-    filter_obj.init_attr(Field(table, field));
     filter_unit->set_right(filter_obj);
   } else {
     FilterObj filter_obj;
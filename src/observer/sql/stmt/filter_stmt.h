@@ -32,12 +32,14 @@ struct FilterObj
   Value value;
   bool is_sub_query = false;
   SelectStmt *sub_query = nullptr;
+  bool is_outer = false;  ///< 字段属于外层查询的表，当前是一个相关子查询
 
-  void init_attr(const Field &field)
+  void init_attr(const Field &field, bool is_outer = false)
   {
     is_attr     = true;
     is_sub_query = false;
     this->field = field;
+    this->is_outer = is_outer;
   }
 
   void init_value(const Value &value)
@@ -93,11 +95,15 @@ public:
   const vector<FilterUnit *> &filter_units() const { return filter_units_; }
 
 public:
+  /**
+   * @param outer_tables 外层查询的表，不为空时当前是一个子查询，条件中可以引用外层查询的字段
+   */
   static RC create(Db *db, Table *default_table, unordered_map<string, Table *> *tables,
-      const ConditionSqlNode *conditions, int condition_num, FilterStmt *&stmt);
+      const ConditionSqlNode *conditions, int condition_num, FilterStmt *&stmt,
+      unordered_map<string, Table *> *outer_tables = nullptr);
 
   static RC create_filter_unit(Db *db, Table *default_table, unordered_map<string, Table *> *tables,
-      const ConditionSqlNode &condition, FilterUnit *&filter_unit);
+      const ConditionSqlNode &condition, FilterUnit *&filter_unit, unordered_map<string, Table *> *outer_tables);
 
 private:
   vector<FilterUnit *> filter_units_;  // 默认当前都是AND关系
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/unordered_map.h"
 #include "common/sys/rc.h"
 #include "sql/stmt/stmt.h"
 #include "storage/field/field.h"
@@ -38,7 +39,10 @@ public:
   StmtType type() const override { return StmtType::SELECT; }
 
 public:
-  static RC create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt);
+  /**
+   * @param outer_tables 外层查询的表，创建子查询时不为空，子查询的条件中可以引用外层查询的字段
+   */
+  static RC create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt, unordered_map<string, Table *> *outer_tables = nullptr);
 
 public:
   const vector<Table *> &tables() const { return tables_; }
@@ -47,6 +51,7 @@ public:
   vector<unique_ptr<Expression>> &query_expressions() { return query_expressions_; }
   vector<unique_ptr<Expression>> &group_by() { return group_by_; }
   vector<OrderStmt *>            &order_by() { return order_by_; }
+  int                             limit() const { return limit_; }
 
 private:
   vector<unique_ptr<Expression>> query_expressions_;
@@ -54,4 +59,5 @@ private:
   FilterStmt                    *filter_stmt_ = nullptr;
   vector<OrderStmt *>            order_by_;
   vector<unique_ptr<Expression>> group_by_;
+  int                            limit_ = -1;  ///< -1 表示没有 limit
 };
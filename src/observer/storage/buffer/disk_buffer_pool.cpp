@@ -186,7 +186,7 @@ list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
 ////////////////////////////////////////////////////////////////////////////////
 BufferPoolIterator::BufferPoolIterator() {}
 BufferPoolIterator::~BufferPoolIterator() {}
-RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
+RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */, PageNum end_page /* = -1 */)
 {
   bitmap_.init(bp.file_header_->bitmap, bp.file_header_->page_count);
   if (start_page <= 0) {
@@ -194,14 +194,22 @@ RC BufferPoolIterator::init(DiskBufferPool &bp, PageNum start_page /* = 0 */)
   } else {
     current_page_num_ = start_page - 1;
   }
+  end_page_num_ = end_page;
   return RC::SUCCESS;
 }
 
-bool BufferPoolIterator::has_next() { return bitmap_.next_setted_bit(current_page_num_ + 1) != -1; }
+bool BufferPoolIterator::has_next()
+{
+  PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
+  return next_page != -1 && (end_page_num_ < 0 || next_page < end_page_num_);
+}
 
 PageNum BufferPoolIterator::next()
 {
   PageNum next_page = bitmap_.next_setted_bit(current_page_num_ + 1);
+  if (end_page_num_ >= 0 && next_page >= end_page_num_) {
+    next_page = -1;
+  }
   if (next_page != -1) {
     current_page_num_ = next_page;
   }
@@ -421,11 +429,16 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   allocated_frame->clear_page();
   allocated_frame->set_page_num(file_header_->page_count - 1);
 
-  // Use flush operation to extension file
-  if ((rc = flush_page_internal(*allocated_frame)) != RC::SUCCESS) {
+  // 直接把空页面写入数据文件来扩展文件，不经过二次写缓冲区。二次写缓冲区中的页面在刷盘前只保存在内存中，
+  // 崩溃后文件头中的页面个数可能超过文件的大小，恢复时读不到这个页面。
+  // 空页面没有需要保护的旧数据，写了一半也可以通过日志重做
+  allocated_frame->set_check_sum(crc32(allocated_frame->page().data, BP_PAGE_DATA_SIZE));
+  if ((rc = dblwr_manager_.write_logged_page(this, page_num, allocated_frame->page())) != RC::SUCCESS) {
     LOG_WARN("Failed to alloc page %s , due to failed to extend one page.", file_name_.c_str());
     // skip return false, delay flush the extended page
     // return tmp;
+  } else {
+    allocated_frame->clear_dirty();
   }
 
   lock_.unlock();
@@ -555,7 +568,11 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
 
   frame.set_check_sum(crc32(frame.page().data, BP_PAGE_DATA_SIZE));
 
-  rc = dblwr_manager_.add_page(this, frame.page_num(), frame.page());
+  if (frame.image_logged()) {
+    rc = dblwr_manager_.write_logged_page(this, frame.page_num(), frame.page());
+  } else {
+    rc = dblwr_manager_.add_page(this, frame.page_num(), frame.page());
+  }
   if (OB_FAIL(rc)) {
     return rc;
   }
@@ -577,7 +594,13 @@ RC DiskBufferPool::flush_all_pages()
       return rc;
     }
   }
-  return RC::SUCCESS;
+
+  // 页面可能还攒在二次写缓冲区的内存中
+  RC rc = dblwr_manager_.flush_page();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to flush double write buffer. rc=%s", strrc(rc));
+  }
+  return rc;
 }
 
 RC DiskBufferPool::recover_page(PageNum page_num)
@@ -170,7 +170,10 @@ public:
   BufferPoolIterator();
   ~BufferPoolIterator();
 
-  RC      init(DiskBufferPool &bp, PageNum start_page = 0);
+  /**
+   * @brief 遍历 [start_page, end_page) 范围内的页面，end_page 小于 0 时遍历到文件结尾
+   */
+  RC      init(DiskBufferPool &bp, PageNum start_page = 0, PageNum end_page = -1);
   bool    has_next();
   PageNum next();
   RC      reset();
@@ -178,6 +181,7 @@ public:
 private:
   common::Bitmap bitmap_;
   PageNum        current_page_num_ = -1;
+  PageNum        end_page_num_     = -1;
 };
 
 /**
@@ -272,6 +276,9 @@ public:
 public:
   int32_t id() const { return buffer_pool_id_; }
 
+  /// 文件中的页面个数，包括已经释放的页面
+  PageNum page_count() const { return file_header_->page_count; }
+
   const char *filename() const { return file_name_.c_str(); }
 
 protected:
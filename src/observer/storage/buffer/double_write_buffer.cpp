@@ -12,13 +12,16 @@ See the Mulan PSL v2 for more details. */
 // Created by Wenbin1002 on 2024/04/16
 //
 #include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
 
 #include "storage/buffer/double_write_buffer.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "common/io/io.h"
 #include "common/log/log.h"
 #include "common/math/crc.h"
-#include <algorithm>
+#include "common/thread/task_scheduler.h"
+#include "common/lang/algorithm.h"
 
 using namespace common;
 
@@ -26,19 +29,18 @@ struct DoubleWritePage
 {
 public:
   DoubleWritePage() = default;
-  DoubleWritePage(int32_t buffer_pool_id, PageNum page_num, int32_t page_index, Page &page);
+  DoubleWritePage(int32_t buffer_pool_id, PageNum page_num, Page &page);
 
 public:
   DoubleWritePageKey key;
   int32_t            page_index = -1; /// 页面在double write buffer文件中的页索引
-  bool               valid = true; /// 表示页面是否有效，在页面被删除时，需要同时标记磁盘上的值。
   Page               page;
 
   static const int32_t SIZE;
 };
 
-DoubleWritePage::DoubleWritePage(int32_t buffer_pool_id, PageNum page_num, int32_t page_index, Page &_page)
-  : key{buffer_pool_id, page_num}, page_index(page_index), page(_page)
+DoubleWritePage::DoubleWritePage(int32_t buffer_pool_id, PageNum page_num, Page &_page)
+  : key{buffer_pool_id, page_num}, page(_page)
 {}
 
 const int32_t DoubleWritePage::SIZE = sizeof(DoubleWritePage);
@@ -75,20 +77,61 @@ RC DiskDoubleWriteBuffer::open_file(const char *filename)
 
 RC DiskDoubleWriteBuffer::flush_page()
 {
-  sync();
+  scoped_lock lock_guard(lock_);
+  return flush_page_internal();
+}
 
+RC DiskDoubleWriteBuffer::flush_page_internal()
+{
+  vector<DoubleWritePage *> pages;
+  pages.reserve(dblwr_pages_.size());
   for (const auto &pair : dblwr_pages_) {
-    RC rc = write_page(pair.second);
-    if (rc != RC::SUCCESS) {
+    pages.push_back(pair.second);
+  }
+
+  // 同一个文件的页面放在一起，并且按照页号从小到大写入数据文件
+  sort(pages.begin(), pages.end(), [](DoubleWritePage *a, DoubleWritePage *b) {
+    if (a->key.buffer_pool_id != b->key.buffer_pool_id) {
+      return a->key.buffer_pool_id < b->key.buffer_pool_id;
+    }
+    return a->key.page_num < b->key.page_num;
+  });
+
+  // 所有页面和文件头一起写到共享文件中，只需要一次 fsync
+  RC rc = RC::SUCCESS;
+  if (!pages.empty()) {
+    rc = write_pages_internal(pages);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to write pages into double write buffer. rc=%s", strrc(rc));
       return rc;
     }
-    pair.second->valid = false;
-    write_page_internal(pair.second);
-    delete pair.second;
+    if (fdatasync(file_desc_) != 0) {
+      LOG_ERROR("Failed to sync double write buffer file due to %s.", strerror(errno));
+      return RC::IOERR_SYNC;
+    }
+  }
+
+  rc = write_home_pages(pages);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to write pages into data files. rc=%s", strrc(rc));
+    return rc;
   }
 
+  for (DoubleWritePage *page : pages) {
+    delete page;
+  }
   dblwr_pages_.clear();
+
+  if (header_.page_cnt == 0) {
+    return rc;
+  }
+
+  // 数据文件都已经写完了，清空共享文件。不需要 fsync，恢复时会跳过数据文件中已经是最新的页面
   header_.page_cnt = 0;
+  if (pwrite(file_desc_, &header_, sizeof(header_), 0) != static_cast<ssize_t>(sizeof(header_))) {
+    LOG_ERROR("Failed to reset double write buffer header due to %s.", strerror(errno));
+    return RC::IOERR_WRITE;
+  }
 
   return RC::SUCCESS;
 }
@@ -102,37 +145,16 @@ RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &p
     iter->second->page = page;
     LOG_TRACE("[cache hit]add page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size=%d",
               bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
-    return write_page_internal(iter->second);
+    return RC::SUCCESS;
   }
 
-  int64_t          page_cnt   = dblwr_pages_.size();
-  DoubleWritePage *dblwr_page = new DoubleWritePage(bp->id(), page_num, page_cnt, page);
+  DoubleWritePage *dblwr_page = new DoubleWritePage(bp->id(), page_num, page);
   dblwr_pages_.insert(pair<DoubleWritePageKey, DoubleWritePage *>(key, dblwr_page));
   LOG_TRACE("insert page into double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d, dwb size:%d",
             bp->id(), page_num, page.lsn, static_cast<int>(dblwr_pages_.size()));
 
-  RC rc = write_page_internal(dblwr_page);
-  if (OB_FAIL(rc)) {
-    LOG_WARN("failed to write page into double write buffer. rc=%s buffer_pool_id:%d,page_num:%d,lsn=%d.",
-        strrc(rc), bp->id(), page_num, page.lsn);
-    return rc;
-  }
-
-  if (page_cnt + 1 > header_.page_cnt) {
-    header_.page_cnt = page_cnt + 1;
-    if (lseek(file_desc_, 0, SEEK_SET) == -1) {
-      LOG_ERROR("Failed to add page header due to failed to seek %s.", strerror(errno));
-      return RC::IOERR_SEEK;
-    }
-
-    if (writen(file_desc_, &header_, sizeof(header_)) != 0) {
-      LOG_ERROR("Failed to add page header due to %s.", strerror(errno));
-      return RC::IOERR_WRITE;
-    }
-  }
-
   if (static_cast<int>(dblwr_pages_.size()) >= max_pages_) {
-    RC rc = flush_page();
+    RC rc = flush_page_internal();
     if (rc != RC::SUCCESS) {
       LOG_ERROR("Failed to flush pages in double write buffer");
       return rc;
@@ -142,32 +164,114 @@ RC DiskDoubleWriteBuffer::add_page(DiskBufferPool *bp, PageNum page_num, Page &p
   return RC::SUCCESS;
 }
 
-RC DiskDoubleWriteBuffer::write_page_internal(DoubleWritePage *page)
+RC DiskDoubleWriteBuffer::write_logged_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
-  int32_t page_index = page->page_index;
-  int64_t offset = page_index * DoubleWritePage::SIZE + DoubleWriteBufferHeader::SIZE;
-  if (lseek(file_desc_, offset, SEEK_SET) == -1) {
-    LOG_ERROR("Failed to add page %lld of %d due to failed to seek %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_SEEK;
+  // 与刷盘互斥，防止刷盘时把旧的页面写到新的页面之后
+  scoped_lock lock_guard(lock_);
+  DoubleWritePageKey key{bp->id(), page_num};
+  auto iter = dblwr_pages_.find(key);
+  if (iter != dblwr_pages_.end()) {
+    delete iter->second;
+    dblwr_pages_.erase(iter);
   }
 
-  if (writen(file_desc_, page, DoubleWritePage::SIZE) != 0) {
-    LOG_ERROR("Failed to add page %lld of %d due to %s.", offset, file_desc_, strerror(errno));
-    return RC::IOERR_WRITE;
+  LOG_TRACE("write logged page without double write. buffer_pool_id:%d,page_num:%d,lsn=%d",
+            bp->id(), page_num, page.lsn);
+  RC rc = bp->write_page(page_num, page);
+  if (OB_SUCC(rc)) {
+    // 下次刷盘时与其它页面一起 fsync
+    unsynced_buffer_pools_.insert(bp->id());
+  }
+  return rc;
+}
+
+RC DiskDoubleWriteBuffer::write_pages_internal(const vector<DoubleWritePage *> &pages)
+{
+  // 文件头后面紧跟着所有的页面，在共享文件中是连续的，用 pwritev 一起写入
+  header_.page_cnt = static_cast<int32_t>(pages.size());
+
+  vector<iovec> iovs;
+  iovs.reserve(pages.size() + 1);
+  iovs.push_back(iovec{&header_, sizeof(header_)});
+  for (size_t i = 0; i < pages.size(); i++) {
+    pages[i]->page_index = static_cast<int32_t>(i);
+    iovs.push_back(iovec{pages[i], static_cast<size_t>(DoubleWritePage::SIZE)});
   }
 
+  // 一次 pwritev 最多写 IOV_MAX 个缓冲区
+  int64_t offset = 0;
+  for (size_t begin = 0; begin < iovs.size(); begin += IOV_MAX) {
+    const int count = static_cast<int>(std::min(iovs.size() - begin, static_cast<size_t>(IOV_MAX)));
+    ssize_t   size  = 0;
+    for (int i = 0; i < count; i++) {
+      size += iovs[begin + i].iov_len;
+    }
+
+    if (pwritev(file_desc_, iovs.data() + begin, count, offset) != size) {
+      LOG_ERROR("Failed to write pages into double write buffer due to %s. page count=%d, offset=%ld",
+                strerror(errno), header_.page_cnt, offset);
+      return RC::IOERR_WRITE;
+    }
+    offset += size;
+  }
   return RC::SUCCESS;
 }
 
+RC DiskDoubleWriteBuffer::write_home_pages(const vector<DoubleWritePage *> &pages)
+{
+  // 每个数据文件一组，组内按照页号顺序写入
+  struct HomeFile
+  {
+    DiskBufferPool *buffer_pool = nullptr;
+    size_t          begin       = 0;
+    size_t          end         = 0;
+    RC              rc          = RC::SUCCESS;
+  };
+
+  vector<HomeFile> files;
+  for (size_t i = 0; i < pages.size(); i++) {
+    const int32_t buffer_pool_id = pages[i]->key.buffer_pool_id;
+    if (files.empty() || files.back().buffer_pool->id() != buffer_pool_id) {
+      DiskBufferPool *disk_buffer = nullptr;
+      RC rc = bp_manager_.get_buffer_pool(buffer_pool_id, disk_buffer);
+      ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", buffer_pool_id);
+      files.push_back(HomeFile{disk_buffer, i, i});
+      unsynced_buffer_pools_.erase(buffer_pool_id);
+    }
+    files.back().end = i + 1;
+  }
+
+  // 直接写入的页面也需要 fsync，buffer pool 已经关闭的话会在关闭时处理
+  for (int32_t buffer_pool_id : unsynced_buffer_pools_) {
+    DiskBufferPool *disk_buffer = nullptr;
+    if (OB_SUCC(bp_manager_.get_buffer_pool(buffer_pool_id, disk_buffer)) && disk_buffer != nullptr) {
+      files.push_back(HomeFile{disk_buffer, pages.size(), pages.size()});
+    }
+  }
+  unsynced_buffer_pools_.clear();
+
+  auto write_file = [this, &pages, &files](int index) {
+    HomeFile &file = files[index];
+    for (size_t i = file.begin; i < file.end && OB_SUCC(file.rc); i++) {
+      file.rc = write_page(pages[i]);
+    }
+    if (OB_SUCC(file.rc) && fdatasync(file.buffer_pool->file_desc()) != 0) {
+      LOG_ERROR("Failed to sync data file %s due to %s.", file.buffer_pool->filename(), strerror(errno));
+      file.rc = RC::IOERR_SYNC;
+    }
+    return file.rc;
+  };
+
+  // 不同的数据文件交给共享的任务调度器并行写入，当前线程也参与写入，不会因为调度器的线程都在忙而一直等待
+  if (files.size() <= 1) {
+    return files.empty() ? RC::SUCCESS : write_file(0);
+  }
+  return common::TaskScheduler::instance().run(static_cast<int>(files.size()), write_file);
+}
+
 RC DiskDoubleWriteBuffer::write_page(DoubleWritePage *dblwr_page)
 {
   DiskBufferPool *disk_buffer = nullptr;
-  // skip invalid page
-  if (!dblwr_page->valid) {
-    LOG_TRACE("double write buffer write page invalid. buffer_pool_id:%d,page_num:%d,lsn=%d",
-              dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
-    return RC::SUCCESS;
-  }
   RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
   ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_page->key.buffer_pool_id);
 
@@ -206,6 +310,7 @@ RC DiskDoubleWriteBuffer::clear_pages(DiskBufferPool *buffer_pool)
 
   lock_.lock();
   erase_if(dblwr_pages_, remove_pred);
+  unsynced_buffer_pools_.erase(buffer_pool->id());
   lock_.unlock();
 
   LOG_INFO("clear pages in double write buffer. file name=%s, page count=%d",
@@ -224,8 +329,10 @@ RC DiskDoubleWriteBuffer::clear_pages(DiskBufferPool *buffer_pool)
                buffer_pool->filename(), dbl_page->key.page_num, strrc(rc));
       break;
     }
-    dbl_page->valid = false;
-    write_page_internal(dbl_page);
+  }
+
+  if (fdatasync(buffer_pool->file_desc()) != 0) {
+    LOG_WARN("Failed to sync data file %s due to %s.", buffer_pool->filename(), strerror(errno));
   }
 
   for_each(spec_pages.begin(), spec_pages.end(), [](DoubleWritePage *dbl_page) { delete dbl_page; });
@@ -269,7 +376,13 @@ RC DiskDoubleWriteBuffer::load_pages()
     Page &page     = dblwr_page->page;
     page.check_sum = (CheckSum)-1;
 
+    // 文件头和页面是一起写入的，写入过程中崩溃时文件可能比文件头中记录的短，后面的页面都没有写完
     ret = readn(file_desc_, dblwr_page.get(), DoubleWritePage::SIZE);
+    if (ret == -1) {
+      LOG_WARN("double write buffer file is shorter than page count in header. page count=%d, loaded=%d",
+               header_.page_cnt, page_num);
+      break;
+    }
     if (ret != 0) {
       LOG_ERROR("Failed to load page, file_desc:%d, page num:%d, due to failed to read data:%s, ret=%d, page count=%d",
                 file_desc_, page_num, strerror(errno), ret, page_num);
@@ -278,8 +391,15 @@ RC DiskDoubleWriteBuffer::load_pages()
 
     const CheckSum check_sum = crc32(page.data, BP_PAGE_DATA_SIZE);
     if (check_sum == page.check_sum) {
-      DoubleWritePageKey key = dblwr_page->key;
-      dblwr_pages_.insert(pair<DoubleWritePageKey, DoubleWritePage *>(key, dblwr_page.release()));
+      // 页面跳过二次写之后又加进来的话，共享文件中会有同一个页面的多个版本，保留最新的
+      DoubleWritePageKey key  = dblwr_page->key;
+      auto               iter = dblwr_pages_.find(key);
+      if (iter == dblwr_pages_.end()) {
+        dblwr_pages_.insert(pair<DoubleWritePageKey, DoubleWritePage *>(key, dblwr_page.release()));
+      } else if (iter->second->page.lsn < page.lsn) {
+        delete iter->second;
+        iter->second = dblwr_page.release();
+      }
     } else {
       LOG_TRACE("got a page with an invalid checksum. on disk:%d, in memory:%d", page.check_sum, check_sum);
     }
@@ -291,7 +411,39 @@ RC DiskDoubleWriteBuffer::load_pages()
 
 RC DiskDoubleWriteBuffer::recover()
 {
-  return flush_page();
+  scoped_lock lock_guard(lock_);
+
+  // 只有数据文件中写了一半或者比共享文件中旧的页面才需要修复，其它页面已经在上次刷盘时写完了
+  for (auto iter = dblwr_pages_.begin(); iter != dblwr_pages_.end();) {
+    DoubleWritePage *dblwr_page  = iter->second;
+    DiskBufferPool  *disk_buffer = nullptr;
+    RC rc = bp_manager_.get_buffer_pool(dblwr_page->key.buffer_pool_id, disk_buffer);
+    if (OB_FAIL(rc) || disk_buffer == nullptr) {
+      LOG_WARN("buffer pool of double write page is not opened, skip it. buffer_pool_id:%d,page_num:%d",
+               dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num);
+      delete dblwr_page;
+      iter = dblwr_pages_.erase(iter);
+      continue;
+    }
+
+    Page    home_page;
+    int64_t offset = ((int64_t)dblwr_page->key.page_num) * sizeof(Page);
+    ssize_t ret    = pread(disk_buffer->file_desc(), &home_page, sizeof(Page), offset);
+    if (ret == static_cast<ssize_t>(sizeof(Page)) && crc32(home_page.data, BP_PAGE_DATA_SIZE) == home_page.check_sum &&
+        home_page.lsn >= dblwr_page->page.lsn) {
+      LOG_TRACE("skip up to date page in double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d",
+                dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
+      delete dblwr_page;
+      iter = dblwr_pages_.erase(iter);
+      continue;
+    }
+
+    LOG_INFO("recover page from double write buffer. buffer_pool_id:%d,page_num:%d,lsn=%d",
+             dblwr_page->key.buffer_pool_id, dblwr_page->key.page_num, dblwr_page->page.lsn);
+    ++iter;
+  }
+
+  return flush_page_internal();
 }
 
 ////////////////////////////////////////////////////////////////
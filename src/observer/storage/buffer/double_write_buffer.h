@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/lang/mutex.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/vector.h"
 #include "common/types.h"
 #include "common/sys/rc.h"
 #include "storage/buffer/page.h"
@@ -35,8 +37,21 @@ public:
    */
   virtual RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) = 0;
 
+  /**
+   * @brief 页面的完整镜像已经记录在日志中，不需要二次写，直接写入数据文件
+   * @details 即使写数据文件时只写了一半，恢复时也可以用日志中的页面镜像修复。
+   * buffer 中如果还有这个页面的旧版本，需要丢弃，否则之后会覆盖新的数据。
+   */
+  virtual RC write_logged_page(DiskBufferPool *bp, PageNum page_num, Page &page) = 0;
+
   virtual RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) = 0;
 
+  /**
+   * @brief 将内存中攒着的页面全部写入磁盘
+   * @details 显式刷盘(比如 buffer pool 的 flush_all_pages)之后，页面需要已经落盘，不能只是在内存中
+   */
+  virtual RC flush_page() = 0;
+
   /**
    * @brief 清空所有与指定buffer pool关联的页面
    */
@@ -80,7 +95,12 @@ struct DoubleWritePageKeyHash
  * 当我们从磁盘中读取页面时，会校验页面的checksum，如果校验失败，则说明页面写入不完整，这时候可以从
  * DoubleWriteBuffer中读取数据。
  *
- * @note 每次都要保证，不管在内存中还是在文件中，这里的数据都是最新的，都比Buffer pool中的数据要新
+ * 页面加入时只放在内存中，攒够 max_pages 个之后一起刷盘：所有页面和文件头用一次 pwritev 写到共享文件中，
+ * 只做一次 fsync，然后再把页面写到各自的数据文件中，不同数据文件的页面并行写入，每个数据文件 fsync 一次。
+ * 数据文件都写完之后把文件头中的页面个数清零，这一步不需要 fsync：恢复时只有数据文件中的页面
+ * 校验失败或者比共享文件中的旧，才会用共享文件中的页面覆盖。
+ *
+ * @note 每次都要保证，内存中的数据都是最新的，都比Buffer pool中的数据要新
  */
 class DiskDoubleWriteBuffer : public DoubleWriteBuffer
 {
@@ -103,13 +123,15 @@ public:
    * 将buffer中的页全部写入磁盘，并且清空buffer
    * TODO 目前的解决方案是等buffer装满后再刷盘，可能会导致程序卡住一段时间
    */
-  RC flush_page();
+  RC flush_page() override;
 
   /**
-   * 将页面加入buffer，并且写入磁盘中的共享表空间
+   * 将页面加入buffer，攒够 max_pages 个之后一起写入磁盘中的共享表空间
    */
   RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
+  RC write_logged_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
+
   RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
   /**
@@ -118,22 +140,31 @@ public:
   RC clear_pages(DiskBufferPool *bp) override;
 
   /**
-   * 将共享表空间的页读入buffer
+   * 将共享表空间中完整的页面写回数据文件
+   * @details 只修复数据文件中写了一半(校验和不对)或者比共享文件中旧的页面
    */
   RC recover();
 
 private:
   /**
-   * 将buffer中的页面写入对应的磁盘
+   * @brief 刷盘的实现，调用者需要持有 lock_
    */
-  RC write_page(DoubleWritePage *page);
+  RC flush_page_internal();
 
   /**
-   * 将页面写到当前double write buffer文件中
-   * @details 每次页面更新都应该写入到磁盘中。保证double write buffer
-   * 内存和文件中的数据都是最新的。
+   * 将文件头和页面依次写到double write buffer文件中，不 fsync
    */
-  RC write_page_internal(DoubleWritePage *page);
+  RC write_pages_internal(const vector<DoubleWritePage *> &pages);
+
+  /**
+   * 将页面写入各自的数据文件并 fsync，pages 已经按照 buffer pool 和页号排好序
+   */
+  RC write_home_pages(const vector<DoubleWritePage *> &pages);
+
+  /**
+   * 将buffer中的页面写入对应的磁盘
+   */
+  RC write_page(DoubleWritePage *page);
 
   /**
    * @brief 将磁盘文件中的内容加载到内存中。在启动时调用
@@ -148,6 +179,8 @@ private:
   DoubleWriteBufferHeader header_;
 
   unordered_map<DoubleWritePageKey, DoubleWritePage *, DoubleWritePageKeyHash> dblwr_pages_;
+
+  unordered_set<int32_t> unsynced_buffer_pools_;  /// 跳过二次写直接写入、还没有 fsync 的数据文件
 };
 
 class VacuousDoubleWriteBuffer : public DoubleWriteBuffer
@@ -156,12 +189,16 @@ public:
   virtual ~VacuousDoubleWriteBuffer() = default;
 
   /**
-   * 将页面加入buffer，并且写入磁盘中的共享表空间
+   * 将页面加入buffer，攒够 max_pages 个之后一起写入磁盘中的共享表空间
    */
   RC add_page(DiskBufferPool *bp, PageNum page_num, Page &page) override;
 
+  RC write_logged_page(DiskBufferPool *bp, PageNum page_num, Page &page) override { return add_page(bp, page_num, page); }
+
   RC read_page(DiskBufferPool *bp, PageNum page_num, Page &page) override { return RC::BUFFERPOOL_INVALID_PAGE_NUM; }
 
+  RC flush_page() override { return RC::SUCCESS; }
+
   /**
    * @brief 清空所有与指定buffer pool关联的页面
    */
@@ -75,8 +75,8 @@ public:
    * @details 在 MemPoolSimple 分配和释放一个Frame对象时，不会调用构造函数和析构函数，
    * 而是调用reinit和reset。
    */
-  void reinit() {}
-  void reset() {}
+  void reinit() { image_logged_ = false; }
+  void reset() { image_logged_ = false; }
 
   void clear_page() { memset(&page_, 0, sizeof(page_)); }
 
@@ -132,9 +132,21 @@ public:
    * @brief 重置“脏”标记
    * @details 如果页面已经被写入磁盘文件，则应调用此函数。
    */
-  void clear_dirty() { dirty_ = false; }
+  void clear_dirty()
+  {
+    dirty_        = false;
+    image_logged_ = false;
+  }
   bool dirty() const { return dirty_; }
 
+  /**
+   * @brief 标记页面的完整镜像已经记录到了日志中
+   * @details 这样的页面刷盘时不需要经过 double write buffer，写了一半的页面可以用日志中的镜像修复。
+   * 页面刷盘后清除标记。
+   */
+  void mark_image_logged() { image_logged_ = true; }
+  bool image_logged() const { return image_logged_; }
+
   char *data() { return page_.data; }
 
   bool can_purge() { return pin_count_.load() == 0; }
@@ -172,6 +184,7 @@ private:
   friend class BufferPool;
 
   bool          dirty_ = false;
+  bool          image_logged_ = false;
   atomic<int>   pin_count_{0};
   unsigned long acc_time_ = 0;
   FrameId       frame_id_;
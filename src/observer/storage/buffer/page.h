@@ -17,8 +17,6 @@ See the Mulan PSL v2 for more details. */
 #include "common/types.h"
 #include <stdint.h>
 
-using TrxID = int32_t;
-
 static constexpr PageNum BP_INVALID_PAGE_NUM = -1;
 
 static constexpr PageNum BP_HEADER_PAGE = 0;
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "storage/clog/disk_log_handler.h"
 #include "storage/clog/log_file.h"
 #include "storage/clog/log_replayer.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/chrono.h"
 
 using namespace common;
@@ -37,6 +38,10 @@ RC DiskLogHandler::start()
   }
 
   running_.store(true);
+  {
+    lock_guard lock(mutex_);
+    flusher_active_ = true;
+  }
   thread_ = make_unique<thread>(&DiskLogHandler::thread_func, this);
   LOG_INFO("log handler started");
   return RC::SUCCESS;
@@ -49,7 +54,11 @@ RC DiskLogHandler::stop()
     return RC::INTERNAL;
   }
 
-  running_.store(false);
+  {
+    lock_guard lock(mutex_);
+    running_.store(false);
+    flush_cv_.notify_one();
+  }
 
   LOG_INFO("log handler stopped");
   return RC::SUCCESS;
@@ -84,10 +93,16 @@ RC DiskLogHandler::replay(LogReplayer &replayer, LSN start_lsn)
   };
 
   RC rc = iterate(replay_callback, start_lsn);
+  // 即使遍历失败也要等待已经分发出去的日志回放结束
+  RC finish_rc = replayer.finish_replay();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to iterate log entries. rc=%s", strrc(rc));
     return rc;
   }
+  if (OB_FAIL(finish_rc)) {
+    LOG_WARN("failed to finish replaying log entries. rc=%s", strrc(finish_rc));
+    return finish_rc;
+  }
 
   rc = entry_buffer_.init(max_lsn);
   if (OB_FAIL(rc)) {
@@ -99,6 +114,22 @@ RC DiskLogHandler::replay(LogReplayer &replayer, LSN start_lsn)
   return rc;
 }
 
+RC DiskLogHandler::truncate(LSN lsn)
+{
+  // 还没有刷盘的日志在恢复时可能需要
+  const LSN truncate_lsn = min(lsn, entry_buffer_.flushed_lsn() + 1);
+
+  int removed_count = 0;
+  RC  rc            = file_manager_.truncate(truncate_lsn, removed_count);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to truncate clog files. lsn=%ld, rc=%s", truncate_lsn, strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("truncate clog files done. lsn=%ld, removed files=%d", truncate_lsn, removed_count);
+  return rc;
+}
+
 RC DiskLogHandler::iterate(function<RC(LogEntry&)> consumer, LSN start_lsn)
 {
   vector<string> log_files;
@@ -133,27 +164,41 @@ RC DiskLogHandler::iterate(function<RC(LogEntry&)> consumer, LSN start_lsn)
   return RC::SUCCESS;
 }
 
-RC DiskLogHandler::_append(LSN &lsn, LogModule module, vector<char> &&data)
+RC DiskLogHandler::_append(LSN &lsn, LogModule module, span<const char> data)
 {
   ASSERT(running_.load(), "log handler is not running. lsn=%ld, module=%s, size=%d", 
         lsn, module.name(), data.size());
 
-  RC rc = entry_buffer_.append(lsn, module, std::move(data));
+  RC rc = entry_buffer_.append(lsn, module, data);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to append log entry to buffer. rc=%s", strrc(rc));
     return rc;
   }
 
+  // 缓存中的日志比较多时，不等待超时直接唤醒刷盘线程，避免缓存写满阻塞写日志的线程
+  if (entry_buffer_.half_full()) {
+    flush_cv_.notify_one();
+  }
   return RC::SUCCESS;
 }
 
 RC DiskLogHandler::wait_lsn(LSN lsn)
 {
-  // 直接强制等待。在生产系统中，我们可能会使用条件变量来等待。
-  while (running_.load() && current_flushed_lsn() < lsn) {
-    this_thread::sleep_for(chrono::milliseconds(100));
+  if (current_flushed_lsn() >= lsn) {
+    return RC::SUCCESS;
+  }
+
+  unique_lock lock(mutex_);
+  // 刷盘线程先更新 flushed lsn 再加锁唤醒等待者，所以这里加锁之后需要再检查一次，避免错过唤醒
+  if (current_flushed_lsn() >= lsn || !flusher_active_) {
+    return current_flushed_lsn() >= lsn ? RC::SUCCESS : RC::INTERNAL;
   }
 
+  LsnWaiter waiter;
+  waiters_.emplace(lsn, &waiter);
+  flush_cv_.notify_one();
+  waiter.cv.wait(lock, [&waiter]() { return waiter.done; });
+
   if (current_flushed_lsn() >= lsn) {
     return RC::SUCCESS;
   } else {
@@ -161,20 +206,61 @@ RC DiskLogHandler::wait_lsn(LSN lsn)
   }
 }
 
+bool DiskLogHandler::need_flush() const
+{
+  if (!running_.load()) {
+    return true;
+  }
+
+  if (entry_buffer_.entry_number() == 0) {
+    return false;
+  }
+
+  return !waiters_.empty() || entry_buffer_.half_full();
+}
+
+void DiskLogHandler::wake_waiters(bool all)
+{
+  lock_guard lock(mutex_);
+
+  auto end = all ? waiters_.end() : waiters_.upper_bound(current_flushed_lsn());
+  for (auto iter = waiters_.begin(); iter != end; ++iter) {
+    iter->second->done = true;
+    iter->second->cv.notify_one();
+  }
+  waiters_.erase(waiters_.begin(), end);
+}
+
 void DiskLogHandler::thread_func()
 {
   /*
-  这个线程一直不停的循环，检查日志缓冲区中是否有日志在内存中，如果在内存中就刷新到磁盘。
-  这种做法很粗暴简单，与生产数据库的做法不同。生产数据库通常会在内存达到一定量，或者一定时间
-  之后，会刷新一下磁盘。这样做的好处是减少磁盘的IO次数，提高性能。
+  刷盘线程在条件变量上等待，下面几种情况会被唤醒并刷盘：
+  - 有事务在 wait_lsn 中等待；
+  - 缓存中的日志超过了缓存大小的一半；
+  - 距离上次唤醒超过了 FLUSH_INTERVAL；
+  - 要停止运行。
+  每次刷盘都会把缓存中所有的日志一次写入文件并只做一次 fdatasync，等待期间到达的提交会合并到同一次刷盘中。
   */
   thread_set_name("LogHandler");
   LOG_INFO("log handler thread started");
 
   LogFileWriter file_writer;
-  
+
   RC rc = RC::SUCCESS;
-  while (running_.load() || entry_buffer_.entry_number() > 0) {
+  while (true) {
+    // 日志文件写满时，剩下的日志需要立即写到下一个文件中
+    if (rc != RC::LOG_FILE_FULL) {
+      unique_lock lock(mutex_);
+      flush_cv_.wait_for(lock, FLUSH_INTERVAL, [this]() { return need_flush(); });
+      if (!running_.load() && entry_buffer_.entry_number() == 0) {
+        break;
+      }
+    }
+
+    if (entry_buffer_.entry_number() == 0) {
+      continue;
+    }
+
     if (!file_writer.valid() || rc == RC::LOG_FILE_FULL) {
       if (rc == RC::LOG_FILE_FULL) {
         // 我们在这里判断日志文件是否写满了。
@@ -196,13 +282,22 @@ void DiskLogHandler::thread_func()
     rc = entry_buffer_.flush(file_writer, flush_count);
     if (OB_FAIL(rc) && RC::LOG_FILE_FULL != rc) {
       LOG_WARN("failed to flush log entry buffer. rc=%s", strrc(rc));
+      this_thread::sleep_for(chrono::milliseconds(100));
     }
 
-    if (flush_count == 0 && rc == RC::SUCCESS) {
-      this_thread::sleep_for(chrono::milliseconds(100));
-      continue;
+    if (flush_count > 0) {
+      wake_waiters(false /*all*/);
+    } else if (OB_SUCC(rc)) {
+      // 日志已经分配了LSN但是还没有写完，让出CPU等待写日志的线程
+      this_thread::yield();
     }
   }
 
+  {
+    lock_guard lock(mutex_);
+    flusher_active_ = false;
+  }
+  wake_waiters(true /*all*/);
+
   LOG_INFO("log handler thread stopped");
 }
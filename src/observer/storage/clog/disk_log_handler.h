@@ -20,6 +20,9 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/deque.h"
 #include "common/lang/memory.h"
 #include "common/lang/thread.h"
+#include "common/lang/chrono.h"
+#include "common/lang/map.h"
+#include "common/lang/mutex.h"
 #include "storage/clog/log_module.h"
 #include "storage/clog/log_file.h"
 #include "storage/clog/log_buffer.h"
@@ -31,7 +34,9 @@ class LogReplayer;
  * @brief 对外提供服务的CLog模块
  * @ingroup CLog
  * @details 该模块负责日志的写入、读取、回放等功能。
- * 会在后台开启一个线程，一直尝试刷新内存中的日志到磁盘。
+ * 会在后台开启一个线程刷新内存中的日志到磁盘。刷盘线程平时在条件变量上等待，有事务等待日志落盘、
+ * 缓存中的日志较多或者超过一定时间时才会被唤醒，把缓存中的所有日志一次性写入文件并执行一次fdatasync，
+ * 然后唤醒所有LSN已经落盘的等待者，这样多个并发提交的事务可以共享一次刷盘（group commit）。
  * 所有的CLog日志文件都存放在指定的目录下，每个日志文件按照日志条数来划分。
  * 调用的顺序应该是：
  * @code {.cpp}
@@ -92,7 +97,8 @@ public:
 
   /**
    * @brief 等待指定的日志刷盘
-   *
+   * @details 会唤醒刷盘线程，然后在条件变量上等待，直到刷盘线程把这个LSN刷到磁盘。
+   * 如果刷盘线程已经退出而日志还没有落盘，返回 RC::INTERNAL。
    * @param lsn 想要等待的日志
    */
   RC wait_lsn(LSN lsn) override;
@@ -102,6 +108,18 @@ public:
   /// @brief 当前刷新到哪个日志
   LSN current_flushed_lsn() const { return entry_buffer_.flushed_lsn(); }
 
+  /**
+   * @brief 删除或者归档所有日志都小于 lsn 的日志文件
+   * @details 只会清理已经刷盘的日志
+   */
+  RC truncate(LSN lsn) override;
+
+  /**
+   * @brief 设置日志归档目录
+   * @details 设置之后清理的日志文件会移动到这个目录，而不是直接删除
+   */
+  RC set_archive_directory(const char *directory) { return file_manager_.set_archive_directory(directory); }
+
 private:
   /**
    * @brief 在缓存中增加一条日志
@@ -110,7 +128,7 @@ private:
    * @param[in] module  日志模块
    * @param[in] data    日志数据。具体的数据由各个模块自己定义
    */
-  RC _append(LSN &lsn, LogModule module, vector<char> &&data) override;
+  RC _append(LSN &lsn, LogModule module, span<const char> data) override;
 
 private:
   /**
@@ -118,6 +136,31 @@ private:
    */
   void thread_func();
 
+  /**
+   * @brief 刷盘线程是否需要立即刷盘
+   * @details 需要持有 mutex_
+   */
+  bool need_flush() const;
+
+  /**
+   * @brief 唤醒日志已经落盘的等待者
+   * @param all 是否唤醒所有等待者，刷盘线程退出时使用
+   */
+  void wake_waiters(bool all);
+
+private:
+  /**
+   * @brief 一个等待日志落盘的事务
+   */
+  struct LsnWaiter
+  {
+    condition_variable cv;
+    bool               done = false;  /// 刷盘线程已经处理过这个等待者
+  };
+
+  /// 没有事务等待时，刷盘线程最长等待这么久也会刷一次盘
+  static constexpr chrono::milliseconds FLUSH_INTERVAL{100};
+
 private:
   unique_ptr<thread> thread_;          /// 刷新日志的线程
   atomic_bool        running_{false};  /// 是否还要继续运行
@@ -126,4 +169,9 @@ private:
   LogEntryBuffer entry_buffer_;  /// 缓存日志
 
   string path_;  /// 日志文件存放的目录
+
+  mutex                      mutex_;                  /// 保护下面的几个成员
+  condition_variable         flush_cv_;               /// 唤醒刷盘线程
+  multimap<LSN, LsnWaiter *> waiters_;                /// 按照LSN排序的等待者
+  bool                       flusher_active_ = false; /// 刷盘线程是否还在运行
 };
@@ -14,6 +14,11 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/clog/integrated_log_replayer.h"
 #include "storage/clog/log_entry.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/functional.h"
+#include "common/thread/thread_util.h"
+
+using namespace common;
 
 IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm)
     : buffer_pool_log_replayer_(bpm),
@@ -29,7 +34,29 @@ IntegratedLogReplayer::IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<
       trx_log_replayer_(std::move(trx_log_replayer))
 {}
 
-RC IntegratedLogReplayer::replay(const LogEntry &entry)
+IntegratedLogReplayer::~IntegratedLogReplayer() { (void)finish_replay(); }
+
+int IntegratedLogReplayer::default_worker_num()
+{
+#ifdef CONCURRENCY
+  const int cpu_num = static_cast<int>(thread::hardware_concurrency());
+  return std::clamp(cpu_num, 1, 8);
+#else
+  return 1;
+#endif
+}
+
+void IntegratedLogReplayer::set_worker_num(int worker_num)
+{
+#ifdef CONCURRENCY
+  worker_num_ = worker_num;
+#else
+  (void)worker_num;
+  worker_num_ = 1;
+#endif
+}
+
+RC IntegratedLogReplayer::replay_entry(const LogEntry &entry)
 {
   switch (entry.module().id()) {
     case LogModule::Id::BUFFER_POOL: return buffer_pool_log_replayer_.replay(entry);
@@ -40,9 +67,175 @@ RC IntegratedLogReplayer::replay(const LogEntry &entry)
   }
 }
 
+int IntegratedLogReplayer::worker_index(const LogEntry &entry) const
+{
+  int32_t buffer_pool_id = -1;
+  PageNum page_num       = BP_HEADER_PAGE;
+  switch (entry.module().id()) {
+    case LogModule::Id::BUFFER_POOL:
+    case LogModule::Id::BPLUS_TREE: {
+      // 这两类日志的第一个字段都是 buffer pool id
+      if (entry.payload_size() < static_cast<int32_t>(sizeof(buffer_pool_id))) {
+        return -1;
+      }
+      memcpy(&buffer_pool_id, entry.data(), sizeof(buffer_pool_id));
+    } break;
+
+    case LogModule::Id::RECORD_MANAGER: {
+      if (entry.payload_size() < RecordLogHeader::SIZE) {
+        return -1;
+      }
+      auto *header   = reinterpret_cast<const RecordLogHeader *>(entry.data());
+      buffer_pool_id = header->buffer_pool_id;
+      page_num       = header->page_num;
+    } break;
+
+    default: {
+      return -1;
+    }
+  }
+
+  const uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(buffer_pool_id)) << 32) |
+                       static_cast<uint32_t>(page_num);
+  return static_cast<int>(hash<uint64_t>()(key) % workers_.size());
+}
+
+RC IntegratedLogReplayer::replay(const LogEntry &entry)
+{
+  if (worker_num_ <= 1) {
+    return replay_entry(entry);
+  }
+
+  RC rc = error_rc_.load();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  if (workers_.empty()) {
+    start_workers();
+  }
+
+  const int index = worker_index(entry);
+  if (index < 0) {
+    return replay_entry(entry);
+  }
+  return dispatch(index, entry);
+}
+
+RC IntegratedLogReplayer::dispatch(int index, const LogEntry &entry)
+{
+  // 调用方的日志对象在回调结束后就会被释放，这里复制一份
+  LogEntry copy;
+  RC rc = copy.init(entry.lsn(), entry.module(), vector<char>(entry.data(), entry.data() + entry.payload_size()));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to copy log entry. rc=%s, entry=%s", strrc(rc), entry.to_string().c_str());
+    return rc;
+  }
+
+  ReplayWorker &worker = *workers_[index];
+  worker.batch.push_back(std::move(copy));
+  if (static_cast<int>(worker.batch.size()) >= DISPATCH_BATCH_SIZE) {
+    submit_batch(worker);
+  }
+  return RC::SUCCESS;
+}
+
+void IntegratedLogReplayer::submit_batch(ReplayWorker &worker)
+{
+  if (worker.batch.empty()) {
+    return;
+  }
+
+  unique_lock lock(worker.lock);
+  worker.cond.wait(lock, [&worker]() { return static_cast<int>(worker.entries.size()) < MAX_PENDING_ENTRIES; });
+  for (LogEntry &entry : worker.batch) {
+    worker.entries.push_back(std::move(entry));
+  }
+  worker.batch.clear();
+  worker.cond.notify_all();
+}
+
+void IntegratedLogReplayer::start_workers()
+{
+  for (int i = 0; i < worker_num_; i++) {
+    workers_.push_back(make_unique<ReplayWorker>());
+  }
+  for (auto &worker : workers_) {
+    worker->thread_handle = make_unique<thread>(&IntegratedLogReplayer::worker_func, this, std::ref(*worker));
+  }
+  LOG_INFO("start %d threads to replay log entries", worker_num_);
+}
+
+void IntegratedLogReplayer::worker_func(ReplayWorker &worker)
+{
+  thread_set_name("LogReplayer");
+
+  deque<LogEntry> entries;
+  unique_lock     lock(worker.lock);
+  while (true) {
+    worker.cond.wait(lock, [&worker]() { return !worker.entries.empty() || worker.stopped; });
+    if (worker.entries.empty()) {
+      break;
+    }
+
+    entries.swap(worker.entries);
+    worker.cond.notify_all();
+    lock.unlock();
+
+    // 出错之后继续取出日志但是不再回放，避免分发日志的线程一直等待
+    for (const LogEntry &entry : entries) {
+      if (OB_FAIL(error_rc_.load())) {
+        break;
+      }
+
+      RC rc = replay_entry(entry);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to replay log entry. rc=%s, entry=%s", strrc(rc), entry.to_string().c_str());
+        set_error(rc);
+      }
+    }
+    entries.clear();
+
+    lock.lock();
+  }
+}
+
+void IntegratedLogReplayer::set_error(RC rc)
+{
+  RC expected = RC::SUCCESS;
+  error_rc_.compare_exchange_strong(expected, rc);
+}
+
+RC IntegratedLogReplayer::finish_replay()
+{
+  for (auto &worker : workers_) {
+    submit_batch(*worker);
+
+    lock_guard lock(worker->lock);
+    worker->stopped = true;
+    worker->cond.notify_all();
+  }
+
+  for (auto &worker : workers_) {
+    worker->thread_handle->join();
+  }
+
+  if (!workers_.empty()) {
+    LOG_INFO("all log replay threads finished. rc=%s", strrc(error_rc_.load()));
+  }
+  workers_.clear();
+  return error_rc_.load();
+}
+
 RC IntegratedLogReplayer::on_done()
 {
-  RC rc = buffer_pool_log_replayer_.on_done();
+  RC rc = finish_replay();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to finish replaying log entries. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = buffer_pool_log_replayer_.on_done();
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to do buffer pool log replay. rc=%s", strrc(rc));
     return rc;
@@ -66,4 +259,4 @@ RC IntegratedLogReplayer::on_done()
   }
 
   return RC::SUCCESS;
-}
\ No newline at end of file
+}
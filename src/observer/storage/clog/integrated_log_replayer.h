@@ -14,6 +14,13 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/atomic.h"
+#include "common/lang/condition_variable.h"
+#include "common/lang/deque.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "storage/clog/log_entry.h"
 #include "storage/clog/log_replayer.h"
 #include "storage/buffer/buffer_pool_log.h"
 #include "storage/record/record_log.h"
@@ -25,7 +32,15 @@ class BufferPoolManager;
 /**
  * @brief 整体日志回放类
  * @ingroup Clog
- * @details 负责回放所有日志，是其它各模块日志回放的分发器
+ * @details 负责回放所有日志，是其它各模块日志回放的分发器。
+ * 页面相关的日志会按照页面分发到多个线程中并行回放，同一个页面的日志总是由同一个线程按照LSN的顺序回放：
+ * - RECORD_MANAGER: 每条日志只修改一个页面，按照 (buffer_pool_id, page_num) 分发；
+ * - BPLUS_TREE: 一条日志可能修改多个页面（比如分裂），并且回放时需要读取索引的头页面，
+ *   所以同一个索引文件的日志都交给同一个线程，保证结构修改操作之间的顺序；
+ * - BUFFER_POOL: 修改的是文件的头页面，与 BPLUS_TREE 一样按照 buffer_pool_id 分发；
+ * - TRANSACTION: 事务日志在回放时只记录事务做了哪些操作，不访问页面，在调用线程中按顺序回放。
+ *   未提交事务的回滚在 on_done 中执行，这时所有页面的日志都已经回放完成。
+ * 缓冲池的锁只在 CONCURRENCY 编译模式下生效，所以其它模式下总是在调用线程中串行回放。
  */
 class IntegratedLogReplayer : public LogReplayer
 {
@@ -44,17 +59,74 @@ public:
    * 区别于另一个构造函数，这个构造函数可以指定不同的事务日志回放器。比如进程启动时可以指定选择使用VacuousTrx还是MvccTrx。
    */
   IntegratedLogReplayer(BufferPoolManager &bpm, unique_ptr<LogReplayer> trx_log_replayer);
-  virtual ~IntegratedLogReplayer() = default;
+  virtual ~IntegratedLogReplayer();
+
+  /**
+   * @brief 设置回放页面日志的线程数
+   * @details 需要在回放第一条日志之前设置。小于等于1时在调用线程中串行回放，非 CONCURRENCY 模式下总是串行回放
+   */
+  void set_worker_num(int worker_num);
+  int  worker_num() const { return worker_num_; }
+
+  /**
+   * @brief 默认的回放线程数
+   */
+  static int default_worker_num();
 
   //! @copydoc LogReplayer::replay
   RC replay(const LogEntry &entry) override;
 
+  //! @copydoc LogReplayer::finish_replay
+  RC finish_replay() override;
+
   //! @copydoc LogReplayer::on_done
   RC on_done() override;
 
+private:
+  /**
+   * @brief 回放日志的线程，按照顺序回放分发给它的日志
+   */
+  struct ReplayWorker
+  {
+    mutex              lock;
+    condition_variable cond;               ///< 有新的日志、日志回放完成或者需要退出
+    deque<LogEntry>    entries;            ///< 等待回放的日志
+    bool               stopped = false;    ///< 所有日志都已经分发完成
+    unique_ptr<thread> thread_handle;
+
+    vector<LogEntry> batch;  ///< 分发线程攒批的日志，只由分发线程访问
+  };
+
+  /// 每个线程最多缓存多少条等待回放的日志，超过后分发日志的线程需要等待
+  static constexpr int MAX_PENDING_ENTRIES = 4096;
+  /// 分发线程每攒够这么多条日志才交给回放线程，减少加锁和唤醒的次数
+  static constexpr int DISPATCH_BATCH_SIZE = 64;
+
+  /**
+   * @brief 交给对应的模块回放日志
+   */
+  RC replay_entry(const LogEntry &entry);
+
+  /**
+   * @brief 计算日志应该由哪个线程回放
+   * @return 返回-1表示在调用线程中回放
+   */
+  int worker_index(const LogEntry &entry) const;
+
+  RC   dispatch(int index, const LogEntry &entry);
+  void submit_batch(ReplayWorker &worker);
+  void start_workers();
+  void worker_func(ReplayWorker &worker);
+  void set_error(RC rc);
+
 private:
   BufferPoolLogReplayer   buffer_pool_log_replayer_;  ///< 缓冲池日志回放器
   RecordLogReplayer       record_log_replayer_;       ///< record manager 日志回放器
   BplusTreeLogReplayer    bplus_tree_log_replayer_;   ///< bplus tree 日志回放器
   unique_ptr<LogReplayer> trx_log_replayer_;          ///< trx 日志回放器
-};
\ No newline at end of file
+
+  int                              worker_num_ = default_worker_num();  ///< 回放页面日志的线程数
+  vector<unique_ptr<ReplayWorker>> workers_;                            ///< 回放页面日志的线程
+
+  atomic<RC> error_rc_{RC::SUCCESS};  ///< 回放线程遇到的第一个错误
+};
@@ -12,9 +12,14 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2024/01/31
 //
 
+#include <string.h>
+
 #include "storage/clog/log_buffer.h"
 #include "storage/clog/log_file.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/chrono.h"
+#include "common/lang/thread.h"
+#include "common/log/log.h"
 
 using namespace common;
 
@@ -22,77 +27,115 @@ RC LogEntryBuffer::init(LSN lsn, int32_t max_bytes /*= 0*/)
 {
   current_lsn_.store(lsn);
   flushed_lsn_.store(lsn);
+  bytes_.store(0);
 
   if (max_bytes > 0) {
     max_bytes_ = max_bytes;
   }
+
+  slot_count_  = std::max(max_bytes_ / SLOT_SIZE, 2);
+  slots_       = make_unique<Slot[]>(slot_count_);
+  slot_memory_ = make_unique<char[]>(static_cast<size_t>(slot_count_) * SLOT_SIZE);
   return RC::SUCCESS;
 }
 
-RC LogEntryBuffer::append(LSN &lsn, LogModule::Id module_id, vector<char> &&data)
+RC LogEntryBuffer::append(LSN &lsn, LogModule::Id module_id, span<const char> data)
 {
-  return append(lsn, LogModule(module_id), std::move(data));
+  return append(lsn, LogModule(module_id), data);
 }
 
-RC LogEntryBuffer::append(LSN &lsn, LogModule module, vector<char> &&data)
+RC LogEntryBuffer::append(LSN &lsn, LogModule module, span<const char> data)
 {
+  if (static_cast<int64_t>(data.size()) > LogEntry::max_payload_size()) {
+    LOG_WARN("log entry size is too large. size=%ld, max_payload_size=%d", data.size(), LogEntry::max_payload_size());
+    return RC::INVALID_ARGUMENT;
+  }
+
   /// 控制当前buffer使用的内存
   /// 简单粗暴，强制原地等待
   /// 但是如果当前想要新插入的日志比较大，不会做控制。所以理论上容纳的最大buffer内存是2*max_bytes_
   while (bytes_.load() >= max_bytes_) {
-    this_thread::sleep_for(chrono::milliseconds(10));
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  lsn = current_lsn_.fetch_add(1) + 1;
+
+  // 槽位上一轮的日志还没有刷盘，说明缓冲区满了
+  while (lsn - flushed_lsn_.load() > slot_count_) {
+    this_thread::sleep_for(chrono::milliseconds(1));
   }
 
-  LogEntry entry;
-  RC rc = entry.init(lsn, module, std::move(data));
-  if (OB_FAIL(rc)) {
-    LOG_WARN("failed to init log entry. rc=%s", strrc(rc));
-    return rc;
+  Slot         &slot       = slot_of(lsn);
+  const int32_t total_size = LogHeader::SIZE + static_cast<int32_t>(data.size());
+
+  char *buffer = nullptr;
+  if (total_size <= SLOT_SIZE) {
+    buffer = slot_memory_.get() + (lsn % slot_count_) * SLOT_SIZE;
+  } else {
+    if (static_cast<int32_t>(slot.overflow.size()) < total_size) {
+      slot.overflow.resize(total_size);
+    }
+    buffer = slot.overflow.data();
   }
 
-  lock_guard guard(mutex_);
-  lsn = ++current_lsn_;
-  entry.set_lsn(lsn);
+  LogHeader header;
+  header.lsn       = lsn;
+  header.size      = static_cast<int32_t>(data.size());
+  header.module_id = module.index();
+  memcpy(buffer, &header, LogHeader::SIZE);
+  if (!data.empty()) {
+    memcpy(buffer + LogHeader::SIZE, data.data(), data.size());
+  }
 
-  entries_.push_back(std::move(entry));
-  bytes_ += entry.total_size();
+  slot.size = total_size;
+  bytes_ += total_size;
+  slot.lsn.store(lsn, std::memory_order_release);
   return RC::SUCCESS;
 }
 
+const char *LogEntryBuffer::slot_data(LSN lsn) const
+{
+  const Slot &slot = slots_[lsn % slot_count_];
+  if (slot.size <= SLOT_SIZE) {
+    return slot_memory_.get() + (lsn % slot_count_) * SLOT_SIZE;
+  }
+  return slot.overflow.data();
+}
+
 RC LogEntryBuffer::flush(LogFileWriter &writer, int &count)
 {
   count = 0;
 
-  while (entry_number() > 0) {
-    LogEntry entry;
-    {
-      lock_guard guard(mutex_);
-      if (entries_.empty()) {
-        break;
-      }
-
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
-      entry = std::move(entries_.front());
-      ASSERT(entry.payload_size() > 0 && entry.lsn() > 0, "invalid log entry");
-      entries_.pop_front();
-      bytes_ -= entry.total_size();
-    }
-    
-    RC rc = writer.write(entry);
-    if (OB_FAIL(rc)) {
-      lock_guard guard(mutex_);
-      entries_.emplace_front(std::move(entry));
-      LogEntry &front_entry = entries_.front();
-      ASSERT(front_entry.lsn() > 0 && front_entry.payload_size() > 0, "invalid log entry");
-      return rc;
-    } else {
-      ++count;
-      flushed_lsn_ = entry.lsn();
+  // 从第一条没有刷盘的日志开始，取出所有连续的已经写好的日志，合并成一次写入和刷盘
+  const LSN start_lsn = flushed_lsn_.load() + 1;
+  const LSN end_lsn   = current_lsn_.load();
+
+  vector<span<const char>> entries;
+  for (LSN lsn = start_lsn; lsn <= end_lsn; lsn++) {
+    Slot &slot = slot_of(lsn);
+    if (slot.lsn.load(std::memory_order_acquire) != lsn) {
+      break;
     }
+    entries.emplace_back(slot_data(lsn), slot.size);
   }
-  
-  return RC::SUCCESS;
+
+  if (entries.empty()) {
+    return RC::SUCCESS;
+  }
+
+  RC rc = writer.write(entries, count);
+
+  int64_t written_bytes = 0;
+  for (int i = 0; i < count; i++) {
+    written_bytes += entries[i].size();
+  }
+
+  if (count > 0) {
+    bytes_ -= written_bytes;
+    // 更新 flushed lsn 之后，这些槽位就可以被新的日志使用了
+    flushed_lsn_.store(start_lsn + count - 1);
+  }
+  return rc;
 }
 
 int64_t LogEntryBuffer::bytes() const
@@ -102,5 +145,10 @@ int64_t LogEntryBuffer::bytes() const
 
 int32_t LogEntryBuffer::entry_number() const
 {
-  return entries_.size();
+  return static_cast<int32_t>(current_lsn_.load() - flushed_lsn_.load());
+}
+
+bool LogEntryBuffer::half_full() const
+{
+  return bytes_.load() >= max_bytes_ / 2 || entry_number() >= slot_count_ / 2;
 }
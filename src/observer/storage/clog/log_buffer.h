@@ -16,10 +16,10 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/sys/rc.h"
 #include "common/types.h"
-#include "common/lang/mutex.h"
 #include "common/lang/vector.h"
-#include "common/lang/deque.h"
+#include "common/lang/span.h"
 #include "common/lang/atomic.h"
+#include "common/lang/memory.h"
 #include "storage/clog/log_module.h"
 #include "storage/clog/log_entry.h"
 
@@ -29,26 +29,39 @@ class LogFileWriter;
  * @brief 日志数据缓冲区
  * @ingroup CLog
  * @details 缓存一部分日志在内存中而不是直接写入磁盘。
- * 这里的缓存没有考虑高性能操作，比如使用预分配内存、环形缓冲池等。
- * 在生产数据库中，通常会使用预分配内存形式的缓存来提高性能，并且可以减少内存碎片。
+ * 缓冲区是一个预先分配好的环形数组，每个槽位对应一条日志，LSN 为 lsn 的日志放在 lsn % slot_count 的槽位上。
+ * 写日志时不需要加锁：
+ * 1. 使用原子的 fetch_add 分配 LSN，也就确定了槽位；
+ * 2. 等待这个槽位上一轮的日志刷盘（缓冲区满时才会发生）；
+ * 3. 把日志头和日志数据序列化到槽位的内存中，然后发布槽位的 LSN。
+ * 每个槽位有固定大小的内存，日志比较大时使用槽位自己的溢出内存，溢出内存会一直复用。
+ * 刷盘只有一个线程，它从 flushed_lsn + 1 开始，找到连续的已经发布的槽位，直接把槽位中的数据写入文件。
  */
 class LogEntryBuffer
 {
 public:
-  LogEntryBuffer()  = default;
+  /// 没有回放日志就直接写日志时，LSN 从 0 开始
+  LogEntryBuffer() { init(0); }
   ~LogEntryBuffer() = default;
 
+  /**
+   * @brief 初始化缓冲区
+   * @param lsn 当前最大的LSN，下一条日志的LSN是 lsn + 1
+   * @param max_bytes 缓冲区的内存大小，决定了槽位的个数
+   */
   RC init(LSN lsn, int32_t max_bytes = 0);
 
   /**
    * @brief 在缓冲区中追加一条日志
+   * @details 可以多个线程同时调用。缓冲区满时会等待刷盘线程刷新日志
    */
-  RC append(LSN &lsn, LogModule::Id module_id, vector<char> &&data);
-  RC append(LSN &lsn, LogModule module, vector<char> &&data);
+  RC append(LSN &lsn, LogModule::Id module_id, span<const char> data);
+  RC append(LSN &lsn, LogModule module, span<const char> data);
 
   /**
    * @brief 刷新缓冲区中的日志到磁盘
-   *
+   * @details 取出缓冲区中所有连续的已经写好的日志，合并成一次写入和一次刷盘。
+   * 同一时间只能有一个线程调用。没有写入的日志会留在缓冲区中
    * @param file_handle 使用它来写文件
    * @param count 刷了多少条日志
    */
@@ -60,17 +73,45 @@ public:
   int64_t bytes() const;
 
   /**
-   * @brief 当前缓冲区中有多少条日志
+   * @brief 当前缓冲区中有多少条日志，包括正在写入的日志
    */
   int32_t entry_number() const;
 
+  /**
+   * @brief 缓冲区最大字节数，超过后追加日志会等待
+   */
+  int32_t max_bytes() const { return max_bytes_; }
+
+  /**
+   * @brief 缓冲区是否已经用了一半，这时应该尽快刷盘
+   */
+  bool half_full() const;
+
   LSN current_lsn() const { return current_lsn_.load(); }
   LSN flushed_lsn() const { return flushed_lsn_.load(); }
 
 private:
-  mutex           mutex_;  /// 当前数据结构一定会在多线程中访问，所以强制使用有效的锁，而不是有条件生效的common::Mutex
-  deque<LogEntry> entries_;  /// 日志缓冲区
-  atomic<int64_t> bytes_;    /// 当前缓冲区中的日志数据大小
+  /**
+   * @brief 缓冲区中的一个槽位
+   */
+  struct Slot
+  {
+    atomic<LSN>  lsn{0};     /// 日志写入完成后设置为日志的LSN，刷盘线程据此判断日志是否可以刷盘
+    int32_t      size = 0;   /// 日志大小，包含日志头
+    vector<char> overflow;   /// 日志超过槽位大小时使用的内存
+  };
+
+  Slot &slot_of(LSN lsn) { return slots_[lsn % slot_count_]; }
+  const char *slot_data(LSN lsn) const;
+
+private:
+  static constexpr int32_t SLOT_SIZE = 512;  /// 每个槽位预先分配的内存大小
+
+  unique_ptr<Slot[]> slots_;           /// 槽位
+  unique_ptr<char[]> slot_memory_;     /// 所有槽位预先分配的连续内存
+  int32_t            slot_count_ = 0;  /// 槽位个数
+
+  atomic<int64_t> bytes_{0};  /// 当前缓冲区中的日志数据大小
 
   atomic<LSN> current_lsn_{0};
   atomic<LSN> flushed_lsn_{0};
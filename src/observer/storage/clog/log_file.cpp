@@ -13,7 +13,11 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
 
+#include "common/lang/algorithm.h"
 #include "common/lang/string_view.h"
 #include "common/lang/charconv.h"
 #include "common/log/log.h"
@@ -155,7 +159,8 @@ RC LogFileWriter::open(const char *filename, int end_lsn)
   filename_ = filename;
   end_lsn_ = end_lsn;
 
-  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT | O_SYNC, 0644);
+  // 不使用 O_SYNC，每批日志写完之后调用一次 fdatasync
+  fd_ = ::open(filename, O_WRONLY | O_APPEND | O_CREAT, 0644);
   if (fd_ < 0) {
     LOG_WARN("open file failed. filename=%s, error=%s", filename, strerror(errno));
     return RC::FILE_OPEN;
@@ -178,40 +183,121 @@ RC LogFileWriter::close()
 
 RC LogFileWriter::write(LogEntry &entry)
 {
-  // 一个日志文件写的日志条数是有限制的
-  if (entry.lsn() > end_lsn_) {
-    return RC::LOG_FILE_FULL;
+  vector<char> buffer(entry.total_size());
+  memcpy(buffer.data(), &entry.header(), LogHeader::SIZE);
+  memcpy(buffer.data() + LogHeader::SIZE, entry.data(), entry.payload_size());
+
+  int count = 0;
+  return write({span<const char>(buffer.data(), buffer.size())}, count);
+}
+
+/**
+ * @brief 把文件数据刷新到磁盘
+ */
+static int sync_data(int fd)
+{
+#ifdef __APPLE__
+  return ::fsync(fd);
+#else
+  return ::fdatasync(fd);
+#endif
+}
+
+/**
+ * @brief 使用 writev 写入所有数据，处理只写入一部分的情况
+ * @return 0 表示成功，否则返回 errno
+ */
+static int writevn(int fd, iovec *iovs, int iov_num)
+{
+  while (iov_num > 0) {
+    const ssize_t ret = ::writev(fd, iovs, std::min(iov_num, IOV_MAX));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return errno;
+    }
+
+    size_t written = static_cast<size_t>(ret);
+    while (iov_num > 0 && written >= iovs->iov_len) {
+      written -= iovs->iov_len;
+      iovs++;
+      iov_num--;
+    }
+    if (iov_num > 0) {
+      iovs->iov_base = static_cast<char *>(iovs->iov_base) + written;
+      iovs->iov_len -= written;
+    }
   }
+  return 0;
+}
 
+RC LogFileWriter::write(const vector<span<const char>> &entries, int &count)
+{
+  count = 0;
   if (fd_ < 0) {
     return RC::FILE_NOT_OPENED;
   }
 
-  if (entry.lsn() <= last_lsn_) {
-    LOG_WARN("write log entry failed. lsn is too small. filename=%s, last_lsn=%ld, entry=%s", 
-             filename_.c_str(), last_lsn_, entry.to_string().c_str());
-    return RC::INVALID_ARGUMENT;
+  RC            stop_rc  = RC::SUCCESS;  // 没有写入全部日志的原因
+  LSN           last_lsn = last_lsn_;
+  vector<iovec> iovs;
+  iovs.reserve(entries.size());
+  for (const span<const char> &entry : entries) {
+    LogHeader header;
+    memcpy(&header, entry.data(), LogHeader::SIZE);
+    // 一个日志文件写的日志条数是有限制的
+    if (header.lsn > end_lsn_) {
+      stop_rc = RC::LOG_FILE_FULL;
+      break;
+    }
+
+    if (header.lsn <= last_lsn) {
+      LOG_WARN("write log entry failed. lsn is too small. filename=%s, last_lsn=%ld, entry=%s", 
+               filename_.c_str(), last_lsn, header.to_string().c_str());
+      stop_rc = RC::INVALID_ARGUMENT;
+      break;
+    }
+
+    iovs.push_back(iovec{const_cast<char *>(entry.data()), entry.size()});
+    last_lsn = header.lsn;
   }
 
-  /// WARNING 这里需要处理日志写一半的情况
-  /// 日志只写成功一部分到文件中非常难处理
-  int ret = writen(fd_, reinterpret_cast<const char *>(&entry.header()), LogHeader::SIZE);
-  if (0 != ret) {
-    LOG_WARN("write log entry header failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
-    return RC::IOERR_WRITE;
+  if (iovs.empty()) {
+    return stop_rc;
   }
 
-  ret = writen(fd_, entry.data(), entry.payload_size());
+  const off_t offset = ::lseek(fd_, 0, SEEK_END);
+  if (offset < 0) {
+    LOG_WARN("failed to get log file size. filename=%s, error=%s", filename_.c_str(), strerror(errno));
+    return RC::IOERR_SEEK;
+  }
+
+  /// 日志只写成功一部分到文件中非常难处理，所以失败时把文件截断到写入之前的大小
+  const int entry_num = static_cast<int>(iovs.size());
+  int       ret       = writevn(fd_, iovs.data(), entry_num);
+  RC        rc        = RC::SUCCESS;
   if (0 != ret) {
-    LOG_WARN("write log entry payload failed. filename=%s, ret = %d, error=%s, entry=%s", 
-             filename_.c_str(), ret, strerror(errno), entry.to_string().c_str());
-    return RC::IOERR_WRITE;
+    LOG_WARN("write log entries failed. filename=%s, error=%s, entry num=%d", 
+             filename_.c_str(), strerror(ret), entry_num);
+    rc = RC::IOERR_WRITE;
+  } else if (0 != sync_data(fd_)) {
+    LOG_WARN("sync log file failed. filename=%s, error=%s", filename_.c_str(), strerror(errno));
+    rc = RC::IOERR_SYNC;
   }
 
-  last_lsn_ = entry.lsn();
-  LOG_TRACE("write log entry success. filename=%s, entry=%s", filename_.c_str(), entry.to_string().c_str());
-  return RC::SUCCESS;
+  if (OB_FAIL(rc)) {
+    if (0 != ::ftruncate(fd_, offset)) {
+      LOG_ERROR("failed to truncate log file after write failure. filename=%s, offset=%ld, error=%s",
+                filename_.c_str(), offset, strerror(errno));
+    }
+    return rc;
+  }
+
+  count     = entry_num;
+  last_lsn_ = last_lsn;
+  LOG_TRACE("write log entries success. filename=%s, entry num=%d, last lsn=%ld", filename_.c_str(), count, last_lsn);
+  return stop_rc;
 }
 
 bool LogFileWriter::valid() const
@@ -294,25 +380,86 @@ RC LogFileManager::get_lsn_from_filename(const string &filename, LSN &lsn)
   return RC::SUCCESS;
 }
 
+RC LogFileManager::set_archive_directory(const char *directory)
+{
+  filesystem::path archive_directory = filesystem::absolute(filesystem::path(directory));
+  if (!filesystem::is_directory(archive_directory)) {
+    error_code ec;
+    bool ret = filesystem::create_directories(archive_directory, ec);
+    if (!ret) {
+      LOG_WARN("create archive directory failed. directory=%s, error=%s", archive_directory.c_str(), ec.message().c_str());
+      return RC::FILE_CREATE;
+    }
+  }
+
+  lock_guard guard(lock_);
+  archive_directory_ = archive_directory;
+  LOG_INFO("set clog archive directory. directory=%s", archive_directory_.c_str());
+  return RC::SUCCESS;
+}
+
 RC LogFileManager::list_files(vector<string> &files, LSN start_lsn)
 {
   files.clear();
 
-  // 这里的代码是AI自动生成的
-  // 其实写的不好，我们只需要找到比start_lsn相等或者小的第一个日志文件就可以了
-  for (auto &file : log_files_) {
-    if (file.first + max_entry_number_per_file_ - 1 >= start_lsn) {
-      files.emplace_back(file.second.string());
+  lock_guard guard(lock_);
+
+  // 包含 start_lsn 的文件是起始LSN小于等于 start_lsn 的最后一个文件
+  auto iter = log_files_.upper_bound(start_lsn);
+  if (iter != log_files_.begin()) {
+    --iter;
+    if (iter->first + max_entry_number_per_file_ - 1 < start_lsn) {
+      ++iter;
     }
   }
 
+  for (; iter != log_files_.end(); ++iter) {
+    files.emplace_back(iter->second.string());
+  }
+
+  return RC::SUCCESS;
+}
+
+RC LogFileManager::truncate(LSN lsn, int &removed_count)
+{
+  removed_count = 0;
+
+  lock_guard guard(lock_);
+  while (log_files_.size() > 1) {
+    auto iter = log_files_.begin();
+    const LSN max_lsn = iter->first + max_entry_number_per_file_ - 1;
+    if (max_lsn >= lsn) {
+      break;
+    }
+
+    const filesystem::path &file_path = iter->second;
+    error_code ec;
+    if (archive_directory_.empty()) {
+      filesystem::remove(file_path, ec);
+    } else {
+      filesystem::rename(file_path, archive_directory_ / file_path.filename(), ec);
+    }
+
+    if (ec) {
+      LOG_WARN("failed to %s log file. file=%s, error=%s",
+               archive_directory_.empty() ? "remove" : "archive", file_path.c_str(), ec.message().c_str());
+      return RC::IOERR_WRITE;
+    }
+
+    LOG_INFO("%s log file. file=%s, max lsn=%ld, truncate lsn=%ld",
+             archive_directory_.empty() ? "remove" : "archive", file_path.c_str(), max_lsn, lsn);
+    log_files_.erase(iter);
+    removed_count++;
+  }
+
   return RC::SUCCESS;
 }
 
 RC LogFileManager::last_file(LogFileWriter &file_writer)
 {
+  lock_guard guard(lock_);
   if (log_files_.empty()) {
-    return next_file(file_writer);
+    return next_file_locked(file_writer);
   }
 
   file_writer.close();
@@ -323,6 +470,12 @@ RC LogFileManager::last_file(LogFileWriter &file_writer)
 }
 
 RC LogFileManager::next_file(LogFileWriter &file_writer)
+{
+  lock_guard guard(lock_);
+  return next_file_locked(file_writer);
+}
+
+RC LogFileManager::next_file_locked(LogFileWriter &file_writer)
 {
   file_writer.close();
 
@@ -17,10 +17,13 @@ See the Mulan PSL v2 for more details. */
 #include "common/sys/rc.h"
 #include "common/types.h"
 #include "common/lang/map.h"
+#include "common/lang/mutex.h"
 #include "common/lang/functional.h"
 #include "common/lang/filesystem.h"
 #include "common/lang/fstream.h"
 #include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/lang/span.h"
 
 class LogEntry;
 
@@ -73,9 +76,18 @@ public:
   /// @brief 关闭当前文件
   RC close();
 
-  /// @brief 写入一条日志
+  /// @brief 写入一条日志，返回时已经刷新到磁盘
   RC write(LogEntry &entry);
 
+  /**
+   * @brief 批量写入日志
+   * @details 使用 writev 直接把所有日志写入文件，再调用一次 fdatasync 刷盘。
+   * 只会写入当前文件可以容纳的日志，写入或刷盘失败时会把文件截断到写入之前的大小，这样失败的日志可以重新写入
+   * @param entries 按照LSN递增排列的日志，每条都是序列化之后的日志头加上日志数据
+   * @param[out] count 成功写入的日志条数。如果没有全部写入，会返回 LOG_FILE_FULL 或者其它错误
+   */
+  RC write(const vector<span<const char>> &entries, int &count);
+
   /**
    * @brief 当前文件是否已经打开
    */
@@ -117,14 +129,31 @@ public:
    */
   RC init(const char *directory, int max_entry_number_per_file);
 
+  /**
+   * @brief 设置日志归档目录
+   * @details 设置之后清理日志文件时会把文件移动到归档目录中，否则直接删除。目录不存在时会创建
+   */
+  RC set_archive_directory(const char *directory);
+
   /**
    * @brief 列出所有的日志文件，第一个日志文件包含大于等于start_lsn最小的日志
+   * @details 在内存中按照文件的起始LSN查找，不会扫描目录
    *
    * @param files 满足条件的所有日志文件名
    * @param start_lsn 想要查找的日志的最小LSN
    */
   RC list_files(vector<string> &files, LSN start_lsn);
 
+  /**
+   * @brief 清理恢复时不再需要的日志文件
+   * @details 文件中最大的LSN小于 lsn 的日志文件会被删除或者移动到归档目录。
+   * 最后一个日志文件可能正在写入，总是保留。
+   *
+   * @param lsn 恢复时需要回放的最小LSN，通常是最近一次检查点的LSN
+   * @param removed_count 清理了多少个日志文件
+   */
+  RC truncate(LSN lsn, int &removed_count);
+
   /**
    * @brief 获取最新的一个日志文件名
    * @details 如果当前有文件就获取最后一个日志文件，否则创建一个日志文件，也就是第一个日志文件
@@ -138,6 +167,11 @@ public:
   RC next_file(LogFileWriter &file_writer);
 
 private:
+  /**
+   * @brief 创建下一个日志文件，调用方需要持有 lock_
+   */
+  RC next_file_locked(LogFileWriter &file_writer);
+
   /**
    * @brief 从文件名称中获取LSN
    * @details 如果日志文件名不符合要求，就返回失败
@@ -149,7 +183,9 @@ private:
   static constexpr const char *file_suffix_ = ".log";
 
   filesystem::path directory_;                  /// 日志文件存放的目录
+  filesystem::path archive_directory_;          /// 日志归档目录，为空时清理日志直接删除文件
   int              max_entry_number_per_file_;  /// 一个文件最大允许存放多少条日志
 
+  mutex                      lock_;       /// 保护 log_files_，刷盘线程会创建新文件，检查点会清理旧文件
   map<LSN, filesystem::path> log_files_;  /// 日志文件名和第一个LSN的映射
 };
@@ -96,6 +96,13 @@ public:
 
   virtual LSN current_lsn() const = 0;
 
+  /**
+   * @brief 清理恢复时不再需要的日志
+   * @details 在检查点完成之后调用，小于 lsn 的日志不会再被回放
+   * @param lsn 恢复时需要回放的最小LSN
+   */
+  virtual RC truncate(LSN lsn) = 0;
+
   static RC create(const char *name, LogHandler *&handler);
 
 private:
@@ -103,5 +110,5 @@ private:
    * @brief 写入一条日志
    * @details 子类应该重现实现这个函数
    */
-  virtual RC _append(LSN &lsn, LogModule module, vector<char> &&data) = 0;
+  virtual RC _append(LSN &lsn, LogModule module, span<const char> data) = 0;
 };
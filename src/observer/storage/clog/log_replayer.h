@@ -35,6 +35,12 @@ public:
    */
   virtual RC replay(const LogEntry &entry) = 0;
 
+  /**
+   * @brief 所有日志都已经交给 replay 之后调用，返回时所有日志都已经回放完成
+   * @details 回放可以是异步的，比如分发给多个线程并行回放。与 on_done 不同，调用这个函数时日志模块还没有启动
+   */
+  virtual RC finish_replay() { return RC::SUCCESS; }
+
   /**
    * @brief 当所有日志回放完成时的回调函数
    */
@@ -27,9 +27,19 @@ RC Chunk::reference(Chunk &chunk)
     columns_[i]->reference(chunk.column(i));
     column_ids_.push_back(chunk.column_ids(i));
   }
+  selection_     = chunk.selection_;
+  has_selection_ = chunk.has_selection_;
   return RC::SUCCESS;
 }
 
+void Chunk::add_columns_like(const Chunk &chunk, int capacity)
+{
+  for (const unique_ptr<Column> &column : chunk.columns_) {
+    int col_id = static_cast<int>(columns_.size());
+    add_column(make_unique<Column>(column->attr_type(), column->attr_len(), capacity), col_id);
+  }
+}
+
 int Chunk::rows() const
 {
   if (!columns_.empty()) {
@@ -46,15 +56,84 @@ int Chunk::capacity() const
   return 0;
 }
 
+void Chunk::set_selection(vector<int> &&selection)
+{
+  selection_     = std::move(selection);
+  has_selection_ = true;
+}
+
+void Chunk::set_selection(const vector<uint8_t> &select)
+{
+  const int rows = this->rows();
+  selection_.clear();
+  for (int i = 0; i < rows; i++) {
+    if (select[i] != 0) {
+      selection_.push_back(i);
+    }
+  }
+  has_selection_ = static_cast<int>(selection_.size()) != rows;
+}
+
+void Chunk::clear_selection()
+{
+  selection_.clear();
+  has_selection_ = false;
+}
+
+void Chunk::init_select(vector<uint8_t> &select) const
+{
+  if (!has_selection_) {
+    select.assign(rows(), 1);
+    return;
+  }
+  select.assign(rows(), 0);
+  for (int row : selection_) {
+    select[row] = 1;
+  }
+}
+
+void Chunk::truncate(int rows)
+{
+  if (rows >= selected_rows()) {
+    return;
+  }
+  if (has_selection_) {
+    selection_.resize(rows);
+    return;
+  }
+  for (auto &col : columns_) {
+    col->set_count(rows);
+  }
+}
+
+RC Chunk::materialize(Chunk &output) const
+{
+  output.reset();
+  const int rows = selected_rows();
+  for (size_t i = 0; i < columns_.size(); i++) {
+    const Column &column = *columns_[i];
+    auto          copy   = make_unique<Column>(column.attr_type(), column.attr_len(), std::max(rows, 1));
+    RC            rc     = has_selection_ ? copy->append_selected(column, selection_) : copy->append_rows(column, 0, rows);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to materialize column. rc=%s", strrc(rc));
+      return rc;
+    }
+    output.add_column(std::move(copy), column_ids_[i]);
+  }
+  return RC::SUCCESS;
+}
+
 void Chunk::reset_data()
 {
   for (auto &col : columns_) {
     col->reset_data();
   }
+  clear_selection();
 }
 
 void Chunk::reset()
 {
   columns_.clear();
   column_ids_.clear();
+  clear_selection();
 }
\ No newline at end of file
@@ -18,23 +18,31 @@ See the Mulan PSL v2 for more details. */
 
 /**
  * @brief A Chunk represents a set of columns.
+ * @details Chunk 可以带一个选择向量(selection vector)，记录有效的行在列中的下标，按照下标递增。
+ * 过滤时只生成选择向量，不拷贝列数据，需要连续的数据时（比如物化、输出给客户端）再按照选择向量取值，
+ * 这样没有被读取的列就不需要拷贝（延迟物化）。
+ * 没有选择向量时所有的行都有效。`rows()` 总是返回列中的行数，有效的行数使用 `selected_rows()`。
  */
 class Chunk
 {
 public:
-  static const int MAX_ROWS = Column::DEFAULT_CAPACITY;
+  static constexpr int MAX_ROWS = Column::DEFAULT_CAPACITY;
   Chunk()                   = default;
   Chunk(const Chunk &other)
   {
     for (size_t i = 0; i < other.columns_.size(); ++i) {
       columns_.emplace_back(other.columns_[i]->clone());
     }
-    column_ids_ = other.column_ids_;
+    column_ids_    = other.column_ids_;
+    selection_     = other.selection_;
+    has_selection_ = other.has_selection_;
   }
   Chunk(Chunk &&chunk)
   {
-    columns_    = std::move(chunk.columns_);
-    column_ids_ = std::move(chunk.column_ids_);
+    columns_       = std::move(chunk.columns_);
+    column_ids_    = std::move(chunk.column_ids_);
+    selection_     = std::move(chunk.selection_);
+    has_selection_ = chunk.has_selection_;
   }
 
   int column_num() const { return columns_.size(); }
@@ -67,6 +75,12 @@ public:
 
   RC reference(Chunk &chunk);
 
+  /**
+   * @brief 按照 `chunk` 中各列的类型追加空的列，列数据由当前 Chunk 持有
+   * @details 列的 id 是它在当前 Chunk 中的位置
+   */
+  void add_columns_like(const Chunk &chunk, int capacity = MAX_ROWS);
+
   /**
    * @brief 获取 Chunk 中的行数
    */
@@ -77,6 +91,45 @@ public:
    */
   int capacity() const;
 
+  bool               has_selection() const { return has_selection_; }
+  const vector<int> &selection() const { return selection_; }
+
+  /**
+   * @brief 有效的行数，没有选择向量时等于 `rows()`
+   */
+  int selected_rows() const { return has_selection_ ? static_cast<int>(selection_.size()) : rows(); }
+
+  /**
+   * @brief 第 i 个有效的行在列中的下标
+   */
+  int row_index(int i) const { return has_selection_ ? selection_[i] : i; }
+
+  void set_selection(vector<int> &&selection);
+
+  /**
+   * @brief 按照过滤结果设置选择向量
+   * @param select 每一行是否有效，长度与 `rows()` 相同，需要已经包含当前选择向量的结果（参考 `init_select`）。
+   * 所有的行都有效时去掉选择向量
+   */
+  void set_selection(const vector<uint8_t> &select);
+
+  void clear_selection();
+
+  /**
+   * @brief 按照当前的选择向量初始化过滤结果，有效的行为 1
+   */
+  void init_select(vector<uint8_t> &select) const;
+
+  /**
+   * @brief 只保留前 `rows` 个有效的行
+   */
+  void truncate(int rows);
+
+  /**
+   * @brief 把有效的行拷贝到 `output` 中，`output` 中的列由它自己持有，并且没有选择向量
+   */
+  RC materialize(Chunk &output) const;
+
   /**
    * @brief 从 Chunk 中获得指定行指定列的 Value
    * @param col_idx 列索引
@@ -99,4 +152,7 @@ private:
   // TODO: remove it and support multi-tables,
   // `columnd_ids` store the ids of child operator that need to be output
   vector<int> column_ids_;
+  /// 选择向量，只有 has_selection_ 为 true 时有效
+  vector<int> selection_;
+  bool        has_selection_ = false;
 };
@@ -462,6 +462,24 @@ public:
     return rc;
   }
 
+  static RC decode(bytes &encoded_key, int64_t &table_id, uint64_t &rid)
+  {
+    RC           rc = RC::SUCCESS;
+    span<byte_t> sp(encoded_key);
+    string       table_prefix;
+    string       rowkey_prefix;
+    if (OB_FAIL(OrderedCode::parse(sp, OrderedCode::increasing, table_prefix))) {
+      LOG_WARN("parse failed");
+    } else if (OB_FAIL(OrderedCode::parse(sp, OrderedCode::increasing, table_id))) {
+      LOG_WARN("parse failed");
+    } else if (OB_FAIL(OrderedCode::parse(sp, OrderedCode::increasing, rowkey_prefix))) {
+      LOG_WARN("parse failed");
+    } else if (OB_FAIL(OrderedCode::parse(sp, OrderedCode::increasing, rid))) {
+      LOG_WARN("parse failed");
+    }
+    return rc;
+  }
+
   static constexpr const char *table_prefix  = "t";
   static constexpr const char *rowkey_prefix = "r";
 };
@@ -8,6 +8,7 @@ EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
 MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
+#include "common/lang/cmath.h"
 #include "common/log/log.h"
 #include "storage/common/column.h"
 
@@ -80,6 +81,9 @@ void Column::init(const Value &value, size_t size)
   own_       = true;
   memcpy(data_, value.data(), attr_len_);
   column_type_ = Type::CONSTANT_COLUMN;
+  if (value.is_null()) {
+    set_null(0);
+  }
 }
 
 void Column::reset()
@@ -96,6 +100,7 @@ void Column::reset()
   own_       = false;
   attr_type_ = AttrType::UNDEFINED;
   attr_len_  = -1;
+  validity_.clear();
 }
 
 RC Column::append_one(const char *data) { return append(data, 1); }
@@ -118,6 +123,70 @@ RC Column::append(const char *data, int count)
   return RC::SUCCESS;
 }
 
+RC Column::append_rows(const Column &column, int start, int count)
+{
+  const int old_count = count_;
+
+  RC rc = RC::SUCCESS;
+  if (column.column_type() == Type::NORMAL_COLUMN) {
+    rc = append(column.data() + static_cast<size_t>(start) * attr_len_, count);
+  } else {
+    for (int i = 0; i < count && OB_SUCC(rc); i++) {
+      rc = append(column.data(), 1);
+    }
+  }
+
+  if (OB_SUCC(rc) && column.has_null()) {
+    for (int i = 0; i < count; i++) {
+      if (column.is_null(start + i)) {
+        set_null(old_count + i);
+      }
+    }
+  }
+  return rc;
+}
+
+RC Column::append_selected(const Column &column, const vector<int> &selection)
+{
+  if (!own_) {
+    LOG_WARN("append data to non-owned column");
+    return RC::INTERNAL;
+  }
+  const int count = static_cast<int>(selection.size());
+  if (count_ + count > capacity_) {
+    LOG_WARN("append data to full column");
+    return RC::INTERNAL;
+  }
+
+  const int old_count = count_;
+  if (column.column_type() == Type::CONSTANT_COLUMN) {
+    for (int i = 0; i < count; i++) {
+      memcpy(data_ + (count_ + i) * attr_len_, column.data(), attr_len_);
+    }
+  } else if (attr_len_ == 4) {
+    // 大部分列是 4 字节的定长类型，按照整数拷贝，避免每行调用 memcpy
+    const int32_t *src = reinterpret_cast<const int32_t *>(column.data());
+    int32_t       *dst = reinterpret_cast<int32_t *>(data_) + count_;
+    for (int i = 0; i < count; i++) {
+      dst[i] = src[selection[i]];
+    }
+  } else {
+    for (int i = 0; i < count; i++) {
+      memcpy(data_ + (count_ + i) * attr_len_, column.data() + static_cast<size_t>(selection[i]) * attr_len_, attr_len_);
+    }
+  }
+  count_ += count;
+
+  if (column.has_null()) {
+    for (int i = 0; i < count; i++) {
+      if (column.is_null(selection[i])) {
+        set_null(old_count + i);
+      }
+    }
+  }
+  return RC::SUCCESS;
+}
+
 RC Column::append_value(const Value &value)
 {
   if (!own_) {
@@ -134,10 +203,87 @@ RC Column::append_value(const Value &value)
   if (total_bytes < attr_len_)
     data_[count_ * attr_len_ + total_bytes] = 0;
 
+  if (value.is_null()) {
+    set_null(count_);
+  }
   count_ += 1;
   return RC::SUCCESS;
 }
 
+void Column::set_null(int index)
+{
+  if (validity_.empty()) {
+    // 新的位图中所有的值都有效
+    const int bits = std::max(capacity_, std::max(count_, index + 1));
+    validity_.assign((bits + 7) / 8, 0xFF);
+  } else if ((index >> 3) >= static_cast<int>(validity_.size())) {
+    validity_.resize((index >> 3) + 1, 0xFF);
+  }
+  validity_[index >> 3] &= ~(1 << (index & 7));
+}
+
+void Column::merge_nulls(const Column &column)
+{
+  if (!column.has_null()) {
+    return;
+  }
+  if (column.column_type() == Type::CONSTANT_COLUMN) {
+    if (column.is_null(0)) {
+      const int rows = column_type_ == Type::CONSTANT_COLUMN ? 1 : count_;
+      for (int i = 0; i < rows; i++) {
+        set_null(i);
+      }
+    }
+    return;
+  }
+  for (int i = 0; i < column.count(); i++) {
+    if (column.is_null(i)) {
+      set_null(i);
+    }
+  }
+}
+
+void Column::detect_nulls()
+{
+  static constexpr char NULL_CHARS[] = "NUL\1";
+  static constexpr int  NULL_CHARS_LEN = sizeof(NULL_CHARS) - 1;
+
+  validity_.clear();
+  const int rows = column_type_ == Type::CONSTANT_COLUMN ? 1 : count_;
+  switch (attr_type_) {
+    case AttrType::INTS:
+    case AttrType::DATES: {
+      const int32_t *values = reinterpret_cast<const int32_t *>(data_);
+      for (int i = 0; i < rows; i++) {
+        if (values[i] == INT32_MAX) {
+          set_null(i);
+        }
+      }
+    } break;
+    case AttrType::FLOATS: {
+      const float *values = reinterpret_cast<const float *>(data_);
+      for (int i = 0; i < rows; i++) {
+        if (std::isnan(values[i])) {
+          set_null(i);
+        }
+      }
+    } break;
+    case AttrType::CHARS: {
+      if (attr_len_ < NULL_CHARS_LEN) {
+        break;
+      }
+      for (int i = 0; i < rows; i++) {
+        const char *value = data_ + static_cast<size_t>(i) * attr_len_;
+        if (memcmp(value, NULL_CHARS, NULL_CHARS_LEN) == 0 &&
+            (attr_len_ == NULL_CHARS_LEN || value[NULL_CHARS_LEN] == '\0')) {
+          set_null(i);
+        }
+      }
+    } break;
+    default: break;
+  }
+}
+
 string_t Column::add_text(const char *data, int length)
 {
   if (vector_buffer_ == nullptr) {
@@ -154,7 +300,11 @@ Value Column::get_value(int index) const
   if (index >= count_ || index < 0) {
     return Value();
   }
-  return Value(attr_type_, &data_[index * attr_len_], attr_len_);
+  Value value(attr_type_, &data_[index * attr_len_], attr_len_);
+  if (is_null(index)) {
+    value.set_is_null(true);
+  }
+  return value;
 }
 
 void Column::reference(const Column &column)
@@ -172,4 +322,20 @@ void Column::reference(const Column &column)
   this->column_type_ = column.column_type();
   this->attr_type_   = column.attr_type();
   this->attr_len_    = column.attr_len();
+  this->validity_    = column.validity_;
+}
+
+void Column::reference(char *data, int count)
+{
+  if (data_ != nullptr && own_) {
+    delete[] data_;
+  }
+  vector_buffer_ = nullptr;
+  validity_.clear();
+
+  this->data_        = data;
+  this->capacity_    = count;
+  this->count_       = count;
+  this->own_         = false;
+  this->column_type_ = Type::NORMAL_COLUMN;
 }
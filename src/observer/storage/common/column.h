@@ -12,11 +12,15 @@ See the Mulan PSL v2 for more details. */
 
 #include <string.h>
 
+#include "common/lang/vector.h"
 #include "storage/field/field_meta.h"
 #include "storage/common/vector_buffer.h"
 
 /**
  * @brief A column contains multiple values in contiguous memory with a specified type.
+ * @details 列可以带一个有效性位图(validity bitmap)，第 i 位为 0 表示第 i 个列值是 NULL。
+ * 没有位图时表示所有列值都不是 NULL，这是最常见的情况，不需要额外的内存和判断。
+ * 常量列只使用第 0 位。
  */
 // TODO: `Column` currently only support fixed-length type.
 class Column
@@ -41,6 +45,7 @@ public:
     data_        = new char[capacity_ * attr_len_];
     memcpy(data_, other.data_, capacity_ * attr_len_);
     vector_buffer_ = make_unique<VectorBuffer>();
+    validity_      = other.validity_;
   }
   Column(Column &&other)
   {
@@ -52,6 +57,7 @@ public:
     attr_len_       = other.attr_len_;
     column_type_    = other.column_type_;
     vector_buffer_  = std::move(other.vector_buffer_);
+    validity_       = std::move(other.validity_);
     other.data_     = nullptr;
     other.count_    = 0;
     other.capacity_ = 0;
@@ -82,6 +88,18 @@ public:
    */
   RC append(const char *data, int count);
 
+  /**
+   * @brief 追加 `column` 中从 start 开始的 count 个列值，`column` 是常量列时重复追加它的值
+   * @note 两个列的类型和长度需要相同
+   */
+  RC append_rows(const Column &column, int start, int count);
+
+  /**
+   * @brief 按照选择向量追加 `column` 中的列值
+   * @param selection 要追加的列值在 `column` 中的下标
+   */
+  RC append_selected(const Column &column, const vector<int> &selection);
+
   /**
    * @brief 获取 index 位置的列值
    */
@@ -109,17 +127,62 @@ public:
   {
     count_         = 0;
     vector_buffer_ = nullptr;
+    validity_.clear();
   }
 
+  /**
+   * @brief 是否可能包含 NULL，为 false 时不需要逐行检查
+   */
+  bool has_null() const { return !validity_.empty(); }
+
+  /**
+   * @brief 有效性位图，没有 NULL 时返回 nullptr
+   */
+  const uint8_t *validity() const { return validity_.empty() ? nullptr : validity_.data(); }
+
+  bool is_null(int index) const
+  {
+    if (validity_.empty()) {
+      return false;
+    }
+    if (column_type_ == Type::CONSTANT_COLUMN) {
+      index = 0;
+    }
+    return (validity_[index >> 3] & (1 << (index & 7))) == 0;
+  }
+
+  void set_null(int index);
+
+  /**
+   * @brief 把 `column` 中为 NULL 的行在当前列中也设置为 NULL，用于计算结果的 NULL 传递
+   * @note 两个列的行数需要相同，或者 `column` 是常量列
+   */
+  void merge_nulls(const Column &column);
+
+  /**
+   * @brief 按照存储层中表示 NULL 的特殊值生成有效性位图
+   * @details 记录中的 NULL 字段保存的是一个特殊值（参考 Value::set_null_value），
+   * 扫描可以为空的字段时需要转换成有效性位图
+   */
+  void detect_nulls();
+
   /**
    * @brief 引用另一个 Column
    */
   void reference(const Column &column);
 
+  /**
+   * @brief 引用外部的一段连续内存作为列数据，不做拷贝，保留当前列的类型信息
+   * @param data 列数据的起始地址，调用者需要保证引用期间该内存有效
+   * @param count 列值的个数
+   */
+  void reference(char *data, int count);
+
   void set_column_type(Type column_type) { column_type_ = column_type; }
   void set_attr_type(AttrType attr_type) { attr_type_ = attr_type; }
   void set_count(int count) { count_ = count; }
 
+  bool                    is_owned() const { return own_; }
   int                     count() const { return count_; }
   int                     capacity() const { return capacity_; }
   AttrType                attr_type() const { return attr_type_; }
@@ -142,4 +205,6 @@ private:
   /// 列类型
   Type                     column_type_   = Type::NORMAL_COLUMN;
   unique_ptr<VectorBuffer> vector_buffer_ = nullptr;
+  /// 有效性位图，为空表示没有 NULL
+  vector<uint8_t> validity_;
 };
@@ -32,6 +32,9 @@ using namespace common;
 
 Db::~Db()
 {
+  // 事务管理器可能在后台访问表(比如垃圾回收)，需要先于表关闭
+  trx_kit_.reset();
+
   for (auto &iter : opened_tables_) {
     delete iter.second;
   }
@@ -303,6 +306,12 @@ RC Db::sync()
     LOG_ERROR("Failed to flush meta. db=%s, rc=%d:%s", name_.c_str(), rc, strrc(rc));
     return rc;
   }
+
+  // 检查点之前的日志在恢复时不会再回放，清理失败不影响检查点本身
+  RC truncate_rc = log_handler_->truncate(check_point_lsn_);
+  if (OB_FAIL(truncate_rc)) {
+    LOG_WARN("Failed to truncate log. db=%s, lsn=%ld, rc=%s", name_.c_str(), check_point_lsn_, strrc(truncate_rc));
+  }
   LOG_INFO("Successfully sync db. db=%s", name_.c_str());
   return rc;
 }
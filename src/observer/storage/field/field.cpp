@@ -32,4 +32,22 @@ int Field::get_int(const Record &record)
   return value.get_int();
 }
 
+void Field::set_int64(Record &record, int64_t value)
+{
+  ASSERT(field_->type() == AttrType::INTS, "could not set int value to a non-int field");
+  ASSERT(field_->len() == sizeof(value), "invalid field len");
+
+  char *field_data = record.data() + field_->offset();
+  memcpy(field_data, &value, sizeof(value));
+}
+
+int64_t Field::get_int64(const Record &record)
+{
+  ASSERT(field_->len() == sizeof(int64_t), "invalid field len");
+
+  int64_t value = 0;
+  memcpy(&value, record.data() + field_->offset(), sizeof(value));
+  return value;
+}
+
 const char *Field::get_data(const Record &record) { return record.data() + field_->offset(); }
\ No newline at end of file
@@ -14,6 +14,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/index/bplus_tree.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/lower_bound.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
@@ -153,6 +154,9 @@ bool IndexNodeHandler::validate() const
       LOG_WARN("root page internal node has less than 2 child. size=%d", size());
       return false;
     }
+  } else if (size() < min_size()) {
+    LOG_WARN("non-root page has less than min size items. size=%d, min size=%d", size(), min_size());
+    return false;
   }
   return true;
 }
@@ -1556,6 +1560,202 @@ RC BplusTreeHandler::insert_entry(const char *user_key, const RID *rid)
   return RC::SUCCESS;
 }
 
+/**
+ * @brief 批量构建时计算每个节点放多少个元素
+ * @details 按照填充比例计算出节点个数后，把元素平均分到每个节点上，避免最后一个节点特别小。
+ * 平均分配后每个节点的元素个数如果小于 min_size，就减少节点个数，把多出来的元素分给其它节点，
+ * 保证除了只有一个节点(根节点)的情况外，每个节点都不少于 min_size 个元素
+ * @param item_num 这一层一共有多少个元素
+ * @param node_capacity 按照填充比例计算出来的每个节点的元素个数
+ * @param min_size 节点最少的元素个数，参考 IndexNodeHandler::min_size
+ * @param node_index 第几个节点
+ * @param[out] begin 这个节点的第一个元素在这一层中的位置
+ * @param[out] end 这个节点最后一个元素的下一个位置
+ */
+static void bulk_load_node_range(
+    int64_t item_num, int node_capacity, int min_size, int64_t node_index, int64_t &begin, int64_t &end)
+{
+  int64_t node_num = (item_num + node_capacity - 1) / node_capacity;
+  node_num         = std::max<int64_t>(1, std::min<int64_t>(node_num, item_num / min_size));
+  begin            = item_num * node_index / node_num;
+  end              = item_num * (node_index + 1) / node_num;
+}
+
+RC BplusTreeHandler::bulk_load(const vector<char> &keys, bool unique, float fill_factor)
+{
+  const int key_length = file_header_.key_length;
+  if (keys.size() % key_length != 0 || fill_factor <= 0 || fill_factor > 1) {
+    LOG_WARN("invalid arguments. keys size=%ld, key length=%d, fill factor=%f", keys.size(), key_length, fill_factor);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (!is_empty()) {
+    LOG_WARN("cannot bulk load a non-empty b+tree. root page=%d", file_header_.root_page);
+    return RC::INTERNAL;
+  }
+
+  const int64_t key_num = keys.size() / key_length;
+  if (key_num == 0) {
+    return RC::SUCCESS;
+  }
+
+  vector<const char *> sorted_keys(key_num);
+  for (int64_t i = 0; i < key_num; i++) {
+    sorted_keys[i] = keys.data() + i * key_length;
+  }
+  std::sort(sorted_keys.begin(), sorted_keys.end(), [this](const char *left, const char *right) {
+    return key_comparator_(left, right) < 0;
+  });
+
+  const AttrComparator &attr_comparator = key_comparator_.attr_comparator();
+  for (int64_t i = 1; i < key_num; i++) {
+    if (unique && attr_comparator(sorted_keys[i - 1], sorted_keys[i]) == 0) {
+      LOG_WARN("duplicate user key while bulk loading a unique b+tree. key=%s", key_printer_(sorted_keys[i]).c_str());
+      return RC::RECORD_NOT_UNIQUE;
+    }
+    if (key_comparator_(sorted_keys[i - 1], sorted_keys[i]) == 0) {
+      LOG_WARN("duplicate key while bulk loading b+tree. key=%s", key_printer_(sorted_keys[i]).c_str());
+      return RC::RECORD_DUPLICATE_KEY;
+    }
+  }
+
+  vector<char> items;
+  vector<char> parent_items;
+  RC           rc = bulk_load_leaves(sorted_keys, fill_factor, parent_items);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to bulk load leaf nodes. rc=%s", strrc(rc));
+    return rc;
+  }
+  sorted_keys.clear();
+  sorted_keys.shrink_to_fit();
+
+  const int internal_item_size = key_length + static_cast<int>(sizeof(PageNum));
+  while (parent_items.size() > static_cast<size_t>(internal_item_size)) {
+    items.swap(parent_items);
+    rc = bulk_load_internals(items, fill_factor, parent_items);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to bulk load internal nodes. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+
+  const PageNum root_page_num = *reinterpret_cast<const PageNum *>(parent_items.data() + key_length);
+
+  BplusTreeMiniTransaction mtr(*this, &rc);
+  root_lock_.lock();
+  update_root_page_num_locked(mtr, root_page_num);
+  root_lock_.unlock();
+
+  LOG_INFO("bulk load b+tree done. key num=%ld, root page=%d", key_num, root_page_num);
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_leaves(
+    const vector<const char *> &sorted_keys, float fill_factor, vector<char> &parent_items)
+{
+  const int     key_length    = file_header_.key_length;
+  const int     item_size     = key_length + static_cast<int>(sizeof(RID));
+  const int     node_capacity = std::max(1, static_cast<int>(file_header_.leaf_max_size * fill_factor));
+  const int     min_size      = file_header_.leaf_max_size - file_header_.leaf_max_size / 2;
+  const int64_t key_num       = sorted_keys.size();
+
+  RC           rc            = RC::SUCCESS;
+  PageNum      prev_page_num = BP_INVALID_PAGE_NUM;
+  vector<char> items;
+  parent_items.clear();
+  for (int64_t node_index = 0, begin = 0, end = 0; end < key_num; node_index++) {
+    bulk_load_node_range(key_num, node_capacity, min_size, node_index, begin, end);
+
+    // 叶子节点中的value就是key中的RID
+    items.resize((end - begin) * item_size);
+    for (int64_t i = begin; i < end; i++) {
+      char *item = items.data() + (i - begin) * item_size;
+      memcpy(item, sorted_keys[i], key_length);
+      memcpy(item + key_length, sorted_keys[i] + file_header_.attr_length, sizeof(RID));
+    }
+
+    // 每个节点使用一个mini transaction，避免日志在内存中堆积
+    BplusTreeMiniTransaction mtr(*this, &rc);
+
+    Frame *frame = nullptr;
+    rc           = mtr.latch_memo().allocate_page(frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate leaf page. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    LeafIndexNodeHandler leaf_node(mtr, file_header_, frame);
+    if (OB_FAIL(rc = leaf_node.init_empty()) || OB_FAIL(rc = leaf_node.append(items.data(), end - begin))) {
+      LOG_WARN("failed to fill leaf page. page num=%d, rc=%s", frame->page_num(), strrc(rc));
+      return rc;
+    }
+    frame->mark_dirty();
+
+    if (prev_page_num != BP_INVALID_PAGE_NUM) {
+      Frame *prev_frame = nullptr;
+      rc                = mtr.latch_memo().get_page(prev_page_num, prev_frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get previous leaf page. page num=%d, rc=%s", prev_page_num, strrc(rc));
+        return rc;
+      }
+      LeafIndexNodeHandler prev_node(mtr, file_header_, prev_frame);
+      rc = prev_node.set_next_page(frame->page_num());
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      prev_frame->mark_dirty();
+    }
+
+    prev_page_num           = frame->page_num();
+    const size_t parent_pos = parent_items.size();
+    parent_items.resize(parent_pos + key_length + sizeof(PageNum));
+    memcpy(parent_items.data() + parent_pos, sorted_keys[begin], key_length);
+    memcpy(parent_items.data() + parent_pos + key_length, &prev_page_num, sizeof(PageNum));
+  }
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_internals(const vector<char> &items, float fill_factor, vector<char> &parent_items)
+{
+  const int key_length = file_header_.key_length;
+  const int item_size  = key_length + static_cast<int>(sizeof(PageNum));
+  // 内部节点至少要有两个子节点，每个节点至少放3个元素，平均分配后每个节点也不会少于2个
+  const int     node_capacity = std::max(3, static_cast<int>(file_header_.internal_max_size * fill_factor));
+  const int     min_size      = file_header_.internal_max_size - file_header_.internal_max_size / 2;
+  const int64_t item_num      = items.size() / item_size;
+
+  RC rc = RC::SUCCESS;
+  parent_items.clear();
+  for (int64_t node_index = 0, begin = 0, end = 0; end < item_num; node_index++) {
+    bulk_load_node_range(item_num, node_capacity, min_size, node_index, begin, end);
+
+    BplusTreeMiniTransaction mtr(*this, &rc);
+
+    Frame *frame = nullptr;
+    rc           = mtr.latch_memo().allocate_page(frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate internal page. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // 会同时设置所有子节点的父节点
+    InternalIndexNodeHandler internal_node(mtr, file_header_, frame);
+    const char              *node_items = items.data() + begin * item_size;
+    if (OB_FAIL(rc = internal_node.init_empty()) || OB_FAIL(rc = internal_node.append(node_items, end - begin))) {
+      LOG_WARN("failed to fill internal page. page num=%d, rc=%s", frame->page_num(), strrc(rc));
+      return rc;
+    }
+    frame->mark_dirty();
+
+    const PageNum page_num   = frame->page_num();
+    const size_t  parent_pos = parent_items.size();
+    parent_items.resize(parent_pos + item_size);
+    memcpy(parent_items.data() + parent_pos, node_items, key_length);
+    memcpy(parent_items.data() + parent_pos + key_length, &page_num, sizeof(PageNum));
+  }
+  return rc;
+}
+
 RC BplusTreeHandler::get_entry(const char *user_key, int key_len, list<RID> &rids)
 {
   BplusTreeScanner scanner(*this);
@@ -2020,8 +2220,77 @@ RC BplusTreeScanner::next_entry(RID &rid)
     return RC::SUCCESS;
   }
 
-  RC      rc            = RC::SUCCESS;
-  PageNum next_page_num = node.next_page();
+  RC rc = move_to_next_page();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  iter_index_ = -1;  // `next` will add 1
+  return next_entry(rid);
+}
+
+RC BplusTreeScanner::next_entries(RID *rids, int capacity, int &count, char *keys /* = nullptr */)
+{
+  count = 0;
+  if (capacity <= 0) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  while (nullptr != current_frame_) {
+    LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
+
+    const int begin = first_emitted_ ? iter_index_ + 1 : iter_index_;
+    if (begin < node.size()) {
+      int         end         = std::min(node.size(), begin + capacity);
+      bool        reach_bound = false;
+      const char *right_key   = static_cast<const char *>(right_key_.get());
+      if (right_key != nullptr && tree_handler_.key_comparator_(node.key_at(end - 1), right_key) > 0) {
+        // 右边界落在当前范围内，找到第一个大于右边界的位置
+        bool      found    = false;
+        const int position = node.lookup(tree_handler_.key_comparator_, right_key, &found);
+        end                = std::max(begin, found ? position + 1 : position);
+        reach_bound        = true;
+      }
+
+      const int attr_length = tree_handler_.file_header_.attr_length;
+      for (int i = begin; i < end; i++) {
+        if (keys != nullptr) {
+          memcpy(keys + static_cast<size_t>(count) * attr_length, node.key_at(i), attr_length);
+        }
+        memcpy(&rids[count++], node.value_at(i), sizeof(RID));
+      }
+
+      iter_index_    = end - 1;
+      first_emitted_ = true;
+      if (reach_bound) {
+        current_frame_ = nullptr;
+      }
+
+      if (count > 0) {
+        return RC::SUCCESS;
+      }
+      continue;
+    }
+
+    RC rc = move_to_next_page();
+    if (OB_FAIL(rc)) {
+      if (rc == RC::RECORD_EOF) {
+        current_frame_ = nullptr;
+      }
+      return rc;
+    }
+
+    iter_index_    = 0;
+    first_emitted_ = false;
+  }
+
+  return RC::RECORD_EOF;
+}
+
+RC BplusTreeScanner::move_to_next_page()
+{
+  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
+  PageNum              next_page_num = node.next_page();
   if (BP_INVALID_PAGE_NUM == next_page_num) {
     return RC::RECORD_EOF;
   }
@@ -2029,7 +2298,7 @@ RC BplusTreeScanner::next_entry(RID &rid)
   LatchMemo &latch_memo = mtr_.latch_memo();
 
   const int memo_point = latch_memo.memo_point();
-  rc                   = latch_memo.get_page(next_page_num, current_frame_);
+  RC        rc         = latch_memo.get_page(next_page_num, current_frame_);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to get next page. page num=%d, rc=%s", next_page_num, strrc(rc));
     return rc;
@@ -2046,8 +2315,7 @@ RC BplusTreeScanner::next_entry(RID &rid)
   }
 
   latch_memo.release_to(memo_point);
-  iter_index_ = -1;  // `next` will add 1
-  return next_entry(rid);
+  return RC::SUCCESS;
 }
 
 RC BplusTreeScanner::close()
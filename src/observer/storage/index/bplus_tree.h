@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
 #include "common/lang/functional.h"
+#include "common/lang/iomanip.h"
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -52,6 +53,7 @@ enum class BplusTreeOperationType
 /**
  * @brief 属性比较(BplusTree)
  * @ingroup BPlusTree
+ * @details 类型是 UNDEFINED 时，表示键值已经编码成可以按字节比较的格式(参考 IndexKeyEncoder)，直接使用 memcmp 比较
  */
 class AttrComparator
 {
@@ -66,7 +68,10 @@ public:
 
   int operator()(const char *v1, const char *v2) const
   {
-    // TODO: optimized the comparison
+    if (attr_type_ == AttrType::UNDEFINED) {
+      return memcmp(v1, v2, attr_length_);
+    }
+
     Value left;
     left.set_type(attr_type_);
     left.set_data(v1, attr_length_);
@@ -126,6 +131,15 @@ public:
 
   string operator()(const char *v) const
   {
+    if (attr_type_ == AttrType::UNDEFINED) {
+      stringstream ss;
+      ss << std::hex << std::setfill('0');
+      for (int i = 0; i < attr_length_; i++) {
+        ss << std::setw(2) << static_cast<int>(static_cast<unsigned char>(v[i]));
+      }
+      return ss.str();
+    }
+
     Value value(attr_type_, const_cast<char *>(v), attr_length_);
     return value.to_string();
   }
@@ -164,7 +178,7 @@ private:
  * @brief the meta information of bplus tree
  * @ingroup BPlusTree
  * @details this is the first page of bplus tree.
- * only one field can be supported, can you extend it to multi-fields?
+ * 多个字段的索引会把所有字段编码成一个按字节比较的键值，B+树本身只看到一个定长的键值
  */
 struct IndexFileHeader
 {
@@ -178,7 +192,7 @@ struct IndexFileHeader
   int32_t  leaf_max_size;      ///< 叶子节点最大的键值对数
   int32_t  attr_length;        ///< 键值的长度
   int32_t  key_length;         ///< attr length + sizeof(RID)
-  AttrType attr_type;          ///< 键值的类型
+  AttrType attr_type;          ///< 键值的类型，UNDEFINED 表示按字节比较的编码键值
 
   const string to_string() const
   {
@@ -367,6 +381,9 @@ public:
   friend string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer);
 
 protected:
+  friend class BplusTreeHandler;  // 批量构建时直接追加数据
+
+
   char *__item_at(int index) const override;
 
   RC append(const char *items, int num);
@@ -427,6 +444,8 @@ public:
   friend string to_string(const InternalIndexNodeHandler &handler, const KeyPrinter &printer);
 
 private:
+  friend class BplusTreeHandler;  // 批量构建时直接追加数据
+
   RC insert_items(int index, const char *items, int num);
   RC append(const char *items, int num);
   RC append(const char *item);
@@ -499,6 +518,18 @@ public:
 
   bool is_empty() const;
 
+  /**
+   * @brief 自底向上批量构建B+树
+   * @details 只能在空的B+树上调用。先对所有的键值排序，然后从左到右依次填充叶子节点，再逐层向上构建内部节点，
+   * 最后设置根节点。与逐条插入相比，不需要每次从根节点查找，也不会出现页面分裂，页面基本上按顺序分配和写入。
+   * @param keys 所有的键值，每个键值是 attr_length 长度的 user_key 加上 RID，与叶子节点中键值的格式相同
+   * @param unique 是否要求 user_key 唯一，存在重复值时返回 RECORD_NOT_UNIQUE
+   * @param fill_factor 每个节点的填充比例，剩余的空间留给后续的插入
+   */
+  RC bulk_load(const vector<char> &keys, bool unique = false, float fill_factor = DEFAULT_FILL_FACTOR);
+
+  static constexpr float DEFAULT_FILL_FACTOR = 0.9f;  ///< 批量构建时节点默认的填充比例
+
   /**
    * @brief 获取指定值的record
    * @param key_len user_key的长度
@@ -636,6 +667,18 @@ protected:
    */
   RC adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame);
 
+  /**
+   * @brief 批量构建时，使用排好序的键值填充叶子节点
+   * @param[out] parent_items 每个叶子节点的第一个键值和页号，作为上一层内部节点的数据
+   */
+  RC bulk_load_leaves(const vector<const char *> &sorted_keys, float fill_factor, vector<char> &parent_items);
+
+  /**
+   * @brief 批量构建时，使用下一层节点的第一个键值和页号填充一层内部节点
+   * @param[out] parent_items 当前这一层每个节点的第一个键值和页号
+   */
+  RC bulk_load_internals(const vector<char> &items, float fill_factor, vector<char> &parent_items);
+
 private:
   common::MemPoolItem::item_unique_ptr make_key(const char *user_key, const RID &rid);
 
@@ -693,6 +736,17 @@ public:
    */
   RC next_entry(RID &rid);
 
+  /**
+   * @brief 批量获取记录
+   * @details 每次最多返回一个叶子节点中满足条件的数据，只在叶子节点的最后一个键值超过右边界时才做一次二分查找，
+   * 避免逐条比较右边界。与 next_entry 可以交替使用
+   * @param[out] rids 长度至少为 capacity
+   * @param[out] keys 不为空时同时返回每条记录的键值(不包含RID)，长度至少为 capacity * attr_length
+   * @param[out] count 返回的记录数，返回 RECORD_EOF 时为0
+   * @return RC RECORD_EOF 表示遍历完成
+   */
+  RC next_entries(RID *rids, int capacity, int &count, char *keys = nullptr);
+
   /**
    * @brief 关闭当前扫描器
    * @details 可以不调用，在析构函数时会自动执行
@@ -712,6 +766,12 @@ private:
    */
   bool touch_end();
 
+  /**
+   * @brief 移动到下一个叶子节点
+   * @return RC RECORD_EOF 表示已经是最后一个叶子节点
+   */
+  RC move_to_next_page();
+
 private:
   bool                     inited_ = false;
   BplusTreeHandler        &tree_handler_;
@@ -16,10 +16,44 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "storage/table/table.h"
 #include "storage/db/db.h"
+#include "storage/record/record_scanner.h"
+
+namespace {
+
+/**
+ * @brief 编码键值使用的缓存
+ * @details 插入、删除和扫描时每条记录都要编码一次键值，常见的键值长度不超过 INLINE_SIZE，直接使用栈上的空间，
+ * 只有更长的键值才分配内存。不能使用成员变量，同一个索引可能被多个线程同时修改
+ */
+class KeyBuffer
+{
+public:
+  explicit KeyBuffer(int length)
+  {
+    if (length > INLINE_SIZE) {
+      heap_.resize(length);
+      data_ = heap_.data();
+    }
+  }
+  KeyBuffer(const KeyBuffer &)            = delete;
+  KeyBuffer &operator=(const KeyBuffer &) = delete;
+
+  char *data() { return data_; }
+
+private:
+  static constexpr int INLINE_SIZE = 256;
+
+  char         inline_[INLINE_SIZE];
+  vector<char> heap_;
+  char        *data_ = inline_;
+};
+
+}  // namespace
 
 BplusTreeIndex::~BplusTreeIndex() noexcept { close(); }
 
-RC BplusTreeIndex::create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+RC BplusTreeIndex::create(
+    Table *table, const char *file_name, const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas)
 {
   if (inited_) {
     LOG_WARN("Failed to create index due to the index has been created before. file_name:%s, index:%s, field:%s",
@@ -27,10 +61,27 @@ RC BplusTreeIndex::create(Table *table, const char *file_name, const IndexMeta &
     return RC::RECORD_OPENNED;
   }
 
-  Index::init(index_meta, field_meta);
+  Index::init(index_meta, field_metas);
+
+  // 不能编码的类型（比如 TEXTS、VECTORS）只能建单字段索引，与旧版本的索引相同，存放原始数据并使用字段类型比较
+  AttrType attr_type   = AttrType::UNDEFINED;
+  int      attr_length = 0;
+  if (field_metas_.size() == 1 && !IndexKeyEncoder::is_supported(field_metas_[0].type())) {
+    attr_type   = field_metas_[0].type();
+    attr_length = field_metas_[0].len();
+    encoded_    = false;
+  } else {
+    RC rc = key_encoder_.init(field_metas_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("Failed to init index key encoder, file_name:%s, index:%s, rc:%s", file_name, index_meta.name(), strrc(rc));
+      return rc;
+    }
+    attr_length = key_encoder_.key_length();
+    encoded_    = true;
+  }
 
   BufferPoolManager &bpm = table->db()->buffer_pool_manager();
-  RC rc = index_handler_.create(table->db()->log_handler(), bpm, file_name, field_meta.type(), field_meta.len());
+  RC rc = index_handler_.create(table->db()->log_handler(), bpm, file_name, attr_type, attr_length);
   if (RC::SUCCESS != rc) {
     LOG_WARN("Failed to create index_handler, file_name:%s, index:%s, field:%s, rc:%s",
         file_name, index_meta.name(), index_meta.field(), strrc(rc));
@@ -50,7 +101,8 @@ RC BplusTreeIndex::drop(Table *table)
   return index_handler_.drop(bpm);
 }
 
-RC BplusTreeIndex::open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+RC BplusTreeIndex::open(
+    Table *table, const char *file_name, const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas)
 {
   if (inited_) {
     LOG_WARN("Failed to open index due to the index has been initedd before. file_name:%s, index:%s, field:%s",
@@ -58,7 +110,7 @@ RC BplusTreeIndex::open(Table *table, const char *file_name, const IndexMeta &in
     return RC::RECORD_OPENNED;
   }
 
-  Index::init(index_meta, field_meta);
+  Index::init(index_meta, field_metas);
 
   BufferPoolManager &bpm = table->db()->buffer_pool_manager();
   RC rc = index_handler_.open(table->db()->log_handler(), bpm, file_name);
@@ -68,6 +120,12 @@ RC BplusTreeIndex::open(Table *table, const char *file_name, const IndexMeta &in
     return rc;
   }
 
+  rc = init_key_encoder(file_name);
+  if (OB_FAIL(rc)) {
+    index_handler_.close();
+    return rc;
+  }
+
   inited_ = true;
   table_  = table;
   LOG_INFO("Successfully open index, file_name:%s, index:%s, field:%s",
@@ -75,6 +133,37 @@ RC BplusTreeIndex::open(Table *table, const char *file_name, const IndexMeta &in
   return RC::SUCCESS;
 }
 
+RC BplusTreeIndex::init_key_encoder(const char *file_name)
+{
+  const IndexFileHeader &header = index_handler_.file_header();
+  if (header.attr_type != AttrType::UNDEFINED) {
+    // 旧版本的单字段索引，键值就是字段的原始数据
+    if (field_metas_.size() != 1 || header.attr_type != field_metas_[0].type() ||
+        header.attr_length != field_metas_[0].len()) {
+      LOG_WARN("index file does not match the index meta. file_name:%s, index:%s, header:%s",
+          file_name, index_meta_.name(), header.to_string().c_str());
+      return RC::INTERNAL;
+    }
+    encoded_ = false;
+    return RC::SUCCESS;
+  }
+
+  RC rc = key_encoder_.init(field_metas_);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to init index key encoder, file_name:%s, index:%s, rc:%s", file_name, index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  if (header.attr_length != key_encoder_.key_length()) {
+    LOG_WARN("index key length mismatch. file_name:%s, index:%s, key length in file:%d, expected:%d",
+        file_name, index_meta_.name(), header.attr_length, key_encoder_.key_length());
+    return RC::INTERNAL;
+  }
+
+  encoded_ = true;
+  return RC::SUCCESS;
+}
+
 RC BplusTreeIndex::close()
 {
   if (inited_) {
@@ -86,14 +175,61 @@ RC BplusTreeIndex::close()
   return RC::SUCCESS;
 }
 
+const char *BplusTreeIndex::make_key(const char *record, char *key_buf) const
+{
+  if (!encoded_) {
+    return record + field_metas_[0].offset();
+  }
+
+  key_encoder_.encode_record(record, key_buf);
+  return key_buf;
+}
+
 RC BplusTreeIndex::insert_entry(const char *record, const RID *rid)
 {
-  return index_handler_.insert_entry(record + field_meta_.offset(), rid);
+  KeyBuffer key_buf(index_handler_.file_header().attr_length);
+  return index_handler_.insert_entry(make_key(record, key_buf.data()), rid);
 }
 
 RC BplusTreeIndex::delete_entry(const char *record, const RID *rid)
 {
-  return index_handler_.delete_entry(record + field_meta_.offset(), rid);
+  KeyBuffer key_buf(index_handler_.file_header().attr_length);
+  return index_handler_.delete_entry(make_key(record, key_buf.data()), rid);
+}
+
+RC BplusTreeIndex::bulk_load(RecordScanner &scanner)
+{
+  RC           rc = RC::SUCCESS;
+  Record       record;
+  vector<char> entries;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    append_bulk_entry(record.data(), record.rid(), entries);
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan records while bulk loading index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+
+  return bulk_load(entries);
+}
+
+void BplusTreeIndex::append_bulk_entry(const char *record, const RID &rid, vector<char> &entries) const
+{
+  const int    attr_length = index_handler_.file_header().attr_length;
+  const size_t pos         = entries.size();
+  entries.resize(pos + attr_length + sizeof(RID));
+  char *entry = entries.data() + pos;
+  if (encoded_) {
+    key_encoder_.encode_record(record, entry);
+  } else {
+    memcpy(entry, record + field_metas_[0].offset(), attr_length);
+  }
+  memcpy(entry + attr_length, &rid, sizeof(RID));
+}
+
+RC BplusTreeIndex::bulk_load(const vector<char> &entries)
+{
+  return index_handler_.bulk_load(entries, index_meta_.isUnique());
 }
 
 IndexScanner *BplusTreeIndex::create_scanner(
@@ -109,6 +245,52 @@ IndexScanner *BplusTreeIndex::create_scanner(
   return index_scanner;
 }
 
+IndexScanner *BplusTreeIndex::create_scanner(
+    const vector<Value> &left_values, bool left_inclusive, const vector<Value> &right_values, bool right_inclusive)
+{
+  if (!encoded_) {
+    return Index::create_scanner(left_values, left_inclusive, right_values, right_inclusive);
+  }
+
+  const int    key_length = key_encoder_.key_length();
+  vector<char> left_key;
+  vector<char> right_key;
+  if (!left_values.empty()) {
+    left_key.resize(key_length);
+    RC rc = key_encoder_.encode_values(left_values, left_inclusive ? '\x00' : '\xFF', left_key.data());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to encode left key of index scanner. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return nullptr;
+    }
+  }
+
+  if (!right_values.empty()) {
+    right_key.resize(key_length);
+    RC rc = key_encoder_.encode_values(right_values, right_inclusive ? '\xFF' : '\x00', right_key.data());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to encode right key of index scanner. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return nullptr;
+    }
+  }
+
+  return create_scanner(left_key.empty() ? nullptr : left_key.data(), key_length, left_inclusive,
+      right_key.empty() ? nullptr : right_key.data(), key_length, right_inclusive);
+}
+
+bool BplusTreeIndex::match_key(const char *record, const char *key) const
+{
+  const IndexFileHeader &header = index_handler_.file_header();
+  if (!encoded_) {
+    AttrComparator comparator;
+    comparator.init(header.attr_type, header.attr_length);
+    return comparator(record + field_metas_[0].offset(), key) == 0;
+  }
+
+  KeyBuffer key_buf(header.attr_length);
+  key_encoder_.encode_record(record, key_buf.data());
+  return memcmp(key_buf.data(), key, header.attr_length) == 0;
+}
+
 RC BplusTreeIndex::sync() { return index_handler_.sync(); }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -124,6 +306,16 @@ RC BplusTreeIndexScanner::open(
 
 RC BplusTreeIndexScanner::next_entry(RID *rid) { return tree_scanner_.next_entry(*rid); }
 
+RC BplusTreeIndexScanner::next_entries(RID *rids, int capacity, int &count)
+{
+  return tree_scanner_.next_entries(rids, capacity, count);
+}
+
+RC BplusTreeIndexScanner::next_entries_with_keys(RID *rids, char *keys, int capacity, int &count)
+{
+  return tree_scanner_.next_entries(rids, capacity, count, keys);
+}
+
 RC BplusTreeIndexScanner::destroy()
 {
   delete this;
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/index/bplus_tree.h"
 #include "storage/index/index.h"
+#include "storage/index/index_key.h"
 
 /**
  * @brief B+树索引
@@ -27,26 +28,64 @@ public:
   BplusTreeIndex() = default;
   virtual ~BplusTreeIndex() noexcept;
 
-  RC create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta) override;
+  RC create(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const vector<const FieldMeta *> &field_metas) override;
   RC drop(Table *table) override;
-  RC open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta) override;
+  RC open(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const vector<const FieldMeta *> &field_metas) override;
   RC close();
 
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
+  /**
+   * @brief 收集所有记录的键值，自底向上构建B+树
+   */
+  RC bulk_load(RecordScanner &scanner) override;
+
+  bool can_bulk_load() const override { return index_handler_.is_empty(); }
+
+  /// 索引项的格式与叶子节点中的键值相同，即 user_key 加上 RID
+  void append_bulk_entry(const char *record, const RID &rid, vector<char> &entries) const override;
+  RC   bulk_load(const vector<char> &entries) override;
+
   /**
    * 扫描指定范围的数据
+   * @details 键值是B+树中存放的格式，即编码之后的键值
    */
   IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
       int right_len, bool right_inclusive) override;
 
+  /**
+   * @brief 把边界值编码成键值之后再扫描
+   * @details 没有给出的字段，左边界包含时填充最小值，不包含时填充最大值，右边界相反
+   */
+  IndexScanner *create_scanner(const vector<Value> &left_values, bool left_inclusive,
+      const vector<Value> &right_values, bool right_inclusive) override;
+
+  int  key_length() const override { return index_handler_.file_header().attr_length; }
+  bool match_key(const char *record, const char *key) const override;
+
   RC sync() override;
 
+private:
+  RC init_key_encoder(const char *file_name);
+
+  /**
+   * @brief 获取记录对应的键值
+   * @param key_buf 编码键值使用的缓存，长度为 key_length
+   */
+  const char *make_key(const char *record, char *key_buf) const;
+
 private:
   bool             inited_ = false;
   Table           *table_  = nullptr;
   BplusTreeHandler index_handler_;
+
+  /// 多个字段的索引把字段编码成一个按字节比较的键值。
+  /// 旧版本创建的单字段索引以及不能编码的类型上的单字段索引直接存放字段的原始数据，此时 encoded_ 为 false
+  IndexKeyEncoder key_encoder_;
+  bool            encoded_ = true;
 };
 
 /**
@@ -60,6 +99,8 @@ public:
   ~BplusTreeIndexScanner() noexcept override;
 
   RC next_entry(RID *rid) override;
+  RC next_entries(RID *rids, int capacity, int &count) override;
+  RC next_entries_with_keys(RID *rids, char *keys, int capacity, int &count) override;
   RC destroy() override;
 
   RC open(const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len,
@@ -13,10 +13,57 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/index/index.h"
+#include "storage/record/record_scanner.h"
 
-RC Index::init(const IndexMeta &index_meta, const FieldMeta &field_meta)
+RC Index::init(const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas)
 {
   index_meta_ = index_meta;
-  field_meta_ = field_meta;
+  field_metas_.clear();
+  for (const FieldMeta *field_meta : field_metas) {
+    field_metas_.push_back(*field_meta);
+  }
   return RC::SUCCESS;
 }
+
+RC Index::bulk_load(RecordScanner &scanner)
+{
+  RC     rc = RC::SUCCESS;
+  Record record;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    rc = insert_entry(record.data(), &record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert record into index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+      return rc;
+    }
+  }
+  return RC::RECORD_EOF == rc ? RC::SUCCESS : rc;
+}
+
+IndexScanner *Index::create_scanner(
+    const vector<Value> &left_values, bool left_inclusive, const vector<Value> &right_values, bool right_inclusive)
+{
+  if (field_metas_.size() != 1 || left_values.size() > 1 || right_values.size() > 1) {
+    LOG_WARN("index does not support multi-field scan. index=%s", index_meta_.name());
+    return nullptr;
+  }
+
+  const char *left_key  = left_values.empty() ? nullptr : left_values[0].data();
+  const int   left_len  = left_values.empty() ? 0 : left_values[0].length();
+  const char *right_key = right_values.empty() ? nullptr : right_values[0].data();
+  const int   right_len = right_values.empty() ? 0 : right_values[0].length();
+  return create_scanner(left_key, left_len, left_inclusive, right_key, right_len, right_inclusive);
+}
+
+RC IndexScanner::next_entries(RID *rids, int capacity, int &count)
+{
+  RC rc = RC::SUCCESS;
+  for (count = 0; count < capacity; count++) {
+    rc = next_entry(&rids[count]);
+    if (OB_FAIL(rc)) {
+      break;
+    }
+  }
+
+  // 已经拿到的数据先返回，错误在下次调用时再返回
+  return count > 0 ? RC::SUCCESS : rc;
+}
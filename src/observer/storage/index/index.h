@@ -17,12 +17,15 @@ See the Mulan PSL v2 for more details. */
 #include <stddef.h>
 #include <vector>
 
+#include "common/value.h"
+
 #include "common/sys/rc.h"
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 #include "storage/record/record_manager.h"
 
 class IndexScanner;
+class RecordScanner;
 
 /**
  * @brief 索引
@@ -40,11 +43,16 @@ public:
   Index()          = default;
   virtual ~Index() = default;
 
-  virtual RC create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+  /**
+   * @param field_metas 索引包含的字段，顺序与 index_meta 中的字段顺序一致
+   */
+  virtual RC create(
+      Table *table, const char *file_name, const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas)
   {
     return RC::UNSUPPORTED;
   }
-  virtual RC open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta)
+  virtual RC open(
+      Table *table, const char *file_name, const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas)
   {
     return RC::UNSUPPORTED;
   }
@@ -52,7 +60,11 @@ public:
   virtual bool is_vector_index() { return false; }
 
   const IndexMeta &index_meta() const { return index_meta_; }
-  const FieldMeta &field_meta() const { return field_meta_; }
+  /**
+   * @brief 索引的第一个字段
+   */
+  const FieldMeta         &field_meta() const { return field_metas_[0]; }
+  const vector<FieldMeta> &field_metas() const { return field_metas_; }
   virtual RC drop(Table *table) = 0;
   /**
    * @brief 插入一条数据
@@ -70,6 +82,30 @@ public:
    */
   virtual RC delete_entry(const char *record, const RID *rid) = 0;
 
+  /**
+   * @brief 使用表中已有的数据填充索引
+   * @details 创建索引时调用，此时索引中还没有数据。默认逐条插入，子类可以实现更高效的批量构建
+   * @param scanner 表的记录扫描器，会遍历到结束
+   */
+  virtual RC bulk_load(RecordScanner &scanner);
+
+  /**
+   * @brief 是否可以使用 append_bulk_entry 收集的索引项批量构建
+   * @details 索引为空并且支持批量构建时返回 true，比如 LOAD DATA 导入到空的索引中
+   */
+  virtual bool can_bulk_load() const { return false; }
+
+  /**
+   * @brief 把一条记录的索引项追加到 entries 中，格式由子类决定，参考 bulk_load(const vector<char> &)
+   */
+  virtual void append_bulk_entry(const char *record, const RID &rid, vector<char> &entries) const {}
+
+  /**
+   * @brief 使用 append_bulk_entry 收集的索引项批量构建索引
+   * @details 只能在 can_bulk_load 返回 true 时调用。唯一索引存在重复的值时返回 RECORD_NOT_UNIQUE，索引仍然为空
+   */
+  virtual RC bulk_load(const vector<char> &entries) { return RC::UNSUPPORTED; }
+
   /**
    * @brief 创建一个索引数据的扫描器
    *
@@ -83,6 +119,28 @@ public:
   virtual IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
       int right_len, bool right_inclusive) = 0;
 
+  /**
+   * @brief 使用索引前面若干个字段的取值创建扫描器
+   * @details 左右边界分别对应索引的前几个字段，比如索引(a,b,c)，左边界(1,2)、右边界(1,5)表示
+   * a=1 并且 2<=b<=5。没有给出的字段不做限制。默认实现只支持单个字段的索引
+   * @param left_values 左边界，为空表示没有左边界
+   * @param right_values 右边界，为空表示没有右边界
+   */
+  virtual IndexScanner *create_scanner(const vector<Value> &left_values, bool left_inclusive,
+      const vector<Value> &right_values, bool right_inclusive);
+
+  /**
+   * @brief 索引项中键值的长度，扫描器不能返回键值时为 0
+   */
+  virtual int key_length() const { return 0; }
+
+  /**
+   * @brief 记录在当前索引上的键值是否与索引项的键值 key 相同
+   * @details 原地更新的记录在索引中每个不同的键值各有一个索引项，扫描时用来找出记录的可见版本对应的那一个
+   * @param key 长度为 key_length，由 IndexScanner::next_entries_with_keys 返回
+   */
+  virtual bool match_key(const char *record, const char *key) const { return true; }
+
   /**
    * @brief 同步索引数据到磁盘
    *
@@ -90,11 +148,11 @@ public:
   virtual RC sync() = 0;
 
 protected:
-  RC init(const IndexMeta &index_meta, const FieldMeta &field_meta);
+  RC init(const IndexMeta &index_meta, const vector<const FieldMeta *> &field_metas);
 
 protected:
-  IndexMeta index_meta_;  ///< 索引的元数据
-  FieldMeta field_meta_;  ///< 当前实现仅考虑一个字段的索引
+  IndexMeta         index_meta_;   ///< 索引的元数据
+  vector<FieldMeta> field_metas_;  ///< 索引包含的字段，按照索引中的顺序排列
 };
 
 /**
@@ -112,5 +170,21 @@ public:
    * 如果没有更多的元素，返回RECORD_EOF
    */
   virtual RC next_entry(RID *rid) = 0;
-  virtual RC destroy()            = 0;
+
+  /**
+   * @brief 批量遍历元素数据
+   * @details 默认逐条调用 next_entry，子类可以一次返回更多的数据
+   * @param[out] rids 长度至少为 capacity
+   * @param[out] count 返回的元素个数。如果没有更多的元素，返回RECORD_EOF
+   */
+  virtual RC next_entries(RID *rids, int capacity, int &count);
+
+  /**
+   * @brief 批量遍历元素数据，同时返回每个元素的键值
+   * @details 只有 Index::key_length 大于 0 的索引支持
+   * @param[out] keys 长度至少为 capacity * Index::key_length
+   */
+  virtual RC next_entries_with_keys(RID *rids, char *keys, int capacity, int &count) { return RC::UNSUPPORTED; }
+
+  virtual RC destroy() = 0;
 };
@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/index/index_key.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string.h"
+#include "common/log/log.h"
+
+/**
+ * @brief 按大端序写入32位整数，这样字节序与数值大小一致
+ */
+static void store_big_endian(uint32_t value, char *key)
+{
+  key[0] = static_cast<char>(value >> 24);
+  key[1] = static_cast<char>(value >> 16);
+  key[2] = static_cast<char>(value >> 8);
+  key[3] = static_cast<char>(value);
+}
+
+RC IndexKeyEncoder::init(const vector<FieldMeta> &field_metas)
+{
+  if (field_metas.empty()) {
+    LOG_WARN("index key should contain at least one field");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  key_length_ = 0;
+  for (const FieldMeta &field_meta : field_metas) {
+    if (!is_supported(field_meta.type())) {
+      LOG_WARN("unsupported index field type. field=%s, type=%s",
+          field_meta.name(), attr_type_to_string(field_meta.type()));
+      return RC::UNSUPPORTED;
+    }
+    key_length_ += field_meta.len();
+  }
+
+  field_metas_ = field_metas;
+  return RC::SUCCESS;
+}
+
+bool IndexKeyEncoder::is_supported(AttrType type)
+{
+  switch (type) {
+    case AttrType::INTS:
+    case AttrType::DATES:
+    case AttrType::FLOATS:
+    case AttrType::CHARS:
+    case AttrType::BOOLEANS: return true;
+    default: return false;
+  }
+}
+
+void IndexKeyEncoder::encode_record(const char *record, char *key) const
+{
+  for (const FieldMeta &field_meta : field_metas_) {
+    encode_field(field_meta.type(), record + field_meta.offset(), field_meta.len(), field_meta.len(), key);
+    key += field_meta.len();
+  }
+}
+
+RC IndexKeyEncoder::encode_values(const vector<Value> &values, char padding, char *key) const
+{
+  if (values.size() > field_metas_.size()) {
+    LOG_WARN("too many values for index key. value num=%ld, field num=%ld", values.size(), field_metas_.size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  char *end = key + key_length_;
+  for (size_t i = 0; i < values.size(); i++) {
+    const FieldMeta &field_meta = field_metas_[i];
+    const Value     &value      = values[i];
+    if (value.attr_type() != field_meta.type()) {
+      LOG_WARN("value type mismatch with index field. field=%s, field type=%s, value type=%s",
+          field_meta.name(), attr_type_to_string(field_meta.type()), attr_type_to_string(value.attr_type()));
+      return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+    }
+
+    encode_field(field_meta.type(), value.data(), value.length(), field_meta.len(), key);
+    key += field_meta.len();
+  }
+
+  memset(key, padding, end - key);
+  return RC::SUCCESS;
+}
+
+void IndexKeyEncoder::encode_field(AttrType type, const char *data, int data_len, int field_len, char *key)
+{
+  switch (type) {
+    case AttrType::INTS:
+    case AttrType::DATES: {
+      int32_t value = 0;
+      memcpy(&value, data, sizeof(value));
+      store_big_endian(static_cast<uint32_t>(value) ^ 0x80000000u, key);
+    } break;
+
+    case AttrType::FLOATS: {
+      float value = 0;
+      memcpy(&value, data, sizeof(value));
+      uint32_t bits = 0;
+      if (value != 0) {  // -0.0 与 0.0 相等，使用相同的编码
+        memcpy(&bits, &value, sizeof(bits));
+      }
+      bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+      store_big_endian(bits, key);
+    } break;
+
+    case AttrType::CHARS: {
+      // 记录中字符串结束符之后的数据可能是之前的残留数据，不能参与比较
+      const int len = static_cast<int>(strnlen(data, std::min(data_len, field_len)));
+      memcpy(key, data, len);
+      memset(key + len, 0, field_len - len);
+    } break;
+
+    default: {
+      memcpy(key, data, field_len);
+    } break;
+  }
+}
@@ -0,0 +1,64 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/sys/rc.h"
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "storage/field/field_meta.h"
+
+/**
+ * @brief 把索引的一个或多个字段编码成可以直接按字节比较的键值
+ * @ingroup Index
+ * @details 按照索引中字段的顺序依次编码，每个字段编码后的长度与字段长度相同，键值长度就是所有字段长度之和。
+ * 编码之后两个键值的大小关系与按字段依次比较的结果一致，所以比较时只需要一次 memcmp，不需要再按照类型分派。
+ * - INTS/DATES: 翻转符号位后按大端序存放
+ * - FLOATS: 正数翻转符号位，负数所有位取反，然后按大端序存放
+ * - CHARS: 保留字符串本身，结束符之后全部补0
+ * - BOOLEANS: 原样存放
+ */
+class IndexKeyEncoder
+{
+public:
+  IndexKeyEncoder() = default;
+
+  RC init(const vector<FieldMeta> &field_metas);
+
+  int key_length() const { return key_length_; }
+  int field_num() const { return static_cast<int>(field_metas_.size()); }
+
+  /**
+   * @brief 从记录中取出索引的所有字段并编码
+   * @param[out] key 长度为 key_length
+   */
+  void encode_record(const char *record, char *key) const;
+
+  /**
+   * @brief 编码索引前面若干个字段的取值，用于范围扫描
+   * @details 剩余的字段使用 padding 填充，0x00 表示剩余字段取最小值，0xFF 表示剩余字段取最大值
+   * @param values 按照顺序对应索引的前几个字段，类型需要与字段类型相同
+   * @param[out] key 长度为 key_length
+   */
+  RC encode_values(const vector<Value> &values, char padding, char *key) const;
+
+  /**
+   * @brief 当前类型的字段是否可以编码
+   * @details 不能编码的类型只能建单字段索引，由 BplusTreeIndex 存放原始数据并使用字段类型比较
+   */
+  static bool is_supported(AttrType type);
+
+private:
+  static void encode_field(AttrType type, const char *data, int data_len, int field_len, char *key);
+
+private:
+  vector<FieldMeta> field_metas_;
+  int               key_length_ = 0;
+};
@@ -21,17 +21,26 @@ See the Mulan PSL v2 for more details. */
 
 const static Json::StaticString FIELD_NAME("name");
 const static Json::StaticString FIELD_FIELD_NAME("field_name");
+const static Json::StaticString FIELD_FIELD_NAMES("field_names");
 const static Json::StaticString UNIQUE("unique");
 
-RC IndexMeta::init(const char *name, const FieldMeta &field, bool isUnique)
+RC IndexMeta::init(const char *name, const vector<const FieldMeta *> &fields, bool isUnique)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Failed to init index, name is empty.");
     return RC::INVALID_ARGUMENT;
   }
 
-  name_  = name;
-  field_ = field.name();
+  if (fields.empty()) {
+    LOG_ERROR("Failed to init index, no field. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  name_ = name;
+  fields_.clear();
+  for (const FieldMeta *field : fields) {
+    fields_.emplace_back(field->name());
+  }
   isUnique_ = isUnique;
   return RC::SUCCESS;
 }
@@ -39,29 +48,52 @@ RC IndexMeta::init(const char *name, const FieldMeta &field, bool isUnique)
 void IndexMeta::to_json(Json::Value &json_value) const
 {
   json_value[FIELD_NAME]       = name_;
-  json_value[FIELD_FIELD_NAME] = field_;
+  json_value[FIELD_FIELD_NAME] = fields_[0];
   json_value[UNIQUE]           = isUnique_;
+
+  Json::Value field_names(Json::arrayValue);
+  for (const string &field : fields_) {
+    field_names.append(field);
+  }
+  json_value[FIELD_FIELD_NAMES] = std::move(field_names);
 }
 
 RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, IndexMeta &index)
 {
   const Json::Value &name_value  = json_value[FIELD_NAME];
-  const Json::Value &field_value = json_value[FIELD_FIELD_NAME];
   if (!name_value.isString()) {
     LOG_ERROR("Index name is not a string. json value=%s", name_value.toStyledString().c_str());
     return RC::INTERNAL;
   }
 
-  if (!field_value.isString()) {
-    LOG_ERROR("Field name of index [%s] is not a string. json value=%s",
-        name_value.asCString(), field_value.toStyledString().c_str());
+  // 只有一个字段的旧版本元数据中没有 field_names
+  Json::Value field_values(Json::arrayValue);
+  if (json_value.isMember(FIELD_FIELD_NAMES)) {
+    field_values = json_value[FIELD_FIELD_NAMES];
+  } else {
+    field_values.append(json_value[FIELD_FIELD_NAME]);
+  }
+
+  if (!field_values.isArray() || field_values.empty()) {
+    LOG_ERROR("Field names of index [%s] is not a non-empty array. json value=%s",
+        name_value.asCString(), field_values.toStyledString().c_str());
     return RC::INTERNAL;
   }
 
-  const FieldMeta *field = table.field(field_value.asCString());
-  if (nullptr == field) {
-    LOG_ERROR("Deserialize index [%s]: no such field: %s", name_value.asCString(), field_value.asCString());
-    return RC::SCHEMA_FIELD_MISSING;
+  vector<const FieldMeta *> fields;
+  for (const Json::Value &field_value : field_values) {
+    if (!field_value.isString()) {
+      LOG_ERROR("Field name of index [%s] is not a string. json value=%s",
+          name_value.asCString(), field_value.toStyledString().c_str());
+      return RC::INTERNAL;
+    }
+
+    const FieldMeta *field = table.field(field_value.asCString());
+    if (nullptr == field) {
+      LOG_ERROR("Deserialize index [%s]: no such field: %s", name_value.asCString(), field_value.asCString());
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    fields.push_back(field);
   }
 
   bool isUnique = false;
@@ -69,13 +101,20 @@ RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, I
     isUnique = json_value[UNIQUE].asBool();
   }
 
-  return index.init(name_value.asCString(), *field, isUnique);
+  return index.init(name_value.asCString(), fields, isUnique);
 }
 
 const char *IndexMeta::name() const { return name_.c_str(); }
 
-const char *IndexMeta::field() const { return field_.c_str(); }
+const char *IndexMeta::field() const { return fields_[0].c_str(); }
 
 bool IndexMeta::isUnique() const { return isUnique_; }
 
-void IndexMeta::desc(ostream &os) const { os << "index name=" << name_ << ", field=" << field_ << ", unique=" << isUnique_; }
\ No newline at end of file
+void IndexMeta::desc(ostream &os) const
+{
+  os << "index name=" << name_ << ", field=";
+  for (size_t i = 0; i < fields_.size(); i++) {
+    os << (i == 0 ? "" : ",") << fields_[i];
+  }
+  os << ", unique=" << isUnique_;
+}
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/sys/rc.h"
 #include "common/lang/string.h"
+#include "common/lang/vector.h"
 
 class TableMeta;
 class FieldMeta;
@@ -27,7 +28,7 @@ class Value;
 /**
  * @brief 描述一个索引
  * @ingroup Index
- * @details 一个索引包含了表的哪些字段，索引的名称等。
+ * @details 一个索引包含了表的哪些字段，索引的名称等。一个索引可以包含多个字段，字段的顺序决定了键值的顺序。
  * 如果以后实现了多种类型的索引，还需要记录索引的类型，对应类型的一些元数据等
  */
 class IndexMeta
@@ -35,12 +36,17 @@ class IndexMeta
 public:
   IndexMeta() = default;
 
-  RC init(const char *name, const FieldMeta &field, bool isUnique);
+  RC init(const char *name, const vector<const FieldMeta *> &fields, bool isUnique);
 
 public:
   const char *name() const;
-  const char *field() const;
-  bool        isUnique() const;
+  /**
+   * @brief 索引的第一个字段
+   */
+  const char           *field() const;
+  const vector<string> &fields() const { return fields_; }
+  int                   field_num() const { return static_cast<int>(fields_.size()); }
+  bool                  isUnique() const;
 
   void desc(ostream &os) const;
 
@@ -49,7 +55,7 @@ public:
   static RC from_json(const TableMeta &table, const Json::Value &json_value, IndexMeta &index);
 
 protected:
-  string name_;   // index's name
-  string field_;  // field's name
-  bool   isUnique_;
+  string         name_;    // index's name
+  vector<string> fields_;  // fields' name, 按照索引中的顺序排列
+  bool           isUnique_;
 };
@@ -18,7 +18,8 @@ RC HeapRecordScanner::open_scan()
   ASSERT(disk_buffer_pool_ != nullptr, "disk buffer pool is null");
   ASSERT(log_handler_ != nullptr, "log handler is null");
 
-  RC rc = bp_iterator_.init(*disk_buffer_pool_, 1);
+  // 指定页面范围时从一个空的范围开始，第一次获取记录时领取页面范围
+  RC rc = morsels_ == nullptr ? bp_iterator_.init(*disk_buffer_pool_, 1) : bp_iterator_.init(*disk_buffer_pool_, 1, 1);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -53,7 +54,13 @@ RC HeapRecordScanner::fetch_next_record()
   }
 
   // 上个页面遍历完了，或者还没有开始遍历某个页面，那么就从一个新的页面开始遍历查找
-  while (bp_iterator_.has_next()) {
+  while (true) {
+    if (!bp_iterator_.has_next()) {
+      if (next_morsel()) {
+        continue;
+      }
+      break;
+    }
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
     rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
@@ -78,6 +85,22 @@ RC HeapRecordScanner::fetch_next_record()
   return RC::RECORD_EOF;
 }
 
+bool HeapRecordScanner::next_morsel()
+{
+  if (morsels_ == nullptr) {
+    return false;
+  }
+
+  PageNum begin = 0;
+  PageNum end   = 0;
+  morsels_->next(begin, end);
+  if (begin >= disk_buffer_pool_->page_count()) {
+    return false;
+  }
+  bp_iterator_.init(*disk_buffer_pool_, begin, end);
+  return true;
+}
+
 /**
  * @brief 遍历当前页面，尝试找到一条有效的记录
  */
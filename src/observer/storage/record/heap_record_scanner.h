@@ -13,23 +13,27 @@ See the Mulan PSL v2 for more details. */
 #include "storage/record/record_scanner.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/trx/trx.h"
+#include "storage/record/record_manager.h"
+#include "common/lang/memory.h"
 
 /**
  * @brief 遍历某个文件中所有记录
  * @ingroup RecordManager
- * @details 遍历所有的页面，同时访问这些页面中所有的记录
+ * @details 遍历所有的页面，同时访问这些页面中所有的记录。
+ * 指定 PageMorselSource 时只遍历从中领取的页面范围，比如收集统计信息时只采样一部分页面。
  */
 class HeapRecordScanner : public RecordScanner
 {
 public:
   HeapRecordScanner(Table *table, DiskBufferPool &buffer_pool, Trx *trx, LogHandler &log_handler, ReadWriteMode mode,
-      ConditionFilter *condition_filter)
+      ConditionFilter *condition_filter, shared_ptr<PageMorselSource> morsels = nullptr)
       : table_(table),
         disk_buffer_pool_(&buffer_pool),
         trx_(trx),
         log_handler_(&log_handler),
         rw_mode_(mode),
-        condition_filter_(condition_filter)
+        condition_filter_(condition_filter),
+        morsels_(std::move(morsels))
   {}
   ~HeapRecordScanner() override { close_scan(); }
 
@@ -61,6 +65,11 @@ private:
    */
   RC fetch_next_record_in_page();
 
+  /**
+   * @brief 领取下一个页面范围，范围超过文件结尾时返回 false
+   */
+  bool next_morsel();
+
 private:
   // TODO 对于一个纯粹的record遍历器来说，不应该关心表和事务
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。这个字段仅供事务函数使用，如果设计合适，可以去掉
@@ -75,4 +84,6 @@ private:
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
   RecordPageIterator record_page_iterator_;           ///< 遍历某个页面上的所有record
   Record             next_record_;                    ///< 获取的记录放在这里缓存起来
+
+  shared_ptr<PageMorselSource> morsels_;  ///< 只遍历部分页面时从这里领取页面范围
 };
\ No newline at end of file
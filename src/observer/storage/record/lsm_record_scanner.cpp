@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/record/lsm_record_scanner.h"
 #include "storage/common/codec.h"
+#include "storage/table/lsm_table_engine.h"
 #include "storage/trx/lsm_mvcc_trx.h"
 
 RC LsmRecordScanner::open_scan()
@@ -23,6 +24,7 @@ RC LsmRecordScanner::open_scan()
     lsm_iter_ = oblsm_->new_iterator(ObLsmReadOptions());
   } else if (trx_->type() == TrxKit::Type::LSM) {
     auto lsm_trx = dynamic_cast<LsmMvccTrx *>(trx_);
+    lsm_trx->start_if_need();
     lsm_iter_ = lsm_trx->get_trx()->new_iterator(ObLsmReadOptions());
   }
   bytes encoded_key;
@@ -52,12 +54,14 @@ RC LsmRecordScanner::next(Record &record)
     string_view lsm_value = lsm_iter_->value();
     string_view lsm_key = lsm_iter_->key();
     int64_t table_id = 0;
+    uint64_t row_id = 0;
     bytes lsm_key_bytes(lsm_key.begin(), lsm_key.end());
-    Codec::decode(lsm_key_bytes, table_id);
+    Codec::decode(lsm_key_bytes, table_id, row_id);
     if (table_id != table_->table_id()) {
       LOG_TRACE("table id not match, table id: %ld", table_->table_id());
       return RC::RECORD_EOF;
     }
+    record.set_rid(LsmTableEngine::row_id_to_rid(row_id));
     record.set_key(string(lsm_key));
     record.copy_data((char *)lsm_value.data(), lsm_value.length());
     lsm_iter_->next();
@@ -174,6 +174,11 @@ public:
 
   void set_data(char *data, int len = 0)
   {
+    // 扫描时会复用同一个record，之前可能持有自己的内存(比如事务替换成了旧版本)，需要先释放
+    if (owner_ && data_ != data) {
+      free(data_);
+      owner_ = false;
+    }
     this->data_ = data;
     this->len_  = len;
   }
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "common/lang/sstream.h"
 #include "common/lang/defer.h"
+#include "common/math/crc.h"
 #include "storage/clog/log_handler.h"
 #include "storage/record/record.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -37,6 +38,7 @@ string RecordOperation::to_string() const
     case Type::INSERT: return ret + "INSERT";
     case Type::DELETE: return ret + "DELETE";
     case Type::UPDATE: return ret + "UPDATE";
+    case Type::PAGE_IMAGE: return ret + "PAGE_IMAGE";
     default: return ret + "UNKNOWN";
   }
 }
@@ -61,6 +63,7 @@ string RecordLogHeader::to_string() const
     case RecordOperation::Type::UPDATE: {
       ss << ", slot_num:" << slot_num;
     } break;
+    case RecordOperation::Type::PAGE_IMAGE: break;
     default: {
       ss << ", unknown operation type";
     } break;
@@ -149,6 +152,27 @@ RC RecordLogHandler::update_record(Frame *frame, const RID &rid, const char *rec
   return rc;
 }
 
+RC RecordLogHandler::page_image(Frame *frame)
+{
+  const int        log_payload_size = RecordLogHeader::SIZE + BP_PAGE_DATA_SIZE;
+  vector<char>     log_payload(log_payload_size);
+  RecordLogHeader *header = reinterpret_cast<RecordLogHeader *>(log_payload.data());
+  header->buffer_pool_id  = buffer_pool_id_;
+  header->operation_type  = RecordOperation(RecordOperation::Type::PAGE_IMAGE).type_id();
+  header->page_num        = frame->page_num();
+  header->record_size     = record_size_;
+  header->storage_format  = static_cast<int>(storage_format_);
+  memcpy(log_payload.data() + RecordLogHeader::SIZE, frame->data(), BP_PAGE_DATA_SIZE);
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::RECORD_MANAGER, std::move(log_payload));
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn);
+    frame->mark_image_logged();
+  }
+  return rc;
+}
+
 RC RecordLogHandler::delete_record(Frame *frame, const RID &rid)
 {
   RecordLogHeader header;
@@ -207,7 +231,10 @@ RC RecordLogReplayer::replay(const LogEntry &entry)
 
   const LSN frame_lsn = frame->lsn();
 
-  if (frame_lsn >= entry.lsn()) {
+  // 跳过二次写的页面可能只写了一半，这时页面上的 lsn 不可信，需要用日志中的页面镜像修复
+  const bool torn_page_image = RecordOperation(log_header->operation_type).type() == RecordOperation::Type::PAGE_IMAGE &&
+                               crc32(frame->data(), BP_PAGE_DATA_SIZE) != frame->check_sum();
+  if (frame_lsn >= entry.lsn() && !torn_page_image) {
     LOG_TRACE("page %d has been initialized, skip replaying record log. frame lsn %d, log lsn %d", 
               log_header->page_num, frame_lsn, entry.lsn());
     return RC::SUCCESS;
@@ -226,6 +253,9 @@ RC RecordLogReplayer::replay(const LogEntry &entry)
     case RecordOperation::Type::UPDATE: {
       rc = replay_update(*buffer_pool, *log_header);
     } break;
+    case RecordOperation::Type::PAGE_IMAGE: {
+      rc = replay_page_image(*frame, entry);
+    } break;
     default: {
       LOG_WARN("unknown record operation type: %d", log_header->operation_type);
       return RC::INVALID_ARGUMENT;
@@ -329,3 +359,18 @@ RC RecordLogReplayer::replay_update(DiskBufferPool &buffer_pool, const RecordLog
 
   return rc;
 }
+
+RC RecordLogReplayer::replay_page_image(Frame &frame, const LogEntry &entry)
+{
+  if (entry.payload_size() != RecordLogHeader::SIZE + BP_PAGE_DATA_SIZE) {
+    LOG_WARN("invalid page image log entry. payload size=%d, expect=%d", 
+             entry.payload_size(), RecordLogHeader::SIZE + BP_PAGE_DATA_SIZE);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  frame.write_latch();
+  memcpy(frame.data(), entry.data() + RecordLogHeader::SIZE, BP_PAGE_DATA_SIZE);
+  frame.mark_dirty();
+  frame.write_unlatch();
+  return RC::SUCCESS;
+}
@@ -41,7 +41,8 @@ public:
     INIT_PAGE,  /// 初始化空页面
     INSERT,     /// 插入一条记录
     DELETE,     /// 删除一条记录
-    UPDATE      /// 更新一条记录
+    UPDATE,     /// 更新一条记录
+    PAGE_IMAGE  /// 整个页面的数据，批量导入时使用
   };
 
 public:
@@ -125,6 +126,14 @@ public:
    */
   RC update_record(Frame *frame, const RID &rid, const char *record);
 
+  /**
+   * @brief 记录整个页面的数据
+   * @param frame 页帧
+   * @details 批量导入数据时，一个页面会一次性写入很多行，记录整个页面比逐行记录日志的开销小很多。
+   * 重放时直接覆盖页面内容，所以不依赖页面原来的状态。
+   */
+  RC page_image(Frame *frame);
+
 private:
   LogHandler   *log_handler_    = nullptr;
   int32_t       buffer_pool_id_ = -1;
@@ -149,6 +158,7 @@ private:
   RC replay_insert(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_delete(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
   RC replay_update(DiskBufferPool &buffer_pool, const RecordLogHeader &log_header);
+  RC replay_page_image(Frame &frame, const LogEntry &entry);
 
 private:
   BufferPoolManager &bpm_;
@@ -198,7 +198,6 @@ RC RecordPageHandler::init_empty_page(DiskBufferPool &buffer_pool, LogHandler &l
   // 计算列偏移
   int *column_index = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
   for (int i = 0; i < column_num; ++i) {
-    ASSERT(i == table_meta->field(i)->field_id(), "i should be the col_id of fields[i]");
     if (i == 0) {
       column_index[i] = table_meta->field(i)->len() * page_header_->record_capacity;
     } else {
@@ -440,18 +439,128 @@ bool RecordPageHandler::is_full() const { return page_header_->record_num >= pag
 
 RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
 {
-  // your code here
-  // Todo:
-  // 1.参考RowRecordPageHandler::insert_record完成大体实现
-  // 2.将一行数据拆分成不同的列插入到不同偏移中
-  // 对应列的偏移可以参照RecordPageHandler::init_empty_page
-  return RC::UNIMPLEMENTED;
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 找到空闲位置
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  // 记录日志，与数据库恢复相关
+  RC rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  write_row(index, data);
+
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::insert_chunk(const Chunk &chunk, int start_row, int &insert_rows, vector<RID> *rids)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert chunk into page while the page is readonly");
+
+  insert_rows = 0;
+  if (chunk.column_num() != page_header_->column_num) {
+    LOG_WARN("column num mismatch. chunk column num=%d, page column num=%d", 
+             chunk.column_num(), page_header_->column_num);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int total_rows = chunk.rows() - start_row;
+  if (total_rows <= 0) {
+    return RC::SUCCESS;
+  }
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 每次找到一段连续的空闲位置，按列整段拷贝
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    slot = bitmap.next_unsetted_bit(0);
+  while (slot != -1 && insert_rows < total_rows) {
+    int run_len = 0;
+    while (slot + run_len < page_header_->record_capacity && insert_rows + run_len < total_rows &&
+           !bitmap.get_bit(slot + run_len)) {
+      bitmap.set_bit(slot + run_len);
+      run_len++;
+    }
+
+    const int chunk_row = start_row + insert_rows;
+    for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+      const Column &column = chunk.column(col_id);
+      ASSERT(column.attr_len() == get_field_len(col_id), "column length mismatch");
+      if (column.column_type() == Column::Type::CONSTANT_COLUMN) {
+        for (int i = 0; i < run_len; i++) {
+          memcpy(get_field_data(slot + i, col_id), column.data(), column.attr_len());
+        }
+      } else {
+        column.copy_to(get_field_data(slot, col_id), chunk_row, run_len);
+      }
+    }
+
+    if (rids != nullptr) {
+      for (int i = 0; i < run_len; i++) {
+        rids->emplace_back(get_page_num(), slot + i);
+      }
+    }
+
+    page_header_->record_num += run_len;
+    insert_rows += run_len;
+    slot = bitmap.next_unsetted_bit(slot + run_len);
+  }
+
+  // 记录日志，与数据库恢复相关。整页记录，避免逐行写日志
+  RC rc = log_handler_.page_image(frame_);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to log page image. page_num %d:%d. rc=%s", 
+              disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  frame_->mark_dirty();
+  return RC::SUCCESS;
 }
 
-RC PaxRecordPageHandler::insert_chunk(const Chunk &chunk, int start_row, int &insert_rows)
+RC PaxRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
 {
-  // your code here
-  return RC::UNIMPLEMENTED;
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  // 更新位图
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    bitmap.set_bit(rid.slot_num);
+    page_header_->record_num++;
+  }
+
+  // 恢复数据
+  write_row(rid.slot_num, data);
+
+  frame_->mark_dirty();
+
+  return RC::SUCCESS;
 }
 
 RC PaxRecordPageHandler::delete_record(const RID *rid)
@@ -478,24 +587,136 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
   }
 }
 
+RC PaxRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "cannot update record in page while the page is readonly");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (bitmap.get_bit(rid.slot_num)) {
+    frame_->mark_dirty();
+
+    write_row(rid.slot_num, data);
+
+    RC rc = log_handler_.update_record(frame_, rid, data);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s", 
+                disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+      // return rc; // ignore errors
+    }
+
+    return RC::SUCCESS;
+  } else {
+    LOG_DEBUG("Invalid slot_num %d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+}
+
 RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
 {
-  // your code here
-  // Todo:
-  // 1.参考RowRecordPageHandler::get_record完成大体实现
-  // 2.通过列的偏移拼接出完整的行数据
-  // 可以参照PaxRecordPageHandler::insert_record的实现
-  return RC::UNIMPLEMENTED;
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  // 列数据在页面内不连续，需要拼接成一行，所以这里的 record 拥有自己的内存
+  RC rc = record.new_record(page_header_->record_real_size);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  read_row(rid.slot_num, record.data());
+  record.set_rid(rid);
+  return RC::SUCCESS;
 }
 
-// TODO: specify the column_ids that chunk needed. currenly we get all columns
 RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
 {
-  // your code here
-  // Todo:
-  // 参照PaxRecordPageHandler::get_record
-  // 一次性获得一个page的所有record
-  return RC::UNIMPLEMENTED;
+  for (int i = 0; i < chunk.column_num(); i++) {
+    const int col_id = chunk.column_ids(i);
+    if (col_id < 0 || col_id >= page_header_->column_num) {
+      LOG_WARN("invalid column id %d, page column num=%d", col_id, page_header_->column_num);
+      return RC::INVALID_ARGUMENT;
+    }
+    if (chunk.column(i).attr_len() != get_field_len(col_id)) {
+      LOG_WARN("column length mismatch. col_id=%d, column len=%d, field len=%d", 
+               col_id, chunk.column(i).attr_len(), get_field_len(col_id));
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
+  const int record_num = page_header_->record_num;
+  Bitmap    bitmap(bitmap_, page_header_->record_capacity);
+  const int first_hole = bitmap.next_unsetted_bit(0);
+  if (first_hole == -1 || first_hole >= record_num) {
+    // 记录都连续存放在页面的前 record_num 个位置，直接引用页面中的列数据
+    for (int i = 0; i < chunk.column_num(); i++) {
+      chunk.column(i).reference(get_field_data(0, chunk.column_ids(i)), record_num);
+    }
+    return RC::SUCCESS;
+  }
+
+  // 页面中有空洞，按照 bitmap 把连续的有效记录整段拷贝出来
+  for (int i = 0; i < chunk.column_num(); i++) {
+    Column &column = chunk.column(i);
+    if (!column.is_owned() || column.capacity() < record_num) {
+      column.init(column.attr_type(), column.attr_len(), max(column.capacity(), page_header_->record_capacity));
+    }
+    column.reset_data();
+  }
+
+  int slot = bitmap.next_setted_bit(0);
+  while (slot != -1) {
+    int run_len = 1;
+    while (slot + run_len < page_header_->record_capacity && bitmap.get_bit(slot + run_len)) {
+      run_len++;
+    }
+
+    for (int i = 0; i < chunk.column_num(); i++) {
+      RC rc = chunk.column(i).append(get_field_data(slot, chunk.column_ids(i)), run_len);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append column data. slot=%d, rows=%d, rc=%s", slot, run_len, strrc(rc));
+        return rc;
+      }
+    }
+
+    if (slot + run_len >= page_header_->record_capacity) {
+      break;
+    }
+    slot = bitmap.next_setted_bit(slot + run_len);
+  }
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::write_row(SlotNum slot_num, const char *data)
+{
+  int field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(get_field_data(slot_num, col_id), data + field_offset, field_len);
+    field_offset += field_len;
+  }
+}
+
+void PaxRecordPageHandler::read_row(SlotNum slot_num, char *data)
+{
+  int field_offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; col_id++) {
+    const int field_len = get_field_len(col_id);
+    memcpy(data + field_offset, get_field_data(slot_num, col_id), field_len);
+    field_offset += field_len;
+  }
 }
 
 char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
@@ -582,13 +803,11 @@ RC RecordFileHandler::init_free_pages()
   return rc;
 }
 
-RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+RC RecordFileHandler::get_free_page(RecordPageHandler &record_page_handler, int record_size)
 {
-  RC ret = RC::SUCCESS;
-
-  unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
-  bool                          page_found       = false;
-  PageNum                       current_page_num = 0;
+  RC      ret              = RC::SUCCESS;
+  bool    page_found       = false;
+  PageNum current_page_num = 0;
 
   // 当前要访问free_pages对象，所以需要加锁。在非并发编译模式下，不需要考虑这个锁
   lock_.lock();
@@ -597,18 +816,18 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   while (!free_pages_.empty()) {
     current_page_num = *free_pages_.begin();
 
-    ret = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
+    ret = record_page_handler.init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
     if (OB_FAIL(ret)) {
       lock_.unlock();
       LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
       return ret;
     }
 
-    if (!record_page_handler->is_full()) {
+    if (!record_page_handler.is_full()) {
       page_found = true;
       break;
     }
-    record_page_handler->cleanup();
+    record_page_handler.cleanup();
     free_pages_.erase(free_pages_.begin());
   }
   lock_.unlock();  // 如果找到了一个有效的页面，那么此时已经拿到了页面的写锁
@@ -623,7 +842,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
 
     current_page_num = frame->page_num();
 
-    ret = record_page_handler->init_empty_page(
+    ret = record_page_handler.init_empty_page(
         *disk_buffer_pool_, *log_handler_, current_page_num, record_size, table_meta_, lob_handler_);
     if (OB_FAIL(ret)) {
       frame->unpin();
@@ -643,6 +862,17 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
     free_pages_.insert(current_page_num);
     lock_.unlock();
   }
+  return RC::SUCCESS;
+}
+
+RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+{
+  unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
+
+  RC ret = get_free_page(*record_page_handler, record_size);
+  if (OB_FAIL(ret)) {
+    return ret;
+  }
 
   // 找到空闲位置
   return record_page_handler->insert_record(data, rid);
@@ -662,10 +892,34 @@ RC RecordFileHandler::update_record(Record *rec)
   return record_page_handler.update_record(rec);
 }
 
-RC RecordFileHandler::insert_chunk(const Chunk &chunk, int record_size)
+RC RecordFileHandler::insert_chunk(const Chunk &chunk, int record_size, vector<RID> *rids)
 {
-  // your code here
-  return RC::UNIMPLEMENTED;
+  if (storage_format_ != StorageFormat::PAX_FORMAT) {
+    LOG_WARN("insert chunk is only supported by pax storage format");
+    return RC::UNSUPPORTED;
+  }
+
+  unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
+
+  RC        rc         = RC::SUCCESS;
+  int       start_row  = 0;
+  const int total_rows = chunk.rows();
+  while (start_row < total_rows) {
+    rc = get_free_page(*record_page_handler, record_size);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    int insert_rows = 0;
+    rc              = record_page_handler->insert_chunk(chunk, start_row, insert_rows, rids);
+    record_page_handler->cleanup();
+    if (OB_FAIL(rc) && rc != RC::RECORD_NOMEM) {
+      LOG_WARN("failed to insert chunk into page. start row=%d, rc=%s", start_row, strrc(rc));
+      return rc;
+    }
+    start_row += insert_rows;
+  }
+  return RC::SUCCESS;
 }
 
 RC RecordFileHandler::recover_insert_record(const char *data, int record_size, const RID &rid)
@@ -733,6 +987,36 @@ RC RecordFileHandler::get_record(const RID &rid, Record &record)
   return rc;
 }
 
+RC RecordFileHandler::get_records(const RID *rids, int count, Record *records)
+{
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
+
+  RC      rc           = RC::SUCCESS;
+  PageNum current_page = BP_INVALID_PAGE_NUM;
+  for (int i = 0; i < count; i++) {
+    const RID &rid = rids[i];
+    if (rid.page_num != current_page) {
+      rc = page_handler->init(*disk_buffer_pool_, *log_handler_, rid.page_num, ReadWriteMode::READ_ONLY);
+      if (OB_FAIL(rc)) {
+        LOG_ERROR("Failed to init record page handler.page number=%d", rid.page_num);
+        return rc;
+      }
+      current_page = rid.page_num;
+    }
+
+    Record inplace_record;
+    rc = page_handler->get_record(rid, inplace_record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record from record page handle. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    records[i].copy_data(inplace_record.data(), inplace_record.len());
+    records[i].set_rid(rid);
+  }
+  return rc;
+}
+
 RC RecordFileHandler::visit_record(const RID &rid, function<bool(Record &)> updater)
 {
   unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
@@ -781,7 +1065,7 @@ RC ChunkFileScanner::close_scan()
 }
 
 RC ChunkFileScanner::open_scan_chunk(
-    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode)
+    Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode, PageMorselSource *morsels)
 {
   close_scan();
 
@@ -789,8 +1073,10 @@ RC ChunkFileScanner::open_scan_chunk(
   disk_buffer_pool_ = &buffer_pool;
   log_handler_      = &log_handler;
   rw_mode_          = mode;
+  morsels_          = morsels;
 
-  RC rc = bp_iterator_.init(buffer_pool, 1);
+  // 并行扫描时从一个空的范围开始，第一次调用 next_chunk 时领取页面范围
+  RC rc = morsels_ == nullptr ? bp_iterator_.init(buffer_pool, 1) : bp_iterator_.init(buffer_pool, 1, 1);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -808,7 +1094,14 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
 {
   RC rc = RC::SUCCESS;
 
-  while (bp_iterator_.has_next()) {
+  while (true) {
+    if (!bp_iterator_.has_next()) {
+      // 当前的页面范围遍历完后，并行扫描时继续领取下一个范围
+      if (next_morsel()) {
+        continue;
+      }
+      break;
+    }
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
     rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_, table_->lob_handler());
@@ -818,6 +1111,9 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
     }
     rc = record_page_handler_->get_chunk(chunk);
     if (rc == RC::SUCCESS) {
+      if (chunk.rows() == 0 && chunk.column_num() > 0) {
+        continue;
+      }
       return rc;
     } else if (rc == RC::RECORD_EOF) {
       break;
@@ -830,3 +1126,19 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
   record_page_handler_->cleanup();
   return RC::RECORD_EOF;
 }
+
+bool ChunkFileScanner::next_morsel()
+{
+  if (morsels_ == nullptr) {
+    return false;
+  }
+
+  PageNum begin = 0;
+  PageNum end   = 0;
+  morsels_->next(begin, end);
+  if (begin >= disk_buffer_pool_->page_count()) {
+    return false;
+  }
+  bp_iterator_.init(*disk_buffer_pool_, begin, end);
+  return true;
+}
@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 //
 #pragma once
 
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
 #include "common/lang/sstream.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -184,7 +186,10 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) { return RC::UNIMPLEMENTED; }
 
-  virtual RC insert_chunk(const Chunk &chunk, int start_row, int &insert_rows) { return RC::UNIMPLEMENTED; }
+  virtual RC insert_chunk(const Chunk &chunk, int start_row, int &insert_rows, vector<RID> *rids)
+  {
+    return RC::UNIMPLEMENTED;
+  }
 
   /**
    * @brief 数据库恢复时，在指定位置插入数据
@@ -330,11 +335,23 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) override;
 
-  // TODO: insert chunk only used in load_data
-  virtual RC insert_chunk(const Chunk &chunk, int start_row, int &insert_rows) override;
+  /**
+   * @brief 将 chunk 中从 start_row 开始的数据按列批量写入当前页面
+   *
+   * @param chunk       待插入的数据，列的顺序与表字段的顺序一致
+   * @param start_row   从 chunk 的哪一行开始插入
+   * @param insert_rows 返回实际插入的行数，页面写满时可能小于剩余行数
+   * @param rids        不为空时，追加返回插入记录的位置
+   * @details 整个页面只记录一条 PAGE_IMAGE 日志，而不是每行一条
+   */
+  virtual RC insert_chunk(const Chunk &chunk, int start_row, int &insert_rows, vector<RID> *rids) override;
+
+  virtual RC recover_insert_record(const char *data, const RID &rid) override;
 
   virtual RC delete_record(const RID *rid) override;
 
+  virtual RC update_record(const RID &rid, const char *data) override;
+
   /**
    * @brief 获取指定位置的记录数据
    *
@@ -348,10 +365,18 @@ public:
    * @brief 以 Chunk 格式获取整个页面中指定列的所有记录。
    *
    * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @details 如果页面中的记录是连续存放的（没有空洞），列数据直接引用页面内存，不做拷贝，
+   * 调用者需要保证在使用 chunk 期间页面仍然被 pin 住；否则按照 bitmap 将有效记录拷贝到 chunk 中。
    */
   virtual RC get_chunk(Chunk &chunk) override;
 
 private:
+  // split the row-format `data` into columns and write them to slot `slot_num`
+  void write_row(SlotNum slot_num, const char *data);
+
+  // assemble the columns of slot `slot_num` into row-format `data`
+  void read_row(SlotNum slot_num, char *data);
+
   // get the field data by `slot_num` and `column id`
   char *get_field_data(SlotNum slot_num, int col_id);
 
@@ -398,7 +423,14 @@ public:
   RC insert_record(const char *data, int record_size, RID *rid);
   RC update_record(Record *rec);
 
-  RC insert_chunk(const Chunk &chunk, int record_size);
+  /**
+   * @brief 批量插入 chunk 中的所有行，当前仅 PAX 格式支持
+   *
+   * @param chunk       待插入的数据，列的顺序与表字段的顺序一致
+   * @param record_size 记录大小
+   * @param rids        不为空时，按行的顺序返回每条记录的标识符
+   */
+  RC insert_chunk(const Chunk &chunk, int record_size, vector<RID> *rids = nullptr);
 
   /**
    * @brief 数据库恢复时，在指定文件指定位置插入数据
@@ -411,6 +443,13 @@ public:
 
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 批量获取记录
+   * @details 相邻的、位于同一个页面的记录只访问一次页面，所以调用方最好按照页面顺序排列 rids
+   * @param[out] records 长度至少为 count，与 rids 一一对应
+   */
+  RC get_records(const RID *rids, int count, Record *records);
+
   RC visit_record(const RID &rid, function<bool(Record &)> updater);
 
 private:
@@ -419,6 +458,14 @@ private:
    */
   RC init_free_pages();
 
+  /**
+   * @brief 找到一个没有填满的页面，找不到就分配一个新的页面
+   *
+   * @param record_page_handler 返回时已经拿到了该页面的写锁
+   * @param record_size         记录大小，初始化新页面时使用
+   */
+  RC get_free_page(RecordPageHandler &record_page_handler, int record_size);
+
 private:
   DiskBufferPool        *disk_buffer_pool_ = nullptr;
   LogHandler            *log_handler_      = nullptr;  ///< 记录日志的处理器
@@ -429,10 +476,47 @@ private:
   LobFileHandler        *lob_handler_ = nullptr;
 };
 
+/**
+ * @brief 把文件中的页面按照固定大小的范围分给多个并行扫描的 ChunkFileScanner
+ * @ingroup RecordManager
+ * @details 每个页面范围称为一个 morsel。扫描线程处理完一个 morsel 后再领取下一个，扫描快的线程会处理更多的 morsel，
+ * 不需要预先按照线程个数切分文件。领取时只修改一个原子变量，页面范围超过文件结尾时由 ChunkFileScanner 结束扫描。
+ * morsel 之间可以间隔一些页面，这样只会扫描文件中均匀分布的一部分页面，用于采样。
+ */
+class PageMorselSource
+{
+public:
+  static constexpr int DEFAULT_MORSEL_PAGES = 16;
+
+  /**
+   * @param morsel_pages 每个 morsel 的页面个数
+   * @param first_page 第一个数据页面，第 0 个页面是文件头
+   * @param stride 相邻两个 morsel 起始页面的距离，不大于 morsel_pages 时扫描所有的页面
+   */
+  explicit PageMorselSource(int morsel_pages = DEFAULT_MORSEL_PAGES, PageNum first_page = 1, int stride = 0)
+      : morsel_pages_(morsel_pages), stride_(max(stride, morsel_pages)), next_page_(first_page)
+  {}
+
+  /**
+   * @brief 领取一个页面范围 [begin, end)，可以在多个线程中同时调用
+   */
+  void next(PageNum &begin, PageNum &end)
+  {
+    begin = next_page_.fetch_add(stride_, std::memory_order_relaxed);
+    end   = begin + morsel_pages_;
+  }
+
+private:
+  const int       morsel_pages_;
+  const int       stride_;
+  atomic<PageNum> next_page_;
+};
+
 /**
  * @brief 遍历某个文件中所有记录，每次返回一个 Chunk
  * @ingroup RecordManager
- * @details 遍历所有的页面，每次以 Chunk 格式返回一个页面内的所有数据
+ * @details 遍历所有的页面，每次以 Chunk 格式返回一个页面内的所有数据。
+ * 指定 PageMorselSource 时只遍历从中领取的页面范围，多个 ChunkFileScanner 共享同一个 PageMorselSource 时可以并行扫描一个文件。
  */
 class ChunkFileScanner
 {
@@ -441,7 +525,8 @@ public:
   ~ChunkFileScanner();
 
   // TODO: not support filter and transaction
-  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode);
+  RC open_scan_chunk(Table *table, DiskBufferPool &buffer_pool, LogHandler &log_handler, ReadWriteMode mode,
+      PageMorselSource *morsels = nullptr);
 
   /**
    * @brief 关闭一个文件扫描，释放相应的资源
@@ -453,6 +538,12 @@ public:
    */
   RC next_chunk(Chunk &chunk);
 
+private:
+  /**
+   * @brief 领取下一个页面范围，范围超过文件结尾时返回 false
+   */
+  bool next_morsel();
+
 private:
   Table *table_ = nullptr;  ///< 当前遍历的是哪张表。
 
@@ -462,4 +553,5 @@ private:
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+  PageMorselSource  *morsels_             = nullptr;  ///< 并行扫描时领取页面范围
 };
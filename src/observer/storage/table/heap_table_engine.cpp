@@ -37,27 +37,63 @@ HeapTableEngine::~HeapTableEngine()
 
   LOG_INFO("Table has been closed: %s", table_meta_->name());
 }
-RC HeapTableEngine::insert_record(Record &record)
+RC HeapTableEngine::check_unique_of_indexes(const char *record)
 {
-  // Check uniqueness
   for (auto index : indexes_) {
-    if (index->index_meta().isUnique()) {
-      const FieldMeta &field_meta = index->field_meta();
-      const char *key = record.data() + field_meta.offset();
-      int key_len = field_meta.len();
-      
-      IndexScanner *scanner = index->create_scanner(key, key_len, true, key, key_len, true);
+    // 推迟构建的索引在构建时检查唯一性
+    if (index->index_meta().isUnique() && !is_bulk_index(index)) {
+      vector<Value> values;
+      for (const FieldMeta &field_meta : index->field_metas()) {
+        values.emplace_back(field_meta.type(), const_cast<char *>(record + field_meta.offset()), field_meta.len());
+      }
+
+      IndexScanner *scanner = index->create_scanner(values, true, values, true);
       if (scanner) {
-        RID rid;
-        RC rc = scanner->next_entry(&rid);
+        const bool unique = is_unique_in_index(index, *scanner);
         delete scanner;
-        if (rc == RC::SUCCESS) {
+        if (!unique) {
           LOG_WARN("failed to insert record, record is not unique");
           return RC::RECORD_NOT_UNIQUE;
         }
       }
     }
   }
+  return RC::SUCCESS;
+}
+
+bool HeapTableEngine::is_unique_in_index(Index *index, IndexScanner &scanner)
+{
+  const int key_length = index->key_length();
+  if (key_length == 0) {
+    RID rid;
+    return scanner.next_entry(&rid) != RC::SUCCESS;
+  }
+
+  // 更新改变了键值时，旧键值的索引项要等旧版本被回收后才删除。
+  // 这样的索引项与表中记录当前的键值不同，不算重复
+  RID          rid;
+  vector<char> key(key_length);
+  int          count = 0;
+  while (OB_SUCC(scanner.next_entries_with_keys(&rid, key.data(), 1, count)) && count > 0) {
+    Record record;
+    if (OB_FAIL(record_handler_->get_record(rid, record))) {
+      return false;
+    }
+    if (index->match_key(record.data(), key.data())) {
+      return false;
+    }
+    LOG_TRACE("skip index entry of an old version. index=%s, rid=%s", index->index_meta().name(), rid.to_string().c_str());
+  }
+  return true;
+}
+
+RC HeapTableEngine::insert_record(Record &record)
+{
+  // Check uniqueness
+  RC unique_rc = check_unique_of_indexes(record.data());
+  if (unique_rc != RC::SUCCESS) {
+    return unique_rc;
+  }
 
   RC rc = RC::SUCCESS;
   rc    = record_handler_->insert_record(record.data(), table_meta_->record_size(), &record.rid());
@@ -84,14 +120,57 @@ RC HeapTableEngine::insert_record(Record &record)
 
 RC HeapTableEngine::insert_chunk(const Chunk& chunk)
 {
-  RC rc = RC::SUCCESS;
-  rc    = record_handler_->insert_chunk(chunk, table_meta_->record_size());
+  if (chunk.column_num() != table_meta_->field_num()) {
+    LOG_WARN("chunk doesn't match the table's schema. table name=%s, chunk column num=%d, field num=%d",
+             table_meta_->name(), chunk.column_num(), table_meta_->field_num());
+    return RC::SCHEMA_FIELD_MISSING;
+  }
+
+  vector<RID> rids;
+  RC rc = record_handler_->insert_chunk(chunk, table_meta_->record_size(), indexes_.empty() ? nullptr : &rids);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert chunk failed. table name=%s, rc=%s", table_meta_->name(), strrc(rc));
     return rc;
   }
 
-  // TODO: insert chunk support update index
+  if (indexes_.empty()) {
+    return rc;
+  }
+
+  // 按行拼出记录，再插入到各个索引中，批量导入时推迟构建的索引只收集索引项。
+  // 出错时与逐行插入的语义一致：出错之前的行保留，之后的行删除
+  vector<char> record(table_meta_->record_size());
+  for (int row = 0; row < chunk.rows(); row++) {
+    for (int col = 0; col < chunk.column_num(); col++) {
+      const FieldMeta *field = table_meta_->field(col);
+      memcpy(record.data() + field->offset(), chunk.column(col).data() + row * field->len(), field->len());
+    }
+
+    rc = check_unique_of_indexes(record.data());
+    if (OB_SUCC(rc)) {
+      rc = insert_entry_of_indexes(record.data(), rids[row]);
+      if (OB_FAIL(rc)) {
+        RC rc2 = delete_entry_of_indexes(record.data(), rids[row], false /*error_on_not_exists*/);
+        if (OB_FAIL(rc2)) {
+          LOG_ERROR("Failed to rollback index data when insert index entries failed. table name=%s, rc=%s",
+                    table_meta_->name(), strrc(rc2));
+        }
+      }
+    }
+
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert index entries of chunk. table name=%s, row=%d, rc=%s",
+               table_meta_->name(), row, strrc(rc));
+      for (int i = row; i < chunk.rows(); i++) {
+        RC rc2 = record_handler_->delete_record(&rids[i]);
+        if (OB_FAIL(rc2)) {
+          LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%s",
+                    table_meta_->name(), strrc(rc2));
+        }
+      }
+      return rc;
+    }
+  }
   return rc;
 }
 
@@ -111,6 +190,17 @@ RC HeapTableEngine::get_record(const RID &rid, Record &record)
   return rc;
 }
 
+RC HeapTableEngine::get_records(const RID *rids, int count, Record *records)
+{
+  RC rc = record_handler_->get_records(rids, count, records);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to get records. count=%d, table=%s, rc=%s", count, table_meta_->name(), strrc(rc));
+    return rc;
+  }
+
+  return rc;
+}
+
 RC HeapTableEngine::delete_record(const Record &record)
 {
   RC rc = RC::SUCCESS;
@@ -145,7 +235,13 @@ RC HeapTableEngine::update_record(Record &record, const char *attr_name, Value *
       }
 
       // 判断是否为索引列
-      isIndex = find_index_by_field(field_name) == nullptr ? false : true;
+      for (const Index *index : indexes_) {
+        for (const FieldMeta &index_field : index->field_metas()) {
+          if (0 == strcmp(index_field.name(), field_name)) {
+            isIndex = true;
+          }
+        }
+      }
 
       // 拿到目标域
       targetFiled = (FieldMeta *)field_meta;
@@ -199,18 +295,48 @@ RC HeapTableEngine::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWr
   return rc;
 }
 
-RC HeapTableEngine::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode)
+RC HeapTableEngine::get_chunk_scanner(
+    ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels)
 {
-  RC rc = scanner.open_scan_chunk(table_, *data_buffer_pool_, db_->log_handler(), mode);
+  RC rc = scanner.open_scan_chunk(table_, *data_buffer_pool_, db_->log_handler(), mode, morsels);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("failed to open scanner. rc=%s", strrc(rc));
   }
   return rc;
 }
 
-RC HeapTableEngine::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique)
+RC HeapTableEngine::get_sample_scanner(RecordScanner *&scanner, Trx *trx, int sample_pages, double &sample_fraction)
+{
+  // 第 0 个页面是文件头
+  const PageNum data_pages = data_buffer_pool_->page_count() - 1;
+  if (sample_pages <= 0 || data_pages <= sample_pages) {
+    sample_fraction = 1.0;
+    return get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  }
+
+  // 每次连续读取几个页面，间隔相同的距离，采样的页面均匀分布在整个文件中
+  const int morsel_pages = min(SAMPLE_MORSEL_PAGES, sample_pages);
+  const int stride       = data_pages / (sample_pages / morsel_pages);
+  PageNum   read_pages   = 0;
+  for (PageNum begin = 1; begin <= data_pages; begin += stride) {
+    read_pages += min(morsel_pages, data_pages + 1 - begin);
+  }
+  sample_fraction = static_cast<double>(read_pages) / data_pages;
+
+  auto morsels = make_shared<PageMorselSource>(morsel_pages, 1, stride);
+  scanner = new HeapRecordScanner(table_, *data_buffer_pool_, trx, db_->log_handler(), ReadWriteMode::READ_ONLY,
+      nullptr, std::move(morsels));
+  RC rc = scanner->open_scan();
+  if (rc != RC::SUCCESS) {
+    LOG_ERROR("failed to open sample scanner. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC HeapTableEngine::create_index(
+    Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique)
 {
-  if (common::is_blank(index_name) || nullptr == field_meta) {
+  if (common::is_blank(index_name) || field_metas.empty()) {
     LOG_INFO("Invalid input arguments, table name is %s, index_name is blank or attribute_name is blank", table_meta_->name());
     return RC::INVALID_ARGUMENT;
   }
@@ -227,7 +353,10 @@ RC HeapTableEngine::create_index(Trx *trx, const FieldMeta *field_meta, const ch
     std::set<std::string> st;
     Record record;
     while (OB_SUCC(rc = scanner->next(record))) {
-      std::string temp(record.data() + field_meta->offset(), field_meta->len());
+      std::string temp;
+      for (const FieldMeta *field_meta : field_metas) {
+        temp.append(record.data() + field_meta->offset(), field_meta->len());
+      }
       if (st.count(temp)) {
         LOG_WARN("failed to insert record, record is not unique");
         scanner->close_scan();
@@ -242,10 +371,10 @@ RC HeapTableEngine::create_index(Trx *trx, const FieldMeta *field_meta, const ch
 
   IndexMeta new_index_meta;
 
-  RC rc = new_index_meta.init(index_name, *field_meta, isUnique);
+  RC rc = new_index_meta.init(index_name, field_metas, isUnique);
   if (rc != RC::SUCCESS) {
     LOG_INFO("Failed to init IndexMeta in table:%s, index_name:%s, field_name:%s", 
-             table_meta_->name(), index_name, field_meta->name());
+             table_meta_->name(), index_name, field_metas[0]->name());
     return rc;
   }
 
@@ -253,40 +382,32 @@ RC HeapTableEngine::create_index(Trx *trx, const FieldMeta *field_meta, const ch
   BplusTreeIndex *index      = new BplusTreeIndex();
   string          index_file = table_index_file(db_->path().c_str(), table_meta_->name(), index_name);
 
-  rc = index->create(table_, index_file.c_str(), new_index_meta, *field_meta);
+  rc = index->create(table_, index_file.c_str(), new_index_meta, field_metas);
   if (rc != RC::SUCCESS) {
     delete index;
     LOG_ERROR("Failed to create bplus tree index. file name=%s, rc=%d:%s", index_file.c_str(), rc, strrc(rc));
     return rc;
   }
 
-  // 遍历当前的所有数据，插入这个索引
+  // 遍历当前的所有数据，批量构建这个索引
   RecordScanner *scanner = nullptr;
   rc = get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to create scanner while creating index. table=%s, index=%s, rc=%s", 
              table_meta_->name(), index_name, strrc(rc));
+    delete index;
     return rc;
   }
 
-  Record record;
-  while (OB_SUCC(rc = scanner->next(record))) {
-    rc = index->insert_entry(record.data(), &record.rid());
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to insert record into index while creating index. table=%s, index=%s, rc=%s",
-               table_meta_->name(), index_name, strrc(rc));
-      return rc;
-    }
-  }
-  if (RC::RECORD_EOF == rc) {
-    rc = RC::SUCCESS;
-  } else {
-    LOG_WARN("failed to insert record into index while creating index. table=%s, index=%s, rc=%s",
+  rc = index->bulk_load(*scanner);
+  scanner->close_scan();
+  delete scanner;
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to insert records into index while creating index. table=%s, index=%s, rc=%s",
              table_meta_->name(), index_name, strrc(rc));
+    delete index;
     return rc;
   }
-  scanner->close_scan();
-  delete scanner;
   LOG_INFO("inserted all records into new index. table=%s, index=%s", table_meta_->name(), index_name);
 
   indexes_.push_back(index);
@@ -336,10 +457,22 @@ RC HeapTableEngine::insert_entry_of_indexes(const char *record, const RID &rid)
 {
   RC rc = RC::SUCCESS;
   for (Index *index : indexes_) {
+    if (is_bulk_index(index)) {
+      continue;
+    }
     rc = index->insert_entry(record, &rid);
     if (rc != RC::SUCCESS) {
-      break;
+      return rc;
+    }
+  }
+
+  // 其它索引都插入成功之后才收集，失败时回滚的记录不会出现在推迟构建的索引中
+  if (!bulk_indexes_.empty()) {
+    lock_guard<mutex> guard(bulk_mutex_);
+    for (BulkIndex &bulk_index : bulk_indexes_) {
+      bulk_index.index->append_bulk_entry(record, rid, bulk_index.entries);
     }
+    bulk_rids_.push_back(rid);
   }
   return rc;
 }
@@ -348,6 +481,9 @@ RC HeapTableEngine::delete_entry_of_indexes(const char *record, const RID &rid,
 {
   RC rc = RC::SUCCESS;
   for (Index *index : indexes_) {
+    if (is_bulk_index(index)) {
+      continue;
+    }
     rc = index->delete_entry(record, &rid);
     if (rc != RC::SUCCESS) {
       if (rc != RC::RECORD_INVALID_KEY || !error_on_not_exists) {
@@ -358,6 +494,82 @@ RC HeapTableEngine::delete_entry_of_indexes(const char *record, const RID &rid,
   return rc;
 }
 
+bool HeapTableEngine::is_bulk_index(const Index *index) const
+{
+  for (const BulkIndex &bulk_index : bulk_indexes_) {
+    if (bulk_index.index == index) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RC HeapTableEngine::begin_bulk_insert()
+{
+  lock_guard<mutex> guard(bulk_mutex_);
+  if (!bulk_indexes_.empty()) {
+    LOG_WARN("bulk insert is in progress. table=%s", table_meta_->name());
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  for (Index *index : indexes_) {
+    if (index->can_bulk_load()) {
+      bulk_indexes_.push_back(BulkIndex{index, {}});
+    }
+  }
+  LOG_INFO("begin bulk insert. table=%s, deferred index num=%d", table_meta_->name(), static_cast<int>(bulk_indexes_.size()));
+  return RC::SUCCESS;
+}
+
+RC HeapTableEngine::end_bulk_insert()
+{
+  RC rc = RC::SUCCESS;
+  for (BulkIndex &bulk_index : bulk_indexes_) {
+    rc = bulk_index.index->bulk_load(bulk_index.entries);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to bulk load index. table=%s, index=%s, rc=%s",
+               table_meta_->name(), bulk_index.index->index_meta().name(), strrc(rc));
+      break;
+    }
+    vector<char>().swap(bulk_index.entries);
+  }
+
+  if (OB_FAIL(rc)) {
+    rollback_bulk_insert();
+  } else {
+    LOG_INFO("end bulk insert. table=%s, row num=%ld", table_meta_->name(), bulk_rids_.size());
+  }
+
+  lock_guard<mutex> guard(bulk_mutex_);
+  bulk_indexes_.clear();
+  vector<RID>().swap(bulk_rids_);
+  return rc;
+}
+
+void HeapTableEngine::rollback_bulk_insert()
+{
+  LOG_WARN("rollback bulk insert. table=%s, row num=%ld", table_meta_->name(), bulk_rids_.size());
+  Record record;
+  for (const RID &rid : bulk_rids_) {
+    RC rc = record_handler_->get_record(rid, record);
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("failed to get record while rolling back bulk insert. table=%s, rid=%s, rc=%s",
+                table_meta_->name(), rid.to_string().c_str(), strrc(rc));
+      continue;
+    }
+
+    // 已经构建好的索引中也有这条记录，构建失败的索引是空的，删除不存在的索引项的错误可以忽略
+    for (Index *index : indexes_) {
+      index->delete_entry(record.data(), &rid);
+    }
+    rc = record_handler_->delete_record(&rid);
+    if (OB_FAIL(rc)) {
+      LOG_PANIC("failed to delete record while rolling back bulk insert. table=%s, rid=%s, rc=%s",
+                table_meta_->name(), rid.to_string().c_str(), strrc(rc));
+    }
+  }
+}
+
 RC HeapTableEngine::sync()
 {
   RC rc = RC::SUCCESS;
@@ -427,19 +639,24 @@ RC HeapTableEngine::open()
   const int index_num = table_meta_->index_num();
   for (int i = 0; i < index_num; i++) {
     const IndexMeta *index_meta = table_meta_->index(i);
-    const FieldMeta *field_meta = table_meta_->field(index_meta->field());
-    if (field_meta == nullptr) {
-      LOG_ERROR("Found invalid index meta info which has a non-exists field. table=%s, index=%s, field=%s",
-                table_meta_->name(), index_meta->name(), index_meta->field());
-      // skip cleanup
-      //  do all cleanup action in destructive Table function
-      return RC::INTERNAL;
+
+    vector<const FieldMeta *> field_metas;
+    for (const string &field_name : index_meta->fields()) {
+      const FieldMeta *field_meta = table_meta_->field(field_name.c_str());
+      if (field_meta == nullptr) {
+        LOG_ERROR("Found invalid index meta info which has a non-exists field. table=%s, index=%s, field=%s",
+                  table_meta_->name(), index_meta->name(), field_name.c_str());
+        // skip cleanup
+        //  do all cleanup action in destructive Table function
+        return RC::INTERNAL;
+      }
+      field_metas.push_back(field_meta);
     }
 
     BplusTreeIndex *index      = new BplusTreeIndex();
     string          index_file = table_index_file(db_->path().c_str(), table_meta_->name(), index_meta->name());
 
-    rc = index->open(table_, index_file.c_str(), *index_meta, *field_meta);
+    rc = index->open(table_, index_file.c_str(), *index_meta, field_metas);
     if (rc != RC::SUCCESS) {
       delete index;
       LOG_ERROR("Failed to open index. table=%s, index=%s, file=%s, rc=%s",
@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/mutex.h"
 #include "storage/table/text_manager.h"
 #include "storage/table/table_engine.h"
 #include "storage/index/index.h"
@@ -38,10 +39,20 @@ public:
     return RC::UNSUPPORTED;
   }
   RC get_record(const RID &rid, Record &record) override;
+  RC get_records(const RID *rids, int count, Record *records) override;
 
-  RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique) override;
+  /**
+   * @brief 开始批量导入，空的索引推迟到导入结束时自底向上构建
+   * @details 导入期间插入的记录只收集这些索引的索引项，不插入到索引中，其它的索引仍然逐条插入
+   */
+  RC begin_bulk_insert() override;
+  RC end_bulk_insert() override;
+
+  RC create_index(
+      Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique) override;
   RC get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode) override;
-  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode) override;
+  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels) override;
+  RC get_sample_scanner(RecordScanner *&scanner, Trx *trx, int sample_pages, double &sample_fraction) override;
   RC visit_record(const RID &rid, function<bool(Record &)> visitor) override;
   RC sync() override;
 
@@ -52,13 +63,34 @@ public:
   RC init() override;
 
 private:
+  /// 采样时每次连续读取的页面个数
+  static constexpr int SAMPLE_MORSEL_PAGES = 4;
+
+  RC check_unique_of_indexes(const char *record);
+  /// scanner 找到的索引项中是否没有与表中记录当前的键值相同的
+  bool is_unique_in_index(Index *index, IndexScanner &scanner);
   RC insert_entry_of_indexes(const char *record, const RID &rid);
   RC delete_entry_of_indexes(const char *record, const RID &rid, bool error_on_not_exists);
 
+  /// 是否是批量导入结束时才构建的索引
+  bool is_bulk_index(const Index *index) const;
+  /// 构建推迟的索引失败时，删除导入期间插入的记录
+  void rollback_bulk_insert();
+
 private:
   DiskBufferPool    *data_buffer_pool_ = nullptr;  /// 数据文件关联的buffer pool
   RecordFileHandler *record_handler_   = nullptr;  /// 记录操作
   vector<Index *>    indexes_;
   Db                *db_;
   Table             *table_;
+
+  /// 批量导入时推迟构建的索引和收集的索引项
+  struct BulkIndex
+  {
+    Index       *index = nullptr;
+    vector<char> entries;
+  };
+  vector<BulkIndex> bulk_indexes_;
+  vector<RID>       bulk_rids_;  ///< 批量导入期间插入的记录
+  mutex             bulk_mutex_;
 };
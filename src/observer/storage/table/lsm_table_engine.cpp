@@ -9,6 +9,7 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "storage/table/lsm_table_engine.h"
+#include "common/lang/algorithm.h"
 #include "storage/record/heap_record_scanner.h"
 #include "common/log/log.h"
 #include "storage/index/bplus_tree_index.h"
@@ -18,17 +19,161 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/codec.h"
 #include "storage/trx/lsm_mvcc_trx.h"
 
-RC LsmTableEngine::insert_record(Record &record)
+RC LsmTableEngine::insert_record(Record &record) { return insert_record_with_trx(record, nullptr); }
+
+RC LsmTableEngine::delete_record(const Record &record) { return delete_record_with_trx(record, nullptr); }
+
+RC LsmTableEngine::update_record(Record &record, const char *attr_name, Value *value)
+{
+  Record new_record;
+  RC     rc = make_updated_record(*table_meta_, record, attr_name, value, new_record);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  rc = update_record_with_trx(record, new_record, nullptr);
+  if (OB_SUCC(rc)) {
+    rc = record.copy_data(new_record.data(), new_record.len());
+  }
+  return rc;
+}
+
+RC LsmTableEngine::insert_record_with_trx(Record &record, Trx *trx)
 {
-  RC rc = RC::SUCCESS;
   // TODO: set auto increment id, and keep durability.
   // TODO: support set primary key as a part of lsm_key.
+  record.set_rid(row_id_to_rid(inc_id_.fetch_add(1)));
+
+  string key;
+  RC     rc = encode_key(record.rid(), key);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  record.set_key(key);
+
+  ObLsmTransaction *lsm_transaction = lsm_trx(trx);
+  string_view       value(record.data(), record.len());
+  return lsm_transaction != nullptr ? lsm_transaction->put(key, value) : lsm_->put(key, value);
+}
+
+RC LsmTableEngine::delete_record_with_trx(const Record &record, Trx *trx)
+{
+  string key;
+  RC     rc = encode_key(record.rid(), key);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  ObLsmTransaction *lsm_transaction = lsm_trx(trx);
+  return lsm_transaction != nullptr ? lsm_transaction->remove(key) : lsm_->remove(key);
+}
+
+RC LsmTableEngine::update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx)
+{
+  string key;
+  RC     rc = encode_key(old_record.rid(), key);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  ObLsmTransaction *lsm_transaction = lsm_trx(trx);
+  string_view       value(new_record.data(), new_record.len());
+  return lsm_transaction != nullptr ? lsm_transaction->put(key, value) : lsm_->put(key, value);
+}
+
+RC LsmTableEngine::get_record(const RID &rid, Record &record)
+{
+  string key;
+  RC     rc = encode_key(rid, key);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  string value;
+  rc = lsm_->get(key, &value);
+  if (rc == RC::NOT_EXIST) {
+    return RC::RECORD_NOT_EXIST;
+  } else if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get record. rid=%s, table=%s, rc=%s", rid.to_string().c_str(), table_meta_->name(), strrc(rc));
+    return rc;
+  }
+
+  record.set_rid(rid);
+  record.set_key(key);
+  return record.copy_data(value.data(), static_cast<int>(value.size()));
+}
+
+RC LsmTableEngine::get_records(const RID *rids, int count, Record *records)
+{
+  RC rc = RC::SUCCESS;
+  for (int i = 0; i < count && OB_SUCC(rc); i++) {
+    rc = get_record(rids[i], records[i]);
+  }
+  return rc;
+}
+
+RC LsmTableEngine::make_updated_record(
+    const TableMeta &table_meta, const Record &old_record, const char *attr_name, const Value *value, Record &new_record)
+{
+  const FieldMeta *field_meta = table_meta.field(attr_name);
+  if (nullptr == field_meta) {
+    return RC::SCHEMA_FIELD_NOT_EXIST;
+  }
+  if (field_meta->type() != value->attr_type()) {
+    return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+  }
+  // TEXT 存放在 LOB 中，LSM 表还不支持
+  if (field_meta->type() == AttrType::TEXTS) {
+    return RC::UNSUPPORTED;
+  }
+
+  RC rc = new_record.copy_data(old_record.data(), old_record.len());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  new_record.set_rid(old_record.rid());
+  new_record.set_key(old_record.key());
+
+  // 字符串可能比字段短，剩余的部分补 0
+  vector<char> field_data(field_meta->len(), 0);
+  memcpy(field_data.data(), value->data(), min(field_meta->len(), value->length()));
+  return new_record.set_field(field_meta->offset(), field_meta->len(), field_data.data());
+}
+
+RID LsmTableEngine::row_id_to_rid(uint64_t row_id)
+{
+  return RID(static_cast<PageNum>(row_id >> 32), static_cast<SlotNum>(row_id & 0xFFFFFFFF));
+}
+
+uint64_t LsmTableEngine::rid_to_row_id(const RID &rid)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(rid.page_num)) << 32) |
+         static_cast<uint32_t>(rid.slot_num);
+}
+
+RC LsmTableEngine::encode_key(const RID &rid, string &key) const
+{
   bytes lsm_key;
-  Codec::encode(table_->table_id(), inc_id_.fetch_add(1), lsm_key);
-  rc = lsm_->put(string_view((char *)lsm_key.data(), lsm_key.size()), string_view(record.data(), record.len()));
+  RC    rc = Codec::encode(table_->table_id(), rid_to_row_id(rid), lsm_key);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to encode lsm key. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+  key.assign(reinterpret_cast<const char *>(lsm_key.data()), lsm_key.size());
   return rc;
 }
 
+ObLsmTransaction *LsmTableEngine::lsm_trx(Trx *trx) const
+{
+  if (trx == nullptr || trx->type() != TrxKit::Type::LSM) {
+    return nullptr;
+  }
+
+  auto lsm_mvcc_trx = static_cast<LsmMvccTrx *>(trx);
+  lsm_mvcc_trx->start_if_need();
+  return lsm_mvcc_trx->get_trx();
+}
+
 RC LsmTableEngine::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode)
 {
   scanner = new LsmRecordScanner(table_, db_->lsm(), trx);
@@ -30,19 +30,23 @@ public:
 
   RC insert_record(Record &record) override;
   RC insert_chunk(const Chunk &chunk) override { return RC::UNIMPLEMENTED; }
-  RC delete_record(const Record &record) override { return RC::UNIMPLEMENTED; }
-  RC update_record(Record &record, const char *attr_name, Value *value) override { return RC::UNIMPLEMENTED; };
-  RC insert_record_with_trx(Record &record, Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC delete_record_with_trx(const Record &record, Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx) override
+  RC delete_record(const Record &record) override;
+  RC update_record(Record &record, const char *attr_name, Value *value) override;
+  RC insert_record_with_trx(Record &record, Trx *trx) override;
+  RC delete_record_with_trx(const Record &record, Trx *trx) override;
+  RC update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx) override;
+  RC get_record(const RID &rid, Record &record) override;
+  RC get_records(const RID *rids, int count, Record *records) override;
+
+  RC create_index(Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique) override
   {
     return RC::UNIMPLEMENTED;
   }
-  RC get_record(const RID &rid, Record &record) override { return RC::UNIMPLEMENTED; }
-
-  RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique) override { return RC::UNIMPLEMENTED; }
   RC get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode) override;
-  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode) override { return RC::UNIMPLEMENTED; }
+  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels) override
+  {
+    return RC::UNIMPLEMENTED;
+  }
   RC visit_record(const RID &rid, function<bool(Record &)> visitor) override { return RC::UNIMPLEMENTED; }
   // TODO:
   RC     sync() override { return RC::SUCCESS; }
@@ -51,6 +55,29 @@ public:
   RC     open() override;
   RC     init() override { return RC::UNIMPLEMENTED; }
 
+  /**
+   * @brief 把记录中的一个字段修改为 value，结果放在 new_record 中
+   */
+  static RC make_updated_record(
+      const TableMeta &table_meta, const Record &old_record, const char *attr_name, const Value *value, Record &new_record);
+
+  /**
+   * @brief LSM 表没有页面，记录的 RID 由自增的行号编码而来，高 32 位作为 page_num，低 32 位作为 slot_num
+   */
+  static RID      row_id_to_rid(uint64_t row_id);
+  static uint64_t rid_to_row_id(const RID &rid);
+
+private:
+  /**
+   * @brief 记录在 LSM 中的 key：t{TableID}r{RowID}
+   */
+  RC encode_key(const RID &rid, string &key) const;
+
+  /**
+   * @brief 记录要写入的 LSM 事务，不是 LSM 事务时返回空，直接写入 LSM
+   */
+  ObLsmTransaction *lsm_trx(Trx *trx) const;
+
 private:
   Db              *db_;
   Table           *table_;
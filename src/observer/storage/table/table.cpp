@@ -205,6 +205,22 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir)
   }
   fs.close();
 
+  // 事务字段的长度改变过(事务ID从32位改成了64位)，旧版本创建的表记录格式不兼容，不能直接打开
+  const vector<FieldMeta> *trx_fields = db->trx_kit().trx_fields();
+  if (trx_fields != nullptr) {
+    for (const FieldMeta &field_meta : table_meta_.trx_fields()) {
+      auto iter = find_if(trx_fields->begin(), trx_fields->end(), [&field_meta](const FieldMeta &trx_field) {
+        return 0 == strcmp(trx_field.name(), field_meta.name());
+      });
+      if (iter != trx_fields->end() && iter->len() != field_meta.len()) {
+        LOG_ERROR("Failed to open table. transaction field length mismatch, the table may be created by an older version. "
+                  "table=%s, field=%s, len=%d, expected len=%d",
+                  table_meta_.name(), field_meta.name(), field_meta.len(), iter->len());
+        return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+      }
+    }
+  }
+
   db_       = db;
   base_dir_ = base_dir;
 
@@ -248,6 +264,10 @@ RC Table::insert_chunk(const Chunk& chunk)
   return engine_->insert_chunk(chunk);
 }
 
+RC Table::begin_bulk_insert() { return engine_->begin_bulk_insert(); }
+
+RC Table::end_bulk_insert() { return engine_->end_bulk_insert(); }
+
 RC Table::visit_record(const RID &rid, function<bool(Record &)> visitor)
 {
   return engine_->visit_record(rid, visitor);
@@ -272,6 +292,11 @@ RC Table::get_record(const RID &rid, Record &record)
   return engine_->get_record(rid, record);
 }
 
+RC Table::get_records(const RID *rids, int count, Record *records)
+{
+  return engine_->get_records(rids, count, records);
+}
+
 const char *Table::name() const { return table_meta_.name(); }
 
 const TableMeta &Table::table_meta() const { return table_meta_; }
@@ -355,14 +380,52 @@ RC Table::get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mo
   return engine_->get_record_scanner(scanner, trx, mode);
 }
 
-RC Table::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode)
+RC Table::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels)
 {
-  return engine_->get_chunk_scanner(scanner, trx, mode);
+  return engine_->get_chunk_scanner(scanner, trx, mode, morsels);
+}
+
+RC Table::get_sample_scanner(RecordScanner *&scanner, Trx *trx, int sample_pages, double &sample_fraction)
+{
+  return engine_->get_sample_scanner(scanner, trx, sample_pages, sample_fraction);
+}
+
+RC Table::update_statistics(shared_ptr<const TableStatistics> statistics)
+{
+  // 只替换统计信息，不能像创建索引那样整体替换元数据，其它会话可能正在使用 FieldMeta 等指针
+  TableMeta new_table_meta(table_meta_);
+  new_table_meta.set_statistics(statistics);
+
+  // 与创建索引相同，先写到临时文件中，再覆盖原来的元数据文件
+  string  tmp_file = table_meta_file(base_dir_.c_str(), name()) + ".tmp";
+  fstream fs;
+  fs.open(tmp_file, ios_base::out | ios_base::binary | ios_base::trunc);
+  if (!fs.is_open()) {
+    LOG_ERROR("Failed to open file for write. file name=%s, errmsg=%s", tmp_file.c_str(), strerror(errno));
+    return RC::IOERR_OPEN;
+  }
+  if (new_table_meta.serialize(fs) < 0) {
+    LOG_ERROR("Failed to dump new table meta to file: %s. sys err=%d:%s", tmp_file.c_str(), errno, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  fs.close();
+
+  string meta_file = table_meta_file(base_dir_.c_str(), name());
+  if (rename(tmp_file.c_str(), meta_file.c_str()) != 0) {
+    LOG_ERROR("Failed to rename tmp meta file (%s) to normal meta file (%s) while updating statistics of table (%s). "
+              "system error=%d:%s",
+              tmp_file.c_str(), meta_file.c_str(), name(), errno, strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+
+  table_meta_.set_statistics(std::move(statistics));
+  LOG_INFO("Successfully updated statistics of table %s", name());
+  return RC::SUCCESS;
 }
 
-RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique)
+RC Table::create_index(Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique)
 {
-  return engine_->create_index(trx, field_meta, index_name, isUnique);
+  return engine_->create_index(trx, field_metas, index_name, isUnique);
 }
 
 RC Table::delete_record(const Record &record)
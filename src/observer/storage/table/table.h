@@ -30,6 +30,7 @@ class DiskBufferPool;
 class RecordFileHandler;
 class RecordScanner;
 class ChunkFileScanner;
+class PageMorselSource;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
@@ -94,6 +95,11 @@ public:
   RC insert_record(Record &record);
 
   RC insert_chunk(const Chunk &chunk);
+
+  /// 批量导入数据的开始和结束，参考 TableEngine::begin_bulk_insert
+  RC begin_bulk_insert();
+  RC end_bulk_insert();
+
   RC delete_record(const Record &record);
   RC update_record(Record &record, const char *attr_name, Value *value);
 
@@ -102,12 +108,28 @@ public:
   RC update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx);
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 批量获取记录
+   * @details rids 最好按照页面顺序排列，同一个页面中相邻的记录只访问一次页面
+   * @param[out] records 长度至少为 count，与 rids 一一对应
+   */
+  RC get_records(const RID *rids, int count, Record *records);
+
   // TODO refactor
-  RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique);
+  RC create_index(Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique);
 
   RC get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode);
 
-  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode);
+  /**
+   * @brief 获取按 chunk 遍历的扫描器
+   * @param morsels 不为空时只扫描从中领取的页面范围，用于多个线程并行扫描
+   */
+  RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels = nullptr);
+
+  /**
+   * @brief 获取只读取一部分页面的只读扫描器，参考 TableEngine::get_sample_scanner
+   */
+  RC get_sample_scanner(RecordScanner *&scanner, Trx *trx, int sample_pages, double &sample_fraction);
 
   /**
    * @brief 可以在页面锁保护的情况下访问记录
@@ -130,7 +152,15 @@ public:
 
   RC sync();
 
-private:
+  /**
+   * @brief 更新表的统计信息，统计信息与表的元数据保存在一起
+   */
+  RC update_statistics(shared_ptr<const TableStatistics> statistics);
+
+  /**
+   * @brief 把某个字段的值写到行数据中
+   * @details TEXT 字段会保存一份新的长文本，不会修改旧的文本，旧版本的记录仍然可以读到原来的值
+   */
   RC set_value_to_record(char *record_data, const Value &value, const FieldMeta *field);
 
 private:
@@ -21,6 +21,7 @@ class DiskBufferPool;
 class RecordFileHandler;
 class RecordScanner;
 class ChunkFileScanner;
+class PageMorselSource;
 class ConditionFilter;
 class DefaultConditionFilter;
 class Index;
@@ -47,9 +48,42 @@ public:
   virtual RC update_record_with_trx(const Record &old_record, const Record &new_record, Trx *trx) = 0;
   virtual RC get_record(const RID &rid, Record &record)                                           = 0;
 
-  virtual RC     create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool isUnique) = 0;
+  /**
+   * @brief 批量获取记录，同一个页面中相邻的记录只访问一次页面
+   * @param[out] records 长度至少为 count，与 rids 一一对应
+   */
+  virtual RC get_records(const RID *rids, int count, Record *records) = 0;
+
+  /**
+   * @brief 开始批量导入，比如 LOAD DATA
+   * @details 导入期间可以推迟空索引的构建，在 end_bulk_insert 中一次构建。默认不做处理
+   */
+  virtual RC begin_bulk_insert() { return RC::SUCCESS; }
+
+  /**
+   * @brief 结束批量导入，构建推迟的索引
+   * @details 构建失败时（比如唯一索引有重复的值），导入期间插入的所有记录都会删除
+   */
+  virtual RC end_bulk_insert() { return RC::SUCCESS; }
+
+  virtual RC     create_index(
+      Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool isUnique) = 0;
   virtual RC     get_record_scanner(RecordScanner *&scanner, Trx *trx, ReadWriteMode mode)   = 0;
-  virtual RC     get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode)  = 0;
+  virtual RC     get_chunk_scanner(
+      ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode, PageMorselSource *morsels)  = 0;
+
+  /**
+   * @brief 获取只读取一部分数据的只读扫描器，用于收集统计信息
+   * @details 默认读取所有的数据
+   * @param sample_pages 最多采样的页面个数
+   * @param[out] sample_fraction 读取的数据占全部数据的比例
+   */
+  virtual RC get_sample_scanner(RecordScanner *&scanner, Trx *trx, int sample_pages, double &sample_fraction)
+  {
+    sample_fraction = 1.0;
+    return get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  }
+
   virtual RC     visit_record(const RID &rid, function<bool(Record &)> visitor)              = 0;
   virtual RC     sync()                                                                      = 0;
   virtual Index *find_index(const char *index_name) const                                    = 0;
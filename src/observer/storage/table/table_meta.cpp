@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 #include "common/lang/algorithm.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
+#include "sql/optimizer/statistics/table_statistics.h"
 #include "storage/table/table_meta.h"
 #include "storage/trx/trx.h"
 #include "json/json.h"
@@ -27,14 +28,18 @@ static const Json::StaticString FIELD_STORAGE_ENGINE("storage_engine");
 static const Json::StaticString FIELD_FIELDS("fields");
 static const Json::StaticString FIELD_INDEXES("indexes");
 static const Json::StaticString FIELD_PRIMARY_KEYS("primary_keys");
+static const Json::StaticString FIELD_STATISTICS("statistics");
 
 TableMeta::TableMeta(const TableMeta &other)
     : table_id_(other.table_id_),
       name_(other.name_),
+      trx_fields_(other.trx_fields_),
       fields_(other.fields_),
       indexes_(other.indexes_),
+      primary_keys_(other.primary_keys_),
       storage_format_(other.storage_format_),
       storage_engine_(other.storage_engine_),
+      statistics_(other.statistics()),
       record_size_(other.record_size_)
 {}
 
@@ -43,9 +48,25 @@ void TableMeta::swap(TableMeta &other) noexcept
   name_.swap(other.name_);
   fields_.swap(other.fields_);
   indexes_.swap(other.indexes_);
+  {
+    scoped_lock lock(statistics_lock_, other.statistics_lock_);
+    statistics_.swap(other.statistics_);
+  }
   std::swap(record_size_, other.record_size_);
 }
 
+shared_ptr<const TableStatistics> TableMeta::statistics() const
+{
+  lock_guard<mutex> lock(statistics_lock_);
+  return statistics_;
+}
+
+void TableMeta::set_statistics(shared_ptr<const TableStatistics> statistics)
+{
+  lock_guard<mutex> lock(statistics_lock_);
+  statistics_ = std::move(statistics);
+}
+
 RC TableMeta::init(int32_t table_id, const char *name, const vector<FieldMeta> *trx_fields,
                    span<const AttrInfoSqlNode> attributes, const vector<string> &primary_keys, StorageFormat storage_format,
                    StorageEngine storage_engine)
@@ -120,6 +141,18 @@ span<const FieldMeta> TableMeta::trx_fields() const
 }
 
 const FieldMeta *TableMeta::field(int index) const { return &fields_[index]; }
+int TableMeta::field_index(const FieldMeta *field) const
+{
+  if (field >= fields_.data() && field < fields_.data() + fields_.size()) {
+    return static_cast<int>(field - fields_.data());
+  }
+  for (size_t i = 0; i < fields_.size(); i++) {
+    if (0 == strcmp(fields_[i].name(), field->name())) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
 const FieldMeta *TableMeta::field(const char *name) const
 {
   if (nullptr == name) {
@@ -203,6 +236,12 @@ int TableMeta::serialize(ostream &ss) const
   }
   table_value[FIELD_PRIMARY_KEYS] = std::move(primary_keys_value);
 
+  if (shared_ptr<const TableStatistics> statistics = this->statistics(); statistics != nullptr) {
+    Json::Value statistics_value;
+    statistics->to_json(statistics_value);
+    table_value[FIELD_STATISTICS] = std::move(statistics_value);
+  }
+
   Json::StreamWriterBuilder builder;
   Json::StreamWriter       *writer = builder.newStreamWriter();
 
@@ -337,6 +376,17 @@ int TableMeta::deserialize(istream &is)
     primary_keys_.swap(primary_keys);
   }
 
+  // 统计信息只影响执行计划，不能解析时忽略，重新收集即可
+  const Json::Value &statistics_value = table_value[FIELD_STATISTICS];
+  if (!statistics_value.isNull()) {
+    auto statistics = make_shared<TableStatistics>();
+    if (OB_SUCC(TableStatistics::from_json(statistics_value, *statistics))) {
+      statistics_ = std::move(statistics);
+    } else {
+      LOG_WARN("Failed to deserialize statistics, ignore it. table name=%s", name_.c_str());
+    }
+  }
+
   return (int)(is.tellg() - old_pos);
 }
 
@@ -14,6 +14,8 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
 #include "common/lang/serializable.h"
 #include "common/sys/rc.h"
 #include "common/types.h"
@@ -21,6 +23,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/field/field_meta.h"
 #include "storage/index/index_meta.h"
 
+class TableStatistics;
+
 /**
  * @brief 表元数据
  *
@@ -48,6 +52,8 @@ public:
   const FieldMeta    *field(int index) const;
   const FieldMeta    *field(const char *name) const;
   const FieldMeta    *find_field_by_offset(int offset) const;
+  /// 字段在 fields_ 中的位置，也是 PAX 页面和 chunk 中列的位置。field_id 只是持久化的字段编号，不能当作位置
+  int                 field_index(const FieldMeta *field) const;
   auto                field_metas() const -> const vector<FieldMeta>                *{ return &fields_; }
   auto                trx_fields() const -> span<const FieldMeta>;
   const StorageFormat storage_format() const { return storage_format_; }
@@ -63,6 +69,13 @@ public:
 
   const vector<string> &primary_keys() const { return primary_keys_; }
 
+  /**
+   * @brief ANALYZE TABLE 收集的统计信息，没有收集过时为空
+   * @details 统计信息可能被其它会话的 ANALYZE TABLE 替换，这里返回的是副本，使用期间不会被释放
+   */
+  shared_ptr<const TableStatistics> statistics() const;
+  void                              set_statistics(shared_ptr<const TableStatistics> statistics);
+
   int record_size() const;
 
 public:
@@ -82,5 +95,8 @@ protected:
   StorageFormat     storage_format_;
   StorageEngine     storage_engine_;
 
+  mutable mutex                     statistics_lock_;  ///< 保护 statistics_，其它字段在创建索引等操作中整体替换
+  shared_ptr<const TableStatistics> statistics_;
+
   int record_size_ = 0;
 };
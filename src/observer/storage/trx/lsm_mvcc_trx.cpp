@@ -9,6 +9,8 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "storage/trx/lsm_mvcc_trx.h"
+#include "common/log/log.h"
+#include "storage/table/lsm_table_engine.h"
 
 RC LsmMvccTrxKit::init() { return RC::SUCCESS; }
 
@@ -16,7 +18,7 @@ const vector<FieldMeta> *LsmMvccTrxKit::trx_fields() const { return nullptr; }
 
 Trx *LsmMvccTrxKit::create_trx(LogHandler &) { return new LsmMvccTrx(lsm_); }
 
-Trx *LsmMvccTrxKit::create_trx(LogHandler &, int32_t /*trx_id*/) { return nullptr; }
+Trx *LsmMvccTrxKit::create_trx(LogHandler &, TrxID /*trx_id*/) { return nullptr; }
 
 void LsmMvccTrxKit::destroy_trx(Trx *trx) { delete trx; }
 
@@ -29,17 +31,25 @@ LogReplayer *LsmMvccTrxKit::create_log_replayer(Db &, LogHandler &) { return new
 
 RC LsmMvccTrx::insert_record(Table *table, Record &record)
 {
-   return table->insert_record_with_trx(record, this);
+  start_if_need();
+  return table->insert_record_with_trx(record, this);
 }
 
 RC LsmMvccTrx::delete_record(Table *table, Record &record)
 {
+  start_if_need();
   return table->delete_record_with_trx(record, this);
 }
 
 RC LsmMvccTrx::update_record(Table *table, Record &record, const char *attr_name, Value *value)
 {
-  return table->update_record(record, attr_name, value);
+  start_if_need();
+  Record new_record;
+  RC     rc = LsmTableEngine::make_updated_record(table->table_meta(), record, attr_name, value, new_record);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return table->update_record_with_trx(record, new_record, this);
 }
 
 /**
@@ -56,17 +66,34 @@ RC LsmMvccTrx::start_if_need()
   return RC::SUCCESS;
 }
 
+/**
+ * 写集合在提交时作为一个批次原子写入，写写冲突在提交时按照序列号乐观地检查，
+ * 冲突时返回 LOCKED_CONCURRENCY_CONFLICT，事务的修改全部丢弃。
+ * 不管成功与否，下一条语句都会开启新的 LSM 事务，拿到新的快照。
+ */
 RC LsmMvccTrx::commit()
 {
   if (trx_ == nullptr) {
     return RC::SUCCESS;
   }
-  return trx_->commit();
+  RC rc = trx_->commit();
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to commit lsm transaction. rc=%s", strrc(rc));
+  }
+  delete trx_;
+  trx_ = nullptr;
+  return rc;
 }
 
 RC LsmMvccTrx::rollback()
 {
-  return trx_->rollback();
+  if (trx_ == nullptr) {
+    return RC::SUCCESS;
+  }
+  RC rc = trx_->rollback();
+  delete trx_;
+  trx_ = nullptr;
+  return rc;
 }
 
 /**
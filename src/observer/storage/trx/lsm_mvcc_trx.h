@@ -29,7 +29,7 @@ public:
   const vector<FieldMeta> *trx_fields() const override;
 
   Trx *create_trx(LogHandler &log_handler) override;
-  Trx *create_trx(LogHandler &log_handler, int32_t trx_id) override;
+  Trx *create_trx(LogHandler &log_handler, TrxID trx_id) override;
   void all_trxes(vector<Trx *> &trxes) override;
 
   void destroy_trx(Trx *trx) override;
@@ -63,7 +63,7 @@ public:
 
   ObLsmTransaction *get_trx() { return trx_; }
 
-  int32_t id() const override { return 0; }
+  TrxID id() const override { return 0; }
 
 private:
   ObLsm            *lsm_;
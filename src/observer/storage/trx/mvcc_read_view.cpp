@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/mvcc_read_view.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/thread.h"
+
+void MvccReadView::init(TrxID low_limit_id, vector<TrxID> &&committing_ids)
+{
+  low_limit_id_   = low_limit_id;
+  committing_ids_ = std::move(committing_ids);
+  sort(committing_ids_.begin(), committing_ids_.end());
+  up_limit_id_ = committing_ids_.empty() ? low_limit_id_ : committing_ids_.front();
+}
+
+bool MvccReadView::is_committing(TrxID commit_xid) const
+{
+  return binary_search(committing_ids_.begin(), committing_ids_.end(), commit_xid);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+MvccActiveTrxTable::MvccActiveTrxTable(int capacity) : capacity_(capacity), slots_(make_unique<Slot[]>(capacity)) {}
+
+bool MvccActiveTrxTable::try_acquire(int slot_index, Trx *trx)
+{
+  Slot &slot = slots_[slot_index];
+  Trx  *free = nullptr;
+  if (slot.trx.load() != nullptr || !slot.trx.compare_exchange_strong(free, trx)) {
+    return false;
+  }
+
+  slot.view_limit.store(NONE);
+  slot.commit_xid.store(NONE);
+
+  int high_water = high_water_.load();
+  while (high_water < slot_index + 1 && !high_water_.compare_exchange_weak(high_water, slot_index + 1)) {
+  }
+  return true;
+}
+
+int MvccActiveTrxTable::acquire(Trx *trx, int hint /*= -1*/)
+{
+  if (hint >= 0 && hint < capacity_ && try_acquire(hint, trx)) {
+    return hint;
+  }
+
+  // 优先使用编号小的槽位，让扫描的范围尽量小
+  for (int i = 0; i < capacity_; i++) {
+    if (try_acquire(i, trx)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void MvccActiveTrxTable::release(int slot)
+{
+  slots_[slot].view_limit.store(NONE);
+  slots_[slot].commit_xid.store(NONE);
+  slots_[slot].trx.store(nullptr);
+}
+
+TrxID MvccActiveTrxTable::load_settled(const atomic<TrxID> &value)
+{
+  TrxID result = value.load();
+  while (result == PENDING) {
+    this_thread::yield();
+    result = value.load();
+  }
+  return result;
+}
+
+void MvccActiveTrxTable::collect_committing(TrxID low_limit_id, vector<TrxID> &committing_ids) const
+{
+  const int high_water = high_water_.load();
+  for (int i = 0; i < high_water; i++) {
+    TrxID commit_xid = load_settled(slots_[i].commit_xid);
+    if (commit_xid != NONE && commit_xid < low_limit_id) {
+      committing_ids.push_back(commit_xid);
+    }
+  }
+}
+
+TrxID MvccActiveTrxTable::min_active_id(TrxID init_id) const
+{
+  TrxID     min_id     = init_id;
+  const int high_water = high_water_.load();
+  for (int i = 0; i < high_water; i++) {
+    TrxID view_limit = load_settled(slots_[i].view_limit);
+    if (view_limit != NONE) {
+      min_id = min(min_id, view_limit);
+    }
+
+    TrxID commit_xid = load_settled(slots_[i].commit_xid);
+    if (commit_xid != NONE) {
+      min_id = min(min_id, commit_xid);
+    }
+  }
+  return min_id;
+}
+
+void MvccActiveTrxTable::all_trxes(vector<Trx *> &trxes) const
+{
+  const int high_water = high_water_.load();
+  for (int i = 0; i < high_water; i++) {
+    Trx *trx = slots_[i].trx.load();
+    if (trx != nullptr) {
+      trxes.push_back(trx);
+    }
+  }
+}
@@ -0,0 +1,146 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/types.h"
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/lang/vector.h"
+
+class Trx;
+
+/**
+ * @brief 多版本事务的读视图(快照)
+ * @ingroup Transaction
+ * @details 记录上保存的是提交ID，事务ID和提交ID从同一个计数器中分配。
+ * 创建读视图时记下当前事务ID，以及所有分配了提交ID但是还没有提交完成的事务的提交ID。
+ * 一个提交ID对读视图可见，当且仅当它比读视图的事务ID小并且不在正在提交的列表中。
+ * 正在提交的事务会逐条修改记录上的提交ID，读视图把它当成没有提交，
+ * 这样其它事务要么看到它的全部修改，要么全部看不到。
+ */
+class MvccReadView
+{
+public:
+  MvccReadView()  = default;
+  ~MvccReadView() = default;
+
+  /**
+   * @brief 初始化读视图
+   * @param low_limit_id 创建读视图的事务ID，大于等于它的提交ID都不可见
+   * @param committing_ids 创建读视图时正在提交的事务的提交ID，都比 low_limit_id 小
+   */
+  void init(TrxID low_limit_id, vector<TrxID> &&committing_ids);
+
+  /**
+   * @brief 某个提交ID对应的修改对当前读视图是否可见
+   * @details 绝大多数情况下只需要和 up_limit_id/low_limit_id 比较一次，
+   * 只有落在两者之间的提交ID才需要在(通常很短的)正在提交列表中二分查找
+   */
+  bool is_visible(TrxID commit_xid) const
+  {
+    if (commit_xid < up_limit_id_) {
+      return true;
+    }
+    if (commit_xid >= low_limit_id_) {
+      return false;
+    }
+    return !is_committing(commit_xid);
+  }
+
+  /**
+   * @brief 比它小的提交ID都可见
+   */
+  TrxID up_limit_id() const { return up_limit_id_; }
+  TrxID low_limit_id() const { return low_limit_id_; }
+
+private:
+  bool is_committing(TrxID commit_xid) const;
+
+private:
+  TrxID         up_limit_id_  = 0;
+  TrxID         low_limit_id_ = 0;
+  vector<TrxID> committing_ids_;  ///< 有序
+};
+
+/**
+ * @brief 活跃事务表
+ * @ingroup Transaction
+ * @details 固定大小的槽位数组，每个活跃事务占用一个槽位，事务对象记住自己的槽位，
+ * 开始、结束事务都不需要加锁，也不需要在列表中查找。
+ * 每个槽位公开两个值：
+ * - view_limit 事务读视图的 up_limit_id，垃圾回收据此判断旧版本是否还有事务需要;
+ * - commit_xid 事务正在提交时分配的提交ID，创建读视图时据此判断哪些提交还没有完成。
+ * 这两个值在分配ID之前先设置成 PENDING，分配到ID之后再写入真实的值。
+ * 读取方看到 PENDING 时要等待，这样读取方不会漏掉一个ID比自己看到的计数器还小的事务。
+ * 只会扫描使用过的最大槽位之前的部分。
+ */
+class MvccActiveTrxTable
+{
+public:
+  static constexpr TrxID NONE    = 0;
+  static constexpr TrxID PENDING = -1;
+
+  static constexpr int DEFAULT_CAPACITY = 4096;
+
+public:
+  explicit MvccActiveTrxTable(int capacity = DEFAULT_CAPACITY);
+  ~MvccActiveTrxTable() = default;
+
+  /**
+   * @brief 为事务分配一个槽位
+   * @param hint 优先尝试的槽位，复用的事务对象会先尝试它上次使用的槽位，通常不需要扫描
+   * @return 槽位编号，槽位用完时返回 -1
+   */
+  int acquire(Trx *trx, int hint = -1);
+
+  /**
+   * @brief 事务销毁时释放槽位
+   */
+  void release(int slot);
+
+  void set_view_limit(int slot, TrxID view_limit) { slots_[slot].view_limit.store(view_limit); }
+  void set_commit_xid(int slot, TrxID commit_xid) { slots_[slot].commit_xid.store(commit_xid); }
+
+  /**
+   * @brief 收集所有正在提交并且提交ID比 low_limit_id 小的事务的提交ID
+   */
+  void collect_committing(TrxID low_limit_id, vector<TrxID> &committing_ids) const;
+
+  /**
+   * @brief 所有活跃事务的读视图和正在提交的事务中最小的ID
+   * @param init_id 没有活跃事务时返回的值
+   */
+  TrxID min_active_id(TrxID init_id) const;
+
+  void all_trxes(vector<Trx *> &trxes) const;
+
+  int capacity() const { return capacity_; }
+
+private:
+  /**
+   * @brief 读取一个槽位上的值，等待 PENDING 结束
+   */
+  static TrxID load_settled(const atomic<TrxID> &value);
+
+  bool try_acquire(int slot, Trx *trx);
+
+private:
+  struct alignas(64) Slot
+  {
+    atomic<Trx *> trx{nullptr};
+    atomic<TrxID> view_limit{NONE};
+    atomic<TrxID> commit_xid{NONE};
+  };
+
+  int                 capacity_ = 0;
+  unique_ptr<Slot[]>  slots_;
+  atomic<int>         high_water_{0};  ///< 用过的最大槽位编号加1
+};
@@ -15,17 +15,129 @@ See the Mulan PSL v2 for more details. */
 #include "storage/trx/mvcc_trx.h"
 #include "storage/db/db.h"
 #include "storage/field/field.h"
+#include "storage/index/index.h"
 #include "storage/trx/mvcc_trx_log.h"
 #include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/thread/thread_util.h"
+
+using namespace common;
+
+/**
+ * @brief 获取指定表上的事务使用的字段，垃圾回收时没有事务对象，也需要用到
+ */
+static void mvcc_trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field)
+{
+  const TableMeta      &table_meta = table->table_meta();
+  span<const FieldMeta> trx_fields = table_meta.trx_fields();
+  ASSERT(trx_fields.size() >= 2, "invalid trx fields number. %d", trx_fields.size());
+
+  begin_xid_field.set_table(table);
+  begin_xid_field.set_field(&trx_fields[0]);
+  end_xid_field.set_table(table);
+  end_xid_field.set_field(&trx_fields[1]);
+}
+
+static void table_indexes(Table *table, vector<Index *> &indexes)
+{
+  const TableMeta &table_meta = table->table_meta();
+  for (int i = 0; i < table_meta.index_num(); i++) {
+    Index *index = table->find_index(table_meta.index(i)->name());
+    if (index != nullptr) {
+      indexes.push_back(index);
+    }
+  }
+}
+
+/**
+ * @brief 两个版本在某个索引上的键值是否相同
+ */
+static bool same_index_key(const Index *index, const char *left, const char *right)
+{
+  for (const FieldMeta &field_meta : index->field_metas()) {
+    if (0 != memcmp(left + field_meta.offset(), right + field_meta.offset(), field_meta.len())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 删除一个被丢弃的版本在索引中的数据
+ * @details 同一条记录的多个版本可能有相同的索引键，只有最新版本和其它旧版本都不使用这个键时才能删除。
+ * 删除后再检查一次，如果并发的更新又用到了这个键，就把它插回去。
+ */
+static void delete_index_entries(MvccVersionStore &version_store, Table *table, const Record &discarded)
+{
+  vector<Index *> indexes;
+  table_indexes(table, indexes);
+  if (indexes.empty()) {
+    return;
+  }
+
+  const RID &rid        = discarded.rid();
+  auto       key_in_use = [&version_store, table, &discarded, &rid](const Index *index) {
+    Record inplace_record;
+    if (OB_SUCC(table->get_record(rid, inplace_record)) &&
+        same_index_key(index, inplace_record.data(), discarded.data())) {
+      return true;
+    }
+
+    bool in_use = false;
+    version_store.visit(table->table_id(), rid, [index, &discarded, &in_use](Record &version) {
+      in_use = same_index_key(index, version.data(), discarded.data());
+      return !in_use;
+    });
+    return in_use;
+  };
+
+  for (Index *index : indexes) {
+    if (key_in_use(index)) {
+      continue;
+    }
+
+    RC rc = index->delete_entry(discarded.data(), &rid);
+    if (OB_FAIL(rc) && rc != RC::RECORD_NOT_EXIST) {
+      LOG_WARN("failed to delete index entry of discarded version. table=%s, index=%s, rid=%s, rc=%s",
+               table->name(), index->index_meta().name(), rid.to_string().c_str(), strrc(rc));
+      continue;
+    }
+
+    if (key_in_use(index)) {
+      rc = index->insert_entry(discarded.data(), &rid);
+      if (OB_FAIL(rc) && rc != RC::RECORD_DUPLICATE_KEY) {
+        LOG_ERROR("failed to restore index entry. table=%s, index=%s, rid=%s, rc=%s",
+                  table->name(), index->index_meta().name(), rid.to_string().c_str(), strrc(rc));
+      }
+    }
+  }
+}
 
 MvccTrxKit::~MvccTrxKit()
 {
+  if (vacuum_thread_) {
+    {
+      lock_guard guard(vacuum_lock_);
+      vacuum_stopped_ = true;
+    }
+    vacuum_cond_.notify_all();
+    vacuum_thread_->join();
+    vacuum_thread_.reset();
+  }
+
   vector<Trx *> tmp_trxes;
-  tmp_trxes.swap(trxes_);
+  active_trxes_.all_trxes(tmp_trxes);
 
   for (Trx *trx : tmp_trxes) {
     delete trx;
   }
+
+  for (TrxFreeList &free_list : free_lists_) {
+    for (MvccTrx *trx : free_list.trxes) {
+      delete trx;
+    }
+    free_list.trxes.clear();
+  }
 }
 
 RC MvccTrxKit::init()
@@ -33,8 +145,13 @@ RC MvccTrxKit::init()
   // 事务使用一些特殊的字段，放到每行记录中，表示行记录的可见性。
   fields_ = vector<FieldMeta>{
       // field_id in trx fields is invisible.
-      FieldMeta("__trx_xid_begin", AttrType::INTS, 0 /*attr_offset*/, 4 /*attr_len*/, false /*visible*/, -1/*field_id*/,false /*nullable*/),
-      FieldMeta("__trx_xid_end", AttrType::INTS, 0 /*attr_offset*/, 4 /*attr_len*/, false /*visible*/, -2/*field_id*/,false /*nullable*/)};
+      // 事务ID是64位的，不会回绕
+      FieldMeta("__trx_xid_begin", AttrType::INTS, 0 /*attr_offset*/, sizeof(TrxID) /*attr_len*/, false /*visible*/, -1/*field_id*/,false /*nullable*/),
+      FieldMeta("__trx_xid_end", AttrType::INTS, 0 /*attr_offset*/, sizeof(TrxID) /*attr_len*/, false /*visible*/, -2/*field_id*/,false /*nullable*/)};
+
+#ifdef CONCURRENCY
+  vacuum_thread_ = make_unique<thread>(&MvccTrxKit::vacuum_thread_func, this);
+#endif
 
   LOG_INFO("init mvcc trx kit done.");
   return RC::SUCCESS;
@@ -42,54 +159,122 @@ RC MvccTrxKit::init()
 
 const vector<FieldMeta> *MvccTrxKit::trx_fields() const { return &fields_; }
 
-int32_t MvccTrxKit::next_trx_id() { return ++current_trx_id_; }
+TrxID MvccTrxKit::next_trx_id() { return ++current_trx_id_; }
 
-int32_t MvccTrxKit::max_trx_id() const { return numeric_limits<int32_t>::max(); }
+void MvccTrxKit::update_trx_id(TrxID trx_id)
+{
+  TrxID current = current_trx_id_.load();
+  while (current < trx_id && !current_trx_id_.compare_exchange_weak(current, trx_id)) {
+  }
+}
 
-Trx *MvccTrxKit::create_trx(LogHandler &log_handler)
+TrxID MvccTrxKit::max_trx_id() const { return numeric_limits<TrxID>::max(); }
+
+/**
+ * @brief 在活跃事务表中为事务分配一个槽位
+ * @details 槽位的个数远多于并发的会话数，用完时只能等待其它事务结束
+ */
+static int acquire_slot(MvccActiveTrxTable &active_trxes, Trx *trx, int hint = -1)
 {
-  Trx *trx = new MvccTrx(*this, log_handler);
-  if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    lock_.unlock();
+  int slot = active_trxes.acquire(trx, hint);
+  if (slot < 0) {
+    LOG_WARN("active trx table is full. capacity=%d", active_trxes.capacity());
+    while ((slot = active_trxes.acquire(trx)) < 0) {
+      this_thread::yield();
+    }
   }
-  return trx;
+  return slot;
 }
 
-Trx *MvccTrxKit::create_trx(LogHandler &log_handler, int32_t trx_id)
+MvccTrxKit::TrxFreeList &MvccTrxKit::local_free_list()
+{
+  static atomic<int>     next_index{0};
+  thread_local const int index = next_index++ % FREE_LIST_NUM;
+  return free_lists_[index];
+}
+
+Trx *MvccTrxKit::create_trx(LogHandler &log_handler)
 {
-  Trx *trx = new MvccTrx(*this, log_handler, trx_id);
-  if (trx != nullptr) {
-    lock_.lock();
-    trxes_.push_back(trx);
-    if (current_trx_id_ < trx_id) {
-      current_trx_id_ = trx_id;
+  MvccTrx     *trx       = nullptr;
+  TrxFreeList &free_list = local_free_list();
+  {
+    lock_guard guard(free_list.lock);
+    if (!free_list.trxes.empty()) {
+      trx = free_list.trxes.back();
+      free_list.trxes.pop_back();
     }
-    lock_.unlock();
   }
+
+  if (trx != nullptr && &trx->log_handler() != &log_handler) {
+    delete trx;
+    trx = nullptr;
+  }
+  if (trx == nullptr) {
+    trx = new MvccTrx(*this, log_handler);
+  }
+
+  trx->set_slot(acquire_slot(active_trxes_, trx, trx->slot()));
+  return trx;
+}
+
+Trx *MvccTrxKit::create_trx(LogHandler &log_handler, TrxID trx_id)
+{
+  auto *trx = new MvccTrx(*this, log_handler, trx_id);
+  trx->set_slot(acquire_slot(active_trxes_, trx));
+  // 恢复出来的事务没有读视图，但是在结束之前也不能回收它能看到的版本
+  active_trxes_.set_view_limit(trx->slot(), trx_id);
+  update_trx_id(trx_id);
   return trx;
 }
 
 void MvccTrxKit::destroy_trx(Trx *trx)
 {
-  lock_.lock();
-  for (auto iter = trxes_.begin(), itend = trxes_.end(); iter != itend; ++iter) {
-    if (*iter == trx) {
-      trxes_.erase(iter);
-      break;
+  auto *mvcc_trx = static_cast<MvccTrx *>(trx);
+  if (mvcc_trx->slot() >= 0) {
+    active_trxes_.release(mvcc_trx->slot());
+  }
+
+  if (mvcc_trx->reset()) {
+    TrxFreeList &free_list = local_free_list();
+    lock_guard   guard(free_list.lock);
+    if (static_cast<int>(free_list.trxes.size()) < MAX_FREE_TRX_NUM) {
+      free_list.trxes.push_back(mvcc_trx);
+      return;
     }
   }
-  lock_.unlock();
 
   delete trx;
 }
 
-void MvccTrxKit::all_trxes(vector<Trx *> &trxes)
+void MvccTrxKit::all_trxes(vector<Trx *> &trxes) { active_trxes_.all_trxes(trxes); }
+
+TrxID MvccTrxKit::begin_trx(int slot, MvccReadView &read_view)
+{
+  // 先公开 PENDING 再分配ID，垃圾回收线程不会在读视图公开之前回收它需要的版本
+  active_trxes_.set_view_limit(slot, MvccActiveTrxTable::PENDING);
+  const TrxID trx_id = next_trx_id();
+
+  vector<TrxID> committing_ids;
+  active_trxes_.collect_committing(trx_id, committing_ids);
+  read_view.init(trx_id, std::move(committing_ids));
+
+  active_trxes_.set_view_limit(slot, read_view.up_limit_id());
+  return trx_id;
+}
+
+TrxID MvccTrxKit::begin_commit(int slot)
+{
+  // 先公开 PENDING 再分配ID，ID比提交ID大的读视图一定能看到这个槽位上的提交ID
+  active_trxes_.set_commit_xid(slot, MvccActiveTrxTable::PENDING);
+  const TrxID commit_xid = next_trx_id();
+  active_trxes_.set_commit_xid(slot, commit_xid);
+  return commit_xid;
+}
+
+void MvccTrxKit::end_trx(int slot)
 {
-  lock_.lock();
-  trxes = trxes_;
-  lock_.unlock();
+  active_trxes_.set_commit_xid(slot, MvccActiveTrxTable::NONE);
+  active_trxes_.set_view_limit(slot, MvccActiveTrxTable::NONE);
 }
 
 LogReplayer *MvccTrxKit::create_log_replayer(Db &db, LogHandler &log_handler)
@@ -97,12 +282,156 @@ LogReplayer *MvccTrxKit::create_log_replayer(Db &db, LogHandler &log_handler)
   return new MvccTrxLogReplayer(db, *this, log_handler);
 }
 
+TrxID MvccTrxKit::oldest_active_trx_id()
+{
+  // 先取当前的事务ID，之后再开始的事务的读视图只会更新，不需要考虑
+  return active_trxes_.min_active_id(current_trx_id_.load() + 1);
+}
+
+RC MvccTrxKit::vacuum(int &purged_count)
+{
+  purged_count = 0;
+
+  const TrxID oldest_trx_id = oldest_active_trx_id();
+
+  // 先回收旧版本，再删除记录。删除记录时会删除最新版本的索引数据，旧版本要先判断是否和最新版本共用索引键
+  RC rc = purge_versions(oldest_trx_id, purged_count);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to purge versions. oldest trx id=%ld, rc=%s", oldest_trx_id, strrc(rc));
+    return rc;
+  }
+
+  rc = purge_deleted_records(oldest_trx_id, purged_count);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to purge deleted records. oldest trx id=%ld, rc=%s", oldest_trx_id, strrc(rc));
+    return rc;
+  }
+
+  if (purged_count > 0) {
+    LOG_DEBUG("vacuum done. oldest trx id=%ld, purged=%d, versions left=%ld",
+              oldest_trx_id, purged_count, version_store_.version_count());
+  }
+  return RC::SUCCESS;
+}
+
+RC MvccTrxKit::purge_versions(TrxID oldest_trx_id, int &purged_count)
+{
+  // 先在版本存储区的锁外找到有旧版本的表，表已经删除时记为空
+  unordered_set<int32_t> table_ids;
+  version_store_.table_ids(table_ids);
+  unordered_map<int32_t, Field> end_xid_fields;
+  for (int32_t table_id : table_ids) {
+    Table *table = db_->find_table(table_id);
+    Field  begin_xid_field, end_xid_field;
+    if (nullptr != table) {
+      mvcc_trx_fields(table, begin_xid_field, end_xid_field);
+    }
+    end_xid_fields.emplace(table_id, end_xid_field);
+  }
+
+  // 覆盖这个版本的事务已经提交，而且比所有活跃事务都老，就没有事务能看到这个版本了
+  auto is_dead = [&end_xid_fields, oldest_trx_id](int32_t table_id, const Record &version) {
+    auto iter = end_xid_fields.find(table_id);
+    if (iter == end_xid_fields.end()) {
+      return false;  // 查找表之后才有旧版本的表，下次再回收
+    }
+    if (nullptr == iter->second.meta()) {
+      return true;  // 表已经删除了
+    }
+
+    TrxID end_xid = iter->second.get_int64(version);
+    return end_xid > 0 && end_xid < oldest_trx_id;
+  };
+
+  vector<MvccVersionStore::PurgedVersion> purged;
+  version_store_.purge(is_dead, purged);
+
+  for (const MvccVersionStore::PurgedVersion &purged_version : purged) {
+    Table *table = db_->find_table(purged_version.key.table_id);
+    if (nullptr != table) {
+      delete_index_entries(version_store_, table, purged_version.version);
+    }
+  }
+
+  purged_count += static_cast<int>(purged.size());
+  return RC::SUCCESS;
+}
+
+RC MvccTrxKit::purge_deleted_records(TrxID oldest_trx_id, int &purged_count)
+{
+  vector<MvccVersionStore::DeletedRecord> deleted_records;
+  version_store_.take_deleted(oldest_trx_id, deleted_records);
+
+  for (const MvccVersionStore::DeletedRecord &deleted_record : deleted_records) {
+    Table *table = db_->find_table(deleted_record.key.table_id);
+    if (nullptr == table) {
+      continue;
+    }
+
+    const RID &rid = deleted_record.key.rid;
+    Record     record;
+    RC         rc = table->get_record(rid, record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get deleted record. table=%s, rid=%s, rc=%s", table->name(), rid.to_string().c_str(), strrc(rc));
+      continue;
+    }
+
+    Field begin_xid_field, end_xid_field;
+    mvcc_trx_fields(table, begin_xid_field, end_xid_field);
+    if (end_xid_field.get_int64(record) != deleted_record.commit_xid) {
+      continue;
+    }
+
+    // 记录删除后 RID 可能被复用，不能留下旧版本
+    version_store_.remove(table->table_id(), rid);
+    rc = table->delete_record(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to delete record while vacuum. table=%s, rid=%s, rc=%s",
+               table->name(), rid.to_string().c_str(), strrc(rc));
+      continue;
+    }
+    purged_count++;
+  }
+  return RC::SUCCESS;
+}
+
+void MvccTrxKit::on_trx_end()
+{
+#ifndef CONCURRENCY
+  if (++ended_trx_count_ % VACUUM_TRX_INTERVAL == 0) {
+    int purged_count = 0;
+    vacuum(purged_count);
+  }
+#endif
+}
+
+void MvccTrxKit::vacuum_thread_func()
+{
+  thread_set_name("MvccVacuum");
+  LOG_INFO("mvcc vacuum thread started");
+
+  unique_lock<mutex> guard(vacuum_lock_);
+  while (!vacuum_stopped_) {
+    vacuum_cond_.wait_for(guard, chrono::milliseconds(VACUUM_INTERVAL_MS), [this] { return vacuum_stopped_; });
+    if (vacuum_stopped_) {
+      break;
+    }
+
+    guard.unlock();
+    int purged_count = 0;
+    vacuum(purged_count);
+    guard.lock();
+  }
+
+  LOG_INFO("mvcc vacuum thread stopped");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler) : Trx(TrxKit::Type::MVCC), trx_kit_(kit), log_handler_(log_handler)
 {}
 
-MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, int32_t trx_id) 
+MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, TrxID trx_id) 
   : Trx(TrxKit::Type::MVCC), trx_kit_(kit), log_handler_(log_handler), trx_id_(trx_id)
 {
   started_    = true;
@@ -111,14 +440,26 @@ MvccTrx::MvccTrx(MvccTrxKit &kit, LogHandler &log_handler, int32_t trx_id)
 
 MvccTrx::~MvccTrx() {}
 
+bool MvccTrx::reset()
+{
+  if (started_ || recovering_) {
+    return false;
+  }
+
+  ASSERT(operations_.empty() && locked_rows_.empty(), "trx has not been ended. trx id=%ld", trx_id_);
+  trx_id_ = -1;
+  set_lock_wait_timeout(DEFAULT_LOCK_WAIT_TIMEOUT_MS);
+  return true;
+}
+
 RC MvccTrx::insert_record(Table *table, Record &record)
 {
   Field begin_field;
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
-  begin_field.set_int(record, -trx_id_);
-  end_field.set_int(record, trx_kit_.max_trx_id());
+  begin_field.set_int64(record, -trx_id_);
+  end_field.set_int64(record, trx_kit_.max_trx_id());
 
   RC rc = table->insert_record(record);
   if (rc != RC::SUCCESS) {
@@ -127,7 +468,7 @@ RC MvccTrx::insert_record(Table *table, Record &record)
   }
 
   rc = log_handler_.insert_record(trx_id_, table, record.rid());
-  ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
+  ASSERT(rc == RC::SUCCESS, "failed to append insert record log. trx id=%ld, table id=%d, rid=%s, record len=%d, rc=%s",
          trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
 
   operations_.push_back(Operation(Operation::Type::INSERT, table, record.rid()));
@@ -140,16 +481,21 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
+  RC rc = lock_row(table, record.rid());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
   RC delete_result = RC::SUCCESS;
 
-  RC rc = table->visit_record(record.rid(), [this, table, &delete_result, &end_field](Record &inplace_record) -> bool {
-    RC rc = this->visit_record(table, inplace_record, ReadWriteMode::READ_WRITE);
+  rc = table->visit_record(record.rid(), [this, &delete_result, &begin_field, &end_field](Record &inplace_record) -> bool {
+    RC rc = this->check_writable(begin_field.get_int64(inplace_record), end_field.get_int64(inplace_record));
     if (OB_FAIL(rc)) {
       delete_result = rc;
       return false;
     }
 
-    end_field.set_int(inplace_record, -trx_id_);
+    end_field.set_int64(inplace_record, -trx_id_);
     return true;
   });
 
@@ -164,7 +510,7 @@ RC MvccTrx::delete_record(Table *table, Record &record)
   }
 
   rc = log_handler_.delete_record(trx_id_, table, record.rid());
-  ASSERT(rc == RC::SUCCESS, "failed to append delete record log. trx id=%d, table id=%d, rid=%s, record len=%d, rc=%s",
+  ASSERT(rc == RC::SUCCESS, "failed to append delete record log. trx id=%ld, table id=%d, rid=%s, record len=%d, rc=%s",
       trx_id_, table->table_id(), record.rid().to_string().c_str(), record.len(), strrc(rc));
 
   operations_.push_back(Operation(Operation::Type::DELETE, table, record.rid()));
@@ -174,62 +520,217 @@ RC MvccTrx::delete_record(Table *table, Record &record)
 
 RC MvccTrx::update_record(Table *table, Record &record, const char *attr_name, Value *value)
 {
-  return table->update_record(record, attr_name, value);
+  const FieldMeta *field_meta = table->table_meta().field(attr_name);
+  if (nullptr == field_meta) {
+    LOG_WARN("no such field. table=%s, field=%s", table->name(), attr_name);
+    return RC::SCHEMA_FIELD_NOT_EXIST;
+  }
+  if (field_meta->type() != value->attr_type()) {
+    LOG_WARN("field type mismatch. table=%s, field=%s", table->name(), attr_name);
+    return RC::SCHEMA_FIELD_TYPE_MISMATCH;
+  }
+
+  Field begin_field;
+  Field end_field;
+  trx_fields(table, begin_field, end_field);
+
+  // 先在不持有页面锁的时候加行锁，其它写事务正在修改这条记录时在这里等待
+  RC rc = lock_row(table, record.rid());
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 在页面锁的保护下检查冲突、保存旧版本并原地写入新版本。
+  // 其它事务看到新版本时，旧版本一定已经在版本链上了
+  RC     update_result = RC::SUCCESS;
+  Record old_version;
+  Record new_version;
+
+  auto record_updater = [&](Record &inplace_record) -> bool {
+    update_result = this->check_writable(begin_field.get_int64(inplace_record), end_field.get_int64(inplace_record));
+    if (OB_FAIL(update_result)) {
+      return false;
+    }
+
+    old_version = inplace_record;
+    end_field.set_int64(old_version, -trx_id_);
+
+    update_result = table->set_value_to_record(inplace_record.data(), *value, field_meta);
+    if (OB_FAIL(update_result)) {
+      return false;
+    }
+    begin_field.set_int64(inplace_record, -trx_id_);
+    end_field.set_int64(inplace_record, trx_kit_.max_trx_id());
+
+    // 先记录带有旧版本的日志再修改页面，恢复时才能回滚没有提交的更新
+    update_result = log_handler_.update_record(trx_id_, table, old_version);
+    if (OB_FAIL(update_result)) {
+      return false;
+    }
+
+    trx_kit_.version_store().push(table->table_id(), old_version);
+    new_version = inplace_record;
+    return true;
+  };
+
+  rc = table->visit_record(record.rid(), record_updater);
+  if (OB_FAIL(update_result)) {
+    LOG_TRACE("failed to update record. rid=%s, rc=%s", record.rid().to_string().c_str(), strrc(update_result));
+    return update_result;
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to visit record. rid=%s, rc=%s", record.rid().to_string().c_str(), strrc(rc));
+    if (new_version.data() != nullptr) {
+      Record version;
+      trx_kit_.version_store().pop(table->table_id(), record.rid(), version);
+    }
+    return rc;
+  }
+
+  operations_.push_back(Operation(Operation::Type::UPDATE, table, record.rid()));
+
+  // 每个版本在索引中都有数据，只需要插入键值变化的索引。旧版本的索引数据由垃圾回收清理
+  vector<Index *> indexes;
+  table_indexes(table, indexes);
+  for (Index *index : indexes) {
+    if (same_index_key(index, old_version.data(), new_version.data())) {
+      continue;
+    }
+
+    rc = index->insert_entry(new_version.data(), &new_version.rid());
+    if (RC::RECORD_DUPLICATE_KEY == rc) {
+      // 更早的版本使用过这个键，还没有被回收
+      rc = RC::SUCCESS;
+    } else if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert index entry. table=%s, index=%s, rid=%s, rc=%s",
+               table->name(), index->index_meta().name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  return rc;
 }
 
-RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
+RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode /*mode*/)
 {
+  // 读写模式下也按照读视图返回数据，写写冲突由修改记录时的行锁处理
   Field begin_field;
   Field end_field;
   trx_fields(table, begin_field, end_field);
 
-  int32_t begin_xid = begin_field.get_int(record);
-  int32_t end_xid   = end_field.get_int(record);
+  RC rc = check_visibility(begin_field.get_int64(record), end_field.get_int64(record));
+  if (rc != RC::RECORD_INVISIBLE) {
+    return rc;
+  }
 
-  RC rc = RC::SUCCESS;
-  if (begin_xid > 0 && end_xid > 0) {
-    if (trx_id_ >= begin_xid && trx_id_ <= end_xid) {
-      rc = RC::SUCCESS;
-    } else {
-      LOG_TRACE("record invisible. trx id=%d, begin xid=%d, end xid=%d", trx_id_, begin_xid, end_xid);
-      rc = RC::RECORD_INVISIBLE;
+  // 最新版本不可见，沿着版本链从新到旧找到当前事务可见的版本
+  bool found = false;
+  trx_kit_.version_store().visit(table->table_id(), record.rid(), [&](Record &version) {
+    if (check_visibility(begin_field.get_int64(version), end_field.get_int64(version)) != RC::SUCCESS) {
+      return true;
     }
-  } else if (begin_xid < 0) {
-    // begin xid 小于0说明是刚插入而且没有提交的数据
-    if (-begin_xid == trx_id_) {
-      rc = RC::SUCCESS;
-    } else {
-      LOG_TRACE("record invisible. someone is updating this record right now. trx id=%d, begin xid=%d, end xid=%d",
+
+    found = true;
+    record.copy_data(version.data(), version.len());
+    return false;
+  });
+
+  return found ? RC::SUCCESS : RC::RECORD_INVISIBLE;
+}
+
+RC MvccTrx::check_visibility(TrxID begin_xid, TrxID end_xid) const
+{
+  if (begin_xid < 0) {
+    // begin xid 小于0说明是刚插入或更新而且没有提交的数据
+    if (-begin_xid != trx_id_) {
+      LOG_TRACE("record invisible. someone is updating this record right now. trx id=%ld, begin xid=%ld, end xid=%ld",
                 trx_id_, begin_xid, end_xid);
-      rc = RC::RECORD_INVISIBLE;
-    }
-  } else if (end_xid < 0) {
-    // end xid 小于0 说明是正在删除但是还没有提交的数据
-    if (mode == ReadWriteMode::READ_ONLY) {
-      // 如果 -end_xid 就是当前事务的事务号，说明是当前事务删除的
-      if (-end_xid != trx_id_) {
-        rc = RC::SUCCESS;
-      } else {
-        LOG_TRACE("record invisible. self has deleted this record. trx id=%d, begin xid=%d, end xid=%d",
-                  trx_id_, begin_xid, end_xid);
-        rc = RC::RECORD_INVISIBLE;
-      }
-    } else {
-      // 如果当前想要修改此条数据，并且不是当前事务删除的，简单的报错
-      // 这是事务并发处理的一种方式，非常简单粗暴。其它的并发处理方法，可以等待，或者让客户端重试
-      // 或者等事务结束后，再检测修改的数据是否有冲突
-      if (-end_xid != trx_id_) {
-        LOG_TRACE("concurrency conflit. someone is deleting this record right now. trx id=%d, begin xid=%d, end xid=%d",
-                  trx_id_, begin_xid, end_xid);
-        rc = RC::LOCKED_CONCURRENCY_CONFLICT;
-      } else {
-        LOG_TRACE("record invisible. self has deleted this record. trx id=%d, begin xid=%d, end xid=%d",
-                  trx_id_, begin_xid, end_xid);
-        rc = RC::RECORD_INVISIBLE;
-      }
+      return RC::RECORD_INVISIBLE;
     }
+    if (-end_xid == trx_id_) {
+      LOG_TRACE("record invisible. self has deleted this record. trx id=%ld, begin xid=%ld, end xid=%ld",
+                trx_id_, begin_xid, end_xid);
+      return RC::RECORD_INVISIBLE;
+    }
+    return RC::SUCCESS;
+  }
+
+  if (!read_view_.is_visible(begin_xid)) {
+    LOG_TRACE("record invisible. trx id=%ld, begin xid=%ld, end xid=%ld", trx_id_, begin_xid, end_xid);
+    return RC::RECORD_INVISIBLE;
+  }
+
+  if (end_xid < 0) {
+    // end xid 小于0 说明是正在删除或更新但是还没有提交的数据，只有自己删除的才不可见
+    if (-end_xid == trx_id_) {
+      LOG_TRACE("record invisible. self has deleted this record. trx id=%ld, begin xid=%ld, end xid=%ld",
+                trx_id_, begin_xid, end_xid);
+      return RC::RECORD_INVISIBLE;
+    }
+    return RC::SUCCESS;
+  }
+
+  if (read_view_.is_visible(end_xid)) {
+    // 删除或覆盖这个版本的事务在读视图创建之前就提交了
+    LOG_TRACE("record invisible. trx id=%ld, begin xid=%ld, end xid=%ld", trx_id_, begin_xid, end_xid);
+    return RC::RECORD_INVISIBLE;
+  }
+  return RC::SUCCESS;
+}
+
+/**
+ * @brief 持有行锁之后，判断最新版本是否可以修改
+ * @details 其它写事务都要先拿到行锁，所以最新版本要么是自己修改的，要么已经提交了。
+ * 与 MySQL 的可重复读一样，修改的是最新提交的版本，即使它对读视图不可见。
+ * 只有最新版本已经被删除时才报冲突。
+ */
+RC MvccTrx::check_writable(TrxID begin_xid, TrxID end_xid) const
+{
+  if (begin_xid < 0 && -begin_xid != trx_id_) {
+    LOG_WARN("record is being modified by others while holding row lock. trx id=%ld, begin xid=%ld, end xid=%ld",
+             trx_id_, begin_xid, end_xid);
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  if (end_xid < 0) {
+    if (-end_xid == trx_id_) {
+      LOG_TRACE("record invisible. self has deleted this record. trx id=%ld, begin xid=%ld, end xid=%ld",
+                trx_id_, begin_xid, end_xid);
+      return RC::RECORD_INVISIBLE;
+    }
+
+    LOG_WARN("record is being deleted by others while holding row lock. trx id=%ld, begin xid=%ld, end xid=%ld",
+             trx_id_, begin_xid, end_xid);
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  if (end_xid != trx_kit_.max_trx_id()) {
+    LOG_TRACE("concurrency conflit. record has been deleted by others. trx id=%ld, begin xid=%ld, end xid=%ld",
+              trx_id_, begin_xid, end_xid);
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+  return RC::SUCCESS;
+}
+
+RC MvccTrx::lock_row(Table *table, const RID &rid)
+{
+  MvccRecordKey key{table->table_id(), rid};
+  RC            rc = trx_kit_.lock_manager().lock(trx_id_, key, lock_wait_timeout());
+  if (OB_FAIL(rc)) {
+    LOG_TRACE("failed to lock row. trx id=%ld, table=%s, rid=%s, rc=%s",
+              trx_id_, table->name(), rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  locked_rows_.push_back(key);
+  return RC::SUCCESS;
+}
+
+void MvccTrx::unlock_rows()
+{
+  if (!locked_rows_.empty()) {
+    trx_kit_.lock_manager().unlock_all(trx_id_, locked_rows_);
+    locked_rows_.clear();
   }
-  return rc;
 }
 
 /**
@@ -241,22 +742,15 @@ RC MvccTrx::visit_record(Table *table, Record &record, ReadWriteMode mode)
  */
 void MvccTrx::trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const
 {
-  const TableMeta      &table_meta = table->table_meta();
-  span<const FieldMeta> trx_fields = table_meta.trx_fields();
-  ASSERT(trx_fields.size() >= 2, "invalid trx fields number. %d", trx_fields.size());
-
-  begin_xid_field.set_table(table);
-  begin_xid_field.set_field(&trx_fields[0]);
-  end_xid_field.set_table(table);
-  end_xid_field.set_field(&trx_fields[1]);
+  mvcc_trx_fields(table, begin_xid_field, end_xid_field);
 }
 
 RC MvccTrx::start_if_need()
 {
   if (!started_) {
     ASSERT(operations_.empty(), "try to start a new trx while operations is not empty");
-    trx_id_ = trx_kit_.next_trx_id();
-    LOG_DEBUG("current thread change to new trx with %d", trx_id_);
+    trx_id_ = trx_kit_.begin_trx(slot_, read_view_);
+    LOG_DEBUG("current thread change to new trx with %ld", trx_id_);
     started_ = true;
   }
   return RC::SUCCESS;
@@ -264,13 +758,14 @@ RC MvccTrx::start_if_need()
 
 RC MvccTrx::commit()
 {
-  int32_t commit_id = trx_kit_.next_trx_id();
+  TrxID commit_id = trx_kit_.begin_commit(slot_);
   return commit_with_trx_id(commit_id);
 }
 
-RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
+RC MvccTrx::commit_with_trx_id(TrxID commit_xid)
 {
-  // TODO 原子性提交BUG：这里存在一个很大的问题，不能让其他事务一次性看到当前事务更新到的数据或同时看不到
+  // 提交ID已经公开在活跃事务表中，在 end_trx 之前创建的读视图都把这次提交当作没有完成，
+  // 其它事务要么看到全部修改，要么全部看不到
   RC rc    = RC::SUCCESS;
   started_ = false;
 
@@ -283,13 +778,13 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
         trx_fields(table, begin_xid_field, end_xid_field);
 
         auto record_updater = [this, &begin_xid_field, commit_xid](Record &record) -> bool {
-          LOG_DEBUG("before commit insert record. trx id=%d, begin xid=%d, commit xid=%d, lbt=%s",
-                    trx_id_, begin_xid_field.get_int(record), commit_xid, lbt());
-          ASSERT(begin_xid_field.get_int(record) == -this->trx_id_ && (!recovering_), 
-                 "got an invalid record while committing. begin xid=%d, this trx id=%d", 
-                 begin_xid_field.get_int(record), trx_id_);
+          LOG_DEBUG("before commit insert record. trx id=%ld, begin xid=%ld, commit xid=%ld, lbt=%s",
+                    trx_id_, begin_xid_field.get_int64(record), commit_xid, lbt());
+          ASSERT(begin_xid_field.get_int64(record) == -this->trx_id_ && (!recovering_), 
+                 "got an invalid record while committing. begin xid=%ld, this trx id=%ld", 
+                 begin_xid_field.get_int64(record), trx_id_);
 
-          begin_xid_field.set_int(record, commit_xid);
+          begin_xid_field.set_int64(record, commit_xid);
           return true;
         };
 
@@ -307,17 +802,24 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
 
         auto record_updater = [this, &end_xid_field, commit_xid](Record &record) -> bool {
           (void)this;
-          ASSERT(end_xid_field.get_int(record) == -trx_id_, 
-                 "got an invalid record while committing. end xid=%d, this trx id=%d", 
-                 end_xid_field.get_int(record), trx_id_);
+          ASSERT(end_xid_field.get_int64(record) == -trx_id_, 
+                 "got an invalid record while committing. end xid=%ld, this trx id=%ld", 
+                 end_xid_field.get_int64(record), trx_id_);
 
-          end_xid_field.set_int(record, commit_xid);
+          end_xid_field.set_int64(record, commit_xid);
           return true;
         };
 
         rc = operation.table()->visit_record(rid, record_updater);
         ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
+
+        // 等到没有事务能看到这条记录时，由垃圾回收把它从表中删除
+        trx_kit_.version_store().add_deleted(table->table_id(), rid, commit_xid);
+      } break;
+
+      case Operation::Type::UPDATE: {
+        commit_versions(operation, commit_xid);
       } break;
 
       default: {
@@ -332,10 +834,56 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
 
   operations_.clear();
 
-  LOG_TRACE("append trx commit log. trx id=%d, commit_xid=%d, rc=%s", trx_id_, commit_xid, strrc(rc));
+  LOG_TRACE("append trx commit log. trx id=%ld, commit_xid=%ld, rc=%s", trx_id_, commit_xid, strrc(rc));
+  trx_kit_.end_trx(slot_);
+  unlock_rows();
+  trx_kit_.on_trx_end();
   return rc;
 }
 
+/**
+ * @brief 提交一个更新操作
+ * @details 最新版本的 begin xid 和被覆盖的旧版本的 end xid 都改成提交ID。
+ * 同一个事务可能多次更新同一条记录，版本链最前面的几个版本都是当前事务产生的，第一次处理时就全部修改了。
+ * 恢复时页面上的数据由日志恢复，只需要修改版本链。
+ */
+void MvccTrx::commit_versions(const Operation &operation, TrxID commit_xid)
+{
+  Table *table = operation.table();
+  RID    rid(operation.page_num(), operation.slot_num());
+
+  Field begin_xid_field, end_xid_field;
+  trx_fields(table, begin_xid_field, end_xid_field);
+
+  if (!recovering_) {
+    auto record_updater = [this, &begin_xid_field, commit_xid](Record &record) -> bool {
+      if (begin_xid_field.get_int64(record) != -trx_id_) {
+        return false;
+      }
+
+      begin_xid_field.set_int64(record, commit_xid);
+      return true;
+    };
+
+    RC rc = table->visit_record(rid, record_updater);
+    ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
+           rid.to_string().c_str(), strrc(rc));
+  }
+
+  auto version_updater = [this, &begin_xid_field, &end_xid_field, commit_xid](Record &version) -> bool {
+    if (end_xid_field.get_int64(version) != -trx_id_) {
+      return false;
+    }
+
+    end_xid_field.set_int64(version, commit_xid);
+    if (begin_xid_field.get_int64(version) == -trx_id_) {
+      begin_xid_field.set_int64(version, commit_xid);
+    }
+    return true;
+  };
+  trx_kit_.version_store().visit(table->table_id(), rid, version_updater);
+}
+
 RC MvccTrx::rollback()
 {
   RC rc    = RC::SUCCESS;
@@ -348,23 +896,23 @@ RC MvccTrx::rollback()
         RID    rid(operation.page_num(), operation.slot_num());
         Table *table = operation.table();
         // 这里也可以不删除，仅仅给数据加个标识位，等垃圾回收器来收割也行
+        // 删除索引数据时需要用到记录的内容
         Record record;
-        record.set_rid(rid);
+        rc = table->get_record(rid, record);
+        if (RC::RECORD_NOT_EXIST == rc && recovering_) {
+          continue;
+        } else if (OB_FAIL(rc)) {
+          LOG_WARN("failed to get record while rollback. table=%s, rid=%s, rc=%s", 
+                   table->name(), rid.to_string().c_str(), strrc(rc));
+          return rc;
+        }
+
         if (recovering_) {
           // 恢复的时候，需要额外判断下当前记录是否还是当前事务拥有。是的话才能删除记录
-          rc = table->get_record(rid, record);
-          if (OB_SUCC(rc)) {
-            Field begin_xid_field, end_xid_field;
-            trx_fields(table, begin_xid_field, end_xid_field);
-            if (begin_xid_field.get_int(record) != -trx_id_) {
-              continue;
-            }
-          } else if (RC::RECORD_NOT_EXIST == rc) {
+          Field begin_xid_field, end_xid_field;
+          trx_fields(table, begin_xid_field, end_xid_field);
+          if (begin_xid_field.get_int64(record) != -trx_id_) {
             continue;
-          } else {
-            LOG_WARN("failed to get record while rollback. table=%s, rid=%s, rc=%s", 
-                     table->name(), rid.to_string().c_str(), strrc(rc));
-            return rc;
           }
         }
         rc = table->delete_record(record);
@@ -382,15 +930,15 @@ RC MvccTrx::rollback()
         trx_fields(table, begin_xid_field, end_xid_field);
 
         auto record_updater = [this, &end_xid_field](Record &record) -> bool {
-          if (recovering_ && end_xid_field.get_int(record) != -trx_id_) {
+          if (recovering_ && end_xid_field.get_int64(record) != -trx_id_) {
             return false;
           }
 
-          ASSERT(end_xid_field.get_int(record) == -trx_id_, 
-                "got an invalid record while rollback. end xid=%d, this trx id=%d", 
-                end_xid_field.get_int(record), trx_id_);
+          ASSERT(end_xid_field.get_int64(record) == -trx_id_, 
+                "got an invalid record while rollback. end xid=%ld, this trx id=%ld", 
+                end_xid_field.get_int64(record), trx_id_);
 
-          end_xid_field.set_int(record, trx_kit_.max_trx_id());
+          end_xid_field.set_int64(record, trx_kit_.max_trx_id());
           return true;
         };
 
@@ -399,6 +947,13 @@ RC MvccTrx::rollback()
                rid.to_string().c_str(), strrc(rc));
       } break;
 
+      case Operation::Type::UPDATE: {
+        rc = rollback_update(operation);
+        if (OB_FAIL(rc)) {
+          return rc;
+        }
+      } break;
+
       default: {
         ASSERT(false, "unsupported operation. type=%d", static_cast<int>(operation.type()));
       }
@@ -406,20 +961,77 @@ RC MvccTrx::rollback()
   }
 
   operations_.clear();
+  trx_kit_.end_trx(slot_);
+  unlock_rows();
 
   if (!recovering_) {
     rc = log_handler_.rollback(trx_id_);
+    trx_kit_.on_trx_end();
   }
-  LOG_TRACE("append trx rollback log. trx id=%d, rc=%s", trx_id_, strrc(rc));
+  LOG_TRACE("append trx rollback log. trx id=%ld, rc=%s", trx_id_, strrc(rc));
   return rc;
 }
 
+/**
+ * @brief 回滚一个更新操作
+ * @details 从版本链上取下当前事务放进去的旧版本，写回到堆表中，再清理新版本在索引中的数据
+ */
+RC MvccTrx::rollback_update(const Operation &operation)
+{
+  Table *table = operation.table();
+  RID    rid(operation.page_num(), operation.slot_num());
+
+  Record old_version;
+  RC     rc = trx_kit_.version_store().pop(table->table_id(), rid, old_version);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get old version while rollback. table=%s, rid=%s, rc=%s",
+             table->name(), rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  Field begin_xid_field, end_xid_field;
+  trx_fields(table, begin_xid_field, end_xid_field);
+  ASSERT(end_xid_field.get_int64(old_version) == -trx_id_,
+         "got an invalid version while rollback. end xid=%ld, this trx id=%ld",
+         end_xid_field.get_int64(old_version), trx_id_);
+
+  Record discarded;
+  auto   record_updater = [this, &begin_xid_field, &end_xid_field, &old_version, &discarded](Record &record) -> bool {
+    // 恢复时，可能更新没有写到页面上，也可能之前已经回滚了一半
+    if (recovering_ && begin_xid_field.get_int64(record) != -trx_id_) {
+      return false;
+    }
+
+    ASSERT(begin_xid_field.get_int64(record) == -trx_id_,
+           "got an invalid record while rollback. begin xid=%ld, this trx id=%ld",
+           begin_xid_field.get_int64(record), trx_id_);
+
+    discarded = record;
+    memcpy(record.data(), old_version.data(), old_version.len());
+    end_xid_field.set_int64(record, trx_kit_.max_trx_id());
+    return true;
+  };
+
+  rc = table->visit_record(rid, record_updater);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to restore old version while rollback. table=%s, rid=%s, rc=%s",
+             table->name(), rid.to_string().c_str(), strrc(rc));
+    return rc;
+  }
+
+  if (discarded.data() != nullptr) {
+    delete_index_entries(trx_kit_.version_store(), table, discarded);
+  }
+  return RC::SUCCESS;
+}
+
 RC find_table(Db *db, const LogEntry &log_entry, Table *&table)
 {
   auto *trx_log_header = reinterpret_cast<const MvccTrxLogHeader *>(log_entry.data());
   switch (MvccTrxLogOperation(trx_log_header->operation_type).type()) {
     case MvccTrxLogOperation::Type::INSERT_RECORD:
-    case MvccTrxLogOperation::Type::DELETE_RECORD: {
+    case MvccTrxLogOperation::Type::DELETE_RECORD:
+    case MvccTrxLogOperation::Type::UPDATE_RECORD: {
       auto *trx_log_record = reinterpret_cast<const MvccTrxRecordLogEntry *>(log_entry.data());
       table                = db->find_table(trx_log_record->table_id);
       if (nullptr == table) {
@@ -454,15 +1066,45 @@ RC MvccTrx::redo(Db *db, const LogEntry &log_entry)
       operations_.push_back(Operation(Operation::Type::DELETE, table, trx_log_record->rid));
     } break;
 
+    case MvccTrxLogOperation::Type::UPDATE_RECORD: {
+      // 把旧版本放回版本链，如果事务最终没有提交，回滚时要用到
+      auto *trx_log_record = reinterpret_cast<const MvccTrxUpdateLogEntry *>(log_entry.data());
+      if (log_entry.payload_size() < MvccTrxUpdateLogEntry::SIZE + trx_log_record->data_len) {
+        LOG_WARN("invalid update log entry. payload size=%d, log record=%s",
+                 log_entry.payload_size(), trx_log_record->to_string().c_str());
+        return RC::LOG_ENTRY_INVALID;
+      }
+
+      Record old_version;
+      old_version.copy_data(trx_log_record->data(), trx_log_record->data_len);
+      old_version.set_rid(trx_log_record->record.rid);
+      trx_kit_.version_store().push(table->table_id(), old_version);
+      operations_.push_back(Operation(Operation::Type::UPDATE, table, trx_log_record->record.rid));
+    } break;
+
     case MvccTrxLogOperation::Type::COMMIT: {
-      // auto *trx_log_record = reinterpret_cast<const MvccTrxCommitLogEntry *>(log_entry.data());
-      // commit_with_trx_id(trx_log_record->commit_trx_id);
       // 遇到了提交日志，说明前面的记录都已经提交成功了
+      // 提交的事务ID也是从事务ID中分配的，恢复之后新事务的ID必须比它大，否则看不到这个事务提交的数据
+      auto *trx_log_record = reinterpret_cast<const MvccTrxCommitLogEntry *>(log_entry.data());
+      trx_kit_.update_trx_id(trx_log_record->commit_trx_id);
+
+      // 放回版本链的旧版本也要标记为已提交，之后由垃圾回收清理
+      for (const Operation &operation : operations_) {
+        if (operation.type() == Operation::Type::UPDATE) {
+          commit_versions(operation, trx_log_record->commit_trx_id);
+        }
+      }
     } break;
 
     case MvccTrxLogOperation::Type::ROLLBACK: {
-      // do nothing
-      // 遇到了回滚日志，前面的回滚操作也都执行完成了
+      // 遇到了回滚日志，前面的回滚操作也都执行完成了，页面上的数据已经由日志恢复
+      // 只需要把放回版本链的旧版本丢弃
+      for (auto iter = operations_.rbegin(), itend = operations_.rend(); iter != itend; ++iter) {
+        if (iter->type() == Operation::Type::UPDATE) {
+          Record old_version;
+          trx_kit_.version_store().pop(iter->table_id(), RID(iter->page_num(), iter->slot_num()), old_version);
+        }
+      }
     } break;
 
     default: {
@@ -14,25 +14,42 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/condition_variable.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
 #include "common/lang/vector.h"
 #include "storage/trx/trx.h"
+#include "storage/trx/mvcc_read_view.h"
 #include "storage/trx/mvcc_trx_log.h"
+#include "storage/trx/mvcc_version_store.h"
+#include "storage/trx/row_lock_manager.h"
 
 class CLogManager;
 class LogHandler;
 class MvccTrxLogHandler;
 
+/**
+ * @brief 多版本并发事务管理器
+ * @ingroup Transaction
+ * @details 除了分配事务ID，还通过活跃事务表(MvccActiveTrxTable)为事务创建读视图，
+ * 管理记录的旧版本(MvccVersionStore)，并负责垃圾回收：
+ * 根据当前最老的活跃事务，回收没有事务能看到的旧版本和已经删除的记录，以及它们在索引中的数据。
+ * CONCURRENCY 模式下由后台线程定期回收，否则在事务结束时顺便回收。
+ *
+ * 事务对象销毁后放到当前线程的空闲列表中，下次创建事务时直接复用，并优先使用它上次的槽位，
+ * 每个语句的事务开销与连接数无关。
+ */
 class MvccTrxKit : public TrxKit
 {
 public:
-  MvccTrxKit() = default;
+  MvccTrxKit(Db *db) : db_(db) {}
   virtual ~MvccTrxKit();
 
   RC                       init() override;
   const vector<FieldMeta> *trx_fields() const override;
 
   Trx *create_trx(LogHandler &log_handler) override;
-  Trx *create_trx(LogHandler &log_handler, int32_t trx_id) override;
+  Trx *create_trx(LogHandler &log_handler, TrxID trx_id) override;
   void destroy_trx(Trx *trx) override;
 
   void all_trxes(vector<Trx *> &trxes) override;
@@ -40,24 +57,104 @@ public:
   LogReplayer *create_log_replayer(Db &db, LogHandler &log_handler) override;
 
 public:
-  int32_t next_trx_id();
+  TrxID next_trx_id();
+
+  /**
+   * @brief 回放日志时使用，保证之后分配的事务ID比日志中出现过的都大
+   */
+  void update_trx_id(TrxID trx_id);
 
 public:
-  int32_t max_trx_id() const;
+  TrxID max_trx_id() const;
+
+  MvccVersionStore   &version_store() { return version_store_; }
+  MvccActiveTrxTable &active_trxes() { return active_trxes_; }
+  RowLockManager     &lock_manager() { return lock_manager_; }
+
+  /**
+   * @brief 开始一个事务：分配事务ID并创建读视图
+   * @param slot 事务在活跃事务表中的槽位
+   * @return 事务ID
+   */
+  TrxID begin_trx(int slot, MvccReadView &read_view);
+
+  /**
+   * @brief 开始提交：分配提交ID，并在活跃事务表中公开，在 end_commit 之前其它事务的读视图都看不到这次提交
+   */
+  TrxID begin_commit(int slot);
+
+  /**
+   * @brief 事务提交或回滚结束，从活跃事务表中清除它的读视图和提交ID
+   */
+  void end_trx(int slot);
+
+  /**
+   * @brief 当前最老的活跃事务ID
+   * @details 提交ID比它小的事务覆盖或删除的版本，已经没有事务能够看到了
+   */
+  TrxID oldest_active_trx_id();
+
+  /**
+   * @brief 执行一轮垃圾回收
+   * @param purged_count 返回回收的旧版本和删除记录的个数
+   */
+  RC vacuum(int &purged_count);
+
+  /**
+   * @brief 事务结束时调用，非 CONCURRENCY 模式下每隔一些事务执行一次垃圾回收
+   */
+  void on_trx_end();
 
 private:
+  /**
+   * @brief 回收的事务对象
+   * @details 每个线程固定使用其中一个，线程数不超过 FREE_LIST_NUM 时相当于每个线程一个空闲列表，锁上没有竞争
+   */
+  struct alignas(64) TrxFreeList
+  {
+    mutex             lock;
+    vector<MvccTrx *> trxes;
+  };
+
+  TrxFreeList &local_free_list();
+
+  void vacuum_thread_func();
+  RC   purge_versions(TrxID oldest_trx_id, int &purged_count);
+  RC   purge_deleted_records(TrxID oldest_trx_id, int &purged_count);
+
+private:
+  static constexpr int VACUUM_INTERVAL_MS  = 1000;  ///< 后台垃圾回收的间隔
+  static constexpr int VACUUM_TRX_INTERVAL = 64;    ///< 非 CONCURRENCY 模式下每结束多少个事务回收一次
+  static constexpr int FREE_LIST_NUM       = 64;    ///< 空闲列表的个数
+  static constexpr int MAX_FREE_TRX_NUM    = 16;    ///< 每个空闲列表最多保留多少个事务对象
+
+  Db *db_ = nullptr;
+
   vector<FieldMeta> fields_;  // 存储事务数据需要用到的字段元数据，所有表结构都需要带的
 
-  atomic<int32_t> current_trx_id_{0};
+  atomic<TrxID> current_trx_id_{0};
+
+  TrxFreeList free_lists_[FREE_LIST_NUM];
+
+  MvccActiveTrxTable active_trxes_;  ///< 活跃事务，代替加锁的事务列表
+  RowLockManager     lock_manager_;  ///< 写事务之间的行锁
+
+  MvccVersionStore version_store_;  ///< 记录的旧版本
 
-  common::Mutex lock_;
-  vector<Trx *> trxes_;
+  mutex              vacuum_lock_;  ///< 保护 vacuum_stopped_
+  condition_variable vacuum_cond_;
+  bool               vacuum_stopped_ = false;
+  unique_ptr<thread> vacuum_thread_;  ///< 后台垃圾回收线程，仅在 CONCURRENCY 模式下启动
+  int                ended_trx_count_ = 0;
 };
 
 /**
  * @brief 多版本并发事务
  * @ingroup Transaction
- * TODO 没有垃圾回收
+ * @details 堆表中保存最新的版本，更新时把旧版本放到 MvccVersionStore 中，
+ * 读取时如果最新版本不可见，就沿着版本链找到当前事务可见的旧版本。
+ * 一个版本是否可见由事务开始时创建的读视图(MvccReadView)决定。
+ * 修改和删除记录之前先加行锁，与其它写事务冲突时等待，拿到锁之后修改最新提交的版本(当前读)。
  */
 class MvccTrx : public Trx
 {
@@ -68,7 +165,7 @@ public:
    * 创建事务时，TrxKit会有一些内部信息需要记录
    */
   MvccTrx(MvccTrxKit &trx_kit, LogHandler &log_handler);
-  MvccTrx(MvccTrxKit &trx_kit, LogHandler &log_handler, int32_t trx_id);  // used for recover
+  MvccTrx(MvccTrxKit &trx_kit, LogHandler &log_handler, TrxID trx_id);  // used for recover
   virtual ~MvccTrx();
 
   RC insert_record(Table *table, Record &record) override;
@@ -93,14 +190,54 @@ public:
 
   RC redo(Db *db, const LogEntry &log_entry) override;
 
-  int32_t id() const override { return trx_id_; }
+  TrxID id() const override { return trx_id_; }
+
+  /**
+   * @brief 事务是否已经开始并且还没有结束
+   */
+  bool started() const { return started_; }
+
+  /**
+   * @brief 事务在活跃事务表中的槽位
+   */
+  int  slot() const { return slot_; }
+  void set_slot(int slot) { slot_ = slot; }
+
+  const MvccReadView &read_view() const { return read_view_; }
+
+  LogHandler &log_handler() const { return log_handler_.log_handler(); }
+
+  /**
+   * @brief 事务对象放回空闲列表之前，清除上一个事务的状态
+   * @details 保留槽位编号，复用时优先尝试这个槽位
+   * @return 事务还没有结束或者是恢复出来的事务时不能复用，返回 false
+   */
+  bool reset();
 
 private:
-  RC   commit_with_trx_id(int32_t commit_id);
+  RC   commit_with_trx_id(TrxID commit_id);
+  RC   rollback_update(const Operation &operation);
+  void commit_versions(const Operation &operation, TrxID commit_xid);
   void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
 
+  /**
+   * @brief 根据某个版本的 begin/end xid 判断它对当前事务的读视图是否可见
+   */
+  RC check_visibility(TrxID begin_xid, TrxID end_xid) const;
+
+  /**
+   * @brief 持有行锁之后，判断最新版本是否可以修改
+   */
+  RC check_writable(TrxID begin_xid, TrxID end_xid) const;
+
+  /**
+   * @brief 修改记录之前加行锁，锁被其它事务持有时等待
+   */
+  RC   lock_row(Table *table, const RID &rid);
+  void unlock_rows();
+
 private:
-  static const int32_t MAX_TRX_ID = numeric_limits<int32_t>::max();
+  static const TrxID MAX_TRX_ID = numeric_limits<TrxID>::max();
 
 private:
   // using OperationSet = unordered_set<Operation, OperationHasher, OperationEqualer>;
@@ -108,8 +245,12 @@ private:
 
   MvccTrxKit       &trx_kit_;
   MvccTrxLogHandler log_handler_;
-  int32_t           trx_id_     = -1;
+  TrxID             trx_id_     = -1;
+  int               slot_       = -1;
+  MvccReadView      read_view_;  ///< 事务开始时创建的快照，整个事务期间不变
   bool              started_    = false;
   bool              recovering_ = false;
   OperationSet      operations_;
+
+  vector<MvccRecordKey> locked_rows_;  ///< 持有的行锁，事务结束时释放
 };
@@ -31,6 +31,7 @@ string MvccTrxLogOperation::to_string() const
     case Type::DELETE_RECORD: return ret + "DELETE_RECORD";
     case Type::COMMIT: return ret + "COMMIT";
     case Type::ROLLBACK: return ret + "ROLLBACK";
+    case Type::UPDATE_RECORD: return ret + "UPDATE_RECORD";
     default: return ret + "UNKNOWN";
   }
 }
@@ -53,6 +54,15 @@ string MvccTrxRecordLogEntry::to_string() const
   return ss.str();
 }
 
+const int32_t MvccTrxUpdateLogEntry::SIZE = sizeof(MvccTrxUpdateLogEntry);
+
+string MvccTrxUpdateLogEntry::to_string() const
+{
+  stringstream ss;
+  ss << record.to_string() << ", data_len: " << data_len;
+  return ss.str();
+}
+
 const int32_t MvccTrxCommitLogEntry::SIZE = sizeof(MvccTrxCommitLogEntry);
 
 string MvccTrxCommitLogEntry::to_string() const
@@ -68,9 +78,9 @@ MvccTrxLogHandler::MvccTrxLogHandler(LogHandler &log_handler) : log_handler_(log
 
 MvccTrxLogHandler::~MvccTrxLogHandler() {}
 
-RC MvccTrxLogHandler::insert_record(int32_t trx_id, Table *table, const RID &rid)
+RC MvccTrxLogHandler::insert_record(TrxID trx_id, Table *table, const RID &rid)
 {
-  ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
+  ASSERT(trx_id > 0, "invalid trx_id:%ld", trx_id);
 
   MvccTrxRecordLogEntry log_entry;
   log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::INSERT_RECORD).index();
@@ -83,9 +93,9 @@ RC MvccTrxLogHandler::insert_record(int32_t trx_id, Table *table, const RID &rid
       lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
 }
 
-RC MvccTrxLogHandler::delete_record(int32_t trx_id, Table *table, const RID &rid)
+RC MvccTrxLogHandler::delete_record(TrxID trx_id, Table *table, const RID &rid)
 {
-  ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
+  ASSERT(trx_id > 0, "invalid trx_id:%ld", trx_id);
 
   MvccTrxRecordLogEntry log_entry;
   log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::DELETE_RECORD).index();
@@ -98,9 +108,27 @@ RC MvccTrxLogHandler::delete_record(int32_t trx_id, Table *table, const RID &rid
       lsn, LogModule::Id::TRANSACTION, span<const char>(reinterpret_cast<const char *>(&log_entry), sizeof(log_entry)));
 }
 
-RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
+RC MvccTrxLogHandler::update_record(TrxID trx_id, Table *table, const Record &old_version)
+{
+  ASSERT(trx_id > 0, "invalid trx_id:%ld", trx_id);
+
+  vector<char> buffer(MvccTrxUpdateLogEntry::SIZE + old_version.len());
+  auto *log_entry = reinterpret_cast<MvccTrxUpdateLogEntry *>(buffer.data());
+
+  log_entry->record.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::UPDATE_RECORD).index();
+  log_entry->record.header.trx_id         = trx_id;
+  log_entry->record.table_id              = table->table_id();
+  log_entry->record.rid                   = old_version.rid();
+  log_entry->data_len                     = old_version.len();
+  memcpy(buffer.data() + MvccTrxUpdateLogEntry::SIZE, old_version.data(), old_version.len());
+
+  LSN lsn = 0;
+  return log_handler_.append(lsn, LogModule::Id::TRANSACTION, std::move(buffer));
+}
+
+RC MvccTrxLogHandler::commit(TrxID trx_id, TrxID commit_trx_id)
 {
-  ASSERT(trx_id > 0 && commit_trx_id > trx_id, "invalid trx_id:%d, commit_trx_id:%d", trx_id, commit_trx_id);
+  ASSERT(trx_id > 0 && commit_trx_id > trx_id, "invalid trx_id:%ld, commit_trx_id:%ld", trx_id, commit_trx_id);
 
   MvccTrxCommitLogEntry log_entry;
   log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::COMMIT).index();
@@ -119,9 +147,9 @@ RC MvccTrxLogHandler::commit(int32_t trx_id, int32_t commit_trx_id)
   return log_handler_.wait_lsn(lsn);
 }
 
-RC MvccTrxLogHandler::rollback(int32_t trx_id)
+RC MvccTrxLogHandler::rollback(TrxID trx_id)
 {
-  ASSERT(trx_id > 0, "invalid trx_id:%d", trx_id);
+  ASSERT(trx_id > 0, "invalid trx_id:%ld", trx_id);
 
   MvccTrxCommitLogEntry log_entry;
   log_entry.header.operation_type = MvccTrxLogOperation(MvccTrxLogOperation::Type::ROLLBACK).index();
@@ -155,7 +183,7 @@ RC MvccTrxLogReplayer::replay(const LogEntry &entry)
   auto trx_iter = trx_map_.find(header->trx_id);
   if (trx_iter == trx_map_.end()) {
     trx = static_cast<MvccTrx *>(trx_kit_.create_trx(log_handler_, header->trx_id));
-    // trx = new MvccTrx(trx_kit_, log_handler_, header->trx_id);
+    trx_map_.emplace(header->trx_id, trx);
   } else {
     trx = trx_iter->second;
   }
@@ -180,7 +208,7 @@ RC MvccTrxLogReplayer::on_done()
   for (auto &pair : trx_map_) {
     MvccTrx *trx = pair.second;
     trx->rollback(); // 恢复时的rollback，可能遇到之前已经回滚一半的事务又再次调用回滚的情况
-    delete pair.second;
+    trx_kit_.destroy_trx(trx);
   }
   trx_map_.clear();
 
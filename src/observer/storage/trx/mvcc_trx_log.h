@@ -40,7 +40,8 @@ public:
     INSERT_RECORD,  ///< 插入一条记录
     DELETE_RECORD,  ///< 删除一条记录
     COMMIT,         ///< 提交事务
-    ROLLBACK        ///< 回滚事务
+    ROLLBACK,       ///< 回滚事务
+    UPDATE_RECORD,  ///< 更新一条记录
   };
 
 public:
@@ -64,7 +65,7 @@ private:
 struct MvccTrxLogHeader
 {
   int32_t operation_type;  ///< 操作类型
-  int32_t trx_id;          ///< 事务ID
+  TrxID   trx_id;          ///< 事务ID
 
   static const int32_t SIZE;  ///< 头部大小
 
@@ -87,6 +88,24 @@ struct MvccTrxRecordLogEntry
   string to_string() const;
 };
 
+/**
+ * @brief 表示事务日志中更新行数据的日志
+ * @ingroup CLog
+ * @details 日志后面紧跟着更新前的整行数据(旧版本)，恢复时用来回滚没有提交的更新。
+ * 新的数据已经记录在数据页面的日志中了。
+ */
+struct MvccTrxUpdateLogEntry
+{
+  MvccTrxRecordLogEntry record;    ///< 表ID和记录ID
+  int32_t               data_len;  ///< 旧版本数据的长度
+
+  static const int32_t SIZE;  ///< 不包含旧版本数据的日志大小
+
+  const char *data() const { return reinterpret_cast<const char *>(this) + SIZE; }
+
+  string to_string() const;
+};
+
 /**
  * @brief 事务提交的日志
  * @ingroup CLog
@@ -95,7 +114,7 @@ struct MvccTrxRecordLogEntry
 struct MvccTrxCommitLogEntry
 {
   MvccTrxLogHeader header;         ///< 日志头部
-  int32_t          commit_trx_id;  ///< 提交的事务ID
+  TrxID            commit_trx_id;  ///< 提交的事务ID
 
   static const int32_t SIZE;
 
@@ -115,24 +134,32 @@ public:
   /**
    * @brief 记录插入一条记录的日志
    */
-  RC insert_record(int32_t trx_id, Table *table, const RID &rid);
+  RC insert_record(TrxID trx_id, Table *table, const RID &rid);
 
   /**
    * @brief 记录删除一条记录的日志
    */
-  RC delete_record(int32_t trx_id, Table *table, const RID &rid);
+  RC delete_record(TrxID trx_id, Table *table, const RID &rid);
+
+  /**
+   * @brief 记录更新一条记录的日志
+   * @param old_version 更新前的整行数据
+   */
+  RC update_record(TrxID trx_id, Table *table, const Record &old_version);
 
   /**
    * @brief 记录提交事务的日志
    * @details 会等待日志落地
    */
-  RC commit(int32_t trx_id, int32_t commit_trx_id);
+  RC commit(TrxID trx_id, TrxID commit_trx_id);
 
   /**
    * @brief 记录回滚事务的日志
    * @details 不会等待日志落地
    */
-  RC rollback(int32_t trx_id);
+  RC rollback(TrxID trx_id);
+
+  LogHandler &log_handler() const { return log_handler_; }
 
 private:
   LogHandler &log_handler_;
@@ -160,5 +187,5 @@ private:
   LogHandler &log_handler_;  ///< 日志处理器
 
   ///< 事务ID到事务的映射。在重做结束后，如果还有未提交的事务，需要回滚。
-  unordered_map<int32_t, MvccTrx *> trx_map_;
+  unordered_map<TrxID, MvccTrx *> trx_map_;
 };
@@ -0,0 +1,119 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/mvcc_version_store.h"
+
+using namespace common;
+
+void MvccVersionStore::push(int32_t table_id, const Record &version)
+{
+  Shard     &shard = this->shard(table_id, version.rid());
+  lock_guard guard(shard.lock);
+  shard.chains[MvccRecordKey{table_id, version.rid()}].push_back(version);
+  version_count_++;
+}
+
+RC MvccVersionStore::pop(int32_t table_id, const RID &rid, Record &version)
+{
+  Shard     &shard = this->shard(table_id, rid);
+  lock_guard guard(shard.lock);
+  auto iter = shard.chains.find(MvccRecordKey{table_id, rid});
+  if (iter == shard.chains.end()) {
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  VersionChain &chain = iter->second;
+  version             = std::move(chain.back());
+  chain.pop_back();
+  version_count_--;
+  if (chain.empty()) {
+    shard.chains.erase(iter);
+  }
+  return RC::SUCCESS;
+}
+
+bool MvccVersionStore::visit(int32_t table_id, const RID &rid, const function<bool(Record &)> &visitor)
+{
+  Shard     &shard = this->shard(table_id, rid);
+  lock_guard guard(shard.lock);
+  auto iter = shard.chains.find(MvccRecordKey{table_id, rid});
+  if (iter == shard.chains.end()) {
+    return false;
+  }
+
+  VersionChain &chain = iter->second;
+  for (auto version_iter = chain.rbegin(); version_iter != chain.rend(); ++version_iter) {
+    if (!visitor(*version_iter)) {
+      break;
+    }
+  }
+  return true;
+}
+
+void MvccVersionStore::remove(int32_t table_id, const RID &rid)
+{
+  Shard     &shard = this->shard(table_id, rid);
+  lock_guard guard(shard.lock);
+  auto iter = shard.chains.find(MvccRecordKey{table_id, rid});
+  if (iter != shard.chains.end()) {
+    version_count_ -= iter->second.size();
+    shard.chains.erase(iter);
+  }
+}
+
+void MvccVersionStore::table_ids(unordered_set<int32_t> &table_ids) const
+{
+  for (const Shard &shard : shards_) {
+    lock_guard guard(shard.lock);
+    for (const auto &[key, chain] : shard.chains) {
+      table_ids.insert(key.table_id);
+    }
+  }
+}
+
+void MvccVersionStore::purge(
+    const function<bool(int32_t table_id, const Record &)> &is_dead, vector<PurgedVersion> &purged)
+{
+  for (Shard &shard : shards_) {
+    lock_guard guard(shard.lock);
+    for (auto iter = shard.chains.begin(); iter != shard.chains.end();) {
+      const MvccRecordKey &key   = iter->first;
+      VersionChain        &chain = iter->second;
+      while (!chain.empty() && is_dead(key.table_id, chain.front())) {
+        purged.push_back(PurgedVersion{key, std::move(chain.front())});
+        chain.pop_front();
+        version_count_--;
+      }
+
+      if (chain.empty()) {
+        iter = shard.chains.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+}
+
+void MvccVersionStore::add_deleted(int32_t table_id, const RID &rid, TrxID commit_xid)
+{
+  lock_guard guard(deleted_lock_);
+  deleted_records_.push_back(DeletedRecord{MvccRecordKey{table_id, rid}, commit_xid});
+}
+
+void MvccVersionStore::take_deleted(TrxID oldest_xid, vector<DeletedRecord> &deleted)
+{
+  lock_guard guard(deleted_lock_);
+  while (!deleted_records_.empty() && deleted_records_.front().commit_xid < oldest_xid) {
+    deleted.push_back(deleted_records_.front());
+    deleted_records_.pop_front();
+  }
+}
+
+int64_t MvccVersionStore::version_count() const { return version_count_.load(); }
@@ -0,0 +1,157 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/sys/rc.h"
+#include "common/lang/atomic.h"
+#include "common/lang/deque.h"
+#include "common/lang/functional.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
+#include "storage/record/record.h"
+
+/**
+ * @brief 标识一条记录，由表ID和RID组成
+ * @ingroup Transaction
+ */
+struct MvccRecordKey
+{
+  int32_t table_id;
+  RID     rid;
+
+  bool operator==(const MvccRecordKey &other) const { return table_id == other.table_id && rid == other.rid; }
+};
+
+struct MvccRecordKeyHash
+{
+  size_t operator()(const MvccRecordKey &key) const noexcept
+  {
+    return hash<int32_t>()(key.table_id) ^ (RIDHash()(key.rid) << 1);
+  }
+};
+
+/**
+ * @brief 多版本事务的旧版本存储区(undo)
+ * @ingroup Transaction
+ * @details 最新的版本总是保存在堆表中，更新时把旧的数据整行复制到这里，串成一个从新到旧的版本链。
+ * 旧版本的数据包含事务字段：begin xid 是产生这个版本的事务，end xid 是覆盖这个版本的事务，
+ * 覆盖它的事务没有提交时 end xid 是该事务ID的相反数，提交后是提交ID。
+ * 这样判断旧版本是否可见的规则和堆表中的记录完全一致。
+ * 版本存储区只在内存中，重启后不需要旧版本(重启时没有活跃的读事务)，只有恢复时未结束的事务
+ * 会根据事务日志重新放回旧版本，用来回滚。
+ * 另外也记录已经提交删除的记录，由后台的垃圾回收从堆表中物理删除。这个列表也只在内存中，重启时不会重建，
+ * 重启前已经提交删除、还没有回收的记录会一直留在堆表和索引中，对所有事务都不可见，只是占用空间。
+ *
+ * 版本链按照记录分成多个分片，每个分片有自己的锁，读写不同记录的版本链时不会互相等待，
+ * 垃圾回收一次也只锁住一个分片。
+ */
+class MvccVersionStore
+{
+public:
+  /**
+   * @brief 被回收的旧版本
+   */
+  struct PurgedVersion
+  {
+    MvccRecordKey key;
+    Record        version;
+  };
+
+  /**
+   * @brief 已经提交删除的记录
+   */
+  struct DeletedRecord
+  {
+    MvccRecordKey key;
+    TrxID         commit_xid;  ///< 删除记录的事务提交ID
+  };
+
+public:
+  MvccVersionStore()  = default;
+  ~MvccVersionStore() = default;
+
+  /**
+   * @brief 把一个旧版本放到版本链的最前面
+   */
+  void push(int32_t table_id, const Record &version);
+
+  /**
+   * @brief 从版本链中取出最新的旧版本，回滚时使用
+   * @return RC::RECORD_NOT_EXIST 没有旧版本
+   */
+  RC pop(int32_t table_id, const RID &rid, Record &version);
+
+  /**
+   * @brief 从新到旧遍历某条记录的旧版本
+   * @details visitor 返回 false 时停止遍历。遍历时持有锁，visitor 中不要再访问版本存储区
+   * @return 这条记录是否有旧版本
+   */
+  bool visit(int32_t table_id, const RID &rid, const function<bool(Record &)> &visitor);
+
+  /**
+   * @brief 删除某条记录的所有旧版本
+   * @details 记录被物理删除后 RID 会被复用，需要把残留的版本都清理掉
+   */
+  void remove(int32_t table_id, const RID &rid);
+
+  /**
+   * @brief 返回所有有旧版本的表
+   * @details 垃圾回收时先在锁外找到这些表，purge 中判断版本是否可以回收时不需要再查找表
+   */
+  void table_ids(unordered_set<int32_t> &table_ids) const;
+
+  /**
+   * @brief 回收所有不再需要的旧版本
+   * @details 版本链从新到旧排列，覆盖这些版本的事务的提交ID也是递减的，
+   * 所以只需要从最旧的版本开始回收。每次只锁住一个分片，is_dead 在锁内调用，不能访问版本存储区或者查找表
+   * @param is_dead 判断一个旧版本是否已经没有事务能够看到
+   * @param purged  返回被回收的版本，调用者需要清理它们在索引中的数据
+   */
+  void purge(const function<bool(int32_t table_id, const Record &)> &is_dead, vector<PurgedVersion> &purged);
+
+  /**
+   * @brief 记录一条已经提交删除的记录
+   */
+  void add_deleted(int32_t table_id, const RID &rid, TrxID commit_xid);
+
+  /**
+   * @brief 取出所有删除事务提交ID小于 oldest_xid 的记录
+   * @details 删除记录的提交ID是递增的，只需要从前往后取
+   */
+  void take_deleted(TrxID oldest_xid, vector<DeletedRecord> &deleted);
+
+  /**
+   * @brief 当前一共保存了多少个旧版本
+   */
+  int64_t version_count() const;
+
+private:
+  using VersionChain = deque<Record>;  ///< 从旧到新排列，back 是最新的旧版本
+
+  struct Shard
+  {
+    mutable common::Mutex                                          lock;
+    unordered_map<MvccRecordKey, VersionChain, MvccRecordKeyHash> chains;
+  };
+
+  static constexpr int SHARD_NUM = 16;
+
+  Shard &shard(int32_t table_id, const RID &rid) { return shards_[MvccRecordKeyHash()({table_id, rid}) % SHARD_NUM]; }
+
+private:
+  Shard                 shards_[SHARD_NUM];
+  atomic<int64_t>       version_count_{0};
+  mutable common::Mutex deleted_lock_;
+  deque<DeletedRecord>  deleted_records_;
+};
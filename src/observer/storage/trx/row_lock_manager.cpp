@@ -0,0 +1,160 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/trx/row_lock_manager.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/log/log.h"
+
+RC RowLockManager::lock(TrxID trx_id, const MvccRecordKey &key, int timeout_ms)
+{
+  Bucket            &bkt = bucket(key);
+  unique_lock<mutex> guard(bkt.lock);
+
+  LockEntry &entry = bkt.entries[key];
+  if (entry.owner == 0 || entry.owner == trx_id) {
+    entry.owner = trx_id;
+    lock_count_++;
+    return RC::SUCCESS;
+  }
+
+  if (timeout_ms <= 0) {
+    timeout_count_++;
+    LOG_TRACE("row is locked by others and no wait. trx id=%ld, owner=%ld, rid=%s",
+              trx_id, entry.owner, key.rid.to_string().c_str());
+    return RC::LOCKED_WAIT_TIMEOUT;
+  }
+
+  if (add_wait_edge(trx_id, entry.owner)) {
+    deadlock_count_++;
+    LOG_INFO("deadlock detected. trx id=%ld, owner=%ld, table id=%d, rid=%s",
+             trx_id, entry.owner, key.table_id, key.rid.to_string().c_str());
+    return RC::LOCKED_DEADLOCK;
+  }
+
+  wait_count_++;
+  int64_t &wait_count = bkt.wait_counts[key];
+  wait_count++;
+  if (bkt.wait_counts.size() > MAX_HOT_ROWS_PER_BUCKET) {
+    // 热点行只是统计信息，太多时丢掉等待次数最少的那些
+    auto coldest = min_element(bkt.wait_counts.begin(), bkt.wait_counts.end(),
+        [](const auto &left, const auto &right) { return left.second < right.second; });
+    bkt.wait_counts.erase(coldest);
+  }
+
+  entry.waiters.push_back(trx_id);
+
+  // 锁释放时由 unlock_all 直接交给队首的事务，并把其它等待者的等待关系指向新的持有者
+  const auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+  bool       granted  = bkt.cond.wait_until(guard, deadline, [&bkt, &key, trx_id] {
+    return bkt.entries[key].owner == trx_id;
+  });
+
+  remove_wait_edge(trx_id);
+  if (granted) {
+    lock_count_++;
+    return RC::SUCCESS;
+  }
+
+  LockEntry &timeout_entry = bkt.entries[key];
+  auto       iter          = find(timeout_entry.waiters.begin(), timeout_entry.waiters.end(), trx_id);
+  if (iter != timeout_entry.waiters.end()) {
+    timeout_entry.waiters.erase(iter);
+  }
+  timeout_count_++;
+  LOG_INFO("lock wait timeout. trx id=%ld, owner=%ld, table id=%d, rid=%s, timeout=%dms",
+           trx_id, timeout_entry.owner, key.table_id, key.rid.to_string().c_str(), timeout_ms);
+  return RC::LOCKED_WAIT_TIMEOUT;
+}
+
+void RowLockManager::unlock_all(TrxID trx_id, const vector<MvccRecordKey> &keys)
+{
+  for (const MvccRecordKey &key : keys) {
+    Bucket          &bkt = bucket(key);
+    lock_guard<mutex> guard(bkt.lock);
+
+    auto iter = bkt.entries.find(key);
+    if (iter == bkt.entries.end() || iter->second.owner != trx_id) {
+      continue;
+    }
+
+    LockEntry &entry = iter->second;
+    if (entry.waiters.empty()) {
+      bkt.entries.erase(iter);
+      continue;
+    }
+
+    entry.owner = entry.waiters.front();
+    entry.waiters.pop_front();
+    {
+      lock_guard<mutex> graph_guard(graph_lock_);
+      for (TrxID waiter : entry.waiters) {
+        waits_for_[waiter] = entry.owner;
+      }
+    }
+    bkt.cond.notify_all();
+  }
+}
+
+bool RowLockManager::add_wait_edge(TrxID waiter, TrxID holder)
+{
+  lock_guard<mutex> guard(graph_lock_);
+
+  // 每个事务最多等待一个事务，沿着等待关系走，最多走过所有等待的事务
+  TrxID current = holder;
+  for (size_t step = 0; step <= waits_for_.size(); step++) {
+    if (current == waiter) {
+      return true;
+    }
+
+    auto iter = waits_for_.find(current);
+    if (iter == waits_for_.end()) {
+      break;
+    }
+    current = iter->second;
+  }
+
+  waits_for_[waiter] = holder;
+  return false;
+}
+
+void RowLockManager::remove_wait_edge(TrxID waiter)
+{
+  lock_guard<mutex> guard(graph_lock_);
+  waits_for_.erase(waiter);
+}
+
+void RowLockManager::hot_rows(int top_n, vector<HotRow> &rows) const
+{
+  rows.clear();
+  for (const Bucket &bkt : buckets_) {
+    lock_guard<mutex> guard(bkt.lock);
+    for (const auto &[key, wait_count] : bkt.wait_counts) {
+      rows.push_back(HotRow{key, wait_count});
+    }
+  }
+
+  sort(rows.begin(), rows.end(), [](const HotRow &left, const HotRow &right) {
+    return left.wait_count > right.wait_count;
+  });
+  if (static_cast<int>(rows.size()) > top_n) {
+    rows.resize(top_n);
+  }
+}
+
+RowLockManager::Stats RowLockManager::stats() const
+{
+  Stats stats;
+  stats.lock_count     = lock_count_.load();
+  stats.wait_count     = wait_count_.load();
+  stats.deadlock_count = deadlock_count_.load();
+  stats.timeout_count  = timeout_count_.load();
+  return stats;
+}
@@ -0,0 +1,125 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/sys/rc.h"
+#include "common/lang/atomic.h"
+#include "common/lang/condition_variable.h"
+#include "common/lang/deque.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/utility.h"
+#include "common/lang/vector.h"
+#include "storage/trx/mvcc_version_store.h"
+
+/**
+ * @brief 行锁管理器
+ * @ingroup Transaction
+ * @details 写事务修改一条记录之前先对它加排他锁，锁被其它事务持有时排队等待，而不是直接报冲突。
+ * 锁按照记录(表ID+RID)散列到多个桶中，每个桶有自己的互斥量和条件变量，不同的记录之间基本没有竞争。
+ * 锁释放时按照先来后到直接交给队列中的第一个等待者。
+ *
+ * 死锁检测使用等待图(waits-for graph)：只有排他锁，所以每个等待的事务只会等待一个事务，
+ * 从当前事务沿着等待关系走下去，如果回到了自己就说明有死锁，由当前请求锁的事务报错并回滚。
+ * 等待图只在发生等待时才会访问。
+ *
+ * 加锁时不能持有页面锁(latch)：等待的事务持有页面锁的话，持有行锁的事务提交时拿不到页面锁，会形成无法检测的死锁。
+ */
+class RowLockManager
+{
+public:
+  static constexpr int BUCKET_NUM = 64;
+
+  /**
+   * @brief 热点行，按照等锁的次数排序
+   */
+  struct HotRow
+  {
+    MvccRecordKey key;
+    int64_t       wait_count = 0;
+  };
+
+  /**
+   * @brief 行锁的统计信息
+   */
+  struct Stats
+  {
+    int64_t lock_count     = 0;  ///< 成功加锁的次数
+    int64_t wait_count     = 0;  ///< 需要等待的次数
+    int64_t deadlock_count = 0;  ///< 检测到死锁的次数
+    int64_t timeout_count  = 0;  ///< 等锁超时的次数
+  };
+
+public:
+  RowLockManager()  = default;
+  ~RowLockManager() = default;
+
+  /**
+   * @brief 给一条记录加排他锁
+   * @param trx_id     加锁的事务
+   * @param key        要加锁的记录
+   * @param timeout_ms 最长等待的时间，0 表示不等待
+   * @return RC        - SUCCESS 加锁成功，包括当前事务已经持有这个锁
+   *                   - LOCKED_DEADLOCK 等待会造成死锁
+   *                   - LOCKED_WAIT_TIMEOUT 等锁超时
+   */
+  RC lock(TrxID trx_id, const MvccRecordKey &key, int timeout_ms);
+
+  /**
+   * @brief 事务结束时释放它持有的锁
+   * @details keys 中可能有重复的记录，也可能有不是这个事务持有的锁，都会跳过
+   */
+  void unlock_all(TrxID trx_id, const vector<MvccRecordKey> &keys);
+
+  /**
+   * @brief 等锁次数最多的 top_n 条记录
+   */
+  void hot_rows(int top_n, vector<HotRow> &rows) const;
+
+  Stats stats() const;
+
+private:
+  struct LockEntry
+  {
+    TrxID        owner = 0;
+    deque<TrxID> waiters;  ///< 按照先来后到排队的事务
+  };
+
+  struct Bucket
+  {
+    mutable mutex                                              lock;
+    condition_variable                                         cond;
+    unordered_map<MvccRecordKey, LockEntry, MvccRecordKeyHash> entries;
+    unordered_map<MvccRecordKey, int64_t, MvccRecordKeyHash>   wait_counts;  ///< 热点行计数
+  };
+
+  Bucket &bucket(const MvccRecordKey &key) { return buckets_[MvccRecordKeyHash()(key) % BUCKET_NUM]; }
+
+  /**
+   * @brief 在等待图中记录 waiter 等待 holder，并检查是否形成环
+   * @return 是否有死锁，有死锁时不会留下等待关系
+   */
+  bool add_wait_edge(TrxID waiter, TrxID holder);
+  void remove_wait_edge(TrxID waiter);
+
+private:
+  static constexpr size_t MAX_HOT_ROWS_PER_BUCKET = 1024;  ///< 每个桶最多记录多少个热点行
+
+  Bucket buckets_[BUCKET_NUM];
+
+  mutex                       graph_lock_;  ///< 保护等待图，加锁顺序在桶锁之后
+  unordered_map<TrxID, TrxID> waits_for_;   ///< 等待的事务 -> 持有锁的事务
+
+  atomic<int64_t> lock_count_{0};
+  atomic<int64_t> wait_count_{0};
+  atomic<int64_t> deadlock_count_{0};
+  atomic<int64_t> timeout_count_{0};
+};
@@ -122,8 +122,8 @@ public:
   /**
    * @brief 创建一个事务，日志回放时使用
    */
-  virtual Trx *create_trx(LogHandler &log_handler, int32_t trx_id) = 0;
-  virtual void all_trxes(vector<Trx *> &trxes)                     = 0;
+  virtual Trx *create_trx(LogHandler &log_handler, TrxID trx_id) = 0;
+  virtual void all_trxes(vector<Trx *> &trxes)                   = 0;
 
   virtual void destroy_trx(Trx *trx) = 0;
 
@@ -154,9 +154,19 @@ public:
 
   virtual RC redo(Db *db, const LogEntry &log_entry) = 0;
 
-  virtual int32_t id() const = 0;
-  TrxKit::Type    type() const { return type_; }
+  virtual TrxID id() const = 0;
+  TrxKit::Type  type() const { return type_; }
+
+  /**
+   * @brief 等待行锁的最长时间(毫秒)，0 表示不等待。只对需要加锁的事务有效
+   */
+  void set_lock_wait_timeout(int timeout_ms) { lock_wait_timeout_ms_ = timeout_ms; }
+  int  lock_wait_timeout() const { return lock_wait_timeout_ms_; }
+
+public:
+  static constexpr int DEFAULT_LOCK_WAIT_TIMEOUT_MS = 10000;
 
 private:
   TrxKit::Type type_;
+  int          lock_wait_timeout_ms_ = DEFAULT_LOCK_WAIT_TIMEOUT_MS;
 };
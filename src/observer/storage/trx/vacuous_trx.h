@@ -29,7 +29,7 @@ public:
   const vector<FieldMeta> *trx_fields() const override;
 
   Trx *create_trx(LogHandler &log_handler) override;
-  Trx *create_trx(LogHandler &log_handler, int32_t trx_id) override;
+  Trx *create_trx(LogHandler &log_handler, TrxID trx_id) override;
   void all_trxes(vector<Trx *> &trxes) override;
 
   void destroy_trx(Trx *trx) override;
@@ -53,7 +53,7 @@ public:
 
   RC redo(Db *db, const LogEntry &log_entry) override;
 
-  int32_t id() const override { return 0; }
+  TrxID id() const override { return 0; }
 };
 
 class VacuousTrxLogReplayer : public LogReplayer
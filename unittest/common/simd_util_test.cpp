@@ -0,0 +1,112 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <vector>
+
+#include "common/math/simd_util.h"
+#include "gtest/gtest.h"
+
+/// 依次使用当前机器支持的每个指令集执行 func
+template <typename Func>
+static void for_each_simd_level(Func func)
+{
+  const SimdLevel origin = simd_level();
+  for (int level = 0; level <= static_cast<int>(detect_simd_level()); level++) {
+    ASSERT_EQ(set_simd_level(static_cast<SimdLevel>(level)), static_cast<SimdLevel>(level));
+    SCOPED_TRACE(simd_level_name(simd_level()));
+    func();
+  }
+  set_simd_level(origin);
+}
+
+TEST(SimdUtilTest, level)
+{
+  const SimdLevel detected = detect_simd_level();
+  ASSERT_EQ(set_simd_level(SimdLevel::AVX512), detected);
+  ASSERT_EQ(simd_level(), detected);
+  ASSERT_EQ(set_simd_level(SimdLevel::SCALAR), SimdLevel::SCALAR);
+  ASSERT_EQ(simd_width(SimdLevel::SCALAR), 1);
+  ASSERT_EQ(simd_width(SimdLevel::AVX512), 16);
+  set_simd_level(detected);
+}
+
+TEST(SimdUtilTest, sum)
+{
+  for_each_simd_level([] {
+    for (int size : {0, 1, 7, 8, 15, 16, 17, 100, 1000}) {
+      std::vector<int>   ints(size);
+      std::vector<float> floats(size);
+      int                expect = 0;
+      for (int i = 0; i < size; i++) {
+        ints[i]   = i - 50;
+        floats[i] = (i - 50) * 0.5f;
+        expect += ints[i];
+      }
+      ASSERT_EQ(simd_sum_epi32(ints.data(), size), expect);
+      ASSERT_FLOAT_EQ(simd_sum_ps(floats.data(), size), expect * 0.5f);
+    }
+  });
+}
+
+TEST(SimdUtilTest, hash)
+{
+  for_each_simd_level([] {
+    const int             size = 37;
+    std::vector<int>      keys(size);
+    std::vector<uint32_t> hashes(size, 0);
+    for (int i = 0; i < size; i++) {
+      keys[i] = i * 7919 - 100;
+    }
+    simd_hash_epi32(keys.data(), size, hashes.data());
+    for (int i = 0; i < size; i++) {
+      ASSERT_EQ(hashes[i], simd_hash_epi32(keys[i]));
+    }
+  });
+}
+
+TEST(SimdUtilTest, selective_load)
+{
+  for_each_simd_level([] {
+    std::vector<int> memory = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    std::vector<int> vec(8, -1);
+    // 第 1、3、4 个位置读取新的值
+    int count = selective_load(memory.data(), 2, vec.data(), 0b11010, 8);
+    ASSERT_EQ(count, 3);
+    std::vector<int> expect = {-1, 12, -1, 13, 14, -1, -1, -1};
+    ASSERT_EQ(vec, expect);
+
+    // 超过 width 的位不读取
+    count = selective_load(memory.data(), 0, vec.data(), 0x1FF, 8);
+    ASSERT_EQ(count, 8);
+    ASSERT_EQ(vec[7], 17);
+  });
+}
+
+TEST(SimdUtilTest, match)
+{
+  for_each_simd_level([] {
+    std::vector<uint32_t> values(SIMD_MATCH_WIDTH, 0);
+    values[0]  = 7;
+    values[3]  = 9;
+    values[8]  = 7;
+    values[15] = 7;
+    uint32_t match_mask = 0;
+    uint32_t zero_mask  = 0;
+    simd_match_epi32(values.data(), 7, match_mask, zero_mask);
+    ASSERT_EQ(match_mask, (1U << 0) | (1U << 8) | (1U << 15));
+    ASSERT_EQ(zero_mask, 0xFFFFU & ~((1U << 0) | (1U << 3) | (1U << 8) | (1U << 15)));
+
+    // 最高位为 1 的值也要按照无符号数比较
+    values.assign(SIMD_MATCH_WIDTH, 0x80000001U);
+    simd_match_epi32(values.data(), 0x80000001U, match_mask, zero_mask);
+    ASSERT_EQ(match_mask, 0xFFFFU);
+    ASSERT_EQ(zero_mask, 0U);
+  });
+}
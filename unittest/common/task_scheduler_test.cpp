@@ -0,0 +1,103 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "common/lang/atomic.h"
+#include "common/lang/chrono.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/thread/task_scheduler.h"
+
+using namespace common;
+
+TEST(TaskScheduler, run_each_index_once)
+{
+  TaskScheduler scheduler(4);
+  for (int parallelism : {0, 1, 3, 4, 17}) {
+    vector<atomic<int>> counters(parallelism);
+    RC rc = scheduler.run(parallelism, [&counters](int index) {
+      counters[index].fetch_add(1);
+      return RC::SUCCESS;
+    });
+    ASSERT_EQ(RC::SUCCESS, rc);
+    for (int i = 0; i < parallelism; i++) {
+      ASSERT_EQ(1, counters[i].load());
+    }
+  }
+}
+
+TEST(TaskScheduler, first_failure)
+{
+  TaskScheduler scheduler(2);
+  RC rc = scheduler.run(8, [](int index) {
+    if (index == 5) {
+      return RC::IOERR_READ;
+    }
+    if (index == 3) {
+      return RC::NOMEM;
+    }
+    return RC::SUCCESS;
+  });
+  ASSERT_EQ(RC::NOMEM, rc);
+}
+
+TEST(TaskScheduler, nested)
+{
+  // 任务中再提交任务并等待，所有线程都在等待时也不会死锁
+  TaskScheduler scheduler(2);
+  atomic<int>   counter(0);
+  RC            rc = scheduler.run(4, [&scheduler, &counter](int) {
+    return scheduler.run(4, [&counter](int) {
+      counter.fetch_add(1);
+      return RC::SUCCESS;
+    });
+  });
+  ASSERT_EQ(RC::SUCCESS, rc);
+  ASSERT_EQ(16, counter.load());
+}
+
+TEST(TaskScheduler, submit_and_wait)
+{
+  TaskScheduler scheduler(2);
+  atomic<int>   counter(0);
+  auto          group = scheduler.submit(6, [&counter](int) {
+    this_thread::sleep_for(chrono::milliseconds(10));
+    counter.fetch_add(1);
+    return RC::SUCCESS;
+  });
+
+  // 调度器的线程在后台执行，等待的线程也会领取没有开始的任务
+  ASSERT_EQ(RC::SUCCESS, scheduler.wait(*group));
+  ASSERT_TRUE(group->done());
+  ASSERT_EQ(6, counter.load());
+  ASSERT_FALSE(group->run_one());
+}
+
+TEST(TaskScheduler, work_stealing)
+{
+  // 在调度器的线程中提交的任务都放在这个线程的队列中，其它线程窃取后并发执行
+  TaskScheduler scheduler(4);
+  atomic<int>   running(0);
+  atomic<int>   max_running(0);
+  RC            rc = scheduler.run(1, [&](int) {
+    auto group = scheduler.submit(8, [&](int) {
+      int now = running.fetch_add(1) + 1;
+      int old = max_running.load();
+      while (now > old && !max_running.compare_exchange_weak(old, now)) {
+      }
+      this_thread::sleep_for(chrono::milliseconds(20));
+      running.fetch_sub(1);
+      return RC::SUCCESS;
+    });
+    return scheduler.wait(*group);
+  });
+  ASSERT_EQ(RC::SUCCESS, rc);
+  ASSERT_GT(max_running.load(), 1);
+}
@@ -77,11 +77,55 @@ TEST_F(ObLsmTransactionTest, DISABLED_oblsm_test_basic1)
   ASSERT_TRUE(check_lsm_scan_result_by_value(iter_txn3, {"valuetxn1", "value2", "value3", "txnvaluex"}));
   delete iter_txn3;
 
+  // txn1 has committed key1 after txn2 began
+  ASSERT_EQ(txn2->commit(), RC::LOCKED_CONCURRENCY_CONFLICT);
+  string value;
+  ASSERT_EQ(db->get("key1", &value), RC::SUCCESS);
+  ASSERT_EQ(value, "valuetxn1");
+
   delete txn1;
   delete txn2;
   delete txn3;
 }
 
+TEST_F(ObLsmTransactionTest, DISABLED_oblsm_test_remove_and_get)
+{
+  db->put("key1", "value1");
+  db->put("key2", "value2");
+
+  auto   txn1 = db->begin_transaction();
+  string value;
+  ASSERT_EQ(txn1->remove("key1"), RC::SUCCESS);
+  ASSERT_EQ(txn1->put("key3", "value3"), RC::SUCCESS);
+  ASSERT_EQ(txn1->get("key1", &value), RC::NOT_EXIST);
+  ASSERT_EQ(txn1->get("key2", &value), RC::SUCCESS);
+  ASSERT_EQ(value, "value2");
+  ASSERT_EQ(db->get("key3", &value), RC::NOT_EXIST);
+
+  auto iter_txn1 = txn1->new_iterator(ObLsmReadOptions());
+  ASSERT_TRUE(check_lsm_scan_result_by_value(iter_txn1, {"value2", "value3"}));
+  delete iter_txn1;
+
+  // writes after txn1 began are invisible to it, and do not conflict with keys it does not write
+  db->put("key4", "value4");
+  ASSERT_EQ(txn1->get("key4", &value), RC::NOT_EXIST);
+  ASSERT_EQ(txn1->commit(), RC::SUCCESS);
+
+  ASSERT_EQ(db->get("key1", &value), RC::NOT_EXIST);
+  ASSERT_EQ(db->get("key3", &value), RC::SUCCESS);
+  ASSERT_EQ(value, "value3");
+
+  // the rolled back changes are never written
+  auto txn2 = db->begin_transaction();
+  txn2->put("key2", "valuetxn2");
+  ASSERT_EQ(txn2->rollback(), RC::SUCCESS);
+  ASSERT_EQ(db->get("key2", &value), RC::SUCCESS);
+  ASSERT_EQ(value, "value2");
+
+  delete txn1;
+  delete txn2;
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
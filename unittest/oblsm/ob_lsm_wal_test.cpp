@@ -53,6 +53,42 @@ TEST(wal, DISABLED_basic_test)
   EXPECT_EQ(p, count);
 }
 
+TEST(wal, DISABLED_torn_batch_test)
+{
+  filesystem::remove_all("oblsm_tmp");
+  filesystem::create_directory("oblsm_tmp");
+  auto path    = filesystem::path("oblsm_tmp");
+  auto rw_file = path / "tmp.wal";
+  WAL  wal;
+  EXPECT_EQ(wal.open(rw_file), RC::SUCCESS);
+
+  const int batch_size  = 10;
+  const int batch_count = 100;
+  for (auto i = 0; i < batch_count; ++i) {
+    std::vector<std::string> keys;
+    for (auto j = 0; j < batch_size; ++j) {
+      keys.push_back("key" + std::to_string(i * batch_size + j));
+    }
+    std::vector<std::pair<std::string_view, std::string_view>> kvs;
+    for (auto &k : keys) {
+      kvs.emplace_back(k, k);
+    }
+    EXPECT_EQ(wal.put_batch(i * batch_size, kvs), RC::SUCCESS);
+  }
+  EXPECT_EQ(wal.sync(), RC::SUCCESS);
+
+  // a crash in the middle of writing the last batch
+  filesystem::resize_file(rw_file, filesystem::file_size(rw_file) - 1);
+
+  std::vector<WalRecord> records;
+  EXPECT_EQ(wal.recover(rw_file, records), RC::SUCCESS);
+  ASSERT_EQ(records.size(), (batch_count - 1) * batch_size);
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(records[i].seq, i);
+    EXPECT_EQ(records[i].key, "key" + std::to_string(i));
+  }
+}
+
 TEST(oblsm_wal_test, DISABLED_oblsm_recover_with_small_amount_of_data)
 {
   filesystem::remove_all("oblsm_tmp");
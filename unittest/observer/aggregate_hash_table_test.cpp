@@ -10,6 +10,7 @@ See the Mulan PSL v2 for more details. */
 
 #include <chrono>
 #include <iostream>
+#include <map>
 
 #include "gtest/gtest.h"
 #include "sql/expr/aggregate_hash_table.h"
@@ -103,8 +104,28 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
   }
 }
 
-#ifdef USE_SIMD
-TEST(AggregateHashTableTest, DISABLED_linear_probing_hash_table)
+/// 扫描哈希表中所有的分组，输出列的 id 依次是 0, 1, 2 ...
+static void scan_hash_table(AggregateHashTable::Scanner &scanner, Chunk &output_chunk, Chunk &result)
+{
+  scanner.open_scan();
+  result.add_columns_like(output_chunk);
+  RC rc = RC::SUCCESS;
+  while (OB_SUCC(rc = scanner.next(output_chunk))) {
+    for (int i = 0; i < output_chunk.column_num(); i++) {
+      ASSERT_EQ(result.column(i).append_rows(output_chunk.column(i), 0, output_chunk.rows()), RC::SUCCESS);
+      for (int row = 0; row < output_chunk.rows(); row++) {
+        if (output_chunk.column(i).is_null(row)) {
+          result.column(i).set_null(result.rows() - output_chunk.rows() + row);
+        }
+      }
+    }
+    output_chunk.reset_data();
+  }
+  ASSERT_EQ(rc, RC::RECORD_EOF);
+  scanner.close_scan();
+}
+
+TEST(AggregateHashTableTest, linear_probing_hash_table)
 {
   // simple case
   {
@@ -120,62 +141,310 @@ TEST(AggregateHashTableTest, DISABLED_linear_probing_hash_table)
     group_chunk.add_column(std::move(column1), 0);
     aggr_chunk.add_column(std::move(column2), 1);
 
-    auto linear_probing_hash_table = std::make_unique<LinearProbingAggregateHashTable<int>>(AggregateExpr::Type::SUM);
+    AggregateExpr             aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    std::vector<Expression *> aggregate_exprs = {&aggregate_expr};
+    auto linear_probing_hash_table = std::make_unique<LinearProbingAggregateHashTable>(aggregate_exprs);
     RC   rc                        = linear_probing_hash_table->add_chunk(group_chunk, aggr_chunk);
     ASSERT_EQ(rc, RC::SUCCESS);
+    ASSERT_EQ(linear_probing_hash_table->size(), 8);
     Chunk output_chunk;
     output_chunk.add_column(
         make_unique<Column>(group_chunk.column(0).attr_type(), group_chunk.column(0).attr_len()), 0);
     output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 1);
-    LinearProbingAggregateHashTable<int>::Scanner scanner(linear_probing_hash_table.get());
+    LinearProbingAggregateHashTable::Scanner scanner(linear_probing_hash_table.get());
     scanner.open_scan();
     rc = scanner.next(output_chunk);
     ASSERT_EQ(rc, RC::SUCCESS);
     ASSERT_EQ(output_chunk.rows(), 8);
     for (int i = 0; i < 8; i++) {
-      std::cout << "column1: " << output_chunk.get_value(1, i).get_string() << " "
-                << "sum(column2)" << output_chunk.get_value(0, i).get_string() << std::endl;
+      // 按照分组插入的顺序输出
+      int key    = output_chunk.get_value(0, i).get_int();
+      int expect = 0;
+      for (int j = key; j < 1023; j += 8) {
+        expect += j;
+      }
+      ASSERT_EQ(key, i);
+      ASSERT_EQ(output_chunk.get_value(1, i).get_int(), expect);
     }
+    output_chunk.reset_data();
+    ASSERT_EQ(scanner.next(output_chunk), RC::RECORD_EOF);
   }
 
-  // hash conflict
+  // hash conflict and resize
   {
     Chunk                   group_chunk;
     Chunk                   aggr_chunk;
     std::unique_ptr<Column> column1 = std::make_unique<Column>(AttrType::INTS, 4);
     std::unique_ptr<Column> column2 = std::make_unique<Column>(AttrType::INTS, 4);
-    for (int i = 0; i < 1002; i++) {
-      int key, value = 1;
-      if (i % 2 == 0) {
-        key = 1;
-      } else {
-        key = 257;
-      }
-
+    for (int i = 0; i < 4000; i++) {
+      int key = (i % 1000) * 256 + 1, value = 1;
       column1->append_one((char *)&key);
       column2->append_one((char *)&value);
     }
     group_chunk.add_column(std::move(column1), 0);
     aggr_chunk.add_column(std::move(column2), 1);
 
-    auto linear_probing_hash_table =
-        std::make_unique<LinearProbingAggregateHashTable<int>>(AggregateExpr::Type::SUM, 256);
-    RC rc = linear_probing_hash_table->add_chunk(group_chunk, aggr_chunk);
-    ASSERT_EQ(rc, RC::SUCCESS);
+    AggregateExpr             aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    std::vector<Expression *> aggregate_exprs = {&aggregate_expr};
+    auto linear_probing_hash_table = std::make_unique<LinearProbingAggregateHashTable>(aggregate_exprs, 16);
+    ASSERT_EQ(linear_probing_hash_table->add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+    ASSERT_EQ(linear_probing_hash_table->size(), 1000);
+    ASSERT_GE(linear_probing_hash_table->capacity(), 2000);
+
     Chunk output_chunk;
-    output_chunk.add_column(
-        make_unique<Column>(group_chunk.column(0).attr_type(), group_chunk.column(0).attr_len()), 0);
-    output_chunk.add_column(make_unique<Column>(aggr_chunk.column(0).attr_type(), aggr_chunk.column(0).attr_len()), 1);
-    LinearProbingAggregateHashTable<int>::Scanner scanner(linear_probing_hash_table.get());
-    scanner.open_scan();
-    rc = scanner.next(output_chunk);
-    ASSERT_EQ(rc, RC::SUCCESS);
-    ASSERT_EQ(output_chunk.rows(), 2);
-    ASSERT_STREQ(output_chunk.get_value(1, 0).get_string().c_str(), "501");
-    ASSERT_STREQ(output_chunk.get_value(1, 1).get_string().c_str(), "501");
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+    LinearProbingAggregateHashTable::Scanner scanner(linear_probing_hash_table.get());
+    Chunk                                    result;
+    scan_hash_table(scanner, output_chunk, result);
+    ASSERT_EQ(result.rows(), 1000);
+    for (int i = 0; i < 1000; i++) {
+      ASSERT_EQ(result.get_value(0, i).get_int(), i * 256 + 1);
+      ASSERT_STREQ(result.get_value(1, i).get_string().c_str(), "4");
+    }
+  }
+}
+
+TEST(AggregateHashTableTest, linear_probing_multiple_columns)
+{
+  // 两个分组列（字符串和整数），多个聚合列，分两个 chunk 写入
+  AggregateExpr             sum_expr(AggregateExpr::Type::SUM, nullptr);
+  AggregateExpr             count_expr(AggregateExpr::Type::COUNT, nullptr);
+  AggregateExpr             max_expr(AggregateExpr::Type::MAX, nullptr);
+  AggregateExpr             avg_expr(AggregateExpr::Type::AVG, nullptr);
+  std::vector<Expression *> aggregate_exprs = {&sum_expr, &count_expr, &max_expr, &avg_expr};
+  LinearProbingAggregateHashTable hash_table(aggregate_exprs);
+
+  const std::vector<std::string> names = {"a", "long string key 0", "long string key 1", "b"};
+  for (int round = 0; round < 2; round++) {
+    Chunk group_chunk;
+    Chunk aggr_chunk;
+    auto  group1 = std::make_unique<Column>(AttrType::CHARS, 20);
+    auto  group2 = std::make_unique<Column>(AttrType::INTS, 4);
+    auto  aggr1  = std::make_unique<Column>(AttrType::FLOATS, 4);
+    auto  aggr2  = std::make_unique<Column>(AttrType::INTS, 4);
+    auto  aggr3  = std::make_unique<Column>(AttrType::INTS, 4);
+    auto  aggr4  = std::make_unique<Column>(AttrType::INTS, 4);
+    for (int i = 0; i < 100; i++) {
+      char name[20] = {0};
+      strncpy(name, names[i % 4].c_str(), sizeof(name));
+      int   key   = i % 2;
+      float value = 0.5f;
+      group1->append_one(name);
+      group2->append_one((char *)&key);
+      aggr1->append_one((char *)&value);
+      aggr2->append_one((char *)&i);
+      aggr3->append_one((char *)&i);
+      aggr4->append_one((char *)&i);
+    }
+    group_chunk.add_column(std::move(group1), 0);
+    group_chunk.add_column(std::move(group2), 1);
+    aggr_chunk.add_column(std::move(aggr1), 0);
+    aggr_chunk.add_column(std::move(aggr2), 1);
+    aggr_chunk.add_column(std::move(aggr3), 2);
+    aggr_chunk.add_column(std::move(aggr4), 3);
+    ASSERT_EQ(hash_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+  }
+  // (name, i % 2) 只有 4 种组合
+  ASSERT_EQ(hash_table.size(), 4);
+
+  Chunk output_chunk;
+  output_chunk.add_column(make_unique<Column>(AttrType::CHARS, 20), 0);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+  output_chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4), 2);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 3);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 4);
+  output_chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4), 5);
+  LinearProbingAggregateHashTable::Scanner scanner(&hash_table);
+  Chunk                                    result;
+  scan_hash_table(scanner, output_chunk, result);
+  ASSERT_EQ(result.rows(), 4);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(result.get_value(0, i).get_string(), names[i]);
+    ASSERT_EQ(result.get_value(1, i).get_int(), i % 2);
+    ASSERT_FLOAT_EQ(result.get_value(2, i).get_float(), 25.0f);
+    ASSERT_EQ(result.get_value(3, i).get_int(), 50);
+    ASSERT_EQ(result.get_value(4, i).get_int(), 96 + i);
+    ASSERT_FLOAT_EQ(result.get_value(5, i).get_float(), 48.0f + i);
+  }
+}
+
+TEST(AggregateHashTableTest, linear_probing_selection_and_null)
+{
+  // 只聚合选择向量中的行，NULL 分组在同一个分组中，NULL 值不参与聚合
+  Chunk group_chunk;
+  Chunk aggr_chunk;
+  auto  group = std::make_unique<Column>(AttrType::INTS, 4);
+  auto  aggr  = std::make_unique<Column>(AttrType::INTS, 4);
+  for (int i = 0; i < 10; i++) {
+    int key = i % 3;
+    group->append_one((char *)&key);
+    aggr->append_one((char *)&i);
+  }
+  group->set_null(0);
+  group->set_null(3);
+  aggr->set_null(1);
+  aggr->set_null(4);
+  aggr->set_null(7);
+  auto count_aggr = aggr->clone();
+  group_chunk.add_column(std::move(group), 0);
+  aggr_chunk.add_column(std::move(aggr), 0);
+  aggr_chunk.add_column(std::move(count_aggr), 1);
+  group_chunk.set_selection(std::vector<int>{0, 1, 3, 4, 5, 7, 9});
+
+  AggregateExpr                   sum_expr(AggregateExpr::Type::SUM, nullptr);
+  AggregateExpr                   count_expr(AggregateExpr::Type::COUNT, nullptr);
+  std::vector<Expression *>       aggregate_exprs = {&sum_expr, &count_expr};
+  LinearProbingAggregateHashTable hash_table(aggregate_exprs);
+  ASSERT_EQ(hash_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+
+  Chunk output_chunk;
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+  output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 2);
+  LinearProbingAggregateHashTable::Scanner scanner(&hash_table);
+  Chunk                                    result;
+  scan_hash_table(scanner, output_chunk, result);
+
+  // 分组依次是 NULL(0, 3)、1(1, 4, 7)、2(5)、0(9)
+  ASSERT_EQ(result.rows(), 4);
+  ASSERT_TRUE(result.column(0).is_null(0));
+  ASSERT_EQ(result.get_value(1, 0).get_int(), 3);
+  ASSERT_EQ(result.get_value(2, 0).get_int(), 2);
+
+  ASSERT_EQ(result.get_value(0, 1).get_int(), 1);
+  ASSERT_TRUE(result.column(1).is_null(1));
+  ASSERT_EQ(result.get_value(2, 1).get_int(), 0);
+
+  ASSERT_EQ(result.get_value(0, 2).get_int(), 2);
+  ASSERT_EQ(result.get_value(1, 2).get_int(), 5);
+  ASSERT_EQ(result.get_value(2, 2).get_int(), 1);
+
+  ASSERT_EQ(result.get_value(0, 3).get_int(), 0);
+  ASSERT_EQ(result.get_value(1, 3).get_int(), 9);
+  ASSERT_EQ(result.get_value(2, 3).get_int(), 1);
+}
+
+TEST(AggregateHashTableTest, linear_probing_simd_levels)
+{
+  // 不同的指令集得到相同的分组结果
+  const SimdLevel origin = simd_level();
+  std::vector<int> expect;
+  for (int level = 0; level <= static_cast<int>(detect_simd_level()); level++) {
+    set_simd_level(static_cast<SimdLevel>(level));
+    SCOPED_TRACE(simd_level_name(simd_level()));
+
+    Chunk group_chunk;
+    Chunk aggr_chunk;
+    auto  group = std::make_unique<Column>(AttrType::INTS, 4);
+    auto  aggr  = std::make_unique<Column>(AttrType::INTS, 4);
+    for (int i = 0; i < 5000; i++) {
+      int key = (i * 7919) % 3001;
+      group->append_one((char *)&key);
+      aggr->append_one((char *)&i);
+    }
+    group_chunk.add_column(std::move(group), 0);
+    aggr_chunk.add_column(std::move(aggr), 0);
+
+    AggregateExpr                   sum_expr(AggregateExpr::Type::SUM, nullptr);
+    std::vector<Expression *>       aggregate_exprs = {&sum_expr};
+    LinearProbingAggregateHashTable hash_table(aggregate_exprs, 64);
+    ASSERT_EQ(hash_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+    ASSERT_EQ(hash_table.size(), 3001);
+
+    Chunk output_chunk;
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+    LinearProbingAggregateHashTable::Scanner scanner(&hash_table);
+    Chunk                                    result;
+    scan_hash_table(scanner, output_chunk, result);
+    std::vector<int> sums;
+    for (int i = 0; i < result.rows(); i++) {
+      sums.push_back(result.get_value(1, i).get_int());
+    }
+    if (expect.empty()) {
+      expect = sums;
+    }
+    ASSERT_EQ(sums, expect);
+  }
+  set_simd_level(origin);
+}
+
+TEST(AggregateHashTableTest, linear_probing_merge_partitions)
+{
+  // 3 个局部哈希表按照分区合并，结果与写入同一个哈希表相同
+  AggregateExpr             sum_expr(AggregateExpr::Type::SUM, nullptr);
+  AggregateExpr             count_expr(AggregateExpr::Type::COUNT, nullptr);
+  AggregateExpr             min_expr(AggregateExpr::Type::MIN, nullptr);
+  std::vector<Expression *> aggregate_exprs = {&sum_expr, &count_expr, &min_expr};
+
+  auto make_chunks = [](int begin, int end, Chunk &group_chunk, Chunk &aggr_chunk) {
+    auto group1 = std::make_unique<Column>(AttrType::CHARS, 24);
+    auto group2 = std::make_unique<Column>(AttrType::INTS, 4);
+    auto aggr   = std::make_unique<Column>(AttrType::INTS, 4);
+    for (int i = begin; i < end; i++) {
+      char name[24] = {0};
+      snprintf(name, sizeof(name), "long string key %d", i % 50);
+      int key = i % 7;
+      group1->append_one(name);
+      group2->append_one((char *)&key);
+      aggr->append_one((char *)&i);
+    }
+    group_chunk.add_column(std::move(group1), 0);
+    group_chunk.add_column(std::move(group2), 1);
+    aggr_chunk.add_column(std::move(aggr), 0);
+    for (int i = 1; i < 3; i++) {
+      auto column = std::make_unique<Column>();
+      column->reference(aggr_chunk.column(0));
+      aggr_chunk.add_column(std::move(column), i);
+    }
+  };
+
+  LinearProbingAggregateHashTable serial_table(aggregate_exprs);
+  std::vector<std::unique_ptr<LinearProbingAggregateHashTable>> local_tables;
+  for (int i = 0; i < 3; i++) {
+    Chunk group_chunk;
+    Chunk aggr_chunk;
+    make_chunks(i * 1000, (i + 1) * 1000 + 500, group_chunk, aggr_chunk);
+    local_tables.emplace_back(std::make_unique<LinearProbingAggregateHashTable>(aggregate_exprs, 64));
+    ASSERT_EQ(local_tables.back()->add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+    ASSERT_EQ(serial_table.add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+  }
+  // 空的哈希表不影响合并结果
+  local_tables.emplace_back(std::make_unique<LinearProbingAggregateHashTable>(aggregate_exprs));
+
+  auto scan_groups = [](LinearProbingAggregateHashTable &hash_table, std::map<std::string, std::vector<int>> &groups) {
+    Chunk output_chunk;
+    output_chunk.add_column(make_unique<Column>(AttrType::CHARS, 24), 0);
+    for (int i = 1; i < 5; i++) {
+      output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), i);
+    }
+    LinearProbingAggregateHashTable::Scanner scanner(&hash_table);
+    Chunk                                    result;
+    scan_hash_table(scanner, output_chunk, result);
+    for (int i = 0; i < result.rows(); i++) {
+      std::string key = result.get_value(0, i).get_string() + "/" + std::to_string(result.get_value(1, i).get_int());
+      ASSERT_EQ(groups.count(key), 0UL);
+      groups[key] = {result.get_value(2, i).get_int(), result.get_value(3, i).get_int(), result.get_value(4, i).get_int()};
+    }
+  };
+
+  std::map<std::string, std::vector<int>> expect;
+  scan_groups(serial_table, expect);
+  ASSERT_EQ(expect.size(), 350UL);
+
+  const int                               partition_bits = 3;
+  std::map<std::string, std::vector<int>> groups;
+  for (int partition = 0; partition < (1 << partition_bits); partition++) {
+    LinearProbingAggregateHashTable partition_table(aggregate_exprs, 32);
+    for (auto &local_table : local_tables) {
+      ASSERT_EQ(partition_table.merge(*local_table, partition, partition_bits), RC::SUCCESS);
+    }
+    ASSERT_GT(partition_table.size(), 0);
+    scan_groups(partition_table, groups);
   }
+  ASSERT_EQ(groups, expect);
 }
-#endif
 
 int main(int argc, char **argv)
 {
@@ -11,6 +11,8 @@ See the Mulan PSL v2 for more details. */
 #include <memory>
 
 #include "sql/expr/arithmetic_operator.hpp"
+#include "common/type/date_type.h"
+#include "sql/expr/column_kernels.h"
 #include "gtest/gtest.h"
 
 using namespace std;
@@ -83,15 +85,14 @@ TEST(ArithmeticTest, arithmetic_test)
       ASSERT_EQ(result[i], -1);
     }
   }
-// sum
-#ifdef USE_SIMD
+  // sum
   {
     int              size = 100;
     std::vector<int> a(size, 0);
     for (int i = 0; i < size; i++) {
       a[i] = i;
     }
-    int res = mm256_sum_epi32(a.data(), size);
+    int res = simd_sum_epi32(a.data(), size);
     ASSERT_EQ(res, 4950);
   }
   {
@@ -100,10 +101,167 @@ TEST(ArithmeticTest, arithmetic_test)
     for (int i = 0; i < size; i++) {
       a[i] = i;
     }
-    int res = mm256_sum_ps(a.data(), size);
+    float res = simd_sum_ps(a.data(), size);
     ASSERT_FLOAT_EQ(res, 4950.0);
   }
-#endif
+}
+
+TEST(ArithmeticTest, divide_by_zero)
+{
+  // 与 FloatType::divide 相同，除数为 0 时结果为 float 的最大值
+  int                size = 20;
+  std::vector<float> a(size, 1.0f);
+  std::vector<float> b(size, 0.0f);
+  std::vector<float> result(size, 0.0f);
+  b[3] = 2.0f;
+  binary_operator<false, false, float, DivideOperator>(a.data(), b.data(), result.data(), size);
+  for (int i = 0; i < size; ++i) {
+    ASSERT_FLOAT_EQ(result[i], i == 3 ? 0.5f : numeric_limits<float>::max());
+  }
+}
+
+TEST(ColumnKernelTest, compare)
+{
+  const int size = 20;
+  Column    ints(AttrType::INTS, sizeof(int), size);
+  Column    floats(AttrType::FLOATS, sizeof(float), size);
+  Column    chars(AttrType::CHARS, 4, size);
+  for (int i = 0; i < size; i++) {
+    float f = i + 0.5f;
+    char  s[4] = {static_cast<char>('a' + i), 0, 0, 0};
+    ints.append_one(reinterpret_cast<const char *>(&i));
+    floats.append_one(reinterpret_cast<const char *>(&f));
+    chars.append_one(s);
+  }
+  ints.set_null(0);
+
+  Column constant;
+  constant.init(Value(10), size);
+  vector<uint8_t> select(size, 1);
+  ASSERT_EQ(compare_columns(CompOp::LESS_THAN, ints, constant, select), RC::SUCCESS);
+  for (int i = 0; i < size; i++) {
+    ASSERT_EQ(select[i], i > 0 && i < 10 ? 1 : 0);
+  }
+
+  // INTS 和 FLOATS 比较
+  select.assign(size, 1);
+  ASSERT_EQ(compare_columns(CompOp::LESS_THAN, floats, ints, select), RC::SUCCESS);
+  for (int i = 0; i < size; i++) {
+    ASSERT_EQ(select[i], 0);
+  }
+
+  // 常量字符串比实际的值短
+  Column char_constant;
+  char_constant.init(Value("e"), size);
+  select.assign(size, 1);
+  ASSERT_EQ(compare_columns(CompOp::GREAT_EQUAL, chars, char_constant, select), RC::SUCCESS);
+  for (int i = 0; i < size; i++) {
+    ASSERT_EQ(select[i], i >= 4 ? 1 : 0);
+  }
+
+  ASSERT_FALSE(can_compare_columns(AttrType::CHARS, AttrType::INTS));
+}
+
+TEST(ColumnKernelTest, calc_and_cast)
+{
+  const int size = 20;
+  Column    ints(AttrType::INTS, sizeof(int), size);
+  for (int i = 0; i < size; i++) {
+    ints.append_one(reinterpret_cast<const char *>(&i));
+  }
+  ints.set_null(1);
+
+  Column two;
+  two.init(Value(2), size);
+  Column result;
+  ASSERT_EQ(calc_columns(ArithmeticExpr::Type::MUL, ints, two, AttrType::INTS, result), RC::SUCCESS);
+  ASSERT_EQ(result.count(), size);
+  for (int i = 0; i < size; i++) {
+    ASSERT_EQ(result.is_null(i), i == 1);
+    if (i != 1) {
+      ASSERT_EQ(reinterpret_cast<int *>(result.data())[i], i * 2);
+    }
+  }
+
+  // 整数相除的结果是 FLOATS
+  ASSERT_EQ(calc_columns(ArithmeticExpr::Type::DIV, ints, two, AttrType::FLOATS, result), RC::SUCCESS);
+  ASSERT_EQ(result.attr_type(), AttrType::FLOATS);
+  ASSERT_FLOAT_EQ(reinterpret_cast<float *>(result.data())[5], 2.5f);
+
+  ASSERT_EQ(calc_columns(ArithmeticExpr::Type::NEGATIVE, two, two, AttrType::INTS, result), RC::SUCCESS);
+  ASSERT_EQ(result.column_type(), Column::Type::CONSTANT_COLUMN);
+  ASSERT_EQ(reinterpret_cast<int *>(result.data())[0], -2);
+
+  ASSERT_EQ(cast_column(ints, AttrType::FLOATS, result), RC::SUCCESS);
+  ASSERT_FLOAT_EQ(reinterpret_cast<float *>(result.data())[7], 7.0f);
+  ASSERT_TRUE(result.is_null(1));
+
+  Column dates;
+  dates.init(Value("2024-02-29"), size);
+  ASSERT_EQ(cast_column(dates, AttrType::DATES, result), RC::SUCCESS);
+  ASSERT_EQ(result.column_type(), Column::Type::CONSTANT_COLUMN);
+  ASSERT_EQ(reinterpret_cast<int *>(result.data())[0], DateType::to_int("2024-02-29"));
+
+  ASSERT_EQ(cast_column(ints, AttrType::CHARS, result), RC::UNIMPLEMENTED);
+}
+
+TEST(ArithmeticTest, simd_levels)
+{
+  // 每个指令集的结果都与标量的实现相同，行数不是寄存器宽度的整数倍
+  const int          size = 101;
+  std::vector<int>   int_left(size), int_right(size);
+  std::vector<float> float_left(size), float_right(size);
+  for (int i = 0; i < size; i++) {
+    int_left[i]    = i % 7 - 3;
+    int_right[i]   = i % 5 - 2;
+    float_left[i]  = int_left[i] * 0.5f;
+    float_right[i] = int_right[i] * 0.25f;
+  }
+  const CompOp ops[] = {
+      CompOp::EQUAL_TO, CompOp::NOT_EQUAL, CompOp::LESS_THAN, CompOp::LESS_EQUAL, CompOp::GREAT_THAN, CompOp::GREAT_EQUAL};
+
+  const SimdLevel origin = simd_level();
+  for (int level = 0; level <= static_cast<int>(detect_simd_level()); level++) {
+    ASSERT_EQ(set_simd_level(static_cast<SimdLevel>(level)), static_cast<SimdLevel>(level));
+    for (CompOp op : ops) {
+      std::vector<uint8_t> int_result(size, 1);
+      std::vector<uint8_t> float_result(size, 1);
+      std::vector<uint8_t> constant_result(size, 1);
+      compare_result<int, false, false>(int_left.data(), int_right.data(), size, int_result, op);
+      compare_result<float, false, false>(float_left.data(), float_right.data(), size, float_result, op);
+      compare_result<int, false, true>(int_left.data(), int_right.data(), size, constant_result, op);
+      for (int i = 0; i < size; i++) {
+        const int cmp_int   = int_left[i] - int_right[i];
+        const int cmp_const = int_left[i] - int_right[0];
+        auto      expect    = [op](int cmp) {
+          switch (op) {
+            case CompOp::EQUAL_TO: return cmp == 0;
+            case CompOp::NOT_EQUAL: return cmp != 0;
+            case CompOp::LESS_THAN: return cmp < 0;
+            case CompOp::LESS_EQUAL: return cmp <= 0;
+            case CompOp::GREAT_THAN: return cmp > 0;
+            default: return cmp >= 0;
+          }
+        };
+        ASSERT_EQ(int_result[i], expect(cmp_int) ? 1 : 0) << simd_level_name(simd_level());
+        const int cmp_float = float_left[i] < float_right[i] ? -1 : (float_left[i] > float_right[i] ? 1 : 0);
+        ASSERT_EQ(float_result[i], expect(cmp_float) ? 1 : 0) << simd_level_name(simd_level());
+        ASSERT_EQ(constant_result[i], expect(cmp_const) ? 1 : 0) << simd_level_name(simd_level());
+      }
+    }
+
+    std::vector<int>   int_result(size);
+    std::vector<float> float_result(size);
+    binary_operator<false, true, int, MultiplyOperator>(int_left.data(), int_right.data(), int_result.data(), size);
+    binary_operator<false, false, float, DivideOperator>(
+        float_left.data(), float_right.data(), float_result.data(), size);
+    for (int i = 0; i < size; i++) {
+      ASSERT_EQ(int_result[i], int_left[i] * int_right[0]) << simd_level_name(simd_level());
+      ASSERT_FLOAT_EQ(float_result[i], DivideOperator::operation(float_left[i], float_right[i]))
+          << simd_level_name(simd_level());
+    }
+  }
+  set_simd_level(origin);
 }
 
 int main(int argc, char **argv)
@@ -826,6 +826,239 @@ TEST(test_bplus_tree, test_bplus_tree_insert)
   handler = nullptr;
 }
 
+TEST(test_bplus_tree, test_bplus_tree_bulk_load)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "test_bplus_tree_bulk_load.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), ORDER, ORDER));
+
+  const int key_length = sizeof(int) + sizeof(RID);
+  // 逆序放入，并且只放偶数，留下奇数给后面逐条插入
+  vector<char> keys;
+  for (int i = insert_num - 2; i >= 0; i -= 2) {
+    RID rid(i / page_size, i % page_size);
+    keys.resize(keys.size() + key_length);
+    memcpy(keys.data() + keys.size() - key_length, &i, sizeof(i));
+    memcpy(keys.data() + keys.size() - key_length + sizeof(i), &rid, sizeof(rid));
+  }
+
+  // 唯一索引存在重复值时失败，并且不修改B+树
+  vector<char> duplicate_keys(keys);
+  duplicate_keys.insert(duplicate_keys.end(), keys.begin(), keys.begin() + sizeof(int));
+  RID duplicate_rid(page_size, 0);
+  duplicate_keys.insert(duplicate_keys.end(), (char *)&duplicate_rid, (char *)&duplicate_rid + sizeof(RID));
+  ASSERT_EQ(RC::RECORD_NOT_UNIQUE, handler.bulk_load(duplicate_keys, true /*unique*/));
+  ASSERT_TRUE(handler.is_empty());
+
+  ASSERT_EQ(RC::SUCCESS, handler.bulk_load(keys));
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_EQ(RC::INTERNAL, handler.bulk_load(keys));
+
+  for (int i = 1; i < insert_num; i += 2) {
+    RID rid(i / page_size, i % page_size);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry((const char *)&i, &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+
+  {
+    BplusTreeScanner scanner(handler);
+    ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+    RID rid;
+    int count = 0;
+    while (RC::SUCCESS == scanner.next_entry(rid)) {
+      ASSERT_EQ(RID(count / page_size, count % page_size), rid);
+      count++;
+    }
+    scanner.close();
+    ASSERT_EQ(insert_num, count);
+  }
+
+  for (int i = 0; i < insert_num; i += 3) {
+    RID rid(i / page_size, i % page_size);
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry((const char *)&i, &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+
+  handler.close();
+}
+
+TEST(test_bplus_tree, test_bplus_tree_bulk_load_min_size)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  // 节点最多20个元素，按照填充比例每个节点放18个，平均分配后可能会小于最少的10个元素
+  const int max_size   = 20;
+  const int key_length = sizeof(int) + sizeof(RID);
+  for (int key_num : {19, 37, 181, 3421}) {
+    filesystem::path buffer_pool_file = test_directory / ("test_bplus_tree_bulk_load_" + to_string(key_num) + ".btree");
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+    DiskBufferPool *buffer_pool = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+
+    BplusTreeHandler handler;
+    ASSERT_EQ(RC::SUCCESS,
+        handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), max_size, max_size));
+
+    vector<char> keys(key_num * key_length);
+    for (int i = 0; i < key_num; i++) {
+      RID rid(i / page_size, i % page_size);
+      memcpy(keys.data() + i * key_length, &i, sizeof(i));
+      memcpy(keys.data() + i * key_length + sizeof(i), &rid, sizeof(rid));
+    }
+    ASSERT_EQ(RC::SUCCESS, handler.bulk_load(keys));
+    // validate_tree 会检查非根节点的元素个数不少于 min_size
+    ASSERT_TRUE(handler.validate_tree());
+
+    for (int i = 0; i < key_num; i += 2) {
+      RID rid(i / page_size, i % page_size);
+      ASSERT_EQ(RC::SUCCESS, handler.delete_entry((const char *)&i, &rid));
+    }
+    ASSERT_TRUE(handler.validate_tree());
+
+    handler.close();
+  }
+}
+
+TEST(test_bplus_tree, test_scanner_next_entries)
+{
+  LoggerFactory::init_default("test.log");
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "test_scanner_next_entries.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), ORDER, ORDER));
+
+  // 每个值重复3次，值为 0, 2, 4, ...
+  const int value_num = 100;
+  for (int i = 0; i < value_num; i++) {
+    const int value = i * 2;
+    for (int j = 0; j < 3; j++) {
+      RID rid(i, j);
+      ASSERT_EQ(RC::SUCCESS, handler.insert_entry((const char *)&value, &rid));
+    }
+  }
+
+  auto scan_one_by_one = [&](const int *left, bool left_inclusive, const int *right, bool right_inclusive) {
+    vector<RID>      rids;
+    BplusTreeScanner scanner(handler);
+    EXPECT_EQ(RC::SUCCESS,
+        scanner.open((const char *)left, sizeof(int), left_inclusive, (const char *)right, sizeof(int), right_inclusive));
+    RID rid;
+    while (RC::SUCCESS == scanner.next_entry(rid)) {
+      rids.push_back(rid);
+    }
+    return rids;
+  };
+
+  auto scan_batch = [&](const int *left, bool left_inclusive, const int *right, bool right_inclusive, int capacity) {
+    vector<RID>      rids;
+    BplusTreeScanner scanner(handler);
+    EXPECT_EQ(RC::SUCCESS,
+        scanner.open((const char *)left, sizeof(int), left_inclusive, (const char *)right, sizeof(int), right_inclusive));
+    vector<RID> batch(capacity);
+    int         count = 0;
+    RC          rc    = RC::SUCCESS;
+    while (RC::SUCCESS == (rc = scanner.next_entries(batch.data(), capacity, count))) {
+      EXPECT_GT(count, 0);
+      EXPECT_LE(count, capacity);
+      rids.insert(rids.end(), batch.begin(), batch.begin() + count);
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(0, count);
+    return rids;
+  };
+
+  const int bounds[] = {-1, 0, 1, 101, 102, 198, 500};
+  for (int capacity : {1, 5, 1000}) {
+    ASSERT_EQ(scan_one_by_one(nullptr, true, nullptr, true), scan_batch(nullptr, true, nullptr, true, capacity));
+    ASSERT_EQ(value_num * 3, (int)scan_batch(nullptr, true, nullptr, true, capacity).size());
+    for (const int &left : bounds) {
+      ASSERT_EQ(scan_one_by_one(&left, true, nullptr, true), scan_batch(&left, true, nullptr, true, capacity));
+      ASSERT_EQ(scan_one_by_one(nullptr, true, &left, false), scan_batch(nullptr, true, &left, false, capacity));
+      for (const int &right : bounds) {
+        if (left > right) {
+          continue;
+        }
+        for (bool left_inclusive : {true, false}) {
+          for (bool right_inclusive : {true, false}) {
+            if (left == right && !(left_inclusive && right_inclusive)) {
+              continue;
+            }
+            ASSERT_EQ(scan_one_by_one(&left, left_inclusive, &right, right_inclusive),
+                scan_batch(&left, left_inclusive, &right, right_inclusive, capacity))
+                << "left=" << left << ", right=" << right << ", capacity=" << capacity;
+          }
+        }
+      }
+    }
+  }
+
+  // next_entry 与 next_entries 交替使用
+  {
+    BplusTreeScanner scanner(handler);
+    ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+    vector<RID> rids;
+    vector<RID> batch(7);
+    int         count = 0;
+    RID         rid;
+    for (int i = 0;; i++) {
+      if (i % 2 == 0) {
+        if (RC::SUCCESS != scanner.next_entry(rid)) {
+          break;
+        }
+        rids.push_back(rid);
+      } else {
+        if (RC::SUCCESS != scanner.next_entries(batch.data(), 7, count)) {
+          break;
+        }
+        rids.insert(rids.end(), batch.begin(), batch.begin() + count);
+      }
+    }
+    ASSERT_EQ(scan_one_by_one(nullptr, true, nullptr, true), rids);
+  }
+
+  handler.close();
+}
+
 int main(int argc, char **argv)
 {
 
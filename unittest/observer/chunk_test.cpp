@@ -60,6 +60,108 @@ TEST(ChunkTest, chunk_test)
   }
 }
 
+TEST(ChunkTest, selection)
+{
+  const int row_num = 6;
+  Chunk     chunk;
+  chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), row_num), 0);
+  chunk.add_column(std::make_unique<Column>(AttrType::FLOATS, sizeof(float), row_num), 1);
+  for (int i = 0; i < row_num; i++) {
+    float value = i + 0.5f;
+    chunk.column(0).append_one((char *)&i);
+    chunk.column(1).append_one((char *)&value);
+  }
+  ASSERT_FALSE(chunk.has_selection());
+  ASSERT_EQ(chunk.selected_rows(), row_num);
+
+  // 全部选中时不需要选择向量
+  vector<uint8_t> select(row_num, 1);
+  chunk.set_selection(select);
+  ASSERT_FALSE(chunk.has_selection());
+
+  select = {0, 1, 0, 1, 1, 0};
+  chunk.set_selection(select);
+  ASSERT_TRUE(chunk.has_selection());
+  ASSERT_EQ(chunk.rows(), row_num);
+  ASSERT_EQ(chunk.selected_rows(), 3);
+  ASSERT_EQ(chunk.row_index(0), 1);
+  ASSERT_EQ(chunk.row_index(2), 4);
+
+  vector<uint8_t> init;
+  chunk.init_select(init);
+  ASSERT_EQ(init, select);
+
+  Chunk chunk2;
+  chunk2.reference(chunk);
+  ASSERT_EQ(chunk2.selection(), chunk.selection());
+
+  chunk2.truncate(2);
+  ASSERT_EQ(chunk2.selected_rows(), 2);
+  ASSERT_EQ(chunk.selected_rows(), 3);
+
+  Chunk output;
+  ASSERT_EQ(chunk.materialize(output), RC::SUCCESS);
+  ASSERT_FALSE(output.has_selection());
+  ASSERT_EQ(output.rows(), 3);
+  ASSERT_EQ(output.get_value(0, 0).get_int(), 1);
+  ASSERT_EQ(output.get_value(0, 1).get_int(), 3);
+  ASSERT_EQ(output.get_value(1, 2).get_float(), 4.5f);
+
+  chunk.reset_data();
+  ASSERT_FALSE(chunk.has_selection());
+}
+
+TEST(ColumnTest, validity)
+{
+  const int row_num = 10;
+  Column    column(AttrType::INTS, sizeof(int), row_num);
+  for (int i = 0; i < row_num; i++) {
+    int value = i == 3 || i == 9 ? INT32_MAX : i;
+    column.append_one((char *)&value);
+  }
+  ASSERT_FALSE(column.has_null());
+  ASSERT_FALSE(column.get_value(3).is_null());
+
+  column.detect_nulls();
+  ASSERT_TRUE(column.has_null());
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(column.is_null(i), i == 3 || i == 9);
+    ASSERT_EQ(column.get_value(i).is_null(), i == 3 || i == 9);
+  }
+
+  // 引用和拷贝都会保留有效性位图
+  Column ref;
+  ref.reference(column);
+  ASSERT_TRUE(ref.is_null(9));
+
+  Column selected(AttrType::INTS, sizeof(int), row_num);
+  ASSERT_EQ(selected.append_selected(column, {2, 3, 4}), RC::SUCCESS);
+  ASSERT_EQ(selected.count(), 3);
+  ASSERT_FALSE(selected.is_null(0));
+  ASSERT_TRUE(selected.is_null(1));
+  ASSERT_EQ(selected.get_value(2).get_int(), 4);
+
+  Column appended(AttrType::INTS, sizeof(int), row_num);
+  ASSERT_EQ(appended.append_rows(column, 8, 2), RC::SUCCESS);
+  ASSERT_FALSE(appended.is_null(0));
+  ASSERT_TRUE(appended.is_null(1));
+
+  Column result(AttrType::INTS, sizeof(int), row_num);
+  result.set_count(row_num);
+  result.merge_nulls(column);
+  ASSERT_TRUE(result.is_null(3));
+  ASSERT_FALSE(result.is_null(4));
+
+  Value null_value(0);
+  null_value.set_is_null(true);
+  Column constant;
+  constant.init(null_value, row_num);
+  ASSERT_TRUE(constant.is_null(5));
+
+  column.reset_data();
+  ASSERT_FALSE(column.has_null());
+}
+
 int main(int argc, char **argv)
 {
 
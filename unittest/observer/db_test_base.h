@@ -0,0 +1,83 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "gtest/gtest.h"
+#include "common/lang/filesystem.h"
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/tuple.h"
+#include "common/lang/vector.h"
+#include "storage/db/db.h"
+#include "storage/record/record.h"
+#include "storage/table/table.h"
+
+/**
+ * @brief 在一个临时目录中创建数据库的测试基类
+ * @details 每个测试开始前清空目录并打开数据库，结束后关闭数据库并删除目录。
+ * 数据库文件在 directory_ / "db" 中，测试可以在 directory_ 下存放其它文件。
+ */
+class DbTestBase : public testing::Test
+{
+public:
+  DbTestBase(const char *directory, const char *trx_kit_name, const char *log_handler_name)
+      : directory_(directory), trx_kit_name_(trx_kit_name), log_handler_name_(log_handler_name)
+  {}
+
+  void SetUp() override
+  {
+    filesystem::remove_all(directory_);
+    filesystem::create_directories(directory_ / "db");
+    ASSERT_EQ(RC::SUCCESS, open_db());
+  }
+
+  void TearDown() override
+  {
+    db_.reset();
+    filesystem::remove_all(directory_);
+  }
+
+  /// 关闭已经打开的数据库，再重新打开
+  RC open_db()
+  {
+    db_.reset();
+    db_ = make_unique<Db>();
+    return db_->init("test_db", (directory_ / "db").c_str(), trx_kit_name_, log_handler_name_);
+  }
+
+  /// 按照 (名称, 类型, 长度) 创建表的字段
+  Table *create_table(const char *table_name, const vector<tuple<const char *, AttrType, int>> &fields,
+      StorageFormat storage_format = StorageFormat::ROW_FORMAT)
+  {
+    vector<AttrInfoSqlNode> attr_infos(fields.size());
+    for (size_t i = 0; i < fields.size(); i++) {
+      attr_infos[i].name   = get<0>(fields[i]);
+      attr_infos[i].type   = get<1>(fields[i]);
+      attr_infos[i].length = get<2>(fields[i]);
+    }
+    EXPECT_EQ(RC::SUCCESS, db_->create_table(table_name, attr_infos, {}, storage_format));
+    return db_->find_table(table_name);
+  }
+
+  /// 不通过事务直接插入一行
+  RC insert_row(Table *table, const vector<Value> &values)
+  {
+    Record record;
+    RC     rc = table->make_record(values.size(), values.data(), record);
+    return OB_SUCC(rc) ? table->insert_record(record) : rc;
+  }
+
+protected:
+  filesystem::path directory_;
+  const char      *trx_kit_name_;
+  const char      *log_handler_name_;
+  unique_ptr<Db>   db_;
+};
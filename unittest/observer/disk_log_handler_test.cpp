@@ -180,6 +180,95 @@ TEST(DiskLogHandler, multi_thread)
   ASSERT_EQ(RC::SUCCESS, handler.await_termination());
 }
 
+TEST(DiskLogHandler, group_commit)
+{
+  const char *directory = "test_log_handler_group_commit";
+  filesystem::remove_all(directory);
+
+  DiskLogHandler  handler;
+  TestLogReplayer replayer;
+  ASSERT_EQ(RC::SUCCESS, handler.init(directory));
+  ASSERT_EQ(RC::SUCCESS, handler.replay(replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, handler.start());
+
+  // 每个线程模拟事务提交：写一条日志然后等待它落盘。
+  // 刷盘线程会被等待者立即唤醒，不应该每次提交都等待一个刷盘周期
+  const int      thread_num        = 4;
+  const int      commit_per_thread = 50;
+  atomic<int>    failed_count{0};
+  vector<thread> threads;
+
+  auto start_time = chrono::steady_clock::now();
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&handler, &failed_count]() {
+      for (int i = 0; i < commit_per_thread; i++) {
+        LSN          lsn = 0;
+        vector<char> data(10);
+        if (OB_FAIL(handler.append(lsn, LogModule::Id::BUFFER_POOL, std::move(data))) ||
+            OB_FAIL(handler.wait_lsn(lsn)) || handler.current_flushed_lsn() < lsn) {
+          failed_count++;
+        }
+      }
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start_time);
+
+  ASSERT_EQ(0, failed_count.load());
+  ASSERT_EQ(thread_num * commit_per_thread, handler.current_lsn());
+  ASSERT_LT(elapsed.count(), commit_per_thread * DiskLogHandler::FLUSH_INTERVAL.count());
+
+  ASSERT_EQ(RC::SUCCESS, handler.stop());
+  ASSERT_EQ(RC::SUCCESS, handler.await_termination());
+
+  // 刷盘线程退出后，等待一个不存在的LSN不会一直阻塞
+  ASSERT_EQ(RC::SUCCESS, handler.wait_lsn(handler.current_lsn()));
+  ASSERT_EQ(RC::INTERNAL, handler.wait_lsn(handler.current_lsn() + 1));
+
+  filesystem::remove_all(directory);
+}
+
+TEST(DiskLogHandler, truncate)
+{
+  const char *directory = "test_log_handler_truncate";
+  filesystem::remove_all(directory);
+
+  DiskLogHandler  handler;
+  TestLogReplayer replayer;
+  ASSERT_EQ(RC::SUCCESS, handler.init(directory));
+  ASSERT_EQ(RC::SUCCESS, handler.replay(replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, handler.start());
+
+  // 每个日志文件存放1000条日志
+  const int times = 3500;
+  for (int i = 0; i < times; ++i) {
+    LSN lsn = 0;
+    ASSERT_EQ(RC::SUCCESS, handler.append(lsn, LogModule::Id::BUFFER_POOL, vector<char>(10)));
+  }
+  ASSERT_EQ(RC::SUCCESS, handler.wait_lsn(handler.current_lsn()));
+
+  // 检查点是2500，前两个日志文件不再需要
+  const LSN check_point_lsn = 2500;
+  ASSERT_EQ(RC::SUCCESS, handler.truncate(check_point_lsn));
+  ASSERT_FALSE(filesystem::exists(filesystem::path(directory) / "clog_0.log"));
+  ASSERT_FALSE(filesystem::exists(filesystem::path(directory) / "clog_1000.log"));
+  ASSERT_TRUE(filesystem::exists(filesystem::path(directory) / "clog_2000.log"));
+
+  ASSERT_EQ(RC::SUCCESS, handler.stop());
+  ASSERT_EQ(RC::SUCCESS, handler.await_termination());
+
+  DiskLogHandler  handler2;
+  TestLogReplayer replayer2;
+  ASSERT_EQ(RC::SUCCESS, handler2.init(directory));
+  ASSERT_EQ(RC::SUCCESS, handler2.replay(replayer2, check_point_lsn));
+  ASSERT_EQ(times - check_point_lsn + 1, replayer2.count());
+  ASSERT_EQ(times, handler2.current_lsn());
+
+  filesystem::remove_all(directory);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
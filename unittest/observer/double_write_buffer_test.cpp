@@ -12,10 +12,14 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai on 2024/04/19
 //
 
+#include <fcntl.h>
 #include <filesystem>
+#include <unistd.h>
 
 #include "gtest/gtest.h"
 
+#include "common/math/crc.h"
+
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/buffer/double_write_buffer.h"
 #include "storage/clog/vacuous_log_handler.h"
@@ -201,6 +205,219 @@ TEST(DoubleWriteBuffer, single_file_exception)
   bpm  = nullptr;
 }
 
+static bool read_home_page(DiskBufferPool *buffer_pool, PageNum page_num, Page &page)
+{
+  return pread(buffer_pool->file_desc(), &page, sizeof(Page), ((int64_t)page_num) * sizeof(Page)) ==
+         static_cast<ssize_t>(sizeof(Page));
+}
+
+TEST(DoubleWriteBuffer, batch_flush)
+{
+  /*
+  攒够4个页面才一起刷盘，刷盘之前只能从double write buffer中读到页面，
+  刷盘之后页面都写到了数据文件中，double write buffer文件头中的页面个数清零
+  */
+  filesystem::path directory("double_write_buffer_test_batch_flush_dir");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename         = directory / "buffer_pool.bp";
+  filesystem::path double_write_buffer_filename = directory / "double_write_buffer.dwb";
+
+  auto              bpm = make_unique<BufferPoolManager>();
+  VacuousLogHandler log_handler;
+  auto              double_write_buffer = make_unique<DiskDoubleWriteBuffer>(*bpm, 4);
+  ASSERT_EQ(RC::SUCCESS, double_write_buffer->open_file(double_write_buffer_filename.c_str()));
+  ASSERT_EQ(bpm->init(std::move(double_write_buffer)), RC::SUCCESS);
+  DoubleWriteBuffer *dblwr_buffer = bpm->get_dblwr_buffer();
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  vector<Frame *> frames;
+  for (int i = 0; i < 4; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    frames.push_back(frame);
+  }
+
+  Page page;
+  for (int i = 0; i < 4; i++) {
+    memset(frames[i]->data(), 'a' + i, BP_PAGE_DATA_SIZE);
+    frames[i]->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_page(*frames[i]));
+    if (i == 3) {
+      break;
+    }
+
+    ASSERT_EQ(RC::SUCCESS, dblwr_buffer->read_page(buffer_pool, frames[i]->page_num(), page));
+    ASSERT_EQ('a' + i, page.data[0]);
+    ASSERT_FALSE(read_home_page(buffer_pool, frames[i]->page_num(), page) && page.data[0] == 'a' + i);
+  }
+
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(RC::BUFFERPOOL_INVALID_PAGE_NUM, dblwr_buffer->read_page(buffer_pool, frames[i]->page_num(), page));
+    ASSERT_TRUE(read_home_page(buffer_pool, frames[i]->page_num(), page));
+    ASSERT_EQ('a' + i, page.data[BP_PAGE_DATA_SIZE - 1]);
+    ASSERT_EQ(crc32(page.data, BP_PAGE_DATA_SIZE), page.check_sum);
+  }
+
+  DoubleWriteBufferHeader header;
+  header.page_cnt = -1;
+  int fd = open(double_write_buffer_filename.c_str(), O_RDONLY);
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(header)), pread(fd, &header, sizeof(header), 0));
+  close(fd);
+  ASSERT_EQ(0, header.page_cnt);
+
+  for (Frame *frame : frames) {
+    frame->unpin();
+  }
+  bpm = nullptr;
+}
+
+TEST(DoubleWriteBuffer, logged_page)
+{
+  /*
+  页面镜像已经记录在日志中的页面直接写入数据文件，并且丢弃double write buffer中的旧版本
+  */
+  filesystem::path directory("double_write_buffer_test_logged_page_dir");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename         = directory / "buffer_pool.bp";
+  filesystem::path double_write_buffer_filename = directory / "double_write_buffer.dwb";
+
+  auto              bpm = make_unique<BufferPoolManager>();
+  VacuousLogHandler log_handler;
+  auto              double_write_buffer = make_unique<DiskDoubleWriteBuffer>(*bpm, 4);
+  ASSERT_EQ(RC::SUCCESS, double_write_buffer->open_file(double_write_buffer_filename.c_str()));
+  ASSERT_EQ(bpm->init(std::move(double_write_buffer)), RC::SUCCESS);
+  DoubleWriteBuffer *dblwr_buffer = bpm->get_dblwr_buffer();
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+
+  Page page;
+  memset(frame->data(), 'x', BP_PAGE_DATA_SIZE);
+  frame->mark_dirty();
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_page(*frame));
+  ASSERT_EQ(RC::SUCCESS, dblwr_buffer->read_page(buffer_pool, frame->page_num(), page));
+
+  memset(frame->data(), 'y', BP_PAGE_DATA_SIZE);
+  frame->mark_dirty();
+  frame->mark_image_logged();
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_page(*frame));
+  ASSERT_FALSE(frame->image_logged());
+  ASSERT_EQ(RC::BUFFERPOOL_INVALID_PAGE_NUM, dblwr_buffer->read_page(buffer_pool, frame->page_num(), page));
+
+  ASSERT_EQ(RC::SUCCESS, static_cast<DiskDoubleWriteBuffer *>(dblwr_buffer)->flush_page());
+  ASSERT_TRUE(read_home_page(buffer_pool, frame->page_num(), page));
+  ASSERT_EQ('y', page.data[0]);
+
+  frame->unpin();
+  bpm = nullptr;
+}
+
+TEST(DoubleWriteBuffer, recover_torn_page)
+{
+  /*
+  模拟刷盘过程中崩溃：double write buffer文件中有完整的页面，数据文件中一个页面只写了一半，
+  另一个页面已经写入了更新的版本。恢复时只修复写了一半的页面
+  */
+  filesystem::path directory("double_write_buffer_test_recover_torn_page_dir");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename         = directory / "buffer_pool.bp";
+  filesystem::path double_write_buffer_filename = directory / "double_write_buffer.dwb";
+
+  auto              bpm = make_unique<BufferPoolManager>();
+  VacuousLogHandler log_handler;
+  auto              double_write_buffer = make_unique<DiskDoubleWriteBuffer>(*bpm, 16);
+  ASSERT_EQ(RC::SUCCESS, double_write_buffer->open_file(double_write_buffer_filename.c_str()));
+  ASSERT_EQ(bpm->init(std::move(double_write_buffer)), RC::SUCCESS);
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(buffer_pool_filename.c_str()));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  vector<PageNum> page_nums;
+  for (int i = 0; i < 4; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    memset(frame->data(), 'a' + i, BP_PAGE_DATA_SIZE);
+    frame->mark_dirty();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_page(*frame));
+    page_nums.push_back(frame->page_num());
+    frame->unpin();
+  }
+
+  // 页面只保存在内存中，刷盘时和文件头一起写到共享文件中，数据文件写完之后文件头中的页面个数清零
+  const uintmax_t empty_size = filesystem::file_size(double_write_buffer_filename);
+  ASSERT_EQ(RC::SUCCESS, static_cast<DiskDoubleWriteBuffer *>(bpm->get_dblwr_buffer())->flush_page());
+  ASSERT_GT(filesystem::file_size(double_write_buffer_filename), empty_size);
+  int fd = open(double_write_buffer_filename.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  DoubleWriteBufferHeader header;
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(header)), pread(fd, &header, sizeof(header), 0));
+  ASSERT_EQ(0, header.page_cnt);
+  close(fd);
+
+  // 关闭时刷文件头页面会覆盖共享文件，先把刷盘后的共享文件保存下来
+  filesystem::path backup_filename = directory / "double_write_buffer.dwb.bak";
+  filesystem::copy_file(double_write_buffer_filename, backup_filename);
+  bpm = nullptr;
+  filesystem::copy_file(backup_filename, double_write_buffer_filename, filesystem::copy_options::overwrite_existing);
+
+  // 刷盘的页面还留在double write buffer文件中，恢复文件头中的页面个数。
+  // 页面个数大于实际写入的个数，加载页面时读到文件末尾就结束
+  fd = open(double_write_buffer_filename.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  header.page_cnt = 16;
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(header)), pwrite(fd, &header, sizeof(header), 0));
+  close(fd);
+
+  fd = open(buffer_pool_filename.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  Page page;
+  // 第一个页面写了一半
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(fd, &page, sizeof(page), ((int64_t)page_nums[0]) * sizeof(Page)));
+  memset(page.data, 'z', BP_PAGE_DATA_SIZE / 2);
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pwrite(fd, &page, sizeof(page), ((int64_t)page_nums[0]) * sizeof(Page)));
+  // 第二个页面已经写入了更新的版本
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pread(fd, &page, sizeof(page), ((int64_t)page_nums[1]) * sizeof(Page)));
+  memset(page.data, 'n', BP_PAGE_DATA_SIZE);
+  page.lsn += 100;
+  page.check_sum = crc32(page.data, BP_PAGE_DATA_SIZE);
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(page)), pwrite(fd, &page, sizeof(page), ((int64_t)page_nums[1]) * sizeof(Page)));
+  close(fd);
+
+  bpm                 = make_unique<BufferPoolManager>();
+  double_write_buffer = make_unique<DiskDoubleWriteBuffer>(*bpm, 16);
+  ASSERT_EQ(RC::SUCCESS, double_write_buffer->open_file(double_write_buffer_filename.c_str()));
+  ASSERT_EQ(bpm->init(std::move(double_write_buffer)), RC::SUCCESS);
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  DiskDoubleWriteBuffer *disk_double_write_buffer = static_cast<DiskDoubleWriteBuffer *>(bpm->get_dblwr_buffer());
+  ASSERT_EQ(RC::SUCCESS, disk_double_write_buffer->recover());
+
+  ASSERT_TRUE(read_home_page(buffer_pool, page_nums[0], page));
+  ASSERT_EQ('a', page.data[0]);
+  ASSERT_EQ(crc32(page.data, BP_PAGE_DATA_SIZE), page.check_sum);
+  ASSERT_TRUE(read_home_page(buffer_pool, page_nums[1], page));
+  ASSERT_EQ('n', page.data[0]);
+  for (int i = 2; i < 4; i++) {
+    ASSERT_TRUE(read_home_page(buffer_pool, page_nums[i], page));
+    ASSERT_EQ('a' + i, page.data[0]);
+  }
+  bpm = nullptr;
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -312,6 +312,29 @@ TEST(ComparisonExpr, comparison_expr_test)
   }
 }
 
+TEST(CorrelatedFieldExpr, shared_value)
+{
+  FieldMeta field_meta("col1", AttrType::INTS, 0, sizeof(int), true, 0, false);
+  Field     field(nullptr, &field_meta);
+
+  CorrelatedFieldExpr    expr(field);
+  unique_ptr<Expression> copied = expr.copy();
+  ASSERT_EQ(ExprType::CORRELATED_FIELD, copied->type());
+  ASSERT_EQ(AttrType::INTS, copied->value_type());
+  ASSERT_TRUE(expr.equal(*copied));
+  ASSERT_FALSE(expr.equal(CorrelatedFieldExpr(field)));
+
+  // 复制的表达式共享外层查询的值，设置之后所有的副本都能取到
+  RowTuple tuple;
+  Value    value;
+  expr.set_value(Value(7));
+  ASSERT_EQ(RC::SUCCESS, copied->get_value(tuple, value));
+  ASSERT_EQ(7, value.get_int());
+  static_cast<CorrelatedFieldExpr &>(*copied).set_value(Value(9));
+  ASSERT_EQ(RC::SUCCESS, expr.get_value(tuple, value));
+  ASSERT_EQ(9, value.get_int());
+}
+
 TEST(AggregateExpr, aggregate_expr_test)
 {
   Value                  int_value(1);
@@ -0,0 +1,243 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "common/lang/cmath.h"
+#include "common/lang/vector.h"
+#include "db_test_base.h"
+#include "sql/optimizer/statistics/table_statistics.h"
+#include "storage/index/index.h"
+#include "storage/record/record_manager.h"
+#include "storage/record/record_scanner.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+class HeapTableEngineTest : public DbTestBase
+{
+public:
+  HeapTableEngineTest() : DbTestBase("heap_table_engine_test", "vacuous", "vacuous") {}
+
+  void SetUp() override
+  {
+    DbTestBase::SetUp();
+    table_ = create_table("t", {{"id", AttrType::INTS, 4}, {"val", AttrType::INTS, 4}});
+    ASSERT_NE(nullptr, table_);
+
+    const FieldMeta *id_field  = table_->table_meta().field("id");
+    const FieldMeta *val_field = table_->table_meta().field("val");
+    ASSERT_EQ(RC::SUCCESS, table_->create_index(nullptr, {id_field}, "idx_id", true /*unique*/));
+    ASSERT_EQ(RC::SUCCESS, table_->create_index(nullptr, {val_field}, "idx_val", false));
+  }
+
+  RC insert(int id, int val) { return insert_row(table_, {Value(id), Value(val)}); }
+
+  /// 索引中等于 value 的索引项个数
+  int index_count(const char *index_name, int value)
+  {
+    vector<Value> values{Value(value)};
+    IndexScanner *scanner = table_->find_index(index_name)->create_scanner(values, true, values, true);
+    EXPECT_NE(nullptr, scanner);
+    int count = 0;
+    RID rid;
+    while (OB_SUCC(scanner->next_entry(&rid))) {
+      count++;
+    }
+    delete scanner;
+    return count;
+  }
+
+  int row_count()
+  {
+    RecordScanner *scanner = nullptr;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY));
+    int    count = 0;
+    Record record;
+    while (OB_SUCC(scanner->next(record))) {
+      count++;
+    }
+    scanner->close_scan();
+    delete scanner;
+    return count;
+  }
+
+protected:
+  Table *table_ = nullptr;
+};
+
+/// 事务模型为 mvcc 的数据库，表中有事务字段
+class HeapTableEngineMvccTest : public DbTestBase
+{
+public:
+  HeapTableEngineMvccTest() : DbTestBase("heap_table_engine_mvcc_test", "mvcc", "vacuous") {}
+};
+
+TEST_F(HeapTableEngineTest, bulk_insert)
+{
+  const int row_num = 5000;
+  ASSERT_EQ(RC::SUCCESS, table_->begin_bulk_insert());
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert(i, i % 10));
+  }
+  // 导入结束之前空的索引中还没有数据
+  EXPECT_EQ(0, index_count("idx_id", 1));
+  ASSERT_EQ(RC::SUCCESS, table_->end_bulk_insert());
+
+  EXPECT_EQ(1, index_count("idx_id", 0));
+  EXPECT_EQ(1, index_count("idx_id", row_num - 1));
+  EXPECT_EQ(row_num / 10, index_count("idx_val", 3));
+
+  // 索引不再为空，之后的导入逐条插入并检查唯一性
+  ASSERT_EQ(RC::SUCCESS, table_->begin_bulk_insert());
+  EXPECT_EQ(RC::RECORD_NOT_UNIQUE, insert(0, 0));
+  EXPECT_EQ(RC::SUCCESS, insert(row_num, 0));
+  ASSERT_EQ(RC::SUCCESS, table_->end_bulk_insert());
+  EXPECT_EQ(1, index_count("idx_id", row_num));
+  EXPECT_EQ(row_num + 1, row_count());
+}
+
+TEST_F(HeapTableEngineTest, bulk_insert_not_unique)
+{
+  ASSERT_EQ(RC::SUCCESS, table_->begin_bulk_insert());
+  for (int i = 0; i < 1000; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert(i % 999, i));
+  }
+  // 唯一索引在构建时才发现重复的值，导入的数据全部删除
+  EXPECT_EQ(RC::RECORD_NOT_UNIQUE, table_->end_bulk_insert());
+  EXPECT_EQ(0, row_count());
+  EXPECT_EQ(0, index_count("idx_id", 1));
+  EXPECT_EQ(0, index_count("idx_val", 1));
+
+  ASSERT_EQ(RC::SUCCESS, insert(1, 1));
+  EXPECT_EQ(1, index_count("idx_id", 1));
+  EXPECT_EQ(1, row_count());
+}
+
+TEST_F(HeapTableEngineTest, raw_key_index)
+{
+  Table *table = create_table("docs", {{"id", AttrType::INTS, 4}, {"doc", AttrType::TEXTS, 4}});
+  ASSERT_NE(nullptr, table);
+
+  // TEXTS 不能编码，单字段索引存放原始数据，多字段索引不支持
+  const FieldMeta *id_field  = table->table_meta().field("id");
+  const FieldMeta *doc_field = table->table_meta().field("doc");
+  EXPECT_EQ(RC::UNSUPPORTED, table->create_index(nullptr, {id_field, doc_field}, "idx_id_doc", false));
+  ASSERT_EQ(RC::SUCCESS, table->create_index(nullptr, {doc_field}, "idx_doc", false));
+
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert_row(table, {Value(i), Value("text")}));
+  }
+
+  IndexScanner *scanner = table->find_index("idx_doc")->create_scanner(nullptr, 0, true, nullptr, 0, true);
+  ASSERT_NE(nullptr, scanner);
+  int count = 0;
+  RID rid;
+  while (OB_SUCC(scanner->next_entry(&rid))) {
+    count++;
+  }
+  delete scanner;
+  EXPECT_EQ(10, count);
+
+  // 重新打开时按照索引文件中的字段类型识别出原始数据的索引
+  ASSERT_EQ(RC::SUCCESS, open_db());
+  EXPECT_NE(nullptr, db_->find_table("docs")->find_index("idx_doc"));
+}
+
+TEST_F(HeapTableEngineMvccTest, pax_field_position)
+{
+  Table *table = create_table("t", {{"a", AttrType::INTS, 4}, {"b", AttrType::INTS, 4}}, StorageFormat::PAX_FORMAT);
+  ASSERT_NE(nullptr, table);
+  const TableMeta &table_meta = table->table_meta();
+
+  // 事务字段在前面，用户字段仍然从 0 开始编号，列的位置由字段在表中的位置决定
+  const FieldMeta *field_b = table_meta.field("b");
+  ASSERT_NE(nullptr, field_b);
+  EXPECT_EQ(1, field_b->field_id());
+  EXPECT_EQ(table_meta.sys_field_num() + 1, table_meta.field_index(field_b));
+
+  const int row_num = 100;
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert_row(table, {Value(i), Value(i * 2)}));
+  }
+
+  ChunkFileScanner scanner;
+  ASSERT_EQ(RC::SUCCESS, table->get_chunk_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY));
+  Chunk chunk;
+  for (int i = 0; i < table_meta.field_num(); i++) {
+    chunk.add_column(make_unique<Column>(*table_meta.field(i)), i);
+  }
+  int count = 0;
+  RC  rc    = RC::SUCCESS;
+  while (OB_SUCC(rc = scanner.next_chunk(chunk))) {
+    for (int i = 0; i < chunk.rows(); i++) {
+      EXPECT_EQ(2 * chunk.get_value(table_meta.field_index(table_meta.field("a")), i).get_int(),
+          chunk.get_value(table_meta.field_index(field_b), i).get_int());
+    }
+    count += chunk.rows();
+    chunk.reset_data();
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  EXPECT_EQ(row_num, count);
+}
+
+TEST_F(HeapTableEngineTest, sample_scanner)
+{
+  Table *table = create_table("wide", {{"id", AttrType::INTS, 4}, {"padding", AttrType::CHARS, 200}});
+  ASSERT_NE(nullptr, table);
+
+  // 数据页面远多于 DEFAULT_SAMPLE_PAGES，采样时只读取部分页面
+  const int row_num = 40000;
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, insert_row(table, {Value(i), Value("padding")}));
+  }
+
+  RecordScanner *scanner         = nullptr;
+  double         sample_fraction = 0;
+  ASSERT_EQ(RC::SUCCESS, table->get_sample_scanner(scanner, nullptr, TableStatistics::DEFAULT_SAMPLE_PAGES, sample_fraction));
+  EXPECT_GT(sample_fraction, 0.1);
+  EXPECT_LT(sample_fraction, 0.9);
+
+  int    sampled_rows = 0;
+  int    min_id       = row_num;
+  int    max_id       = -1;
+  Record record;
+  RC     rc = RC::SUCCESS;
+  while (OB_SUCC(rc = scanner->next(record))) {
+    const int id = *reinterpret_cast<const int *>(record.data() + table->table_meta().field("id")->offset());
+    min_id       = min(min_id, id);
+    max_id       = max(max_id, id);
+    sampled_rows++;
+  }
+  EXPECT_EQ(RC::RECORD_EOF, rc);
+  scanner->close_scan();
+  delete scanner;
+
+  // 采样的页面均匀分布在整个文件中，按照比例放大之后接近全表的行数
+  EXPECT_LT(abs(sampled_rows / sample_fraction - row_num), row_num * 0.05);
+  EXPECT_LT(min_id, row_num / 10);
+  EXPECT_GT(max_id, row_num * 9 / 10);
+
+  auto statistics = make_shared<TableStatistics>();
+  ASSERT_EQ(RC::SUCCESS, TableStatistics::collect(table, nullptr, TableStatistics::DEFAULT_SAMPLE_PAGES, *statistics));
+  EXPECT_EQ(sampled_rows, statistics->sampled_rows());
+  EXPECT_LT(abs(statistics->row_num() - row_num), row_num * 0.05);
+
+  // 更新统计信息不会替换字段等元数据
+  const FieldMeta *field = table->table_meta().field("id");
+  ASSERT_EQ(RC::SUCCESS, table->update_statistics(statistics));
+  EXPECT_EQ(field, table->table_meta().field("id"));
+  EXPECT_EQ(statistics, table->table_meta().statistics());
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
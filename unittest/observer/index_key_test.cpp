@@ -0,0 +1,144 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "common/lang/algorithm.h"
+#include "common/lang/vector.h"
+#include "storage/index/index_key.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static int sign(int v) { return v < 0 ? -1 : (v > 0 ? 1 : 0); }
+
+static vector<char> encode(const IndexKeyEncoder &encoder, const vector<Value> &values)
+{
+  vector<char> key(encoder.key_length());
+  EXPECT_EQ(RC::SUCCESS, encoder.encode_values(values, '\x00', key.data()));
+  return key;
+}
+
+static int compare_key(const vector<char> &left, const vector<char> &right)
+{
+  return sign(memcmp(left.data(), right.data(), left.size()));
+}
+
+TEST(IndexKeyTest, single_field_order)
+{
+  {
+    IndexKeyEncoder encoder;
+    ASSERT_EQ(RC::SUCCESS, encoder.init({FieldMeta("a", AttrType::INTS, 0, 4, true, 0, false)}));
+
+    vector<int> ints = {INT32_MIN, -100, -1, 0, 1, 7, 100, INT32_MAX};
+    for (int l : ints) {
+      for (int r : ints) {
+        ASSERT_EQ(sign((l > r) - (l < r)), compare_key(encode(encoder, {Value(l)}), encode(encoder, {Value(r)})))
+            << l << " vs " << r;
+      }
+    }
+  }
+
+  {
+    IndexKeyEncoder encoder;
+    ASSERT_EQ(RC::SUCCESS, encoder.init({FieldMeta("a", AttrType::FLOATS, 0, 4, true, 0, false)}));
+
+    vector<float> floats = {-1e30f, -2.5f, -1.0f, -0.0f, 0.0f, 1e-20f, 1.0f, 2.5f, 1e30f};
+    for (float l : floats) {
+      for (float r : floats) {
+        ASSERT_EQ((l > r) - (l < r), compare_key(encode(encoder, {Value(l)}), encode(encoder, {Value(r)})))
+            << l << " vs " << r;
+      }
+    }
+  }
+
+  {
+    IndexKeyEncoder encoder;
+    ASSERT_EQ(RC::SUCCESS, encoder.init({FieldMeta("a", AttrType::CHARS, 0, 8, true, 0, false)}));
+
+    vector<const char *> strs = {"", "a", "ab", "abc", "b", "ba", "zzzzzzzz"};
+    for (const char *l : strs) {
+      for (const char *r : strs) {
+        ASSERT_EQ(sign(strcmp(l, r)), compare_key(encode(encoder, {Value(l)}), encode(encoder, {Value(r)})))
+            << l << " vs " << r;
+      }
+    }
+
+    // 记录中结束符之后的残留数据不影响键值
+    char record1[8] = {'a', 'b', '\0', 'x', 'y', 'z', '1', '2'};
+    char record2[8] = {'a', 'b', '\0', '\0', '\0', '\0', '\0', '\0'};
+    vector<char> key1(encoder.key_length());
+    vector<char> key2(encoder.key_length());
+    encoder.encode_record(record1, key1.data());
+    encoder.encode_record(record2, key2.data());
+    ASSERT_EQ(0, compare_key(key1, key2));
+  }
+}
+
+TEST(IndexKeyTest, multi_field_order)
+{
+  IndexKeyEncoder encoder;
+  vector<FieldMeta> field_metas = {
+      FieldMeta("a", AttrType::INTS, 0, 4, true, 0, false),
+      FieldMeta("b", AttrType::CHARS, 4, 4, true, 1, false),
+      FieldMeta("c", AttrType::FLOATS, 8, 4, true, 2, false),
+  };
+  ASSERT_EQ(RC::SUCCESS, encoder.init(field_metas));
+  ASSERT_EQ(12, encoder.key_length());
+  ASSERT_EQ(3, encoder.field_num());
+
+  struct Row
+  {
+    int         a;
+    const char *b;
+    float       c;
+  };
+  vector<Row> rows = {
+      {-5, "zz", 1.0f}, {-5, "zz", 2.0f}, {0, "", -1.0f}, {0, "a", -3.0f}, {0, "a", 0.0f}, {0, "b", -10.0f}, {3, "a", 0.0f}};
+
+  vector<vector<char>> keys;
+  for (const Row &row : rows) {
+    char record[12] = {0};
+    memcpy(record, &row.a, sizeof(row.a));
+    strncpy(record + 4, row.b, 4);
+    memcpy(record + 8, &row.c, sizeof(row.c));
+
+    vector<char> key(encoder.key_length());
+    encoder.encode_record(record, key.data());
+    ASSERT_EQ(0, compare_key(key, encode(encoder, {Value(row.a), Value(row.b), Value(row.c)})));
+    keys.push_back(key);
+  }
+
+  // rows 已经按照 (a, b, c) 排好序
+  for (size_t i = 1; i < keys.size(); i++) {
+    ASSERT_EQ(-1, compare_key(keys[i - 1], keys[i])) << i;
+  }
+
+  // 前缀编码，剩余字段使用最小值或者最大值填充
+  vector<char> lower(encoder.key_length());
+  vector<char> upper(encoder.key_length());
+  ASSERT_EQ(RC::SUCCESS, encoder.encode_values({Value(0)}, '\x00', lower.data()));
+  ASSERT_EQ(RC::SUCCESS, encoder.encode_values({Value(0)}, '\xFF', upper.data()));
+  for (size_t i = 0; i < keys.size(); i++) {
+    const bool in_range = compare_key(lower, keys[i]) <= 0 && compare_key(keys[i], upper) <= 0;
+    ASSERT_EQ(rows[i].a == 0, in_range) << i;
+  }
+
+  // 类型不匹配
+  vector<char> key(encoder.key_length());
+  ASSERT_EQ(RC::SCHEMA_FIELD_TYPE_MISMATCH, encoder.encode_values({Value(1.0f)}, '\x00', key.data()));
+  ASSERT_NE(RC::SUCCESS, encoder.encode_values({Value(0), Value("a"), Value(1.0f), Value(1)}, '\x00', key.data()));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,200 @@
+/* Copyright (c) 2021-2022 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <filesystem>
+
+#include "gtest/gtest.h"
+#include "common/lang/string.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+#include "common/math/integer_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/index/bplus_tree.h"
+#include "storage/record/record_manager.h"
+
+using namespace std;
+using namespace common;
+
+TEST(IntegratedLogReplayer, parallel_replay)
+{
+  /*
+   * 测试场景：
+   * 1. 创建多个数据文件和一个索引文件，随机插入、更新、删除记录，同时向索引中插入数据
+   * 2. 不刷脏页，使用多个线程回放日志
+   * 3. 检查每个文件中的记录和索引中的数据
+   */
+  filesystem::path directory("integrated_log_replayer_test");
+  filesystem::remove_all(directory);
+  ASSERT_TRUE(filesystem::create_directories(directory));
+
+  const int                file_num = 4;
+  vector<filesystem::path> record_files;
+  for (int i = 0; i < file_num; i++) {
+    record_files.push_back(directory / ("record_" + to_string(i) + ".bp"));
+  }
+  const filesystem::path index_file = directory / "index.bp";
+
+  const int record_size = 64;
+  using RecordMap       = unordered_map<RID, string, RIDHash>;
+  vector<RecordMap> record_maps(file_num);
+  const int         index_key_num = 4000;
+
+  {
+    // 缓冲池关闭文件时还会用到日志模块，所以要先于日志模块析构
+    DiskLogHandler    log_handler;
+    BufferPoolManager bpm;
+    ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+    IntegratedLogReplayer log_replayer(bpm);
+    ASSERT_EQ(RC::SUCCESS, log_handler.init(directory.c_str()));
+    ASSERT_EQ(RC::SUCCESS, log_handler.replay(log_replayer, 0));
+    ASSERT_EQ(RC::SUCCESS, log_handler.start());
+
+    vector<unique_ptr<RecordFileHandler>> record_handlers;
+    for (const filesystem::path &file : record_files) {
+      DiskBufferPool *buffer_pool = nullptr;
+      ASSERT_EQ(RC::SUCCESS, bpm.create_file(file.c_str()));
+      ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, file.c_str(), buffer_pool));
+      auto handler = make_unique<RecordFileHandler>(StorageFormat::ROW_FORMAT);
+      ASSERT_EQ(RC::SUCCESS, handler->init(*buffer_pool, log_handler, nullptr, nullptr));
+      record_handlers.push_back(std::move(handler));
+    }
+
+    DiskBufferPool *index_buffer_pool = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(index_file.c_str()));
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, index_file.c_str(), index_buffer_pool));
+    BplusTreeHandler tree_handler;
+    ASSERT_EQ(RC::SUCCESS, tree_handler.create(log_handler, *index_buffer_pool, AttrType::INTS, sizeof(int)));
+
+    // 不同文件的日志交错在一起
+    IntegerGenerator file_random(0, file_num - 1);
+    IntegerGenerator operation_random(0, 3);
+    const int        operation_num = 8000;
+    int              next_key      = 0;
+    for (int i = 0; i < operation_num; i++) {
+      const int          file_index = file_random.next();
+      RecordFileHandler &handler    = *record_handlers[file_index];
+      RecordMap         &record_map = record_maps[file_index];
+
+      string data(record_size, 0);
+      snprintf(data.data(), record_size, "file %d operation %d", file_index, i);
+
+      const int operation = record_map.empty() ? 0 : operation_random.next();
+      if (operation <= 1) {
+        RID rid;
+        ASSERT_EQ(RC::SUCCESS, handler.insert_record(data.data(), record_size, &rid));
+        record_map[rid] = data;
+      } else {
+        auto iter = record_map.begin();
+        advance(iter, IntegerGenerator(0, record_map.size() - 1).next());
+        RID rid = iter->first;
+        if (operation == 2) {
+          ASSERT_EQ(RC::SUCCESS, handler.visit_record(rid, [&data](Record &record) {
+            memcpy(record.data(), data.data(), record_size);
+            return true;
+          }));
+          iter->second = data;
+        } else {
+          ASSERT_EQ(RC::SUCCESS, handler.delete_record(&rid));
+          record_map.erase(iter);
+        }
+      }
+
+      if (next_key < index_key_num && i % 2 == 0) {
+        const int key = next_key * 7919 % index_key_num;  // 乱序插入，触发索引的分裂
+        RID       rid(key, key);
+        ASSERT_EQ(RC::SUCCESS, tree_handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+        next_key++;
+      }
+    }
+    ASSERT_EQ(index_key_num, next_key);
+
+    ASSERT_EQ(RC::SUCCESS, log_handler.stop());
+    ASSERT_EQ(RC::SUCCESS, log_handler.await_termination());
+
+    // 在关闭文件刷脏页之前把文件复制出来，恢复时只能依靠日志
+    for (const filesystem::path &file : record_files) {
+      ASSERT_TRUE(filesystem::copy_file(file, filesystem::path(file).concat(".copy")));
+    }
+    ASSERT_TRUE(filesystem::copy_file(index_file, filesystem::path(index_file).concat(".copy")));
+
+    ASSERT_EQ(RC::SUCCESS, tree_handler.close());
+    record_handlers.clear();
+  }
+
+  for (const filesystem::path &file : record_files) {
+    filesystem::rename(filesystem::path(file).concat(".copy"), file);
+  }
+  filesystem::rename(filesystem::path(index_file).concat(".copy"), index_file);
+
+  DiskLogHandler    log_handler2;
+  BufferPoolManager bpm2;
+  ASSERT_EQ(RC::SUCCESS, bpm2.init(make_unique<VacuousDoubleWriteBuffer>()));
+  vector<DiskBufferPool *> buffer_pools(file_num, nullptr);
+  for (int i = 0; i < file_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, bpm2.open_file(log_handler2, record_files[i].c_str(), buffer_pools[i]));
+  }
+  DiskBufferPool *index_buffer_pool2 = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm2.open_file(log_handler2, index_file.c_str(), index_buffer_pool2));
+
+  IntegratedLogReplayer log_replayer2(bpm2);
+  log_replayer2.set_worker_num(4);
+#ifdef CONCURRENCY
+  ASSERT_EQ(4, log_replayer2.worker_num());
+#else
+  ASSERT_EQ(1, log_replayer2.worker_num());
+#endif
+  ASSERT_EQ(RC::SUCCESS, log_handler2.init(directory.c_str()));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.replay(log_replayer2, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler2.start());
+
+  for (int i = 0; i < file_num; i++) {
+    RecordFileHandler handler(StorageFormat::ROW_FORMAT);
+    ASSERT_EQ(RC::SUCCESS, handler.init(*buffer_pools[i], log_handler2, nullptr, nullptr));
+    for (const auto &[rid, data] : record_maps[i]) {
+      Record record;
+      ASSERT_EQ(RC::SUCCESS, handler.get_record(rid, record)) << "file " << i << ", rid " << rid.to_string();
+      ASSERT_EQ(0, memcmp(record.data(), data.data(), record_size));
+    }
+    handler.close();
+  }
+
+  BplusTreeHandler tree_handler2;
+  ASSERT_EQ(RC::SUCCESS, tree_handler2.open(log_handler2, *index_buffer_pool2));
+  BplusTreeScanner scanner(tree_handler2);
+  ASSERT_EQ(RC::SUCCESS, scanner.open(nullptr, 0, true, nullptr, 0, true));
+  RC  rc    = RC::SUCCESS;
+  RID rid;
+  int count = 0;
+  while (OB_SUCC(rc = scanner.next_entry(rid))) {
+    ASSERT_EQ(count, rid.page_num);
+    count++;
+  }
+  ASSERT_EQ(RC::RECORD_EOF, rc);
+  ASSERT_EQ(RC::SUCCESS, scanner.close());
+  ASSERT_EQ(index_key_num, count);
+  ASSERT_EQ(RC::SUCCESS, tree_handler2.close());
+
+  ASSERT_EQ(RC::SUCCESS, log_handler2.stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler2.await_termination());
+  filesystem::remove_all(directory);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  filesystem::path log_filename = filesystem::path(argv[0]).filename();
+  LoggerFactory::init_default(log_filename.string() + ".log", LOG_LEVEL_INFO);
+  return RUN_ALL_TESTS();
+}
@@ -66,6 +66,83 @@ TEST(LogEntryBuffer, test_append)
   filesystem::remove("test_log_entry_buffer.log");
 }
 
+TEST(LogEntryBuffer, test_concurrent_append)
+{
+  // 使用很小的缓冲区，让槽位不断地被复用，并且有一部分日志超过槽位大小
+  const char *filename = "test_log_entry_buffer_concurrent.log";
+  filesystem::remove(filename);
+
+  LogEntryBuffer buffer;
+  ASSERT_EQ(RC::SUCCESS, buffer.init(0, 16 * LogEntryBuffer::SLOT_SIZE));
+
+  LogFileWriter writer;
+  ASSERT_EQ(RC::SUCCESS, writer.open(filename, 1 << 30));
+
+  const int  thread_num       = 4;
+  const int  entry_per_thread = 500;
+  auto       payload_size     = [](int tid, int i) { return 8 + (tid * 131 + i * 37) % 1200; };
+  atomic_int finished_threads{0};
+
+  thread flusher([&]() {
+    while (finished_threads.load() < thread_num || buffer.entry_number() > 0) {
+      int count = 0;
+      ASSERT_EQ(RC::SUCCESS, buffer.flush(writer, count));
+      if (count == 0) {
+        this_thread::yield();
+      }
+    }
+  });
+
+  vector<thread> threads;
+  for (int tid = 0; tid < thread_num; tid++) {
+    threads.emplace_back([&, tid]() {
+      for (int i = 0; i < entry_per_thread; i++) {
+        vector<char> data(payload_size(tid, i), static_cast<char>(tid * 7 + i));
+        memcpy(data.data(), &tid, sizeof(tid));
+        memcpy(data.data() + sizeof(tid), &i, sizeof(i));
+        LSN lsn = 0;
+        ASSERT_EQ(RC::SUCCESS, buffer.append(lsn, LogModule::Id::BUFFER_POOL, data));
+      }
+      finished_threads++;
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+  flusher.join();
+
+  ASSERT_EQ(thread_num * entry_per_thread, buffer.flushed_lsn());
+  ASSERT_EQ(0, buffer.bytes());
+  writer.close();
+
+  // 日志按照LSN顺序写入文件，每个线程的日志保持写入的顺序，内容没有被覆盖
+  LogFileReader reader;
+  ASSERT_EQ(RC::SUCCESS, reader.open(filename));
+  LSN         expected_lsn = 1;
+  vector<int> next_index(thread_num, 0);
+  RC rc = reader.iterate([&](LogEntry &entry) -> RC {
+    EXPECT_EQ(expected_lsn++, entry.lsn());
+    int tid = 0, i = 0;
+    memcpy(&tid, entry.data(), sizeof(tid));
+    memcpy(&i, entry.data() + sizeof(tid), sizeof(i));
+    EXPECT_TRUE(tid >= 0 && tid < thread_num);
+    EXPECT_EQ(next_index[tid]++, i);
+    EXPECT_EQ(payload_size(tid, i), entry.payload_size());
+    for (int pos = sizeof(tid) + sizeof(i); pos < entry.payload_size(); pos++) {
+      if (entry.data()[pos] != static_cast<char>(tid * 7 + i)) {
+        ADD_FAILURE() << "corrupted log entry. lsn=" << entry.lsn() << ", pos=" << pos;
+        return RC::INTERNAL;
+      }
+    }
+    return RC::SUCCESS;
+  });
+  ASSERT_EQ(RC::SUCCESS, rc);
+  ASSERT_EQ(thread_num * entry_per_thread + 1, expected_lsn);
+  reader.close();
+
+  filesystem::remove(filename);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -390,6 +390,74 @@ TEST(LogFileManager, next_file)
   filesystem::remove_all(directory);
 }
 
+TEST(LogFileManager, truncate)
+{
+  const char *directory                 = "truncate";
+  const char *archive_directory         = "truncate_archive";
+  int         max_entry_number_per_file = 1000;
+
+  filesystem::remove_all(directory);
+  filesystem::remove_all(archive_directory);
+  ASSERT_TRUE(filesystem::create_directory(directory));
+
+  LSN            lsns[] = {0, 1000, 2000, 3000};
+  vector<string> files;
+  for (LSN lsn : lsns) {
+    string filename = string(LogFileManager::file_prefix_) + to_string(lsn) + LogFileManager::file_suffix_;
+    files.push_back(filename);
+    ofstream ofs(filesystem::path(directory) / filename);
+    ofs.close();
+  }
+
+  LogFileManager manager;
+  ASSERT_EQ(RC::SUCCESS, manager.init(directory, max_entry_number_per_file));
+
+  // 第一个文件中还有需要回放的日志，不能删除
+  int removed_count = -1;
+  ASSERT_EQ(RC::SUCCESS, manager.truncate(999, removed_count));
+  ASSERT_EQ(0, removed_count);
+
+  // 删除
+  ASSERT_EQ(RC::SUCCESS, manager.truncate(1000, removed_count));
+  ASSERT_EQ(1, removed_count);
+  ASSERT_FALSE(filesystem::exists(filesystem::path(directory) / files[0]));
+
+  vector<string> result_files;
+  ASSERT_EQ(RC::SUCCESS, manager.list_files(result_files, 0));
+  ASSERT_EQ(3, result_files.size());
+  ASSERT_EQ(files[1], filesystem::path(result_files[0]).filename());
+
+  // 归档
+  ASSERT_EQ(RC::SUCCESS, manager.set_archive_directory(archive_directory));
+  ASSERT_EQ(RC::SUCCESS, manager.truncate(2500, removed_count));
+  ASSERT_EQ(1, removed_count);
+  ASSERT_FALSE(filesystem::exists(filesystem::path(directory) / files[1]));
+  ASSERT_TRUE(filesystem::exists(filesystem::path(archive_directory) / files[1]));
+  ASSERT_TRUE(filesystem::exists(filesystem::path(directory) / files[2]));
+
+  // 最后一个文件总是保留
+  ASSERT_EQ(RC::SUCCESS, manager.truncate(10000, removed_count));
+  ASSERT_EQ(1, removed_count);
+  ASSERT_EQ(RC::SUCCESS, manager.list_files(result_files, 0));
+  ASSERT_EQ(1, result_files.size());
+  ASSERT_EQ(files[3], filesystem::path(result_files[0]).filename());
+
+  // 重新初始化时只能看到剩下的文件，新的日志文件接着最后一个文件编号
+  LogFileManager manager2;
+  ASSERT_EQ(RC::SUCCESS, manager2.init(directory, max_entry_number_per_file));
+  ASSERT_EQ(RC::SUCCESS, manager2.list_files(result_files, 0));
+  ASSERT_EQ(1, result_files.size());
+
+  LogFileWriter writer;
+  ASSERT_EQ(RC::SUCCESS, manager2.next_file(writer));
+  ASSERT_EQ(string(LogFileManager::file_prefix_) + "4000" + LogFileManager::file_suffix_,
+      filesystem::path(writer.filename()).filename());
+  writer.close();
+
+  filesystem::remove_all(directory);
+  filesystem::remove_all(archive_directory);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,546 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "json/json.h"
+#include "common/lang/fstream.h"
+#include "common/lang/unordered_map.h"
+#include "db_test_base.h"
+#include "sql/operator/index_scan_physical_operator.h"
+#include "common/lang/vector.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/index/index.h"
+#include "storage/record/record_scanner.h"
+#include "storage/trx/mvcc_trx.h"
+
+using namespace std;
+using namespace common;
+
+class MvccTrxTest : public DbTestBase
+{
+public:
+  MvccTrxTest() : DbTestBase("mvcc_trx_test", "mvcc", "disk") {}
+
+  void SetUp() override
+  {
+    DbTestBase::SetUp();
+    table_ = create_table("t", {{"id", AttrType::INTS, 4}, {"val", AttrType::INTS, 4}});
+    ASSERT_NE(nullptr, table_);
+    const FieldMeta *val_field = table_->table_meta().field("val");
+    ASSERT_EQ(RC::SUCCESS, table_->create_index(nullptr, {val_field}, "idx_val", false));
+    index_      = table_->find_index("idx_val");
+    val_offset_ = val_field->offset();
+    ASSERT_NE(nullptr, index_);
+  }
+
+  MvccTrxKit &trx_kit() { return static_cast<MvccTrxKit &>(db_->trx_kit()); }
+
+  Trx *begin_trx()
+  {
+    Trx *trx = trx_kit().create_trx(db_->log_handler());
+    trx->start_if_need();
+    return trx;
+  }
+
+  void end_trx(Trx *trx, bool commit = true)
+  {
+    ASSERT_EQ(RC::SUCCESS, commit ? trx->commit() : trx->rollback());
+    trx_kit().destroy_trx(trx);
+  }
+
+  void insert_rows(int count)
+  {
+    Trx *trx = begin_trx();
+    for (int i = 0; i < count; i++) {
+      vector<Value> values{Value(i), Value(i)};
+      Record        record;
+      ASSERT_EQ(RC::SUCCESS, table_->make_record(values.size(), values.data(), record));
+      ASSERT_EQ(RC::SUCCESS, trx->insert_record(table_, record));
+      rids_.push_back(record.rid());
+      initial_values_[record.rid()] = i;
+    }
+    end_trx(trx);
+  }
+
+  RC update_row(Trx *trx, const RID &rid, int val)
+  {
+    Record record;
+    record.set_rid(rid);
+    Value value(val);
+    return trx->update_record(table_, record, "val", &value);
+  }
+
+  /**
+   * @brief 返回事务能看到的每条记录的 val 字段
+   */
+  unordered_map<RID, int, RIDHash> scan(Trx *trx)
+  {
+    unordered_map<RID, int, RIDHash> rows;
+
+    RecordScanner *scanner = nullptr;
+    EXPECT_EQ(RC::SUCCESS, table_->get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY));
+    Record record;
+    RC     rc = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner->next(record))) {
+      int val = 0;
+      memcpy(&val, record.data() + val_offset_, sizeof(val));
+      rows[record.rid()] = val;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    delete scanner;
+    return rows;
+  }
+
+  /**
+   * @brief 使用索引扫描算子返回事务能看到的 val 字段在 [left, right] 之间的记录，同一条记录出现多次时计数
+   */
+  unordered_map<RID, vector<int>, RIDHash> index_scan(Trx *trx, int left, int right)
+  {
+    unordered_map<RID, vector<int>, RIDHash> rows;
+
+    IndexScanPhysicalOperator scan_oper(
+        table_, index_, ReadWriteMode::READ_ONLY, {Value(left)}, true /*left_inclusive*/, {Value(right)}, true);
+    EXPECT_EQ(RC::SUCCESS, scan_oper.open(trx));
+    const int val_index = table_->table_meta().field_index(table_->table_meta().field("val"));
+    RC        rc        = RC::SUCCESS;
+    while (OB_SUCC(rc = scan_oper.next())) {
+      auto  *tuple = static_cast<RowTuple *>(scan_oper.current_tuple());
+      Value  value;
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(val_index, value));
+      rows[tuple->record().rid()].push_back(value.get_int());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scan_oper.close();
+    return rows;
+  }
+
+  int physical_record_count() { return static_cast<int>(scan(nullptr).size()); }
+
+  int index_entry_count()
+  {
+    IndexScanner *scanner = index_->create_scanner(nullptr, 0, true, nullptr, 0, true);
+    int           count   = 0;
+    RID           rid;
+    while (OB_SUCC(scanner->next_entry(&rid))) {
+      count++;
+    }
+    scanner->destroy();
+    return count;
+  }
+
+  void vacuum()
+  {
+    int purged_count = 0;
+    ASSERT_EQ(RC::SUCCESS, trx_kit().vacuum(purged_count));
+  }
+
+protected:
+  Table      *table_      = nullptr;
+  Index      *index_      = nullptr;
+  int         val_offset_ = 0;
+  vector<RID> rids_;
+
+  unordered_map<RID, int, RIDHash> initial_values_;  ///< 每条记录插入时 val 字段的值
+};
+
+TEST_F(MvccTrxTest, update_version_chain)
+{
+  const int row_num = 100;
+  insert_rows(row_num);
+  ASSERT_EQ(row_num, index_entry_count());
+
+  // 读事务在更新之前开始，应该一直看到旧的数据
+  Trx *reader = begin_trx();
+
+  Trx *writer = begin_trx();
+  for (const RID &rid : rids_) {
+    ASSERT_EQ(RC::SUCCESS, update_row(writer, rid, 1000));
+  }
+  for (auto &[rid, val] : scan(writer)) {
+    ASSERT_EQ(1000, val);
+  }
+  for (auto &[rid, val] : scan(reader)) {
+    ASSERT_EQ(initial_values_[rid], val);
+  }
+
+  // 没有提交时其它事务不能修改，不等待的话直接报错
+  Trx *other = begin_trx();
+  other->set_lock_wait_timeout(0);
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, update_row(other, rids_[0], 2000));
+  end_trx(other, false /*commit*/);
+
+  end_trx(writer);
+
+  // 更新在原地进行，不会产生新的记录
+  ASSERT_EQ(row_num, physical_record_count());
+  ASSERT_EQ(row_num, trx_kit().version_store().version_count());
+  ASSERT_EQ(row_num * 2, index_entry_count());
+
+  // 读事务还能看到旧版本，旧版本不能回收
+  vacuum();
+  ASSERT_EQ(row_num, trx_kit().version_store().version_count());
+  unordered_map<RID, int, RIDHash> old_rows = scan(reader);
+  ASSERT_EQ(row_num, static_cast<int>(old_rows.size()));
+  for (auto &[rid, val] : old_rows) {
+    ASSERT_EQ(initial_values_[rid], val);
+  }
+
+  // 读事务看不到已经提交的更新，但是修改时修改的是最新提交的版本
+  ASSERT_EQ(RC::SUCCESS, update_row(reader, rids_[0], 3000));
+  ASSERT_EQ(3000, scan(reader)[rids_[0]]);
+
+  Trx *new_reader = begin_trx();
+  for (auto &[rid, val] : scan(new_reader)) {
+    ASSERT_EQ(1000, val);
+  }
+  end_trx(new_reader);
+
+  end_trx(reader, false /*commit*/);
+
+  // 没有活跃事务了，旧版本和旧版本的索引数据都会被回收
+  vacuum();
+  ASSERT_EQ(0, trx_kit().version_store().version_count());
+  ASSERT_EQ(row_num, index_entry_count());
+  ASSERT_EQ(row_num, physical_record_count());
+}
+
+TEST_F(MvccTrxTest, index_scan_versions)
+{
+  const int row_num = 100;
+  insert_rows(row_num);
+
+  Trx *reader = begin_trx();
+  Trx *writer = begin_trx();
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, update_row(writer, rids_[i], row_num + initial_values_[rids_[i]]));
+  }
+  end_trx(writer);
+  ASSERT_EQ(row_num * 2, index_entry_count());
+
+  // 每条记录在索引中有新旧两个键值，只从可见版本的键值输出一次
+  Trx *new_reader = begin_trx();
+  for (Trx *trx : {reader, new_reader}) {
+    const int expected_base = trx == reader ? 0 : row_num;
+
+    unordered_map<RID, vector<int>, RIDHash> rows = index_scan(trx, 0, row_num * 2);
+    ASSERT_EQ(row_num, static_cast<int>(rows.size()));
+    for (auto &[rid, vals] : rows) {
+      ASSERT_EQ(1, static_cast<int>(vals.size()));
+      ASSERT_EQ(expected_base + initial_values_[rid], vals[0]);
+    }
+
+    // 另一个版本的键值所在的范围中看不到这些记录
+    const int other_base = trx == reader ? row_num : 0;
+    ASSERT_EQ(0, static_cast<int>(index_scan(trx, other_base, other_base + row_num - 1).size()));
+  }
+
+  end_trx(new_reader);
+  end_trx(reader);
+}
+
+TEST_F(MvccTrxTest, rollback_update)
+{
+  const int row_num = 10;
+  insert_rows(row_num);
+
+  Trx *trx = begin_trx();
+  for (const RID &rid : rids_) {
+    ASSERT_EQ(RC::SUCCESS, update_row(trx, rid, 1000));
+    ASSERT_EQ(RC::SUCCESS, update_row(trx, rid, 2000));
+  }
+  ASSERT_EQ(row_num * 2, trx_kit().version_store().version_count());
+  ASSERT_EQ(row_num * 3, index_entry_count());
+  end_trx(trx, false /*commit*/);
+
+  ASSERT_EQ(0, trx_kit().version_store().version_count());
+  ASSERT_EQ(row_num, index_entry_count());
+
+  Trx *reader = begin_trx();
+  for (auto &[rid, val] : scan(reader)) {
+    ASSERT_EQ(initial_values_[rid], val);
+  }
+  end_trx(reader);
+}
+
+TEST_F(MvccTrxTest, vacuum_deleted_records)
+{
+  const int row_num = 100;
+  insert_rows(row_num);
+
+  Trx *reader = begin_trx();
+
+  Trx *trx = begin_trx();
+  for (int i = 0; i < row_num; i += 2) {
+    Record record;
+    ASSERT_EQ(RC::SUCCESS, table_->get_record(rids_[i], record));
+    ASSERT_EQ(RC::SUCCESS, trx->delete_record(table_, record));
+  }
+  end_trx(trx);
+
+  // 读事务还能看到删除的记录
+  vacuum();
+  ASSERT_EQ(row_num, physical_record_count());
+  ASSERT_EQ(row_num, static_cast<int>(scan(reader).size()));
+  end_trx(reader);
+
+  vacuum();
+  ASSERT_EQ(row_num / 2, physical_record_count());
+  ASSERT_EQ(row_num / 2, index_entry_count());
+
+  Trx *new_reader = begin_trx();
+  ASSERT_EQ(row_num / 2, static_cast<int>(scan(new_reader).size()));
+  end_trx(new_reader);
+}
+
+TEST_F(MvccTrxTest, recover_uncommitted_update)
+{
+  const int row_num = 10;
+  insert_rows(row_num);
+
+  Trx *trx = begin_trx();
+  for (const RID &rid : rids_) {
+    ASSERT_EQ(RC::SUCCESS, update_row(trx, rid, 1000));
+  }
+
+  // 更新没有提交，日志落地后复制出来，页面还没有刷盘
+  auto &log_handler = static_cast<DiskLogHandler &>(db_->log_handler());
+  ASSERT_EQ(RC::SUCCESS, log_handler.wait_lsn(log_handler.current_lsn()));
+  filesystem::copy(directory_ / "db", directory_ / "db2", filesystem::copy_options::recursive);
+  end_trx(trx, false /*commit*/);
+
+  auto db2 = make_unique<Db>();
+  ASSERT_EQ(RC::SUCCESS, db2->init("test_db2", (directory_ / "db2").c_str(), "mvcc", "disk"));
+  Table *table2 = db2->find_table("t");
+  ASSERT_NE(nullptr, table2);
+  auto &trx_kit2 = static_cast<MvccTrxKit &>(db2->trx_kit());
+  ASSERT_EQ(0, trx_kit2.version_store().version_count());
+
+  // 没有提交的更新在恢复时回滚，旧版本写回到了表中，不需要依赖版本链
+  Trx *reader = trx_kit2.create_trx(db2->log_handler());
+  reader->start_if_need();
+
+  RecordScanner *scanner = nullptr;
+  ASSERT_EQ(RC::SUCCESS, table2->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY));
+  Record record;
+  int    count = 0;
+  while (OB_SUCC(scanner->next(record))) {
+    ASSERT_EQ(RC::SUCCESS, reader->visit_record(table2, record, ReadWriteMode::READ_ONLY));
+    int val = 0;
+    memcpy(&val, record.data() + val_offset_, sizeof(val));
+    ASSERT_EQ(initial_values_[record.rid()], val);
+    count++;
+  }
+  delete scanner;
+  ASSERT_EQ(row_num, count);
+
+  ASSERT_EQ(RC::SUCCESS, reader->commit());
+  trx_kit2.destroy_trx(reader);
+  db2.reset();
+}
+
+TEST_F(MvccTrxTest, reject_table_with_int32_trx_fields)
+{
+  db_.reset();
+
+  // 模拟旧版本创建的表，事务字段只有4个字节
+  filesystem::path meta_file = directory_ / "db" / "t.table";
+  Json::Value      table_value;
+  {
+    ifstream is(meta_file);
+    ASSERT_TRUE(Json::parseFromStream(Json::CharReaderBuilder(), is, &table_value, nullptr));
+  }
+  for (Json::Value &field_value : table_value["fields"]) {
+    if (field_value["name"].asString().rfind("__trx", 0) == 0) {
+      field_value["len"] = 4;
+    }
+  }
+  {
+    ofstream os(meta_file, ios::trunc);
+    os << table_value;
+  }
+
+  ASSERT_EQ(RC::SCHEMA_FIELD_TYPE_MISMATCH, open_db());
+  db_.reset();
+}
+
+TEST(MvccActiveTrxTable, acquire_release)
+{
+  MvccActiveTrxTable table(4);
+  vector<Trx *>      trxes;
+  table.all_trxes(trxes);
+  ASSERT_TRUE(trxes.empty());
+
+  Trx *fake_trxes[5];
+  for (int i = 0; i < 4; i++) {
+    fake_trxes[i] = reinterpret_cast<Trx *>(static_cast<intptr_t>(i + 1));
+    ASSERT_EQ(i, table.acquire(fake_trxes[i]));
+  }
+  fake_trxes[4] = reinterpret_cast<Trx *>(static_cast<intptr_t>(5));
+  ASSERT_EQ(-1, table.acquire(fake_trxes[4]));
+
+  // 释放后优先复用编号小的槽位
+  table.release(1);
+  ASSERT_EQ(1, table.acquire(fake_trxes[4]));
+
+  table.all_trxes(trxes);
+  ASSERT_EQ(4, static_cast<int>(trxes.size()));
+
+  table.set_view_limit(0, 10);
+  table.set_commit_xid(2, 8);
+  table.set_commit_xid(3, 12);
+  ASSERT_EQ(8, table.min_active_id(100));
+
+  vector<TrxID> committing_ids;
+  table.collect_committing(11, committing_ids);
+  ASSERT_EQ(vector<TrxID>{8}, committing_ids);
+
+  MvccReadView read_view;
+  read_view.init(11, std::move(committing_ids));
+  ASSERT_EQ(8, read_view.up_limit_id());
+  ASSERT_TRUE(read_view.is_visible(7));
+  ASSERT_FALSE(read_view.is_visible(8));
+  ASSERT_TRUE(read_view.is_visible(9));
+  ASSERT_FALSE(read_view.is_visible(11));
+  ASSERT_FALSE(read_view.is_visible(12));
+
+  // 优先使用指定的槽位
+  table.release(1);
+  table.release(3);
+  ASSERT_EQ(3, table.acquire(fake_trxes[3], 3));
+  ASSERT_EQ(1, table.acquire(fake_trxes[1], 3));
+
+  for (int i = 0; i < 4; i++) {
+    table.release(i);
+  }
+  ASSERT_EQ(100, table.min_active_id(100));
+}
+
+TEST_F(MvccTrxTest, unique_index_skips_old_versions)
+{
+  const FieldMeta *val_field = table_->table_meta().field("val");
+  ASSERT_EQ(RC::SUCCESS, table_->create_index(nullptr, {val_field}, "idx_val_unique", true /*unique*/));
+  insert_rows(2);
+
+  // 旧的读事务让 val=0 的旧版本和它的索引项保留下来
+  Trx *reader = begin_trx();
+  Trx *trx    = begin_trx();
+  ASSERT_EQ(RC::SUCCESS, update_row(trx, rids_[0], 100));
+  end_trx(trx);
+  vacuum();
+
+  // 旧键值的索引项不算重复，记录当前的键值仍然要唯一
+  auto insert = [this](int val) {
+    Trx          *trx = begin_trx();
+    vector<Value> values{Value(val), Value(val)};
+    Record        record;
+    EXPECT_EQ(RC::SUCCESS, table_->make_record(values.size(), values.data(), record));
+    RC rc = trx->insert_record(table_, record);
+    end_trx(trx, OB_SUCC(rc));
+    return rc;
+  };
+  ASSERT_EQ(RC::SUCCESS, insert(0));
+  ASSERT_EQ(RC::RECORD_NOT_UNIQUE, insert(100));
+  ASSERT_EQ(RC::RECORD_NOT_UNIQUE, insert(1));
+
+  end_trx(reader);
+}
+
+TEST_F(MvccTrxTest, reuse_trx_object)
+{
+  Trx *trx = begin_trx();
+  const TrxID first_id = trx->id();
+  const int   slot     = static_cast<MvccTrx *>(trx)->slot();
+  end_trx(trx);
+
+  // 结束的事务对象放到了当前线程的空闲列表中，再次创建事务时复用，并使用原来的槽位
+  Trx *reused = trx_kit().create_trx(db_->log_handler());
+  ASSERT_EQ(trx, reused);
+  ASSERT_EQ(slot, static_cast<MvccTrx *>(reused)->slot());
+  ASSERT_EQ(Trx::DEFAULT_LOCK_WAIT_TIMEOUT_MS, reused->lock_wait_timeout());
+  ASSERT_EQ(RC::SUCCESS, reused->start_if_need());
+  ASSERT_GT(reused->id(), first_id);
+  end_trx(reused);
+}
+
+TEST_F(MvccTrxTest, trx_id_beyond_int32)
+{
+  const int row_num = 10;
+  insert_rows(row_num);
+
+  // 事务ID超过32位整数的范围后，记录上的版本号依然正确
+  trx_kit().update_trx_id(static_cast<TrxID>(numeric_limits<int32_t>::max()) + 10);
+
+  Trx *writer = begin_trx();
+  ASSERT_GT(writer->id(), numeric_limits<int32_t>::max());
+  for (const RID &rid : rids_) {
+    ASSERT_EQ(RC::SUCCESS, update_row(writer, rid, 2000));
+  }
+
+  Trx *reader = begin_trx();
+  for (auto &[rid, val] : scan(reader)) {
+    ASSERT_EQ(initial_values_[rid], val);
+  }
+  end_trx(writer);
+  end_trx(reader);
+
+  Trx *new_reader = begin_trx();
+  unordered_map<RID, int, RIDHash> rows = scan(new_reader);
+  ASSERT_EQ(row_num, static_cast<int>(rows.size()));
+  for (auto &[rid, val] : rows) {
+    ASSERT_EQ(2000, val);
+  }
+  end_trx(new_reader);
+}
+
+TEST_F(MvccTrxTest, read_view_excludes_committing_trx)
+{
+  const int row_num = 10;
+  insert_rows(row_num);
+
+  Trx *writer = begin_trx();
+  for (const RID &rid : rids_) {
+    ASSERT_EQ(RC::SUCCESS, update_row(writer, rid, 1000));
+  }
+
+  // 提交ID已经分配，但是还没有修改完记录上的版本号
+  auto       *mvcc_writer = static_cast<MvccTrx *>(writer);
+  const TrxID commit_xid  = trx_kit().begin_commit(mvcc_writer->slot());
+
+  Trx *reader      = begin_trx();
+  auto *mvcc_reader = static_cast<MvccTrx *>(reader);
+  ASSERT_GT(mvcc_reader->id(), commit_xid);
+  ASSERT_FALSE(mvcc_reader->read_view().is_visible(commit_xid));
+  ASSERT_LE(trx_kit().oldest_active_trx_id(), commit_xid);
+
+  end_trx(writer);
+
+  // 提交完成之后，读事务依然看不到这次提交的任何修改
+  for (auto &[rid, val] : scan(reader)) {
+    ASSERT_EQ(initial_values_[rid], val);
+  }
+  ASSERT_LE(trx_kit().oldest_active_trx_id(), mvcc_reader->read_view().up_limit_id());
+  end_trx(reader);
+
+  Trx *new_reader = begin_trx();
+  for (auto &[rid, val] : scan(new_reader)) {
+    ASSERT_EQ(1000, val);
+  }
+  end_trx(new_reader);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  filesystem::path log_filename = filesystem::path(argv[0]).filename();
+  LoggerFactory::init_default(log_filename.string() + ".log", LOG_LEVEL_INFO);
+  return RUN_ALL_TESTS();
+}
@@ -64,6 +64,37 @@ TEST(ParserTest, DISABLED_group_by_test)
   }
 }
 
+TEST(ParserTest, sub_query_limit_test)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from t where a in (select b from s limit 2)";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    const ConditionSqlNode &condition = result.sql_nodes().front()->selection.conditions.front();
+    ASSERT_NE(condition.right_sub_query, nullptr);
+    ASSERT_EQ(condition.right_sub_query->limit, 2);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from t where (select b from s limit 3) = a";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    const ConditionSqlNode &condition = result.sql_nodes().front()->selection.conditions.front();
+    ASSERT_NE(condition.left_sub_query, nullptr);
+    ASSERT_EQ(condition.left_sub_query->limit, 3);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from t where exists (select b from s)";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().size(), 1);
+    const ConditionSqlNode &condition = result.sql_nodes().front()->selection.conditions.front();
+    ASSERT_NE(condition.right_sub_query, nullptr);
+    ASSERT_EQ(condition.right_sub_query->limit, -1);
+  }
+}
+
 int main(int argc, char **argv)
 {
 
@@ -37,7 +37,7 @@ using namespace common;
 class PaxRecordFileScannerWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
+TEST_P(PaxRecordFileScannerWithParam, test_file_iterator)
 {
   int               record_insert_num = GetParam();
   VacuousLogHandler log_handler;
@@ -183,7 +183,7 @@ TEST_P(PaxRecordFileScannerWithParam, DISABLED_test_file_iterator)
 class PaxPageHandlerTestWithParam : public testing::TestWithParam<int>
 {};
 
-TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
+TEST_P(PaxPageHandlerTestWithParam, PaxPageHandler)
 {
   int               record_num = GetParam();
   VacuousLogHandler log_handler;
@@ -347,6 +347,153 @@ TEST_P(PaxPageHandlerTestWithParam, DISABLED_PaxPageHandler)
   delete bpm;
 }
 
+TEST(PaxRecordFileHandler, insert_chunk)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager_chunk.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, record_manager_file, bp));
+
+  TableMeta table_meta;
+  table_meta.fields_.resize(2);
+  table_meta.fields_[0].attr_type_ = AttrType::INTS;
+  table_meta.fields_[0].attr_len_  = 4;
+  table_meta.fields_[0].field_id_  = 0;
+  table_meta.fields_[1].attr_type_ = AttrType::FLOATS;
+  table_meta.fields_[1].attr_len_  = 4;
+  table_meta.fields_[1].field_id_  = 1;
+
+  RecordFileHandler file_handler(StorageFormat::PAX_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, &table_meta, nullptr));
+
+  // more rows than a single page can hold
+  const int row_num = 5000;
+  Chunk     chunk;
+  chunk.add_column(make_unique<Column>(AttrType::INTS, 4, row_num), 0);
+  chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4, row_num), 1);
+  for (int i = 0; i < row_num; i++) {
+    int   int_val   = i;
+    float float_val = i + 0.5f;
+    ASSERT_EQ(RC::SUCCESS, chunk.column(0).append_one((const char *)&int_val));
+    ASSERT_EQ(RC::SUCCESS, chunk.column(1).append_one((const char *)&float_val));
+  }
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_chunk(chunk, sizeof(int) + sizeof(float)));
+
+  Table table;
+  table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
+
+  ChunkFileScanner chunk_scanner;
+  ASSERT_EQ(RC::SUCCESS, chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY));
+  Chunk scan_chunk;
+  scan_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+  scan_chunk.add_column(make_unique<Column>(AttrType::FLOATS, 4), 1);
+
+  RC   rc      = RC::SUCCESS;
+  int  count   = 0;
+  long int_sum = 0;
+  while (OB_SUCC(rc = chunk_scanner.next_chunk(scan_chunk))) {
+    for (int i = 0; i < scan_chunk.rows(); i++) {
+      int value = scan_chunk.get_value(0, i).get_int();
+      ASSERT_FLOAT_EQ(scan_chunk.get_value(1, i).get_float(), value + 0.5f);
+      int_sum += value;
+    }
+    count += scan_chunk.rows();
+    scan_chunk.reset_data();
+  }
+  ASSERT_EQ(rc, RC::RECORD_EOF);
+  ASSERT_EQ(count, row_num);
+  ASSERT_EQ(int_sum, (long)row_num * (row_num - 1) / 2);
+  chunk_scanner.close_scan();
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
+TEST(PaxRecordFileHandler, scan_chunk_by_morsels)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager_morsel.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, record_manager_file, bp));
+
+  TableMeta table_meta;
+  table_meta.fields_.resize(1);
+  table_meta.fields_[0].attr_type_ = AttrType::INTS;
+  table_meta.fields_[0].attr_len_  = 4;
+  table_meta.fields_[0].field_id_  = 0;
+
+  RecordFileHandler file_handler(StorageFormat::PAX_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, &table_meta, nullptr));
+
+  const int row_num = 100000;
+  Chunk     chunk;
+  chunk.add_column(make_unique<Column>(AttrType::INTS, 4, row_num), 0);
+  for (int i = 0; i < row_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, chunk.column(0).append_one((const char *)&i));
+  }
+  ASSERT_EQ(RC::SUCCESS, file_handler.insert_chunk(chunk, sizeof(int)));
+
+  Table table;
+  table.table_meta_.storage_format_ = StorageFormat::PAX_FORMAT;
+
+  // 多个线程从同一个 PageMorselSource 中领取页面范围，每一行只被扫描一次
+  const int        thread_num = 4;
+  PageMorselSource morsels(2 /*morsel_pages*/);
+  vector<long>     sums(thread_num, 0);
+  vector<int>      counts(thread_num, 0);
+  vector<RC>       results(thread_num, RC::SUCCESS);
+  vector<thread>   threads;
+  for (int t = 0; t < thread_num; t++) {
+    threads.emplace_back([&, t]() {
+      ChunkFileScanner chunk_scanner;
+      results[t] = chunk_scanner.open_scan_chunk(&table, *bp, log_handler, ReadWriteMode::READ_ONLY, &morsels);
+      if (OB_FAIL(results[t])) {
+        return;
+      }
+      Chunk scan_chunk;
+      scan_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+      RC rc = RC::SUCCESS;
+      while (OB_SUCC(rc = chunk_scanner.next_chunk(scan_chunk))) {
+        for (int i = 0; i < scan_chunk.rows(); i++) {
+          sums[t] += scan_chunk.get_value(0, i).get_int();
+        }
+        counts[t] += scan_chunk.rows();
+        scan_chunk.reset_data();
+      }
+      results[t] = rc;
+      chunk_scanner.close_scan();
+    });
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  int  count = 0;
+  long sum   = 0;
+  for (int t = 0; t < thread_num; t++) {
+    ASSERT_EQ(results[t], RC::RECORD_EOF);
+    count += counts[t];
+    sum += sums[t];
+  }
+  ASSERT_EQ(count, row_num);
+  ASSERT_EQ(sum, (long)row_num * (row_num - 1) / 2);
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+}
+
 INSTANTIATE_TEST_SUITE_P(PaxFileScannerTests, PaxRecordFileScannerWithParam, testing::Values(1, 10, 100, 1000, 2000, 10000));
 
 INSTANTIATE_TEST_SUITE_P(PaxPageTests, PaxPageHandlerTestWithParam, testing::Values(1, 10, 100, 337));
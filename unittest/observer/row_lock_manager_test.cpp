@@ -0,0 +1,117 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "common/lang/chrono.h"
+#include "common/lang/thread.h"
+#include "storage/trx/row_lock_manager.h"
+
+using namespace std;
+
+static MvccRecordKey make_key(int32_t table_id, PageNum page_num, SlotNum slot_num)
+{
+  return MvccRecordKey{table_id, RID(page_num, slot_num)};
+}
+
+TEST(RowLockManager, lock_and_timeout)
+{
+  RowLockManager lock_manager;
+  MvccRecordKey  key = make_key(1, 1, 0);
+
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, key, 0));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, key, 0));  // 重入
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.lock(2, key, 0));
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.lock(2, key, 10));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, make_key(1, 1, 1), 0));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, make_key(2, 1, 0), 0));
+
+  // 重复的记录和不是自己持有的锁都会被跳过
+  lock_manager.unlock_all(1, {key, key, make_key(1, 1, 1)});
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, key, 0));
+  ASSERT_EQ(RC::LOCKED_WAIT_TIMEOUT, lock_manager.lock(1, make_key(1, 1, 1), 0));
+
+  RowLockManager::Stats stats = lock_manager.stats();
+  ASSERT_EQ(5, stats.lock_count);
+  ASSERT_EQ(1, stats.wait_count);
+  ASSERT_EQ(3, stats.timeout_count);
+  ASSERT_EQ(0, stats.deadlock_count);
+}
+
+TEST(RowLockManager, wait_and_grant_in_order)
+{
+  RowLockManager lock_manager;
+  MvccRecordKey  key = make_key(1, 1, 0);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, key, 0));
+
+  atomic<int> granted_order{0};
+  int         order2 = 0, order3 = 0;
+  thread      waiter2([&] {
+    ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, key, 10000));
+    order2 = ++granted_order;
+    lock_manager.unlock_all(2, {key});
+  });
+  while (lock_manager.stats().wait_count < 1) {
+    this_thread::yield();
+  }
+  thread waiter3([&] {
+    ASSERT_EQ(RC::SUCCESS, lock_manager.lock(3, key, 10000));
+    order3 = ++granted_order;
+    lock_manager.unlock_all(3, {key});
+  });
+  while (lock_manager.stats().wait_count < 2) {
+    this_thread::yield();
+  }
+
+  lock_manager.unlock_all(1, {key});
+  waiter2.join();
+  waiter3.join();
+  ASSERT_EQ(1, order2);
+  ASSERT_EQ(2, order3);
+
+  vector<RowLockManager::HotRow> hot_rows;
+  lock_manager.hot_rows(10, hot_rows);
+  ASSERT_EQ(1, static_cast<int>(hot_rows.size()));
+  ASSERT_TRUE(hot_rows[0].key == key);
+  ASSERT_EQ(2, hot_rows[0].wait_count);
+}
+
+TEST(RowLockManager, deadlock)
+{
+  RowLockManager lock_manager;
+  MvccRecordKey  key_a = make_key(1, 1, 0);
+  MvccRecordKey  key_b = make_key(1, 1, 1);
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, key_a, 0));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(2, key_b, 0));
+
+  // 事务1等待事务2持有的 B
+  thread waiter([&] {
+    ASSERT_EQ(RC::SUCCESS, lock_manager.lock(1, key_b, 10000));
+    lock_manager.unlock_all(1, {key_a, key_b});
+  });
+  while (lock_manager.stats().wait_count < 1) {
+    this_thread::yield();
+  }
+
+  // 事务2再等待事务1持有的 A 就形成了环
+  ASSERT_EQ(RC::LOCKED_DEADLOCK, lock_manager.lock(2, key_a, 10000));
+  ASSERT_EQ(1, lock_manager.stats().deadlock_count);
+
+  // 事务2回滚释放锁后，事务1拿到锁
+  lock_manager.unlock_all(2, {key_b});
+  waiter.join();
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(3, key_a, 0));
+  ASSERT_EQ(RC::SUCCESS, lock_manager.lock(3, key_b, 0));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
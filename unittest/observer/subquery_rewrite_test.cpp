@@ -0,0 +1,230 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "common/lang/vector.h"
+#include "db_test_base.h"
+#include "sql/expr/sub_query_expr.h"
+#include "sql/operator/group_by_logical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/project_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/physical_plan_generator.h"
+#include "sql/optimizer/rewriter.h"
+#include "storage/trx/trx.h"
+
+using namespace std;
+
+/**
+ * @brief 相关的标量子查询：select t1.k from t1 where (select agg(t2.v) from t2 where t2.k = t1.k) <comp> value
+ * @details t1 的 k 为 0 到 9，t2 中只有偶数的 k，每个 k 有 k / 2 + 1 行
+ */
+class SubqueryRewriteTest : public DbTestBase
+{
+public:
+  SubqueryRewriteTest() : DbTestBase("subquery_rewrite_test", "vacuous", "vacuous") {}
+
+  void SetUp() override
+  {
+    DbTestBase::SetUp();
+    t1_ = create_table("t1", {{"k", AttrType::INTS, 4}, {"v", AttrType::INTS, 4}});
+    t2_ = create_table("t2", {{"k", AttrType::INTS, 4}, {"v", AttrType::INTS, 4}});
+    ASSERT_NE(nullptr, t1_);
+    ASSERT_NE(nullptr, t2_);
+
+    trx_ = db_->trx_kit().create_trx(db_->log_handler());
+    for (int k = 0; k < 10; k++) {
+      insert(t1_, k, k);
+      for (int i = 0; k % 2 == 0 && i <= k / 2; i++) {
+        insert(t2_, k, i);
+      }
+    }
+  }
+
+  void TearDown() override
+  {
+    db_->trx_kit().destroy_trx(trx_);
+    DbTestBase::TearDown();
+  }
+
+  void insert(Table *table, int k, int v)
+  {
+    vector<Value> values{Value(k), Value(v)};
+    Record        record;
+    ASSERT_EQ(RC::SUCCESS, table->make_record(values.size(), values.data(), record));
+    ASSERT_EQ(RC::SUCCESS, trx_->insert_record(table, record));
+  }
+
+  unique_ptr<LogicalOperator> build(AggregateExpr::Type agg_type, CompOp comp, int value)
+  {
+    auto field = [](Table *table, const char *name) { return make_unique<FieldExpr>(table, table->table_meta().field(name)); };
+
+    auto sub_predicate = make_unique<PredicateLogicalOperator>(make_unique<ComparisonExpr>(
+        EQUAL_TO, field(t2_, "k"), make_unique<CorrelatedFieldExpr>(Field(t1_, t1_->table_meta().field("k")))));
+    sub_predicate->add_child(make_unique<TableGetLogicalOperator>(t2_, ReadWriteMode::READ_ONLY));
+
+    auto aggregate = make_unique<AggregateExpr>(agg_type, field(t2_, "v"));
+    aggregate->set_name("agg(v)");
+    aggregate->set_pos(0);
+    auto group_by = make_unique<GroupByLogicalOperator>(vector<unique_ptr<Expression>>(), vector<Expression *>{aggregate.get()});
+    group_by->add_child(std::move(sub_predicate));
+
+    vector<unique_ptr<Expression>> sub_outputs;
+    sub_outputs.emplace_back(std::move(aggregate));
+    auto sub_project = make_unique<ProjectLogicalOperator>(std::move(sub_outputs));
+    sub_project->add_child(std::move(group_by));
+
+    auto sub_query = make_unique<SubQueryExpr>(std::move(sub_project));
+    sub_query_     = sub_query.get();
+    auto predicate = make_unique<PredicateLogicalOperator>(
+        make_unique<ComparisonExpr>(comp, std::move(sub_query), make_unique<ValueExpr>(Value(value))));
+    predicate->add_child(make_unique<TableGetLogicalOperator>(t1_, ReadWriteMode::READ_ONLY));
+
+    vector<unique_ptr<Expression>> outputs;
+    outputs.emplace_back(field(t1_, "k"));
+    auto project = make_unique<ProjectLogicalOperator>(std::move(outputs));
+    project->add_child(std::move(predicate));
+    return project;
+  }
+
+  /**
+   * @brief 带 LIMIT 的子查询：select t1.k from t1 where t1.k <comp> (select t2.k from t2 [where t2.k = t1.k] limit n)
+   */
+  unique_ptr<LogicalOperator> build_limit(CompOp comp, bool correlated, int limit)
+  {
+    auto field = [](Table *table, const char *name) { return make_unique<FieldExpr>(table, table->table_meta().field(name)); };
+
+    unique_ptr<LogicalOperator> sub_child = make_unique<TableGetLogicalOperator>(t2_, ReadWriteMode::READ_ONLY);
+    if (correlated) {
+      auto sub_predicate = make_unique<PredicateLogicalOperator>(make_unique<ComparisonExpr>(
+          EQUAL_TO, field(t2_, "k"), make_unique<CorrelatedFieldExpr>(Field(t1_, t1_->table_meta().field("k")))));
+      sub_predicate->add_child(std::move(sub_child));
+      sub_child = std::move(sub_predicate);
+    }
+    auto limit_oper = make_unique<LimitLogicalOperator>(limit);
+    limit_oper->add_child(std::move(sub_child));
+
+    vector<unique_ptr<Expression>> sub_outputs;
+    sub_outputs.emplace_back(field(t2_, "k"));
+    auto sub_project = make_unique<ProjectLogicalOperator>(std::move(sub_outputs));
+    sub_project->add_child(std::move(limit_oper));
+
+    unique_ptr<Expression> left;
+    if (comp == CompOp_IN || comp == CompOp_NOT_IN) {
+      left = field(t1_, "k");
+    } else {
+      left = make_unique<ValueExpr>(Value("", 0, true));
+    }
+    auto predicate = make_unique<PredicateLogicalOperator>(
+        make_unique<ComparisonExpr>(comp, std::move(left), make_unique<SubQueryExpr>(std::move(sub_project))));
+    predicate->add_child(make_unique<TableGetLogicalOperator>(t1_, ReadWriteMode::READ_ONLY));
+
+    vector<unique_ptr<Expression>> outputs;
+    outputs.emplace_back(field(t1_, "k"));
+    auto project = make_unique<ProjectLogicalOperator>(std::move(outputs));
+    project->add_child(std::move(predicate));
+    return project;
+  }
+
+  void rewrite(unique_ptr<LogicalOperator> &plan)
+  {
+    Rewriter rewriter;
+    bool     changed = true;
+    while (changed) {
+      EXPECT_EQ(RC::SUCCESS, rewriter.rewrite(plan, changed));
+    }
+  }
+
+  static bool has_join(LogicalOperator &oper)
+  {
+    if (oper.type() == LogicalOperatorType::JOIN) {
+      return true;
+    }
+    for (unique_ptr<LogicalOperator> &child : oper.children()) {
+      if (has_join(*child)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// 改写并执行，返回输出的 t1.k
+  vector<int> execute(unique_ptr<LogicalOperator> plan)
+  {
+    rewrite(plan);
+
+    PhysicalPlanGenerator        generator;
+    unique_ptr<PhysicalOperator> oper;
+    EXPECT_EQ(RC::SUCCESS, generator.create(*plan, oper, nullptr));
+    EXPECT_EQ(RC::SUCCESS, oper->open(trx_));
+
+    vector<int> result;
+    RC          rc = RC::SUCCESS;
+    while (OB_SUCC(rc = oper->next())) {
+      Value value;
+      EXPECT_EQ(RC::SUCCESS, oper->current_tuple()->cell_at(0, value));
+      result.push_back(value.get_int());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    oper->close();
+    sort(result.begin(), result.end());
+    return result;
+  }
+
+protected:
+  Table        *t1_        = nullptr;
+  Table        *t2_        = nullptr;
+  Trx          *trx_       = nullptr;
+  SubQueryExpr *sub_query_ = nullptr;
+};
+
+TEST_F(SubqueryRewriteTest, count_without_match)
+{
+  // 没有匹配的行时 COUNT 是 0 而不是 NULL，不能改写成按照分组查找
+  EXPECT_EQ(execute(build(AggregateExpr::Type::COUNT, EQUAL_TO, 0)), (vector<int>{1, 3, 5, 7, 9}));
+  EXPECT_TRUE(sub_query_->lookup_keys().empty());
+
+  EXPECT_EQ(execute(build(AggregateExpr::Type::COUNT, GREAT_EQUAL, 2)), (vector<int>{2, 4, 6, 8}));
+}
+
+TEST_F(SubqueryRewriteTest, max_lookup)
+{
+  // 没有匹配的行时 MAX 是 NULL，与查找不到分组的结果相同
+  EXPECT_EQ(execute(build(AggregateExpr::Type::MAX, GREAT_EQUAL, 2)), (vector<int>{4, 6, 8}));
+  EXPECT_FALSE(sub_query_->lookup_keys().empty());
+  EXPECT_EQ(sub_query_->execute_count(), 1);
+
+  EXPECT_EQ(execute(build(AggregateExpr::Type::MAX, LESS_THAN, 1)), (vector<int>{0}));
+}
+
+TEST_F(SubqueryRewriteTest, limit_not_rewritten)
+{
+  // t2 中第一行的 k 是 0，LIMIT 作用在子查询上时只有 0 满足条件，不能改写成半连接
+  unique_ptr<LogicalOperator> plan = build_limit(CompOp_IN, false /*correlated*/, 1);
+  rewrite(plan);
+  EXPECT_FALSE(has_join(*plan));
+  EXPECT_EQ(execute(std::move(plan)), (vector<int>{0}));
+
+  EXPECT_EQ(execute(build_limit(CompOp_NOT_IN, false /*correlated*/, 1)), (vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  plan = build_limit(CompOp_EXISTS, true /*correlated*/, 1);
+  rewrite(plan);
+  EXPECT_FALSE(has_join(*plan));
+  EXPECT_EQ(execute(std::move(plan)), (vector<int>{0, 2, 4, 6, 8}));
+
+  EXPECT_EQ(execute(build_limit(CompOp_NOT_EXISTS, true /*correlated*/, 0)), (vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
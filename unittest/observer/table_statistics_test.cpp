@@ -0,0 +1,147 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "common/lang/cmath.h"
+#include "sql/optimizer/statistics/hyper_log_log.h"
+#include "sql/optimizer/statistics/table_statistics.h"
+
+#include "gtest/gtest.h"
+#include "json/json.h"
+
+TEST(HyperLogLog, estimate)
+{
+  HyperLogLog small;
+  for (int i = 0; i < 100; i++) {
+    small.add(Value(i % 10));
+  }
+  Value null_value(0);
+  null_value.set_is_null(true);
+  small.add(null_value);
+  EXPECT_NEAR(small.estimate(), 10, 1);
+
+  HyperLogLog left;
+  HyperLogLog right;
+  for (int i = 0; i < 100000; i++) {
+    left.add(Value(i));
+    right.add(Value(i + 50000));
+  }
+  EXPECT_NEAR(left.estimate(), 100000, 100000 * 0.05);
+
+  left.merge(right);
+  EXPECT_NEAR(left.estimate(), 150000, 150000 * 0.05);
+}
+
+TEST(ColumnStatistics, uniform)
+{
+  ColumnStatisticsBuilder builder("id", AttrType::INTS);
+  for (int i = 0; i < 10000; i++) {
+    builder.add(Value(i));
+  }
+  for (int i = 0; i < 2500; i++) {
+    Value null_value(0);
+    null_value.set_is_null(true);
+    builder.add(null_value);
+  }
+
+  ColumnStatistics column;
+  builder.build(12500, column);
+  EXPECT_DOUBLE_EQ(column.null_fraction(), 0.2);
+  EXPECT_NEAR(column.ndv(), 10000, 10000 * 0.05);
+  EXPECT_EQ(column.min_value().get_int(), 0);
+  EXPECT_EQ(column.max_value().get_int(), 9999);
+  ASSERT_EQ(column.histogram().size(), static_cast<size_t>(ColumnStatisticsBuilder::DEFAULT_BUCKET_NUM + 1));
+
+  EXPECT_NEAR(column.less_selectivity(Value(2500), false), 0.8 * 0.25, 0.01);
+  EXPECT_NEAR(column.greater_selectivity(Value(7500), true), 0.8 * 0.25, 0.01);
+  EXPECT_NEAR(column.equal_selectivity(Value(100)), 0.8 / 10000, 0.0001);
+  EXPECT_EQ(column.equal_selectivity(Value(-1)), 0);
+  EXPECT_EQ(column.equal_selectivity(Value(10000)), 0);
+  EXPECT_EQ(column.less_selectivity(Value(-1), true), 0);
+  EXPECT_NEAR(column.less_selectivity(Value(10000), false), 0.8, 0.0001);
+}
+
+TEST(ColumnStatistics, skew)
+{
+  // 一半的值是 7，其余的值各不相同
+  ColumnStatisticsBuilder builder("c", AttrType::INTS);
+  for (int i = 0; i < 1000; i++) {
+    builder.add(Value(i % 2 == 0 ? 7 : 1000 + i));
+  }
+
+  ColumnStatistics column;
+  builder.build(1000, column);
+  EXPECT_NEAR(column.ndv(), 501, 501 * 0.05);
+  EXPECT_NEAR(column.equal_selectivity(Value(7)), 0.5, 0.05);
+  EXPECT_LT(column.equal_selectivity(Value(1001)), 0.01);
+
+  ColumnStatisticsBuilder chars_builder("name", AttrType::CHARS);
+  for (const char *s : {"apple", "banana", "cherry", "durian"}) {
+    chars_builder.add(Value(s));
+  }
+  chars_builder.build(4, column);
+  EXPECT_EQ(column.min_value().get_string(), "apple");
+  EXPECT_EQ(column.max_value().get_string(), "durian");
+  EXPECT_EQ(column.equal_selectivity(Value("zebra")), 0);
+  EXPECT_NEAR(column.less_selectivity(Value("c"), false), 0.5, 0.2);
+}
+
+TEST(ColumnStatistics, scale_ndv)
+{
+  // 全表采样时不需要放大
+  EXPECT_DOUBLE_EQ(ColumnStatisticsBuilder::scale_ndv(100, 1000, 1000), 100);
+
+  // 采样 10% 的数据：每个值出现 100 次时采样中几乎都能看到，所有值都不同时采样中的值也都不同
+  EXPECT_NEAR(ColumnStatisticsBuilder::scale_ndv(1000, 10000, 100000), 1000, 10);
+  EXPECT_NEAR(ColumnStatisticsBuilder::scale_ndv(10000, 10000, 100000), 100000, 1);
+
+  // 每个值出现 10 次时，采样中大约能看到 1 - 0.9^10 = 65% 的值
+  const double sample_ndv = 10000 * (1 - pow(0.9, 10));
+  EXPECT_NEAR(ColumnStatisticsBuilder::scale_ndv(sample_ndv, 10000, 100000), 10000, 10);
+}
+
+TEST(TableStatistics, json)
+{
+  ColumnStatisticsBuilder builder("score", AttrType::FLOATS);
+  for (int i = 0; i < 100; i++) {
+    builder.add(Value(i * 0.5f));
+  }
+  ColumnStatistics column;
+  builder.build(100, column, 4);
+
+  Json::Value json_value;
+  column.to_json(json_value);
+  ColumnStatistics restored;
+  ASSERT_EQ(ColumnStatistics::from_json(json_value, restored), RC::SUCCESS);
+  EXPECT_EQ(restored.name(), "score");
+  EXPECT_EQ(restored.type(), AttrType::FLOATS);
+  EXPECT_DOUBLE_EQ(restored.ndv(), column.ndv());
+  ASSERT_EQ(restored.histogram().size(), 5);
+  for (size_t i = 0; i < column.histogram().size(); i++) {
+    EXPECT_EQ(restored.histogram()[i].compare(column.histogram()[i]), 0);
+  }
+  EXPECT_DOUBLE_EQ(restored.less_selectivity(Value(10.0f), true), column.less_selectivity(Value(10.0f), true));
+
+  Json::Value      table_value;
+  TableStatistics  table_statistics;
+  table_statistics.to_json(table_value);
+  table_value["columns"].append(json_value);
+  ASSERT_EQ(TableStatistics::from_json(table_value, table_statistics), RC::SUCCESS);
+  ASSERT_NE(table_statistics.column("score"), nullptr);
+  EXPECT_EQ(table_statistics.column("id"), nullptr);
+
+  table_value["columns"][0]["histogram"][1] = "not a float";
+  EXPECT_NE(TableStatistics::from_json(table_value, table_statistics), RC::SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "gtest/gtest.h"
+#include "sql/expr/value_hash_set.h"
+
+static Value null_value(AttrType type)
+{
+  Value value;
+  value.set_type(type);
+  value.set_null_value();
+  return value;
+}
+
+TEST(ValueHashSet, in)
+{
+  ValueHashSet set(AttrType::INTS);
+  bool         result  = false;
+  bool         is_null = false;
+
+  // 空集合
+  ASSERT_EQ(RC::SUCCESS, set.in(Value(1), result, is_null));
+  ASSERT_FALSE(result);
+  ASSERT_FALSE(is_null);
+  ASSERT_EQ(RC::SUCCESS, set.in(null_value(AttrType::INTS), result, is_null));
+  ASSERT_FALSE(result);
+  ASSERT_FALSE(is_null);
+
+  for (int i = 0; i < 100; i += 2) {
+    ASSERT_EQ(RC::SUCCESS, set.insert(Value(i)));
+  }
+  ASSERT_EQ(50, set.size());
+  ASSERT_EQ(RC::SUCCESS, set.in(Value(10), result, is_null));
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(is_null);
+  ASSERT_EQ(RC::SUCCESS, set.in(Value(11), result, is_null));
+  ASSERT_FALSE(result);
+  ASSERT_FALSE(is_null);
+  ASSERT_EQ(RC::SUCCESS, set.in(null_value(AttrType::INTS), result, is_null));
+  ASSERT_TRUE(is_null);
+
+  // 集合中有 NULL 时，不在集合中的值结果是 NULL
+  ASSERT_EQ(RC::SUCCESS, set.insert(null_value(AttrType::INTS)));
+  ASSERT_TRUE(set.has_null());
+  ASSERT_EQ(RC::SUCCESS, set.in(Value(10), result, is_null));
+  ASSERT_TRUE(result);
+  ASSERT_FALSE(is_null);
+  ASSERT_EQ(RC::SUCCESS, set.in(Value(11), result, is_null));
+  ASSERT_FALSE(result);
+  ASSERT_TRUE(is_null);
+
+  ASSERT_EQ(RC::INVALID_ARGUMENT, set.insert(Value(1.0f)));
+  ASSERT_EQ(RC::INVALID_ARGUMENT, set.in(Value(1.0f), result, is_null));
+}
+
+TEST(ValueHashSet, types)
+{
+  bool result  = false;
+  bool is_null = false;
+
+  ValueHashSet float_set(AttrType::FLOATS);
+  ASSERT_EQ(RC::SUCCESS, float_set.insert(Value(-0.0f)));
+  ASSERT_EQ(RC::SUCCESS, float_set.insert(Value(1.5f)));
+  ASSERT_EQ(RC::SUCCESS, float_set.in(Value(0.0f), result, is_null));
+  ASSERT_TRUE(result);
+  ASSERT_EQ(RC::SUCCESS, float_set.in(Value(1.25f), result, is_null));
+  ASSERT_FALSE(result);
+
+  ValueHashSet char_set(AttrType::CHARS);
+  ASSERT_EQ(RC::SUCCESS, char_set.insert(Value("abc")));
+  ASSERT_EQ(RC::SUCCESS, char_set.insert(Value("abc\0\0", 5)));
+  ASSERT_EQ(RC::SUCCESS, char_set.in(Value("abc"), result, is_null));
+  ASSERT_TRUE(result);
+  ASSERT_EQ(RC::SUCCESS, char_set.in(Value("ab"), result, is_null));
+  ASSERT_FALSE(result);
+
+  ASSERT_TRUE(ValueHashSet::support(AttrType::DATES));
+  ASSERT_FALSE(ValueHashSet::support(AttrType::VECTORS));
+}
@@ -0,0 +1,628 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+#include "gtest/gtest.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/atomic.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/aggregate_vec_physical_operator.h"
+#include "sql/operator/gather_vec_physical_operator.h"
+#include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "sql/operator/join_vec_physical_operator.h"
+#include "sql/operator/limit_physical_operator.h"
+#include "sql/operator/order_by_vec_physical_operator.h"
+#include "sql/operator/predicate_vec_physical_operator.h"
+#include "storage/field/field.h"
+
+using namespace std;
+
+/**
+ * @brief 依次返回预先准备好的 chunk
+ * @details 并行执行时，工作算子从创建它的算子中依次领取 chunk，与表扫描领取页面范围类似
+ */
+class ChunkSourceOperator : public PhysicalOperator
+{
+public:
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::TABLE_SCAN_VEC; }
+
+  RC open(Trx *trx) override
+  {
+    index_ = 0;
+    return RC::SUCCESS;
+  }
+  RC next(Chunk &chunk) override
+  {
+    if (parent_ != nullptr) {
+      const size_t index = parent_->next_chunk_.fetch_add(1);
+      if (index >= parent_->chunks_.size()) {
+        return RC::RECORD_EOF;
+      }
+      return chunk.reference(*parent_->chunks_[index]);
+    }
+    if (index_ >= chunks_.size()) {
+      return RC::RECORD_EOF;
+    }
+    return chunk.reference(*chunks_[index_++]);
+  }
+  RC close() override { return RC::SUCCESS; }
+
+  bool parallel_safe() const override { return true; }
+
+  RC create_workers(int parallel_degree, vector<unique_ptr<PhysicalOperator>> &workers) override
+  {
+    next_chunk_.store(0);
+    for (int i = 0; i < parallel_degree; i++) {
+      auto worker     = make_unique<ChunkSourceOperator>();
+      worker->parent_ = this;
+      workers.emplace_back(std::move(worker));
+    }
+    return RC::SUCCESS;
+  }
+
+  /**
+   * @brief 添加一个每列都是 int 的 chunk，columns[i] 是第 i 列的值，null_rows 是第 0 列中为 NULL 的行
+   */
+  void add_chunk(const vector<vector<int>> &columns, const vector<int> &null_rows = {})
+  {
+    auto chunk = make_unique<Chunk>();
+    for (size_t i = 0; i < columns.size(); i++) {
+      auto column = make_unique<Column>(AttrType::INTS, sizeof(int), columns[i].size());
+      column->append(reinterpret_cast<const char *>(columns[i].data()), columns[i].size());
+      for (int row : null_rows) {
+        if (i == 0) {
+          column->set_null(row);
+        }
+      }
+      chunk->add_column(std::move(column), i);
+    }
+    chunks_.emplace_back(std::move(chunk));
+  }
+
+private:
+  vector<unique_ptr<Chunk>> chunks_;
+  size_t                    index_ = 0;
+
+  ChunkSourceOperator *parent_ = nullptr;
+  atomic<size_t>       next_chunk_{0};
+};
+
+static FieldMeta int_field_meta("col", AttrType::INTS, 0, sizeof(int), true, 0, false);
+
+static unique_ptr<Expression> make_column_expr(int pos)
+{
+  auto expr = make_unique<FieldExpr>(Field(nullptr, &int_field_meta));
+  expr->set_pos(pos);
+  return expr;
+}
+
+static unique_ptr<Expression> make_compare_expr(CompOp comp, int pos, int value)
+{
+  return make_unique<ComparisonExpr>(comp, make_column_expr(pos), make_unique<ValueExpr>(Value(value)));
+}
+
+/**
+ * @brief 读取算子输出的所有行
+ */
+static RC fetch_all_rows(PhysicalOperator &oper, vector<vector<int>> &rows)
+{
+  RC rc = oper.open(nullptr);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Chunk chunk;
+  while (OB_SUCC(rc = oper.next(chunk))) {
+    EXPECT_LE(chunk.rows(), Chunk::MAX_ROWS);
+    for (int row = 0; row < chunk.selected_rows(); row++) {
+      vector<int> values;
+      for (int col = 0; col < chunk.column_num(); col++) {
+        values.push_back(chunk.get_value(col, chunk.row_index(row)).get_int());
+      }
+      rows.push_back(values);
+    }
+  }
+  oper.close();
+  return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+}
+
+TEST(PredicateVecPhysicalOperator, filter)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  source->add_chunk({{1, 2, 3, 4, 5}, {10, 20, 30, 40, 50}});
+  source->add_chunk({{6, 7}, {60, 70}});
+  source->add_chunk({{8, 9, 10}, {80, 90, 100}});
+
+  // id > 2 AND (id < 4 OR id >= 9)
+  vector<unique_ptr<Expression>> or_children;
+  or_children.emplace_back(make_compare_expr(LESS_THAN, 0, 4));
+  or_children.emplace_back(make_compare_expr(GREAT_EQUAL, 0, 9));
+  vector<unique_ptr<Expression>> and_children;
+  and_children.emplace_back(make_compare_expr(GREAT_THAN, 0, 2));
+  and_children.emplace_back(make_unique<ConjunctionExpr>(ConjunctionExpr::Type::OR, or_children));
+
+  PredicateVecPhysicalOperator predicate(make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, and_children));
+  predicate.add_child(std::move(source));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(predicate, rows));
+  vector<vector<int>> expected = {{3, 30}, {9, 90}, {10, 100}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(PredicateVecPhysicalOperator, constant)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  source->add_chunk({{1, 2, 3}});
+
+  Value false_value;
+  false_value.set_boolean(false);
+  PredicateVecPhysicalOperator predicate(make_unique<ValueExpr>(false_value));
+  predicate.add_child(std::move(source));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(predicate, rows));
+  ASSERT_TRUE(rows.empty());
+}
+
+TEST(PredicateVecPhysicalOperator, selection)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  source->add_chunk({{1, 2, 3, 4, 5, 6}, {10, 20, 30, 40, 50, 60}});
+  Chunk source_chunk;
+  ASSERT_EQ(RC::SUCCESS, source->next(source_chunk));
+  const char *source_data = source_chunk.column(0).data();
+
+  // 过滤只设置选择向量，列数据不拷贝
+  PredicateVecPhysicalOperator predicate(make_compare_expr(GREAT_THAN, 0, 1));
+  predicate.add_child(std::move(source));
+  ASSERT_EQ(RC::SUCCESS, predicate.open(nullptr));
+  Chunk chunk;
+  ASSERT_EQ(RC::SUCCESS, predicate.next(chunk));
+  ASSERT_TRUE(chunk.has_selection());
+  ASSERT_EQ(6, chunk.rows());
+  ASSERT_EQ(5, chunk.selected_rows());
+  ASSERT_EQ(source_data, chunk.column(0).data());
+  predicate.close();
+
+  // 两个过滤算子叠加时合并选择向量
+  auto second = make_unique<ChunkSourceOperator>();
+  second->add_chunk({{1, 2, 3, 4, 5, 6}, {10, 20, 30, 40, 50, 60}});
+  auto lower = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(GREAT_THAN, 0, 1));
+  lower->add_child(std::move(second));
+  auto upper = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(NOT_EQUAL, 1, 40));
+  upper->add_child(std::move(lower));
+
+  LimitVecPhysicalOperator limit(3);
+  limit.add_child(std::move(upper));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(limit, rows));
+  vector<vector<int>> expected = {{2, 20}, {3, 30}, {5, 50}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(HashJoinVecPhysicalOperator, filtered_children)
+{
+  // 左右两边都是带选择向量的 chunk
+  auto left_source = make_unique<ChunkSourceOperator>();
+  left_source->add_chunk({{1, 2, 3, 4}, {10, 20, 30, 40}});
+  auto left = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(NOT_EQUAL, 0, 2));
+  left->add_child(std::move(left_source));
+
+  auto right_source = make_unique<ChunkSourceOperator>();
+  right_source->add_chunk({{4, 3, 2, 1}, {400, 300, 200, 100}});
+  auto right = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(LESS_THAN, 0, 4));
+  right->add_child(std::move(right_source));
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  left_keys.emplace_back(make_column_expr(0));
+  right_keys.emplace_back(make_column_expr(0));
+  HashJoinVecPhysicalOperator join(std::move(left_keys), std::move(right_keys));
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  vector<vector<int>> expected = {{1, 10, 1, 100}, {3, 30, 3, 300}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(NestedLoopJoinVecPhysicalOperator, cross_product)
+{
+  auto left = make_unique<ChunkSourceOperator>();
+  left->add_chunk({{1, 2}});
+  left->add_chunk({{3}});
+  auto right = make_unique<ChunkSourceOperator>();
+  right->add_chunk({{10, 20}, {100, 200}});
+  right->add_chunk({{30}, {300}});
+
+  NestedLoopJoinVecPhysicalOperator join;
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  vector<vector<int>> expected = {{1, 10, 100},
+      {1, 20, 200},
+      {1, 30, 300},
+      {2, 10, 100},
+      {2, 20, 200},
+      {2, 30, 300},
+      {3, 10, 100},
+      {3, 20, 200},
+      {3, 30, 300}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(NestedLoopJoinVecPhysicalOperator, large_output)
+{
+  // 输出超过一个 chunk 的容量
+  const int   left_rows  = 3;
+  const int   right_rows = Chunk::MAX_ROWS / 2 + 1;
+  vector<int> left_values(left_rows);
+  vector<int> right_values(right_rows);
+  for (int i = 0; i < left_rows; i++) {
+    left_values[i] = i;
+  }
+  for (int i = 0; i < right_rows; i++) {
+    right_values[i] = i;
+  }
+
+  auto left = make_unique<ChunkSourceOperator>();
+  left->add_chunk({left_values});
+  auto right = make_unique<ChunkSourceOperator>();
+  right->add_chunk({right_values});
+
+  NestedLoopJoinVecPhysicalOperator join;
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  ASSERT_EQ(static_cast<size_t>(left_rows * right_rows), rows.size());
+  for (size_t i = 0; i < rows.size(); i++) {
+    ASSERT_EQ(static_cast<int>(i / right_rows), rows[i][0]);
+    ASSERT_EQ(static_cast<int>(i % right_rows), rows[i][1]);
+  }
+}
+
+TEST(HashJoinVecPhysicalOperator, equi_join)
+{
+  auto left = make_unique<ChunkSourceOperator>();
+  left->add_chunk({{1, 2, 3}, {10, 20, 30}});
+  left->add_chunk({{3, 5}, {31, 50}});
+  auto right = make_unique<ChunkSourceOperator>();
+  right->add_chunk({{3, 1, 4}, {300, 100, 400}});
+  right->add_chunk({{3}, {301}});
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  left_keys.emplace_back(make_column_expr(0));
+  right_keys.emplace_back(make_column_expr(0));
+  HashJoinVecPhysicalOperator join(std::move(left_keys), std::move(right_keys));
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  vector<vector<int>> expected = {
+      {1, 10, 1, 100}, {3, 30, 3, 300}, {3, 30, 3, 301}, {3, 31, 3, 300}, {3, 31, 3, 301}};
+  ASSERT_EQ(expected, rows);
+}
+
+/**
+ * @brief 执行 semi/anti join，返回输出的第 1 列
+ * @details 左边第 0 列是 {1, 2, 3, 4, NULL}，第 1 列是 {10, 20, 30, 40, 50}
+ */
+static vector<int> run_semi_join(JoinType join_type, bool has_key, unique_ptr<ChunkSourceOperator> right)
+{
+  auto left = make_unique<ChunkSourceOperator>();
+  left->add_chunk({{1, 2, 3}, {10, 20, 30}});
+  left->add_chunk({{4, 0}, {40, 50}}, {1});
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  if (has_key) {
+    left_keys.emplace_back(make_column_expr(0));
+    right_keys.emplace_back(make_column_expr(0));
+  }
+  HashJoinVecPhysicalOperator join(std::move(left_keys), std::move(right_keys), join_type);
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  EXPECT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  vector<int> values;
+  for (const vector<int> &row : rows) {
+    EXPECT_EQ(2u, row.size());
+    values.push_back(row[1]);
+  }
+  return values;
+}
+
+TEST(HashJoinVecPhysicalOperator, semi_anti_join)
+{
+  auto make_right = [](const vector<int> &keys, const vector<int> &null_rows) {
+    auto right = make_unique<ChunkSourceOperator>();
+    if (!keys.empty()) {
+      right->add_chunk({keys}, null_rows);
+    }
+    return right;
+  };
+
+  // key IN (3, 1, 3, NULL)
+  ASSERT_EQ(vector<int>({10, 30}), run_semi_join(JoinType::SEMI, true, make_right({3, 1, 3, 0}, {3})));
+  // key NOT IN (3, 1)，左边的 NULL 不输出
+  ASSERT_EQ(vector<int>({20, 40}), run_semi_join(JoinType::NULL_AWARE_ANTI, true, make_right({3, 1}, {})));
+  // key NOT IN (3, NULL) 总是不成立
+  ASSERT_EQ(vector<int>(), run_semi_join(JoinType::NULL_AWARE_ANTI, true, make_right({3, 0}, {1})));
+  // key NOT IN (空集) 总是成立，包括 NULL
+  ASSERT_EQ(vector<int>({10, 20, 30, 40, 50}), run_semi_join(JoinType::NULL_AWARE_ANTI, true, make_right({}, {})));
+  // NOT EXISTS (... WHERE key = 右边的值)，NULL 不匹配任何行，左边的 NULL 和右边的 NULL 都不影响结果
+  ASSERT_EQ(vector<int>({20, 40, 50}), run_semi_join(JoinType::ANTI, true, make_right({3, 1, 0}, {2})));
+  ASSERT_EQ(vector<int>({10, 20, 30, 40, 50}), run_semi_join(JoinType::ANTI, true, make_right({}, {})));
+  ASSERT_EQ(vector<int>(), run_semi_join(JoinType::SEMI, true, make_right({}, {})));
+
+  // EXISTS/NOT EXISTS 没有连接键
+  ASSERT_EQ(vector<int>({10, 20, 30, 40, 50}), run_semi_join(JoinType::SEMI, false, make_right({0}, {0})));
+  ASSERT_EQ(vector<int>(), run_semi_join(JoinType::ANTI, false, make_right({7}, {})));
+  ASSERT_EQ(vector<int>({10, 20, 30, 40, 50}), run_semi_join(JoinType::ANTI, false, make_right({}, {})));
+}
+
+TEST(HashJoinVecPhysicalOperator, null_keys)
+{
+  // NULL 的连接键不匹配
+  auto left = make_unique<ChunkSourceOperator>();
+  left->add_chunk({{0, 1}, {10, 11}}, {0});
+  auto right = make_unique<ChunkSourceOperator>();
+  right->add_chunk({{0, 1}, {100, 101}}, {0});
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  left_keys.emplace_back(make_column_expr(0));
+  right_keys.emplace_back(make_column_expr(0));
+  HashJoinVecPhysicalOperator join(std::move(left_keys), std::move(right_keys));
+  join.add_child(std::move(left));
+  join.add_child(std::move(right));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(join, rows));
+  vector<vector<int>> expected = {{1, 11, 1, 101}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(OrderByVecPhysicalOperator, multi_keys)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  source->add_chunk({{3, 1, 4}, {1, 2, 3}});
+  source->add_chunk({{3, 1}, {2, 1}});
+
+  // order by col0 desc, col1 asc
+  vector<OrderByVecPhysicalOperator::OrderKey> keys(2);
+  keys[0].pos = 0;
+  keys[0].asc = false;
+  keys[1].pos = 1;
+  keys[1].asc = true;
+  OrderByVecPhysicalOperator order_by(std::move(keys));
+  order_by.add_child(std::move(source));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(order_by, rows));
+  vector<vector<int>> expected = {{4, 3}, {3, 1}, {3, 2}, {1, 1}, {1, 2}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(GroupByVecPhysicalOperator, group_by)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  source->add_chunk({{1, 2, 1, 3, 2}, {10, 20, 30, 40, 50}});
+  source->add_chunk({{3, 1, 4}, {60, 70, 80}});
+  auto predicate = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(NOT_EQUAL, 1, 30));
+  predicate->add_child(std::move(source));
+
+  // select id, sum(value), count(*), max(value) from t where value <> 30 group by id
+  vector<unique_ptr<Expression>> group_by_exprs;
+  group_by_exprs.emplace_back(make_column_expr(0));
+  AggregateExpr        sum_expr(AggregateExpr::Type::SUM, make_column_expr(1));
+  AggregateExpr        count_expr(AggregateExpr::Type::COUNT, make_unique<ValueExpr>(Value(1)));
+  AggregateExpr        max_expr(AggregateExpr::Type::MAX, make_column_expr(1));
+  vector<Expression *> aggregate_exprs = {&sum_expr, &count_expr, &max_expr};
+
+  GroupByVecPhysicalOperator group_by(std::move(group_by_exprs), std::move(aggregate_exprs));
+  group_by.add_child(std::move(predicate));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(group_by, rows));
+  vector<vector<int>> expected = {{1, 80, 2, 70}, {2, 70, 2, 50}, {3, 100, 2, 60}, {4, 80, 1, 80}};
+  ASSERT_EQ(expected, rows);
+}
+
+TEST(LimitVecPhysicalOperator, limit)
+{
+  for (int limit : {0, 2, 5, 7, 100}) {
+    auto source = make_unique<ChunkSourceOperator>();
+    source->add_chunk({{1, 2, 3, 4, 5}});
+    source->add_chunk({{6, 7, 8}});
+
+    LimitVecPhysicalOperator limit_oper(limit);
+    limit_oper.add_child(std::move(source));
+
+    vector<vector<int>> rows;
+    ASSERT_EQ(RC::SUCCESS, fetch_all_rows(limit_oper, rows));
+    ASSERT_EQ(static_cast<size_t>(min(limit, 8)), rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+      ASSERT_EQ(static_cast<int>(i) + 1, rows[i][0]);
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+/**
+ * @brief 生成 chunk_num 个 chunk，第 i 行是 {i % 100, i}
+ */
+static unique_ptr<ChunkSourceOperator> make_sequence_source(int chunk_num, int chunk_rows)
+{
+  auto source = make_unique<ChunkSourceOperator>();
+  for (int c = 0; c < chunk_num; c++) {
+    vector<int> keys;
+    vector<int> values;
+    for (int r = 0; r < chunk_rows; r++) {
+      keys.push_back((c * chunk_rows + r) % 100);
+      values.push_back(c * chunk_rows + r);
+    }
+    source->add_chunk({keys, values});
+  }
+  return source;
+}
+
+TEST(GatherVecPhysicalOperator, parallel_hash_join_probe)
+{
+  for (int parallel_degree : {1, 2, 4}) {
+    // select * from l, r where l.key = r.key and l.value % 100 < 50，右表的 key 是 0..19
+    auto left = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(LESS_THAN, 0, 50));
+    left->add_child(make_sequence_source(40, 100));
+    auto right = make_unique<ChunkSourceOperator>();
+    vector<int> right_keys_col;
+    vector<int> right_values_col;
+    for (int i = 0; i < 20; i++) {
+      right_keys_col.push_back(i);
+      right_values_col.push_back(i * 1000);
+    }
+    right->add_chunk({right_keys_col, right_values_col});
+
+    vector<unique_ptr<Expression>> left_keys;
+    vector<unique_ptr<Expression>> right_keys;
+    left_keys.emplace_back(make_column_expr(0));
+    right_keys.emplace_back(make_column_expr(0));
+    auto join = make_unique<HashJoinVecPhysicalOperator>(std::move(left_keys), std::move(right_keys));
+    join->add_child(std::move(left));
+    join->add_child(std::move(right));
+    ASSERT_TRUE(join->parallel_safe());
+
+    GatherVecPhysicalOperator gather(parallel_degree);
+    gather.add_child(std::move(join));
+
+    vector<vector<int>> rows;
+    ASSERT_EQ(RC::SUCCESS, fetch_all_rows(gather, rows));
+    ASSERT_EQ(rows.size(), 40u * 20u);
+    std::sort(rows.begin(), rows.end(), [](const vector<int> &a, const vector<int> &b) { return a[1] < b[1]; });
+    for (size_t i = 0; i < rows.size(); i++) {
+      ASSERT_EQ(rows[i][0], rows[i][1] % 100);
+      ASSERT_LT(rows[i][0], 20);
+      ASSERT_EQ(rows[i][2], rows[i][0]);
+      ASSERT_EQ(rows[i][3], rows[i][0] * 1000);
+    }
+  }
+}
+
+TEST(GatherVecPhysicalOperator, close_early)
+{
+  // LIMIT 读取一部分数据后关闭，工作算子在队列满时等待，关闭时需要结束
+  auto gather = make_unique<GatherVecPhysicalOperator>(4);
+  gather->add_child(make_sequence_source(200, 10));
+  LimitVecPhysicalOperator limit(15);
+  limit.add_child(std::move(gather));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(limit, rows));
+  ASSERT_EQ(rows.size(), 15u);
+}
+
+TEST(GatherVecPhysicalOperator, scheduler_busy)
+{
+  // 调度器的线程都被占用，Gather 所在的线程自己执行工作算子，不会一直等待
+  common::TaskScheduler &scheduler = common::TaskScheduler::instance();
+  const int              thread_num = scheduler.thread_num();
+  atomic<int>            blocked{0};
+  atomic<bool>           release{false};
+  auto                   blockers = scheduler.submit(thread_num, [&](int) {
+    blocked++;
+    while (!release.load()) {
+      this_thread::yield();
+    }
+    return RC::SUCCESS;
+  });
+  while (blocked.load() < thread_num) {
+    this_thread::yield();
+  }
+
+  auto gather = make_unique<GatherVecPhysicalOperator>(4);
+  gather->add_child(make_sequence_source(100, 10));
+
+  vector<vector<int>> rows;
+  ASSERT_EQ(RC::SUCCESS, fetch_all_rows(*gather, rows));
+  ASSERT_EQ(rows.size(), 1000u);
+
+  release = true;
+  ASSERT_EQ(RC::SUCCESS, scheduler.wait(*blockers));
+}
+
+TEST(GroupByVecPhysicalOperator, parallel_group_by)
+{
+  // select key, sum(value), count(*) from t where value >= 1000 group by key
+  auto run = [](int parallel_degree, vector<vector<int>> &rows) {
+    auto predicate = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(GREAT_EQUAL, 1, 1000));
+    predicate->add_child(make_sequence_source(50, 100));
+
+    vector<unique_ptr<Expression>> group_by_exprs;
+    group_by_exprs.emplace_back(make_column_expr(0));
+    AggregateExpr        sum_expr(AggregateExpr::Type::SUM, make_column_expr(1));
+    AggregateExpr        count_expr(AggregateExpr::Type::COUNT, make_unique<ValueExpr>(Value(1)));
+    vector<Expression *> aggregate_exprs = {&sum_expr, &count_expr};
+
+    GroupByVecPhysicalOperator group_by(std::move(group_by_exprs), std::move(aggregate_exprs));
+    group_by.set_parallel_degree(parallel_degree);
+    group_by.add_child(std::move(predicate));
+    ASSERT_EQ(RC::SUCCESS, fetch_all_rows(group_by, rows));
+    std::sort(rows.begin(), rows.end());
+  };
+
+  vector<vector<int>> serial_rows;
+  run(1, serial_rows);
+  ASSERT_EQ(serial_rows.size(), 100u);
+  for (int parallel_degree : {2, 3, 8}) {
+    vector<vector<int>> rows;
+    run(parallel_degree, rows);
+    ASSERT_EQ(serial_rows, rows);
+  }
+}
+
+TEST(AggregateVecPhysicalOperator, parallel_aggregate)
+{
+  for (int parallel_degree : {1, 4}) {
+    // select sum(value), count(value), min(value) from t where key <> 7
+    auto predicate = make_unique<PredicateVecPhysicalOperator>(make_compare_expr(NOT_EQUAL, 0, 7));
+    predicate->add_child(make_sequence_source(30, 100));
+
+    AggregateExpr        sum_expr(AggregateExpr::Type::SUM, make_column_expr(1));
+    AggregateExpr        count_expr(AggregateExpr::Type::COUNT, make_column_expr(1));
+    AggregateExpr        min_expr(AggregateExpr::Type::MIN, make_column_expr(1));
+    vector<Expression *> aggregate_exprs = {&sum_expr, &count_expr, &min_expr};
+
+    AggregateVecPhysicalOperator aggregate(std::move(aggregate_exprs));
+    aggregate.set_parallel_degree(parallel_degree);
+    aggregate.add_child(std::move(predicate));
+
+    vector<vector<int>> rows;
+    ASSERT_EQ(RC::SUCCESS, fetch_all_rows(aggregate, rows));
+    int sum = 0;
+    for (int i = 0; i < 3000; i++) {
+      sum += i % 100 == 7 ? 0 : i;
+    }
+    vector<vector<int>> expected = {{sum, 2970, 0}};
+    ASSERT_EQ(expected, rows);
+  }
+}